@@ -53,6 +53,7 @@ set(ENABLE_TIMER OFF CACHE BOOL "enable timer")
 set(ENABLE_ANEOS ON CACHE BOOL "enable the ANEOS equation of state package")
 set(ENABLE_OPENSUBDIV ON CACHE BOOL "enable the Opensubdiv Pixar extension for refining polyhedra")
 set(ENABLE_HELMHOLTZ ON CACHE BOOL "enable the Helmholtz equation of state package")
+set(ENABLE_CXXTESTS OFF CACHE BOOL "enable the C++ unit tests and hot path benchmarks (the CXXTests package)")
 
 option(ENABLE_STATIC_CXXONLY "build only static libs" OFF)
 if(ENABLE_STATIC_CXXONLY)
@@ -199,21 +199,21 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
             Scalar& vsigi = vsigMax(nodeListi, i);
             
             // Get the connectivity info for this node.
-            const vector< vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(&nodeList, i);
+            const auto fullConnectivity = connectivityMap.connectivityForNode(&nodeList, i);
             
             // Iterate over the NodeLists.
             for (size_t nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
                 
                 // Connectivity of this node with this NodeList.  We only need to proceed if
                 // there are some nodes in this list.
-                const vector<int>& connectivity = fullConnectivity[nodeListj];
+                const auto connectivity = fullConnectivity[nodeListj];
                 if (connectivity.size() > 0) {
                     
                     // Loop over the neighbors.
 #if defined __INTEL_COMPILER
 #pragma vector always
 #endif
-                    for (vector<int>::const_iterator jItr = connectivity.begin();
+                    for (auto jItr = connectivity.begin();
                          jItr != connectivity.end();
                          ++jItr) {
                         const int j = *jItr;
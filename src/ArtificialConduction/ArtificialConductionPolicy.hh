@@ -57,6 +57,9 @@ namespace Spheral {
         
         // Equivalence.
         virtual bool operator==(const UpdatePolicyBase<Dimension>& rhs) const;
+
+        // We can only be fired concurrently if the energy policy can.
+        virtual bool concurrentUpdate() const { return mEnergyPolicy->concurrentUpdate(); }
         
     private:
         //--------------------------- Private Interface ---------------------------//
@@ -376,7 +376,7 @@ finalizeDerivatives(const Scalar /*time*/,
       Scalar& vsigi = vsig(nodeListi, i);
 
       // Neighbors!
-      const vector<vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
       CHECK(fullConnectivity.size() == numNodeLists);
 
       // Walk the neighbor nodeLists.
@@ -384,7 +384,7 @@ finalizeDerivatives(const Scalar /*time*/,
       
         // Connectivity of this node with this NodeList.  We only need to proceed if
         // there are some nodes in this list.
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
+        const auto connectivity = fullConnectivity[nodeListj];
         if (connectivity.size() > 0) {
           const int firstGhostNodej = DvDx[nodeListj]->nodeList().firstGhostNode();
 
@@ -392,7 +392,7 @@ finalizeDerivatives(const Scalar /*time*/,
 #if defined __INTEL_COMPILER
 #pragma vector always
 #endif
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             const int j = *jItr;
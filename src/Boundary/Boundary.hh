@@ -152,6 +152,10 @@ public:
   // packages have been initialized.
   virtual void initializeProblemStartup(const bool)                              {};
 
+  // Optional hook to start any communication needed for the ghost boundaries
+  // applied so far, which finalizeGhostBoundary will then complete.
+  virtual void beginGhostBoundary() const                                        {};
+
   // Provide an optional hook that is to be called when all ghost boundaries are
   // to have been set.
   virtual void finalizeGhostBoundary() const                                     {};
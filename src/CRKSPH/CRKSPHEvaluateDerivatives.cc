@@ -55,6 +55,16 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   CHECK(corrections.size() == numNodeLists);
   CHECK(surfacePoint.size() == numNodeLists);
 
+  // The pair geometry and base kernel values (evaluated in blocks over the
+  // pairs), if they're being cached for sharing between the packages.
+  auto& pairGeometry = connectivityMap.pairGeometry();
+  const auto cachedGeometry = pairGeometry.caching();
+  const typename NodePairGeometry<Dimension>::KernelValues* Wvalues = nullptr;
+  if (cachedGeometry) {
+    pairGeometry.update(pairs, connectivityMap.nodePairGeneration(), position, H);
+    Wvalues = &pairGeometry.kernelValues(WR.kernel());
+  }
+
   // Derivative FieldLists.
   auto  DxDt = derivatives.fields(IncrementFieldList<Dimension, Field<Dimension, Vector> >::prefix() + HydroFieldNames::position, Vector::zero);
   auto  DrhoDt = derivatives.fields(IncrementFieldList<Dimension, Field<Dimension, Scalar> >::prefix() + HydroFieldNames::massDensity, 0.0);
@@ -90,6 +100,7 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   if (compatibleEnergy) pairAccelerations.resize(npairs);
 
   // Walk all the interacting pairs.
+  PairThreadReduction<Dimension> threadReduction(connectivityMap, this->threadReductionMethod());
 #pragma omp parallel
   {
     // Thread private scratch variables
@@ -97,168 +108,183 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
     Scalar Wi, gWi, Wj, gWj;
     Tensor QPiij, QPiji;
     Vector gradWi, gradWj, gradWSPHi, gradWSPHj;
+    Vector rij, etai, etaj, Hetai, Hetaj;
     Vector deltagrad, forceij, forceji;
 
-    typename SpheralThreads<Dimension>::FieldListStack threadStack;
-    auto DvDt_thread = DvDt.threadCopy(threadStack);
-    auto DepsDt_thread = DepsDt.threadCopy(threadStack);
-    auto DvDx_thread = DvDx.threadCopy(threadStack);
-    auto localDvDx_thread = localDvDx.threadCopy(threadStack);
-    auto maxViscousPressure_thread = maxViscousPressure.threadCopy(threadStack, ThreadReduction::MAX);
-    auto effViscousPressure_thread = effViscousPressure.threadCopy(threadStack);
-    auto viscousWork_thread = viscousWork.threadCopy(threadStack);
-    auto XSPHDeltaV_thread = XSPHDeltaV.threadCopy(threadStack);
-    auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
-    auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
-
-#pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& ri = position(nodeListi, i);
-      const auto  mi = mass(nodeListi, i);
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto& correctionsi = corrections(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdeti);
-      CHECK2(mi > 0.0, i << " " << mi);
-      CHECK2(rhoi > 0.0, i << " " << rhoi);
-      CHECK2(Hdeti > 0.0, i << " " << Hdeti);
-      CHECK2(weighti > 0.0, i << " " << weighti);
-
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto& rj = position(nodeListj, j);
-      const auto  mj = mass(nodeListj, j);
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      //const auto  epsj = specificThermalEnergy(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto& correctionsj = corrections(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdetj);
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-      CHECK(weightj > 0.0);
-
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Node displacement.
-      const auto rij = ri - rj;
-      const auto etai = Hi*rij;
-      const auto etaj = Hj*rij;
-      const auto vij = vi - vj;
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( rij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
-      std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-rij, Hi, correctionsj);
-      deltagrad = gradWj - gradWi;
-      gradWSPHi = (Hi*etai.unitVector())*gWi;
-      gradWSPHj = (Hj*etaj.unitVector())*gWj;
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = nodeListi == nodeListj ? 1.0 : mj*rhoi/(mi*rhoj);
-      const auto rij2 = rij.magnitude2();
-      const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
-
-      // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      ri, etai, vi, rhoi, ci, Hi,
-                                      rj, etaj, vj, rhoj, cj, Hj);
-      const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
-      // const auto workQij = 0.5*(vij.dot(Qaccij));
-      const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
-      const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
-      // const auto workQVi =  vij.dot((rhoj*rhoj*QPiji).dot(gradWj));               //RK V and RK I Work
-      // const auto workQVj =  vij.dot((rhoi*rhoi*QPiij).dot(gradWi));               //RK V and RK I Work
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
-      maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
-      effViscousPressurei += weightj * Qi * Wj;
-      effViscousPressurej += weighti * Qj * Wi;
-      viscousWorki += 0.5*weighti*weightj/mi*workQi;
-      viscousWorkj += 0.5*weighti*weightj/mj*workQj;
-
-      // Velocity gradient.
-      DvDxi -= weightj*vij.dyad(gradWj);
-      DvDxj += weighti*vij.dyad(gradWi);
-      if (nodeListi == nodeListj) {
-        localDvDxi -= weightj*vij.dyad(gradWj);
-        localDvDxj += weighti*vij.dyad(gradWi);
-      }
-
-      // // Mass density gradient.
-      // gradRhoi += weightj*(rhoj - rhoi)*gradWj;
-      // gradRhoj += weighti*(rhoi - rhoj)*gradWi;
-
-      // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
-      // Momentum
-      forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
-                 0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
-                 mi*weightj*((Pj - Pi)/rhoi*gradWj + rhoi*QPiij.dot(gradWj)));       // RK
-      forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ? 
-                 0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
-                 mj*weighti*((Pj - Pi)/rhoj*gradWi - rhoj*QPiji.dot(gradWi)));       // RK
-      DvDti -= forceij/mi;
-      DvDtj += forceji/mj; 
-      if (compatibleEnergy) pairAccelerations[kk] = -forceij/mi;                     // Acceleration for i (j anti-symmetric)
-
-      // Energy
-      DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ? 
-                  0.5*weighti*weightj*(Pj*vij.dot(deltagrad) + workQi)/mi :          // CRK
-                  weightj*rhoi*QPiij.dot(vij).dot(gradWj));                          // RK
-      DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ? 
-                  0.5*weighti*weightj*(Pi*vij.dot(deltagrad) + workQj)/mj :          // CRK
-                  -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                         // RK
-
-      // Estimate of delta v (for XSPH).
-      if (XSPH and (nodeListi == nodeListj)) {
-        XSPHDeltaVi -= weightj*Wj*vij;
-        XSPHDeltaVj += weighti*Wi*vij;
+    // Thread-local accumulation windows.
+    FieldListThreadWindow<Dimension, Vector> DvDt_thread(DvDt, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> DepsDt_thread(DepsDt, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> DvDx_thread(DvDx, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> localDvDx_thread(localDvDx, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> maxViscousPressure_thread(maxViscousPressure, threadReduction, ThreadReduction::MAX);
+    FieldListThreadWindow<Dimension, Scalar> effViscousPressure_thread(effViscousPressure, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> viscousWork_thread(viscousWork, threadReduction);
+    FieldListThreadWindow<Dimension, Vector> XSPHDeltaV_thread(XSPHDeltaV, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> weightedNeighborSum_thread(weightedNeighborSum, threadReduction);
+    FieldListThreadWindow<Dimension, SymTensor> massSecondMoment_thread(massSecondMoment, threadReduction);
+
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = threadReduction.pairRange(ghostPairs);
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& ri = position(nodeListi, i);
+        const auto  mi = mass(nodeListi, i);
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto& correctionsi = corrections(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdeti);
+        CHECK2(mi > 0.0, i << " " << mi);
+        CHECK2(rhoi > 0.0, i << " " << rhoi);
+        CHECK2(Hdeti > 0.0, i << " " << Hdeti);
+        CHECK2(weighti > 0.0, i << " " << weighti);
+
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto& rj = position(nodeListj, j);
+        const auto  mj = mass(nodeListj, j);
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        //const auto  epsj = specificThermalEnergy(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto& correctionsj = corrections(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdetj);
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+        CHECK(weightj > 0.0);
+
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Node displacement and symmetrized kernel weight and gradient.
+        if (cachedGeometry) {
+          rij = pairGeometry.rij(kk);
+          etai = pairGeometry.etai(kk);
+          etaj = pairGeometry.etaj(kk);
+          Hetai = pairGeometry.Hetai(kk);
+          Hetaj = pairGeometry.Hetaj(kk);
+          std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradientsFromBase( rij, Wvalues->Wj[kk], Wvalues->gWj[kk],  Hetaj, correctionsi);  // Hj because we compute RK using scatter formalism
+          std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradientsFromBase(-rij, Wvalues->Wi[kk], Wvalues->gWi[kk], -Hetai, correctionsj);
+        } else {
+          rij = ri - rj;
+          etai = Hi*rij;
+          etaj = Hj*rij;
+          Hetai = Hi*etai.unitVector();
+          Hetaj = Hj*etaj.unitVector();
+          std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( rij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
+          std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-rij, Hi, correctionsj);
+        }
+        const auto vij = vi - vj;
+        deltagrad = gradWj - gradWi;
+        gradWSPHi = Hetai*gWi;
+        gradWSPHj = Hetaj*gWj;
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = nodeListi == nodeListj ? 1.0 : mj*rhoi/(mi*rhoj);
+        const auto rij2 = rij.magnitude2();
+        const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
+
+        // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        ri, etai, vi, rhoi, ci, Hi,
+                                        rj, etaj, vj, rhoj, cj, Hj);
+        const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
+        // const auto workQij = 0.5*(vij.dot(Qaccij));
+        const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
+        const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
+        // const auto workQVi =  vij.dot((rhoj*rhoj*QPiji).dot(gradWj));               //RK V and RK I Work
+        // const auto workQVj =  vij.dot((rhoi*rhoi*QPiij).dot(gradWi));               //RK V and RK I Work
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
+        maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
+        effViscousPressurei += weightj * Qi * Wj;
+        effViscousPressurej += weighti * Qj * Wi;
+        viscousWorki += 0.5*weighti*weightj/mi*workQi;
+        viscousWorkj += 0.5*weighti*weightj/mj*workQj;
+
+        // Velocity gradient.
+        DvDxi -= weightj*vij.dyad(gradWj);
+        DvDxj += weighti*vij.dyad(gradWi);
+        if (nodeListi == nodeListj) {
+          localDvDxi -= weightj*vij.dyad(gradWj);
+          localDvDxj += weighti*vij.dyad(gradWi);
+        }
+
+        // // Mass density gradient.
+        // gradRhoi += weightj*(rhoj - rhoi)*gradWj;
+        // gradRhoj += weighti*(rhoi - rhoj)*gradWi;
+
+        // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
+        // Momentum
+        forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
+                   0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
+                   mi*weightj*((Pj - Pi)/rhoi*gradWj + rhoi*QPiij.dot(gradWj)));       // RK
+        forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ? 
+                   0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
+                   mj*weighti*((Pj - Pi)/rhoj*gradWi - rhoj*QPiji.dot(gradWi)));       // RK
+        DvDti -= forceij/mi;
+        DvDtj += forceji/mj; 
+        if (compatibleEnergy) pairAccelerations[kk] = -forceij/mi;                     // Acceleration for i (j anti-symmetric)
+
+        // Energy
+        DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ? 
+                    0.5*weighti*weightj*(Pj*vij.dot(deltagrad) + workQi)/mi :          // CRK
+                    weightj*rhoi*QPiij.dot(vij).dot(gradWj));                          // RK
+        DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ? 
+                    0.5*weighti*weightj*(Pi*vij.dot(deltagrad) + workQj)/mj :          // CRK
+                    -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                         // RK
+
+        // Estimate of delta v (for XSPH).
+        if (XSPH and (nodeListi == nodeListj)) {
+          XSPHDeltaVi -= weightj*Wj*vij;
+          XSPHDeltaVj += weighti*Wi*vij;
+        }
       }
     }
 
     // Reduce the thread values to the master.
-    threadReduceFieldLists<Dimension>(threadStack);
+    threadReduction.reduce();
 
   }   // OMP parallel
 
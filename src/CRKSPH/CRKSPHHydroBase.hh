@@ -97,6 +97,9 @@ public:
                            const State<Dimension>& state,
                            StateDerivatives<Dimension>& derivatives) const override;
 
+  // Our pair loops evaluate the interior pairs before those touching ghosts.
+  virtual bool overlapGhostExchange() const override { return true; }
+
   // Finalize the derivatives.
   virtual
   void finalizeDerivatives(const Scalar time,
@@ -307,149 +307,154 @@ evaluateDerivatives(const Dim<2>::Scalar /*time*/,
     auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& posi = position(nodeListi, i);
-      const auto  ri = abs(posi.y());
-      const auto  circi = 2.0*M_PI*ri;
-      const auto  mi = mass(nodeListi, i);
-      const auto  mRZi = mi/circi;
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto& correctionsi = corrections(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
-      const auto  zetai = abs((Hi*posi).y());
-      //const auto  hri = ri*safeInv(zetai);
-      CONTRACT_VAR(Hdeti);
-      CHECK2(ri > 0.0, i << " " << ri);
-      CHECK2(mi > 0.0, i << " " << mi);
-      CHECK2(rhoi > 0.0, i << " " << rhoi);
-      CHECK2(Hdeti > 0.0, i << " " << Hdeti);
-      CHECK2(weighti > 0.0, i << " " << weighti);
-
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto& posj = position(nodeListj, j);
-      const auto  rj = abs(posj.y());
-      const auto  circj = 2.0*M_PI*rj;
-      const auto  mj = mass(nodeListj, j);
-      const auto  mRZj = mj/circj;
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      const auto  epsj = specificThermalEnergy(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto& correctionsj = corrections(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
-      const auto  zetaj = abs((Hj*posj).y());
-      CONTRACT_VAR(epsj);
-      CONTRACT_VAR(Hdeti);
-      CONTRACT_VAR(Hdetj);
-      CHECK2(rj > 0.0, j << " " << rj);
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-      CHECK(weightj > 0.0);
-
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Node displacement.
-      const auto xij = posi - posj;
-      const auto etai = Hi*xij;
-      const auto etaj = Hj*xij;
-      const auto vij = vi - vj;
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( xij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
-      std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-xij, Hi, correctionsj);
-      deltagrad = gradWj - gradWi;
-      const auto gradWSPHi = (Hi*etai.unitVector())*gWi;
-      const auto gradWSPHj = (Hj*etaj.unitVector())*gWj;
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = nodeListi == nodeListj ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
-      const auto xij2 = xij.magnitude2();
-      const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
-
-      // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      posi, etai, vi, rhoi, ci, Hi,
-                                      posj, etaj, vj, rhoj, cj, Hj);
-      const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
-      const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
-      const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
-      maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
-      effViscousPressurei += weightj * Qi * Wj;
-      effViscousPressurej += weighti * Qj * Wi;
-      viscousWorki += 0.5*weighti*weightj/mi*workQi;
-      viscousWorkj += 0.5*weighti*weightj/mj*workQj;
-
-      // Velocity gradient.
-      DvDxi -= weightj*vij.dyad(gradWj);
-      DvDxj += weighti*vij.dyad(gradWi);
-      if (nodeListi == nodeListj) {
-        localDvDxi -= weightj*vij.dyad(gradWj);
-        localDvDxj += weighti*vij.dyad(gradWi);
-      }
-
-      // Acceleration (CRKSPH form).
-      CHECK(rhoi > 0.0);
-      CHECK(rhoj > 0.0);
-      const auto forceij  = 0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij); // <- Type III, with CRKSPH Q forces
-      DvDti -= forceij/mRZi; //CRK Acceleration
-      DvDtj += forceij/mRZj; //CRK Acceleration
-      if (mCompatibleEnergyEvolution) {
-        pairAccelerations[2*kk]   = -forceij/mRZi;
-        pairAccelerations[2*kk+1] =  forceij/mRZj;
-      }
-
-      DepsDti += 0.5*weighti*weightj*(Pj*vij.dot(deltagrad) + workQi)/mRZi;    // CRK Q
-      DepsDtj += 0.5*weighti*weightj*(Pi*vij.dot(deltagrad) + workQj)/mRZj;    // CRK Q
-
-      // Estimate of delta v (for XSPH).
-      if ((mXSPH and (nodeListi == nodeListj)) or min(zetai, zetaj) < 1.0) {
-        XSPHDeltaVi -= weightj*Wj*vij;
-        XSPHDeltaVj += weighti*Wi*vij;
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& posi = position(nodeListi, i);
+        const auto  ri = abs(posi.y());
+        const auto  circi = 2.0*M_PI*ri;
+        const auto  mi = mass(nodeListi, i);
+        const auto  mRZi = mi/circi;
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto& correctionsi = corrections(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
+        const auto  zetai = abs((Hi*posi).y());
+        //const auto  hri = ri*safeInv(zetai);
+        CONTRACT_VAR(Hdeti);
+        CHECK2(ri > 0.0, i << " " << ri);
+        CHECK2(mi > 0.0, i << " " << mi);
+        CHECK2(rhoi > 0.0, i << " " << rhoi);
+        CHECK2(Hdeti > 0.0, i << " " << Hdeti);
+        CHECK2(weighti > 0.0, i << " " << weighti);
+
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto& posj = position(nodeListj, j);
+        const auto  rj = abs(posj.y());
+        const auto  circj = 2.0*M_PI*rj;
+        const auto  mj = mass(nodeListj, j);
+        const auto  mRZj = mj/circj;
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        const auto  epsj = specificThermalEnergy(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto& correctionsj = corrections(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
+        const auto  zetaj = abs((Hj*posj).y());
+        CONTRACT_VAR(epsj);
+        CONTRACT_VAR(Hdeti);
+        CONTRACT_VAR(Hdetj);
+        CHECK2(rj > 0.0, j << " " << rj);
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+        CHECK(weightj > 0.0);
+
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Node displacement.
+        const auto xij = posi - posj;
+        const auto etai = Hi*xij;
+        const auto etaj = Hj*xij;
+        const auto vij = vi - vj;
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( xij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
+        std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-xij, Hi, correctionsj);
+        deltagrad = gradWj - gradWi;
+        const auto gradWSPHi = (Hi*etai.unitVector())*gWi;
+        const auto gradWSPHj = (Hj*etaj.unitVector())*gWj;
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = nodeListi == nodeListj ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
+        const auto xij2 = xij.magnitude2();
+        const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
+
+        // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        posi, etai, vi, rhoi, ci, Hi,
+                                        posj, etaj, vj, rhoj, cj, Hj);
+        const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
+        const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
+        const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
+        maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
+        effViscousPressurei += weightj * Qi * Wj;
+        effViscousPressurej += weighti * Qj * Wi;
+        viscousWorki += 0.5*weighti*weightj/mi*workQi;
+        viscousWorkj += 0.5*weighti*weightj/mj*workQj;
+
+        // Velocity gradient.
+        DvDxi -= weightj*vij.dyad(gradWj);
+        DvDxj += weighti*vij.dyad(gradWi);
+        if (nodeListi == nodeListj) {
+          localDvDxi -= weightj*vij.dyad(gradWj);
+          localDvDxj += weighti*vij.dyad(gradWi);
+        }
+
+        // Acceleration (CRKSPH form).
+        CHECK(rhoi > 0.0);
+        CHECK(rhoj > 0.0);
+        const auto forceij  = 0.5*weighti*weightj*((Pi + Pj)*deltagrad + Qaccij); // <- Type III, with CRKSPH Q forces
+        DvDti -= forceij/mRZi; //CRK Acceleration
+        DvDtj += forceij/mRZj; //CRK Acceleration
+        if (mCompatibleEnergyEvolution) {
+          pairAccelerations[2*kk]   = -forceij/mRZi;
+          pairAccelerations[2*kk+1] =  forceij/mRZj;
+        }
+
+        DepsDti += 0.5*weighti*weightj*(Pj*vij.dot(deltagrad) + workQi)/mRZi;    // CRK Q
+        DepsDtj += 0.5*weighti*weightj*(Pi*vij.dot(deltagrad) + workQj)/mRZj;    // CRK Q
+
+        // Estimate of delta v (for XSPH).
+        if ((mXSPH and (nodeListi == nodeListj)) or min(zetai, zetaj) < 1.0) {
+          XSPHDeltaVi -= weightj*Wj*vij;
+          XSPHDeltaVj += weighti*Wi*vij;
+        }
       }
     }
 
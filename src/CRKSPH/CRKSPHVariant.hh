@@ -85,6 +85,10 @@ public:
                            const State<Dimension>& state,
                            StateDerivatives<Dimension>& derivatives) const override;
 
+  // We walk the neighbors of each node rather than the NodePairList, so need
+  // the ghost values complete before evaluating the derivatives.
+  virtual bool overlapGhostExchange() const override { return false; }
+
 private:
   //--------------------------- Private Interface ---------------------------//
   // No default constructor, copying, or assignment.
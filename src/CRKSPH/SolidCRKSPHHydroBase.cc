@@ -408,174 +408,179 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
     auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& ri = position(nodeListi, i);
-      const auto  mi = mass(nodeListi, i);
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto& Si = S(nodeListi, i);
-      const auto  pTypei = pTypes(nodeListi, i);
-      const auto& correctionsi = corrections(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdeti);
-      CHECK(mi > 0.0);
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-      CHECK(weighti > 0.0);
-
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto& rj = position(nodeListj, j);
-      const auto  mj = mass(nodeListj, j);
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      //const auto  epsj = specificThermalEnergy(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto& Sj = S(nodeListj, j);
-      const auto  pTypej = pTypes(nodeListj, j);
-      const auto& correctionsj = corrections(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdetj);
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-      CHECK(weightj > 0.0);
-
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Node displacement.
-      const auto rij = ri - rj;
-      const auto etai = Hi*rij;
-      const auto etaj = Hj*rij;
-      const auto vij = vi - vj;
-
-      // Flag if at least one particle is free (0).
-      const auto freeParticle = (pTypei == 0 or pTypej == 0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( rij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
-      std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-rij, Hi, correctionsj);
-      deltagrad = gradWj - gradWi;
-      gradWSPHi = (Hi*etai.unitVector())*gWi;
-      gradWSPHj = (Hj*etaj.unitVector())*gWj;
-
-      // Find the damaged pair weighting scaling.
-      const auto fij = coupling(nodeListi, i, nodeListj, j);
-      CHECK(fij >= 0.0 and fij <= 1.0);
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = nodeListi == nodeListj ? 1.0 : mj*rhoi/(mi*rhoj);
-      const auto rij2 = rij.magnitude2();
-      const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
-
-      // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      ri, etai, vi, rhoi, ci, Hi,
-                                      rj, etaj, vj, rhoj, cj, Hj);
-      const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
-      // const auto workQij = 0.5*(vij.dot(Qaccij));
-      const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
-      const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
-      // const auto workQVi =  vij.dot((rhoj*rhoj*QPiji).dot(gradWj));               //RK V and RK I Work
-      // const auto workQVj =  vij.dot((rhoi*rhoi*QPiij).dot(gradWi));               //RK V and RK I Work
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
-      maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
-      effViscousPressurei += weightj * Qi * Wj;
-      effViscousPressurej += weighti * Qj * Wi;
-      viscousWorki += 0.5*weighti*weightj/mi*workQi;
-      viscousWorkj += 0.5*weighti*weightj/mj*workQj;
-
-      // Velocity gradient.
-      DvDxi -= weightj*vij.dyad(gradWj);
-      DvDxj += weighti*vij.dyad(gradWi);
-      localDvDxi -= fij*weightj*vij.dyad(gradWj);
-      localDvDxj += fij*weighti*vij.dyad(gradWi);
-
-      // // Mass density gradient.
-      // gradRhoi += weightj*(rhoj - rhoi)*gradWj;
-      // gradRhoj += weighti*(rhoi - rhoj)*gradWi;
-
-      // We treat positive and negative pressures distinctly, so split 'em up.
-      Pposi = max(0.0, Pi);
-      Pnegi = min(0.0, Pi);
-      Pposj = max(0.0, Pj);
-      Pnegj = min(0.0, Pj);
-
-      // Compute the stress tensors.
-      if (nodeListi == nodeListj) {
-        sigmai = Si - Pnegi*SymTensor::one;
-        sigmaj = Sj - Pnegj*SymTensor::one;
-      } else {
-        sigmai.Zero();
-        sigmaj.Zero();
-      }
-
-      // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
-      // Momentum
-      forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
-                 0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :         // Type III CRK interpoint force.
-                 mi*weightj*(((Pposj - Pposi)*gradWj - fij*(sigmaj - sigmai)*gradWj)/rhoi + rhoi*QPiij.dot(gradWj))); // RK
-      forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ?
-                 0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :         // Type III CRK interpoint force.
-                 mj*weighti*(((Pposj - Pposi)*gradWi - fij*(sigmaj - sigmai)*gradWi)/rhoj - rhoj*QPiji.dot(gradWi))); // RK
-      if (freeParticle) {
-        DvDti -= forceij/mi;
-        DvDtj += forceji/mj;
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& ri = position(nodeListi, i);
+        const auto  mi = mass(nodeListi, i);
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto& Si = S(nodeListi, i);
+        const auto  pTypei = pTypes(nodeListi, i);
+        const auto& correctionsi = corrections(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdeti);
+        CHECK(mi > 0.0);
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+        CHECK(weighti > 0.0);
+
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto& rj = position(nodeListj, j);
+        const auto  mj = mass(nodeListj, j);
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        //const auto  epsj = specificThermalEnergy(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto& Sj = S(nodeListj, j);
+        const auto  pTypej = pTypes(nodeListj, j);
+        const auto& correctionsj = corrections(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdetj);
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+        CHECK(weightj > 0.0);
+
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Node displacement.
+        const auto rij = ri - rj;
+        const auto etai = Hi*rij;
+        const auto etaj = Hj*rij;
+        const auto vij = vi - vj;
+
+        // Flag if at least one particle is free (0).
+        const auto freeParticle = (pTypei == 0 or pTypej == 0);
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( rij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
+        std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-rij, Hi, correctionsj);
+        deltagrad = gradWj - gradWi;
+        gradWSPHi = (Hi*etai.unitVector())*gWi;
+        gradWSPHj = (Hj*etaj.unitVector())*gWj;
+
+        // Find the damaged pair weighting scaling.
+        const auto fij = coupling(nodeListi, i, nodeListj, j);
+        CHECK(fij >= 0.0 and fij <= 1.0);
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = nodeListi == nodeListj ? 1.0 : mj*rhoi/(mi*rhoj);
+        const auto rij2 = rij.magnitude2();
+        const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
+
+        // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        ri, etai, vi, rhoi, ci, Hi,
+                                        rj, etaj, vj, rhoj, cj, Hj);
+        const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
+        // const auto workQij = 0.5*(vij.dot(Qaccij));
+        const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);                // CRK
+        const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);                // CRK
+        // const auto workQVi =  vij.dot((rhoj*rhoj*QPiji).dot(gradWj));               //RK V and RK I Work
+        // const auto workQVj =  vij.dot((rhoi*rhoi*QPiij).dot(gradWi));               //RK V and RK I Work
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);                     // We need tighter timestep controls on the Q with CRK
+        maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
+        effViscousPressurei += weightj * Qi * Wj;
+        effViscousPressurej += weighti * Qj * Wi;
+        viscousWorki += 0.5*weighti*weightj/mi*workQi;
+        viscousWorkj += 0.5*weighti*weightj/mj*workQj;
+
+        // Velocity gradient.
+        DvDxi -= weightj*vij.dyad(gradWj);
+        DvDxj += weighti*vij.dyad(gradWi);
+        localDvDxi -= fij*weightj*vij.dyad(gradWj);
+        localDvDxj += fij*weighti*vij.dyad(gradWi);
+
+        // // Mass density gradient.
+        // gradRhoi += weightj*(rhoj - rhoi)*gradWj;
+        // gradRhoj += weighti*(rhoi - rhoj)*gradWi;
+
+        // We treat positive and negative pressures distinctly, so split 'em up.
+        Pposi = max(0.0, Pi);
+        Pnegi = min(0.0, Pi);
+        Pposj = max(0.0, Pj);
+        Pnegj = min(0.0, Pj);
+
+        // Compute the stress tensors.
+        if (nodeListi == nodeListj) {
+          sigmai = Si - Pnegi*SymTensor::one;
+          sigmaj = Sj - Pnegj*SymTensor::one;
+        } else {
+          sigmai.Zero();
+          sigmaj.Zero();
+        }
+
+        // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
+        // Momentum
+        forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
+                   0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :         // Type III CRK interpoint force.
+                   mi*weightj*(((Pposj - Pposi)*gradWj - fij*(sigmaj - sigmai)*gradWj)/rhoi + rhoi*QPiij.dot(gradWj))); // RK
+        forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ?
+                   0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :         // Type III CRK interpoint force.
+                   mj*weighti*(((Pposj - Pposi)*gradWi - fij*(sigmaj - sigmai)*gradWi)/rhoj - rhoj*QPiji.dot(gradWi))); // RK
+        if (freeParticle) {
+          DvDti -= forceij/mi;
+          DvDtj += forceji/mj;
+        }
+        if (compatibleEnergy) pairAccelerations[kk] = -forceij/mi;                                                      // Acceleration for i (j anti-symmetric)
+
+        // Energy
+        DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ?
+                    0.5*weighti*weightj*(Pposj*vij.dot(deltagrad) - fij*sigmaj.dot(vij).dot(deltagrad) + workQi)/mi :   // CRK
+                    weightj*rhoi*QPiij.dot(vij).dot(gradWj));                                                           // RK, Q term only -- adiabatic portion added later
+        DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ?
+                    0.5*weighti*weightj*(Pposi*vij.dot(deltagrad) - fij*sigmai.dot(vij).dot(deltagrad) + workQj)/mj :   // CRK
+                    -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                                                          // RK, Q term only -- adiabatic portion added later
+
+        // Estimate of delta v (for XSPH).
+        XSPHDeltaVi -= fij*weightj*Wj*vij;
+        XSPHDeltaVj += fij*weighti*Wi*vij;
       }
-      if (compatibleEnergy) pairAccelerations[kk] = -forceij/mi;                                                      // Acceleration for i (j anti-symmetric)
-
-      // Energy
-      DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ?
-                  0.5*weighti*weightj*(Pposj*vij.dot(deltagrad) - fij*sigmaj.dot(vij).dot(deltagrad) + workQi)/mi :   // CRK
-                  weightj*rhoi*QPiij.dot(vij).dot(gradWj));                                                           // RK, Q term only -- adiabatic portion added later
-      DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ?
-                  0.5*weighti*weightj*(Pposi*vij.dot(deltagrad) - fij*sigmai.dot(vij).dot(deltagrad) + workQj)/mj :   // CRK
-                  -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                                                          // RK, Q term only -- adiabatic portion added later
-
-      // Estimate of delta v (for XSPH).
-      XSPHDeltaVi -= fij*weightj*Wj*vij;
-      XSPHDeltaVj += fij*weighti*Wi*vij;
     }
 
     // Reduce the thread values to the master.
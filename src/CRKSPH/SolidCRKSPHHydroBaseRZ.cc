@@ -401,177 +401,182 @@ evaluateDerivatives(const Dim<2>::Scalar /*time*/,
     auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& posi = position(nodeListi, i);
-      const auto  ri = abs(posi.y());
-      const auto  circi = 2.0*M_PI*ri;
-      const auto  mi = mass(nodeListi, i);
-      const auto  mRZi = mi/circi;
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto  Si = S(nodeListi, i);
-      const auto  pTypei = pTypes(nodeListi, i);
-      const auto& correctionsi = corrections(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdeti);
-      CHECK(mi > 0.0);
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-      CHECK(weighti > 0.0);
-
-      //auto& DrhoDti = DrhoDt(nodeListi, i);
-      auto& DvDti = DvDt(nodeListi, i);
-      auto& DepsDti = DepsDt(nodeListi, i);
-      auto& DvDxi = DvDx(nodeListi, i);
-      auto& localDvDxi = localDvDx(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure(nodeListi, i);
-      auto& viscousWorki = viscousWork(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment(nodeListi, i);
-
-      // Get the state for node j
-      const auto& posj = position(nodeListj, j);
-      const auto  rj = abs(posj.y());
-      const auto  circj = 2.0*M_PI*rj;
-      const auto  mj = mass(nodeListj, j);
-      const auto  mRZj = mj/circj;
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      //const auto  epsj = specificThermalEnergy(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto  pTypej = pTypes(nodeListj, j);
-      const auto& correctionsj = corrections(nodeListj, j);
-      const auto& Sj = S(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
-      CONTRACT_VAR(Hdetj);
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-      CHECK(weightj > 0.0);
-
-      auto& DvDtj = DvDt(nodeListj, j);
-      auto& DepsDtj = DepsDt(nodeListj, j);
-      auto& DvDxj = DvDx(nodeListj, j);
-      auto& localDvDxj = localDvDx(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure(nodeListj, j);
-      auto& viscousWorkj = viscousWork(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment(nodeListj, j);
-
-      // Node displacement.
-      const auto xij = posi - posj;
-      const auto etai = Hi*xij;
-      const auto etaj = Hj*xij;
-      const auto vij = vi - vj;
-
-      // Flag if at least one particle is free (0).
-      const auto freeParticle = (pTypei == 0 or pTypej == 0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( xij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
-      std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-xij, Hi, correctionsj);
-      deltagrad = gradWj - gradWi;
-      const auto gradWSPHi = (Hi*etai.unitVector())*gWi;
-      const auto gradWSPHj = (Hj*etaj.unitVector())*gWj;
-
-      // Find the damaged pair weighting scaling.
-      const auto fij = coupling(nodeListi, i, nodeListj, j);
-      CHECK(fij >= 0.0 and fij <= 1.0);
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = nodeListi == nodeListj ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
-      const auto xij2 = xij.magnitude2();
-      const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
-
-      // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      posi, etai, vi, rhoi, ci, Hi,
-                                      posj, etaj, vj, rhoj, cj, Hj);
-      const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
-      const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);          // CRK
-      const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);          // CRK
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);               // We need tighter timestep controls on the Q with CRK
-      maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
-      effViscousPressurei += weightj * Qi * Wj;
-      effViscousPressurej += weighti * Qj * Wi;
-      viscousWorki += 0.5*weighti*weightj/mRZi*workQi;
-      viscousWorkj += 0.5*weighti*weightj/mRZj*workQj;
-
-      // Velocity gradient.
-      DvDxi -= weightj*vij.dyad(gradWj);
-      DvDxj += weighti*vij.dyad(gradWi);
-      localDvDxi -= fij*weightj*vij.dyad(gradWj);
-      localDvDxj += fij*weighti*vij.dyad(gradWi);
-
-      // We treat positive and negative pressures distinctly, so split 'em up.
-      Pposi = max(0.0, Pi),
-      Pnegi = min(0.0, Pi),
-      Pposj = max(0.0, Pj),
-      Pnegj = min(0.0, Pj);
-
-      // Compute the stress tensors.
-      if (nodeListi == nodeListj) {
-        sigmai = Si - Pnegi*SymTensor::one;
-        sigmaj = Sj - Pnegj*SymTensor::one;
-      } else {
-        sigmai.Zero();
-        sigmaj.Zero();
-      }
-
-      // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
-      // Momentum
-      forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
-                 0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
-                 mi*weightj*(((Pposj - Pposi)*gradWj - fij*(sigmaj - sigmai)*gradWj)/rhoi + rhoi*QPiij.dot(gradWj)));        // RK
-      forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ?
-                 0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
-                 mj*weighti*(((Pposj - Pposi)*gradWi - fij*(sigmaj - sigmai)*gradWi)/rhoj - rhoj*QPiji.dot(gradWi)));        // RK
-      if (freeParticle) {
-        DvDti -= forceij/mRZi;
-        DvDtj += forceji/mRZj;
-      }
-      if (compatibleEnergy) {
-        pairAccelerations[kk]   = -forceij/mRZi;
-        pairAccelerations[2*kk] =  forceji/mRZj;
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& posi = position(nodeListi, i);
+        const auto  ri = abs(posi.y());
+        const auto  circi = 2.0*M_PI*ri;
+        const auto  mi = mass(nodeListi, i);
+        const auto  mRZi = mi/circi;
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto  Si = S(nodeListi, i);
+        const auto  pTypei = pTypes(nodeListi, i);
+        const auto& correctionsi = corrections(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  weighti = volume(nodeListi, i);  // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdeti);
+        CHECK(mi > 0.0);
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+        CHECK(weighti > 0.0);
+
+        //auto& DrhoDti = DrhoDt(nodeListi, i);
+        auto& DvDti = DvDt(nodeListi, i);
+        auto& DepsDti = DepsDt(nodeListi, i);
+        auto& DvDxi = DvDx(nodeListi, i);
+        auto& localDvDxi = localDvDx(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure(nodeListi, i);
+        auto& viscousWorki = viscousWork(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment(nodeListi, i);
+
+        // Get the state for node j
+        const auto& posj = position(nodeListj, j);
+        const auto  rj = abs(posj.y());
+        const auto  circj = 2.0*M_PI*rj;
+        const auto  mj = mass(nodeListj, j);
+        const auto  mRZj = mj/circj;
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        //const auto  epsj = specificThermalEnergy(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto  pTypej = pTypes(nodeListj, j);
+        const auto& correctionsj = corrections(nodeListj, j);
+        const auto& Sj = S(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  weightj = volume(nodeListj, j);     // Change CRKSPH weights here if need be!
+        CONTRACT_VAR(Hdetj);
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+        CHECK(weightj > 0.0);
+
+        auto& DvDtj = DvDt(nodeListj, j);
+        auto& DepsDtj = DepsDt(nodeListj, j);
+        auto& DvDxj = DvDx(nodeListj, j);
+        auto& localDvDxj = localDvDx(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure(nodeListj, j);
+        auto& viscousWorkj = viscousWork(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment(nodeListj, j);
+
+        // Node displacement.
+        const auto xij = posi - posj;
+        const auto etai = Hi*xij;
+        const auto etaj = Hj*xij;
+        const auto vij = vi - vj;
+
+        // Flag if at least one particle is free (0).
+        const auto freeParticle = (pTypei == 0 or pTypej == 0);
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wj, gradWj, gWj) = WR.evaluateKernelAndGradients( xij, Hj, correctionsi);  // Hj because we compute RK using scatter formalism
+        std::tie(Wi, gradWi, gWi) = WR.evaluateKernelAndGradients(-xij, Hi, correctionsj);
+        deltagrad = gradWj - gradWi;
+        const auto gradWSPHi = (Hi*etai.unitVector())*gWi;
+        const auto gradWSPHj = (Hj*etaj.unitVector())*gWj;
+
+        // Find the damaged pair weighting scaling.
+        const auto fij = coupling(nodeListi, i, nodeListj, j);
+        CHECK(fij >= 0.0 and fij <= 1.0);
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = nodeListi == nodeListj ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
+        const auto xij2 = xij.magnitude2();
+        const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWSPHi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWSPHj.magnitude2()*thpt;
+
+        // Compute the artificial viscous pressure (Pi = P/rho^2 actually).
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        posi, etai, vi, rhoi, ci, Hi,
+                                        posj, etaj, vj, rhoj, cj, Hj);
+        const auto Qaccij = (rhoi*rhoi*QPiij + rhoj*rhoj*QPiji).dot(deltagrad);
+        const auto workQi = rhoj*rhoj*QPiji.dot(vij).dot(deltagrad);          // CRK
+        const auto workQj = rhoi*rhoi*QPiij.dot(vij).dot(deltagrad);          // CRK
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, 4.0*Qi);               // We need tighter timestep controls on the Q with CRK
+        maxViscousPressurej = max(maxViscousPressurej, 4.0*Qj);
+        effViscousPressurei += weightj * Qi * Wj;
+        effViscousPressurej += weighti * Qj * Wi;
+        viscousWorki += 0.5*weighti*weightj/mRZi*workQi;
+        viscousWorkj += 0.5*weighti*weightj/mRZj*workQj;
+
+        // Velocity gradient.
+        DvDxi -= weightj*vij.dyad(gradWj);
+        DvDxj += weighti*vij.dyad(gradWi);
+        localDvDxi -= fij*weightj*vij.dyad(gradWj);
+        localDvDxj += fij*weighti*vij.dyad(gradWi);
+
+        // We treat positive and negative pressures distinctly, so split 'em up.
+        Pposi = max(0.0, Pi),
+        Pnegi = min(0.0, Pi),
+        Pposj = max(0.0, Pj),
+        Pnegj = min(0.0, Pj);
+
+        // Compute the stress tensors.
+        if (nodeListi == nodeListj) {
+          sigmai = Si - Pnegi*SymTensor::one;
+          sigmaj = Sj - Pnegj*SymTensor::one;
+        } else {
+          sigmai.Zero();
+          sigmaj.Zero();
+        }
+
+        // We decide between RK and CRK for the momentum and energy equations based on the surface condition.
+        // Momentum
+        forceij = (true ? // surfacePoint(nodeListi, i) <= 1 ? 
+                   0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
+                   mi*weightj*(((Pposj - Pposi)*gradWj - fij*(sigmaj - sigmai)*gradWj)/rhoi + rhoi*QPiij.dot(gradWj)));        // RK
+        forceji = (true ? // surfacePoint(nodeListj, j) <= 1 ?
+                   0.5*weighti*weightj*((Pposi + Pposj)*deltagrad - fij*(sigmai + sigmaj)*deltagrad + Qaccij) :                // Type III CRK interpoint force.
+                   mj*weighti*(((Pposj - Pposi)*gradWi - fij*(sigmaj - sigmai)*gradWi)/rhoj - rhoj*QPiji.dot(gradWi)));        // RK
+        if (freeParticle) {
+          DvDti -= forceij/mRZi;
+          DvDtj += forceji/mRZj;
+        }
+        if (compatibleEnergy) {
+          pairAccelerations[kk]   = -forceij/mRZi;
+          pairAccelerations[2*kk] =  forceji/mRZj;
+        }
+
+        // Energy
+        DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ?
+                    0.5*weighti*weightj*(Pposj*vij.dot(deltagrad) - fij*sigmaj.dot(vij).dot(deltagrad) + workQi)/mRZi :           // CRK
+                    weightj*rhoi*QPiij.dot(vij).dot(gradWj));                                                                     // RK, Q term only -- adiabatic portion added later
+        DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ?
+                    0.5*weighti*weightj*(Pposi*vij.dot(deltagrad) - fij*sigmai.dot(vij).dot(deltagrad) + workQj)/mRZj :           // CRK
+                   -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                                                                     // RK, Q term only -- adiabatic portion added later
+
+        // Estimate of delta v (for XSPH).
+        XSPHDeltaVi -= fij*weightj*Wj*vij;
+        XSPHDeltaVj += fij*weighti*Wi*vij;
       }
-
-      // Energy
-      DepsDti += (true ? // surfacePoint(nodeListi, i) <= 1 ?
-                  0.5*weighti*weightj*(Pposj*vij.dot(deltagrad) - fij*sigmaj.dot(vij).dot(deltagrad) + workQi)/mRZi :           // CRK
-                  weightj*rhoi*QPiij.dot(vij).dot(gradWj));                                                                     // RK, Q term only -- adiabatic portion added later
-      DepsDtj += (true ? // surfacePoint(nodeListj, j) <= 1 ?
-                  0.5*weighti*weightj*(Pposi*vij.dot(deltagrad) - fij*sigmai.dot(vij).dot(deltagrad) + workQj)/mRZj :           // CRK
-                 -weighti*rhoj*QPiji.dot(vij).dot(gradWi));                                                                     // RK, Q term only -- adiabatic portion added later
-
-      // Estimate of delta v (for XSPH).
-      XSPHDeltaVi -= fij*weightj*Wj*vij;
-      XSPHDeltaVj += fij*weighti*Wi*vij;
     }
 
     // Reduce the thread values to the master.
@@ -85,14 +85,14 @@ computeCRKSPHEvaluation(const ConnectivityMap<Dimension>& connectivityMap,
 
   // Neighbors!
   bool first_time=true;//Used as a flag to include self contribution
-  const vector<vector<int> > fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+  const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
   CHECK(fullConnectivity.size() == numNodeLists);
   for (size_t nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
     if (coupleNodeLists or nodeListi == nodeListj) {
-      const vector<int>& connectivity = fullConnectivity[nodeListj];
+      const auto connectivity = fullConnectivity[nodeListj];
 
       // Iterate over the neighbors for in this NodeList.
-      for (vector<int>::const_iterator jItr = connectivity.begin();
+      for (auto jItr = connectivity.begin();
            jItr != connectivity.end();
            ++jItr) {
            
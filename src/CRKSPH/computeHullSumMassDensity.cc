@@ -214,14 +214,14 @@ computeHullSumMassDensity(const ConnectivityMap<Dimension>& connectivityMap,
 
         // Get the neighbors for this node (in this NodeList).  We use the approximation here
         // that nodes from other NodeLists do not contribute to the density of this one.
-        const vector<int>& connectivity = connectivityMap.connectivityForNode(nodeListi, i)[nodeListi];
+        const auto connectivity = connectivityMap.connectivityForNode(nodeListi, i)[nodeListi];
 
         // Copy the neighbor positions & masses.
         vector<Vector> positionsInv(1, Vector::zero);
         vector<Scalar> masses(1, mi);
         positionsInv.reserve(connectivity.size() + 1);
         masses.reserve(connectivity.size() + 1);
-        for (vector<int>::const_iterator jItr = connectivity.begin();
+        for (auto jItr = connectivity.begin();
              jItr != connectivity.end();
              ++jItr) {
           const unsigned j = *jItr;
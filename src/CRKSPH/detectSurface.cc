@@ -73,13 +73,13 @@ detectSurface(const ConnectivityMap<Dimension>& connectivityMap,
                 
       if (std::abs(m0i - 1.0) > detectThreshold) {
         // Get neighbors
-        const vector<vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+        const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
         CHECK(fullConnectivity.size() == numNodeLists);
         // Loop over them
         size_t nodeListj = 0;
         while (!particleDetected and nodeListj != numNodeLists) {
-          const vector<int>& connectivity = fullConnectivity[nodeListj];
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          const auto connectivity = fullConnectivity[nodeListj];
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             const int j = *jItr;
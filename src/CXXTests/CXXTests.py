@@ -0,0 +1,5 @@
+#-------------------------------------------------------------------------------
+# The C++ unit tests and hot path benchmarks, under the name the test drivers
+# import them by.
+#-------------------------------------------------------------------------------
+from SpheralCXXTests import *
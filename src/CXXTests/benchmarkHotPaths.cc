@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// benchmarkHotPaths
+// Timing harnesses for the inner loops we care most about.
+//------------------------------------------------------------------------------
+#include "benchmarkHotPaths.hh"
+
+#include "DataBase/DataBase.hh"
+#include "DataBase/State.hh"
+#include "DataBase/StateDerivatives.hh"
+#include "Physics/Physics.hh"
+#include "Kernel/TableKernel.hh"
+#include "Material/EquationOfState.hh"
+#include "Field/Field.hh"
+#include "NodeList/NodeList.hh"
+#include "Utilities/timingUtilities.hh"
+#include "Utilities/DBC.hh"
+
+#include <vector>
+
+namespace Spheral {
+
+using std::vector;
+
+//------------------------------------------------------------------------------
+// ConnectivityMap.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<double>
+benchmarkConnectivityMap(const DataBase<Dimension>& dataBase,
+                         const bool computeGhostConnectivity,
+                         const unsigned nrepeat) {
+  vector<double> result;
+  result.reserve(nrepeat);
+  for (auto k = 0u; k < nrepeat; ++k) {
+    const auto t0 = Timing::currentTime();
+    dataBase.updateConnectivityMap(computeGhostConnectivity, false);
+    result.push_back(1.0e-6*Timing::difference(t0, Timing::currentTime()));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Physics::initialize.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<double>
+benchmarkPhysicsInitialize(Physics<Dimension>& physics,
+                           const DataBase<Dimension>& dataBase,
+                           State<Dimension>& state,
+                           StateDerivatives<Dimension>& derivs,
+                           const unsigned nrepeat) {
+  vector<double> result;
+  result.reserve(nrepeat);
+  for (auto k = 0u; k < nrepeat; ++k) {
+    const auto t0 = Timing::currentTime();
+    physics.initialize(0.0, 1.0, dataBase, state, derivs);
+    result.push_back(1.0e-6*Timing::difference(t0, Timing::currentTime()));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Physics::evaluateDerivatives.  We zero the derivatives between repetitions
+// outside the timed region.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<double>
+benchmarkEvaluateDerivatives(const Physics<Dimension>& physics,
+                             const DataBase<Dimension>& dataBase,
+                             const State<Dimension>& state,
+                             StateDerivatives<Dimension>& derivs,
+                             const unsigned nrepeat) {
+  vector<double> result;
+  result.reserve(nrepeat);
+  for (auto k = 0u; k < nrepeat; ++k) {
+    derivs.Zero();
+    const auto t0 = Timing::currentTime();
+    physics.evaluateDerivatives(0.0, 1.0, dataBase, state, derivs);
+    result.push_back(1.0e-6*Timing::difference(t0, Timing::currentTime()));
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// TableKernel.  We accumulate the results so the compiler cannot discard the
+// lookups.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<double>
+benchmarkTableKernel(const TableKernel<Dimension>& W,
+                     const unsigned n,
+                     const unsigned nrepeat) {
+  REQUIRE(n > 0u);
+  const auto deta = W.kernelExtent()/n;
+  vector<double> result;
+  result.reserve(nrepeat);
+  volatile double sink = 0.0;
+  for (auto k = 0u; k < nrepeat; ++k) {
+    double sum = 0.0;
+    const auto t0 = Timing::currentTime();
+    for (auto i = 0u; i < n; ++i) {
+      const auto WdW = W.kernelAndGradValue(i*deta, 1.0);
+      sum += WdW.first + WdW.second;
+    }
+    result.push_back(1.0e-6*Timing::difference(t0, Timing::currentTime()));
+    sink = sink + sum;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// EquationOfState.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<double>
+benchmarkEquationOfState(const EquationOfState<Dimension>& eos,
+                         const Field<Dimension, typename Dimension::Scalar>& massDensity,
+                         const Field<Dimension, typename Dimension::Scalar>& specificThermalEnergy,
+                         const unsigned nrepeat) {
+  typedef typename Dimension::Scalar Scalar;
+  const auto& nodeList = massDensity.nodeList();
+  Field<Dimension, Scalar> P("pressure", nodeList), cs("sound speed", nodeList), T("temperature", nodeList);
+  vector<double> result;
+  result.reserve(nrepeat);
+  for (auto k = 0u; k < nrepeat; ++k) {
+    const auto t0 = Timing::currentTime();
+    eos.setState(&P, &cs, &T, nullptr, nullptr, massDensity, specificThermalEnergy);
+    result.push_back(1.0e-6*Timing::difference(t0, Timing::currentTime()));
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// benchmarkHotPaths
+// Timing harnesses for the inner loops we care most about (neighbor
+// connectivity, physics package derivatives, kernel lookups, and equation of
+// state evaluations).  Each method runs the requested operation nrepeat times
+// and returns the wall clock time of each repetition in seconds, leaving the
+// statistics and reporting to the python driver
+// (tests/benchmark/benchmarkHotPaths.py).
+//------------------------------------------------------------------------------
+#ifndef __Spheral_benchmarkHotPaths_hh__
+#define __Spheral_benchmarkHotPaths_hh__
+
+#include <vector>
+
+namespace Spheral {
+  template<typename Dimension> class DataBase;
+  template<typename Dimension> class State;
+  template<typename Dimension> class StateDerivatives;
+  template<typename Dimension> class Physics;
+  template<typename Dimension> class TableKernel;
+  template<typename Dimension> class EquationOfState;
+  template<typename Dimension, typename DataType> class Field;
+}
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Time building the ConnectivityMap from scratch.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::vector<double>
+benchmarkConnectivityMap(const DataBase<Dimension>& dataBase,
+                         const bool computeGhostConnectivity,
+                         const unsigned nrepeat);
+
+//------------------------------------------------------------------------------
+// Time a physics package's initialize step (e.g., the RK volumes and
+// corrections for RKCorrections).
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::vector<double>
+benchmarkPhysicsInitialize(Physics<Dimension>& physics,
+                           const DataBase<Dimension>& dataBase,
+                           State<Dimension>& state,
+                           StateDerivatives<Dimension>& derivs,
+                           const unsigned nrepeat);
+
+//------------------------------------------------------------------------------
+// Time a physics package's evaluateDerivatives.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::vector<double>
+benchmarkEvaluateDerivatives(const Physics<Dimension>& physics,
+                             const DataBase<Dimension>& dataBase,
+                             const State<Dimension>& state,
+                             StateDerivatives<Dimension>& derivs,
+                             const unsigned nrepeat);
+
+//------------------------------------------------------------------------------
+// Time n evaluations of the kernel value & gradient spread over the kernel
+// extent.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::vector<double>
+benchmarkTableKernel(const TableKernel<Dimension>& W,
+                     const unsigned n,
+                     const unsigned nrepeat);
+
+//------------------------------------------------------------------------------
+// Time setting the pressure, sound speed, and temperature from an equation
+// of state.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::vector<double>
+benchmarkEquationOfState(const EquationOfState<Dimension>& eos,
+                         const Field<Dimension, typename Dimension::Scalar>& massDensity,
+                         const Field<Dimension, typename Dimension::Scalar>& specificThermalEnergy,
+                         const unsigned nrepeat);
+
+}
+
+#endif
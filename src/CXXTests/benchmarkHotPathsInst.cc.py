@@ -0,0 +1,20 @@
+text = """
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "CXXTests/benchmarkHotPaths.cc"
+
+namespace Spheral {
+template vector<double> benchmarkConnectivityMap<Dim< %(ndim)s > >(const DataBase<Dim< %(ndim)s > >&, const bool, const unsigned);
+
+template vector<double> benchmarkPhysicsInitialize<Dim< %(ndim)s > >(Physics<Dim< %(ndim)s > >&, const DataBase<Dim< %(ndim)s > >&, State<Dim< %(ndim)s > >&, StateDerivatives<Dim< %(ndim)s > >&, const unsigned);
+
+template vector<double> benchmarkEvaluateDerivatives<Dim< %(ndim)s > >(const Physics<Dim< %(ndim)s > >&, const DataBase<Dim< %(ndim)s > >&, const State<Dim< %(ndim)s > >&, StateDerivatives<Dim< %(ndim)s > >&, const unsigned);
+
+template vector<double> benchmarkTableKernel<Dim< %(ndim)s > >(const TableKernel<Dim< %(ndim)s > >&, const unsigned, const unsigned);
+
+template vector<double> benchmarkEquationOfState<Dim< %(ndim)s > >(const EquationOfState<Dim< %(ndim)s > >&, const Field<Dim< %(ndim)s >, Dim< %(ndim)s >::Scalar>&, const Field<Dim< %(ndim)s >, Dim< %(ndim)s >::Scalar>&, const unsigned);
+}
+
+"""
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+// testRKCoefficients
+//------------------------------------------------------------------------------
+#include "testRKCoefficients.hh"
+
+#include "RK/RKCoefficients.hh"
+#include "RK/RKUtilities.hh"
+#include "Utilities/packElement.hh"
+#include "Utilities/DBC.hh"
+
+#include "Eigen/Dense"
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace Spheral {
+
+using std::vector;
+using std::string;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Fill a set of coefficients with the given size with random values.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+randomCoefficients(RKCoefficients<Dimension>& x,
+                   const unsigned size,
+                   std::mt19937& gen) {
+  std::uniform_real_distribution<double> dist(-10.0, 10.0);
+  x.resize(size);
+  for (auto& xi: x) xi = dist(gen);
+}
+
+//------------------------------------------------------------------------------
+// Check the coefficients match a std::vector<double>.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+sameValues(const RKCoefficients<Dimension>& x,
+           const vector<double>& ans) {
+  return (x.size() == ans.size() and std::equal(x.begin(), x.end(), ans.begin()));
+}
+
+//------------------------------------------------------------------------------
+// Apply the transformation for a random Tensor to random coefficients, and
+// compare with the same transformation applied to a std::vector<double>.
+//------------------------------------------------------------------------------
+template<typename Dimension, RKOrder order>
+string
+checkTransformation(const bool needHessian,
+                    std::mt19937& gen) {
+  typedef RKUtilities<Dimension, order> RKUtilitiesType;
+  typename Dimension::Tensor T;
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  for (auto i = 0u; i < Dimension::nDim; ++i) {
+    for (auto j = 0u; j < Dimension::nDim; ++j) T(i,j) = dist(gen);
+  }
+  typename RKUtilitiesType::TransformationMatrix M;
+  RKUtilitiesType::getTransformationMatrix(T, needHessian, M);
+  RKCoefficients<Dimension> corrections;
+  randomCoefficients(corrections, M.cols(), gen);
+  corrections.correctionOrder = order;
+
+  // The answer from a std::vector.
+  vector<double> ans = corrections.coeffs();
+  Eigen::Map<Eigen::VectorXd> V(&ans[0], ans.size());
+  const Eigen::VectorXd MV = M*V;
+  V = MV;
+
+  RKUtilitiesType::applyTransformation(M, corrections);
+  std::stringstream message;
+  if (corrections.correctionOrder != order or corrections.size() != ans.size()) {
+    message << "applyTransformation changed the coefficients size or order for order " << static_cast<int>(order);
+    return message.str();
+  }
+  for (auto i = 0u; i < ans.size(); ++i) {
+    if (std::abs(corrections[i] - ans[i]) > 1.0e-12*std::max(1.0, std::abs(ans[i]))) {
+      message << "applyTransformation for order " << static_cast<int>(order) << " (" << ans.size()
+              << " coefficients, hessian=" << needHessian << ") element " << i << " : "
+              << corrections[i] << " != " << ans[i];
+      return message.str();
+    }
+  }
+  return "OK";
+}
+
+}
+
+//------------------------------------------------------------------------------
+// The test.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+string
+testRKCoefficients(const unsigned seed) {
+  typedef RKCoefficients<Dimension> Coeffs;
+  const unsigned ninline = Coeffs::inlineCapacity;
+  std::mt19937 gen(seed);
+  std::stringstream message;
+
+  // The sizes to check:  empty, inline, exactly filling the inline storage,
+  // and spilling to the heap.
+  const vector<unsigned> sizes = {0u, 1u, ninline - 1u, ninline, ninline + 1u, 3u*ninline};
+
+  for (const auto size: sizes) {
+    Coeffs x;
+    randomCoefficients(x, size, gen);
+    x.correctionOrder = RKOrder::QuadraticOrder;
+    const auto ans = x.coeffs();
+    if (not sameValues(x, ans)) {
+      message << "coeffs() does not match the coefficients for size " << size;
+      return message.str();
+    }
+
+    // Copy and assign, including into coefficients on the other side of the
+    // inline capacity.
+    Coeffs y(x);
+    if (y != x or not sameValues(y, ans)) {
+      message << "Copy construction failed for size " << size;
+      return message.str();
+    }
+    for (const auto size0: sizes) {
+      Coeffs z;
+      randomCoefficients(z, size0, gen);
+      z = x;
+      if (z != x or not sameValues(z, ans)) {
+        message << "Assignment of size " << size << " to size " << size0 << " failed";
+        return message.str();
+      }
+
+      // Resizing keeps the leading values.
+      Coeffs w(x);
+      w.resize(size0, -1.0);
+      for (auto i = 0u; i < size0; ++i) {
+        const double wans = (i < size ? ans[i] : -1.0);
+        if (w[i] != wans) {
+          message << "Resizing from " << size << " to " << size0 << " gives element " << i << " = " << w[i] << " != " << wans;
+          return message.str();
+        }
+      }
+    }
+
+    // Pack and unpack, into both empty coefficients and ones already holding
+    // a different number of values.
+    vector<char> buffer;
+    packElement(x, buffer);
+    packElement(x, buffer);
+    Coeffs u1, u2;
+    randomCoefficients(u2, (size <= ninline ? 2u*ninline : 1u), gen);
+    auto itr = static_cast<const vector<char>&>(buffer).begin();
+    const auto endItr = static_cast<const vector<char>&>(buffer).end();
+    unpackElement(u1, itr, endItr);
+    unpackElement(u2, itr, endItr);
+    if (itr != endItr) {
+      message << "Unpacking size " << size << " did not consume the buffer";
+      return message.str();
+    }
+    if (u1 != x or u2 != x or not sameValues(u1, ans) or not sameValues(u2, ans) or
+        u1.correctionOrder != RKOrder::QuadraticOrder or u2.correctionOrder != RKOrder::QuadraticOrder) {
+      message << "Pack/unpack round trip failed for size " << size;
+      return message.str();
+    }
+  }
+
+  // applyTransformation, with the corrections for each order both inside and
+  // beyond the inline storage.
+  for (const auto needHessian: {false, true}) {
+    vector<string> results = {checkTransformation<Dimension, RKOrder::ZerothOrder>(needHessian, gen),
+                              checkTransformation<Dimension, RKOrder::LinearOrder>(needHessian, gen),
+                              checkTransformation<Dimension, RKOrder::QuadraticOrder>(needHessian, gen),
+                              checkTransformation<Dimension, RKOrder::CubicOrder>(needHessian, gen)};
+    for (const auto& result: results) {
+      if (result != "OK") return result;
+    }
+  }
+
+  return "OK";
+}
+
+}
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+// testRKCoefficients
+// Exercise the inline/heap storage of RKCoefficients:  copying, resizing, and
+// packing/unpacking coefficients either side of the inline capacity, and
+// RKUtilities::applyTransformation against the same transformation applied
+// to a std::vector<double>.  Returns "OK", or a description of the first
+// failure.
+//------------------------------------------------------------------------------
+#ifndef __Spheral_testRKCoefficients_hh__
+#define __Spheral_testRKCoefficients_hh__
+
+#include <string>
+
+namespace Spheral {
+
+template<typename Dimension>
+std::string
+testRKCoefficients(const unsigned seed);
+
+}
+
+#endif
@@ -0,0 +1,13 @@
+text = """
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "CXXTests/testRKCoefficients.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+template std::string testRKCoefficients<Dim< %(ndim)s > >(const unsigned);
+}
+
+"""
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// testSPHSumDensityAndOmegaGradh
+//------------------------------------------------------------------------------
+#include "testSPHSumDensityAndOmegaGradh.hh"
+
+#include "DataBase/DataBase.hh"
+#include "Field/FieldList.hh"
+#include "Kernel/TableKernel.hh"
+#include "Neighbor/ConnectivityMap.hh"
+#include "Neighbor/NodePairGeometry.hh"
+#include "SPH/computeSPHSumMassDensity.hh"
+#include "SPH/computeSPHOmegaGradhCorrection.hh"
+#include "SPH/computeSPHSumMassDensityAndOmegaGradh.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace Spheral {
+
+using std::string;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// The largest difference between the internal values of two FieldLists,
+// relative to the largest magnitude in the first.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+double
+maxRelativeDifference(const FieldList<Dimension, typename Dimension::Scalar>& a,
+                      const FieldList<Dimension, typename Dimension::Scalar>& b) {
+  REQUIRE(a.size() == b.size());
+  double scale = 1.0e-50, diff = 0.0;
+  for (auto nodeListi = 0u; nodeListi < a.size(); ++nodeListi) {
+    const auto n = a[nodeListi]->numInternalElements();
+    for (auto i = 0u; i < n; ++i) {
+      scale = std::max(scale, std::abs(a(nodeListi, i)));
+      diff = std::max(diff, std::abs(a(nodeListi, i) - b(nodeListi, i)));
+    }
+  }
+  return diff/scale;
+}
+
+}
+
+template<typename Dimension>
+string
+testSPHSumDensityAndOmegaGradh(const DataBase<Dimension>& dataBase,
+                               const TableKernel<Dimension>& W,
+                               const double tolerance) {
+  typedef typename Dimension::Scalar Scalar;
+
+  const auto& connectivityMap = dataBase.connectivityMap();
+  const auto  position = dataBase.fluidPosition();
+  const auto  mass = dataBase.fluidMass();
+  const auto  H = dataBase.fluidHfield();
+  auto& pairGeometry = connectivityMap.pairGeometry();
+  const auto caching0 = pairGeometry.caching();
+
+  // The answer from the separate passes, without the cache.
+  pairGeometry.caching(false);
+  auto rho0 = dataBase.newFluidFieldList(0.0, "reference mass density");
+  auto omega0 = dataBase.newFluidFieldList(0.0, "reference omega");
+  computeSPHSumMassDensity(connectivityMap, W, true, position, mass, H, rho0);
+  computeSPHOmegaGradhCorrection(connectivityMap, W, position, H, omega0);
+
+  // The fused pass with every combination of the cache and thread reduction.
+  string result = "OK";
+  for (const auto caching: {false, true}) {
+    for (const auto method: {ThreadReductionMethod::FullCopy, ThreadReductionMethod::TouchedRange}) {
+      pairGeometry.caching(caching);
+      auto rho = dataBase.newFluidFieldList(-1.0, "fused mass density");
+      auto omega = dataBase.newFluidFieldList(-1.0, "fused omega");
+      computeSPHSumMassDensityAndOmegaGradh(connectivityMap, W, true, position, mass, H, rho, omega, method);
+      const Scalar errs[2] = {maxRelativeDifference(rho0, rho), maxRelativeDifference(omega0, omega)};
+      const char* names[2] = {"mass density", "omega"};
+      for (auto k = 0u; k < 2u; ++k) {
+        if (result == "OK" and not (errs[k] <= tolerance)) {
+          std::stringstream message;
+          message << "Fused " << names[k] << " (caching " << caching << ", thread reduction " << int(method)
+                  << ") differs from the separate passes by " << errs[k];
+          result = message.str();
+        }
+      }
+    }
+  }
+
+  pairGeometry.caching(caching0);
+  return result;
+}
+
+}
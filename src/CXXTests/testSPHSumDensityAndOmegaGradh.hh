@@ -0,0 +1,29 @@
+//------------------------------------------------------------------------------
+// testSPHSumDensityAndOmegaGradh
+// Compare the fused computeSPHSumMassDensityAndOmegaGradh against
+// computeSPHSumMassDensity followed by computeSPHOmegaGradhCorrection for the
+// fluid nodes of the given DataBase, with the pair geometry cache both off and
+// on, and with each thread reduction method.  Returns "OK", or a description
+// of the first failure.
+//------------------------------------------------------------------------------
+#ifndef __Spheral_testSPHSumDensityAndOmegaGradh_hh__
+#define __Spheral_testSPHSumDensityAndOmegaGradh_hh__
+
+#include <string>
+
+namespace Spheral {
+  template<typename Dimension> class DataBase;
+  template<typename Dimension> class TableKernel;
+}
+
+namespace Spheral {
+
+template<typename Dimension>
+std::string
+testSPHSumDensityAndOmegaGradh(const DataBase<Dimension>& dataBase,
+                               const TableKernel<Dimension>& W,
+                               const double tolerance);
+
+}
+
+#endif
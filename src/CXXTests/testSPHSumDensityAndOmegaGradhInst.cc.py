@@ -0,0 +1,13 @@
+text = """
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "CXXTests/testSPHSumDensityAndOmegaGradh.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+template std::string testSPHSumDensityAndOmegaGradh<Dim< %(ndim)s > >(const DataBase<Dim< %(ndim)s > >&, const TableKernel<Dim< %(ndim)s > >&, const double);
+}
+
+"""
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// testStateSnapshots
+//------------------------------------------------------------------------------
+#include "testStateSnapshots.hh"
+
+#include "DataBase/State.hh"
+#include "Field/Field.hh"
+#include "NodeList/NodeList.hh"
+#include "Utilities/DBC.hh"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace Spheral {
+
+using std::vector;
+using std::string;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Set the Field values for the given "step".
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+setValues(Field<Dimension, typename Dimension::Scalar>& a,
+          Field<Dimension, typename Dimension::Vector>& b,
+          vector<typename Dimension::Vector>& c,
+          const double step) {
+  typedef typename Dimension::Vector Vector;
+  for (auto i = 0u; i < a.numElements(); ++i) {
+    a[i] = step + i;
+    b[i] = Vector::one*(step - 2.0*i);
+  }
+  for (auto i = 0u; i < c.size(); ++i) c[i] = Vector::one*(step*i);
+}
+
+//------------------------------------------------------------------------------
+// Check the Field values against those for the given "step".
+//------------------------------------------------------------------------------
+template<typename Dimension>
+string
+checkValues(const string& label,
+            const Field<Dimension, typename Dimension::Scalar>& a,
+            const Field<Dimension, typename Dimension::Vector>& b,
+            const vector<typename Dimension::Vector>& c,
+            const double step) {
+  typedef typename Dimension::Vector Vector;
+  std::stringstream message;
+  for (auto i = 0u; i < a.numElements(); ++i) {
+    if (a[i] != step + i or b[i] != Vector::one*(step - 2.0*i)) {
+      message << label << ":  Field values for node " << i << " are (" << a[i] << ", " << b[i]
+              << "), expected step " << step;
+      return message.str();
+    }
+  }
+  for (auto i = 0u; i < c.size(); ++i) {
+    if (c[i] != Vector::one*(step*i)) {
+      message << label << ":  vector value " << i << " is " << c[i] << ", expected step " << step;
+      return message.str();
+    }
+  }
+  return "OK";
+}
+
+}
+
+//------------------------------------------------------------------------------
+// The test.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+string
+testStateSnapshots(NodeList<Dimension>& nodes) {
+  typedef typename Dimension::Scalar Scalar;
+  typedef typename Dimension::Vector Vector;
+  typedef typename State<Dimension>::SnapshotPoolType SnapshotPoolType;
+  typedef typename State<Dimension>::SnapshotPoolPtr SnapshotPoolPtr;
+
+  // Our state:  two Fields, one of them also registered under a second key,
+  // a vector<Vector> (which copyState copies), and an int (which it doesn't).
+  const string aliasKey = "snapshot test alias", vecKey = "snapshot test vector<Vector>", intKey = "snapshot test int";
+  Field<Dimension, Scalar> a("snapshot test scalar", nodes);
+  Field<Dimension, Vector> b("snapshot test vector", nodes);
+  vector<Vector> c(10);
+  int counter = 5;
+  State<Dimension> state;
+  state.enroll(a);
+  state.enroll(b);
+  state.enrollAny(aliasKey, static_cast<FieldBase<Dimension>&>(a));
+  state.enrollAny(vecKey, c);
+  state.enrollAny(intKey, counter);
+  const auto akey = State<Dimension>::key(a), bkey = State<Dimension>::key(b);
+  setValues(a, b, c, 1.0);
+
+  // Do a few steps, as an integrator would:  snapshot the state, advance it,
+  // and then restore the snapshot.
+  SnapshotPoolPtr pool = std::make_shared<SnapshotPoolType>();
+  for (auto step = 0u; step < 3u; ++step) {
+    const auto poolSize0 = pool->size();
+    {
+      State<Dimension> snapshot(state);
+      snapshot.copyState(pool);
+
+      // The Fields should be copies, with both keys for the aliased Field
+      // referring to the same copy.
+      auto& acopy = snapshot.field(akey, Scalar());
+      auto& bcopy = snapshot.field(bkey, Vector());
+      auto& ccopy = snapshot.getAny(vecKey, vector<Vector>());
+      if (&acopy == &a or &bcopy == &b) return "copyState did not copy the Fields";
+      if (&snapshot.template getAny<FieldBase<Dimension>>(aliasKey) != &acopy) return "copyState made separate copies of a Field registered under two keys";
+      if (&ccopy == &c) return "copyState did not copy the vector<Vector>";
+      if (&snapshot.getAny(intKey, int()) != &counter) return "copyState should leave other types by reference";
+      if (step > 0u and pool->size() + 2u != poolSize0) {
+        std::stringstream message;
+        message << "copyState did not draw its Fields from the pool:  size " << poolSize0 << " -> " << pool->size();
+        return message.str();
+      }
+      auto result = checkValues("Snapshot", acopy, bcopy, ccopy, 1.0);
+      if (result != "OK") return result;
+
+      // Advance the state, which should not touch the snapshot.
+      setValues(a, b, c, 2.0 + step);
+      counter += 1;
+      result = checkValues("Snapshot after advance", acopy, bcopy, ccopy, 1.0);
+      if (result != "OK") return result;
+
+      // Restore the snapshot.
+      state.swapState(snapshot);
+      result = checkValues("Restored state", a, b, c, 1.0);
+      if (result != "OK") return result;
+      if (&state.field(akey, Scalar()) != &a or
+          &state.template getAny<FieldBase<Dimension>>(aliasKey) != &a or
+          &state.getAny(vecKey, vector<Vector>()) != &c) return "swapState changed the registered Fields";
+      if (state.getAny(intKey, int()) != 6 + int(step)) return "swapState should leave other types alone";
+    }
+
+    // The snapshot's Fields should be back in the pool.
+    if (pool->size() != 2u) {
+      std::stringstream message;
+      message << "Expected the two snapshot Fields to be returned to the pool, found " << pool->size();
+      return message.str();
+    }
+  }
+
+  // Field::swapValues.
+  Field<Dimension, Scalar> a2("snapshot test scalar 2", nodes);
+  for (auto i = 0u; i < a2.numElements(); ++i) a2[i] = -1.0*i;
+  a.swapValues(a2);
+  for (auto i = 0u; i < a.numElements(); ++i) {
+    if (a[i] != -1.0*i or a2[i] != 1.0 + i) return "Field::swapValues did not exchange the values";
+  }
+  if (a.nodeListPtr() != &nodes or a2.nodeListPtr() != &nodes or
+      a.numElements() != nodes.numNodes() or a2.numElements() != nodes.numNodes()) return "Field::swapValues changed the NodeList";
+
+  return "OK";
+}
+
+}
@@ -0,0 +1,24 @@
+//------------------------------------------------------------------------------
+// testStateSnapshots
+// Exercise the State snapshots integrators take each step:  copyState with a
+// SnapshotPool, swapState to restore the snapshot, and the underlying
+// Field::swapValues.  Returns "OK", or a description of the first failure.
+//------------------------------------------------------------------------------
+#ifndef __Spheral_testStateSnapshots_hh__
+#define __Spheral_testStateSnapshots_hh__
+
+#include <string>
+
+namespace Spheral {
+  template<typename Dimension> class NodeList;
+}
+
+namespace Spheral {
+
+template<typename Dimension>
+std::string
+testStateSnapshots(NodeList<Dimension>& nodes);
+
+}
+
+#endif
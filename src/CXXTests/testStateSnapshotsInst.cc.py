@@ -0,0 +1,12 @@
+text = """
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "CXXTests/testStateSnapshots.cc"
+
+namespace Spheral {
+template std::string testStateSnapshots<Dim< %(ndim)s > >(NodeList<Dim< %(ndim)s > >&);
+}
+
+"""
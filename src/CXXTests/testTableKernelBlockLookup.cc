@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// testTableKernelBlockLookup
+//------------------------------------------------------------------------------
+#include "testTableKernelBlockLookup.hh"
+
+#include "Kernel/TableKernel.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace Spheral {
+
+using std::vector;
+using std::string;
+
+template<typename Dimension>
+string
+testTableKernelBlockLookup(const TableKernel<Dimension>& W,
+                           const unsigned n,
+                           const unsigned seed) {
+
+  // The normalized distances:  random values out to beyond the kernel extent,
+  // plus the table points and the kernel extent itself.
+  const auto extent = W.kernelExtent();
+  const auto stepSize = extent/(W.numPoints() - 1);
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> etaDist(0.0, 1.25*extent), HdetDist(0.1, 10.0);
+  vector<double> etas, Hdets;
+  for (auto i = 0u; i < n; ++i) etas.push_back(etaDist(gen));
+  for (auto i = 0; i < W.numPoints(); ++i) etas.push_back(i*stepSize);
+  etas.push_back(extent);
+  for (auto i = 0u; i < etas.size(); ++i) Hdets.push_back(HdetDist(gen));
+  const auto m = etas.size();
+
+  // The block lookups.
+  vector<double> Wblock(m), gradWblock(m), Wblock2(m), gradWblock2(m), grad2Wblock2(m), Wvec, gradWvec;
+  W.kernelAndGradValues(&etas[0], &Hdets[0], m, &Wblock[0], &gradWblock[0]);
+  W.kernelAndGradValues(&etas[0], &Hdets[0], m, &Wblock2[0], &gradWblock2[0], &grad2Wblock2[0]);
+  W.kernelAndGradValues(etas, Hdets, Wvec, gradWvec);
+  if (Wvec.size() != m or gradWvec.size() != m) return "std::vector kernelAndGradValues returned the wrong number of values";
+
+  // The block lookups evaluate the same parabolic fits as the scalar lookups,
+  // so they should agree to round off.
+  const auto scale = std::max(1.0, std::abs(W.kernelValue(0.0, 1.0)));
+  for (auto k = 0u; k < m; ++k) {
+    const auto WgradW = W.kernelAndGradValue(etas[k], Hdets[k]);
+    const auto grad2W = W.grad2Value(etas[k], Hdets[k]);
+    const auto tol = 1.0e-10*scale*Hdets[k];
+    const double vals[6] = {Wblock[k], gradWblock[k], Wblock2[k], gradWblock2[k], Wvec[k], gradWvec[k]};
+    const double ans[6] = {WgradW.first, WgradW.second, WgradW.first, WgradW.second, WgradW.first, WgradW.second};
+    for (auto j = 0u; j < 6u; ++j) {
+      if (std::abs(vals[j] - ans[j]) > tol) {
+        std::stringstream message;
+        message << "Block lookup " << j << " for eta=" << etas[k] << ", Hdet=" << Hdets[k]
+                << " : " << vals[j] << " != " << ans[j];
+        return message.str();
+      }
+    }
+    if (std::abs(grad2Wblock2[k] - grad2W) > tol) {
+      std::stringstream message;
+      message << "Block grad2 lookup for eta=" << etas[k] << ", Hdet=" << Hdets[k]
+              << " : " << grad2Wblock2[k] << " != " << grad2W;
+      return message.str();
+    }
+  }
+  return "OK";
+}
+
+}
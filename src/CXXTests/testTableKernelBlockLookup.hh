@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------
+// testTableKernelBlockLookup
+// Compare the block TableKernel::kernelAndGradValues lookups (with and without
+// the second derivative, and the std::vector version) against the scalar
+// kernelAndGradValue and grad2Value lookups, for random normalized distances
+// spanning the kernel extent and beyond.  Returns "OK", or a description of
+// the first failure.
+//------------------------------------------------------------------------------
+#ifndef __Spheral_testTableKernelBlockLookup_hh__
+#define __Spheral_testTableKernelBlockLookup_hh__
+
+#include <string>
+
+namespace Spheral {
+  template<typename Dimension> class TableKernel;
+}
+
+namespace Spheral {
+
+template<typename Dimension>
+std::string
+testTableKernelBlockLookup(const TableKernel<Dimension>& W,
+                           const unsigned n,
+                           const unsigned seed);
+
+}
+
+#endif
@@ -0,0 +1,13 @@
+text = """
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "CXXTests/testTableKernelBlockLookup.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+template std::string testTableKernelBlockLookup<Dim< %(ndim)s > >(const TableKernel<Dim< %(ndim)s > >&, const unsigned, const unsigned);
+}
+
+"""
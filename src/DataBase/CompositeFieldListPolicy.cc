@@ -115,6 +115,19 @@ operator==(const UpdatePolicyBase<Dimension>& rhs) const {
   return (this->mPolicyPtrs == rhsPtr->mPolicyPtrs);
 }
 
+//------------------------------------------------------------------------------
+// Can we be fired concurrently with other policies?
+//------------------------------------------------------------------------------
+template<typename Dimension, typename ValueType>
+bool
+CompositeFieldListPolicy<Dimension, ValueType>::
+concurrentUpdate() const {
+  for (const auto& policyPtr: mPolicyPtrs) {
+    if (not policyPtr->concurrentUpdate()) return false;
+  }
+  return true;
+}
+
 //------------------------------------------------------------------------------
 // Add a new UpdatePolicy to this thing.
 //------------------------------------------------------------------------------
@@ -52,6 +52,9 @@ public:
   // Equivalence.
   virtual bool operator==(const UpdatePolicyBase<Dimension>& rhs) const;
 
+  // We can only be fired concurrently if all our policies can.
+  virtual bool concurrentUpdate() const;
+
   // Add new UpdatePolicies to this thing.
   void push_back(UpdatePolicyBase<Dimension>* policyPtr);
 
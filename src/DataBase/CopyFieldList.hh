@@ -38,6 +38,9 @@ public:
   // Equivalence.
   virtual bool operator==(const UpdatePolicyBase<Dimension>& rhs) const;
 
+  // A simple serial update of our own state, so safe to fire concurrently.
+  virtual bool concurrentUpdate() const { return this->template exactPolicyType<CopyFieldList>(); }
+
   static const std::string prefix() { return "delta "; }
 
 private:
@@ -1520,12 +1520,8 @@ DataBase<Dimension>::numNeighbors() const {
     Field<Dimension, int>& count = **(result.fieldForNodeList(nodes));
     for (auto i = 0u; i != nodes.numInternalNodes(); ++i) {
       count(i) = 0;
-      const vector< vector<int> >& connectivity = mConnectivityMapPtr->connectivityForNode(&nodes, i);
-      for (typename vector< vector<int> >::const_iterator itr = connectivity.begin();
-           itr != connectivity.end();
-           ++itr) {
-        count(i) += itr->size();
-      }
+      const auto connectivity = mConnectivityMapPtr->connectivityForNode(&nodes, i);
+      for (const auto& neighbors: connectivity) count(i) += neighbors.size();
     }
   }
   return result;
@@ -1763,11 +1759,11 @@ localSamplingBoundingBoxes(vector<typename Dimension::Vector>& xminima,
         flags(nodeListi, i) = 1;
 
         // Find the min/max extent of this connected set of nodes.
-        const vector<vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(&nodeList, i);
+        const auto fullConnectivity = connectivityMap.connectivityForNode(&nodeList, i);
         CHECK((int)fullConnectivity.size() == numNodeLists);
         for (int nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
-          const vector<int>& connectivity = fullConnectivity[nodeListj];
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          const auto connectivity = fullConnectivity[nodeListj];
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             const int j = *jItr;
@@ -141,12 +141,18 @@ update(const KeyType& key,
   const FieldList<Dimension, ValueType> df = derivs.fields(incrementKey, ValueType());
   CHECK(f.size() == df.size());
 
-  // Loop over the internal values of the field.
+  // Loop over the internal values of the field (or the nodes the update is
+  // restricted to).
   const unsigned numNodeLists = f.size();
   for (unsigned k = 0; k != numNodeLists; ++k) {
-    const unsigned n = f[k]->numInternalElements();
-    for (unsigned i = 0; i != n; ++i) {
-      f(k, i) = min(mMaxValue, max(mMinValue, f(k, i) + multiplier*(df(k, i))));
+    const auto* ids = state.restrictedNodes(f[k]->nodeList());
+    if (ids == nullptr) {
+      const unsigned n = f[k]->numInternalElements();
+      for (unsigned i = 0; i != n; ++i) {
+        f(k, i) = min(mMaxValue, max(mMinValue, f(k, i) + multiplier*(df(k, i))));
+      }
+    } else {
+      for (const auto i: *ids) f(k, i) = min(mMaxValue, max(mMinValue, f(k, i) + multiplier*(df(k, i))));
     }
   }
 }
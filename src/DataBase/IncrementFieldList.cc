@@ -148,9 +148,14 @@ update(const KeyType& key,
     const auto df = derivs.fields(key, Value());
     CHECK(df.size() == f.size());
     for (auto k = 0u; k != numNodeLists; ++k) {
-      const auto n = f[k]->numInternalElements();
-      for (auto i = 0u; i != n; ++i) {
-        f(k, i) += multiplier*(df(k, i));
+      const auto* ids = state.restrictedNodes(f[k]->nodeList());
+      if (ids == nullptr) {
+        const auto n = f[k]->numInternalElements();
+        for (auto i = 0u; i != n; ++i) {
+          f(k, i) += multiplier*(df(k, i));
+        }
+      } else {
+        for (const auto i: *ids) f(k, i) += multiplier*(df(k, i));
       }
     }
   }
@@ -99,9 +99,15 @@ update(const KeyType& key,
   Field<Dimension, Value>& f = state.field(key, Value());
   const Field<Dimension, Value>& df = derivs.field(incrementKey, Value());
 
-  // Loop over the internal values of the field.
-  for (unsigned i = 0; i != f.nodeList().numInternalNodes(); ++i) {
-    f(i) += multiplier*(df(i));
+  // Loop over the internal values of the field (or the nodes the update is
+  // restricted to).
+  const auto* ids = state.restrictedNodes(f.nodeList());
+  if (ids == nullptr) {
+    for (unsigned i = 0; i != f.nodeList().numInternalNodes(); ++i) {
+      f(i) += multiplier*(df(i));
+    }
+  } else {
+    for (const auto i: *ids) f(i) += multiplier*(df(i));
   }
 }
 
@@ -105,12 +105,18 @@ update(const KeyType& key,
   const FieldList<Dimension, Value> df = derivs.fields(replaceKey, Value());
   CHECK(f.size() == df.size());
 
-  // Loop over the internal values of the field.
+  // Loop over the internal values of the field (or the nodes the update is
+  // restricted to).
   const unsigned numNodeLists = f.size();
   for (unsigned k = 0; k != numNodeLists; ++k) {
-    const unsigned n = f[k]->numInternalElements();
-    for (unsigned i = 0; i != n; ++i) {
-      f(k, i) = df(k, i);
+    const auto* ids = state.restrictedNodes(f[k]->nodeList());
+    if (ids == nullptr) {
+      const unsigned n = f[k]->numInternalElements();
+      for (unsigned i = 0; i != n; ++i) {
+        f(k, i) = df(k, i);
+      }
+    } else {
+      for (const auto i: *ids) f(k, i) = df(k, i);
     }
   }
 }
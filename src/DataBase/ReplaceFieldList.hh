@@ -49,6 +49,11 @@ public:
   // Equivalence.
   virtual bool operator==(const UpdatePolicyBase<Dimension>& rhs) const;
 
+  // A simple serial update of our own state node by node, so safe to fire
+  // concurrently or restricted to a subset of the nodes.
+  virtual bool concurrentUpdate() const { return this->template exactPolicyType<ReplaceFieldList>(); }
+  virtual bool restrictedUpdate() const { return this->template exactPolicyType<ReplaceFieldList>(); }
+
   static const std::string prefix() { return "new "; }
 
 private:
@@ -100,9 +100,15 @@ update(const KeyType& key,
   Field<Dimension, ValueType>& f = state.field(key, ValueType());
   const Field<Dimension, ValueType>& df = derivs.field(replaceKey, ValueType());
 
-  // Loop over the internal values of the field.
-  for (auto i = 0u; i != f.nodeList().numInternalNodes(); ++i) {
-    f(i) = df(i);
+  // Loop over the internal values of the field (or the nodes the update is
+  // restricted to).
+  const auto* ids = state.restrictedNodes(f.nodeList());
+  if (ids == nullptr) {
+    for (auto i = 0u; i != f.nodeList().numInternalNodes(); ++i) {
+      f(i) = df(i);
+    }
+  } else {
+    for (const auto i: *ids) f(i) = df(i);
   }
 }
 
@@ -13,8 +13,13 @@
 #include "Field/Field.hh"
 #include "Field/FieldList.hh"
 #include "Geometry/Dimension.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/timingUtilities.hh"
+#include "Utilities/DBC.hh"
+#include "NodeList/NodeList.hh"
 
 #include <string>
+#include <exception>
 using std::vector;
 using std::map;
 using std::set;
@@ -81,7 +86,12 @@ State<Dimension>::
 State():
   StateBase<Dimension>(),
   mPolicyMap(),
-  mTimeAdvanceOnly(false) {
+  mTimeAdvanceOnly(false),
+  mConcurrentPolicyUpdates(true),
+  mMeasureWork(false),
+  mPolicyLevelsValid(false),
+  mPolicyLevels(),
+  mRestrictedNodes() {
 }
 
 //------------------------------------------------------------------------------
@@ -93,7 +103,12 @@ State(DataBase<Dimension>& dataBase,
       typename State<Dimension>::PackageList& physicsPackages):
   StateBase<Dimension>(),
   mPolicyMap(),
-  mTimeAdvanceOnly(false) {
+  mTimeAdvanceOnly(false),
+  mConcurrentPolicyUpdates(true),
+  mMeasureWork(false),
+  mPolicyLevelsValid(false),
+  mPolicyLevels(),
+  mRestrictedNodes() {
   // Iterate over the physics packages, and have them register their state.
   for (PackageIterator itr = physicsPackages.begin();
        itr != physicsPackages.end();
@@ -110,7 +125,12 @@ State(DataBase<Dimension>& dataBase,
       typename State<Dimension>::PackageIterator physicsPackageEnd):
   StateBase<Dimension>(),
   mPolicyMap(),
-  mTimeAdvanceOnly(false) {
+  mTimeAdvanceOnly(false),
+  mConcurrentPolicyUpdates(true),
+  mMeasureWork(false),
+  mPolicyLevelsValid(false),
+  mPolicyLevels(),
+  mRestrictedNodes() {
   // Iterate over the physics packages, and have them register their state.
   for (PackageIterator itr = physicsPackageBegin;
        itr != physicsPackageEnd;
@@ -125,7 +145,12 @@ State<Dimension>::
 State(const State<Dimension>& rhs):
   StateBase<Dimension>(rhs),
   mPolicyMap(rhs.mPolicyMap),
-  mTimeAdvanceOnly(rhs.mTimeAdvanceOnly) {
+  mTimeAdvanceOnly(rhs.mTimeAdvanceOnly),
+  mConcurrentPolicyUpdates(rhs.mConcurrentPolicyUpdates),
+  mMeasureWork(rhs.mMeasureWork),
+  mPolicyLevelsValid(false),
+  mPolicyLevels(),
+  mRestrictedNodes(rhs.mRestrictedNodes) {
 }
 
 //------------------------------------------------------------------------------
@@ -147,6 +172,11 @@ operator=(const State<Dimension>& rhs) {
     StateBase<Dimension>::operator=(rhs);
     mPolicyMap = rhs.mPolicyMap;
     mTimeAdvanceOnly = rhs.mTimeAdvanceOnly;
+    mConcurrentPolicyUpdates = rhs.mConcurrentPolicyUpdates;
+    mMeasureWork = rhs.mMeasureWork;
+    mPolicyLevelsValid = false;
+    mPolicyLevels.clear();
+    mRestrictedNodes = rhs.mRestrictedNodes;
   }
   return *this;
 }
@@ -163,7 +193,9 @@ operator==(const StateBase<Dimension>& rhs) const {
 
 //------------------------------------------------------------------------------
 // Update the state with the given derivatives object, according to the per
-// state field policies.
+// state field policies.  The policies are fired level by level through the
+// cached dependency graph; policies within a level are independent of one
+// another, and can optionally be fired concurrently.
 //------------------------------------------------------------------------------
 template<typename Dimension>
 void
@@ -173,7 +205,146 @@ update(StateDerivatives<Dimension>& derivs,
        const double t,
        const double dt) {
 
-  // cerr << "################################################################################" << endl;
+  const auto& levels = this->currentPolicyLevels();
+  const bool threaded = (mConcurrentPolicyUpdates and
+                         omp_get_max_threads() > 1 and
+                         omp_in_parallel() == 0);
+  for (const auto& level: levels) {
+
+    // Split out the policies we can fire concurrently.
+    vector<const PolicyNode*> concurrent, serial;
+    for (const auto& node: level) {
+      if (threaded and node.policy->concurrentUpdate()) {
+        concurrent.push_back(&node);
+      } else {
+        serial.push_back(&node);
+      }
+    }
+    if (concurrent.size() < 2) {
+      serial.insert(serial.begin(), concurrent.begin(), concurrent.end());
+      concurrent.clear();
+    }
+
+    // Fire each concurrent policy as a task.  Exceptions can't escape a task,
+    // so we capture the first one and rethrow it once the tasks are done.
+    if (not concurrent.empty()) {
+      const int n = concurrent.size();
+      std::exception_ptr error;
+#pragma omp parallel
+      {
+#pragma omp single
+        {
+          for (auto k = 0; k < n; ++k) {
+#pragma omp task firstprivate(k) shared(concurrent, derivs, error)
+            {
+              try {
+                this->firePolicy(*concurrent[k], derivs, multiplier, t, dt);
+              } catch (...) {
+#pragma omp critical (State_update_error)
+                if (not error) error = std::current_exception();
+              }
+            }
+          }
+        }
+      }
+      if (error) std::rethrow_exception(error);
+    }
+
+    // The rest are fired in order on this thread.
+    for (const auto* nodePtr: serial) this->firePolicy(*nodePtr, derivs, multiplier, t, dt);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Restrict the update to a subset of the nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+State<Dimension>::
+restrictUpdate(const map<const NodeList<Dimension>*, vector<int>>& nodeIDs) {
+  BEGIN_CONTRACT_SCOPE
+  {
+    for (const auto& x: nodeIDs) {
+      const auto& ids = x.second;
+      for (auto k = 0u; k < ids.size(); ++k) {
+        REQUIRE(ids[k] >= 0 and ids[k] < int(x.first->numInternalNodes()));
+        REQUIRE(k == 0u or ids[k] > ids[k - 1u]);
+      }
+    }
+  }
+  END_CONTRACT_SCOPE
+  mRestrictedNodes = nodeIDs;
+}
+
+//------------------------------------------------------------------------------
+// Lift any restriction on the update.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+State<Dimension>::
+unrestrictUpdate() {
+  mRestrictedNodes.clear();
+}
+
+//------------------------------------------------------------------------------
+// The policy keys in each level of the dependency graph.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<vector<typename State<Dimension>::KeyType>>
+State<Dimension>::
+policyLevels() {
+  const auto& levels = this->currentPolicyLevels();
+  vector<vector<KeyType>> result(levels.size());
+  for (auto ilevel = 0u; ilevel < levels.size(); ++ilevel) {
+    for (const auto& node: levels[ilevel]) result[ilevel].push_back(node.key);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Return the cached dependency levels, rebuilding them if the policies have
+// changed since they were last computed.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+const typename State<Dimension>::PolicyLevelsType&
+State<Dimension>::
+currentPolicyLevels() {
+  if (not this->policyLevelsCurrent()) this->buildPolicyLevels();
+  ENSURE(mPolicyLevelsValid);
+  return mPolicyLevels;
+}
+
+//------------------------------------------------------------------------------
+// Check whether the cached dependency levels are still current.  Enrolling or
+// removing policies invalidates the cache directly, but we also have to catch
+// policies that have had dependencies added since the graph was built.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+State<Dimension>::
+policyLevelsCurrent() const {
+  if (not mPolicyLevelsValid) return false;
+  for (const auto& level: mPolicyLevels) {
+    for (const auto& node: level) {
+      if (node.policy->dependencies().size() != node.numDependencies) return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Sort the policies into levels of the dependency graph.  A policy can fire
+// once none of the field names it depends upon have policies still waiting to
+// fire.  We also require that any FieldList (wildcard) policies fire before
+// NodeList specific versions of the same Field names.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+State<Dimension>::
+buildPolicyLevels() {
+
+  mPolicyLevels.clear();
+  mPolicyLevelsValid = false;
 
   // Prepare lists of the keys to be completed.
   vector<KeyType> fieldsToBeCompleted;
@@ -192,22 +363,22 @@ update(StateDerivatives<Dimension>& derivs,
        ++itr) fieldsToBeCompleted.push_back(itr->first);
   CHECK(fieldsToBeCompleted.size() == stateToBeCompleted.size());
 
-  // Iterate until all state has been updated.
+  // Iterate until all state has been assigned a level.
   while (not stateToBeCompleted.empty()) {
 
     // Walk the remaining state to be completed.
-    vector<KeyType> stateToRemove;
+    vector<PolicyNode> level;
     for (typename map<KeyType, set<KeyType> >::iterator itr = stateToBeCompleted.begin();
          itr != stateToBeCompleted.end();
          ++itr) {
       const KeyType fieldKey = itr->first;
-      const set<KeyType>& remainingKeys = stateToBeCompleted[fieldKey];
+      const set<KeyType>& remainingKeys = itr->second;
 
       // Walk the remaining individual keys for this fieldKey.
-      for (typename set<KeyType>::const_iterator itr = remainingKeys.begin();
-           itr != remainingKeys.end();
-           ++itr) {
-        const KeyType key = *itr;
+      for (typename set<KeyType>::const_iterator kitr = remainingKeys.begin();
+           kitr != remainingKeys.end();
+           ++kitr) {
+        const KeyType key = *kitr;
         const PolicyPointer policyPtr = mPolicyMap[fieldKey][key];
 
         // Check if all the dependencies for this state have been satisfied yet.
@@ -217,34 +388,22 @@ update(StateDerivatives<Dimension>& derivs,
                          back_inserter(unmetDependencies));
         if (unmetDependencies.empty()) {
 
-          // We also require that any FieldList policies fire before NodeList specific 
-          // versions of the same Field names.
+          // Wildcard policies have to precede NodeList specific versions.
           KeyType fieldKey, nodeListKey;
           this->splitFieldKey(key, fieldKey, nodeListKey);
-          bool fire = (nodeListKey == UpdatePolicyBase<Dimension>::wildcard());
-          if (not fire) {
+          bool ready = (nodeListKey == UpdatePolicyBase<Dimension>::wildcard());
+          if (not ready) {
             const KeyType wildKey = this->buildFieldKey(fieldKey, UpdatePolicyBase<Dimension>::wildcard());
-            fire = (find(remainingKeys.begin(), remainingKeys.end(), wildKey) == remainingKeys.end());
-          }
-
-          if (fire) {
-            // cerr <<" --> Update " << key << endl;
-            if (mTimeAdvanceOnly) {
-              policyPtr->updateAsIncrement(key, *this, derivs, multiplier, t, dt);
-            } else {
-              policyPtr->update(key, *this, derivs, multiplier, t, dt);
-            }
-
-            // List this field as completed.
-            stateToRemove.push_back(key);
+            ready = (find(remainingKeys.begin(), remainingKeys.end(), wildKey) == remainingKeys.end());
           }
+          if (ready) level.push_back(PolicyNode{key, policyPtr, policyPtr->dependencies().size()});
         }
       }
     }
 
-    // Check that the some state has been updated on this iteration.  If not, then *somebody*
+    // Check that the some state was ready on this iteration.  If not, then *somebody*
     // has specified a circular dependency tree!
-    if (stateToRemove.empty()) {
+    if (level.empty()) {
       std::stringstream message;
       message << "State::update ERROR: someone has specified a circular state dependency.\n"
               << "Remaining State:\n";
@@ -255,7 +414,6 @@ update(StateDerivatives<Dimension>& derivs,
       for (typename PolicyMapType::iterator itr = mPolicyMap.begin();
            itr != mPolicyMap.end();
            ++itr) {
-        const KeyType fieldKey = itr->first;
         const map<KeyType, PolicyPointer>& keysAndPolicies = itr->second;
         for (typename map<KeyType, PolicyPointer>::const_iterator pitr = keysAndPolicies.begin();
              pitr != keysAndPolicies.end();
@@ -269,17 +427,15 @@ update(StateDerivatives<Dimension>& derivs,
           message << "\n";
         }
       }
-      VERIFY2(not stateToRemove.empty(), message.str());
+      VERIFY2(not level.empty(), message.str());
     }
-    
+
     // Remove the completed state.
-    for (typename vector<KeyType>::const_iterator keyItr = stateToRemove.begin();
-         keyItr != stateToRemove.end();
-         ++keyItr) {
+    for (const auto& node: level) {
       KeyType fieldKey, nodeListKey;
-      this->splitFieldKey(*keyItr, fieldKey, nodeListKey);
+      this->splitFieldKey(node.key, fieldKey, nodeListKey);
       CHECK(stateToBeCompleted.find(fieldKey) != stateToBeCompleted.end());
-      stateToBeCompleted[fieldKey].erase(*keyItr);
+      stateToBeCompleted[fieldKey].erase(node.key);
       if (stateToBeCompleted[fieldKey].empty()) stateToBeCompleted.erase(fieldKey);
     }
     fieldsToBeCompleted = vector<KeyType>();
@@ -287,6 +443,86 @@ update(StateDerivatives<Dimension>& derivs,
          itr != stateToBeCompleted.end();
          ++itr) fieldsToBeCompleted.push_back(itr->first);
     CHECK(fieldsToBeCompleted.size() == stateToBeCompleted.size());
+    mPolicyLevels.push_back(level);
+  }
+  mPolicyLevelsValid = true;
+}
+
+//------------------------------------------------------------------------------
+// Apply a single policy.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+State<Dimension>::
+firePolicy(const PolicyNode& node,
+           StateDerivatives<Dimension>& derivs,
+           const double multiplier,
+           const double t,
+           const double dt) {
+  const auto start = (mMeasureWork ? Timing::currentTime() : Timing::Time());
+
+  // If the update is restricted to a subset of the nodes and this policy
+  // doesn't know how to honor that, save the values of the other nodes of its
+  // Fields so we can put them back after it fires.
+  vector<FieldBase<Dimension>*> savedFields;
+  vector<vector<int>> savedIDs;
+  vector<vector<char>> savedValues;
+  if (not (mRestrictedNodes.empty() or node.policy->restrictedUpdate())) {
+    KeyType fieldKey, nodeListKey;
+    this->splitFieldKey(node.key, fieldKey, nodeListKey);
+    const auto& index = this->fieldNameIndex();
+    const auto indexItr = index.find(fieldKey);
+    const auto fieldPtrs = (indexItr == index.end() ? vector<FieldBase<Dimension>*>() : indexItr->second.fields);
+    for (auto* fieldPtr: fieldPtrs) {
+      const auto& nodeList = fieldPtr->nodeList();
+      const auto* ids = this->restrictedNodes(nodeList);
+      if (ids != nullptr and
+          (nodeListKey == UpdatePolicyBase<Dimension>::wildcard() or nodeListKey == nodeList.name())) {
+        vector<int> others;
+        auto itr = ids->begin();
+        for (auto i = 0; i < int(nodeList.numInternalNodes()); ++i) {
+          if (itr != ids->end() and *itr == i) {
+            ++itr;
+          } else {
+            others.push_back(i);
+          }
+        }
+        if (not others.empty()) {
+          savedFields.push_back(fieldPtr);
+          savedValues.push_back(fieldPtr->packValues(others));
+          savedIDs.push_back(others);
+        }
+      }
+    }
+  }
+
+  if (mTimeAdvanceOnly) {
+    node.policy->updateAsIncrement(node.key, *this, derivs, multiplier, t, dt);
+  } else {
+    node.policy->update(node.key, *this, derivs, multiplier, t, dt);
+  }
+  for (auto k = 0u; k < savedFields.size(); ++k) savedFields[k]->unpackValues(savedIDs[k], savedValues[k]);
+
+  // If we're measuring the work, charge the time spent on a NodeList specific
+  // policy (such as an equation of state or strength model) to the nodes of
+  // that NodeList.  Policies that span all NodeLists are left to the caller
+  // to account for.
+  if (mMeasureWork) {
+    const auto elapsed = Timing::difference(start, Timing::currentTime());
+    KeyType fieldKey, nodeListKey;
+    this->splitFieldKey(node.key, fieldKey, nodeListKey);
+    for (const auto* nodeListPtr: this->mNodeListPtrs) {
+      if (nodeListPtr->name() == nodeListKey) {
+        const auto n = nodeListPtr->numInternalNodes();
+        if (n > 0) {
+          auto& work = nodeListPtr->work();
+#pragma omp critical (State_firePolicy_work)
+          {
+            for (auto i = 0u; i < n; ++i) work(i) += elapsed/n;
+          }
+        }
+      }
+    }
   }
 }
 
@@ -348,6 +584,7 @@ removePolicy(const typename State<Dimension>::KeyType& key) {
   }
   policies.erase(innerItr);
   if (policies.size() == 0) mPolicyMap.erase(outerItr);
+  mPolicyLevelsValid = false;
 }
 
 //------------------------------------------------------------------------------
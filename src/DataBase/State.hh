@@ -22,6 +22,7 @@ template<typename Dimension> class StateDerivatives;
 template<typename Dimension, typename DataType> class Field;
 template<typename Dimension> class DataBase;
 template<typename Dimension> class Physics;
+template<typename Dimension> class NodeList;
 
 template<typename Dimension>
 class State: public StateBase<Dimension> {
@@ -98,11 +99,64 @@ public:
   bool timeAdvanceOnly() const;
   void timeAdvanceOnly(const bool x);
 
+  // Optionally fire independent policies (those in the same level of the
+  // dependency graph) concurrently as OpenMP tasks.  Only policies that opt in
+  // via UpdatePolicyBase::concurrentUpdate are fired this way.
+  bool concurrentPolicyUpdates() const;
+  void concurrentPolicyUpdates(const bool x);
+
+  // Optionally time each policy as it fires, adding the time spent on NodeList
+  // specific policies to the work of those nodes (NodeList::work).
+  bool measureWork() const;
+  void measureWork(const bool x);
+
+  // Optionally restrict update to a subset of the internal nodes, given as a
+  // sorted list of node indices per NodeList (NodeLists not in the map are
+  // updated in full).  Policies that opt in via UpdatePolicyBase::restrictedUpdate
+  // only visit those nodes; for any other policy we put back the values of the
+  // remaining nodes of its Fields once it has fired.
+  void restrictUpdate(const std::map<const NodeList<Dimension>*, std::vector<int>>& nodeIDs);
+  void unrestrictUpdate();
+
+  // The nodes of the NodeList the update is restricted to, or nullptr if all
+  // of its internal nodes are updated.
+  const std::vector<int>* restrictedNodes(const NodeList<Dimension>& nodeList) const;
+
+  // The policy keys grouped into levels of the dependency graph, in the order
+  // they are fired by update.  Policies in a level depend only on state
+  // completed in earlier levels.
+  std::vector<std::vector<KeyType>> policyLevels();
+
 private:
   //--------------------------- Private Interface ---------------------------//
   typedef std::map<KeyType, std::map<KeyType, PolicyPointer> > PolicyMapType;
+
+  // A policy in the cached dependency graph.  We remember how many
+  // dependencies it had when the graph was built, since policies can acquire
+  // new dependencies after they are enrolled.
+  struct PolicyNode {
+    KeyType key;
+    PolicyPointer policy;
+    size_t numDependencies;
+  };
+  typedef std::vector<std::vector<PolicyNode>> PolicyLevelsType;
+
   PolicyMapType mPolicyMap;
-  bool mTimeAdvanceOnly;
+  bool mTimeAdvanceOnly, mConcurrentPolicyUpdates, mMeasureWork, mPolicyLevelsValid;
+  PolicyLevelsType mPolicyLevels;
+  std::map<const NodeList<Dimension>*, std::vector<int>> mRestrictedNodes;
+
+  // Build (if necessary) and return the cached dependency levels.
+  const PolicyLevelsType& currentPolicyLevels();
+  bool policyLevelsCurrent() const;
+  void buildPolicyLevels();
+
+  // Apply a single policy.
+  void firePolicy(const PolicyNode& node,
+                  StateDerivatives<Dimension>& derivs,
+                  const double multiplier,
+                  const double t,
+                  const double dt);
 };
 
 }
@@ -14,6 +14,9 @@
 
 #include <algorithm>
 #include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 using std::vector;
 using std::cout;
 using std::cerr;
@@ -50,7 +53,9 @@ StateBase():
   mStorage(),
   mCache(),
   mConnectivityMapPtr(),
-  mMeshPtr(new MeshType()) {
+  mMeshPtr(new MeshType()),
+  mSnapshotPoolPtr(),
+  mFieldNameIndex() {
 }
 
 //------------------------------------------------------------------------------
@@ -63,7 +68,10 @@ StateBase(const StateBase<Dimension>& rhs):
   mCache(),
   mNodeListPtrs(rhs.mNodeListPtrs),
   mConnectivityMapPtr(rhs.mConnectivityMapPtr),
-  mMeshPtr(rhs.mMeshPtr) {
+  mMeshPtr(rhs.mMeshPtr),
+  mSnapshotPoolPtr(),
+  mFieldNameIndex() {
+  this->rebuildFieldIndex();
 }
 
 //------------------------------------------------------------------------------
@@ -72,6 +80,7 @@ StateBase(const StateBase<Dimension>& rhs):
 template<typename Dimension>
 StateBase<Dimension>::
 ~StateBase() {
+  releaseFieldCache(mFieldCache, mSnapshotPoolPtr);
 }
 
 //------------------------------------------------------------------------------
@@ -87,6 +96,7 @@ operator=(const StateBase<Dimension>& rhs) {
     mNodeListPtrs = rhs.mNodeListPtrs;
     mConnectivityMapPtr = rhs.mConnectivityMapPtr;
     mMeshPtr = rhs.mMeshPtr;
+    this->rebuildFieldIndex();
   }
   return *this;
 }
@@ -187,14 +197,19 @@ template<typename Dimension>
 bool
 StateBase<Dimension>::
 fieldNameRegistered(const FieldName& name) const {
-  KeyType fieldName, nodeListName;
-  auto itr = mStorage.begin();
-  while (itr != mStorage.end()) {
-    splitFieldKey(itr->first, fieldName, nodeListName);
-    if (fieldName == name) return true;
-    ++itr;
-  }
-  return false;
+  return (mFieldNameIndex.find(name) != mFieldNameIndex.end());
+}
+
+//------------------------------------------------------------------------------
+// Return all the registered fields.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<FieldBase<Dimension>*>
+StateBase<Dimension>::
+allFieldBases() const {
+  vector<FieldBase<Dimension>*> result;
+  for (const auto& x: mFieldNameIndex) result.insert(result.end(), x.second.fields.begin(), x.second.fields.end());
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -207,7 +222,14 @@ enroll(FieldBase<Dimension>& field) {
   const KeyType key = this->key(field);
   boost::any fieldptr;
   fieldptr = &field;
-  mStorage[key] = fieldptr;
+  const auto itr = mStorage.find(key);
+  if (itr == mStorage.end()) {
+    mStorage[key] = fieldptr;
+    this->indexKey(key);
+  } else {
+    itr->second = fieldptr;
+    this->rebuildFieldIndex();
+  }
   mNodeListPtrs.insert(field.nodeListPtr());
   // std::cerr << "StateBase::enroll field:  " << key << " at " << &field << std::endl;
   ENSURE(&(this->getAny<FieldBase<Dimension>>(key)) == &field);
@@ -222,7 +244,14 @@ void
 StateBase<Dimension>::
 enroll(std::shared_ptr<FieldBase<Dimension>>& fieldPtr) {
   const KeyType key = this->key(*fieldPtr);
-  mStorage[key] = fieldPtr.get();
+  const auto itr = mStorage.find(key);
+  if (itr == mStorage.end()) {
+    mStorage[key] = fieldPtr.get();
+    this->indexKey(key);
+  } else {
+    itr->second = fieldPtr.get();
+    this->rebuildFieldIndex();
+  }
   mNodeListPtrs.insert(fieldPtr->nodeListPtr());
   mFieldCache.push_back(fieldPtr);
   ENSURE(find(mNodeListPtrs.begin(), mNodeListPtrs.end(), fieldPtr->nodeListPtr()) != mNodeListPtrs.end());
@@ -265,21 +294,12 @@ template<typename Dimension>
 std::vector<typename FieldBase<Dimension>::FieldName>
 StateBase<Dimension>::
 fieldKeys() const {
-  KeyType fieldName, nodeListName;
   vector<typename FieldBase<Dimension>::FieldName> result;
-  result.reserve(mStorage.size());
-  for (typename StorageType::const_iterator itr = mStorage.begin();
-       itr != mStorage.end();
-       ++itr) {
-    splitFieldKey(itr->first, fieldName, nodeListName);
-    if (fieldName != "" and nodeListName != "") result.push_back(fieldName);
+  result.reserve(mFieldNameIndex.size());
+  for (const auto& x: mFieldNameIndex) {
+    if (not x.second.fields.empty()) result.push_back(x.first);
   }
-
-  // Remove any duplicates.  This will happen when we've stored the same field
-  // for different NodeLists.
   sort(result.begin(), result.end());
-  result.erase(unique(result.begin(), result.end()), result.end());
-
   return result;
 }
 
@@ -386,6 +406,71 @@ assign(const StateBase<Dimension>& rhs) {
     }
   }
 
+  // Copy the connectivity and mesh.
+  this->assignConnectivityAndMesh(rhs);
+}
+
+//------------------------------------------------------------------------------
+// Assign the state data of this State object to be equal to the values in
+// another by exchanging the Field values with it.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+swapState(StateBase<Dimension>& rhs) {
+
+  // Extract the keys for each state, and verify they line up.
+  REQUIRE(mStorage.size() == rhs.mStorage.size());
+  vector<KeyType> lhsKeys = keys();
+  vector<KeyType> rhsKeys = rhs.keys();
+  REQUIRE(lhsKeys.size() == rhsKeys.size());
+  sort(lhsKeys.begin(), lhsKeys.end());
+  sort(rhsKeys.begin(), rhsKeys.end());
+  REQUIRE(lhsKeys == rhsKeys);
+
+  // Walk the keys, swapping where we can and falling back to copying (if for
+  // instance the number of nodes has changed).  A Field registered under more
+  // than one key is only exchanged once.
+  std::unordered_set<FieldBase<Dimension>*> exchanged;
+  for (auto itr = rhs.mStorage.begin();
+       itr != rhs.mStorage.end();
+       ++itr) {
+    auto& anylhs = mStorage[itr->first];
+    auto& anyrhs = itr->second;
+    try {
+      auto lhsptr = boost::any_cast<FieldBase<Dimension>*>(anylhs);
+      auto rhsptr = boost::any_cast<FieldBase<Dimension>*>(anyrhs);
+      if (lhsptr != rhsptr and exchanged.insert(lhsptr).second) {
+        if (lhsptr->nodeListPtr() == rhsptr->nodeListPtr() and
+            lhsptr->size() == rhsptr->size()) {
+          lhsptr->swapValues(*rhsptr);
+        } else {
+          *lhsptr = *rhsptr;
+        }
+      }
+    } catch(const boost::bad_any_cast&) {
+      try {
+        auto lhsptr = boost::any_cast<vector<Vector>*>(anylhs);
+        auto rhsptr = boost::any_cast<vector<Vector>*>(anyrhs);
+        if (lhsptr != rhsptr) lhsptr->swap(*rhsptr);
+      } catch(const boost::bad_any_cast&) {
+        // As with assign, other things are not exchanged.
+      }
+    }
+  }
+
+  // Copy the connectivity and mesh.
+  this->assignConnectivityAndMesh(rhs);
+}
+
+//------------------------------------------------------------------------------
+// Copy the connectivity and mesh from another StateBase.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+assignConnectivityAndMesh(const StateBase<Dimension>& rhs) {
+
   // Copy the connectivity (by reference).  This thing is too
   // big to carry around separate copies!
   if (rhs.mConnectivityMapPtr != NULL) {
@@ -410,12 +495,30 @@ template<typename Dimension>
 void
 StateBase<Dimension>::
 copyState() {
+  this->copyState(SnapshotPoolPtr());
+}
 
-  // Remove any pre-existing stuff.
+//------------------------------------------------------------------------------
+// Force the state fields to be copied to local storage, reusing Field buffers
+// from the given pool where possible.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+copyState(SnapshotPoolPtr pool) {
+
+  // Remove any pre-existing stuff.  We hang onto any Fields we already own
+  // until we're done, since they may be the source of the new copies.
+  FieldCacheType oldFieldCache;
+  oldFieldCache.swap(mFieldCache);
+  auto oldPool = mSnapshotPoolPtr;
+  mSnapshotPoolPtr = pool;
   mCache = CacheType();
-  mFieldCache = FieldCacheType();
 
-  // Walk the registered state and copy it to our local cache.
+  // Walk the registered state and copy it to our local cache.  A Field
+  // registered under more than one key gets a single copy, so the keys still
+  // refer to the same Field.
+  std::unordered_map<FieldBase<Dimension>*, FieldBase<Dimension>*> fieldCopies;
   for (auto itr = mStorage.begin();
        itr != mStorage.end();
        ++itr) {
@@ -424,8 +527,12 @@ copyState() {
     // Is this a Field?
     try {
       auto ptr = boost::any_cast<FieldBase<Dimension>*>(anythingPtr);
-      mFieldCache.push_back(ptr->clone());
-      itr->second = mFieldCache.back().get();
+      auto copyItr = fieldCopies.find(ptr);
+      if (copyItr == fieldCopies.end()) {
+        mFieldCache.push_back(this->snapshotField(*ptr));
+        copyItr = fieldCopies.insert(std::make_pair(ptr, mFieldCache.back().get())).first;
+      }
+      itr->second = copyItr->second;
 
     } catch (const boost::bad_any_cast&) {
       try {
@@ -440,6 +547,91 @@ copyState() {
       }
     }
   }
+
+  this->rebuildFieldIndex();
+
+  // Now we can release the Fields we previously owned.
+  releaseFieldCache(oldFieldCache, oldPool);
+}
+
+//------------------------------------------------------------------------------
+// Make an internally owned copy of the given Field, taking the buffer from the
+// snapshot pool if one of the right type is available.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+std::shared_ptr<FieldBase<Dimension>>
+StateBase<Dimension>::
+snapshotField(const FieldBase<Dimension>& field) {
+  if (mSnapshotPoolPtr) {
+    auto range = mSnapshotPoolPtr->equal_range(key(field));
+    for (auto itr = range.first; itr != range.second; ++itr) {
+      if (typeid(*(itr->second)) == typeid(field)) {
+        auto result = itr->second;
+        mSnapshotPoolPtr->erase(itr);
+        result->setNodeList(field.nodeList());
+        *result = field;
+        return result;
+      }
+    }
+  }
+  return field.clone();
+}
+
+//------------------------------------------------------------------------------
+// Release a set of internally owned Fields.  If given a snapshot pool, any
+// Fields no one else is referencing are detached from their NodeLists (so they
+// are no longer resized or seen as registered Fields) and returned to the pool.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+releaseFieldCache(FieldCacheType& fieldCache,
+                  const SnapshotPoolPtr& pool) {
+  if (pool) {
+    for (auto& fieldPtr: fieldCache) {
+      if (fieldPtr.use_count() == 1 and fieldPtr->nodeListPtr() != nullptr) {
+        const auto fieldKey = key(*fieldPtr);
+        fieldPtr->unregisterNodeList();
+        pool->insert(std::make_pair(fieldKey, fieldPtr));
+      }
+    }
+  }
+  fieldCache = FieldCacheType();
+}
+
+//------------------------------------------------------------------------------
+// Add a newly registered key to the index of registered Fields by name.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+indexKey(const KeyType& key) {
+  KeyType fieldName, nodeListName;
+  splitFieldKey(key, fieldName, nodeListName);
+  if (fieldName != "") {
+    auto& entry = mFieldNameIndex[fieldName];
+    entry.clearViews();
+    if (nodeListName != "") {
+      const auto itr = mStorage.find(key);
+      CHECK(itr != mStorage.end());
+      try {
+        entry.fields.push_back(boost::any_cast<FieldBase<Dimension>*>(itr->second));
+      } catch (const boost::bad_any_cast&) {
+        // Not a Field, so not something we serve up as a FieldList.
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Rebuild the index of registered Fields by name from scratch.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+StateBase<Dimension>::
+rebuildFieldIndex() {
+  mFieldNameIndex.clear();
+  for (const auto& x: mStorage) this->indexKey(x.first);
 }
 
 }
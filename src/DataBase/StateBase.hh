@@ -10,6 +10,12 @@
 // another StateBase object with this one will only create new references to the
 // original's Fields.  You have to explicitly call "copyFields()" if you want
 // to do the expensive copy.
+//
+// Integrators that snapshot the state every step can pass a SnapshotPool to
+// copyState:  the copies are then drawn from (and on destruction returned to)
+// the pool, so the snapshot buffers are reused from step to step rather than
+// reallocated.  swapState restores a snapshot by exchanging the Field storage
+// rather than copying it back, for use when the snapshot is no longer needed.
 // 
 // Created by JMO, Wed Aug 25 22:23:35 2004
 //----------------------------------------------------------------------------//
@@ -25,8 +31,11 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <typeindex>
 #include <list>
 #include <set>
+#include <atomic>
 
 #include "Field/FieldBase.hh"
 
@@ -63,6 +72,10 @@ public:
   typedef std::string KeyType;
   typedef typename FieldBase<Dimension>::FieldName FieldName;
 
+  // A pool of Field buffers available for reuse by copyState, by key.
+  typedef std::unordered_multimap<KeyType, std::shared_ptr<FieldBase<Dimension>>> SnapshotPoolType;
+  typedef std::shared_ptr<SnapshotPoolType> SnapshotPoolPtr;
+
   // Constructors, destructor.
   StateBase();
   StateBase(const StateBase& rhs);
@@ -95,6 +108,9 @@ public:
   template<typename Value>
   std::vector<Field<Dimension, Value>*> allFields(const Value& dummy) const;
 
+  // Return all the registered fields, regardless of Value type.
+  std::vector<FieldBase<Dimension>*> allFieldBases() const;
+
   //............................................................................
   // Enroll a FieldList.
   virtual void enroll(FieldListBase<Dimension>& fieldList);
@@ -144,9 +160,18 @@ public:
   template<typename Value>
   void assignFields(const StateBase<Dimension>& rhs, const std::string name);
 
+  // Set the Fields equal to those in another State object by exchanging their
+  // values, leaving rhs holding our previous values.  Use in place of assign
+  // when rhs is a copy (copyState) that is not needed afterwards.
+  void swapState(StateBase<Dimension>& rhs);
+
   // Force the StateBase to create new internally owned copies of all state.
   virtual void copyState();
 
+  // As above, but take the copies of Fields from the given pool where
+  // possible, and return them to it when we are done with them.
+  void copyState(SnapshotPoolPtr pool);
+
   //............................................................................
   // Construct the lookup key for the given field.
   static KeyType key(const FieldBase<Dimension>& field);
@@ -165,6 +190,26 @@ protected:
   typedef std::list<std::shared_ptr<FieldBase<Dimension>>> FieldCacheType;
   typedef std::list<boost::any> CacheType;
 
+  // Index of the registered Fields by Field name, and the FieldList views we
+  // have built from them (one per element type).  The index is derived from
+  // mStorage and kept up to date as things are registered, which is never
+  // threaded, so lookups are lock free reads.  The views are built on demand
+  // by the lookups and pushed onto an append only list with a compare and
+  // swap, so concurrent lookups never see a partially built view.
+  struct FieldListView {
+    std::type_index type;
+    std::shared_ptr<FieldListBase<Dimension>> fieldList;
+    FieldListView* next;
+  };
+  struct FieldNameEntry {
+    std::vector<FieldBase<Dimension>*> fields;
+    mutable std::atomic<FieldListView*> views;
+    FieldNameEntry(): fields(), views(nullptr) {}
+    ~FieldNameEntry() { clearViews(); }
+    void clearViews();
+  };
+  typedef std::unordered_map<FieldName, FieldNameEntry> FieldNameIndexType;
+
   // Protected data.
   StorageType mStorage;
   CacheType mCache;
@@ -172,6 +217,21 @@ protected:
   std::set<const NodeList<Dimension>*> mNodeListPtrs;
   ConnectivityMapPtr mConnectivityMapPtr;
   MeshPtr mMeshPtr;
+  SnapshotPoolPtr mSnapshotPoolPtr;
+  FieldNameIndexType mFieldNameIndex;
+
+  // Maintain the Field name index:  indexKey adds a newly registered key,
+  // rebuildFieldIndex starts over from mStorage.
+  void indexKey(const KeyType& key);
+  void rebuildFieldIndex();
+  const FieldNameIndexType& fieldNameIndex() const;
+
+  // Copy the connectivity and mesh from another StateBase (assign/swapState).
+  void assignConnectivityAndMesh(const StateBase<Dimension>& rhs);
+
+  // Manage our internally owned Field copies with the snapshot pool.
+  std::shared_ptr<FieldBase<Dimension>> snapshotField(const FieldBase<Dimension>& field);
+  static void releaseFieldCache(FieldCacheType& fieldCache, const SnapshotPoolPtr& pool);
 };
 
 }
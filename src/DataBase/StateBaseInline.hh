@@ -3,6 +3,9 @@
 #include "Mesh/Mesh.hh"
 #include "Utilities/DBC.hh"
 
+#include <algorithm>
+#include <typeinfo>
+
 namespace Spheral {
 
 //------------------------------------------------------------------------------
@@ -47,24 +50,40 @@ allFields(const Value&) const {
 
 //------------------------------------------------------------------------------
 // Return a FieldList containing all registered fields of the given name.
+// The FieldList is assembled once per name and type, and thereafter served
+// from the cache until the set of registered Fields changes.  This is a lock
+// free read, so it is safe to call from threaded code.
 //------------------------------------------------------------------------------
 template<typename Dimension>
 template<typename Value>
 inline
 FieldList<Dimension, Value>
 StateBase<Dimension>::
-fields(const std::string& name, const Value& dummy) const {
-  FieldList<Dimension, Value> result;
-  KeyType fieldName, nodeListName;
-  for (auto itr = mStorage.begin();
-       itr != mStorage.end();
-       ++itr) {
-    splitFieldKey(itr->first, fieldName, nodeListName);
-    if (fieldName == name) {
-      CHECK(nodeListName != "");
-      result.appendField(this->field<Value>(itr->first, dummy));
-    }
+fields(const std::string& name, const Value&) const {
+  typedef FieldList<Dimension, Value> FieldListType;
+  const auto indexItr = mFieldNameIndex.find(name);
+  if (indexItr == mFieldNameIndex.end()) return FieldListType();
+
+  // Do we already have a view of these Fields as this type?
+  const auto& entry = indexItr->second;
+  const std::type_index valueType(typeid(FieldListType));
+  for (auto* view = entry.views.load(std::memory_order_acquire); view != nullptr; view = view->next) {
+    if (view->type == valueType) return *std::static_pointer_cast<FieldListType>(view->fieldList);
   }
+
+  // Nope, so build it and add it to the views.  If another thread beats us to
+  // it we just end up with a redundant (but equivalent) view.
+  FieldListType result;
+  for (auto* fieldBasePtr: entry.fields) {
+    auto* fieldPtr = dynamic_cast<Field<Dimension, Value>*>(fieldBasePtr);
+    VERIFY2(fieldPtr != nullptr, "StateBase ERROR: unable to extract field for key " << key(*fieldBasePtr) << "\n");
+    result.appendField(*fieldPtr);
+  }
+  auto* view = new FieldListView{valueType, std::shared_ptr<FieldListBase<Dimension>>(new FieldListType(result)), nullptr};
+  view->next = entry.views.load(std::memory_order_relaxed);
+  while (not entry.views.compare_exchange_weak(view->next, view,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {}
   return result;
 }
 
@@ -76,7 +95,14 @@ template<typename Value>
 void
 StateBase<Dimension>::
 enrollAny(const typename StateBase<Dimension>::KeyType& key, Value& thing) {
-  mStorage[key] = &thing;
+  const auto itr = mStorage.find(key);
+  if (itr == mStorage.end()) {
+    mStorage[key] = &thing;
+    this->indexKey(key);
+  } else {
+    itr->second = &thing;
+    this->rebuildFieldIndex();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -105,6 +131,34 @@ getAny(const typename StateBase<Dimension>::KeyType& key,
   return this->getAny<Value>(key);
 }
 
+//------------------------------------------------------------------------------
+// Drop the FieldList views of a Field name index entry.  Only called when
+// registering things, so never concurrently with the lookups.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+void
+StateBase<Dimension>::FieldNameEntry::
+clearViews() {
+  auto* view = views.exchange(nullptr);
+  while (view != nullptr) {
+    auto* next = view->next;
+    delete view;
+    view = next;
+  }
+}
+
+//------------------------------------------------------------------------------
+// The index of registered Fields by name.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+const typename StateBase<Dimension>::FieldNameIndexType&
+StateBase<Dimension>::
+fieldNameIndex() const {
+  return mFieldNameIndex;
+}
+
 //------------------------------------------------------------------------------
 // Construct the lookup key for the given field.
 //------------------------------------------------------------------------------
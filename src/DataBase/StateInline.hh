@@ -12,6 +12,7 @@ enroll(const typename State<Dimension>::KeyType& key,
   KeyType fieldKey, nodeKey;
   this->splitFieldKey(key, fieldKey, nodeKey);
   mPolicyMap[fieldKey][key] = polptr;
+  mPolicyLevelsValid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -106,4 +107,54 @@ timeAdvanceOnly(const bool x) {
   mTimeAdvanceOnly = x;
 }
 
+//------------------------------------------------------------------------------
+// Optionally fire independent policies concurrently.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+State<Dimension>::
+concurrentPolicyUpdates() const {
+  return mConcurrentPolicyUpdates;
+}
+
+template<typename Dimension>
+inline
+void
+State<Dimension>::
+concurrentPolicyUpdates(const bool x) {
+  mConcurrentPolicyUpdates = x;
+}
+
+//------------------------------------------------------------------------------
+// Optionally measure the work of the policies.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+State<Dimension>::
+measureWork() const {
+  return mMeasureWork;
+}
+
+template<typename Dimension>
+inline
+void
+State<Dimension>::
+measureWork(const bool x) {
+  mMeasureWork = x;
+}
+
+//------------------------------------------------------------------------------
+// The nodes of a NodeList the update is restricted to.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+const std::vector<int>*
+State<Dimension>::
+restrictedNodes(const NodeList<Dimension>& nodeList) const {
+  const auto itr = mRestrictedNodes.find(&nodeList);
+  return (itr == mRestrictedNodes.end() ? nullptr : &(itr->second));
+}
+
 }
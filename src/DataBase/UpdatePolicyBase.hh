@@ -13,6 +13,7 @@
 
 #include <string>
 #include <vector>
+#include <typeinfo>
 
 namespace Spheral {
 
@@ -81,6 +82,18 @@ public:
     this->update(key, state, derivs, multiplier, t, dt);
   }
 
+  // Can this policy be fired concurrently with other independent policies
+  // (see State::update)?  Off by default:  policies may communicate, be
+  // threaded internally, call non-reentrant code (such as the Fortran behind
+  // some equations of state), or be implemented in Python (and so need the
+  // GIL).  Only policies known to be free of all of those should opt in.
+  virtual bool concurrentUpdate() const { return false; }
+
+  // Does this policy honor State::restrictUpdate, advancing only the nodes
+  // State::restrictedNodes returns?  Off by default, in which case State::update
+  // restores the values of the other nodes after the policy fires.
+  virtual bool restrictedUpdate() const { return false; }
+
   // Require descendents to define an equivalence operator.
   virtual bool operator==(const UpdatePolicyBase& rhs) const = 0;
   bool operator!=(const UpdatePolicyBase& rhs) const;
@@ -98,6 +111,13 @@ public:
   // The wildcard string for comparing dependency keys.
   static const std::string wildcard() { return "*"; }
 
+protected:
+  //--------------------------- Protected Interface ---------------------------//
+  // Policies opting in to concurrentUpdate (or restrictedUpdate) use this so the opt in is not
+  // inherited:  a derived policy (including a Python subclass) is only fired
+  // concurrently if it opts in for itself.
+  template<typename PolicyType> bool exactPolicyType() const { return typeid(*this) == typeid(PolicyType); }
+
 private:
   //--------------------------- Private Interface ---------------------------//
   std::vector<std::string> mDependencies;
@@ -0,0 +1,187 @@
+//---------------------------------Spheral++----------------------------------//
+// AsyncRestartWriter
+//
+// Write restart files in the background.
+//----------------------------------------------------------------------------//
+#include "AsyncRestartWriter.hh"
+#include "RestartRegistrar.hh"
+#include "FileIO/MemoryFileIO.hh"
+#include "Utilities/DBC.hh"
+
+using std::string;
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Constructor.  Starts the I/O thread.
+//------------------------------------------------------------------------------
+AsyncRestartWriter::
+AsyncRestartWriter(const unsigned maxPending):
+  mMaxPending(1u),
+  mNumWritten(0u),
+  mStop(false),
+  mError(),
+  mQueue(),
+  mFinished(),
+  mMutex(),
+  mQueueChanged(),
+  mThread() {
+  this->maxPending(maxPending);
+  mThread = std::thread(&AsyncRestartWriter::drain, this);
+}
+
+//------------------------------------------------------------------------------
+// Destructor.  Write anything still pending and stop the I/O thread.
+//------------------------------------------------------------------------------
+AsyncRestartWriter::
+~AsyncRestartWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mQueueChanged.notify_all();
+  if (mThread.joinable()) mThread.join();
+  this->releaseFinished();
+}
+
+//------------------------------------------------------------------------------
+// Snapshot the registered state and queue it for writing.
+//------------------------------------------------------------------------------
+void
+AsyncRestartWriter::
+dumpState(const string fileName) {
+
+  // Wait for room in the queue.
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mQueueChanged.wait(lock, [this] { return mQueue.size() < mMaxPending; });
+    this->checkError();
+  }
+  this->releaseFinished();
+
+  // Take the snapshot.  This only touches the new MemoryFileIO, so we can do
+  // it while the I/O thread is writing.
+  std::unique_ptr<MemoryFileIO> snapshot(new MemoryFileIO(fileName, AccessType::Create));
+  RestartRegistrar::instance().dumpState(*snapshot);
+
+  // Hand it off.
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back(std::move(snapshot));
+  }
+  mQueueChanged.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// Wait until everything queued has been written.
+//------------------------------------------------------------------------------
+void
+AsyncRestartWriter::
+wait() {
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mQueueChanged.wait(lock, [this] { return mQueue.empty(); });
+    this->checkError();
+  }
+  this->releaseFinished();
+}
+
+//------------------------------------------------------------------------------
+// The maximum number of snapshots in flight.
+//------------------------------------------------------------------------------
+unsigned
+AsyncRestartWriter::
+maxPending() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMaxPending;
+}
+
+void
+AsyncRestartWriter::
+maxPending(const unsigned x) {
+  VERIFY2(x > 0u, "AsyncRestartWriter ERROR: maxPending must be at least 1");
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxPending = x;
+  }
+  mQueueChanged.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// The number of pending snapshots.
+//------------------------------------------------------------------------------
+unsigned
+AsyncRestartWriter::
+numPending() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mQueue.size();
+}
+
+//------------------------------------------------------------------------------
+// The number of snapshots written.
+//------------------------------------------------------------------------------
+unsigned
+AsyncRestartWriter::
+numWritten() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mNumWritten;
+}
+
+//------------------------------------------------------------------------------
+// The I/O thread.  Snapshots stay at the front of the queue while they are
+// being written, so they count against maxPending until they are on disk.
+//------------------------------------------------------------------------------
+void
+AsyncRestartWriter::
+drain() {
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    mQueueChanged.wait(lock, [this] { return mStop or not mQueue.empty(); });
+    if (mQueue.empty()) break;
+    MemoryFileIO& snapshot = *mQueue.front();
+    lock.unlock();
+    string error;
+    try {
+      snapshot.close();
+    } catch (std::exception& e) {
+      error = e.what();
+    }
+    lock.lock();
+    if (error.empty()) {
+      ++mNumWritten;
+    } else {
+      mError = error;
+    }
+    mFinished.push_back(std::move(mQueue.front()));
+    mQueue.pop_front();
+    mQueueChanged.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Free the written snapshots.  They are destroyed outside the lock.
+//------------------------------------------------------------------------------
+void
+AsyncRestartWriter::
+releaseFinished() {
+  std::deque<std::unique_ptr<MemoryFileIO>> finished;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    finished.swap(mFinished);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Report an error from the I/O thread.
+//------------------------------------------------------------------------------
+void
+AsyncRestartWriter::
+checkError() {
+  if (not mError.empty()) {
+    const string error = mError;
+    mError.clear();
+    VERIFY2(false, "AsyncRestartWriter ERROR: failed writing restart file : " << error);
+  }
+}
+
+}
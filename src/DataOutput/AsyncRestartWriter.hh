@@ -0,0 +1,93 @@
+//---------------------------------Spheral++----------------------------------//
+// AsyncRestartWriter
+//
+// Write restart files in the background.  dumpState snapshots the state of
+// every object registered with the RestartRegistrar into a MemoryFileIO (so
+// the cost to the caller is essentially copying the state), and queues that
+// snapshot to be written to disk by a background I/O thread.  At most
+// maxPending snapshots are held at once:  if the I/O thread falls that far
+// behind dumpState blocks until a snapshot has been written.
+//
+// The restart files are always written in the MemoryFileIO format, regardless
+// of which FileIO type the rest of the run uses; read them back with
+// MemoryFileIO.
+//
+// Errors writing a snapshot are reported (thrown) from the next call to
+// dumpState or wait.  Snapshots are only created and destroyed on the calling
+// thread, since FileIO objects may hold Python references; the I/O thread
+// just writes them.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_AsyncRestartWriter__
+#define __Spheral_AsyncRestartWriter__
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Forward declarations.
+namespace Spheral {
+  class MemoryFileIO;
+}
+
+namespace Spheral {
+
+class AsyncRestartWriter {
+public:
+  //------------------------===== Public Interface =====-----------------------//
+  // Constructor, destructor.  The destructor waits for all pending snapshots.
+  AsyncRestartWriter(const unsigned maxPending);
+  ~AsyncRestartWriter();
+
+  // Snapshot the registered state and queue it to be written to fileName.
+  void dumpState(const std::string fileName);
+
+  // Block until all queued snapshots have been written.
+  void wait();
+
+  // The maximum number of snapshots allowed in flight.
+  unsigned maxPending() const;
+  void maxPending(const unsigned x);
+
+  // The number of snapshots waiting to be (or being) written.
+  unsigned numPending() const;
+
+  // The total number of snapshots written.
+  unsigned numWritten() const;
+
+private:
+  //------------------------===== Private Interface =====----------------------//
+  unsigned mMaxPending, mNumWritten;
+  bool mStop;
+  std::string mError;
+  std::deque<std::unique_ptr<MemoryFileIO>> mQueue, mFinished;
+  mutable std::mutex mMutex;
+  std::condition_variable mQueueChanged;
+  std::thread mThread;
+
+  // The I/O thread:  write snapshots until told to stop.
+  void drain();
+
+  // Throw any error from the I/O thread.  Must hold the lock.
+  void checkError();
+
+  // Free the snapshots which have been written.
+  void releaseFinished();
+
+  // No copying or assignment.
+  AsyncRestartWriter(const AsyncRestartWriter&);
+  AsyncRestartWriter& operator=(const AsyncRestartWriter&);
+};
+
+}
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  class AsyncRestartWriter;
+}
+
+#endif
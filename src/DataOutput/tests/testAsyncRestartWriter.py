@@ -0,0 +1,187 @@
+#ATS:test(SELF, label="AsyncRestartWriter unit tests")
+#-------------------------------------------------------------------------------
+# AsyncRestartWriter snapshots the registered restart state on the calling
+# thread and writes it from a background thread.  Check
+#   1.  Each file holds the state as of its dumpState call, and restores.
+#   2.  dumpState blocks while maxPending snapshots are in flight.  We hold the
+#       I/O thread up by making the first restart file a FIFO, which it cannot
+#       open until a (deliberately slow) reader process opens the other end.
+#   3.  A failed write is reported by the next wait or dumpState, and the
+#       writer carries on working afterwards.
+#-------------------------------------------------------------------------------
+from Spheral1d import *
+from SpheralTestUtilities import *
+
+import os
+import subprocess
+import time
+
+title("AsyncRestartWriter")
+
+commandLine(n = 20,
+            readerDelay = 1.0,
+            )
+
+baseName = "AsyncRestartWriter-test"
+
+eos = GammaLawGasMKS(2.0, 2.0)
+nodes = makeFluidNodeList("nodes", eos)
+nodes.numInternalNodes = n
+
+#-------------------------------------------------------------------------------
+# Something restartable whose state we control.
+#-------------------------------------------------------------------------------
+class Counter:
+    def __init__(self):
+        self.restart = RestartableObject(self)
+        self.value = 0
+        return
+    def label(self):
+        return "Counter"
+    def dumpState(self, file, path):
+        file.writeObject(self.value, path + "/value")
+        return
+    def restoreState(self, file, path):
+        self.value = file.readObject(path + "/value")
+        return
+
+counter = Counter()
+
+def setState(value):
+    counter.value = value
+    mass = nodes.mass()
+    for i in xrange(n):
+        mass[i] = value + 0.01*i
+    return
+
+def checkFile(fileName, value):
+    setState(-1)
+    f = MemoryFileIO(fileName, Read)
+    RestartRegistrar.instance().restoreState(f)
+    f.close()
+    if counter.value != value:
+        raise ValueError, "%s restored counter %s, expected %s" % (fileName, counter.value, value)
+    mass = nodes.mass()
+    for i in xrange(n):
+        if mass[i] != value + 0.01*i:
+            raise ValueError, "%s restored mass %g for node %i, expected %g" % (fileName, mass[i], i, value + 0.01*i)
+    return
+
+def fileName(k):
+    return "%s-%i" % (baseName, k)
+
+def removeFile(name):
+    if os.path.exists(name + ".restart"):
+        os.remove(name + ".restart")
+    return
+
+#-------------------------------------------------------------------------------
+# maxPending must be positive.
+#-------------------------------------------------------------------------------
+writer = AsyncRestartWriter(3)
+assert writer.maxPending == 3
+try:
+    writer.maxPending = 0
+    raise ValueError, "Setting maxPending = 0 did not raise an error"
+except RuntimeError:
+    pass
+assert writer.maxPending == 3
+
+#-------------------------------------------------------------------------------
+# Each file holds the state when it was queued.
+#-------------------------------------------------------------------------------
+nfiles = 6
+for k in xrange(nfiles):
+    setState(k)
+    writer.dumpState(fileName(k))
+    if writer.numPending > writer.maxPending:
+        raise ValueError, "%i snapshots pending with maxPending = %i" % (writer.numPending, writer.maxPending)
+writer.wait()
+if writer.numPending != 0 or writer.numWritten != nfiles:
+    raise ValueError, "After wait: %i pending, %i written, expected 0 and %i" % (writer.numPending, writer.numWritten, nfiles)
+for k in xrange(nfiles):
+    checkFile(fileName(k), k)
+    removeFile(fileName(k))
+print "Snapshot contents PASSED."
+
+#-------------------------------------------------------------------------------
+# dumpState blocks while maxPending snapshots are in flight.
+#-------------------------------------------------------------------------------
+writer.maxPending = 1
+slowName = baseName + "-slow"
+copyName = baseName + "-slow-copy"
+removeFile(slowName)
+removeFile(copyName)
+os.mkfifo(slowName + ".restart")
+
+# The I/O thread cannot open the FIFO until the reader does, so this snapshot
+# stays pending.
+numWritten0 = writer.numWritten
+setState(100)
+writer.dumpState(slowName)
+if writer.numPending != 1:
+    raise ValueError, "Expected the FIFO snapshot to be pending, found %i pending" % writer.numPending
+reader = subprocess.Popen("sleep %g; cat %s.restart > %s.restart" % (readerDelay, slowName, copyName), shell=True)
+
+# So this one has to wait for the reader.
+start = time.time()
+setState(101)
+writer.dumpState(fileName(101))
+elapsed = time.time() - start
+print "Second dumpState with maxPending = 1 blocked for %g seconds" % elapsed
+if elapsed < 0.5*readerDelay:
+    raise ValueError, "dumpState returned after %g seconds without waiting for the pending snapshot" % elapsed
+if writer.numPending > 1:
+    raise ValueError, "%i snapshots pending with maxPending = 1" % writer.numPending
+writer.wait()
+if reader.wait() != 0:
+    raise ValueError, "FIFO reader failed"
+if writer.numWritten != numWritten0 + 2:
+    raise ValueError, "Wrote %i snapshots, expected 2" % (writer.numWritten - numWritten0)
+checkFile(copyName, 100)
+checkFile(fileName(101), 101)
+for name in (slowName, copyName, fileName(101)):
+    removeFile(name)
+print "Blocking on maxPending PASSED."
+
+#-------------------------------------------------------------------------------
+# Errors from the I/O thread come back to the caller.
+#-------------------------------------------------------------------------------
+badName = os.path.join("AsyncRestartWriter-no-such-directory", baseName)
+assert not os.path.exists(os.path.dirname(badName))
+numWritten0 = writer.numWritten
+writer.dumpState(badName)
+try:
+    writer.wait()
+    raise ValueError, "Writing %s did not raise an error" % badName
+except RuntimeError, e:
+    if "failed writing restart file" not in str(e):
+        raise ValueError, "Unexpected error writing %s : %s" % (badName, e)
+if writer.numWritten != numWritten0:
+    raise ValueError, "Failed write was counted as written"
+
+# The error is reported once, and the writer still works.
+writer.wait()
+setState(200)
+writer.dumpState(fileName(200))
+writer.wait()
+if writer.numWritten != numWritten0 + 1:
+    raise ValueError, "Writer did not recover after a failed write"
+checkFile(fileName(200), 200)
+removeFile(fileName(200))
+
+# The error can also come back from the next dumpState.
+writer.dumpState(badName)
+while writer.numPending > 0:
+    time.sleep(0.01)
+try:
+    writer.dumpState(fileName(201))
+    raise ValueError, "Queueing after a failed write did not raise an error"
+except RuntimeError, e:
+    if "failed writing restart file" not in str(e):
+        raise ValueError, "Unexpected error from dumpState : %s" % e
+writer.wait()
+removeFile(fileName(201))
+print "Error reporting PASSED."
+
+print "PASS"
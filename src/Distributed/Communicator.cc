@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------//
 #include "Communicator.hh"
 #include "Utilities/DBC.hh"
+#include "Utilities/OpenMP_wrapper.hh"
 
 namespace Spheral {
 
@@ -29,6 +30,27 @@ instancePtr() {
   return mInstancePtr;
 }
 
+//------------------------------------------------------------------------------
+// Check the MPI thread support level allows MPI calls from the master thread
+// of a parallel region.
+//------------------------------------------------------------------------------
+bool
+Communicator::
+funneledThreadSupport() {
+#ifdef USE_MPI
+  if (omp_get_max_threads() == 1) return true;
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) return false;
+  int provided, isMain;
+  MPI_Query_thread(&provided);
+  MPI_Is_thread_main(&isMain);
+  return (provided >= MPI_THREAD_FUNNELED and isMain != 0);
+#else
+  return true;
+#endif
+}
+
 //------------------------------------------------------------------------------
 // Default constructor (private).
 //------------------------------------------------------------------------------
@@ -30,6 +30,12 @@ public:
   static void communicator(int&) {}
 #endif
 
+  // Can the master thread of an OpenMP parallel region started on the calling
+  // thread make MPI calls?  This requires MPI was initialized with at least
+  // MPI_THREAD_FUNNELED from this thread (or that we only run one thread).
+  // Always true without MPI.
+  static bool funneledThreadSupport();
+
 private:
   //------------------------===== Private Interface =====----------------------//
   // The one and only instance.
@@ -32,6 +32,12 @@ using std::abs;
 
 namespace Spheral {
 
+namespace {
+// The MPI tag for the coalesced exchange messages.  The per Field exchanges
+// count up from 1 (and 65536 for the variable size buffer sizes).
+const int coalescedExchangeTag = 32000;
+}
+
 //------------------------------------------------------------------------------
 // Default constructor.
 //------------------------------------------------------------------------------
@@ -49,7 +55,14 @@ DistributedBoundary<Dimension>::DistributedBoundary():
   mRecvProcIDs(),
 #endif
   mSendBuffers(),
-  mRecvBuffers() {
+  mRecvBuffers(),
+  mField2SendBuffer(),
+  mField2RecvBuffer(),
+  mCoalescedSendBuffers(),
+  mCoalescedRecvSizes(),
+  mCoalescedFieldIndices(),
+  mCoalescedExchanges(),
+  mActiveExchange(0) {
   
   // Get the number of processor and this one's rank.
   MPI_Comm_rank(Communicator::communicator(), &mDomainID);
@@ -65,6 +78,7 @@ DistributedBoundary<Dimension>::DistributedBoundary():
 //------------------------------------------------------------------------------
 template<typename Dimension>
 DistributedBoundary<Dimension>::~DistributedBoundary() {
+  freeCoalescedExchanges();
 }
 
 //------------------------------------------------------------------------------
@@ -1012,7 +1026,12 @@ DistributedBoundary<Dimension>::
 applyGhostBoundary(FieldBase<Dimension>& field) const {
   if (field.fixedSizeDataType()) {
     // cerr << " -->    FIXED SIZE: " << field.name() << endl;
-    beginExchangeFieldFixedSize(field);
+    // Pack into the coalesced exchange, unless that has already been posted.
+    if (mActiveExchange == 0) {
+      packCoalescedField(field);
+    } else {
+      beginExchangeFieldFixedSize(field);
+    }
   } else {
     // cerr << " --> VARIABLE SIZE: " << field.name() << endl;
     beginExchangeFieldVariableSize(field);
@@ -1217,6 +1236,132 @@ cullGhostNodes(const FieldList<Dimension, int>& flagSet,
   }
 }
 
+//------------------------------------------------------------------------------
+// Append the send values of a fixed size Field to the coalesced message for
+// each neighbor domain, and note how much we'll receive for it.  The values
+// are packed now (as the per Field exchanges do), so the Field only needs to
+// exist again when the exchange is finalized and the ghost values unpacked.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+DistributedBoundary<Dimension>::
+packCoalescedField(FieldBase<Dimension>& field) const {
+  REQUIRE(field.fixedSizeDataType());
+  REQUIRE(mActiveExchange == 0);
+  const int procID = domainID();
+  const auto& nodeList = field.nodeList();
+  if (communicatedNodeList(nodeList)) {
+    for (const auto& domainNodes: domainBoundaryNodeMap(nodeList)) {
+      const int neighborDomainID = domainNodes.first;
+      const DomainBoundaryNodes& boundNodes = domainNodes.second;
+      if (boundNodes.sendNodes.size() > 0) {
+        const vector<char> packedValues = field.packValues(boundNodes.sendNodes);
+        auto& buffer = mCoalescedSendBuffers[neighborDomainID];
+        buffer.insert(buffer.end(), packedValues.begin(), packedValues.end());
+      }
+      if (boundNodes.receiveNodes.size() > 0) {
+        mCoalescedRecvSizes[neighborDomainID] += field.computeCommBufferSize(boundNodes.receiveNodes, neighborDomainID, procID);
+      }
+    }
+  }
+  mCoalescedFieldIndices.push_back(mExchangeFields.size());
+}
+
+//------------------------------------------------------------------------------
+// Start the (persistent) sends and receives for the coalesced exchange.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+DistributedBoundary<Dimension>::
+beginExchanges() const {
+  if (mActiveExchange != 0 or mCoalescedFieldIndices.empty()) return;
+
+  // The total message sizes to and from each neighbor domain.
+  std::map<int, pair<int, int>> procSizes;
+  for (const auto& val: mCoalescedSendBuffers) procSizes[val.first].first = val.second.size();
+  for (const auto& val: mCoalescedRecvSizes) procSizes[val.first].second = val.second;
+  vector<int> key;
+  for (const auto& val: procSizes) {
+    if (val.second.first > 0 or val.second.second > 0) {
+      key.push_back(val.first);
+      key.push_back(val.second.first);
+      key.push_back(val.second.second);
+    }
+  }
+
+  // Look up (or build) the persistent requests for this pattern of messages.
+  auto itr = mCoalescedExchanges.find(key);
+  if (itr == mCoalescedExchanges.end()) {
+    if (mCoalescedExchanges.size() >= 16u) freeCoalescedExchanges();
+    CoalescedExchange& exchange = mCoalescedExchanges[key];
+    for (const auto& val: procSizes) {
+      if (val.second.first > 0) {
+        exchange.sendProcs.push_back(val.first);
+        exchange.sendBuffers.push_back(vector<char>(val.second.first));
+      }
+      if (val.second.second > 0) {
+        exchange.recvProcs.push_back(val.first);
+        exchange.recvBuffers.push_back(vector<char>(val.second.second));
+      }
+    }
+    exchange.sendRequests.resize(exchange.sendProcs.size());
+    exchange.recvRequests.resize(exchange.recvProcs.size());
+    for (auto k = 0u; k < exchange.sendProcs.size(); ++k) {
+      MPI_Send_init(&exchange.sendBuffers[k].front(), exchange.sendBuffers[k].size(), MPI_CHAR, exchange.sendProcs[k],
+                    coalescedExchangeTag, Communicator::communicator(), &exchange.sendRequests[k]);
+    }
+    for (auto k = 0u; k < exchange.recvProcs.size(); ++k) {
+      MPI_Recv_init(&exchange.recvBuffers[k].front(), exchange.recvBuffers[k].size(), MPI_CHAR, exchange.recvProcs[k],
+                    coalescedExchangeTag, Communicator::communicator(), &exchange.recvRequests[k]);
+    }
+    itr = mCoalescedExchanges.find(key);
+  }
+  CHECK(itr != mCoalescedExchanges.end());
+  mActiveExchange = &(itr->second);
+  CoalescedExchange& exchange = *mActiveExchange;
+
+  // Post the receives.
+  if (not exchange.recvRequests.empty()) MPI_Startall(exchange.recvRequests.size(), &exchange.recvRequests.front());
+
+  // Copy the packed values into the persistent send buffers, and send.
+  for (auto k = 0u; k < exchange.sendProcs.size(); ++k) {
+    const auto& packedValues = mCoalescedSendBuffers[exchange.sendProcs[k]];
+    CHECK(packedValues.size() == exchange.sendBuffers[k].size());
+    std::copy(packedValues.begin(), packedValues.end(), exchange.sendBuffers[k].begin());
+  }
+  if (not exchange.sendRequests.empty()) MPI_Startall(exchange.sendRequests.size(), &exchange.sendRequests.front());
+  mCoalescedSendBuffers.clear();
+  mCoalescedRecvSizes.clear();
+}
+
+//------------------------------------------------------------------------------
+// Free the persistent requests for the coalesced exchanges.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+DistributedBoundary<Dimension>::
+freeCoalescedExchanges() const {
+  REQUIRE(mActiveExchange == 0);
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (finalized) return;
+  for (auto& val: mCoalescedExchanges) {
+    for (auto& request: val.second.sendRequests) MPI_Request_free(&request);
+    for (auto& request: val.second.recvRequests) MPI_Request_free(&request);
+  }
+  mCoalescedExchanges.clear();
+}
+
+//------------------------------------------------------------------------------
+// Begin the ghost boundary condition, posting the deferred exchanges.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+DistributedBoundary<Dimension>::
+beginGhostBoundary() const {
+  this->beginExchanges();
+}
+
 //------------------------------------------------------------------------------
 // Finalize the ghost boundary condition.
 //------------------------------------------------------------------------------
@@ -1273,6 +1418,9 @@ template<typename Dimension>
 void
 DistributedBoundary<Dimension>::finalizeExchanges() {
 
+  // Make sure the coalesced exchange is underway.
+  beginExchanges();
+
   BEGIN_CONTRACT_SCOPE
   {
     // Make sure everyone has the same number of exchange fields.
@@ -1315,14 +1463,67 @@ DistributedBoundary<Dimension>::finalizeExchanges() {
 #else
     MPI_Waitall(mRecvRequests.size(), &(*mRecvRequests.begin()), &(*recvStatus.begin()));
 #endif
+  }
+
+  // Likewise for the coalesced exchange.
+  CoalescedExchange* exchangePtr = mActiveExchange;
+  if (exchangePtr != 0 and not exchangePtr->recvRequests.empty()) {
+    vector<MPI_Status> recvStatus(exchangePtr->recvRequests.size());
+    MPI_Waitall(exchangePtr->recvRequests.size(), &exchangePtr->recvRequests.front(), &recvStatus.front());
+  }
+
+  // Unpack all field values in the order the exchanges were posted, so if a
+  // Field is exchanged more than once (say coalesced, and again after the
+  // coalesced exchange was posted) the last values sent win.  The coalesced
+  // Fields are unpacked from each domain's buffer in the order they were packed.
+  {
+    const int procID = domainID();
+    vector<vector<char>::const_iterator> coalescedItrs;
+    if (exchangePtr != 0) {
+      for (const auto& buffer: exchangePtr->recvBuffers) coalescedItrs.push_back(buffer.cbegin());
+    }
+    auto coalescedFieldItr = mCoalescedFieldIndices.begin();
+    for (auto kfield = 0u; kfield < mExchangeFields.size(); ++kfield) {
+      auto* fieldPtr = mExchangeFields[kfield];
+      if (coalescedFieldItr != mCoalescedFieldIndices.end() and *coalescedFieldItr == kfield) {
+        CHECK(exchangePtr != 0);
+        const auto& nodeList = fieldPtr->nodeList();
+        for (auto k = 0u; k < exchangePtr->recvProcs.size(); ++k) {
+          const int neighborDomainID = exchangePtr->recvProcs[k];
+          if (nodeListSharedWithDomain(nodeList, neighborDomainID)) {
+            const DomainBoundaryNodes& boundNodes = domainBoundaryNodes(nodeList, neighborDomainID);
+            if (boundNodes.receiveNodes.size() > 0) {
+              auto& bufItr = coalescedItrs[k];
+              const int bufSize = fieldPtr->computeCommBufferSize(boundNodes.receiveNodes, neighborDomainID, procID);
+              CHECK(std::distance(bufItr, exchangePtr->recvBuffers[k].cend()) >= bufSize);
+              fieldPtr->unpackValues(boundNodes.receiveNodes, vector<char>(bufItr, bufItr + bufSize));
+              bufItr += bufSize;
+            }
+          }
+        }
+        ++coalescedFieldItr;
+      } else {
+        const auto bufferItr = mField2RecvBuffer.find(fieldPtr);
+        if (bufferItr != mField2RecvBuffer.end()) unpackField(*fieldPtr, *(bufferItr->second));
+      }
+    }
+    CHECK(coalescedFieldItr == mCoalescedFieldIndices.end());
+    BEGIN_CONTRACT_SCOPE
+    for (auto k = 0u; k < coalescedItrs.size(); ++k) CHECK(coalescedItrs[k] == exchangePtr->recvBuffers[k].cend());
+    END_CONTRACT_SCOPE
+  }
 
-    // Unpack all field values.
-    for (typename vector<FieldBase<Dimension>*>::const_iterator fieldItr = mExchangeFields.begin();
-         fieldItr != mExchangeFields.end();
-         ++fieldItr) {
-      if (mField2RecvBuffer.find(&(**fieldItr)) != mField2RecvBuffer.end()) unpackField(**fieldItr, *mField2RecvBuffer[&(**fieldItr)]);
+  // Complete the coalesced sends.
+  if (exchangePtr != 0) {
+    if (not exchangePtr->sendRequests.empty()) {
+      vector<MPI_Status> sendStatus(exchangePtr->sendRequests.size());
+      MPI_Waitall(exchangePtr->sendRequests.size(), &exchangePtr->sendRequests.front(), &sendStatus.front());
     }
+    mActiveExchange = 0;
   }
+  mCoalescedFieldIndices.clear();
+  mCoalescedSendBuffers.clear();
+  mCoalescedRecvSizes.clear();
 
   // Do we have any data we're waiting to send?
   if (mSendRequests.size() > 0) {
@@ -1358,6 +1559,8 @@ DistributedBoundary<Dimension>::finalizeExchanges() {
 
   // Post-conditions.
   ENSURE(mExchangeFields.size() == 0);
+  ENSURE(mCoalescedFieldIndices.size() == 0);
+  ENSURE(mActiveExchange == 0);
   ENSURE(mMPIFieldTag == 0);
   ENSURE(mSendRequests.size() == 0);
   ENSURE(mRecvRequests.size() == 0);
@@ -1515,6 +1718,9 @@ DistributedBoundary<Dimension>::reset(const DataBase<Dimension>& dataBase) {
   // Call the ancestor method.
   Boundary<Dimension>::reset(dataBase);
 
+  // The communication pattern is changing, so release our persistent requests.
+  freeCoalescedExchanges();
+
   // Clear our own internal data.
   for (typename DataBase<Dimension>::ConstNodeListIterator iter = 
     dataBase.nodeListBegin(); iter != dataBase.nodeListEnd(); ++iter) {
@@ -98,7 +98,8 @@ public:
                               FieldList<Dimension, int>& old2newIndexMap,
                               std::vector<int>& numNodesRemoved) override;
 
-  // Override the base method to finalize ghost boundaries.
+  // Override the base methods to begin and finalize ghost boundaries.
+  virtual void beginGhostBoundary() const override;
   virtual void finalizeGhostBoundary() const override;
 
   // We do not want to use the parallel ghost nodes as generators.
@@ -109,6 +110,12 @@ public:
   void beginExchangeFieldFixedSize(FieldBase<Dimension>& field) const;
   void beginExchangeFieldVariableSize(FieldBase<Dimension>& field) const;
 
+  // Fixed size Fields passed to applyGhostBoundary are packed immediately into
+  // a single pending message for each neighbor domain.  beginExchanges posts
+  // those messages (finalizeExchanges will call it if need be).
+  void beginExchanges() const;
+  void packCoalescedField(FieldBase<Dimension>& field) const;
+
   // Force the exchanges which have been registered to execute.
   void finalizeExchanges();
 
@@ -180,6 +187,31 @@ private:
   mutable Field2BufferType mField2SendBuffer;
   mutable Field2BufferType mField2RecvBuffer;
 
+  // The coalesced exchange being assembled:  the values packed so far for
+  // each neighbor domain, the number of bytes we expect back from each, and
+  // which of the mExchangeFields receive them (in packing order).
+  mutable std::map<int, std::vector<char>> mCoalescedSendBuffers;
+  mutable std::map<int, int> mCoalescedRecvSizes;
+  mutable std::vector<size_t> mCoalescedFieldIndices;
+
+#ifdef USE_MPI
+  // Persistent requests and buffers for a coalesced exchange.  These only
+  // depend on the message sizes to each neighbor domain, so we keep one set for
+  // each distinct pattern of sizes (typically just a few, such as positions & H
+  // vs. the full state) until the ghost nodes are rebuilt.
+  struct CoalescedExchange {
+    std::vector<int> sendProcs, recvProcs;
+    std::vector<std::vector<char>> sendBuffers, recvBuffers;
+    std::vector<MPI_Request> sendRequests, recvRequests;
+  };
+  typedef std::map<std::vector<int>, CoalescedExchange> CoalescedExchangeMap;
+  mutable CoalescedExchangeMap mCoalescedExchanges;
+  mutable CoalescedExchange* mActiveExchange;
+
+  // Release all the persistent requests.
+  void freeCoalescedExchanges() const;
+#endif
+
 };
 
 }
@@ -70,7 +70,8 @@ SpaceFillingCurveRedistributeNodes(double,
   mMinNodesPerDomainFraction(minNodesPerDomainFraction),
   mMaxNodesPerDomainFraction(maxNodesPerDomainFraction),
   mWorkBalance(workBalance),
-  mLocalReorderOnly(localReorderOnly) {
+  mLocalReorderOnly(localReorderOnly),
+  mMigrationFraction(1.0) {
 }
 
 //------------------------------------------------------------------------------
@@ -155,9 +156,21 @@ redistributeNodes(DataBase<Dimension>& dataBase,
       (*nodeListItr)->numGhostNodes(0);
     }
 
-    // Compute the target work per domain.
+    // Compute the target work per domain.  If we're only migrating part of
+    // the way toward balance, each domain's target moves from its current
+    // work toward the mean by the migration fraction.  Since the domains are
+    // assigned consecutive ranges of the curve, starting from a prior space
+    // filling curve decomposition this only shifts the boundaries between
+    // neighboring domains.
     const Scalar targetWork = workField.sumElements()/numProcs;
     if (procID == 0) cerr << "SpaceFillingCurveRedistributeNodes: Target work per process " << targetWork << endl;
+    vector<Scalar> domainTargetWork(numProcs, targetWork);
+    if (mMigrationFraction < 1.0) {
+      vector<Scalar> localDomainWork(numProcs, 0.0);
+      for (const auto& domainNode: nodeDistribution) localDomainWork[procID] += domainNode.work;
+      domainTargetWork = allReduce(localDomainWork, MPI_SUM, Communicator::communicator());
+      for (auto& worki: domainTargetWork) worki += mMigrationFraction*(targetWork - worki);
+    }
 
     // Compute the Key indices for each point on this processor.
     if (procID == 0) cerr << "SpaceFillingCurveRedistributeNodes: Hashing indices" << endl;
@@ -236,7 +249,7 @@ redistributeNodes(DataBase<Dimension>& dataBase,
                    work,
                    lowerBound,
                    indexMax,
-                   targetWork,
+                   domainTargetWork[iProc],
                    minNodes,
                    maxNodes,
                    upperBound,
@@ -668,4 +681,23 @@ localReorderOnly(bool val) {
   mLocalReorderOnly = val;
 }
 
+//------------------------------------------------------------------------------
+// The fraction of the way toward the balanced work we move in a single
+// redistribution.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+double
+SpaceFillingCurveRedistributeNodes<Dimension>::
+migrationFraction() const {
+  return mMigrationFraction;
+}
+
+template<typename Dimension>
+void
+SpaceFillingCurveRedistributeNodes<Dimension>::
+migrationFraction(double x) {
+  VERIFY2(x > 0.0 and x <= 1.0, "SpaceFillingCurveRedistributeNodes ERROR: migrationFraction must be in (0, 1] : " << x);
+  mMigrationFraction = x;
+}
+
 }
@@ -133,11 +133,18 @@ public:
   bool localReorderOnly() const;
   void localReorderOnly(bool val);
 
+  // The fraction of the way from the current work per domain to the balanced
+  // work we move in each redistribution.  Values less than one migrate the
+  // nodes incrementally over several redistributions.
+  double migrationFraction() const;
+  void migrationFraction(double x);
+
 private:
   //--------------------------- Private Interface ---------------------------//
   double mMinNodesPerDomainFraction, mMaxNodesPerDomainFraction;
   bool mWorkBalance;
   bool mLocalReorderOnly;
+  double mMigrationFraction;
 
   // No copy or assignment operations.
   SpaceFillingCurveRedistributeNodes(const SpaceFillingCurveRedistributeNodes& nodes);
@@ -8,8 +8,10 @@ source("testDistributeByPosition2d.py")
 # The space filling curve redistributors.
 source("testMortonOrderDistribute.py")
 source("testPeanoHilbertOrderDistribute.py")
+source("testWorkRedistribution.py")
 
 # DistributedBoundary unit tests.
 source("testDistributed1d.py")
 source("testDistributed2d.py")
 source("testDistributed3d.py")
+source("testGhostExchange.py")
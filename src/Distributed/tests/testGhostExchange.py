@@ -0,0 +1,153 @@
+#ATS:test(SELF, np=4, label="DistributedBoundary ghost exchanges of mixed fixed and variable size Fields")
+#-------------------------------------------------------------------------------
+# Repeatedly exchange a mix of fixed size Fields (which go through the
+# coalesced exchange) and variable size Fields (which are exchanged one at a
+# time) with TreeDistributedBoundary, checking the ghost values against the
+# owning domains' values each time:
+#   1.  The number of fixed size Fields varies from round to round, so the
+#       persistent requests kept for each pattern of message sizes are both
+#       reused and (once there are more than 16 patterns) freed and rebuilt.
+#   2.  Some rounds apply a Field again after the coalesced exchange has been
+#       posted, having changed its values in between:  the ghosts should get
+#       the later values.
+#-------------------------------------------------------------------------------
+from Spheral1d import *
+from SpheralTestUtilities import *
+from DistributeNodes import distributeNodesInRange1d
+from generateGlobalIDs import *
+import mpi
+
+title("DistributedBoundary ghost exchanges")
+
+commandLine(nx1 = 100,
+            nx2 = 50,
+            nPerh = 2.01,
+            nScalarFields = 20,      # More than the 16 cached exchange patterns
+            nPasses = 3,
+            )
+
+if mpi.procs < 2:
+    raise RuntimeError, "testGhostExchange requires more than one domain"
+
+WT = TableKernel(BSplineKernel(), 100)
+eos = GammaLawGasMKS(2.0, 2.0)
+nodes1 = makeFluidNodeList("nodes1", eos, nPerh = nPerh, NeighborType = TreeNeighbor)
+nodes2 = makeFluidNodeList("nodes2", eos, nPerh = nPerh, NeighborType = TreeNeighbor)
+distributeNodesInRange1d([(nodes1, nx1, 1.0, (0.0, 1.0)),
+                          (nodes2, nx2, 1.0, (0.5, 1.0))],
+                         nPerh = nPerh)
+nodeLists = (nodes1, nodes2)
+globalIDs = generateGlobalIDs(nodeLists, globalNodeIDs, numGlobalNodes)
+
+db = DataBase()
+for nodes in nodeLists:
+    db.appendNodeList(nodes)
+
+domainbc = TreeDistributedBoundary.instance()
+domainbc.setAllGhostNodes(db)
+domainbc.finalizeGhostBoundary()
+for nodes in nodeLists:
+    nodes.neighbor().updateNodes()
+
+# Get the global IDs of our ghost nodes.
+for ids in globalIDs:
+    domainbc.applyGhostBoundary(ids)
+domainbc.finalizeGhostBoundary()
+nghost = mpi.allreduce(sum([nodes.numGhostNodes for nodes in nodeLists]), mpi.SUM)
+if nghost == 0:
+    raise ValueError, "No ghost nodes were created"
+
+#-------------------------------------------------------------------------------
+# The Fields to exchange, and the values we expect for each global ID.
+#-------------------------------------------------------------------------------
+scalarFields = [[ScalarField("scalar %i" % k, nodes) for k in xrange(nScalarFields)] for nodes in nodeLists]
+vectorFields = [VectorField("vector", nodes) for nodes in nodeLists]
+symTensorFields = [SymTensorField("symtensor", nodes) for nodes in nodeLists]
+vectorDoubleFields = [VectorDoubleField("vector of double", nodes) for nodes in nodeLists]
+
+def scalarValue(gid, iround, k):
+    return gid + 1000.0*iround + 0.01*k
+
+def vectorValue(gid, iround):
+    return Vector(2.0*gid + iround)
+
+def symTensorValue(gid, iround):
+    return SymTensor(3.0*gid - iround)
+
+def vectorDoubleValue(gid, iround):
+    return [gid + 0.5*j + iround for j in xrange((gid + iround) % 4)]
+
+def setInternalValues(inodes, iround, nscalar):
+    ids = globalIDs[inodes]
+    for i in xrange(nodeLists[inodes].numInternalNodes):
+        gid = ids[i]
+        for k in xrange(nscalar):
+            scalarFields[inodes][k][i] = scalarValue(gid, iround, k)
+        vectorFields[inodes][i] = vectorValue(gid, iround)
+        symTensorFields[inodes][i] = symTensorValue(gid, iround)
+        vectorDoubleFields[inodes][i] = vector_of_double(vectorDoubleValue(gid, iround))
+
+def scrambleGhostValues(inodes, nscalar):
+    nodes = nodeLists[inodes]
+    for i in xrange(nodes.firstGhostNode, nodes.numNodes):
+        for k in xrange(nscalar):
+            scalarFields[inodes][k][i] = -1.0
+        vectorFields[inodes][i] = Vector(-1.0)
+        symTensorFields[inodes][i] = SymTensor(-1.0)
+        vectorDoubleFields[inodes][i] = vector_of_double([-1.0]*5)
+
+def checkGhostValues(inodes, iround, nscalar, reapplyRound):
+    nodes = nodeLists[inodes]
+    ids = globalIDs[inodes]
+    for i in xrange(nodes.firstGhostNode, nodes.numNodes):
+        gid = ids[i]
+        for k in xrange(nscalar):
+            if k == 0:
+                ans = scalarValue(gid, reapplyRound, k)
+            else:
+                ans = scalarValue(gid, iround, k)
+            if scalarFields[inodes][k][i] != ans:
+                raise ValueError, "Round %i: %s ghost %i (global ID %i) value %g != %g" % (iround, scalarFields[inodes][k].name, i, gid, scalarFields[inodes][k][i], ans)
+        checks = ((vectorFields[inodes][i], vectorValue(gid, iround), vectorFields[inodes].name),
+                  (symTensorFields[inodes][i], symTensorValue(gid, iround), symTensorFields[inodes].name),
+                  (list(vectorDoubleFields[inodes][i]), vectorDoubleValue(gid, iround), vectorDoubleFields[inodes].name))
+        for x, ans, name in checks:
+            if x != ans:
+                raise ValueError, "Round %i: %s ghost %i (global ID %i) value %s != %s" % (iround, name, i, gid, x, ans)
+
+#-------------------------------------------------------------------------------
+# Do the exchanges.
+#-------------------------------------------------------------------------------
+nrounds = nPasses*nScalarFields
+for iround in xrange(nrounds):
+    nscalar = iround % nScalarFields + 1
+    reapply = (iround % 3 == 1)
+    for inodes in xrange(len(nodeLists)):
+        setInternalValues(inodes, iround, nscalar)
+        scrambleGhostValues(inodes, nscalar)
+
+    # Interleave the fixed and variable size Fields.
+    for inodes in xrange(len(nodeLists)):
+        domainbc.applyGhostBoundary(vectorDoubleFields[inodes])
+        domainbc.applyGhostBoundary(scalarFields[inodes][0])
+        domainbc.applyGhostBoundary(vectorFields[inodes])
+    for inodes in xrange(len(nodeLists)):
+        for k in xrange(1, nscalar):
+            domainbc.applyGhostBoundary(scalarFields[inodes][k])
+        domainbc.applyGhostBoundary(symTensorFields[inodes])
+
+    # Post the coalesced exchange, and then change and apply the first scalar
+    # Field again so it is also exchanged on its own.
+    domainbc.beginGhostBoundary()
+    if reapply:
+        for inodes in xrange(len(nodeLists)):
+            ids = globalIDs[inodes]
+            for i in xrange(nodeLists[inodes].numInternalNodes):
+                scalarFields[inodes][0][i] = scalarValue(ids[i], iround + nrounds, 0)
+            domainbc.applyGhostBoundary(scalarFields[inodes][0])
+    domainbc.finalizeGhostBoundary()
+
+    for inodes in xrange(len(nodeLists)):
+        checkGhostValues(inodes, iround, nscalar, iround + nrounds if reapply else iround)
+
+print "PASS"
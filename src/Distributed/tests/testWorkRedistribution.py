@@ -0,0 +1,136 @@
+#ATS:test(SELF, np=4, label="Space filling curve redistribution on measured work")
+#-------------------------------------------------------------------------------
+# Check the work based space filling curve redistribution:
+#   1.  With migrationFraction < 1 each domain's work moves only that fraction
+#       of the way from its current work toward the mean.
+#   2.  With migrationFraction = 1 the domains end up balanced.
+#   3.  SpheralController only redistributes when the max/mean domain work
+#       exceeds redistributeImbalanceThreshold.
+#-------------------------------------------------------------------------------
+from Spheral1d import *
+from SpheralTestUtilities import *
+
+title("Space filling curve redistribution on measured work")
+
+commandLine(nx = 400,
+            x0 = 0.0,
+            x1 = 1.0,
+            nPerh = 2.01,
+
+            # The nodes in [x0, xheavy) cost this much work, the rest cost 1.
+            xheavy = 0.25,
+            heavyWork = 2.0,
+
+            migrationFraction = 0.5,
+            imbalanceThreshold = 1.15,
+            )
+
+if mpi.procs < 2:
+    raise RuntimeError, "testWorkRedistribution requires more than one domain"
+
+WT = TableKernel(BSplineKernel(), 1000)
+eos = GammaLawGasMKS(5.0/3.0, 1.0)
+nodes = makeFluidNodeList("nodes", eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+from DistributeNodes import distributeNodesInRange1d
+distributeNodesInRange1d([(nodes, nx, 1.0, (x0, x1))], nPerh = nPerh)
+db = DataBase()
+db.appendNodeList(nodes)
+
+#-------------------------------------------------------------------------------
+# Helpers.
+#-------------------------------------------------------------------------------
+def setWork(heavy):
+    pos = nodes.positions()
+    work = nodes.work()
+    for i in xrange(nodes.numInternalNodes):
+        if pos[i].x < xheavy:
+            work[i] = heavy
+        else:
+            work[i] = 1.0
+
+def domainWork():
+    work = nodes.work()
+    localWork = sum([work[i] for i in xrange(nodes.numInternalNodes)])
+    result = [0.0]*mpi.procs
+    result[mpi.rank] = localWork
+    return mpi.allreduce(result, mpi.SUM)
+
+def domainNodes():
+    result = [0]*mpi.procs
+    result[mpi.rank] = nodes.numInternalNodes
+    return mpi.allreduce(result, mpi.SUM)
+
+def checkTargets(label, before, fraction, tolerance):
+    after = domainWork()
+    mean = sum(before)/mpi.procs
+    expected = [x + fraction*(mean - x) for x in before]
+    print "%s: domain work before %s, after %s, expected %s" % (label, before, after, expected)
+    if abs(sum(after) - sum(before)) > 1.0e-10*sum(before):
+        raise ValueError, "%s: total work changed %g -> %g" % (label, sum(before), sum(after))
+    for proc in xrange(mpi.procs):
+        if abs(after[proc] - expected[proc]) > tolerance:
+            raise ValueError, "%s: domain %i work %g, expected %g" % (label, proc, after[proc], expected[proc])
+    return after
+
+# A single node's work is the granularity we can balance to.
+tolerance = 2.0*heavyWork + 1.0e-10
+nglobal = mpi.allreduce(nodes.numInternalNodes, mpi.SUM)
+
+#-------------------------------------------------------------------------------
+# Start from a balanced curve decomposition, so the domains are consecutive
+# ranges of the curve.
+#-------------------------------------------------------------------------------
+repartition = PeanoHilbertOrderRedistributeNodes(2.0)
+assert repartition.workBalance and not repartition.computeWork
+setWork(1.0)
+repartition.redistributeNodes(db)
+checkTargets("Uniform work", [float(nglobal)/mpi.procs]*mpi.procs, 1.0, tolerance)
+
+#-------------------------------------------------------------------------------
+# Partial then full migration toward balance.
+#-------------------------------------------------------------------------------
+setWork(heavyWork)
+before = domainWork()
+assert max(before) > imbalanceThreshold*sum(before)/mpi.procs
+repartition.migrationFraction = migrationFraction
+repartition.redistributeNodes(db)
+after = checkTargets("migrationFraction = %g" % migrationFraction, before, migrationFraction, tolerance)
+if max(after) <= sum(after)/mpi.procs + tolerance:
+    raise ValueError, "Partial migration balanced the work in one go: %s" % after
+
+repartition.migrationFraction = 1.0
+repartition.redistributeNodes(db)
+checkTargets("migrationFraction = 1", after, 1.0, tolerance)
+assert mpi.allreduce(nodes.numInternalNodes, mpi.SUM) == nglobal
+
+#-------------------------------------------------------------------------------
+# The controller only redistributes past the imbalance threshold.
+#-------------------------------------------------------------------------------
+hydro = SPH(dataBase = db, W = WT, Q = MonaghanGingoldViscosity(1.0, 1.0))
+integrator = CheapSynchronousRK2Integrator(db)
+integrator.appendPhysicsPackage(hydro)
+control = SpheralController(integrator, WT,
+                            redistributeStep = 1000,
+                            redistributeImbalanceThreshold = imbalanceThreshold,
+                            redistributeMigrationFraction = 1.0,
+                            restartBaseName = "testWorkRedistribution-restart")
+assert integrator.measureWork
+assert control.redistribute.migrationFraction == 1.0
+
+# The current decomposition is balanced on the heavy work, so nothing moves.
+setWork(heavyWork)
+counts = domainNodes()
+work = domainWork()
+assert max(work) <= imbalanceThreshold*sum(work)/mpi.procs
+control.updateDomainDistribution(0, 0.0, 0.0)
+if domainNodes() != counts:
+    raise ValueError, "Controller redistributed below the imbalance threshold: %s -> %s" % (counts, domainNodes())
+
+# Uniform work leaves the domains with the light nodes imbalanced past the
+# threshold, so the controller rebalances.
+setWork(1.0)
+work = domainWork()
+assert max(work) > imbalanceThreshold*sum(work)/mpi.procs
+control.updateDomainDistribution(0, 0.0, 0.0)
+checkTargets("Controller", work, 1.0, tolerance)
+print "PASS"
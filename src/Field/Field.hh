@@ -217,6 +217,7 @@ public:
                             const std::vector<char>& buffer) override;
   virtual void copyElements(const std::vector<int>& fromIndices,
                             const std::vector<int>& toIndices) override;
+  virtual void swapValues(FieldBase<Dimension>& rhs) override;
   virtual bool fixedSizeDataType() const override;
   virtual int numValsInDataType() const override;
   virtual int sizeofDataType() const override;
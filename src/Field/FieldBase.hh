@@ -64,6 +64,7 @@ public:
                             const std::vector<char>& buffer) = 0;
   virtual void copyElements(const std::vector<int>& fromIndices,
                             const std::vector<int>& toIndices) = 0;
+  virtual void swapValues(FieldBase& rhs) = 0;
   virtual bool fixedSizeDataType() const = 0;
   virtual int numValsInDataType() const = 0;
   virtual int sizeofDataType() const = 0;
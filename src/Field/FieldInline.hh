@@ -1321,6 +1321,25 @@ copyElements(const std::vector<int>& fromIndices,
   for (auto k = 0u; k < ni; ++k) (*this)(toIndices[k]) = (*this)(fromIndices[k]);
 }
 
+//------------------------------------------------------------------------------
+// Exchange our values with another Field of the same type on the same
+// NodeList.  This just swaps the underlying storage, so no values are copied.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+void
+Field<Dimension, DataType>::
+swapValues(FieldBase<Dimension>& rhs) {
+  auto* rhsPtr = dynamic_cast<Field<Dimension, DataType>*>(&rhs);
+  VERIFY2(rhsPtr != nullptr, "Attempt to swap values with an incompatible field type.");
+  REQUIRE(this->nodeListPtr() == rhsPtr->nodeListPtr());
+  REQUIRE(this->size() == rhsPtr->size());
+  if (rhsPtr != this) {
+    mDataArray.swap(rhsPtr->mDataArray);
+    std::swap(mValid, rhsPtr->mValid);
+  }
+}
+
 //------------------------------------------------------------------------------
 // fixedSizeDataType
 //------------------------------------------------------------------------------
@@ -0,0 +1,888 @@
+//---------------------------------Spheral++----------------------------------//
+// MemoryFileIO -- A FileIO which holds everything written to it in memory.
+//----------------------------------------------------------------------------//
+#include "MemoryFileIO.hh"
+#include "Field/Field.hh"
+#include "Utilities/packElement.hh"
+#include "Utilities/DataTypeTraits.hh"
+#include "Utilities/DBC.hh"
+
+#include "boost/algorithm/string.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+using std::vector;
+using std::string;
+
+namespace Spheral {
+
+namespace {
+
+// Tag identifying our files.
+const string MemoryFileIO_magic = "SpheralMemoryFileIO-1";
+
+//------------------------------------------------------------------------------
+// Canonicalize a path name ("a/b/c"), so that paths differing only in
+// redundant slashes refer to the same record.
+//------------------------------------------------------------------------------
+string canonicalPath(const string& pathName) {
+  vector<string> components;
+  boost::split(components, pathName, boost::is_any_of("/"));
+  string result;
+  for (const auto& dirName: components) {
+    if (dirName.size() > 0) {
+      if (not result.empty()) result += "/";
+      result += dirName;
+    }
+  }
+  return result;
+}
+
+}   // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Empty constructor.
+//------------------------------------------------------------------------------
+MemoryFileIO::MemoryFileIO():
+  FileIO(),
+  mRecords() {
+}
+
+//------------------------------------------------------------------------------
+// Construct and open the given file.
+//------------------------------------------------------------------------------
+MemoryFileIO::
+MemoryFileIO(const string fileName, AccessType access):
+  FileIO(fileName, access),
+  mRecords() {
+  open(fileName, access);
+  ENSURE(mFileOpen);
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//------------------------------------------------------------------------------
+MemoryFileIO::~MemoryFileIO() {
+  close();
+}
+
+//------------------------------------------------------------------------------
+// Open a file with the specified access.  If reading we load the whole file
+// into memory now.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::open(const string fileName, AccessType access) {
+  VERIFY2(mFileOpen == false,
+          "ERROR: attempt to reopen MemoryFileIO object.");
+
+  string fullFileName = fileName;
+  if (fullFileName.find(".restart") == string::npos) {
+    fullFileName += ".restart";
+  }
+
+  mFileName = fullFileName;
+  mAccess = access;
+  mRecords.clear();
+  if (access == AccessType::Read) this->readFile(fullFileName);
+  mFileOpen = true;
+}
+
+//------------------------------------------------------------------------------
+// Close the current file, writing our contents if we're not read only.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::close() {
+  if (mFileOpen) {
+    if (mAccess != AccessType::Read) this->writeFile(mFileName);
+    mRecords.clear();
+  }
+  mFileOpen = false;
+}
+
+//------------------------------------------------------------------------------
+// The number of bytes currently held.
+//------------------------------------------------------------------------------
+size_t
+MemoryFileIO::numBytes() const {
+  size_t result = 0u;
+  for (const auto& val: mRecords) result += val.second.size();
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Check if the specified path is in the file.  This may be either a value,
+// or a "directory" containing values.
+//------------------------------------------------------------------------------
+bool
+MemoryFileIO::pathExists(const std::string pathName) const {
+  const string path = canonicalPath(pathName);
+  if (path.empty()) return true;
+  const auto itr = mRecords.lower_bound(path);
+  if (itr == mRecords.end()) return false;
+  if (itr->first == path) return true;
+  // Any paths within this directory sort immediately after "path/".
+  const auto ditr = mRecords.lower_bound(path + "/");
+  return (ditr != mRecords.end() and ditr->first.compare(0, path.size() + 1, path + "/") == 0);
+}
+
+//------------------------------------------------------------------------------
+// Get an empty buffer for the given path.
+//------------------------------------------------------------------------------
+vector<char>&
+MemoryFileIO::newRecord(const string pathName) {
+  REQUIRE(mFileOpen and mAccess != AccessType::Read);
+  auto& result = mRecords[canonicalPath(pathName)];
+  result.clear();
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Get the buffer for the given path.
+//------------------------------------------------------------------------------
+const vector<char>&
+MemoryFileIO::record(const string pathName) const {
+  REQUIRE(mFileOpen);
+  const auto itr = mRecords.find(canonicalPath(pathName));
+  VERIFY2(itr != mRecords.end(), "MemoryFileIO ERROR: no value for " << pathName << " in " << mFileName);
+  return itr->second;
+}
+
+//------------------------------------------------------------------------------
+// Write/read anything packElement understands.
+//------------------------------------------------------------------------------
+template<typename Value>
+void
+MemoryFileIO::writeValue(const Value& value, const string pathName) {
+  packElement(value, this->newRecord(pathName));
+}
+
+template<typename Value>
+void
+MemoryFileIO::readValue(Value& value, const string pathName) const {
+  const auto& buffer = this->record(pathName);
+  auto itr = buffer.begin();
+  unpackElement(value, itr, buffer.end());
+  VERIFY2(itr == buffer.end(), "MemoryFileIO ERROR: bad size reading " << pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field.  Values which are flat arrays of elements (everything but
+// ThirdRankTensor) are copied as a single block.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename Value>
+void
+MemoryFileIO::writeField(const Field<Dimension, Value>& field,
+                         const string pathName) {
+  typedef typename DataTypeTraits<Value>::ElementType ElementType;
+  this->writeValue(field.name(), pathName + "/name");
+  auto& buffer = this->newRecord(pathName + "/values");
+  const size_t n = field.numInternalElements();
+  if (n > 0) {
+    const size_t nbytes = DataTypeTraits<Value>::numElements(field(0))*sizeof(ElementType);
+    if (sizeof(Value) == nbytes) {
+      const char* data = reinterpret_cast<const char*>(&field(0));
+      buffer.assign(data, data + n*nbytes);
+    } else {
+      buffer.reserve(n*nbytes);
+      for (auto i = 0u; i < n; ++i) packElement(field(i), buffer);
+    }
+    ENSURE(buffer.size() == n*nbytes);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Read a Field.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename Value>
+void
+MemoryFileIO::readField(Field<Dimension, Value>& field,
+                        const string pathName) const {
+  typedef typename DataTypeTraits<Value>::ElementType ElementType;
+  string fieldname;
+  this->readValue(fieldname, pathName + "/name");
+  field.name(fieldname);
+  const auto& buffer = this->record(pathName + "/values");
+  const size_t n = field.numInternalElements();
+  const size_t nbytes = (n > 0 ? DataTypeTraits<Value>::numElements(field(0))*sizeof(ElementType) : 0u);
+  VERIFY2(buffer.size() == n*nbytes,
+          "MemoryFileIO ERROR: bad Field size reading " << pathName << " : " << buffer.size() << " != " << n*nbytes);
+  if (n > 0) {
+    if (sizeof(Value) == nbytes) {
+      std::memcpy(reinterpret_cast<char*>(&field(0)), &buffer.front(), n*nbytes);
+    } else {
+      auto itr = buffer.begin();
+      for (auto i = 0u; i < n; ++i) unpackElement(field(i), itr, buffer.end());
+      CHECK(itr == buffer.end());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Write our records to a file.  Each record is the path, the number of bytes,
+// and the bytes.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::writeFile(const string fileName) const {
+  std::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  VERIFY2(os, "MemoryFileIO ERROR: unable to open " << fileName << " for writing");
+  vector<char> header;
+  packElement(MemoryFileIO_magic, header);
+  packElement(unsigned(mRecords.size()), header);
+  os.write(&header.front(), header.size());
+  for (const auto& val: mRecords) {
+    header.clear();
+    packElement(val.first, header);
+    packElement(val.second.size(), header);
+    os.write(&header.front(), header.size());
+    if (not val.second.empty()) os.write(&val.second.front(), val.second.size());
+  }
+  os.close();
+  VERIFY2(os, "MemoryFileIO ERROR: failed writing " << fileName);
+}
+
+//------------------------------------------------------------------------------
+// Read the records from a file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::readFile(const string fileName) {
+  std::ifstream is(fileName.c_str(), std::ios::in | std::ios::binary);
+  VERIFY2(is, "MemoryFileIO ERROR: unable to open " << fileName << " for reading");
+  const vector<char> buffer((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+  auto itr = buffer.begin();
+  const auto end = buffer.end();
+  string magic;
+  unsigned numRecords;
+  unpackElement(magic, itr, end);
+  VERIFY2(magic == MemoryFileIO_magic, "MemoryFileIO ERROR: " << fileName << " is not a MemoryFileIO file");
+  unpackElement(numRecords, itr, end);
+  for (auto k = 0u; k < numRecords; ++k) {
+    string path;
+    size_t nbytes;
+    unpackElement(path, itr, end);
+    unpackElement(nbytes, itr, end);
+    VERIFY2(size_t(std::distance(itr, end)) >= nbytes, "MemoryFileIO ERROR: " << fileName << " is truncated");
+    mRecords[path].assign(itr, itr + nbytes);
+    itr += nbytes;
+  }
+  VERIFY2(itr == end, "MemoryFileIO ERROR: unexpected data at the end of " << fileName);
+}
+
+//------------------------------------------------------------------------------
+// Write an unsigned to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const unsigned& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write an int to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const int& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a bool to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const bool& value, const string pathName) {
+  const int ivalue = value ? 1 : 0;
+  this->writeValue(ivalue, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a double to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const double& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a string to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const string& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<int> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const std::vector<int>& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<double> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const std::vector<double>& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<string> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const std::vector<string>& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read an unsigned from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(unsigned& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read an int from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(int& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a bool from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(bool& value, const string pathName) const {
+  int ivalue;
+  this->readValue(ivalue, pathName);
+  value = (ivalue == 1);
+}
+
+//------------------------------------------------------------------------------
+// Read a double from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(double& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a string from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(string& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<int> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(std::vector<int>& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<double> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(std::vector<double>& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<string> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(std::vector<string>& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<1>::Vector& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<1>::Tensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<1>::SymTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<1>::ThirdRankTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<2>::Vector& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<2>::Tensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<2>::SymTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<2>::ThirdRankTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<3>::Vector& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<3>::Tensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<3>::SymTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Dim<3>::ThirdRankTensor& value, const string pathName) {
+  this->writeValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<1>::Vector& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<1>::Tensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<1>::SymTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<1>::ThirdRankTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<2>::Vector& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<2>::Tensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<2>::SymTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<2>::ThirdRankTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<3>::Vector& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<3>::Tensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<3>::SymTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Dim<3>::ThirdRankTensor& value, const string pathName) const {
+  this->readValue(value, pathName);
+}
+
+#ifdef SPHERAL1D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, Dim<1>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, Dim<1>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, Dim<1>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, Dim<1>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, Dim<1>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, int> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<1>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, Dim<1>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, Dim<1>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, Dim<1>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, Dim<1>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, Dim<1>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, int> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<1>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+#ifdef SPHERAL2D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, Dim<2>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, Dim<2>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, Dim<2>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, Dim<2>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, Dim<2>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, int> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<2>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, Dim<2>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, Dim<2>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, Dim<2>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, Dim<2>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, Dim<2>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, int> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<2>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+#ifdef SPHERAL3D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, Dim<3>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, Dim<3>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, Dim<3>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, Dim<3>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, Dim<3>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, int> to the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::write(const Field<Dim<3>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, Dim<3>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, Dim<3>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, Dim<3>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, Dim<3>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, Dim<3>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, int> from the file.
+//------------------------------------------------------------------------------
+void
+MemoryFileIO::read(Field<Dim<3>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+}
@@ -0,0 +1,1211 @@
+//---------------------------------Spheral++----------------------------------//
+// ParallelHDF5FileIO -- Provide the interface to a single HDF5 file shared by
+// all processes.
+//----------------------------------------------------------------------------//
+#include "ParallelHDF5FileIO.hh"
+#include "Field/Field.hh"
+#include "Distributed/Communicator.hh"
+#include "Utilities/allReduce.hh"
+#include "Utilities/DBC.hh"
+
+#include "boost/algorithm/string.hpp"
+
+#include <algorithm>
+#include <numeric>
+using std::vector;
+using std::string;
+using std::min;
+using std::max;
+
+// We can only share a file between processes if HDF5 provides the MPI-IO driver.
+#if defined(USE_MPI) && defined(H5_HAVE_PARALLEL)
+#define SPHERAL_HDF5_MPIO
+#endif
+
+namespace Spheral {
+
+namespace {
+
+// The maximum number of elements in a compressed chunk.
+const hsize_t maxChunkSize = 65536u;
+
+// The group holding the buffered (non-Field) values.
+const string bufferedValuesPath = "/ParallelHDF5FileIO_values";
+
+//------------------------------------------------------------------------------
+// Canonicalize a path name to an absolute HDF5 path ("/a/b/c").
+//------------------------------------------------------------------------------
+string HDF5_path(const string& pathName) {
+  vector<string> components;
+  boost::split(components, pathName, boost::is_any_of("/"));
+  string result;
+  for (const auto& dirName: components) {
+    if (dirName.size() > 0) result += "/" + dirName;
+  }
+  return (result.empty() ? string("/") : result);
+}
+
+//------------------------------------------------------------------------------
+// Check if a path is in the HDF5 file.
+//------------------------------------------------------------------------------
+bool HDF5_pathExists(const hid_t fileID, const string& pathName) {
+  // H5Lexists requires every parent along the path to exist, so we have to
+  // check each level in turn.
+  vector<string> components;
+  boost::split(components, pathName, boost::is_any_of("/"));
+  string path;
+  for (const auto& dirName: components) {
+    if (dirName.size() > 0) {
+      path += "/" + dirName;
+      if (H5Lexists(fileID, path.c_str(), H5P_DEFAULT) <= 0) return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Read the offsets delimiting each process's slice of a ragged dataset.
+//------------------------------------------------------------------------------
+vector<hsize_t> readOffsets(const hid_t fileID,
+                            const hid_t transferProps,
+                            const string& path) {
+  const hid_t dset = H5Dopen2(fileID, (path + "/offsets").c_str(), H5P_DEFAULT);
+  VERIFY2(dset >= 0, "ParallelHDF5FileIO ERROR: unable to open " << path);
+  const hid_t space = H5Dget_space(dset);
+  const hssize_t n = H5Sget_simple_extent_npoints(space);
+  VERIFY2(n == hssize_t(Process::getTotalNumberOfProcesses() + 1),
+          "ParallelHDF5FileIO ERROR: " << path << " was written by " << (n - 1) << " processes, but is being read by "
+          << Process::getTotalNumberOfProcesses() << ".  A ParallelHDF5FileIO file must be read with the same number of"
+          << " processes that wrote it.");
+  vector<hsize_t> result(n);
+  VERIFY2(H5Dread(dset, H5T_NATIVE_HSIZE, H5S_ALL, H5S_ALL, transferProps, &result.front()) >= 0,
+          "ParallelHDF5FileIO ERROR: unable to read offsets for " << path);
+  H5Sclose(space);
+  H5Dclose(dset);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Describe the values of a Field as an array of HDF5 elements.
+// These methods work for types Vector, Tensor, SymTensor, ThirdRankTensor, ...
+//------------------------------------------------------------------------------
+template<typename Value>
+struct FieldElements {
+  typedef double ElementType;
+  static hid_t type() { return H5T_NATIVE_DOUBLE; }
+  static hsize_t numElements() { return Value::numElements; }
+
+  // Can we treat an array of Values as a flat array of doubles?
+  static bool contiguous(const Value& x) {
+    return (sizeof(Value) == Value::numElements*sizeof(double) and
+            &(*x.begin()) == reinterpret_cast<const double*>(&x));
+  }
+  static const double* begin(const Value& x) { return &(*x.begin()); }
+  static double* begin(Value& x) { return &(*x.begin()); }
+};
+
+template<>
+struct FieldElements<double> {
+  typedef double ElementType;
+  static hid_t type() { return H5T_NATIVE_DOUBLE; }
+  static hsize_t numElements() { return 1u; }
+  static bool contiguous(const double&) { return true; }
+  static const double* begin(const double& x) { return &x; }
+  static double* begin(double& x) { return &x; }
+};
+
+template<>
+struct FieldElements<int> {
+  typedef int ElementType;
+  static hid_t type() { return H5T_NATIVE_INT; }
+  static hsize_t numElements() { return 1u; }
+  static bool contiguous(const int&) { return true; }
+  static const int* begin(const int& x) { return &x; }
+  static int* begin(int& x) { return &x; }
+};
+
+}   // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Empty constructor.
+//------------------------------------------------------------------------------
+ParallelHDF5FileIO::ParallelHDF5FileIO():
+  FileIO(),
+  mFileID(-1),
+  mTransferProps(-1),
+  mCompressionLevel(0),
+  mValues() {
+}
+
+//------------------------------------------------------------------------------
+// Construct and open the given file.
+//------------------------------------------------------------------------------
+ParallelHDF5FileIO::
+ParallelHDF5FileIO(const string fileName, AccessType access):
+  FileIO(fileName, access),
+  mFileID(-1),
+  mTransferProps(-1),
+  mCompressionLevel(0),
+  mValues() {
+  open(fileName, access);
+  ENSURE(mFileOpen && mFileID >= 0);
+}
+
+//------------------------------------------------------------------------------
+// Construct and open the given file, specifying the compression level.
+//------------------------------------------------------------------------------
+ParallelHDF5FileIO::
+ParallelHDF5FileIO(const string fileName, AccessType access, const int compressionLevel):
+  FileIO(fileName, access),
+  mFileID(-1),
+  mTransferProps(-1),
+  mCompressionLevel(0),
+  mValues() {
+  this->compressionLevel(compressionLevel);
+  open(fileName, access);
+  ENSURE(mFileOpen && mFileID >= 0);
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//------------------------------------------------------------------------------
+ParallelHDF5FileIO::~ParallelHDF5FileIO() {
+  close();
+}
+
+//------------------------------------------------------------------------------
+// Open an HDF5 file with the specified access.  Collective.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::open(const string fileName, AccessType access) {
+  VERIFY2(mFileID < 0 and mFileOpen == false,
+          "ERROR: attempt to reopen ParallelHDF5FileIO object.");
+
+  string fullFileName = fileName;
+  if (fullFileName.find(".h5") == string::npos) {
+    fullFileName += ".h5";
+  }
+
+  const hid_t fileProps = H5Pcreate(H5P_FILE_ACCESS);
+  mTransferProps = H5Pcreate(H5P_DATASET_XFER);
+#ifdef SPHERAL_HDF5_MPIO
+  VERIFY2(H5Pset_fapl_mpio(fileProps, Communicator::communicator(), MPI_INFO_NULL) >= 0 and
+          H5Pset_dxpl_mpio(mTransferProps, H5FD_MPIO_COLLECTIVE) >= 0,
+          "ParallelHDF5FileIO ERROR: unable to select MPI-IO for " << fullFileName);
+#if H5_VERSION_GE(1, 10, 0)
+  // Every process makes the same metadata calls, so let HDF5 do them collectively.
+  H5Pset_all_coll_metadata_ops(fileProps, true);
+  H5Pset_coll_metadata_write(fileProps, true);
+#endif
+#else
+  VERIFY2(Process::getTotalNumberOfProcesses() == 1,
+          "ParallelHDF5FileIO ERROR: HDF5 was built without parallel support, so cannot share " << fullFileName
+          << " between processes.");
+#endif
+
+  if (access == AccessType::Read) {
+    mFileID = H5Fopen(fullFileName.c_str(), H5F_ACC_RDONLY, fileProps);
+  } else {
+    mFileID = H5Fcreate(fullFileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileProps);
+  }
+  H5Pclose(fileProps);
+  VERIFY2(mFileID >= 0, "ParallelHDF5FileIO ERROR: unable to open " << fullFileName);
+  mFileName = fullFileName;
+  mAccess = access;
+  mFileOpen = true;
+
+  // Load the buffered values, which also checks that we have the same number
+  // of processes that wrote the file.
+  mValues.clear();
+  if (access == AccessType::Read) this->readBufferedValues();
+}
+
+//------------------------------------------------------------------------------
+// Close the current file.  Collective.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::close() {
+  if (mFileID >= 0) {
+    if (mAccess != AccessType::Read) this->writeBufferedValues();
+    VERIFY2(H5Fclose(mFileID) >= 0,
+            "ParallelHDF5FileIO ERROR: unable to close file.");
+    mFileID = -1;
+  }
+  if (mTransferProps >= 0) {
+    H5Pclose(mTransferProps);
+    mTransferProps = -1;
+  }
+  mValues.clear();
+  mFileOpen = false;
+}
+
+//------------------------------------------------------------------------------
+// Check if the specified path is in the file.
+//------------------------------------------------------------------------------
+bool
+ParallelHDF5FileIO::pathExists(const std::string pathName) const {
+  REQUIRE(mFileID >= 0);
+
+  // The path may be a buffered value, or a parent of one.
+  const string path = HDF5_path(pathName);
+  if (mValues.find(path) != mValues.end()) return true;
+  const string prefix = (path == "/" ? path : path + "/");
+  const auto itr = mValues.lower_bound(prefix);
+  if (itr != mValues.end() and itr->first.compare(0, prefix.size(), prefix) == 0) return true;
+
+  return HDF5_pathExists(mFileID, path);
+}
+
+//------------------------------------------------------------------------------
+// Write this process's slice of a ragged dataset.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::writeArray(const void* data,
+                               const hid_t type,
+                               const hsize_t n,
+                               const string pathName) {
+  REQUIRE(mFileID >= 0);
+  REQUIRE(n == 0 or data != 0);
+  const unsigned rank = Process::getRank();
+  const unsigned numProcs = Process::getTotalNumberOfProcesses();
+  const string path = HDF5_path(pathName);
+
+  // Gather the slice sizes from every process to build the offsets.
+  vector<hsize_t> offsets(numProcs + 1, 0u);
+  offsets[rank + 1] = n;
+#ifdef USE_MPI
+  static_assert(sizeof(hsize_t) == sizeof(unsigned long long), "ParallelHDF5FileIO requires hsize_t to be unsigned long long");
+  MPI_Allgather(&offsets[rank + 1], 1, MPI_UNSIGNED_LONG_LONG,
+                &offsets[1], 1, MPI_UNSIGNED_LONG_LONG,
+                Communicator::communicator());
+#endif
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  const hsize_t ntot = offsets.back();
+
+  // Replace any existing value, and create the group (and any parents).
+  if (HDF5_pathExists(mFileID, path)) {
+    VERIFY2(H5Ldelete(mFileID, path.c_str(), H5P_DEFAULT) >= 0,
+            "ParallelHDF5FileIO ERROR: unable to overwrite " << path);
+  }
+  const hid_t linkProps = H5Pcreate(H5P_LINK_CREATE);
+  H5Pset_create_intermediate_group(linkProps, 1);
+  const hid_t group = H5Gcreate2(mFileID, path.c_str(), linkProps, H5P_DEFAULT, H5P_DEFAULT);
+  H5Pclose(linkProps);
+  VERIFY2(group >= 0, "ParallelHDF5FileIO ERROR: unable to create " << path);
+
+  // The offsets, which every process knows, so only the root writes them.
+  {
+    const hsize_t noffsets = numProcs + 1;
+    const hid_t fileSpace = H5Screate_simple(1, &noffsets, NULL);
+    const hid_t memSpace = H5Screate_simple(1, &noffsets, NULL);
+    if (rank != 0) {
+      H5Sselect_none(fileSpace);
+      H5Sselect_none(memSpace);
+    }
+    const hid_t dset = H5Dcreate2(group, "offsets", H5T_NATIVE_HSIZE, fileSpace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VERIFY2(dset >= 0 and
+            H5Dwrite(dset, H5T_NATIVE_HSIZE, memSpace, fileSpace, mTransferProps, &offsets.front()) >= 0,
+            "ParallelHDF5FileIO ERROR: unable to write offsets for " << path);
+    H5Dclose(dset);
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+  }
+
+  // The data, each process writing its own hyperslab.
+  {
+    const hid_t createProps = H5Pcreate(H5P_DATASET_CREATE);
+    if (mCompressionLevel > 0 and ntot > 0) {
+      const hsize_t chunk = min(ntot, maxChunkSize);
+      H5Pset_chunk(createProps, 1, &chunk);
+      H5Pset_deflate(createProps, mCompressionLevel);
+    }
+    const hid_t fileSpace = H5Screate_simple(1, &ntot, NULL);
+    const hsize_t nmem = max(n, hsize_t(1u));
+    const hid_t memSpace = H5Screate_simple(1, &nmem, NULL);
+    if (n > 0) {
+      H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &offsets[rank], NULL, &n, NULL);
+    } else {
+      H5Sselect_none(fileSpace);
+      H5Sselect_none(memSpace);
+    }
+
+    // Processes with nothing to write still participate in the collective
+    // write, but HDF5 insists on a non-null buffer.
+    const char dummy = 0;
+    const hid_t dset = H5Dcreate2(group, "data", type, fileSpace, H5P_DEFAULT, createProps, H5P_DEFAULT);
+    VERIFY2(dset >= 0 and
+            H5Dwrite(dset, type, memSpace, fileSpace, mTransferProps, (n > 0 ? data : &dummy)) >= 0,
+            "ParallelHDF5FileIO ERROR: unable to write " << path);
+    H5Dclose(dset);
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+    H5Pclose(createProps);
+  }
+  H5Gclose(group);
+}
+
+//------------------------------------------------------------------------------
+// The size of this process's slice of a ragged dataset.
+//------------------------------------------------------------------------------
+hsize_t
+ParallelHDF5FileIO::localSize(const string pathName) const {
+  return this->localSize(pathName, Process::getRank());
+}
+
+hsize_t
+ParallelHDF5FileIO::localSize(const string pathName, const unsigned sourceRank) const {
+  REQUIRE(mFileID >= 0);
+  REQUIRE(sourceRank < unsigned(Process::getTotalNumberOfProcesses()));
+  const auto offsets = readOffsets(mFileID, mTransferProps, HDF5_path(pathName));
+  return offsets[sourceRank + 1] - offsets[sourceRank];
+}
+
+//------------------------------------------------------------------------------
+// Read this process's (or the given process's) slice of a ragged dataset.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::readArray(void* data,
+                              const hid_t type,
+                              const hsize_t n,
+                              const string pathName) const {
+  this->readArray(data, type, n, pathName, Process::getRank());
+}
+
+void
+ParallelHDF5FileIO::readArray(void* data,
+                              const hid_t type,
+                              const hsize_t n,
+                              const string pathName,
+                              const unsigned sourceRank) const {
+  REQUIRE(mFileID >= 0);
+  REQUIRE(n == 0 or data != 0);
+  REQUIRE(sourceRank < unsigned(Process::getTotalNumberOfProcesses()));
+  const string path = HDF5_path(pathName);
+  const auto offsets = readOffsets(mFileID, mTransferProps, path);
+  VERIFY2(offsets[sourceRank + 1] - offsets[sourceRank] == n,
+          "ParallelHDF5FileIO ERROR: bad size for " << path << " : " << n << " != " << (offsets[sourceRank + 1] - offsets[sourceRank]));
+
+  const hid_t dset = H5Dopen2(mFileID, (path + "/data").c_str(), H5P_DEFAULT);
+  VERIFY2(dset >= 0, "ParallelHDF5FileIO ERROR: unable to open " << path);
+  const hid_t fileSpace = H5Dget_space(dset);
+  const hsize_t nmem = max(n, hsize_t(1u));
+  const hid_t memSpace = H5Screate_simple(1, &nmem, NULL);
+  if (n > 0) {
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &offsets[sourceRank], NULL, &n, NULL);
+  } else {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memSpace);
+  }
+  char dummy;
+  VERIFY2(H5Dread(dset, type, memSpace, fileSpace, mTransferProps, (n > 0 ? data : &dummy)) >= 0,
+          "ParallelHDF5FileIO ERROR: unable to read " << path);
+  H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+  H5Dclose(dset);
+}
+
+//------------------------------------------------------------------------------
+// Buffer a (non-Field) value to be written when we close the file.
+//------------------------------------------------------------------------------
+template<typename Value>
+void
+ParallelHDF5FileIO::writeValues(const Value* data, const size_t n, const string pathName) {
+  REQUIRE(mFileID >= 0);
+  REQUIRE(n == 0 or data != 0);
+  const char* bytes = reinterpret_cast<const char*>(data);
+  mValues[HDF5_path(pathName)] = vector<char>(bytes, bytes + n*sizeof(Value));
+}
+
+//------------------------------------------------------------------------------
+// Look up a buffered value.
+//------------------------------------------------------------------------------
+const vector<char>&
+ParallelHDF5FileIO::bufferedValue(const string pathName) const {
+  REQUIRE(mFileID >= 0);
+  const auto itr = mValues.find(HDF5_path(pathName));
+  VERIFY2(itr != mValues.end(), "ParallelHDF5FileIO ERROR: unable to find " << HDF5_path(pathName));
+  return itr->second;
+}
+
+template<typename Value>
+void
+ParallelHDF5FileIO::readValues(Value* data, const size_t n, const string pathName) const {
+  const auto& buf = this->bufferedValue(pathName);
+  VERIFY2(buf.size() == n*sizeof(Value),
+          "ParallelHDF5FileIO ERROR: bad size for " << HDF5_path(pathName) << " : " << n*sizeof(Value) << " != " << buf.size());
+  std::copy(buf.begin(), buf.end(), reinterpret_cast<char*>(data));
+}
+
+template<typename Value>
+void
+ParallelHDF5FileIO::readValues(vector<Value>& values, const string pathName) const {
+  const auto& buf = this->bufferedValue(pathName);
+  VERIFY2(buf.size() % sizeof(Value) == 0,
+          "ParallelHDF5FileIO ERROR: bad size for " << HDF5_path(pathName) << " : " << buf.size());
+  values.resize(buf.size()/sizeof(Value));
+  std::copy(buf.begin(), buf.end(), reinterpret_cast<char*>(values.data()));
+}
+
+//------------------------------------------------------------------------------
+// Write all the buffered values with three collective writes:  the paths
+// (which are the same on every process, so only the root writes them), and
+// each process's value sizes and values.  Collective.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::writeBufferedValues() {
+  REQUIRE(mFileID >= 0);
+  const unsigned rank = Process::getRank();
+  const int numValues = mValues.size();
+  VERIFY2(allReduce(numValues, MPI_MIN, Communicator::communicator()) == numValues and
+          allReduce(numValues, MPI_MAX, Communicator::communicator()) == numValues,
+          "ParallelHDF5FileIO ERROR: processes wrote different sets of values to " << mFileName);
+  string paths;
+  vector<hsize_t> sizes;
+  vector<char> data;
+  sizes.reserve(numValues);
+  for (const auto& val: mValues) {
+    paths += val.first;
+    paths += '\0';
+    sizes.push_back(val.second.size());
+    data.insert(data.end(), val.second.begin(), val.second.end());
+  }
+  this->writeArray(paths.data(), H5T_NATIVE_CHAR, (rank == 0 ? paths.size() : 0u), bufferedValuesPath + "/paths");
+  this->writeArray(sizes.data(), H5T_NATIVE_HSIZE, sizes.size(), bufferedValuesPath + "/sizes");
+  this->writeArray(data.data(), H5T_NATIVE_CHAR, data.size(), bufferedValuesPath + "/data");
+  mValues.clear();
+}
+
+//------------------------------------------------------------------------------
+// Load all the buffered values for this process.  Collective.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::readBufferedValues() {
+  REQUIRE(mFileID >= 0);
+  mValues.clear();
+  VERIFY2(HDF5_pathExists(mFileID, bufferedValuesPath),
+          "ParallelHDF5FileIO ERROR: " << mFileName << " was not written by ParallelHDF5FileIO");
+  vector<char> paths(this->localSize(bufferedValuesPath + "/paths", 0u));
+  this->readArray(paths.data(), H5T_NATIVE_CHAR, paths.size(), bufferedValuesPath + "/paths", 0u);
+  vector<hsize_t> sizes(this->localSize(bufferedValuesPath + "/sizes"));
+  this->readArray(sizes.data(), H5T_NATIVE_HSIZE, sizes.size(), bufferedValuesPath + "/sizes");
+  vector<char> data(this->localSize(bufferedValuesPath + "/data"));
+  this->readArray(data.data(), H5T_NATIVE_CHAR, data.size(), bufferedValuesPath + "/data");
+  auto pathItr = paths.cbegin();
+  auto dataItr = data.cbegin();
+  for (const auto n: sizes) {
+    const auto pathEnd = std::find(pathItr, paths.cend(), '\0');
+    VERIFY2(pathEnd != paths.cend() and hsize_t(data.cend() - dataItr) >= n,
+            "ParallelHDF5FileIO ERROR: corrupt values in " << mFileName);
+    mValues[string(pathItr, pathEnd)] = vector<char>(dataItr, dataItr + n);
+    pathItr = pathEnd + 1;
+    dataItr += n;
+  }
+  VERIFY2(pathItr == paths.cend() and dataItr == data.cend(),
+          "ParallelHDF5FileIO ERROR: corrupt values in " << mFileName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field.  Fields whose values are flat arrays of doubles (or ints) are
+// written directly from the Field storage.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename Value>
+void
+ParallelHDF5FileIO::writeField(const Field<Dimension, Value>& field,
+                               const string pathName) {
+  typedef FieldElements<Value> Elements;
+  typedef typename Elements::ElementType ElementType;
+  const hsize_t n = field.numInternalElements();
+  const hsize_t ne = Elements::numElements();
+  this->write(field.name(), pathName + "/name");
+  if (n == 0) {
+    this->writeArray(0, Elements::type(), 0u, pathName + "/values");
+  } else if (Elements::contiguous(field(0))) {
+    this->writeArray(Elements::begin(field(0)), Elements::type(), n*ne, pathName + "/values");
+  } else {
+    vector<ElementType> buf(n*ne);
+    for (auto i = 0u; i < n; ++i) std::copy(Elements::begin(field(i)), Elements::begin(field(i)) + ne, &buf[i*ne]);
+    this->writeArray(&buf.front(), Elements::type(), n*ne, pathName + "/values");
+  }
+}
+
+//------------------------------------------------------------------------------
+// Read a Field.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename Value>
+void
+ParallelHDF5FileIO::readField(Field<Dimension, Value>& field,
+                              const string pathName) const {
+  typedef FieldElements<Value> Elements;
+  typedef typename Elements::ElementType ElementType;
+  const hsize_t n = field.numInternalElements();
+  const hsize_t ne = Elements::numElements();
+  string fieldname;
+  this->read(fieldname, pathName + "/name");
+  field.name(fieldname);
+  if (n == 0) {
+    this->readArray(0, Elements::type(), 0u, pathName + "/values");
+  } else if (Elements::contiguous(field(0))) {
+    this->readArray(Elements::begin(field(0)), Elements::type(), n*ne, pathName + "/values");
+  } else {
+    vector<ElementType> buf(n*ne);
+    this->readArray(&buf.front(), Elements::type(), n*ne, pathName + "/values");
+    for (auto i = 0u; i < n; ++i) std::copy(&buf[i*ne], &buf[i*ne] + ne, Elements::begin(field(i)));
+  }
+}
+
+//------------------------------------------------------------------------------
+// Write/read the elements of a Vector, Tensor, etc.
+//------------------------------------------------------------------------------
+template<typename Value>
+void
+ParallelHDF5FileIO::writeElements(const Value& value, const string pathName) {
+  const vector<double> buf(value.begin(), value.end());
+  this->writeValues(buf.data(), buf.size(), pathName);
+}
+
+template<typename Value>
+void
+ParallelHDF5FileIO::readElements(Value& value, const string pathName) const {
+  vector<double> buf(Value::numElements);
+  this->readValues(buf.data(), buf.size(), pathName);
+  std::copy(buf.begin(), buf.end(), value.begin());
+}
+
+//------------------------------------------------------------------------------
+// Write an unsigned to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const unsigned& value, const string pathName) {
+  this->writeValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write an int to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const int& value, const string pathName) {
+  this->writeValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a bool to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const bool& value, const string pathName) {
+  const int ivalue = value ? 1 : 0;
+  this->writeValues(&ivalue, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a double to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const double& value, const string pathName) {
+  this->writeValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a string to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const string& value, const string pathName) {
+  this->writeValues(value.data(), value.size(), pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<int> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const std::vector<int>& value, const string pathName) {
+  this->writeValues(value.data(), value.size(), pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<double> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const std::vector<double>& value, const string pathName) {
+  this->writeValues(value.data(), value.size(), pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a vector<string> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const std::vector<string>& value, const string pathName) {
+  const unsigned n = value.size();
+  vector<int> dim_stuff(n);
+  string stuff;
+  for (unsigned i = 0; i != n; ++i) {
+    dim_stuff[i] = value[i].size();
+    stuff += value[i];
+  }
+  this->write(dim_stuff, pathName + "/dim_stuff");
+  this->write(stuff, pathName + "/stuff");
+}
+
+//------------------------------------------------------------------------------
+// Read an unsigned from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(unsigned& value, const string pathName) const {
+  this->readValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read an int from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(int& value, const string pathName) const {
+  this->readValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a bool from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(bool& value, const string pathName) const {
+  int ivalue;
+  this->readValues(&ivalue, 1u, pathName);
+  value = (ivalue == 1);
+}
+
+//------------------------------------------------------------------------------
+// Read a double from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(double& value, const string pathName) const {
+  this->readValues(&value, 1u, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a string from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(string& value, const string pathName) const {
+  const auto& buf = this->bufferedValue(pathName);
+  value = string(buf.begin(), buf.end());
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<int> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(std::vector<int>& value, const string pathName) const {
+  this->readValues(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<double> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(std::vector<double>& value, const string pathName) const {
+  this->readValues(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a vector<string> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(std::vector<string>& value, const string pathName) const {
+  vector<int> dim_stuff;
+  string stuff;
+  this->read(dim_stuff, pathName + "/dim_stuff");
+  this->read(stuff, pathName + "/stuff");
+  const unsigned n = dim_stuff.size();
+  value.resize(n);
+  auto pos = 0u;
+  for (unsigned i = 0; i != n; ++i) {
+    CHECK(pos + dim_stuff[i] <= stuff.size());
+    value[i] = stuff.substr(pos, dim_stuff[i]);
+    pos += dim_stuff[i];
+  }
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<1>::Vector& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<1>::Tensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<1>::SymTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<1>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<1>::ThirdRankTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<2>::Vector& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<2>::Tensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<2>::SymTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<2>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<2>::ThirdRankTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::Vector to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<3>::Vector& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::Tensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<3>::Tensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::SymTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<3>::SymTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Dim<3>::ThirdRankTensor to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Dim<3>::ThirdRankTensor& value, const string pathName) {
+  this->writeElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<1>::Vector& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<1>::Tensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<1>::SymTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<1>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<1>::ThirdRankTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<2>::Vector& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<2>::Tensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<2>::SymTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<2>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<2>::ThirdRankTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::Vector from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<3>::Vector& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::Tensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<3>::Tensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::SymTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<3>::SymTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Dim<3>::ThirdRankTensor from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Dim<3>::ThirdRankTensor& value, const string pathName) const {
+  this->readElements(value, pathName);
+}
+
+#ifdef SPHERAL1D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, Dim<1>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, Dim<1>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, Dim<1>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, Dim<1>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, Dim<1>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, Dim<1>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<1>, int> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<1>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, Dim<1>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, Dim<1>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, Dim<1>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, Dim<1>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, Dim<1>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, Dim<1>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<1>, int> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<1>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+#ifdef SPHERAL2D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, Dim<2>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, Dim<2>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, Dim<2>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, Dim<2>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, Dim<2>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, Dim<2>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<2>, int> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<2>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, Dim<2>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, Dim<2>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, Dim<2>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, Dim<2>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, Dim<2>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, Dim<2>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<2>, int> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<2>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+#ifdef SPHERAL3D
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Scalar> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, Dim<3>::Scalar>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Vector> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, Dim<3>::Vector>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::Tensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, Dim<3>::Tensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::SymTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, Dim<3>::SymTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, Dim<3>::ThirdRankTensor> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, Dim<3>::ThirdRankTensor>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Write a Field<Dim<3>, int> to the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::write(const Field<Dim<3>, int>& value, const string pathName) {
+  this->writeField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Scalar> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, Dim<3>::Scalar>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Vector> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, Dim<3>::Vector>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::Tensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, Dim<3>::Tensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::SymTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, Dim<3>::SymTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, Dim<3>::ThirdRankTensor> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, Dim<3>::ThirdRankTensor>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+
+//------------------------------------------------------------------------------
+// Read a Field<Dim<3>, int> from the file.
+//------------------------------------------------------------------------------
+void
+ParallelHDF5FileIO::read(Field<Dim<3>, int>& value, const string pathName) const {
+  this->readField(value, pathName);
+}
+#endif
+
+}
@@ -0,0 +1,231 @@
+//---------------------------------Spheral++----------------------------------//
+// ParallelHDF5FileIO -- Provide the interface to a single HDF5 file shared by
+// all processes.
+//
+// Rather than one file per process every process writes into the same file.
+// Each Field is stored as the concatenation of the values from all processes
+// in rank order:  the group pathName holds the dataset "data" and the dataset
+// "offsets" (numProcs + 1 entries) delimiting the slice (hyperslab) owned by
+// each rank.  When HDF5 is built with parallel support the slices are written
+// with collective MPI-IO, and Fields are written straight from their storage
+// without staging copies.  The data may optionally be compressed in chunks.
+//
+// Everything else (scalars, strings, std::vectors, Vectors, Tensors, ...) is
+// small, and making a collective dataset for each would dominate the cost of
+// a restart dump.  Those values are instead buffered in memory as raw bytes,
+// and written in one batch when the file is closed:  a table of their paths,
+// and the sizes and bytes of each process's values.  Reading loads the batch
+// when the file is opened.
+//
+// Since creating datasets is collective, every process must make the same
+// sequence of Field writes, and write values at the same set of paths, as is
+// the case for restart dumps.  A file can only be read back with the same
+// number of processes that wrote it (each process reads back its own slice);
+// this is checked when the file is opened.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_ParallelHDF5FileIO__
+#define __Spheral_ParallelHDF5FileIO__
+
+#include "FileIO.hh"
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "hdf5.h"
+
+namespace Spheral {
+
+class ParallelHDF5FileIO: public FileIO {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  // Constructors.
+  ParallelHDF5FileIO();
+  ParallelHDF5FileIO(const std::string fileName, AccessType access);
+  ParallelHDF5FileIO(const std::string fileName, AccessType access, const int compressionLevel);
+
+  // Destructor.
+  virtual ~ParallelHDF5FileIO();
+
+  // All File objects must provide methods to open and close the files.
+  virtual void open(const std::string fileName, AccessType access) override;
+  virtual void close() override;
+
+  // The deflate compression level (0-9) applied to datasets we write.  0
+  // (the default) writes contiguous uncompressed datasets.
+  int compressionLevel() const;
+  void compressionLevel(const int x);
+
+  //******************************************************************************
+  // Methods all FileIO descendent classes must provide.
+  //******************************************************************************
+  // Check if the specified path is in the file.
+  virtual bool pathExists(const std::string pathName) const override;
+
+  // All FileIO objects had better be able to read and write the primitive 
+  // DataTypes.
+  virtual void write(const unsigned& value, const std::string pathName) override;
+  virtual void write(const int& value, const std::string pathName) override;
+  virtual void write(const bool& value, const std::string pathName) override;
+  virtual void write(const double& value, const std::string pathName) override;
+  virtual void write(const std::string& value, const std::string pathName) override;
+  virtual void write(const std::vector<int>& value, const std::string pathName) override;
+  virtual void write(const std::vector<double>& value, const std::string pathName) override;
+  virtual void write(const std::vector<std::string>& value, const std::string pathName) override;
+
+  virtual void write(const Dim<1>::Vector& value, const std::string pathName) override;
+  virtual void write(const Dim<1>::Tensor& value, const std::string pathName) override;
+  virtual void write(const Dim<1>::SymTensor& value, const std::string pathName) override;
+  virtual void write(const Dim<1>::ThirdRankTensor& value, const std::string pathName) override;
+
+  virtual void write(const Dim<2>::Vector& value, const std::string pathName) override;
+  virtual void write(const Dim<2>::Tensor& value, const std::string pathName) override;
+  virtual void write(const Dim<2>::SymTensor& value, const std::string pathName) override;
+  virtual void write(const Dim<2>::ThirdRankTensor& value, const std::string pathName) override;
+
+  virtual void write(const Dim<3>::Vector& value, const std::string pathName) override;
+  virtual void write(const Dim<3>::Tensor& value, const std::string pathName) override;
+  virtual void write(const Dim<3>::SymTensor& value, const std::string pathName) override;
+  virtual void write(const Dim<3>::ThirdRankTensor& value, const std::string pathName) override;
+
+  virtual void read(unsigned& value, const std::string pathName) const override;
+  virtual void read(int& value, const std::string pathName) const override;
+  virtual void read(bool& value, const std::string pathName) const override;
+  virtual void read(double& value, const std::string pathName) const override;
+  virtual void read(std::string& value, const std::string pathName) const override;
+  virtual void read(std::vector<int>& value, const std::string pathName) const override;
+  virtual void read(std::vector<double>& value, const std::string pathName) const override;
+  virtual void read(std::vector<std::string>& value, const std::string pathName) const override;
+
+  virtual void read(Dim<1>::Vector& value, const std::string pathName) const override;
+  virtual void read(Dim<1>::Tensor& value, const std::string pathName) const override;
+  virtual void read(Dim<1>::SymTensor& value, const std::string pathName) const override;
+  virtual void read(Dim<1>::ThirdRankTensor& value, const std::string pathName) const override;
+
+  virtual void read(Dim<2>::Vector& value, const std::string pathName) const override;
+  virtual void read(Dim<2>::Tensor& value, const std::string pathName) const override;
+  virtual void read(Dim<2>::SymTensor& value, const std::string pathName) const override;
+  virtual void read(Dim<2>::ThirdRankTensor& value, const std::string pathName) const override;
+
+  virtual void read(Dim<3>::Vector& value, const std::string pathName) const override;
+  virtual void read(Dim<3>::Tensor& value, const std::string pathName) const override;
+  virtual void read(Dim<3>::SymTensor& value, const std::string pathName) const override;
+  virtual void read(Dim<3>::ThirdRankTensor& value, const std::string pathName) const override;
+
+  // Require that all FileIO objects provide methods to read and write
+  // Fields of specific DataTypes.
+#ifdef SPHERAL1D
+  virtual void write(const Field<Dim<1>, Dim<1>::Scalar>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<1>, Dim<1>::Vector>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<1>, Dim<1>::Tensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<1>, Dim<1>::SymTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<1>, Dim<1>::ThirdRankTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<1>, int>& field, const std::string pathName) override;
+
+  virtual void read(Field<Dim<1>, Dim<1>::Scalar>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<1>, Dim<1>::Vector>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<1>, Dim<1>::Tensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<1>, Dim<1>::SymTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<1>, Dim<1>::ThirdRankTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<1>, int>& field, const std::string pathName) const override;
+#endif
+
+#ifdef SPHERAL2D
+  virtual void write(const Field<Dim<2>, Dim<2>::Scalar>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<2>, Dim<2>::Vector>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<2>, Dim<2>::Tensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<2>, Dim<2>::SymTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<2>, Dim<2>::ThirdRankTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<2>, int>& field, const std::string pathName) override;
+
+  virtual void read(Field<Dim<2>, Dim<2>::Scalar>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<2>, Dim<2>::Vector>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<2>, Dim<2>::Tensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<2>, Dim<2>::SymTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<2>, Dim<2>::ThirdRankTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<2>, int>& field, const std::string pathName) const override;
+#endif
+
+#ifdef SPHERAL3D
+  virtual void write(const Field<Dim<3>, Dim<3>::Scalar>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<3>, Dim<3>::Vector>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<3>, Dim<3>::Tensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<3>, Dim<3>::SymTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<3>, Dim<3>::ThirdRankTensor>& field, const std::string pathName) override;
+  virtual void write(const Field<Dim<3>, int>& field, const std::string pathName) override;
+
+  virtual void read(Field<Dim<3>, Dim<3>::Scalar>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<3>, Dim<3>::Vector>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<3>, Dim<3>::Tensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<3>, Dim<3>::SymTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<3>, Dim<3>::ThirdRankTensor>& field, const std::string pathName) const override;
+  virtual void read(Field<Dim<3>, int>& field, const std::string pathName) const override;
+#endif
+  //******************************************************************************
+
+  //------------------------------------------------------------------------------
+  // We have to forward the templated write/read methods to the base class due to
+  // function hiding.
+  // Write/read a vector<Value> if Value is a primitive we already know about.
+  template<typename Value> void write(const std::vector<Value>& x, const std::string pathName) { FileIO::write(x, pathName); }
+  template<typename Value> void  read(std::vector<Value>& x, const std::string pathName) const { FileIO::read(x, pathName); }
+  //------------------------------------------------------------------------------
+
+  // Forward hidden base class methods
+  using FileIO::write;
+  using FileIO::read;
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  // The HDF5 file and dataset transfer property list.
+  hid_t mFileID, mTransferProps;
+  int mCompressionLevel;
+
+  // The buffered (non-Field) values for this process, as raw bytes.
+  std::map<std::string, std::vector<char>> mValues;
+
+  // Write this process's n values (of HDF5 type) into its slice of the ragged
+  // dataset pathName.  Collective.
+  void writeArray(const void* data, const hid_t type, const hsize_t n, const std::string pathName);
+
+  // The size of this process's (or sourceRank's) slice of the ragged dataset
+  // pathName, and read that slice into data.
+  hsize_t localSize(const std::string pathName) const;
+  hsize_t localSize(const std::string pathName, const unsigned sourceRank) const;
+  void readArray(void* data, const hid_t type, const hsize_t n, const std::string pathName) const;
+  void readArray(void* data, const hid_t type, const hsize_t n, const std::string pathName, const unsigned sourceRank) const;
+
+  // Buffer and look up the non-Field values.
+  template<typename Value> void writeValues(const Value* data, const size_t n, const std::string pathName);
+  template<typename Value> void readValues(Value* data, const size_t n, const std::string pathName) const;
+  template<typename Value> void readValues(std::vector<Value>& values, const std::string pathName) const;
+  const std::vector<char>& bufferedValue(const std::string pathName) const;
+
+  // Write/load all the buffered values.  Collective.
+  void writeBufferedValues();
+  void readBufferedValues();
+
+  // Common methods for Fields.
+  template<typename Dimension, typename Value> void writeField(const Field<Dimension, Value>& field, const std::string pathName);
+  template<typename Dimension, typename Value> void readField(Field<Dimension, Value>& field, const std::string pathName) const;
+
+  // Common methods for the geometric types.
+  template<typename Value> void writeElements(const Value& value, const std::string pathName);
+  template<typename Value> void readElements(Value& value, const std::string pathName) const;
+
+  // Don't allow assignment.
+  ParallelHDF5FileIO& operator=(const ParallelHDF5FileIO& rhs);
+};
+
+}
+
+#include "ParallelHDF5FileIOInline.hh"
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  class ParallelHDF5FileIO;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#include "Utilities/DBC.hh"
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// The compression level.
+//------------------------------------------------------------------------------
+inline
+int
+ParallelHDF5FileIO::
+compressionLevel() const {
+  return mCompressionLevel;
+}
+
+inline
+void
+ParallelHDF5FileIO::
+compressionLevel(const int x) {
+  VERIFY2(x >= 0 and x <= 9, "ParallelHDF5FileIO ERROR: compression level must be in [0, 9] : " << x);
+  mCompressionLevel = x;
+}
+
+}
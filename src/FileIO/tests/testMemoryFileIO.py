@@ -0,0 +1,123 @@
+#ATS:test(SELF, label="MemoryFileIO unit tests")
+from Spheral import *
+from FileIOTestBase import *
+
+import os
+import unittest
+
+#-------------------------------------------------------------------------------
+# MemoryFileIO tests.
+#-------------------------------------------------------------------------------
+class MemoryFileIOTest(FileIOTestBase, unittest.TestCase):
+
+    def setUp(self):
+        self.n = 10 # 1000
+        self.intmin = -2**24
+        self.intmax = 2**24
+        self.doublemin = -1e50
+        self.doublemax = 1e50
+        self.constructor = MemoryFileIO
+
+        # Size the NodeLists.
+        nodes1d.numInternalNodes = self.n
+        nodes2d.numInternalNodes = self.n
+        nodes3d.numInternalNodes = self.n
+
+        return
+
+    def tearDown(self):
+        return
+
+    def removeFile(self, filename):
+        os.remove(filename + ".restart")
+
+    #---------------------------------------------------------------------------
+    # The base tests write one value per file.  MemoryFileIO keeps every
+    # record in memory until it is closed, so also write a mix of types to a
+    # single file and read them all back.
+    #---------------------------------------------------------------------------
+    def testManyRecords(self):
+        xint = g.randint(self.intmin, self.intmax)
+        xbool = g.choice([True, False])
+        xdouble = g.uniform(self.doublemin, self.doublemax)
+        xstring = "abcdefg"
+        xvec = Vector3d(g.uniform(self.doublemin, self.doublemax),
+                        g.uniform(self.doublemin, self.doublemax),
+                        g.uniform(self.doublemin, self.doublemax))
+        xy = g.uniform(self.doublemin, self.doublemax)
+        xsymtensor = SymTensor2d(g.uniform(self.doublemin, self.doublemax), xy,
+                                 xy, g.uniform(self.doublemin, self.doublemax))
+        xvecdouble = vector_of_double([g.uniform(self.doublemin, self.doublemax) for i in xrange(self.n)])
+        xobject = [49, 492, "ackthpt", 3.5]
+        xintfield = IntField1d("int field 1d control", nodes1d)
+        xvecfield = VectorField2d("vector field 2d control", nodes2d)
+        for i in xrange(self.n):
+            xintfield[i] = g.randint(self.intmin, self.intmax)
+            xvecfield[i] = Vector2d(g.uniform(self.doublemin, self.doublemax),
+                                    g.uniform(self.doublemin, self.doublemax))
+        xfl = SymTensorFieldList3d()
+        xfl.copyFields()
+        xfl.appendNewField("symtensor field 3d control", nodes3d, SymTensor3d())
+        for i in xrange(self.n):
+            xx, xy, xz, yy, yz, zz = [g.uniform(self.doublemin, self.doublemax) for k in xrange(6)]
+            xfl[0][i] = SymTensor3d(xx, xy, xz,
+                                    xy, yy, yz,
+                                    xz, yz, zz)
+
+        f = self.constructor("TestManyRecords", Write)
+        f.write_int(xint, "FileIOTestBase/scalars/int")
+        f.write_bool(xbool, "FileIOTestBase/scalars/bool")
+        f.write_double(xdouble, "FileIOTestBase/scalars/double")
+        f.write_string(xstring, "FileIOTestBase/scalars/string")
+        f.write(xvec, "FileIOTestBase/geometry/Vector3d")
+        f.write(xsymtensor, "FileIOTestBase/geometry/SymTensor2d")
+        f.write(xvecdouble, "FileIOTestBase/vector_of_double")
+        f.writeObject(xobject, "FileIOTestBase/object")
+        f.write(xintfield, "FileIOTestBase/fields/IntField1d")
+        f.write(xvecfield, "FileIOTestBase/fields/VectorField2d")
+        f.write(xfl, "FileIOTestBase/fields/SymTensorFieldList3d")
+        f.close()
+
+        f = self.constructor("TestManyRecords", Read)
+        for path in ("FileIOTestBase", "FileIOTestBase/scalars", "FileIOTestBase/fields",
+                     "FileIOTestBase/scalars/int", "FileIOTestBase/fields/VectorField2d"):
+            self.failUnless(f.pathExists(path), "Missing path %s in many records test" % path)
+        self.failIf(f.pathExists("FileIOTestBase/scal"), "Found partial path in many records test")
+        self.failUnless(f.read_int("FileIOTestBase/scalars/int") == xint, "int mismatch in many records test")
+        self.failUnless(f.read_bool("FileIOTestBase/scalars/bool") == xbool, "bool mismatch in many records test")
+        self.failUnless(f.read_double("FileIOTestBase/scalars/double") == xdouble, "double mismatch in many records test")
+        self.failUnless(f.read_string("FileIOTestBase/scalars/string") == xstring, "string mismatch in many records test")
+        vec = Vector3d()
+        f.read(vec, "FileIOTestBase/geometry/Vector3d")
+        self.failUnless(vec == xvec, "%s != %s in many records test" % (vec, xvec))
+        symtensor = SymTensor2d()
+        f.read(symtensor, "FileIOTestBase/geometry/SymTensor2d")
+        self.failUnless(symtensor == xsymtensor, "%s != %s in many records test" % (symtensor, xsymtensor))
+        vecdouble = vector_of_double()
+        f.read(vecdouble, "FileIOTestBase/vector_of_double")
+        self.failUnless(list(vecdouble) == list(xvecdouble), "vector<double> mismatch in many records test")
+        self.failUnless(f.readObject("FileIOTestBase/object") == xobject, "object mismatch in many records test")
+        intfield = IntField1d("int field 1d test", nodes1d)
+        f.read(intfield, "FileIOTestBase/fields/IntField1d")
+        vecfield = VectorField2d("vector field 2d test", nodes2d)
+        f.read(vecfield, "FileIOTestBase/fields/VectorField2d")
+        fl = SymTensorFieldList3d()
+        fl.copyFields()
+        f.read(fl, "FileIOTestBase/fields/SymTensorFieldList3d")
+        f.close()
+        assert len(fl) == len(xfl)
+        for i in xrange(self.n):
+            self.failUnless(intfield[i] == xintfield[i],
+                            "%i != %i @ %i in many records IntField1d test" % (intfield[i], xintfield[i], i))
+            self.failUnless(vecfield[i] == xvecfield[i],
+                            "%s != %s @ %i in many records VectorField2d test" % (vecfield[i], xvecfield[i], i))
+            self.failUnless(fl[0][i] == xfl[0][i],
+                            "%s != %s @ %i in many records SymTensorFieldList3d test" % (fl[0][i], xfl[0][i], i))
+        self.removeFile("TestManyRecords")
+        return
+
+#-------------------------------------------------------------------------------
+# Run those tests.
+#-------------------------------------------------------------------------------
+if __name__ == "__main__":
+    unittest.main()
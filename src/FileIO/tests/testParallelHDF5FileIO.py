@@ -0,0 +1,44 @@
+#ATS:test(SELF, np=1, label="ParallelHDF5FileIO unit tests (serial)")
+#ATS:test(SELF, np=4, label="ParallelHDF5FileIO unit tests (4 proc)")
+from Spheral import *
+from FileIOTestBase import *
+
+import os
+import unittest
+import mpi
+
+#-------------------------------------------------------------------------------
+# ParallelHDF5FileIO tests.  In parallel every process writes (and must read
+# back) its own values to the shared file.
+#-------------------------------------------------------------------------------
+class ParallelHDF5FileIOTest(FileIOTestBase, unittest.TestCase):
+
+    def setUp(self):
+        self.n = 10 # 1000
+        self.intmin = -2**24
+        self.intmax = 2**24
+        self.doublemin = -1e50
+        self.doublemax = 1e50
+        self.constructor = ParallelHDF5FileIO
+
+        # Size the NodeLists.
+        nodes1d.numInternalNodes = self.n
+        nodes2d.numInternalNodes = self.n
+        nodes3d.numInternalNodes = self.n
+
+        return
+
+    def tearDown(self):
+        return
+
+    def removeFile(self, filename):
+        mpi.barrier()
+        if mpi.rank == 0:
+            os.remove(filename + ".h5")
+        mpi.barrier()
+
+#-------------------------------------------------------------------------------
+# Run those tests.
+#-------------------------------------------------------------------------------
+if __name__ == "__main__":
+    unittest.main()
@@ -170,6 +170,65 @@ void collapseDegenerates(Polyhedron& poly,
 
 std::vector<std::vector<int>> splitIntoTetrahedra(const Polyhedron& poly, 
                                                   const double tol = 0.0);
+
+//------------------------------------------------------------------------------
+// 3D arena polyhedron.
+//
+// The same polyhedron description as Polyhedron, but the vertex neighbors and
+// clip IDs are stored as slices of flat pools owned by the polyhedron rather
+// than per vertex containers.  Once the pools have grown to the working size
+// copying and clipping these polyhedra does no further allocation, which is
+// what we want for clipping a cell per node (i.e., Voronoi volumes).
+//------------------------------------------------------------------------------
+struct ArenaVertex3d {
+  typedef Spheral::Dim<3>::Vector Vector;
+  Vector position;
+  int neighborOffset, numNeighbors, neighborCapacity;     // slice of ArenaPolyhedron::neighbors
+  int clipOffset, numClips, clipCapacity;                 // slice of ArenaPolyhedron::clips (sorted)
+  int comp;
+  int ID;
+  ArenaVertex3d():                       position(),    neighborOffset(0), numNeighbors(0), neighborCapacity(0), clipOffset(0), numClips(0), clipCapacity(0), comp(1), ID(-1) {}
+  ArenaVertex3d(const Vector& pos, const int c): position(pos), neighborOffset(0), numNeighbors(0), neighborCapacity(0), clipOffset(0), numClips(0), clipCapacity(0), comp(c), ID(-1) {}
+};
+
+struct ArenaPolyhedron {
+  typedef std::vector<ArenaVertex3d>::iterator iterator;
+  typedef std::vector<ArenaVertex3d>::const_iterator const_iterator;
+  std::vector<ArenaVertex3d> vertices;
+  std::vector<int> neighbors;
+  std::vector<int> clips;
+  size_t size() const                    { return vertices.size(); }
+  bool empty() const                     { return vertices.empty(); }
+  void clear()                           { vertices.clear(); neighbors.clear(); clips.clear(); }
+  iterator begin()                       { return vertices.begin(); }
+  iterator end()                         { return vertices.end(); }
+  const_iterator begin() const           { return vertices.begin(); }
+  const_iterator end() const             { return vertices.end(); }
+  const ArenaVertex3d& operator[](const size_t i) const { return vertices[i]; }
+  ArenaVertex3d& operator[](const size_t i)             { return vertices[i]; }
+};
+
+void convertToArenaPolyhedron(ArenaPolyhedron& result,
+                              const Polyhedron& polyhedron);
+
+void convertFromArenaPolyhedron(Polyhedron& result,
+                                const ArenaPolyhedron& polyhedron);
+
+void moments(double& zerothMoment, Spheral::Dim<3>::Vector& firstMoment,
+             const ArenaPolyhedron& polyhedron);
+
+void clipPolyhedron(ArenaPolyhedron& poly,
+                    const std::vector<Plane3d>& planes);
+
+void collapseDegenerates(ArenaPolyhedron& poly,
+                         const double tol);
+
+std::vector<std::vector<int>> extractFaces(const ArenaPolyhedron& poly);
+
+std::string polyhedron2string(const ArenaPolyhedron& poly);
+
+std::vector<std::set<int>> convertFromPolyhedron(Spheral::Dim<3>::FacetedVolume& Spheral_polyhedron,
+                                                 const ArenaPolyhedron& polyhedron);
 }
 
 #endif
@@ -322,15 +322,19 @@ void clipPolygon(Polygon& polygon,
 
   // cerr << "Initial polygon: " << polygon2string(polygon) << endl;
 
-  // Find the bounding box of the polygon.
+  // Find the bounding box and bounding radius of the polygon.
   auto xmin = std::numeric_limits<double>::max(), xmax = std::numeric_limits<double>::lowest();
   auto ymin = std::numeric_limits<double>::max(), ymax = std::numeric_limits<double>::lowest();
+  auto rmax2 = 0.0;
   for (auto& v: polygon) {
     xmin = std::min(xmin, v.position[0]);
     xmax = std::max(xmax, v.position[0]);
     ymin = std::min(ymin, v.position[1]);
     ymax = std::max(ymax, v.position[1]);
+    rmax2 = std::max(rmax2, v.position.magnitude2());
   }
+  auto rmax = std::sqrt(rmax2);
+  const auto sorted = std::is_sorted(planes.begin(), planes.end());
 
   // Loop over the planes.
   TIME_PC2d_planes.start();
@@ -340,7 +344,15 @@ void clipPolygon(Polygon& polygon,
     const auto& plane = planes[kplane++];
     // cerr << "Clip plane: " << plane.dist << " " << plane.normal << endl;
 
-    // First check against the bounding box.
+    // Planes beyond the bounding radius (measured from the origin, i.e., the
+    // generator for Voronoi cells) leave the polygon untouched.  If the planes
+    // are sorted by distance, so do all the rest.
+    if (plane.dist > rmax*(1.0 + 1.0e-10)) {
+      if (sorted) break;
+      continue;
+    }
+
+    // Check against the bounding box.
     auto boxcomp = compare(plane, xmin, ymin, xmax, ymax);
     auto above = boxcomp ==  1;
     auto below = boxcomp == -1;
@@ -472,6 +484,7 @@ void clipPolygon(Polygon& polygon,
       // First, number the active vertices sequentially.
       xmin = std::numeric_limits<double>::max(), xmax = std::numeric_limits<double>::lowest();
       ymin = std::numeric_limits<double>::max(), ymax = std::numeric_limits<double>::lowest();
+      rmax2 = 0.0;
       auto i = 0;
       auto nkill = 0;
       for (auto& v: polygon) {
@@ -483,8 +496,10 @@ void clipPolygon(Polygon& polygon,
           xmax = std::max(xmax, v.position[0]);
           ymin = std::min(ymin, v.position[1]);
           ymax = std::max(ymax, v.position[1]);
+          rmax2 = std::max(rmax2, v.position.magnitude2());
         }
       }
+      rmax = std::sqrt(rmax2);
 
       // Find the vertices to remove, and renumber the neighbors.
       if (nkill > 0) {
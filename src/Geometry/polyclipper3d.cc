@@ -865,4 +865,770 @@ vector<vector<int>> splitIntoTetrahedra(const Polyhedron& poly,
   VERIFY2(false, "PolyClipper::splitIntoTetrahedra ERROR: non-convex polyhedra not supported yet:\n" + polyhedron2string(poly));
 }
 
+
+namespace {    // anonymous arena methods
+
+//------------------------------------------------------------------------------
+// Scratch pools for compressing arena polyhedra, kept per thread so clipping
+// doesn't allocate once they've grown to the working size.
+//------------------------------------------------------------------------------
+thread_local vector<int> arenaNeighborScratch, arenaClipScratch, arenaLoopScratch;
+thread_local vector<char> arenaEdgeWalked;
+
+//------------------------------------------------------------------------------
+// Add a vertex to an arena polyhedron, reserving the given capacity for its
+// neighbors and clips at the end of the pools.
+//------------------------------------------------------------------------------
+inline
+int
+addArenaVertex(ArenaPolyhedron& poly,
+               const Spheral::Dim<3>::Vector& position,
+               const int comp,
+               const int neighborCapacity,
+               const int clipCapacity) {
+  const int result = poly.vertices.size();
+  poly.vertices.push_back(ArenaVertex3d(position, comp));
+  auto& v = poly.vertices.back();
+  v.neighborOffset = poly.neighbors.size();
+  v.neighborCapacity = neighborCapacity;
+  poly.neighbors.resize(poly.neighbors.size() + neighborCapacity);
+  v.clipOffset = poly.clips.size();
+  v.clipCapacity = clipCapacity;
+  poly.clips.resize(poly.clips.size() + clipCapacity);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Make room for at least one more entry in a vertex slice of a pool, moving
+// the slice to the end of the pool if it's full.
+//------------------------------------------------------------------------------
+inline
+void
+growArenaSlice(vector<int>& pool, int& offset, const int size, int& capacity) {
+  if (size == capacity) {
+    const int newOffset = pool.size();
+    capacity = std::max(4, 2*capacity);
+    pool.resize(newOffset + capacity);
+    std::copy(pool.begin() + offset, pool.begin() + offset + size, pool.begin() + newOffset);
+    offset = newOffset;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Replace the contents of a vertex slice of a pool, moving the slice to the
+// end of the pool if it's too small.  The values must not live in the pool.
+//------------------------------------------------------------------------------
+inline
+void
+assignArenaSlice(vector<int>& pool, int& offset, int& size, int& capacity, const vector<int>& vals) {
+  const int n = vals.size();
+  if (n > capacity) {
+    offset = pool.size();
+    capacity = std::max(n, 2*capacity);
+    pool.resize(offset + capacity);
+  }
+  std::copy(vals.begin(), vals.end(), pool.begin() + offset);
+  size = n;
+}
+
+//------------------------------------------------------------------------------
+// Remove adjacent repeats from a neighbor loop, including the wrap around
+// from the last to the first neighbor.
+//------------------------------------------------------------------------------
+inline
+void
+removeAdjacentRepeats(vector<int>& vals) {
+  if (vals.empty()) return;
+  for (auto kitr = vals.begin(); kitr < vals.end() - 1; ++kitr) {
+    if (*kitr == *(kitr + 1)) kitr = vals.erase(kitr);
+  }
+  if (vals.front() == vals.back()) vals.pop_back();
+}
+
+//------------------------------------------------------------------------------
+// Insert a neighbor at the front of a vertex's (CCW ordered) neighbor list.
+//------------------------------------------------------------------------------
+inline
+void
+insertArenaNeighborFront(ArenaPolyhedron& poly, const int i, const int val) {
+  auto& v = poly.vertices[i];
+  growArenaSlice(poly.neighbors, v.neighborOffset, v.numNeighbors, v.neighborCapacity);
+  auto* nbegin = &poly.neighbors[v.neighborOffset];
+  std::copy_backward(nbegin, nbegin + v.numNeighbors, nbegin + v.numNeighbors + 1);
+  nbegin[0] = val;
+  ++v.numNeighbors;
+}
+
+//------------------------------------------------------------------------------
+// Insert a plane ID into a vertex's (sorted, unique) clips.
+//------------------------------------------------------------------------------
+inline
+void
+insertArenaClip(ArenaPolyhedron& poly, const int i, const int val) {
+  auto& v = poly.vertices[i];
+  auto* cbegin = &poly.clips[v.clipOffset];
+  auto* itr = std::lower_bound(cbegin, cbegin + v.numClips, val);
+  if (itr != cbegin + v.numClips and *itr == val) return;
+  const auto k = itr - cbegin;
+  growArenaSlice(poly.clips, v.clipOffset, v.numClips, v.clipCapacity);
+  cbegin = &poly.clips[v.clipOffset];
+  std::copy_backward(cbegin + k, cbegin + v.numClips, cbegin + v.numClips + 1);
+  cbegin[k] = val;
+  ++v.numClips;
+}
+
+//------------------------------------------------------------------------------
+// Find the next neighbor in CCW order in the neighbor set of a vertex.
+// This should be the previous vertex from our entry value.
+//------------------------------------------------------------------------------
+inline
+int
+nextInFaceLoop(const ArenaPolyhedron& poly, const int i, const int vprev) {
+  const auto& v = poly.vertices[i];
+  const auto* nbegin = &poly.neighbors[v.neighborOffset];
+  const auto* itr = std::find(nbegin, nbegin + v.numNeighbors, vprev);
+  CHECK(itr != nbegin + v.numNeighbors);
+  return (itr == nbegin ? nbegin[v.numNeighbors - 1] : *(itr - 1));
+}
+
+}              // anonymous arena methods
+
+//------------------------------------------------------------------------------
+// Convert PolyClipper::Polyhedron -> PolyClipper::ArenaPolyhedron.
+//------------------------------------------------------------------------------
+void convertToArenaPolyhedron(ArenaPolyhedron& result,
+                              const Polyhedron& polyhedron) {
+  result.clear();
+  for (const auto& v: polyhedron) {
+    const int nneigh = v.neighbors.size();
+    const int nclips = v.clips.size();
+    const auto i = addArenaVertex(result, v.position, v.comp, nneigh, nclips);
+    auto& av = result.vertices[i];
+    av.ID = v.ID;
+    av.numNeighbors = nneigh;
+    av.numClips = nclips;
+    std::copy(v.neighbors.begin(), v.neighbors.end(), result.neighbors.begin() + av.neighborOffset);
+    std::copy(v.clips.begin(), v.clips.end(), result.clips.begin() + av.clipOffset);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Convert PolyClipper::ArenaPolyhedron -> PolyClipper::Polyhedron.
+//------------------------------------------------------------------------------
+void convertFromArenaPolyhedron(Polyhedron& result,
+                                const ArenaPolyhedron& polyhedron) {
+  const auto nverts = polyhedron.size();
+  result.resize(nverts);
+  for (auto i = 0u; i < nverts; ++i) {
+    const auto& av = polyhedron[i];
+    auto& v = result[i];
+    v.position = av.position;
+    v.comp = av.comp;
+    v.ID = av.ID;
+    v.neighbors.assign(polyhedron.neighbors.begin() + av.neighborOffset,
+                       polyhedron.neighbors.begin() + av.neighborOffset + av.numNeighbors);
+    v.clips = set<int>(polyhedron.clips.begin() + av.clipOffset,
+                       polyhedron.clips.begin() + av.clipOffset + av.numClips);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compute the zeroth and first moment of an ArenaPolyhedron.
+// We walk the faces as extractFaces does, but flag the directed edges walked
+// by their slot in the neighbor pool rather than building sets of edges.
+// The directed edge (vprev -> v) is identified by the slot of vprev in the
+// neighbors of v.
+//------------------------------------------------------------------------------
+void moments(double& zerothMoment, Spheral::Dim<3>::Vector& firstMoment,
+             const ArenaPolyhedron& polyhedron) {
+  TIME_PC3d_moments.start();
+
+  // Useful types.
+  typedef Spheral::Dim<3>::Vector Vector;
+
+  // Clear the result for accumulation.
+  zerothMoment = 0.0;
+  firstMoment = Vector::zero;
+
+  if (not polyhedron.empty()) {
+    auto& walked = arenaEdgeWalked;
+    walked.assign(polyhedron.neighbors.size(), 0);
+    const auto& neighbors = polyhedron.neighbors;
+    const int nverts = polyhedron.size();
+    double dV;
+    for (auto i = 0; i < nverts; ++i) {
+      const auto& v = polyhedron[i];
+      CHECK(v.comp >= 0);
+      for (auto j = 0; j < v.numNeighbors; ++j) {
+        if (walked[v.neighborOffset + j] == 0) {
+
+          // Follow around the face starting with the edge (ni -> i), fanning
+          // triangles out from ni.
+          const auto vstart = neighbors[v.neighborOffset + j];
+          const auto& v0 = polyhedron[vstart].position;
+          auto vprev = vstart;
+          auto vnext = i;
+          auto nfaceverts = 1;
+          const Vector* vlast = nullptr;
+          while (vnext != vstart) {
+            const auto& vn = polyhedron[vnext];
+            const auto* nbegin = &neighbors[vn.neighborOffset];
+            const auto* itr = std::find(nbegin, nbegin + vn.numNeighbors, vprev);
+            CHECK(itr != nbegin + vn.numNeighbors);
+            CHECK(walked[vn.neighborOffset + (itr - nbegin)] == 0);
+            walked[vn.neighborOffset + (itr - nbegin)] = 1;
+            if (vlast != nullptr) {
+              dV = v0.dot(vlast->cross(vn.position));
+              zerothMoment += dV;
+              firstMoment += dV*(v0 + *vlast + vn.position);
+            }
+            vlast = &vn.position;
+            ++nfaceverts;
+            vprev = vnext;
+            vnext = (itr == nbegin ? nbegin[vn.numNeighbors - 1] : *(itr - 1));
+          }
+
+          // Final edge connecting last->first vertex.
+          {
+            const auto& vn = polyhedron[vstart];
+            const auto* nbegin = &neighbors[vn.neighborOffset];
+            const auto* itr = std::find(nbegin, nbegin + vn.numNeighbors, vprev);
+            CHECK(itr != nbegin + vn.numNeighbors);
+            walked[vn.neighborOffset + (itr - nbegin)] = 1;
+          }
+          CHECK(nfaceverts >= 3);
+          CONTRACT_VAR(nfaceverts);
+        }
+      }
+    }
+    zerothMoment /= 6.0;
+    firstMoment *= Spheral::safeInv(24.0*zerothMoment);
+  }
+  TIME_PC3d_moments.stop();
+}
+
+//------------------------------------------------------------------------------
+// Clip an ArenaPolyhedron by planes.
+// This is the same algorithm as clipPolyhedron for Polyhedron, with the
+// addition that we track the maximum distance of the vertices from the origin
+// (the generator, for Voronoi cells).  Any plane farther from the origin than
+// that can't cut the polyhedron, and if the planes are sorted by distance
+// we're done as soon as we hit one.
+//------------------------------------------------------------------------------
+void clipPolyhedron(ArenaPolyhedron& polyhedron,
+                    const std::vector<Plane3d>& planes) {
+  TIME_PC3d_clip.start();
+
+  // Pre-declare variables.  Normally I prefer local declaration, but this
+  // seems to slightly help performance.
+  int nverts0, nverts, nneigh, i, j, k, jn, inew, iprev, inext, itmp, nclipsi, nclipsj;
+
+  // Find the bounding box and bounding radius of the polyhedron.
+  auto xmin = std::numeric_limits<double>::max(), xmax = std::numeric_limits<double>::lowest();
+  auto ymin = std::numeric_limits<double>::max(), ymax = std::numeric_limits<double>::lowest();
+  auto zmin = std::numeric_limits<double>::max(), zmax = std::numeric_limits<double>::lowest();
+  auto rmax2 = 0.0;
+  for (const auto& v: polyhedron) {
+    xmin = std::min(xmin, v.position[0]);
+    xmax = std::max(xmax, v.position[0]);
+    ymin = std::min(ymin, v.position[1]);
+    ymax = std::max(ymax, v.position[1]);
+    zmin = std::min(zmin, v.position[2]);
+    zmax = std::max(zmax, v.position[2]);
+    rmax2 = std::max(rmax2, v.position.magnitude2());
+  }
+  auto rmax = std::sqrt(rmax2);
+  const auto sorted = std::is_sorted(planes.begin(), planes.end());
+
+  // Loop over the planes.
+  TIME_PC3d_planes.start();
+  size_t kplane = 0;
+  const auto nplanes = planes.size();
+  while (kplane < nplanes and not polyhedron.empty()) {
+    const auto& plane = planes[kplane++];
+
+    // Planes beyond the bounding radius leave the polyhedron untouched.
+    if (plane.dist > rmax*(1.0 + 1.0e-10)) {
+      if (sorted) break;
+      continue;
+    }
+
+    // Check against the bounding box.
+    auto boxcomp = compare(plane, xmin, ymin, zmin, xmax, ymax, zmax);
+    auto above = boxcomp ==  1;
+    auto below = boxcomp == -1;
+    CHECK(not (above and below));
+
+    // Check the current set of vertices against this plane.
+    TIME_PC3d_checkverts.start();
+    if (not (above or below)) {
+      for (auto& v: polyhedron) {
+        v.comp = compare(plane, v.position);
+        if (v.comp == 1) {
+          below = false;
+        } else if (v.comp == -1) {
+          above = false;
+        }
+      }
+      CHECK(not (above and below));
+    }
+    TIME_PC3d_checkverts.stop();
+
+    // Did we get a simple case?
+    if (below) {
+      // The polyhedron is entirely below the clip plane, and is therefore entirely removed.
+      polyhedron.clear();
+
+    } else if (not above) {
+
+      // This plane passes through the polyhedron.
+      // Insert any new vertices.  Note the pools may move as we add to them,
+      // so we always index rather than hold pointers into them.
+      TIME_PC3d_insertverts.start();
+      auto& verts = polyhedron.vertices;
+      auto& neighbors = polyhedron.neighbors;
+      auto& clips = polyhedron.clips;
+      nverts0 = verts.size();
+      for (i = 0; i < nverts0; ++i) {
+        if (verts[i].comp == 1) {
+
+          // This vertex survives clipping -- check the neighbors for any new vertices we need to insert.
+          nneigh = verts[i].numNeighbors;
+          CHECK(nneigh >= 3);
+          for (j = 0; j < nneigh; ++j) {
+            jn = neighbors[verts[i].neighborOffset + j];
+            CHECK(jn < nverts0);
+            if (verts[jn].comp == -1) {
+
+              // This edge straddles the clip plane, so insert a new vertex.
+              nclipsi = verts[i].numClips;
+              nclipsj = verts[jn].numClips;
+              inew = addArenaVertex(polyhedron,
+                                    segmentPlaneIntersection(verts[i].position, verts[jn].position, plane),
+                                    2,                                     // 2 indicates new vertex
+                                    4,
+                                    1 + std::min(nclipsi, nclipsj));
+              auto& vnew = verts[inew];
+              vnew.numNeighbors = 2;
+              neighbors[vnew.neighborOffset] = jn;
+              neighbors[vnew.neighborOffset + 1] = i;
+
+              // The new vertex is clipped by this plane and any clips the
+              // edge endpoints have in common.
+              vnew.numClips = std::set_intersection(clips.begin() + verts[i].clipOffset,
+                                                    clips.begin() + verts[i].clipOffset + nclipsi,
+                                                    clips.begin() + verts[jn].clipOffset,
+                                                    clips.begin() + verts[jn].clipOffset + nclipsj,
+                                                    clips.begin() + vnew.clipOffset) - (clips.begin() + vnew.clipOffset);
+              insertArenaClip(polyhedron, inew, plane.ID);
+
+              // Patch up the links.
+              {
+                auto* nbegin = &neighbors[verts[jn].neighborOffset];
+                auto* nitr = std::find(nbegin, nbegin + verts[jn].numNeighbors, i);
+                CHECK(nitr != nbegin + verts[jn].numNeighbors);
+                *nitr = inew;
+              }
+              neighbors[verts[i].neighborOffset + j] = inew;
+            }
+          }
+        } else if (verts[i].comp == 0) {
+          // This vertex is exactly in plane, so just add this plane as a clip.
+          insertArenaClip(polyhedron, i, plane.ID);
+        }
+      }
+      nverts = verts.size();
+      TIME_PC3d_insertverts.stop();
+
+      // For each new vertex, link to the neighbors that survive the clipping.
+      TIME_PC3d_linknew.start();
+      for (i = nverts0; i < nverts; ++i) {
+        CHECK(verts[i].comp == 2);
+        nneigh = verts[i].numNeighbors;
+
+        // Look for any neighbors of the vertex that are clipped.
+        for (j = 0; j < nneigh; ++j) {
+          jn = neighbors[verts[i].neighborOffset + j];
+          if (verts[jn].comp == -1) {
+
+            // This neighbor is clipped, so look for the first unclipped vertex along this face loop.
+            iprev = i;
+            inext = jn;
+            itmp = inext;
+            k = 0;
+            while (verts[inext].comp == -1 and k++ < nverts) {
+              itmp = inext;
+              inext = nextInFaceLoop(polyhedron, inext, iprev);
+              iprev = itmp;
+            }
+            CHECK(verts[inext].comp != -1);
+            neighbors[verts[i].neighborOffset + j] = inext;
+            insertArenaNeighborFront(polyhedron, inext, i);
+          }
+        }
+      }
+      TIME_PC3d_linknew.stop();
+
+      // Remove the clipped vertices, compressing the polyhedron and its pools.
+      TIME_PC3d_compress.start();
+      i = 0;
+      xmin = std::numeric_limits<double>::max(), xmax = std::numeric_limits<double>::lowest();
+      ymin = std::numeric_limits<double>::max(), ymax = std::numeric_limits<double>::lowest();
+      zmin = std::numeric_limits<double>::max(), zmax = std::numeric_limits<double>::lowest();
+      rmax2 = 0.0;
+      for (auto& v: verts) {
+        if (v.comp >= 0) {
+          v.ID = i++;
+          xmin = std::min(xmin, v.position[0]);
+          xmax = std::max(xmax, v.position[0]);
+          ymin = std::min(ymin, v.position[1]);
+          ymax = std::max(ymax, v.position[1]);
+          zmin = std::min(zmin, v.position[2]);
+          zmax = std::max(zmax, v.position[2]);
+          rmax2 = std::max(rmax2, v.position.magnitude2());
+        }
+      }
+      rmax = std::sqrt(rmax2);
+
+      // Renumber the neighbor links.
+      for (i = 0; i < nverts; ++i) {
+        if (verts[i].comp >= 0) {
+          CHECK(verts[i].numNeighbors >= 3);
+          for (j = 0; j < verts[i].numNeighbors; ++j) {
+            neighbors[verts[i].neighborOffset + j] = verts[neighbors[verts[i].neighborOffset + j]].ID;
+          }
+        }
+      }
+
+      // Copy the surviving slices into the scratch pools, leaving a spare
+      // neighbor slot for in-plane vertices picking up new links.
+      auto& newNeighbors = arenaNeighborScratch;
+      auto& newClips = arenaClipScratch;
+      newNeighbors.clear();
+      newClips.clear();
+      k = 0;
+      for (i = 0; i < nverts; ++i) {
+        if (verts[i].comp >= 0) {
+          auto v = verts[i];
+          const auto noff = newNeighbors.size();
+          newNeighbors.insert(newNeighbors.end(), neighbors.begin() + v.neighborOffset, neighbors.begin() + v.neighborOffset + v.numNeighbors);
+          newNeighbors.push_back(-1);
+          const auto coff = newClips.size();
+          newClips.insert(newClips.end(), clips.begin() + v.clipOffset, clips.begin() + v.clipOffset + v.numClips);
+          v.neighborOffset = noff;
+          v.neighborCapacity = v.numNeighbors + 1;
+          v.clipOffset = coff;
+          v.clipCapacity = v.numClips;
+          verts[k++] = v;
+        }
+      }
+      verts.resize(k);
+      neighbors.assign(newNeighbors.begin(), newNeighbors.end());
+      clips.assign(newClips.begin(), newClips.end());
+
+      // Is the polyhedron gone?
+      if (polyhedron.size() < 4) polyhedron.clear();
+      TIME_PC3d_compress.stop();
+    }
+  }
+  TIME_PC3d_planes.stop();
+  TIME_PC3d_clip.stop();
+}
+
+//------------------------------------------------------------------------------
+// Collapse degenerate vertices of an ArenaPolyhedron.
+// The same algorithm as collapseDegenerates for Polyhedron, building the
+// merged neighbor and clip lists in scratch space and writing them back to
+// the vertex slices.
+//------------------------------------------------------------------------------
+void collapseDegenerates(ArenaPolyhedron& polyhedron,
+                         const double tol) {
+  TIME_PC3d_collapseDegenerates.start();
+
+  const auto tol2 = tol*tol;
+  auto& verts = polyhedron.vertices;
+  auto& neighbors = polyhedron.neighbors;
+  auto& clips = polyhedron.clips;
+  auto& loop = arenaLoopScratch;
+  const int n = verts.size();
+  if (n > 0) {
+
+    // Set the initial ID's the vertices.
+    for (auto i = 0; i < n; ++i) verts[i].ID = i;
+
+    // Walk the polyhedron removing degenerate edges until we make a sweep without
+    // removing any.  Don't worry about ordering of the neighbors yet.
+    auto active = false;
+    for (auto i = 0; i < n; ++i) {
+      if (verts[i].ID >= 0) {
+        auto idone = false;
+        while (not idone) {
+          idone = true;
+          for (auto jneigh = 0; jneigh < verts[i].numNeighbors; ++jneigh) {
+            const auto j = neighbors[verts[i].neighborOffset + jneigh];
+            CHECK(verts[j].ID >= 0);
+            if ((verts[i].position - verts[j].position).magnitude2() < tol2) {
+              active = true;
+              idone = false;
+              verts[j].ID = -1;
+
+              // Merge the clips of j into i.
+              loop.clear();
+              std::set_union(clips.begin() + verts[i].clipOffset, clips.begin() + verts[i].clipOffset + verts[i].numClips,
+                             clips.begin() + verts[j].clipOffset, clips.begin() + verts[j].clipOffset + verts[j].numClips,
+                             std::back_inserter(loop));
+              assignArenaSlice(clips, verts[i].clipOffset, verts[i].numClips, verts[i].clipCapacity, loop);
+
+              // Merge the neighbors of j->i:  the neighbors of j following i
+              // (wrapping around) go where j was in the neighbors of i.
+              {
+                const auto ibegin = neighbors.begin() + verts[i].neighborOffset;
+                const auto jbegin = neighbors.begin() + verts[j].neighborOffset;
+                const auto jend = jbegin + verts[j].numNeighbors;
+                const auto kitr = std::find(jbegin, jend, i);
+                CHECK(kitr != jend);
+                loop.assign(ibegin, ibegin + jneigh);
+                loop.insert(loop.end(), kitr + 1, jend);
+                loop.insert(loop.end(), jbegin, kitr);
+                loop.insert(loop.end(), ibegin + jneigh, ibegin + verts[i].numNeighbors);
+              }
+
+              // Make sure i & j are removed from the neighbor set of i, and
+              // remove any adjacent repeats.
+              loop.erase(remove_if(loop.begin(), loop.end(),
+                                   [&](const int val) { return val == i or val == j; }),
+                         loop.end());
+              removeAdjacentRepeats(loop);
+              assignArenaSlice(neighbors, verts[i].neighborOffset, verts[i].numNeighbors, verts[i].neighborCapacity, loop);
+
+              // Make all the neighbors of j point back at i instead of j.
+              for (auto kk = 0; kk < verts[j].numNeighbors; ++kk) {
+                const auto k = neighbors[verts[j].neighborOffset + kk];
+                // i is a neighbor to j, and j has already been removed from list
+                // also, i can not be a neighbor to itself
+                if (k != i) {
+                  const auto kbegin = neighbors.begin() + verts[k].neighborOffset;
+                  const auto kend = kbegin + verts[k].numNeighbors;
+                  const auto itr = std::find(kbegin, kend, j);
+                  if (itr != kend) *itr = i;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    if (active) {
+
+      // Renumber the nodes assuming we're going to clear out the degenerates.
+      auto offset = 0;
+      for (auto i = 0; i < n; ++i) {
+        if (verts[i].ID == -1) {
+          --offset;
+        } else {
+          verts[i].ID += offset;
+        }
+      }
+      for (auto i = 0; i < n; ++i) {
+        if (verts[i].ID >= 0) {
+          for (auto j = 0; j < verts[i].numNeighbors; ++j) {
+            neighbors[verts[i].neighborOffset + j] = verts[neighbors[verts[i].neighborOffset + j]].ID;
+          }
+        }
+      }
+
+      // Copy the surviving vertices into the scratch pools, dropping links to
+      // the collapsed vertices and any adjacent repeats.
+      auto& newNeighbors = arenaNeighborScratch;
+      auto& newClips = arenaClipScratch;
+      newNeighbors.clear();
+      newClips.clear();
+      auto k = 0;
+      for (auto i = 0; i < n; ++i) {
+        if (verts[i].ID >= 0) {
+          auto v = verts[i];
+          loop.assign(neighbors.begin() + v.neighborOffset, neighbors.begin() + v.neighborOffset + v.numNeighbors);
+          loop.erase(remove_if(loop.begin(), loop.end(), [](const int x) { return x < 0; }), loop.end());
+          removeAdjacentRepeats(loop);
+          v.neighborOffset = newNeighbors.size();
+          v.numNeighbors = loop.size();
+          v.neighborCapacity = v.numNeighbors;
+          newNeighbors.insert(newNeighbors.end(), loop.begin(), loop.end());
+          v.clipOffset = newClips.size();
+          v.clipCapacity = v.numClips;
+          newClips.insert(newClips.end(), clips.begin() + verts[i].clipOffset, clips.begin() + verts[i].clipOffset + verts[i].numClips);
+          verts[k++] = v;
+        }
+      }
+      verts.resize(k);
+      neighbors.assign(newNeighbors.begin(), newNeighbors.end());
+      clips.assign(newClips.begin(), newClips.end());
+      if (polyhedron.size() < 4) polyhedron.clear();
+    }
+  }
+
+  // Post-conditions.
+  BEGIN_CONTRACT_SCOPE
+  {
+    const int n = polyhedron.size();
+    for (auto i = 0; i < n; ++i) {
+      ENSURE(polyhedron[i].ID == i);
+      for (auto j = 0; j < polyhedron[i].numNeighbors; ++j) {
+        CONTRACT_VAR(j);
+        ENSURE(polyhedron.neighbors[polyhedron[i].neighborOffset + j] >= 0 and
+               polyhedron.neighbors[polyhedron[i].neighborOffset + j] < n);
+      }
+    }
+  }
+  END_CONTRACT_SCOPE
+
+  TIME_PC3d_collapseDegenerates.stop();
+}
+
+//------------------------------------------------------------------------------
+// Return the vertices of an ArenaPolyhedron ordered in faces.
+// We walk the faces in the same order as extractFaces for Polyhedron, flagging
+// the directed edges walked by slot as moments does.
+//------------------------------------------------------------------------------
+vector<vector<int>>
+extractFaces(const ArenaPolyhedron& poly) {
+
+  vector<vector<int>> result;
+  auto& walked = arenaEdgeWalked;
+  walked.assign(poly.neighbors.size(), 0);
+  const auto& neighbors = poly.neighbors;
+  const int nverts = poly.size();
+  for (auto i = 0; i < nverts; ++i) {
+    const auto& v = poly[i];
+    if (v.comp >= 0) {
+      for (auto j = 0; j < v.numNeighbors; ++j) {
+        if (walked[v.neighborOffset + j] == 0) {
+
+          // Follow around the face represented by the edge (ni -> i) until we
+          // get back to our starting vertex.
+          const auto vstart = neighbors[v.neighborOffset + j];
+          CHECK(poly[vstart].comp >= 0);
+          vector<int> face(1, vstart);
+          auto vprev = vstart;
+          auto vnext = i;
+          while (vnext != vstart) {
+            face.push_back(vnext);
+            const auto& vn = poly[vnext];
+            const auto* nbegin = &neighbors[vn.neighborOffset];
+            const auto* itr = std::find(nbegin, nbegin + vn.numNeighbors, vprev);
+            CHECK(itr != nbegin + vn.numNeighbors);
+            CHECK2(walked[vn.neighborOffset + (itr - nbegin)] == 0, polyhedron2string(poly));
+            walked[vn.neighborOffset + (itr - nbegin)] = 1;
+            vprev = vnext;
+            vnext = (itr == nbegin ? nbegin[vn.numNeighbors - 1] : *(itr - 1));
+          }
+
+          // Final edge connecting last->first vertex.
+          {
+            const auto& vn = poly[vstart];
+            const auto* nbegin = &neighbors[vn.neighborOffset];
+            const auto* itr = std::find(nbegin, nbegin + vn.numNeighbors, vprev);
+            CHECK(itr != nbegin + vn.numNeighbors);
+            walked[vn.neighborOffset + (itr - nbegin)] = 1;
+          }
+          CHECK(face.size() >= 3);
+          result.push_back(face);
+        }
+      }
+    }
+  }
+
+  // Post-conditions.
+  BEGIN_CONTRACT_SCOPE
+  {
+    // Every edge should have been walked in both directions.
+    for (auto i = 0; i < nverts; ++i) {
+      for (auto j = 0; j < poly[i].numNeighbors; ++j) {
+        CONTRACT_VAR(j);
+        CHECK(poly[i].comp < 0 or walked[poly[i].neighborOffset + j] == 1);
+      }
+    }
+  }
+  END_CONTRACT_SCOPE
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Return a nicely formatted string representing the ArenaPolyhedron.
+//------------------------------------------------------------------------------
+std::string
+polyhedron2string(const ArenaPolyhedron& poly) {
+
+  std::ostringstream s;
+  const auto nverts = poly.size();
+  for (auto i = 0u; i < nverts; ++i) {
+    const auto& v = poly[i];
+    s << i << " ID=" << v.ID << " comp=" << v.comp << " @ " << v.position
+      << " neighbors=[";
+    copy(poly.neighbors.begin() + v.neighborOffset, poly.neighbors.begin() + v.neighborOffset + v.numNeighbors, ostream_iterator<int>(s, " "));
+    s << "] clips[";
+    copy(poly.clips.begin() + v.clipOffset, poly.clips.begin() + v.clipOffset + v.numClips, ostream_iterator<int>(s, " "));
+    s << "]\n";
+  }
+
+  return s.str();
+}
+
+//------------------------------------------------------------------------------
+// Convert PolyClipper::ArenaPolyhedron -> Spheral::GeomPolyhedron.
+//------------------------------------------------------------------------------
+vector<set<int>> convertFromPolyhedron(Spheral::Dim<3>::FacetedVolume& Spheral_polyhedron,
+                                       const ArenaPolyhedron& polyhedron) {
+  TIME_PC3d_convertfrom.start();
+
+  // Useful types.
+  typedef Spheral::Dim<3>::FacetedVolume FacetedVolume;
+  typedef Spheral::Dim<3>::Vector Vector;
+
+  vector<set<int>> vertexPlanes;
+
+  if (polyhedron.empty()) {
+
+    Spheral_polyhedron = FacetedVolume();
+
+  } else {
+
+    // extractFaces actually does most of the work.
+    const auto faces = extractFaces(polyhedron);
+
+    // Number and extract the active vertices.
+    const auto nverts = polyhedron.size();
+    vector<Vector> coords;
+    vector<int> ids(nverts, -1);
+    for (auto i = 0u; i < nverts; ++i) {
+      const auto& v = polyhedron[i];
+      if (v.comp >= 0) {
+        ids[i] = coords.size();
+        coords.push_back(v.position);
+        vertexPlanes.push_back(set<int>(polyhedron.clips.begin() + v.clipOffset,
+                                        polyhedron.clips.begin() + v.clipOffset + v.numClips));
+      }
+    }
+
+    // Extract the faces as integer vertex index loops.
+    vector<vector<unsigned>> facets(faces.size());
+    for (auto k = 0u; k < faces.size(); ++k) {
+      facets[k].resize(faces[k].size());
+      transform(faces[k].begin(), faces[k].end(), facets[k].begin(),
+                [&](const int k) { return ids[k]; });
+    }
+
+    // Now we can build the Spheral::Polyhedron.
+    Spheral_polyhedron = FacetedVolume(coords, facets);
+
+  }
+
+  // Return the set of planes responsible for each vertex.
+  ENSURE(vertexPlanes.size() == Spheral_polyhedron.vertices().size());
+  TIME_PC3d_convertfrom.stop();
+  return vertexPlanes;
+}
+
 }
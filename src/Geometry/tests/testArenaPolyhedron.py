@@ -0,0 +1,182 @@
+#ATS:test(SELF, label="ArenaPolyhedron clipping tests")
+
+import unittest
+from math import *
+
+from Spheral3d import *
+from testPolyClipper3d import cube_points, cube_neighbors, notched_points, notched_neighbors, \
+    degenerate_cube_points1, degenerate_cube_points2
+
+# Create a global random number generator.
+import random
+random.seed(2459)
+rangen = random.Random()
+
+#-------------------------------------------------------------------------------
+# The ArenaPolyhedron should give exactly the same answers as the Polyhedron
+# for every operation, so we compare the two on randomized clips.
+#-------------------------------------------------------------------------------
+class TestArenaPolyhedron(unittest.TestCase):
+
+    #---------------------------------------------------------------------------
+    # setUp
+    #---------------------------------------------------------------------------
+    def setUp(self):
+        self.polyData = [(cube_points, cube_neighbors),
+                         (notched_points, notched_neighbors)]
+        self.degeneratePolyData = [(degenerate_cube_points1, cube_neighbors),
+                                   (degenerate_cube_points2, cube_neighbors)]
+        self.ntests = 1000
+        return
+
+    #---------------------------------------------------------------------------
+    # Build the pair of polyhedra.
+    #---------------------------------------------------------------------------
+    def initialize(self, points, neighbors):
+        PCpoly = PolyClipper.Polyhedron()
+        PolyClipper.initializePolyhedron(PCpoly, points, neighbors)
+        arena = PolyClipper.ArenaPolyhedron()
+        PolyClipper.convertToArenaPolyhedron(arena, PCpoly)
+        return PCpoly, arena
+
+    #---------------------------------------------------------------------------
+    # Random planes passing through the bounding box of the points.
+    #---------------------------------------------------------------------------
+    def randomPlanes(self, points, nplanes, firstID):
+        xmin = Vector(min([p.x for p in points]), min([p.y for p in points]), min([p.z for p in points]))
+        xmax = Vector(max([p.x for p in points]), max([p.y for p in points]), max([p.z for p in points]))
+        planes = []
+        for k in xrange(nplanes):
+            p0 = Vector(rangen.uniform(xmin.x, xmax.x),
+                        rangen.uniform(xmin.y, xmax.y),
+                        rangen.uniform(xmin.z, xmax.z))
+            phat = Vector(rangen.uniform(-1.0, 1.0),
+                          rangen.uniform(-1.0, 1.0),
+                          rangen.uniform(-1.0, 1.0)).unitVector()
+            planes.append(PolyClipper.Plane3d(p0, phat, firstID + k))
+        return planes
+
+    #---------------------------------------------------------------------------
+    # Check an ArenaPolyhedron against the equivalent Polyhedron:  the
+    # vertices, neighbors and clips, the moments, and (unless the polyhedron
+    # has degenerate vertices) the Spheral::Polyhedron and vertex clips we
+    # extract from them.
+    #---------------------------------------------------------------------------
+    def compare(self, PCpoly, arena, label):
+        self.failUnless(len(arena) == len(PCpoly),
+                        "%s : %i != %i vertices" % (label, len(arena), len(PCpoly)))
+        self.failUnless(PolyClipper.polyhedron2string(arena) == PolyClipper.polyhedron2string(PCpoly),
+                        "%s : polyhedra differ\n%s\n !=\n%s" % (label,
+                                                                PolyClipper.polyhedron2string(arena),
+                                                                PolyClipper.polyhedron2string(PCpoly)))
+        for i in xrange(len(arena)):
+            self.failUnless(list(arena.vertexNeighbors(i)) == list(PCpoly[i].neighbors),
+                            "%s : vertex %i neighbors differ" % (label, i))
+            self.failUnless(sorted(arena.vertexClips(i)) == sorted(PCpoly[i].clips),
+                            "%s : vertex %i clips differ" % (label, i))
+        PCpoly1 = PolyClipper.Polyhedron()
+        PolyClipper.convertFromArenaPolyhedron(PCpoly1, arena)
+        self.failUnless(PolyClipper.polyhedron2string(PCpoly1) == PolyClipper.polyhedron2string(PCpoly),
+                        "%s : converted polyhedra differ" % label)
+        vol0, centroid0 = PolyClipper.moments(PCpoly)
+        vol1, centroid1 = PolyClipper.moments(arena)
+        self.failUnless(vol1 == vol0,
+                        "%s : volume %g != %g" % (label, vol1, vol0))
+        self.failUnless(centroid1 == centroid0,
+                        "%s : centroid %s != %s" % (label, centroid1, centroid0))
+        if min([len(v.neighbors) for v in PCpoly] + [3]) < 3:
+            return
+        poly0, poly1 = Polyhedron(), Polyhedron()
+        clips0 = PolyClipper.convertFromPolyhedron(poly0, PCpoly)
+        clips1 = PolyClipper.convertFromPolyhedron(poly1, arena)
+        self.failUnless([sorted(x) for x in clips1] == [sorted(x) for x in clips0],
+                        "%s : vertex clips differ: %s != %s" % (label, list(clips1), list(clips0)))
+        self.failUnless(len(poly1.vertices) == len(poly0.vertices),
+                        "%s : %i != %i Spheral::Polyhedron vertices" % (label, len(poly1.vertices), len(poly0.vertices)))
+        self.failUnless(list(poly1.vertices) == list(poly0.vertices),
+                        "%s : Spheral::Polyhedron vertices differ" % label)
+        self.failUnless(poly1.volume == poly0.volume,
+                        "%s : Spheral::Polyhedron volume %g != %g" % (label, poly1.volume, poly0.volume))
+        return
+
+    #---------------------------------------------------------------------------
+    # Conversions and moments of the unclipped polyhedra.
+    #---------------------------------------------------------------------------
+    def testConvert(self):
+        for points, neighbors in self.polyData + self.degeneratePolyData:
+            PCpoly, arena = self.initialize(points, neighbors)
+            self.compare(PCpoly, arena, "convert")
+
+    #---------------------------------------------------------------------------
+    # Clip with random sets of planes.
+    #---------------------------------------------------------------------------
+    def testRandomClips(self):
+        for points, neighbors in self.polyData:
+            for i in xrange(self.ntests):
+                PCpoly, arena = self.initialize(points, neighbors)
+                planes = self.randomPlanes(points, rangen.randint(1, 6), 0)
+                PolyClipper.clipPolyhedron(PCpoly, planes)
+                PolyClipper.clipPolyhedron(arena, planes)
+                self.compare(PCpoly, arena, "clip pass %i" % i)
+
+                # Clip the results again, which moves and grows the vertex
+                # slices in the arena.
+                planes = self.randomPlanes(points, 2, 10)
+                PolyClipper.clipPolyhedron(PCpoly, planes)
+                PolyClipper.clipPolyhedron(arena, planes)
+                self.compare(PCpoly, arena, "second clip pass %i" % i)
+
+    #---------------------------------------------------------------------------
+    # Clip with planes sorted by distance, as computeVoronoiVolume does, some of
+    # which lie beyond the polyhedron.  The arena clipper stops at the first
+    # plane past its bounding radius.
+    #---------------------------------------------------------------------------
+    def testSortedClips(self):
+        for points, neighbors in self.polyData:
+            rmax = max([p.magnitude() for p in points])
+            for i in xrange(self.ntests):
+                PCpoly, arena = self.initialize(points, neighbors)
+                planes = self.randomPlanes(points, rangen.randint(1, 6), 0)
+                for k in xrange(3):
+                    phat = Vector(rangen.uniform(-1.0, 1.0),
+                                  rangen.uniform(-1.0, 1.0),
+                                  rangen.uniform(-1.0, 1.0)).unitVector()
+                    planes.append(PolyClipper.Plane3d(rangen.uniform(1.0, 2.0)*rmax, phat))
+                planes.sort(key = lambda plane: plane.dist)
+                PolyClipper.clipPolyhedron(PCpoly, planes)
+                PolyClipper.clipPolyhedron(arena, planes)
+                self.compare(PCpoly, arena, "sorted clip pass %i" % i)
+
+    #---------------------------------------------------------------------------
+    # collapseDegenerates, on the degenerate cubes and on clipped polyhedra
+    # with planes passing very close to a vertex.
+    #---------------------------------------------------------------------------
+    def testCollapseDegenerates(self):
+        for points, neighbors in self.degeneratePolyData:
+            PCpoly, arena = self.initialize(points, neighbors)
+            PolyClipper.collapseDegenerates(PCpoly, 1.0e-10)
+            PolyClipper.collapseDegenerates(arena, 1.0e-10)
+            assert len(arena) == 5
+            self.compare(PCpoly, arena, "degenerate cube")
+
+        ncollapsed = 0
+        for points, neighbors in self.polyData:
+            for i in xrange(self.ntests):
+                PCpoly, arena = self.initialize(points, neighbors)
+                phat = Vector(rangen.uniform(-1.0, 1.0),
+                              rangen.uniform(-1.0, 1.0),
+                              rangen.uniform(-1.0, 1.0)).unitVector()
+                p0 = rangen.choice(points) + rangen.uniform(1.0e-12, 1.0e-11)*phat
+                planes = [PolyClipper.Plane3d(p0, phat, 0)] + self.randomPlanes(points, rangen.randint(0, 3), 1)
+                PolyClipper.clipPolyhedron(PCpoly, planes)
+                PolyClipper.clipPolyhedron(arena, planes)
+                n0 = len(PCpoly)
+                PolyClipper.collapseDegenerates(PCpoly, 1.0e-10)
+                PolyClipper.collapseDegenerates(arena, 1.0e-10)
+                if len(PCpoly) < n0:
+                    ncollapsed += 1
+                self.compare(PCpoly, arena, "collapse pass %i" % i)
+        self.failUnless(ncollapsed > 0, "No degenerate vertices were collapsed")
+
+if __name__ == "__main__":
+    unittest.main()
@@ -15,10 +15,12 @@
 #include "Utilities/allReduce.hh"
 #include "Utilities/FastMath.hh"
 #include "Utilities/PairComparisons.hh"
+#include "Utilities/boundPointWithinBox.hh"
 #include "Hydro/HydroFieldNames.hh"
 #include "Field/FieldList.hh"
 #include "Field/Field.hh"
 #include "Distributed/Communicator.hh"
+#include "Utilities/OpenMP_wrapper.hh"
 #include "Utilities/DBC.hh"
 
 #include <cstdio>
@@ -64,6 +66,19 @@ struct TreeDimensionTraits<Dim<2> > {
 
   static double forceLaw(const double r2) { return 1.0/sqrt(r2); }
   static double potentialLaw(const double r2) { return log(sqrt(r2)); }
+
+  // The far field of a unit mass as a function of s = r^2 + eps^2:  the
+  // potential psi(s) = 1/2 ln(s), and Dn = 2^n d^n psi/ds^n.
+  static void farFieldKernel(const double s, double& psi, double& D1, double& D2, double& D3) {
+    const double sinv = 1.0/s;
+    psi = 0.5*log(s);
+    D1 = sinv;
+    D2 = -2.0*sinv*sinv;
+    D3 = 8.0*sinv*sinv*sinv;
+  }
+
+  // The potential we accumulate (following potentialLaw) is -psi in 2D.
+  static double potentialSign() { return -1.0; }
 };
 
 //..............................................................................
@@ -85,6 +100,19 @@ struct TreeDimensionTraits<Dim<3> > {
 
   static double forceLaw(const double r2) { return 1.0/r2; }
   static double potentialLaw(const double r2) { return 1.0/sqrt(r2); }
+
+  // The far field of a unit mass as a function of s = r^2 + eps^2:  the
+  // Plummer potential psi(s) = -1/sqrt(s), and Dn = 2^n d^n psi/ds^n.
+  static void farFieldKernel(const double s, double& psi, double& D1, double& D2, double& D3) {
+    const double sinv = 1.0/s;
+    psi = -sqrt(sinv);
+    D1 = -psi*sinv;
+    D2 = -3.0*D1*sinv;
+    D3 = -5.0*D2*sinv;
+  }
+
+  // The potential we accumulate (following potentialLaw) is psi in 3D.
+  static double potentialSign() { return 1.0; }
 };
 
 }
@@ -171,16 +199,17 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   // Initialize the time-step voting data.
   FieldList<Dimension, std::vector<Scalar> > interactionMasses = dataBase.newGlobalFieldList(vector<Scalar>(), "gravity dt interaction masses");
   FieldList<Dimension, std::vector<Vector> > interactionPositions = dataBase.newGlobalFieldList(vector<Vector>(), "gravity dt interaction positions");
-  FieldList<Dimension, std::pair<LevelKey, CellKey> > homeBuckets = dataBase.newGlobalFieldList(pair<LevelKey, CellKey>(), "gravity dt home buckets");
   mDtMinAcc = std::numeric_limits<Scalar>::max();
 
-  // Prepare the flags to remember which cells have terminated for each node.
-  CompletedCellSet cellsCompleted;
-  for (unsigned nodeListi = 0; nodeListi != mass.numFields(); ++nodeListi) {
-    for (unsigned i = 0; i != mass[nodeListi]->numInternalElements(); ++i) {
-      cellsCompleted[NodeID(nodeListi, i)] = vector<boost::unordered_set<CellKey> >(num1dbits);
-    }
-  }
+  // Prepare the local expansions for each cell in our tree, and the direct
+  // accumulations for each node.  We only need to remember which cells
+  // each node interacted with for the dynamical time step choice.
+  const size_t ncells = mTree.cells.size();
+  const size_t nnodes = mTree.masses.size();
+  vector<LocalExpansion> expansions(ncells);
+  vector<Vector> accel(nnodes, Vector::zero);
+  vector<Scalar> phi(nnodes, 0.0);
+  vector<InteractionBuckets> buckets(mTimeStepChoice == GravityTimeStepType::DynamicalTime ? ncells : 0);
 
 #ifdef USE_MPI
 
@@ -188,52 +217,103 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   const unsigned rank = Process::getRank();
   const unsigned numProcs = Process::getTotalNumberOfProcesses();
 
-  // Pack up the local tree.
-  vector<char> localBuffer, buffer;
-  this->serialize(mTree, localBuffer);
-  unsigned localBufSize = localBuffer.size();
+  // Exchange the bounding boxes of the nodes on each domain:  a flag for
+  // whether the domain has any nodes, then xmin and xmax.
+  const unsigned boxSize = 2*Dimension::nDim + 1;
+  vector<double> localBox(boxSize, 0.0), boxes(boxSize*numProcs);
+  if (nnodes > 0) {
+    Vector xmin = mTree.positions[0], xmax = mTree.positions[0];
+    for (const Vector& xi: mTree.positions) {
+      xmin = elementWiseMin(xmin, xi);
+      xmax = elementWiseMax(xmax, xi);
+    }
+    localBox[0] = 1.0;
+    std::copy(xmin.begin(), xmin.end(), localBox.begin() + 1);
+    std::copy(xmax.begin(), xmax.end(), localBox.begin() + 1 + Dimension::nDim);
+  }
+  MPI_Allgather(&localBox.front(), boxSize, MPI_DOUBLE, &boxes.front(), boxSize, MPI_DOUBLE, Communicator::communicator());
+
+  // Pack up the locally essential tree each other domain needs from us.
+  vector<vector<char> > sendBuffers(numProcs);
+  vector<unsigned> sendSizes(numProcs, 0U), recvSizes(numProcs, 0U);
+#pragma omp parallel for schedule(dynamic)
+  for (unsigned otherProc = 0; otherProc < numProcs; ++otherProc) {
+    const double* otherBox = &boxes[boxSize*otherProc];
+    if (otherProc != rank and nnodes > 0 and otherBox[0] > 0.0) {
+      Vector xmin, xmax;
+      std::copy(otherBox + 1, otherBox + 1 + Dimension::nDim, xmin.begin());
+      std::copy(otherBox + 1 + Dimension::nDim, otherBox + boxSize, xmax.begin());
+      Tree tree;
+      this->buildLocallyEssentialTree(xmin, xmax, tree);
+      this->serialize(tree, sendBuffers[otherProc]);
+      sendSizes[otherProc] = sendBuffers[otherProc].size();
+    }
+  }
+  MPI_Alltoall(&sendSizes.front(), 1, MPI_UNSIGNED, &recvSizes.front(), 1, MPI_UNSIGNED, Communicator::communicator());
 
-  // Launch our sends to all other processors.  This may be a bit aggressive.... :)
-  vector<MPI_Request> sendRequests;
-  sendRequests.reserve(2*numProcs);
+  // Post our receives and sends.
+  vector<vector<char> > recvBuffers(numProcs);
+  vector<MPI_Request> recvRequests(numProcs, MPI_REQUEST_NULL), sendRequests;
+  sendRequests.reserve(numProcs);
   for (unsigned otherProc = 0; otherProc != numProcs; ++otherProc) {
-    if (otherProc != rank) {
+    if (recvSizes[otherProc] > 0) {
+      recvBuffers[otherProc].resize(recvSizes[otherProc]);
+      MPI_Irecv(&recvBuffers[otherProc].front(), recvSizes[otherProc], MPI_CHAR, otherProc, 2, Communicator::communicator(), &recvRequests[otherProc]);
+    }
+    if (sendSizes[otherProc] > 0) {
       sendRequests.push_back(MPI_Request());
-      MPI_Isend(&localBufSize, 1, MPI_UNSIGNED, otherProc, 1, Communicator::communicator(), &sendRequests.back());
-      if (localBufSize > 0) {
-        sendRequests.push_back(MPI_Request());
-        MPI_Isend(&localBuffer.front(), localBufSize, MPI_CHAR, otherProc, 2, Communicator::communicator(), &sendRequests.back());
-      }
+      MPI_Isend(&sendBuffers[otherProc].front(), sendSizes[otherProc], MPI_CHAR, otherProc, 2, Communicator::communicator(), &sendRequests.back());
     }
   }
-  CHECK(sendRequests.size() <= 2*numProcs);
+  CHECK(sendRequests.size() <= numProcs);
+
+#endif
+
+  // Apply the forces from our local tree while the remote trees are in flight.
+  this->applyTreeForces(mTree, expansions, accel, phi, buckets);
 
-  // Now walk the other processes and get their trees to add to our own.
-  unsigned bufSize;
-  MPI_Status recvStatus;
-  vector<char>::const_iterator bufItr;
-  Tree tree;
+#ifdef USE_MPI
+
+  // Now add the forces from the other domains' trees.  We take these in
+  // domain order (rather than as they arrive) so the sums are reproducible.
   for (unsigned otherProc = 0; otherProc != numProcs; ++otherProc) {
-    if (otherProc != rank) {
-      MPI_Recv(&bufSize, 1, MPI_UNSIGNED, otherProc, 1, Communicator::communicator(), &recvStatus);
-      if (bufSize > 0) {
-        buffer = vector<char>(bufSize);
-        MPI_Recv(&buffer.front(), bufSize, MPI_CHAR, otherProc, 2, Communicator::communicator(), &recvStatus);
-        tree = Tree();
-        bufItr = buffer.begin();
-        this->deserialize(tree, bufItr, buffer.end());
-        CHECK(bufItr == buffer.end());
-        mDtMinAcc = min(mDtMinAcc, 
-                        applyTreeForces(tree, mass, position, DvDt, mPotential, interactionMasses, interactionPositions, homeBuckets, cellsCompleted));
-      }
+    if (recvSizes[otherProc] > 0) {
+      MPI_Status recvStatus;
+      MPI_Wait(&recvRequests[otherProc], &recvStatus);
+      Tree tree;
+      vector<char>::const_iterator bufItr = recvBuffers[otherProc].begin();
+      this->deserialize(tree, bufItr, recvBuffers[otherProc].end());
+      CHECK(bufItr == recvBuffers[otherProc].end());
+      vector<char>().swap(recvBuffers[otherProc]);
+      this->applyTreeForces(tree, expansions, accel, phi, buckets);
     }
   }
 
 #endif
 
-  // Apply the forces from our local tree.
-  mDtMinAcc = min(mDtMinAcc,
-                  applyTreeForces(mTree, mass, position, DvDt, mPotential, interactionMasses, interactionPositions, homeBuckets, cellsCompleted));
+  // Push the cell expansions down to the nodes.  The walks only accumulate
+  // expansions at or below the task cells, so we can do each task cell
+  // independently.
+  const vector<unsigned> tasks = this->taskCells();
+  const unsigned ntasks = tasks.size();
+#pragma omp parallel for schedule(dynamic)
+  for (unsigned itask = 0; itask < ntasks; ++itask) {
+    const unsigned icell = tasks[itask];
+    InteractionBuckets pathBuckets;
+    this->evaluateExpansions(icell, LocalExpansion(), mTree.cells[icell].xcm, expansions, buckets, pathBuckets,
+                             accel, phi, interactionMasses, interactionPositions);
+  }
+
+  // Accumulate the results to the nodes, and the acceleration based constraint
+  // for the time-step.
+  for (size_t k = 0; k != nnodes; ++k) {
+    const NodeID& inode = mTree.nodeIDs[k];
+    DvDt(inode.first, inode.second) += accel[k];       // Multiply by G later
+    mPotential(inode.first, inode.second) += phi[k];   // Multiply by G later
+    const double amag = accel[k].magnitude();
+    if (amag > 0.0) mDtMinAcc = min(mDtMinAcc, sqrt(mSofteningLength/amag));   // Divide by G later
+  }
+  mDtMinAcc /= sqrt(mG);
 
   // If we're using the dynamical time step choice, make the calculations for the next
   // time step now.
@@ -279,15 +359,6 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
                 0.75*sqrt(rpcmax2*rpc2) <= xpcmax.dot(xpc)) rholocal += rhoenc[j].first;
           }
 
-          // // Add this nodes local bucket.
-          // const LevelKey levelKey = mHomeBuckets(nodeListi, i).first;
-          // const CellKey cellKey = mHomeBuckets(nodeListi, i).second;
-          // CHECK(levelKey <= mTree.size());
-          // typename TreeLevel::const_iterator itr = mTree[levelKey].find(cellKey);
-          // CHECK(itr != mTree[levelKey].end());
-          // const Cell& localCell = itr->second; // mTree[levelKey][cellKey];
-          // rholocal += localCell.Mglobal/Dimension::pownu(sqrt((localCell.xcm - xi).magnitude2() + softLength2));
-
           // Now check for the global max.
           if (mRhoMax < rholocal) {
             mRhoMax = rholocal;
@@ -374,7 +445,6 @@ initialize(const Scalar /*time*/,
     const FieldList<Dimension, Scalar> mass = state.fields(HydroFieldNames::mass, 0.0);
     const FieldList<Dimension, Vector> position = state.fields(HydroFieldNames::position, Vector::zero);
     const FieldList<Dimension, Vector> velocity = state.fields(HydroFieldNames::velocity, Vector::zero);
-    const size_t numNodeLists = mass.numFields();
 
     // Determine the box size.
     globalBoundingBox(position, mXmin, mXmax, false);
@@ -384,91 +454,9 @@ initialize(const Scalar /*time*/,
     mBoxLength = (mXmax - mXmin).maxAbsElement();
     CHECK(mBoxLength >= 0.0);
 
-    // Walk all the internal nodes and add them to the tree.
-    for (size_t nodeListi = 0; nodeListi != numNodeLists; ++nodeListi) {
-      const size_t n = mass[nodeListi]->numInternalElements();
-      for (size_t i = 0; i != n; ++i) {
-        this->addNodeToTree(mass(nodeListi, i), position(nodeListi, i), velocity(nodeListi, i));
-      }
-    }
-
-#ifdef USE_MPI
-
-    // We require the true global center of mass for each cell, which means
-    // in parallel we need to exchange the local trees and build up this information.
-    // We also build the global total mass in each cell at the same time.
-    // Get the processor information.
-    const unsigned rank = Process::getRank();
-    const unsigned numProcs = Process::getTotalNumberOfProcesses();
-
-    // Pack up the local tree.
-    vector<char> localBuffer, buffer;
-    this->serialize(mTree, localBuffer);
-
-    // Walk each process, and have them send their local tree info to all other
-    // domains.
-    unsigned bufSize;
-    vector<char>::const_iterator bufItr;
-    Tree tree;
-    for (unsigned sendProc = 0; sendProc != numProcs; ++sendProc) {
-
-      // Broadcast the send processor's tree.
-      buffer = localBuffer;
-      bufSize = buffer.size();
-      MPI_Bcast(&bufSize, 1, MPI_UNSIGNED, sendProc, Communicator::communicator());
-      buffer.resize(bufSize);
-      MPI_Bcast(&buffer.front(), bufSize, MPI_CHAR, sendProc, Communicator::communicator());
-      tree = Tree();
-      bufItr = buffer.begin();
-      this->deserialize(tree, bufItr, buffer.end());
-      CHECK(bufItr == buffer.end());
-
-      // Augment any of our local cell calculations for mass and center of mass.
-      if (sendProc != rank) {
-        const unsigned nlevels = min(mTree.size(), tree.size());
-        for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
-          for (typename TreeLevel::iterator myItr = mTree[ilevel].begin();
-               myItr != mTree[ilevel].end();
-               ++myItr) {
-            const CellKey key = myItr->first;
-            Cell& cell = myItr->second;
-            CHECK(cell.key == key);
-            const typename TreeLevel::const_iterator otherItr = tree[ilevel].find(key);
-            if (otherItr != tree[ilevel].end()) {
-              const Cell& otherCell = otherItr->second;
-              cell.xcm = (cell.Mglobal*cell.xcm + otherCell.M*otherCell.xcm)/(cell.Mglobal + otherCell.M);
-              cell.vcm = (cell.Mglobal*cell.vcm + otherCell.M*otherCell.vcm)/(cell.Mglobal + otherCell.M);
-              cell.Mglobal += otherCell.M;
-            }
-          }
-        }
-      }
-    }
-
-#endif
-
-    // Set the daughter pointers.
-    constructDaughterPtrs(mTree);
-
-    // Make a final pass over the cells and fill in the distance between the 
-    // center of mass and the geometric center.
-    CellKey ckey, ix, iy, iz;
-    double cellsize;
-    for (unsigned ilevel = 0; ilevel != mTree.size(); ++ilevel) {
-      cellsize = mBoxLength/(1U << ilevel);
-      //double cellvol = Dimension::pownu(cellsize);
-      for (typename TreeLevel::iterator itr = mTree[ilevel].begin();
-           itr != mTree[ilevel].end();
-           ++itr) {
-        ckey = itr->first;
-        Cell& cell = itr->second;
-        extractCellIndices(ckey, ix, iy, iz);
-
-        // Update the distance between the cell's center of mass and geometric center.
-        cell.rcm2cc2 = (cell.xcm - TreeDimensionTraits<Dimension>::cellCenter(mXmin, ix, iy, iz, cellsize)).magnitude2();
-        CHECK(cell.rcm2cc2 < Dimension::nDim*cellsize*cellsize);
-      }
-    }
+    // Build the tree from our local nodes.  Each domain's tree carries the
+    // moments of just its own nodes, so there is no need to communicate here.
+    this->buildTree(mass, position, velocity);
   }
 }
 
@@ -541,73 +529,65 @@ template<typename Dimension>
 std::string
 TreeGravity<Dimension>::
 dumpTree(const bool globalTree) const {
-  std::stringstream ss;
-  CellKey ix, iy, iz;
-#ifdef USE_MPI
-  const unsigned numProcs = Process::getTotalNumberOfProcesses();
-  const unsigned rank = Process::getRank();
-#endif
-  unsigned nlevels = mTree.size();
-  if (globalTree) nlevels = allReduce(nlevels, MPI_MAX, Communicator::communicator());
-
-  ss << "Tree : nlevels = " << nlevels << "\n";
-  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
-
-    // Gather up the level cells and sort them.
-    vector<Cell> cells;
-    vector<char> localBuffer;
-    cells.reserve(mTree[ilevel].size());
-    if (ilevel < mTree.size()) {
-      for (typename TreeLevel::const_iterator itr = mTree[ilevel].begin();
-           itr != mTree[ilevel].end();
-           ++itr) {
-        cells.push_back(itr->second);
-        this->serialize(itr->second, localBuffer);
-      }
+  typedef pair<pair<LevelKey, CellKey>, string> CellDescription;
+
+  // Describe each of our cells.
+  vector<CellDescription> cells;
+  for (const Cell& cell: mTree.cells) {
+    std::stringstream cs;
+    cs << "    Cell key=" << cell.key << "\n"
+       << "         xcm=" << cell.xcm << " vcm=" << cell.vcm << " rmax=" << cell.rmax << " M=" << cell.M << "\n"
+       << "         S=" << cell.S << "\n"
+       << "         daughters = ( ";
+    for (unsigned k = 0; k != cell.numDaughters; ++k) cs << mTree.cells[cell.firstDaughter + k].key << " ";
+    cs << ")\n"
+       << "         nodes = [";
+    if (cell.numDaughters == 0) {
+      for (unsigned k = cell.firstNode; k != cell.firstNode + cell.numNodes; ++k) cs << " ("
+                                                                                     << mTree.masses[k] << " "
+                                                                                     << mTree.positions[k] << ")";
     }
+    cs << " ]\n";
+    cells.push_back(make_pair(make_pair(cell.level, cell.key), cs.str()));
+  }
+
 #ifdef USE_MPI
-    if (globalTree) {
-      for (unsigned sendProc = 0; sendProc != numProcs; ++sendProc) {
-        unsigned bufSize = localBuffer.size();
-        MPI_Bcast(&bufSize, 1, MPI_UNSIGNED, sendProc, Communicator::communicator());
-        if (bufSize > 0) {
-          vector<char> buffer = localBuffer;
-          MPI_Bcast(&buffer.front(), bufSize, MPI_CHAR, sendProc, Communicator::communicator());
-          if (rank != sendProc) {
-            vector<char>::const_iterator itr = buffer.begin();
-            while (itr < buffer.end()) {
-              cells.push_back(Cell());
-              this->deserialize(cells.back(), itr, buffer.end());
-            }
-          }
-        }
+  // Gather everyone's cells if we're describing the global tree.
+  if (globalTree) {
+    const unsigned numProcs = Process::getTotalNumberOfProcesses();
+    const unsigned rank = Process::getRank();
+    vector<char> localBuffer;
+    packElement(cells, localBuffer);
+    for (unsigned sendProc = 0; sendProc != numProcs; ++sendProc) {
+      unsigned bufSize = localBuffer.size();
+      MPI_Bcast(&bufSize, 1, MPI_UNSIGNED, sendProc, Communicator::communicator());
+      vector<char> buffer = localBuffer;
+      buffer.resize(bufSize);
+      MPI_Bcast(&buffer.front(), bufSize, MPI_CHAR, sendProc, Communicator::communicator());
+      if (rank != sendProc) {
+        vector<CellDescription> otherCells;
+        vector<char>::const_iterator itr = buffer.begin();
+        unpackElement(otherCells, itr, buffer.end());
+        cells.insert(cells.end(), otherCells.begin(), otherCells.end());
       }
     }
+  }
+#else
+  CONTRACT_VAR(globalTree);
 #endif
-    sort(cells.begin(), cells.end());
-    cells.erase(unique(cells.begin(), cells.end()), cells.end());
+  sort(cells.begin(), cells.end());
 
+  // Write out the cells by level.
+  std::stringstream ss;
+  const unsigned nlevels = cells.empty() ? 0U : cells.back().first.first + 1U;
+  ss << "Tree : nlevels = " << nlevels << "\n";
+  auto itr = cells.begin();
+  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
+    auto endItr = itr;
+    while (endItr != cells.end() and endItr->first.first == ilevel) ++endItr;
     ss << "--------------------------------------------------------------------------------\n" 
-       << " Level " << ilevel << " : numCells = " << cells.size() << "\n";
-    for (typename vector<Cell>::const_iterator itr = cells.begin();
-         itr != cells.end();
-         ++itr) {
-      const Cell& cell = *itr;
-      extractCellIndices(cell.key, ix, iy, iz);
-      ss << "    Cell key=" << cell.key << " : (ix,iy,iz)=(" << ix << " " << iy << " " << iz << ")\n"
-         << "         xcm=" << cell.xcm << " vcm=" << cell.vcm << " rcm2cc=" << sqrt(cell.rcm2cc2) << " M=" << cell.M  << " Mglobal=" << cell.Mglobal << "\n"
-         << "         daughters = ( ";
-      for (vector<CellKey>::const_iterator ditr = cell.daughters.begin();
-           ditr != cell.daughters.end();
-           ++ditr) ss << *ditr << " ";
-      ss << ")\n"
-         << "         nodes = [";
-      for (unsigned k = 0; k != cell.masses.size(); ++k) ss << " ("
-                                                            << cell.masses[k] << " "
-                                                            << cell.positions[k] << " "
-                                                            << cell.velocities[k] << ")";
-      ss <<" ]\n";
-    }
+       << " Level " << ilevel << " : numCells = " << (endItr - itr) << "\n";
+    for (; itr != endItr; ++itr) ss << itr->second;
   }
   return ss.str();
 }
@@ -619,62 +599,34 @@ template<typename Dimension>
 std::string
 TreeGravity<Dimension>::
 dumpTreeStatistics(const bool globalTree) const {
-  std::stringstream ss;
-#ifdef USE_MPI
-  const unsigned numProcs = Process::getTotalNumberOfProcesses();
-  const unsigned rank = Process::getRank();
-#endif
-  unsigned nlevels = mTree.size();
-  if (globalTree) nlevels = allReduce(nlevels, MPI_MAX, Communicator::communicator());
 
-  ss << "Tree : nlevels = " << nlevels << "\n";
-  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
-
-    // Gather up the level cells and sort them.
-    vector<Cell> cells;
-    vector<char> localBuffer;
-    cells.reserve(mTree[ilevel].size());
-    if (ilevel < mTree.size()) {
-      for (typename TreeLevel::const_iterator itr = mTree[ilevel].begin();
-           itr != mTree[ilevel].end();
-           ++itr) {
-        cells.push_back(itr->second);
-        this->serialize(itr->second, localBuffer);
-      }
+  // Count the cells and the nodes in leaf cells on each level.
+  vector<unsigned> ncells, nparticles;
+  for (const Cell& cell: mTree.cells) {
+    if (cell.level >= ncells.size()) {
+      ncells.resize(cell.level + 1, 0U);
+      nparticles.resize(cell.level + 1, 0U);
     }
-#ifdef USE_MPI
-    if (globalTree) {
-      for (unsigned sendProc = 0; sendProc != numProcs; ++sendProc) {
-        unsigned bufSize = localBuffer.size();
-        MPI_Bcast(&bufSize, 1, MPI_UNSIGNED, sendProc, Communicator::communicator());
-        if (bufSize > 0) {
-          vector<char> buffer = localBuffer;
-          MPI_Bcast(&buffer.front(), bufSize, MPI_CHAR, sendProc, Communicator::communicator());
-          if (rank != sendProc) {
-            vector<char>::const_iterator itr = buffer.begin();
-            while (itr < buffer.end()) {
-              cells.push_back(Cell());
-              this->deserialize(cells.back(), itr, buffer.end());
-            }
-          }
-        }
-      }
+    ++ncells[cell.level];
+    if (cell.numDaughters == 0) nparticles[cell.level] += cell.numNodes;
+  }
+  unsigned nlevels = ncells.size();
+  if (globalTree) {
+    nlevels = allReduce(nlevels, MPI_MAX, Communicator::communicator());
+    ncells.resize(nlevels, 0U);
+    nparticles.resize(nlevels, 0U);
+    for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
+      ncells[ilevel] = allReduce(ncells[ilevel], MPI_SUM, Communicator::communicator());
+      nparticles[ilevel] = allReduce(nparticles[ilevel], MPI_SUM, Communicator::communicator());
     }
-#endif
-    sort(cells.begin(), cells.end());
-    cells.erase(unique(cells.begin(), cells.end()), cells.end());
+  }
 
-    // Count up how much of everything we have.
+  std::stringstream ss;
+  ss << "Tree : nlevels = " << nlevels << "\n";
+  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
     ss << "--------------------------------------------------------------------------------\n" 
-       << " Level " << ilevel << " : numCells = " << cells.size() << "\n";
-    unsigned nparticles = 0;
-    for (typename vector<Cell>::const_iterator itr = cells.begin();
-         itr != cells.end();
-         ++itr) {
-      const Cell& cell = *itr;
-      nparticles += cell.masses.size();
-    }
-    ss << "         : nparts = " << nparticles << "\n";
+       << " Level " << ilevel << " : numCells = " << ncells[ilevel] << "\n"
+       << "         : nparts = " << nparticles[ilevel] << "\n";
   }
   return ss.str();
 }
@@ -809,140 +761,393 @@ restoreState(const FileIO& file, const string& pathName) {
 }
 
 //------------------------------------------------------------------------------
-// Apply the forces from a tree.
+// Build the tree from the local nodes.
 //------------------------------------------------------------------------------
 template<typename Dimension>
-typename Dimension::Scalar
+void
 TreeGravity<Dimension>::
-applyTreeForces(const Tree& tree,
-                const FieldList<Dimension, Scalar>& mass,
-                const FieldList<Dimension, Vector>& position,
-                FieldList<Dimension, Vector>& DvDt,
-                FieldList<Dimension, Scalar>& potential,
-                FieldList<Dimension, vector<Scalar> >& interactionMasses,
-                FieldList<Dimension, vector<Vector> >& interactionPositions,
-                FieldList<Dimension, pair<LevelKey, CellKey> >& homeBuckets,
-                TreeGravity<Dimension>::CompletedCellSet& cellsCompleted) const {
-
-  const unsigned numNodeLists = mass.numFields();
-  //const unsigned numNodes = mass.numInternalNodes();
-  const double boxLength2 = mBoxLength*mBoxLength;
-  const double softLength2 = mSofteningLength*mSofteningLength;
+buildTree(const FieldList<Dimension, Scalar>& mass,
+          const FieldList<Dimension, Vector>& position,
+          const FieldList<Dimension, Vector>& velocity) {
+  mTree = Tree();
 
-  // Prepare the result for the shortest timestep.
-  double result = std::numeric_limits<double>::max();
+  // Sort the nodes by Morton key.
+  vector<pair<CellKey, NodeID> > keys;
+  const size_t numNodeLists = mass.numFields();
+  for (size_t nodeListi = 0; nodeListi != numNodeLists; ++nodeListi) {
+    const size_t n = mass[nodeListi]->numInternalElements();
+    for (size_t i = 0; i != n; ++i) keys.push_back(make_pair(this->mortonKey(position(nodeListi, i)), NodeID(nodeListi, i)));
+  }
+  std::sort(keys.begin(), keys.end());
+  const size_t nnodes = keys.size();
+  if (nnodes == 0) return;
+
+  mTree.masses.resize(nnodes);
+  mTree.positions.resize(nnodes);
+  mTree.nodeIDs.resize(nnodes);
+  vector<Vector> velocities(nnodes);
+  for (size_t k = 0; k != nnodes; ++k) {
+    const NodeID& inode = keys[k].second;
+    mTree.masses[k] = mass(inode.first, inode.second);
+    mTree.positions[k] = position(inode.first, inode.second);
+    velocities[k] = velocity(inode.first, inode.second);
+    mTree.nodeIDs[k] = inode;
+  }
 
-  // Declare variables we're going to need in the loop once.  May help with optimization?
-  unsigned nodeListi, i, j, k, ilevel, nremaining;
-  double mj, cellsize2, rji2;
-  Vector xji, nhat;
-  vector<Cell*> remainingCells, newDaughters;
-  NodeID inode;
+  // Build the cells breadth first.  Since the nodes are sorted by key, the
+  // nodes of each daughter are a contiguous subrange of the parent's.
+  mTree.cells.push_back(Cell());
+  mTree.cells[0].numNodes = nnodes;
+  for (size_t icell = 0; icell < mTree.cells.size(); ++icell) {
+    const LevelKey ilevel = mTree.cells[icell].level;
+    const CellKey key = mTree.cells[icell].key;
+    const uint32_t kbegin = mTree.cells[icell].firstNode;
+    const uint32_t kend = kbegin + mTree.cells[icell].numNodes;
+    if (kend - kbegin > maxLeafSize and ilevel < num1dbits) {
+      const uint32_t firstDaughter = mTree.cells.size();
+      uint32_t k = kbegin;
+      while (k < kend) {
+        const unsigned idaughter = this->daughterIndex(keys[k].first, ilevel);
+        uint32_t kk = k + 1;
+        while (kk < kend and this->daughterIndex(keys[kk].first, ilevel) == idaughter) ++kk;
+        Cell daughter;
+        daughter.key = (key << Dimension::nDim) + idaughter;
+        daughter.level = ilevel + 1;
+        daughter.firstNode = k;
+        daughter.numNodes = kk - k;
+        mTree.cells.push_back(daughter);
+        k = kk;
+      }
+      mTree.cells[icell].firstDaughter = firstDaughter;
+      mTree.cells[icell].numDaughters = mTree.cells.size() - firstDaughter;
+      CHECK(mTree.cells[icell].numDaughters <= (1U << Dimension::nDim));
+    }
+  }
+
+  // Compute the cell moments from the leaves up.  Daughters always follow
+  // their parents, so we can just walk the cells backwards.
+  for (int icell = mTree.cells.size() - 1; icell >= 0; --icell) {
+    Cell& cell = mTree.cells[icell];
+    if (cell.numDaughters == 0) {
+      const uint32_t kend = cell.firstNode + cell.numNodes;
+      for (uint32_t k = cell.firstNode; k != kend; ++k) {
+        cell.M += mTree.masses[k];
+        cell.xcm += mTree.masses[k]*mTree.positions[k];
+        cell.vcm += mTree.masses[k]*velocities[k];
+      }
+      CHECK(cell.M > 0.0);
+      cell.xcm /= cell.M;
+      cell.vcm /= cell.M;
+      for (uint32_t k = cell.firstNode; k != kend; ++k) {
+        const Vector dx = mTree.positions[k] - cell.xcm;
+        cell.S += mTree.masses[k]*dx.selfdyad();
+        cell.rmax = max(cell.rmax, dx.magnitude());
+      }
+    } else {
+      const uint32_t dend = cell.firstDaughter + cell.numDaughters;
+      for (uint32_t d = cell.firstDaughter; d != dend; ++d) {
+        const Cell& daughter = mTree.cells[d];
+        cell.M += daughter.M;
+        cell.xcm += daughter.M*daughter.xcm;
+        cell.vcm += daughter.M*daughter.vcm;
+      }
+      CHECK(cell.M > 0.0);
+      cell.xcm /= cell.M;
+      cell.vcm /= cell.M;
+      for (uint32_t d = cell.firstDaughter; d != dend; ++d) {
+        const Cell& daughter = mTree.cells[d];
+        const Vector dx = daughter.xcm - cell.xcm;
+        cell.S += daughter.S + daughter.M*dx.selfdyad();
+        cell.rmax = max(cell.rmax, dx.magnitude() + daughter.rmax);
+      }
+    }
+  }
+}
 
-  // We'll always be starting with the daughters of the root level.
-  const unsigned numLevels = tree.size();
-  if (numLevels >= 1) {
-    const Cell& rootCell = tree[0].begin()->second;
+//------------------------------------------------------------------------------
+// The cells of the local tree we divide the tree walks into.  We descend from
+// the root until we have enough independent subtrees to keep the threads busy.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+vector<unsigned>
+TreeGravity<Dimension>::
+taskCells() const {
+  vector<unsigned> result;
+  if (not mTree.cells.empty()) {
+    const size_t target = 8*omp_get_max_threads();
+    result.push_back(0U);
+    bool refined = true;
+    while (refined and result.size() < target) {
+      refined = false;
+      vector<unsigned> next;
+      for (const unsigned icell: result) {
+        const Cell& cell = mTree.cells[icell];
+        if (cell.numDaughters > 0) {
+          for (unsigned k = 0; k != cell.numDaughters; ++k) next.push_back(cell.firstDaughter + k);
+          refined = true;
+        } else {
+          next.push_back(icell);
+        }
+      }
+      result.swap(next);
+    }
+  }
+  return result;
+}
 
-    // Walk each internal node.
-    typename TreeLevel::const_iterator cellItr;
-    for (nodeListi = 0; nodeListi != numNodeLists; ++nodeListi) {
-      for (i = 0; i != mass[nodeListi]->numInternalElements(); ++i) {
+//------------------------------------------------------------------------------
+// Extract the locally essential tree for another domain.
+// The other domain's nodes all lie within the box [xmin, xmax], so any of our
+// cells which is well separated from every point in the box (treating those
+// points as cells of zero size) is always accepted as a multipole by that
+// domain's walk, and we need not send anything beneath it.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+TreeGravity<Dimension>::
+buildLocallyEssentialTree(const Vector& xmin,
+                          const Vector& xmax,
+                          Tree& result) const {
+  result = Tree();
+  if (mTree.cells.empty()) return;
+  const double acceptFactor = 1.0/min(1.0, mOpening2);
+
+  // Copy the cells breadth first, so the daughters of each cell stay
+  // contiguous.  localCells maps the result cells back to our own.
+  vector<uint32_t> localCells(1, 0U);
+  result.cells.push_back(mTree.cells[0]);
+  for (size_t icell = 0; icell < result.cells.size(); ++icell) {
+    const Cell& cell = mTree.cells[localCells[icell]];
+    const double r2 = (cell.xcm - boundPointWithinBox(cell.xcm, xmin, xmax)).magnitude2();
+    Cell& copy = result.cells[icell];
+    if (r2 > acceptFactor*cell.rmax*cell.rmax) {
+
+      // Prune this cell.
+      copy.firstDaughter = 0;
+      copy.numDaughters = 0;
+      copy.firstNode = 0;
+      copy.numNodes = 0;
+
+    } else if (cell.numDaughters == 0) {
+
+      // A leaf we might open, so send along its nodes.
+      copy.firstNode = result.masses.size();
+      result.masses.insert(result.masses.end(), mTree.masses.begin() + cell.firstNode, mTree.masses.begin() + cell.firstNode + cell.numNodes);
+      result.positions.insert(result.positions.end(), mTree.positions.begin() + cell.firstNode, mTree.positions.begin() + cell.firstNode + cell.numNodes);
+
+    } else {
+
+      // Queue up the daughters.
+      const uint32_t firstDaughter = result.cells.size();
+      for (uint32_t k = 0; k != cell.numDaughters; ++k) {
+        localCells.push_back(cell.firstDaughter + k);
+        result.cells.push_back(mTree.cells[cell.firstDaughter + k]);
+      }
+      result.cells[icell].firstDaughter = firstDaughter;
+      result.cells[icell].firstNode = 0;
+      result.cells[icell].numNodes = 0;
 
-        // State of node i.
-        //mi = mass(nodeListi, i);
-        const Vector& xi = position(nodeListi, i);
-        Vector& DvDti = DvDt(nodeListi, i);
-        Scalar& phii = potential(nodeListi, i);
-        inode = NodeID(nodeListi, i);
-
-        // Walk the tree.
-        ilevel = 0;
-        remainingCells = rootCell.daughterPtrs;
-        while ((not remainingCells.empty()) and ++ilevel < numLevels) {
-          nremaining = remainingCells.size();
-          newDaughters = vector<Cell*>();
-          newDaughters.reserve(8*nremaining);
-          cellsize2 = boxLength2/(1U << (2*ilevel));
-
-          // Walk each of the current set of Cells.
-          for (k = 0; k != nremaining; ++k) {
-            const Cell& cell = *remainingCells[k];
-
-            // Can we ignore this cells daughters?
-            if (cellsCompleted[inode][ilevel].find(cell.key) == cellsCompleted[inode][ilevel].end()) {
-              xji = cell.xcm - xi;
-              rji2 = xji.magnitude2();
-
-              // We use Barnes (1994) modified criterion, except for the extra square factor here for efficiency.
-              if (rji2 > cellsize2/mOpening2 + cell.rcm2cc2) {      
-
-                // Yep, treat this cells and all of its daughters as a single point.
-                nhat = xji.unitVector();
-                rji2 += softLength2;
-                CHECK(rji2 > 0.0);
-
-                // Increment the acceleration and potential.
-                DvDti += cell.Mglobal*TreeDimensionTraits<Dimension>::forceLaw(rji2) * nhat;  // Multiply by G later
-                phii -= cell.Mglobal*TreeDimensionTraits<Dimension>::potentialLaw(rji2);   // Multiply by G later
-                cellsCompleted[inode][ilevel].insert(cell.key);
-
-                // Add to the set of "interaction" buckets for this point, which are used for
-                // choosing the timestep.
-                interactionMasses(nodeListi, i).push_back(cell.Mglobal);
-                interactionPositions(nodeListi, i).push_back(cell.xcm);
-
-              } else if (cell.daughterPtrs.size() == 0) {
-
-                // This cell represents a leaf (termination of descent.  We just directly
-                // add up the node properties of any nodes in the cell.
-                CHECK(cell.masses.size() > 0 and
-                      cell.positions.size() == cell.masses.size() and
-                      cell.velocities.size() == cell.masses.size());
-                for (j = 0; j != cell.masses.size(); ++j) {
-                  mj = cell.masses[j];
-                  const Vector& xj = cell.positions[j];
-                  xji = xj - xi;
-                  rji2 = xji.magnitude2();
-
-                  if (rji2/softLength2 > 1.0e-10) {           // Screen out self-interaction.
-                    nhat = xji.unitVector();
-                    rji2 += softLength2;
-                    CHECK(rji2 > 0.0);
-
-                    // Increment the acceleration and potential.
-                    DvDti += mj*TreeDimensionTraits<Dimension>::forceLaw(rji2) * nhat;  // Multiply by G later
-                    phii -= mj*TreeDimensionTraits<Dimension>::potentialLaw(rji2);   // Multiply by G later
-                  } else {
-                    homeBuckets(nodeListi, i) = make_pair(ilevel, cell.key);
-                  }
-                }
-
-                // Add this cells contribution to the interaction buckets.
-                interactionMasses(nodeListi, i).push_back(cell.Mglobal);
-                interactionPositions(nodeListi, i).push_back(cell.xcm);
-
-              } else {
-
-                // We need to walk further down the tree.  Add this cells daughters
-                // to the next set.
-                copy(cell.daughterPtrs.begin(), cell.daughterPtrs.end(), back_inserter(newDaughters));
-
-              }
+    }
+  }
+  ENSURE(result.masses.size() == result.positions.size());
+}
+
+//------------------------------------------------------------------------------
+// Apply the forces from a tree.
+// This is a dual tree walk of our local (sink) tree against the source tree.
+// Pairs of cells that are well separated relative to the opening criterion
+// interact through the monopole and quadrupole moments of the source,
+// expanded to first order about the center of mass of the sink cell.  Failing
+// that we split the larger cell, and pairs of leaves interact node by node.
+// Pruned cells in a locally essential source tree are never split:  we split
+// the sink down to its leaves instead, and evaluate the source multipole at
+// the sink nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+TreeGravity<Dimension>::
+applyTreeForces(const Tree& sourceTree,
+                vector<LocalExpansion>& expansions,
+                vector<Vector>& accel,
+                vector<Scalar>& phi,
+                vector<InteractionBuckets>& buckets) const {
+  if (mTree.cells.empty() or sourceTree.cells.empty()) return;
+  REQUIRE(expansions.size() == mTree.cells.size());
+  REQUIRE(accel.size() == mTree.masses.size());
+  REQUIRE(phi.size() == mTree.masses.size());
+  REQUIRE(buckets.empty() or buckets.size() == mTree.cells.size());
+
+  const bool selfTree = (&sourceTree == &mTree);
+  const bool trackBuckets = not buckets.empty();
+  const double softLength2 = mSofteningLength*mSofteningLength;
+
+  // Cells are well separated if the distance between their centers of mass
+  // exceeds the sum of their radii over the opening ratio.  We never accept
+  // overlapping cells, where the expansions are invalid.
+  const double acceptFactor = 1.0/min(1.0, mOpening2);
+
+  // Walk each task cell of our tree against the source tree.  Each walk only
+  // touches the expansions and nodes in its own subtree.
+  const vector<unsigned> tasks = this->taskCells();
+  const unsigned ntasks = tasks.size();
+#pragma omp parallel for schedule(dynamic)
+  for (unsigned itask = 0; itask < ntasks; ++itask) {
+    vector<pair<uint32_t, uint32_t> > stack(1, make_pair(tasks[itask], 0U));
+    while (not stack.empty()) {
+      const uint32_t b = stack.back().first;
+      const uint32_t a = stack.back().second;
+      stack.pop_back();
+      const Cell& sink = mTree.cells[b];
+      const Cell& source = sourceTree.cells[a];
+      const bool self = (selfTree and a == b);
+
+      // Can we treat the source as a multipole?
+      if (not self) {
+        const Vector d = sink.xcm - source.xcm;
+        const double r2 = d.magnitude2();
+        const double rsum = sink.rmax + source.rmax;
+        if (r2 > acceptFactor*rsum*rsum) {
+          double psi, D1, D2, D3;
+          TreeDimensionTraits<Dimension>::farFieldKernel(r2 + softLength2, psi, D1, D2, D3);
+          const double trS = source.S.Trace();
+          const Vector Sd = source.S*d;
+          const double dSd = d.dot(Sd);
+          LocalExpansion& L = expansions[b];
+          L.phi += source.M*psi + 0.5*(D1*trS + D2*dSd);
+          L.a -= source.M*D1*d + 0.5*(D2*(trS*d + 2.0*Sd) + D3*dSd*d);
+          L.J -= source.M*(D1*SymTensor::one + D2*d.selfdyad());
+          if (trackBuckets) buckets[b].push_back(make_pair(source.M, source.xcm));
+          continue;
+        }
+      }
+
+      const bool sinkLeaf = (sink.numDaughters == 0);
+      const bool sourceLeaf = (source.numDaughters == 0);
+      if (sinkLeaf and sourceLeaf and source.numNodes == 0) {
+
+        // A pruned source cell from a locally essential tree against a leaf
+        // -- evaluate the source multipole at each of the sink nodes.
+        const double psign = TreeDimensionTraits<Dimension>::potentialSign();
+        const double trS = source.S.Trace();
+        const uint32_t iend = sink.firstNode + sink.numNodes;
+        for (uint32_t i = sink.firstNode; i != iend; ++i) {
+          const Vector d = mTree.positions[i] - source.xcm;
+          double psi, D1, D2, D3;
+          TreeDimensionTraits<Dimension>::farFieldKernel(d.magnitude2() + softLength2, psi, D1, D2, D3);
+          const Vector Sd = source.S*d;
+          const double dSd = d.dot(Sd);
+          phi[i] += psign*(source.M*psi + 0.5*(D1*trS + D2*dSd));
+          accel[i] -= source.M*D1*d + 0.5*(D2*(trS*d + 2.0*Sd) + D3*dSd*d);
+        }
+        if (trackBuckets) buckets[b].push_back(make_pair(source.M, source.xcm));
+
+      } else if (sinkLeaf and sourceLeaf) {
+
+        // Both leaves -- sum the node contributions directly.
+        const uint32_t iend = sink.firstNode + sink.numNodes;
+        const uint32_t jend = source.firstNode + source.numNodes;
+        for (uint32_t i = sink.firstNode; i != iend; ++i) {
+          const Vector& xi = mTree.positions[i];
+          Vector& ai = accel[i];
+          Scalar& phii = phi[i];
+          for (uint32_t j = source.firstNode; j != jend; ++j) {
+            const Vector xji = sourceTree.positions[j] - xi;
+            double rji2 = xji.magnitude2();
+            if (rji2/softLength2 > 1.0e-10) {           // Screen out self-interaction.
+              const Vector nhat = xji.unitVector();
+              rji2 += softLength2;
+              CHECK(rji2 > 0.0);
+              ai += sourceTree.masses[j]*TreeDimensionTraits<Dimension>::forceLaw(rji2) * nhat;
+              phii -= sourceTree.masses[j]*TreeDimensionTraits<Dimension>::potentialLaw(rji2);
             }
           }
+        }
+        if (trackBuckets) buckets[b].push_back(make_pair(source.M, source.xcm));
+
+      } else if (self) {
 
-          // Update the set of cells to check on the next pass.
-          remainingCells = newDaughters;
+        // A cell against itself -- all pairs of daughters.
+        for (uint32_t kb = 0; kb != sink.numDaughters; ++kb) {
+          for (uint32_t ka = 0; ka != source.numDaughters; ++ka) {
+            stack.push_back(make_pair(sink.firstDaughter + kb, source.firstDaughter + ka));
+          }
         }
 
-        // Update the total acceleration based constraint for the time-step.
-        const double amag = DvDti.magnitude();
-        if (amag > 0.0) result = min(result, sqrt(mSofteningLength / amag));       // Divide by G later
+      } else if (sourceLeaf or (not sinkLeaf and sink.rmax >= source.rmax)) {
+
+        // Split the sink.
+        for (uint32_t kb = 0; kb != sink.numDaughters; ++kb) stack.push_back(make_pair(sink.firstDaughter + kb, a));
+
+      } else {
+
+        // Split the source.
+        for (uint32_t ka = 0; ka != source.numDaughters; ++ka) stack.push_back(make_pair(b, source.firstDaughter + ka));
+
       }
     }
   }
-  return result/sqrt(mG);
+}
+
+//------------------------------------------------------------------------------
+// Push the local expansions down the tree from the given cell to its nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+TreeGravity<Dimension>::
+evaluateExpansions(const unsigned icell,
+                   const LocalExpansion& parentExpansion,
+                   const Vector& parentCenter,
+                   const vector<LocalExpansion>& expansions,
+                   const vector<InteractionBuckets>& buckets,
+                   InteractionBuckets& pathBuckets,
+                   vector<Vector>& accel,
+                   vector<Scalar>& phi,
+                   FieldList<Dimension, vector<Scalar> >& interactionMasses,
+                   FieldList<Dimension, vector<Vector> >& interactionPositions) const {
+  const Cell& cell = mTree.cells[icell];
+
+  // Shift the parent expansion to our center of mass, and add our own.
+  const Vector delta = cell.xcm - parentCenter;
+  LocalExpansion L;
+  L.phi = parentExpansion.phi - parentExpansion.a.dot(delta) + expansions[icell].phi;
+  L.a = parentExpansion.a + parentExpansion.J*delta + expansions[icell].a;
+  L.J = parentExpansion.J + expansions[icell].J;
+
+  // Accumulate the interaction buckets along the way.
+  const bool trackBuckets = not buckets.empty();
+  const size_t nbuckets = pathBuckets.size();
+  if (trackBuckets) pathBuckets.insert(pathBuckets.end(), buckets[icell].begin(), buckets[icell].end());
+
+  if (cell.numDaughters == 0) {
+
+    // Evaluate the expansion at each of our nodes.
+    const double psign = TreeDimensionTraits<Dimension>::potentialSign();
+    const uint32_t kend = cell.firstNode + cell.numNodes;
+    for (uint32_t k = cell.firstNode; k != kend; ++k) {
+      const Vector dx = mTree.positions[k] - cell.xcm;
+      accel[k] += L.a + L.J*dx;
+      phi[k] += psign*(L.phi - L.a.dot(dx));
+      if (trackBuckets) {
+        const NodeID& inode = mTree.nodeIDs[k];
+        vector<Scalar>& masses = interactionMasses(inode.first, inode.second);
+        vector<Vector>& positions = interactionPositions(inode.first, inode.second);
+        for (const auto& bucket: pathBuckets) {
+          masses.push_back(bucket.first);
+          positions.push_back(bucket.second);
+        }
+      }
+    }
+
+  } else {
+
+    // Recurse to our daughters.
+    for (unsigned k = 0; k != cell.numDaughters; ++k) {
+      this->evaluateExpansions(cell.firstDaughter + k, L, cell.xcm, expansions, buckets, pathBuckets,
+                               accel, phi, interactionMasses, interactionPositions);
+    }
+  }
+
+  pathBuckets.resize(nbuckets);
 }
 
 //------------------------------------------------------------------------------
@@ -953,18 +1158,11 @@ void
 TreeGravity<Dimension>::
 serialize(const TreeGravity<Dimension>::Tree& tree,
           std::vector<char>& buffer) const {
-  const unsigned nlevels = tree.size();
-  packElement(nlevels, buffer);
-  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
-    const unsigned ncells = tree[ilevel].size();
-    packElement(ncells, buffer);
-    for (typename TreeLevel::const_iterator itr = tree[ilevel].begin();
-         itr != tree[ilevel].end();
-         ++itr) {
-      packElement(itr->first, buffer);
-      serialize(itr->second, buffer);
-    }
-  }
+  const unsigned ncells = tree.cells.size();
+  packElement(ncells, buffer);
+  for (const Cell& cell: tree.cells) serialize(cell, buffer);
+  packElement(tree.masses, buffer);
+  packElement(tree.positions, buffer);
 }
 
 //------------------------------------------------------------------------------
@@ -976,15 +1174,16 @@ TreeGravity<Dimension>::
 serialize(const TreeGravity<Dimension>::Cell& cell,
           std::vector<char>& buffer) const {
   packElement(cell.M, buffer);
-  packElement(cell.Mglobal, buffer);
   packElement(cell.xcm, buffer);
   packElement(cell.vcm, buffer);
-  packElement(cell.rcm2cc2, buffer);
+  packElement(cell.S, buffer);
+  packElement(cell.rmax, buffer);
   packElement(cell.key, buffer);
-  packElement(cell.daughters, buffer);
-  packElement(cell.masses, buffer);
-  packElement(cell.positions, buffer);
-  packElement(cell.velocities, buffer);
+  packElement(cell.level, buffer);
+  packElement(cell.firstDaughter, buffer);
+  packElement(cell.numDaughters, buffer);
+  packElement(cell.firstNode, buffer);
+  packElement(cell.numNodes, buffer);
 }
 
 //------------------------------------------------------------------------------
@@ -996,25 +1195,13 @@ TreeGravity<Dimension>::
 deserialize(TreeGravity<Dimension>::Tree& tree,
             vector<char>::const_iterator& bufItr,
             const vector<char>::const_iterator& endItr) const {
-  unsigned nlevels;
-  CellKey key;
-  Cell cell;
-  unpackElement(nlevels, bufItr, endItr);
-  tree.resize(nlevels);
-  for (unsigned ilevel = 0; ilevel != nlevels; ++ilevel) {
-    unsigned ncells;
-    unpackElement(ncells, bufItr, endItr);
-    for (unsigned i = 0; i != ncells; ++i) {
-      cell.daughters = vector<CellKey>();
-      cell.masses = vector<double>();
-      cell.positions = vector<Vector>();
-      cell.velocities = vector<Vector>();
-      unpackElement(key, bufItr, endItr);
-      deserialize(cell, bufItr, endItr);
-      tree[ilevel][key] = cell;
-    }
-  }
-  constructDaughterPtrs(tree);
+  unsigned ncells;
+  unpackElement(ncells, bufItr, endItr);
+  tree.cells.resize(ncells);
+  for (unsigned i = 0; i != ncells; ++i) deserialize(tree.cells[i], bufItr, endItr);
+  unpackElement(tree.masses, bufItr, endItr);
+  unpackElement(tree.positions, bufItr, endItr);
+  tree.nodeIDs.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -1027,15 +1214,16 @@ deserialize(TreeGravity<Dimension>::Cell& cell,
             vector<char>::const_iterator& bufItr,
             const vector<char>::const_iterator& endItr) const {
   unpackElement(cell.M, bufItr, endItr);
-  unpackElement(cell.Mglobal, bufItr, endItr);
   unpackElement(cell.xcm, bufItr, endItr);
   unpackElement(cell.vcm, bufItr, endItr);
-  unpackElement(cell.rcm2cc2, bufItr, endItr);
+  unpackElement(cell.S, bufItr, endItr);
+  unpackElement(cell.rmax, bufItr, endItr);
   unpackElement(cell.key, bufItr, endItr);
-  unpackElement(cell.daughters, bufItr, endItr);
-  unpackElement(cell.masses, bufItr, endItr);
-  unpackElement(cell.positions, bufItr, endItr);
-  unpackElement(cell.velocities, bufItr, endItr);
+  unpackElement(cell.level, bufItr, endItr);
+  unpackElement(cell.firstDaughter, bufItr, endItr);
+  unpackElement(cell.numDaughters, bufItr, endItr);
+  unpackElement(cell.firstNode, bufItr, endItr);
+  unpackElement(cell.numNodes, bufItr, endItr);
 }
 
 //------------------------------------------------------------------------------
@@ -1043,8 +1231,6 @@ deserialize(TreeGravity<Dimension>::Cell& cell,
 //------------------------------------------------------------------------------
 template<typename Dimension> unsigned TreeGravity<Dimension>::num1dbits = 21U;
 template<typename Dimension> uint64_t TreeGravity<Dimension>::max1dKey = 1U << TreeGravity<Dimension>::num1dbits;
-template<typename Dimension> uint64_t TreeGravity<Dimension>::xkeymask = (1U << TreeGravity<Dimension>::num1dbits) - 1U;
-template<typename Dimension> uint64_t TreeGravity<Dimension>::ykeymask = TreeGravity<Dimension>::xkeymask << TreeGravity<Dimension>::num1dbits;
-template<typename Dimension> uint64_t TreeGravity<Dimension>::zkeymask = TreeGravity<Dimension>::ykeymask << TreeGravity<Dimension>::num1dbits;
+template<typename Dimension> unsigned TreeGravity<Dimension>::maxLeafSize = 8U;
 
 }
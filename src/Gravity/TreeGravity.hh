@@ -2,6 +2,17 @@
 // TreeGravity -- An implementation of the tree n-body gravity solver.
 // Based on the original 3D only OctTreeGravity.
 //
+// The tree is stored as a flat, Morton ordered array of cells carrying
+// monopole and quadrupole (second) moments.  Forces are computed with a
+// dual tree walk:  well separated pairs of cells interact through local
+// expansions about the sink cell centers of mass, which are then pushed down
+// the tree to the nodes, while nearby leaf cells interact directly.
+//
+// In parallel each domain sends every other domain only the locally essential
+// part of its tree:  cells far enough from the other domain's bounding box
+// that they will always be accepted as multipoles are sent without their
+// daughters or nodes.
+//
 // Created by JMO, 2013-06-12
 //----------------------------------------------------------------------------//
 #ifndef __Spheral_TreeGravity__
@@ -12,8 +23,7 @@
 #include "Field/FieldList.hh"
 
 #include <stdint.h>
-#include "boost/unordered_map.hpp"
-#include "boost/unordered_set.hpp"
+#include <vector>
 
 namespace Spheral {
 
@@ -132,42 +142,57 @@ private:
   typedef uint32_t LevelKey;
   typedef uint64_t CellKey;
   typedef std::pair<size_t, size_t> NodeID;
-  typedef boost::unordered_map<NodeID, std::vector<boost::unordered_set<CellKey> > > CompletedCellSet;
 
   static unsigned num1dbits;                   // The number of bits we quantize 1D coordinates to.  We have to fit three of these in 64 bits.
   static CellKey max1dKey;                     // The maximum number of cells this corresponds to in a direction.
-  static CellKey xkeymask, ykeymask, zkeymask; // Bit masks we can use to extract the coordinate specific indices from a cell key.
+  static unsigned maxLeafSize;                 // The maximum number of nodes in a leaf cell (above the finest level).
 
   //----------------------------------------------------------------------------
-  // Cell holds the properties of cells in the tree.
+  // Cell holds the properties of cells in the tree.  Cells are stored flat in
+  // breadth first (and therefore Morton) order, with the daughters of each cell
+  // contiguous, and reference a contiguous range of the tree's nodes (which
+  // are sorted by Morton key).  In a locally essential tree a cell with
+  // neither daughters nor nodes is a pruned cell, represented only by its
+  // moments.
   //----------------------------------------------------------------------------
   struct Cell {
-    double M, Mglobal;               // total mass (and global sum)
+    double M;                        // total mass
     Vector xcm;                      // center of mass
     Vector vcm;                      // velocity of center of mass
-    double rcm2cc2;                  // square of the distance between center of mass and geometric center
-    CellKey key;                     // Key for this cell.
-    std::vector<CellKey> daughters;  // Keys of any daughter cells on level+1
-    std::vector<Cell*> daughterPtrs; // Pointers to the daughter cells.
-    std::vector<double> masses;      // Masses of the nodes that terminate in this cell.
-    std::vector<Vector> positions;   // Positions of the nodes that terminate in this cell.
-    std::vector<Vector> velocities;  // Velocities of the nodes that terminate in this cell.
-
-    // Convenience constructors for TreeGravity::addNodeToTree.
-    Cell(): M(0.0), Mglobal(0.0), xcm(), vcm(), rcm2cc2(0.0), key(0), daughters(), daughterPtrs(), masses(), positions(), velocities() {}
-    Cell(const double mi, const Vector& xi, const Vector& vi, const CellKey& keyi):
-      M(mi), Mglobal(mi), xcm(xi), vcm(vi), rcm2cc2(0.0), key(keyi), daughters(), daughterPtrs(), masses(1, mi), positions(1, xi), velocities(1, vi) {}
-    Cell(const double mi, const Vector& xi, const Vector& vi, const CellKey& keyi, const CellKey& daughter):
-      M(mi), Mglobal(mi), xcm(xi), vcm(vi), rcm2cc2(0.0), key(keyi), daughters(1, daughter), daughterPtrs(), masses(), positions(), velocities() {}
-
-    // Throw in comparison operators for help sorting.
-    bool operator==(const Cell& rhs) const { return key == rhs.key; }
-    bool operator<(const Cell& rhs) const { return key < rhs.key; }
+    SymTensor S;                     // second moment of the mass about xcm: sum m (x - xcm)(x - xcm)
+    double rmax;                     // radius about xcm enclosing all the nodes in the cell
+    CellKey key;                     // Morton key for this cell on its level
+    LevelKey level;                  // level of this cell
+    uint32_t firstDaughter;          // index of the first daughter cell
+    uint32_t numDaughters;           // number of daughter cells (0 for leaves)
+    uint32_t firstNode;              // index of the first node in this cell
+    uint32_t numNodes;               // number of nodes in this cell
+
+    Cell(): M(0.0), xcm(), vcm(), S(), rmax(0.0), key(0), level(0), firstDaughter(0), numDaughters(0), firstNode(0), numNodes(0) {}
+  };
+
+  //----------------------------------------------------------------------------
+  // Tree is the flat cell array plus the nodes the leaves refer to.
+  //----------------------------------------------------------------------------
+  struct Tree {
+    std::vector<Cell> cells;         // cells[0] is the root
+    std::vector<double> masses;      // node masses, sorted by Morton key
+    std::vector<Vector> positions;   // node positions, sorted by Morton key
+    std::vector<NodeID> nodeIDs;     // (NodeList, node) for each node (local tree only)
+  };
+
+  //----------------------------------------------------------------------------
+  // The far field of a set of source cells expanded to first order about a
+  // cell center of mass:  phi(x) = phi - a.(x - xcm), a(x) = a + J.(x - xcm).
+  //----------------------------------------------------------------------------
+  struct LocalExpansion {
+    double phi;
+    Vector a;
+    SymTensor J;
+    LocalExpansion(): phi(0.0), a(), J() {}
   };
 
-  // Define the types we use to build the tree.
-  typedef boost::unordered_map<CellKey, Cell> TreeLevel;
-  typedef std::vector<TreeLevel> Tree;
+  typedef std::vector<std::pair<double, Vector> > InteractionBuckets;
 
   // Private data.
   double mG, mSofteningLength, mOpening2, mftimestep, mBoxLength;
@@ -195,41 +220,47 @@ private:
   // Assignment operator -- disabled.
   TreeGravity& operator=(const TreeGravity&);
 
-  // Build a cell key based on a level and position.
-  void buildCellKey(const LevelKey ilevel,
-                    const Vector& xi,
-                    CellKey& key,
-                    CellKey& ix,
-                    CellKey& iy,
-                    CellKey& iz) const;
-
-  // Extract the individual coordinate indices from a cell key.
-  void extractCellIndices(const CellKey& key,
-                          CellKey& ix,
-                          CellKey& iy,
-                          CellKey& iz) const;
-
-  // Add a cell key to the daughters of a cell.
-  void addDaughter(Cell& cell, const CellKey daughterKey) const;
-
-  // Add a node to the internal tree.
-  void addNodeToTree(const double mi,
-                     const Vector& xi,
-                     const Vector& vi);
-
-  // Construct all the daughterPtrs in a tree.
-  void constructDaughterPtrs(Tree& tree) const;
-
-  // Walk a tree and apply it's forces to a set of points.
-  Scalar applyTreeForces(const Tree& tree,
-                         const FieldList<Dimension, Scalar>& mass,
-                         const FieldList<Dimension, Vector>& position,
-                         FieldList<Dimension, Vector>& DvDt,
-                         FieldList<Dimension, Scalar>& potential,
-                         FieldList<Dimension, std::vector<Scalar> >& interactionMasses,
-                         FieldList<Dimension, std::vector<Vector> >& interactionPositions,
-                         FieldList<Dimension, std::pair<LevelKey, CellKey> >& homeBuckets,
-                         CompletedCellSet& cellsCompleted) const;
+  // The Morton key of a position on the finest level.
+  CellKey mortonKey(const Vector& xi) const;
+
+  // The index of the daughter of a level ilevel cell containing the given key.
+  unsigned daughterIndex(const CellKey key, const LevelKey ilevel) const;
+
+  // Build the internal tree from the local nodes.
+  void buildTree(const FieldList<Dimension, Scalar>& mass,
+                 const FieldList<Dimension, Vector>& position,
+                 const FieldList<Dimension, Vector>& velocity);
+
+  // Walk the cells of the sink (local) tree against a source tree, accumulating
+  // cell-cell interactions into the local expansions of the sink cells and
+  // direct node-node interactions into the sink node accelerations and potentials.
+  void applyTreeForces(const Tree& sourceTree,
+                       std::vector<LocalExpansion>& expansions,
+                       std::vector<Vector>& accel,
+                       std::vector<Scalar>& phi,
+                       std::vector<InteractionBuckets>& buckets) const;
+
+  // Push the local expansions down the local tree to the nodes.
+  void evaluateExpansions(const unsigned icell,
+                          const LocalExpansion& parentExpansion,
+                          const Vector& parentCenter,
+                          const std::vector<LocalExpansion>& expansions,
+                          const std::vector<InteractionBuckets>& buckets,
+                          InteractionBuckets& pathBuckets,
+                          std::vector<Vector>& accel,
+                          std::vector<Scalar>& phi,
+                          FieldList<Dimension, std::vector<Scalar> >& interactionMasses,
+                          FieldList<Dimension, std::vector<Vector> >& interactionPositions) const;
+
+  // Extract the locally essential part of our tree for a domain with the given
+  // bounding box:  the cells that domain's tree walk may open, with everything
+  // beyond them pruned.
+  void buildLocallyEssentialTree(const Vector& xmin,
+                                 const Vector& xmax,
+                                 Tree& result) const;
+
+  // The cells of the local tree we divide the tree walk into for threading.
+  std::vector<unsigned> taskCells() const;
 
   // Methods to help serializing/deserializing Trees to buffers of char.
   void serialize(const Tree& tree, std::vector<char>& buffer) const;
@@ -72,7 +72,7 @@ update(const KeyType& key,
     const EquationOfState<Dimension>& eos = fluidNodeListPtr->equationOfState();
 
     // Now set the pressure for this field.
-    eos.setPressure(*pressure[i], *massDensity[i], *energy[i]);
+    eos.setState(pressure[i], nullptr, nullptr, nullptr, nullptr, *massDensity[i], *energy[i]);
   }
 }
 
@@ -167,11 +167,11 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
 
       // Find the neighbors for this node.
       // Note that we only want neighbors from the same NodeList...
-      const vector<int>& neighbors = connectivityMap.connectivityForNode(nodeListPtr, i)[iNodeList];
+      const auto neighbors = connectivityMap.connectivityForNode(nodeListPtr, i)[iNodeList];
 
       // Iterate over the neighbors, and build up the vote for the hourglass motion
       Vector hg;
-      for (vector<int>::const_iterator jItr = neighbors.begin();
+      for (auto jItr = neighbors.begin();
            jItr != neighbors.end();
            ++jItr) {
         const int j = *jItr;
@@ -72,7 +72,7 @@ update(const KeyType& key,
     const EquationOfState<Dimension>& eos = fluidNodeListPtr->equationOfState();
 
     // Now set the soundSpeed for this field.
-    eos.setSoundSpeed(*soundSpeed[i], *massDensity[i], *energy[i]);
+    eos.setState(nullptr, soundSpeed[i], nullptr, nullptr, nullptr, *massDensity[i], *energy[i]);
   }
 }
 
@@ -114,7 +114,7 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
       const int i = *iItr;
       const Vector& ri = position(nodeListi, i);
       const SymTensor& Hi = H(nodeListi, i);
-      const vector< vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
       CHECK(fullConnectivity.size() == numNodeLists);
 
       // Iterate over the neighboring NodeLists.
@@ -122,12 +122,12 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
 
         // Connectivity of this node with this NodeList.  We only need to proceed if
         // there are some nodes in this list.
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
+        const auto connectivity = fullConnectivity[nodeListj];
         if (connectivity.size() > 0) {
           const int firstGhostNodej = nodeLists[nodeListj]->firstGhostNode();
 
           // Iterate over the neighbors in this NodeList.
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             const int j = *jItr;
@@ -195,7 +195,7 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
       const SymTensor& Hi = H(nodeListi, i);
       const ThirdRankTensor& Ti = mThirdMoment(nodeListi, i);
       const Scalar Hdeti = Hi.Determinant();
-      const vector< vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
       vector<Vector>& pairAccelerationsi = pairAccelerations(nodeListi, i);
       CHECK(rhoi > 0.0);
       CHECK(fullConnectivity.size() == numNodeLists);
@@ -205,12 +205,12 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
 
         // Connectivity of this node with this NodeList.  We only need to proceed if
         // there are some nodes in this list.
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
+        const auto connectivity = fullConnectivity[nodeListj];
         if (connectivity.size() > 0) {
           const int firstGhostNodej = nodeLists[nodeListj]->firstGhostNode();
 
           // Iterate over the neighbors in this NodeList.
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             const int j = *jItr;
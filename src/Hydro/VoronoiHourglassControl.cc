@@ -288,11 +288,11 @@ finalize(const typename Dimension::Scalar time,
         Bi = mB(nodeListi, i);
         gradAi = mGradA(nodeListi, i);
         gradBi = mGradB(nodeListi, i);
-        const vector<vector<int> >& fullConnectivity = cm.connectivityForNode(nodeListi, i);
+        const auto fullConnectivity = cm.connectivityForNode(nodeListi, i);
         CHECK(fullConnectivity.size() == numNodeLists);
         for (nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
-          const vector<int>& connectivity = fullConnectivity[nodeListj];
-          for (vector<int>::const_iterator jItr = connectivity.begin();
+          const auto connectivity = fullConnectivity[nodeListj];
+          for (auto jItr = connectivity.begin();
                jItr != connectivity.end();
                ++jItr) {
             j = *jItr;
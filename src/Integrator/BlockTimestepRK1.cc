@@ -0,0 +1,355 @@
+//---------------------------------Spheral++----------------------------------//
+// BlockTimestepRK1 -- Advance the set of Physics packages in time using
+// hierarchical individual (block) timesteps.
+//----------------------------------------------------------------------------//
+#include "DataOutput/Restart.hh"
+#include "BlockTimestepRK1.hh"
+#include "DataBase/DataBase.hh"
+#include "DataBase/State.hh"
+#include "DataBase/StateDerivatives.hh"
+#include "Field/FieldList.hh"
+#include "Field/FieldBase.hh"
+#include "NodeList/NodeList.hh"
+#include "Physics/Physics.hh"
+#include "Hydro/HydroFieldNames.hh"
+#include "Neighbor/ConnectivityMap.hh"
+#include "Utilities/allReduce.hh"
+#include "Utilities/Process.hh"
+#include "Distributed/Communicator.hh"
+#include "Utilities/DBC.hh"
+
+#include <map>
+#include <algorithm>
+
+using std::vector;
+using std::map;
+using std::string;
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::min;
+using std::max;
+using std::abs;
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Empty constructor.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+BlockTimestepRK1<Dimension>::BlockTimestepRK1():
+  Integrator<Dimension>(),
+  mMaxRung(8),
+  mLastNumRungs(0),
+  mMaxDrift(0.1),
+  mLastWorkFraction(1.0) {
+}
+
+//------------------------------------------------------------------------------
+// Construct with the given DataBase.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+BlockTimestepRK1<Dimension>::
+BlockTimestepRK1(DataBase<Dimension>& dataBase):
+  Integrator<Dimension>(dataBase),
+  mMaxRung(8),
+  mLastNumRungs(0),
+  mMaxDrift(0.1),
+  mLastWorkFraction(1.0) {
+}
+
+//------------------------------------------------------------------------------
+// Construct with the given DataBase and Physics packages.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+BlockTimestepRK1<Dimension>::
+BlockTimestepRK1(DataBase<Dimension>& dataBase,
+                 const vector<Physics<Dimension>*>& physicsPackages):
+  Integrator<Dimension>(dataBase, physicsPackages),
+  mMaxRung(8),
+  mLastNumRungs(0),
+  mMaxDrift(0.1),
+  mLastWorkFraction(1.0) {
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+//------------------------------------------------------------------------------
+template<typename Dimension>
+BlockTimestepRK1<Dimension>::~BlockTimestepRK1() {
+}
+
+//------------------------------------------------------------------------------
+// Assignment
+//------------------------------------------------------------------------------
+template<typename Dimension>
+BlockTimestepRK1<Dimension>&
+BlockTimestepRK1<Dimension>::
+operator=(const BlockTimestepRK1<Dimension>& rhs) {
+  if (this != &rhs) {
+    Integrator<Dimension>::operator=(rhs);
+    mMaxRung = rhs.mMaxRung;
+    mLastNumRungs = rhs.mLastNumRungs;
+    mMaxDrift = rhs.mMaxDrift;
+    mLastWorkFraction = rhs.mLastWorkFraction;
+  }
+  return *this;
+}
+
+//------------------------------------------------------------------------------
+// Take a step.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+BlockTimestepRK1<Dimension>::
+step(typename Dimension::Scalar maxTime,
+     State<Dimension>& state,
+     StateDerivatives<Dimension>& derivs) {
+
+  // Get the current time and data base.
+  const Scalar t0 = this->currentTime();
+  DataBase<Dimension>& db = this->accessDataBase();
+  const auto numNodeLists = db.numFluidNodeLists();
+
+  // Initalize the integrator.
+  this->preStepInitialize(state, derivs);
+
+  // Get the per node timestep votes, based on the current state and the last
+  // derivatives (just as the synchronous integrators do with selectDt).
+  const Scalar dtMin = min(this->dtMin(), maxTime - t0);
+  const Scalar dtMax = min(this->dtMax(), maxTime - t0);
+  auto dtNode = db.newFluidFieldList(dtMax, "block timestep");
+  this->nodeTimesteps(t0, dtMin, dtMax, state, derivs, dtNode);
+
+  // The block step is the largest node timestep, reduced if necessary so that
+  // every node can be accommodated within maxRung halvings.
+  auto dtNodeMin = dtMax, dtNodeMax = dtMin;
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto n = dtNode[nodeListi]->numInternalElements();
+    for (auto i = 0u; i < n; ++i) {
+      dtNodeMin = min(dtNodeMin, dtNode(nodeListi, i));
+      dtNodeMax = max(dtNodeMax, dtNode(nodeListi, i));
+    }
+  }
+  dtNodeMin = allReduce(dtNodeMin, MPI_MIN, Communicator::communicator());
+  dtNodeMax = allReduce(dtNodeMax, MPI_MAX, Communicator::communicator());
+  auto dtBlock = min(dtNodeMax, this->dtGrowth()*this->lastDt());
+  dtBlock = min(dtBlock, dtNodeMin*double(1u << mMaxRung));
+  dtBlock = min(dtMax, max(dtMin, dtBlock));
+  CHECK(dtBlock > 0.0);
+
+  // Assign the rungs, and find the finest rung anyone needs.
+  auto rungs = db.newFluidFieldList(0, "block timestep rung");
+  auto active = db.newFluidFieldList(0, "block timestep active");
+  int R = 0;
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto n = rungs[nodeListi]->numInternalElements();
+    for (auto i = 0u; i < n; ++i) {
+      rungs(nodeListi, i) = this->rung(dtBlock, dtNode(nodeListi, i));
+      R = max(R, rungs(nodeListi, i));
+    }
+  }
+  R = allReduce(R, MPI_MAX, Communicator::communicator());
+  const int nsub = 1 << R;
+  const Scalar dts = dtBlock/nsub;
+
+  // We need the NodeList index of the fluid NodeLists, and the others (which
+  // are advanced on the finest rung).
+  map<const NodeList<Dimension>*, unsigned> nodeListIndex;
+  {
+    auto k = 0u;
+    for (auto itr = db.fluidNodeListBegin(); itr != db.fluidNodeListEnd(); ++itr, ++k) nodeListIndex[*itr] = k;
+  }
+  vector<const NodeList<Dimension>*> otherNodeLists;
+  for (auto itr = db.nodeListBegin(); itr != db.nodeListEnd(); ++itr) {
+    if (nodeListIndex.find(*itr) == nodeListIndex.end()) otherNodeLists.push_back(*itr);
+  }
+
+  // The distance each node has drifted (in units of its smoothing scale) since
+  // the ghost nodes and connectivity were last rebuilt.
+  auto drift = db.newFluidFieldList(0.0, "block timestep drift");
+  auto driftMax = 0.0;
+
+  // Walk the substeps.
+  double numNodeAdvances = 0.0, numNodes = 0.0;
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) numNodes += rungs[nodeListi]->numInternalElements();
+  for (auto isub = 0; isub < nsub; ++isub) {
+    const auto t = t0 + isub*dts;
+
+    // Rebuild the ghost nodes and connectivity once the nodes have drifted
+    // far enough, otherwise just let the packages prepare for the substep.
+    if (isub > 0) {
+      if (driftMax > mMaxDrift) {
+        this->preStepInitialize(state, derivs);
+        drift = 0.0;
+        driftMax = 0.0;
+      } else {
+        for (auto physicsItr = this->physicsPackagesBegin(); physicsItr != this->physicsPackagesEnd(); ++physicsItr) {
+          (*physicsItr)->preStepInitialize(db, state, derivs);
+        }
+      }
+    }
+
+    // Flag the nodes that are due on this substep.
+    for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+      const auto n = rungs[nodeListi]->numInternalElements();
+      for (auto i = 0u; i < n; ++i) active(nodeListi, i) = (isub % (nsub >> rungs(nodeListi, i)) == 0 ? 1 : 0);
+    }
+
+    // Evaluate the derivatives for the active nodes.  Everyone is active at the
+    // beginning of the block.  The NodePairList stays restricted through the
+    // state update, since some policies (such as the compatible energy) walk
+    // the pairs along with pairwise derivatives.
+    this->initializeDerivatives(t, dts, state, derivs);
+    derivs.Zero();
+    if (isub > 0) this->accessConnectivityMap().restrictNodePairs(active);
+    this->evaluateDerivatives(t, dts, db, state, derivs);
+    this->finalizeDerivatives(t, dts, db, state, derivs);
+
+    // Let the active nodes change rungs based on the new derivatives.  A node
+    // can always move to a finer rung, but can only move to a coarser rung when
+    // we're synchronized with it.  Either way the new rung is due now.
+    for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+      const auto n = dtNode[nodeListi]->numInternalElements();
+      for (auto i = 0u; i < n; ++i) dtNode(nodeListi, i) = (active(nodeListi, i) == 1 ? dtMax : 0.0);
+    }
+    this->nodeTimesteps(t, dtMin, dtMax, state, derivs, dtNode);
+    vector<vector<vector<int>>> ids(R + 1, vector<vector<int>>(numNodeLists));
+    for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+      const auto n = rungs[nodeListi]->numInternalElements();
+      for (auto i = 0u; i < n; ++i) {
+        if (active(nodeListi, i) == 1) {
+          auto& ri = rungs(nodeListi, i);
+          const auto rnew = min(R, int(this->rung(dtBlock, dtNode(nodeListi, i))));
+          if (rnew > ri) {
+            ri = rnew;
+          } else if (rnew < ri and isub % (nsub >> (ri - 1)) == 0) {
+            --ri;
+          }
+          ids[ri][nodeListi].push_back(i);
+          numNodeAdvances += 1.0;
+        }
+      }
+    }
+
+    // The positions are advanced by the drift below, so remember the values
+    // the rung updates are going to overwrite.
+    auto position = state.fields(HydroFieldNames::position, Vector::zero);
+    const auto numPositionFields = position.numFields();
+    vector<vector<int>> positionIDs(numPositionFields);
+    vector<vector<char>> position0(numPositionFields);
+    for (auto k = 0u; k < numPositionFields; ++k) {
+      const auto itr = nodeListIndex.find(position[k]->nodeListPtr());
+      if (itr != nodeListIndex.end()) {
+        for (auto r = 0; r <= R; ++r) positionIDs[k].insert(positionIDs[k].end(), ids[r][itr->second].begin(), ids[r][itr->second].end());
+      } else {
+        positionIDs[k].resize(position[k]->numInternalElements());
+        for (auto i = 0u; i < positionIDs[k].size(); ++i) positionIDs[k][i] = i;
+      }
+      if (not positionIDs[k].empty()) position0[k] = position[k]->packValues(positionIDs[k]);
+    }
+
+    // Advance the nodes on each rung due on this substep by that rung's step,
+    // restricting the update to those nodes.  The rungs don't share nodes, so
+    // each advances from the beginning of substep state without our having to
+    // copy it.  We loop over the rungs due globally so every domain fires the
+    // same sequence of policies.
+    map<const NodeList<Dimension>*, vector<int>> rungIDs;
+    for (auto r = 0; r <= R; ++r) {
+      if (isub % (nsub >> r) == 0) {
+        const Scalar dtr = dtBlock/(1 << r);
+        rungIDs.clear();
+        for (const auto& x: nodeListIndex) rungIDs[x.first] = ids[r][x.second];
+        if (r < R) {
+          for (const auto* nodeListPtr: otherNodeLists) rungIDs[nodeListPtr] = vector<int>();
+        }
+        state.restrictUpdate(rungIDs);
+        state.update(derivs, dtr, t, dtr);
+      }
+    }
+    state.unrestrictUpdate();
+    if (isub > 0) this->accessConnectivityMap().unrestrictNodePairs();
+    for (auto k = 0u; k < numPositionFields; ++k) {
+      if (not positionIDs[k].empty()) position[k]->unpackValues(positionIDs[k], position0[k]);
+    }
+
+    // Drift all the positions.
+    {
+      const auto velocity = state.fields(HydroFieldNames::velocity, Vector::zero);
+      for (auto k = 0u; k < numPositionFields; ++k) {
+        const auto n = position[k]->numInternalElements();
+#pragma omp parallel for
+        for (auto i = 0u; i < n; ++i) position(k, i) += dts*velocity(k, i);
+      }
+    }
+
+    // Keep track of how far the nodes have drifted.
+    {
+      const auto velocity = db.fluidVelocity();
+      const auto H = db.fluidHfield();
+      for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+        const auto n = drift[nodeListi]->numInternalElements();
+        for (auto i = 0u; i < n; ++i) {
+          drift(nodeListi, i) += dts*(H(nodeListi, i)*velocity(nodeListi, i)).magnitude();
+          driftMax = max(driftMax, drift(nodeListi, i));
+        }
+      }
+      driftMax = allReduce(driftMax, MPI_MAX, Communicator::communicator());
+    }
+
+    // Finish the substep.
+    this->currentTime(t + dts);
+    this->applyGhostBoundaries(state, derivs);
+    this->postStateUpdate(t + dts, dts, db, state, derivs);
+    this->finalizeGhostBoundaries();
+    this->enforceBoundaries(state, derivs);
+  }
+
+  // Apply any physics specific finalizations.
+  this->currentTime(t0 + dtBlock);
+  this->postStepFinalize(t0 + dtBlock, dtBlock, state, derivs);
+
+  // Record what we did.
+  numNodeAdvances = allReduce(numNodeAdvances, MPI_SUM, Communicator::communicator());
+  numNodes = allReduce(numNodes, MPI_SUM, Communicator::communicator());
+  mLastNumRungs = R + 1;
+  mLastWorkFraction = (numNodes > 0.0 ? numNodeAdvances/(numNodes*nsub) : 1.0);
+  if (this->verbose() and Process::getRank() == 0) {
+    cout << "BlockTimestepRK1: dt = " << dtBlock << " in " << nsub << " substeps over "
+         << mLastNumRungs << " rungs, work fraction " << mLastWorkFraction << endl;
+  }
+
+  // Set the new current time and last time step.
+  this->currentCycle(this->currentCycle() + 1);
+  this->lastDt(dtBlock);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Collect the per node timestep votes from the physics packages.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+BlockTimestepRK1<Dimension>::
+nodeTimesteps(const Scalar t,
+              const Scalar dtMin,
+              const Scalar dtMax,
+              const State<Dimension>& state,
+              const StateDerivatives<Dimension>& derivs,
+              FieldList<Dimension, Scalar>& dt) const {
+  const auto& db = this->dataBase();
+  for (auto physicsItr = this->physicsPackagesBegin(); physicsItr != this->physicsPackagesEnd(); ++physicsItr) {
+    (*physicsItr)->nodeTimesteps(db, state, derivs, t, dt);
+  }
+
+  // Enforce the timestep boundaries.
+  const auto numNodeLists = dt.numFields();
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto n = dt[nodeListi]->numInternalElements();
+    for (auto i = 0u; i < n; ++i) {
+      if (dt(nodeListi, i) > 0.0) dt(nodeListi, i) = min(dtMax, max(dtMin, dt(nodeListi, i)));
+    }
+  }
+}
+
+}
@@ -0,0 +1,118 @@
+//---------------------------------Spheral++----------------------------------//
+// BlockTimestepRK1 -- Advance the set of Physics packages in time using
+// hierarchical individual (block) timesteps.
+//
+// Each call to step advances the problem by a block timestep dt.  Every node
+// is assigned a rung r, and is advanced in kicks of dt/2^r, so the nodes
+// requiring the smallest timesteps (in shocks, bound clumps, etc.) no longer
+// force the entire problem to take their step.  The block is broken into
+// 2^R substeps for the finest rung R in use; on each substep only the nodes
+// whose rung is due (active nodes) have their derivatives evaluated -- the
+// ConnectivityMap NodePairList is restricted to pairs involving active nodes
+// -- and have their state advanced with forward Euler over their rung step,
+// with the State update restricted to them (State::restrictUpdate).  All nodes
+// drift their positions with their current velocity every substep.  Rather
+// than rebuilding the ghost nodes and connectivity every substep, we rebuild
+// them once some node has drifted more than maxDrift (in units of its
+// smoothing scale) since the last rebuild.
+//
+// The remaining per substep work over all the nodes is the drift itself, and
+// any update policies that can't be restricted to the active nodes (such as
+// the equations of state), for which State::update restores the values of the
+// inactive nodes after they fire.
+//
+// Nodes are placed on rungs according to the per node timestep votes of the
+// physics packages (Physics::nodeTimesteps).  An active node may move to a
+// finer rung on any substep, but only to a coarser rung (one at a time) when
+// the substep is aligned with that coarser step.  Fields on non-fluid
+// NodeLists are advanced on the finest rung.
+//
+// Note that packages which distribute pairwise work to both nodes of a pair
+// (such as the compatible energy discretization) can only conserve exactly
+// when both nodes are active, as is the case for all block timestep schemes.
+//----------------------------------------------------------------------------//
+#ifndef BlockTimestepRK1_HH
+#define BlockTimestepRK1_HH
+
+#include "Integrator.hh"
+
+#include <vector>
+
+namespace Spheral {
+
+template<typename Dimension>
+class BlockTimestepRK1: public Integrator<Dimension> {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  typedef typename Dimension::Scalar Scalar;
+  typedef typename Dimension::Vector Vector;
+  typedef typename Dimension::Tensor Tensor;
+  typedef typename Dimension::SymTensor SymTensor;
+
+  // Constructors.
+  BlockTimestepRK1();
+  BlockTimestepRK1(DataBase<Dimension>& dataBase);
+  BlockTimestepRK1(DataBase<Dimension>& dataBase,
+                   const std::vector<Physics<Dimension>*>& physicsPackages);
+
+  // Destructor.
+  ~BlockTimestepRK1();
+
+  // Assignment.
+  BlockTimestepRK1& operator=(const BlockTimestepRK1& rhs);
+
+  // All Integrators are required to provide the single cycle method.
+  virtual bool step(Scalar maxTime,
+                    State<Dimension>& state,
+                    StateDerivatives<Dimension>& derivs) override;
+
+  // We need to make the simpler form of step visible!
+  using Integrator<Dimension>::step;
+
+  // The maximum rung allowed, i.e., the smallest node timestep is dt/2^maxRung.
+  unsigned maxRung() const;
+  void maxRung(const unsigned x);
+
+  // The distance (in units of h) any node may drift before the ghost nodes
+  // and connectivity are rebuilt on a substep.  Zero rebuilds every substep.
+  double maxDrift() const;
+  void maxDrift(const double x);
+
+  // Diagnostics from the last step: the number of rungs used, and the number
+  // of node advances relative to advancing every node on every substep.
+  unsigned lastNumRungs() const;
+  double lastWorkFraction() const;
+
+  // Restart methods.
+  virtual std::string label() const override { return "BlockTimestepRK1"; }
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  unsigned mMaxRung, mLastNumRungs;
+  double mMaxDrift, mLastWorkFraction;
+
+  // Collect the per node timestep votes of the physics packages into dt.
+  // Nodes with dt <= 0 on input are skipped.
+  void nodeTimesteps(const Scalar t,
+                     const Scalar dtMin,
+                     const Scalar dtMax,
+                     const State<Dimension>& state,
+                     const StateDerivatives<Dimension>& derivs,
+                     FieldList<Dimension, Scalar>& dt) const;
+
+  // The rung (<= maxRung) required for a node timestep dtNode in a block of dtBlock.
+  unsigned rung(const Scalar dtBlock, const Scalar dtNode) const;
+};
+
+}
+
+#include "BlockTimestepRK1Inline.hh"
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  template<typename Dimension> class BlockTimestepRK1;
+}
+
+#endif
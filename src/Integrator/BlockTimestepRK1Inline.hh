@@ -0,0 +1,83 @@
+#include "Utilities/DBC.hh"
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// The maximum rung.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+unsigned
+BlockTimestepRK1<Dimension>::
+maxRung() const {
+  return mMaxRung;
+}
+
+template<typename Dimension>
+inline
+void
+BlockTimestepRK1<Dimension>::
+maxRung(const unsigned x) {
+  VERIFY2(x < 31, "BlockTimestepRK1 ERROR: maxRung must be less than 31 : " << x);
+  mMaxRung = x;
+}
+
+//------------------------------------------------------------------------------
+// The drift allowed between rebuilds of the ghost nodes and connectivity.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+double
+BlockTimestepRK1<Dimension>::
+maxDrift() const {
+  return mMaxDrift;
+}
+
+template<typename Dimension>
+inline
+void
+BlockTimestepRK1<Dimension>::
+maxDrift(const double x) {
+  VERIFY2(x >= 0.0, "BlockTimestepRK1 ERROR: maxDrift must be non-negative : " << x);
+  mMaxDrift = x;
+}
+
+//------------------------------------------------------------------------------
+// Diagnostics from the last step.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+unsigned
+BlockTimestepRK1<Dimension>::
+lastNumRungs() const {
+  return mLastNumRungs;
+}
+
+template<typename Dimension>
+inline
+double
+BlockTimestepRK1<Dimension>::
+lastWorkFraction() const {
+  return mLastWorkFraction;
+}
+
+//------------------------------------------------------------------------------
+// The rung required for the given node timestep.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+unsigned
+BlockTimestepRK1<Dimension>::
+rung(const typename Dimension::Scalar dtBlock,
+     const typename Dimension::Scalar dtNode) const {
+  if (dtNode <= 0.0) return mMaxRung;
+  unsigned result = 0u;
+  auto dtr = dtBlock;
+  while (result < mMaxRung and dtr > (1.0 + 1.0e-10)*dtNode) {
+    dtr *= 0.5;
+    ++result;
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,11 @@
+text = """
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "Integrator/BlockTimestepRK1.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+  template class BlockTimestepRK1< Dim< %(ndim)s > >;
+}
+"""
@@ -122,7 +122,7 @@ step(typename Dimension::Scalar maxTime,
   // Copy the beginning of step state.
   TIME_CheapRK2CopyState.start();
   State<Dimension> state0(state);
-  state0.copyState();
+  state0.copyState(this->snapshotPool());
   TIME_CheapRK2CopyState.stop();
 
   // Trial advance the state to the mid timestep point.
@@ -150,7 +150,7 @@ step(typename Dimension::Scalar maxTime,
                                       state,
                                       derivs);
     if (dtnew < 0.5*dt) {
-      state.assign(state0);
+      state.swapState(state0);
       return false;
     }
   }
@@ -159,7 +159,7 @@ step(typename Dimension::Scalar maxTime,
   TIME_CheapRK2EndStep.start();
   state.timeAdvanceOnly(false);
   //this->copyGhostState(state, state0);
-  state.assign(state0);
+  state.swapState(state0);
   state.update(derivs, dt, t, dt);
   this->currentTime(t + dt);
   this->applyGhostBoundaries(state, derivs);
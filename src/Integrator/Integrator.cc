@@ -14,7 +14,7 @@
 #include "Physics/Physics.hh"
 #include "Boundary/Boundary.hh"
 #include "Hydro/HydroFieldNames.hh"
-// #include "Utilities/timingUtilities.hh"
+#include "Utilities/timingUtilities.hh"
 #include "Neighbor/ConnectivityMap.hh"
 #include "Utilities/allReduce.hh"
 #include "Distributed/Communicator.hh"
@@ -37,6 +37,55 @@ using std::abs;
 
 namespace Spheral {
 
+namespace {
+
+//------------------------------------------------------------------------------
+// The sum of the work on the internal nodes of the DataBase.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+double
+localWork(const DataBase<Dimension>& dataBase) {
+  auto result = 0.0;
+  for (auto itr = dataBase.nodeListBegin(); itr < dataBase.nodeListEnd(); ++itr) {
+    const auto& work = (*itr)->work();
+    const auto n = (*itr)->numInternalNodes();
+    for (auto i = 0u; i < n; ++i) result += work(i);
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Spread a measured time over the internal nodes of the DataBase, in
+// proportion to the given per node weights (if any are nonzero) or uniformly
+// otherwise.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+distributeWork(const DataBase<Dimension>& dataBase,
+               const double elapsed,
+               const vector<vector<double>>& weights) {
+  if (elapsed <= 0.0) return;
+  const auto numNodeLists = dataBase.numNodeLists();
+  CHECK(weights.empty() or weights.size() == numNodeLists);
+  auto weightSum = 0.0;
+  for (const auto& weightsi: weights) {
+    for (const auto w: weightsi) weightSum += w;
+  }
+  const auto uniform = (weightSum == 0.0);
+  if (uniform) weightSum = double(dataBase.numInternalNodes());
+  if (weightSum == 0.0) return;
+  const auto scale = elapsed/weightSum;
+  for (auto nodeListi = 0u; nodeListi != numNodeLists; ++nodeListi) {
+    const auto& nodeList = **(dataBase.nodeListBegin() + nodeListi);
+    auto& work = nodeList.work();
+    const auto n = nodeList.numInternalNodes();
+    CHECK(uniform or weights[nodeListi].size() == n);
+    for (auto i = 0u; i < n; ++i) work(i) += scale*(uniform ? 1.0 : weights[nodeListi][i]);
+  }
+}
+
+}
+
 //------------------------------------------------------------------------------
 // Empty constructor.
 //------------------------------------------------------------------------------
@@ -60,6 +109,10 @@ Integrator<Dimension>::Integrator():
   mPhysicsPackages(0),
   mRigorousBoundaries(false),
   mCullGhostNodes(true),
+  mOverlapGhostExchange(true),
+  mMeasureWork(false),
+  mCachePairGeometry(false),
+  mSnapshotPool(new typename StateBase<Dimension>::SnapshotPoolType()),
   mRestart(registerWithRestart(*this)) {
 }
 
@@ -87,6 +140,10 @@ Integrator(DataBase<Dimension>& dataBase):
   mPhysicsPackages(0),
   mRigorousBoundaries(false),
   mCullGhostNodes(true),
+  mOverlapGhostExchange(true),
+  mMeasureWork(false),
+  mCachePairGeometry(false),
+  mSnapshotPool(new typename StateBase<Dimension>::SnapshotPoolType()),
   mRestart(registerWithRestart(*this)) {
 }
 
@@ -114,6 +171,10 @@ Integrator(DataBase<Dimension>& dataBase,
   mPhysicsPackages(physicsPackages),
   mRigorousBoundaries(false),
   mCullGhostNodes(true),
+  mOverlapGhostExchange(true),
+  mMeasureWork(false),
+  mCachePairGeometry(false),
+  mSnapshotPool(new typename StateBase<Dimension>::SnapshotPoolType()),
   mRestart(registerWithRestart(*this)) {
 }
 
@@ -145,6 +206,9 @@ operator=(const Integrator<Dimension>& rhs) {
     mRigorousBoundaries = rhs.mRigorousBoundaries;
     mUpdateBoundaryFrequency = rhs.mUpdateBoundaryFrequency;
     mCullGhostNodes = rhs.mCullGhostNodes;
+    mOverlapGhostExchange = rhs.mOverlapGhostExchange;
+    mMeasureWork = rhs.mMeasureWork;
+    mCachePairGeometry = rhs.mCachePairGeometry;
     mVerbose = rhs.mVerbose;
     mAllowDtCheck = rhs.mAllowDtCheck;
     mRequireConnectivity = rhs.mRequireConnectivity;
@@ -164,6 +228,16 @@ step(const typename Dimension::Scalar maxTime) {
   DataBase<Dimension>& db = this->accessDataBase();
   State<Dimension> state(db, this->physicsPackagesBegin(), this->physicsPackagesEnd());
   StateDerivatives<Dimension> derivs(db, this->physicsPackagesBegin(), this->physicsPackagesEnd());
+
+  // If we're measuring the work, start the NodeList work fields from zero
+  // and time the whole step.  The packages and state updates attribute what
+  // they can to specific nodes as we go.
+  if (mMeasureWork) {
+    for (auto itr = db.nodeListBegin(); itr < db.nodeListEnd(); ++itr) (*itr)->work() = 0.0;
+    state.measureWork(true);
+  }
+  const auto start = Timing::currentTime();
+
   auto success = false;
   auto count = 0;
   auto maxIterations = 10;
@@ -180,6 +254,14 @@ step(const typename Dimension::Scalar maxTime) {
     }
   }
   mDtMultiplier = 1.0;
+
+  // Whatever time we couldn't attribute to particular nodes (timestep
+  // selection, boundary conditions, global state updates, etc.) is spread
+  // uniformly, so the sum of the work on this domain is its measured step time.
+  if (mMeasureWork) {
+    const auto elapsed = Timing::difference(start, Timing::currentTime());
+    distributeWork(db, elapsed - localWork(db), vector<vector<double>>());
+  }
   return success;
 }
 
@@ -294,12 +376,15 @@ Integrator<Dimension>::initializeDerivatives(const double t,
                                              State<Dimension>& state,
                                              StateDerivatives<Dimension>& derivs) {
 
-  // Initialize the work fields.
+  // Initialize the work fields, unless we're accumulating the measured work
+  // over the whole step.
   DataBase<Dimension>& db = accessDataBase();
-  for (typename DataBase<Dimension>::NodeListIterator nodeListItr = db.nodeListBegin();
-       nodeListItr < db.nodeListEnd();
-       ++nodeListItr) {
-    (*nodeListItr)->work() = 0.0;
+  if (not mMeasureWork) {
+    for (typename DataBase<Dimension>::NodeListIterator nodeListItr = db.nodeListBegin();
+         nodeListItr < db.nodeListEnd();
+         ++nodeListItr) {
+      (*nodeListItr)->work() = 0.0;
+    }
   }
 
   // Loop over the physics packages and perform any necessary initializations.
@@ -310,8 +395,18 @@ Integrator<Dimension>::initializeDerivatives(const double t,
   }
 
   // Physics packages may have called boundary conditions as well, so finalize any
-  // outstanding boundary conditions here.
-  this->finalizeGhostBoundaries();
+  // outstanding boundary conditions here.  If we're overlapping that
+  // communication with the derivative evaluation, we just start it and let
+  // evaluateDerivatives complete it once the interior pairs have been done.
+  // The completion happens on the master thread inside the packages' parallel
+  // pair loops, so we only overlap if MPI supports that (MPI_THREAD_FUNNELED).
+  if (mOverlapGhostExchange and mRequireConnectivity and Communicator::funneledThreadSupport()) {
+    this->beginGhostBoundaries();
+    const auto& connectivityMap = db.connectivityMap(mRequireGhostConnectivity, mRequireOverlapConnectivity);
+    connectivityMap.ghostExchangePending([this]() { this->finalizeGhostBoundaries(); });
+  } else {
+    this->finalizeGhostBoundaries();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -325,12 +420,50 @@ Integrator<Dimension>::evaluateDerivatives(const Scalar t,
                                            const State<Dimension>& state,
                                            StateDerivatives<Dimension>& derivs) const {
 
+  // The state is fixed while we evaluate the derivatives, so the packages can
+  // optionally share the per-pair geometry and kernel values.
+  const auto& connectivityMap = dataBase.connectivityMap(mRequireGhostConnectivity, mRequireOverlapConnectivity);
+  auto& pairGeometry = connectivityMap.pairGeometry();
+  pairGeometry.caching(mCachePairGeometry);
+
+  // If we're measuring the work, the cost of the pair based packages is
+  // attributed to the nodes in proportion to the number of pairs they're in.
+  vector<vector<double>> pairCounts;
+  if (mMeasureWork and mRequireConnectivity) {
+    const auto numNodeLists = dataBase.numNodeLists();
+    pairCounts.resize(numNodeLists);
+    for (auto nodeListi = 0u; nodeListi != numNodeLists; ++nodeListi) {
+      pairCounts[nodeListi].resize((*(dataBase.nodeListBegin() + nodeListi))->numInternalNodes(), 0.0);
+    }
+    for (const auto& pair: connectivityMap.nodePairList()) {
+      if (pair.i_node < (int)pairCounts[pair.i_list].size()) pairCounts[pair.i_list][pair.i_node] += 1.0;
+      if (pair.j_node < (int)pairCounts[pair.j_list].size()) pairCounts[pair.j_list][pair.j_node] += 1.0;
+    }
+  }
+
   // Loop over the physics packages and have them evaluate their derivatives.
+  // Any ghost exchange still in flight is completed by the first package that
+  // can't overlap it (if not already by a package that can).
   for (typename Integrator<Dimension>::ConstPackageIterator physicsItr = physicsPackagesBegin();
        physicsItr != physicsPackagesEnd();
        ++physicsItr) {
-    (*physicsItr)->evaluateDerivatives(t, dt, dataBase, state, derivs);
+    if (not (*physicsItr)->overlapGhostExchange()) connectivityMap.completeGhostExchange();
+    if (mMeasureWork) {
+      // Packages that time their own nodes are only charged for the remainder.
+      const auto work0 = localWork(dataBase);
+      const auto start = Timing::currentTime();
+      (*physicsItr)->evaluateDerivatives(t, dt, dataBase, state, derivs);
+      const auto elapsed = Timing::difference(start, Timing::currentTime());
+      distributeWork(dataBase, elapsed - (localWork(dataBase) - work0),
+                     (*physicsItr)->requireConnectivity() ? pairCounts : vector<vector<double>>());
+    } else {
+      (*physicsItr)->evaluateDerivatives(t, dt, dataBase, state, derivs);
+    }
   }
+  connectivityMap.completeGhostExchange();
+
+  // Don't let the cached geometry outlive this evaluation.
+  pairGeometry.caching(false);
 }
 
 //------------------------------------------------------------------------------
@@ -396,6 +529,26 @@ Integrator<Dimension>::postStepFinalize(const double t,
   }
 }
 
+//------------------------------------------------------------------------------
+// Write access to the ConnectivityMap.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+ConnectivityMap<Dimension>&
+Integrator<Dimension>::
+accessConnectivityMap() {
+  return *(this->accessDataBase().connectivityMapPtr(mRequireGhostConnectivity, mRequireOverlapConnectivity));
+}
+
+//------------------------------------------------------------------------------
+// The pool of snapshot Field buffers.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+typename StateBase<Dimension>::SnapshotPoolPtr
+Integrator<Dimension>::
+snapshotPool() const {
+  return mSnapshotPool;
+}
+
 //------------------------------------------------------------------------------
 // Add a physics package.
 //------------------------------------------------------------------------------
@@ -554,10 +707,10 @@ Integrator<Dimension>::setGhostNodes() {
         const auto& nodeList = **nodeListItr;
         for (auto i = 0u; i != nodeList.numInternalNodes(); ++i) {
           flags(nodeListi, i) = 1;
-          const vector<vector<int> >& fullConnectivity = cm.connectivityForNode(&nodeList, i);
+          const auto fullConnectivity = cm.connectivityForNode(&nodeList, i);
           for (auto nodeListj = 0u; nodeListj != fullConnectivity.size(); ++nodeListj) {
-            const vector<int>& connectivity = fullConnectivity[nodeListj];
-            for (vector<int>::const_iterator jItr = connectivity.begin();
+            const auto connectivity = fullConnectivity[nodeListj];
+            for (auto jItr = connectivity.begin();
                  jItr != connectivity.end();
                  ++jItr) flags(nodeListj, *jItr) = 1;
           }
@@ -692,6 +845,20 @@ Integrator<Dimension>::applyGhostBoundaries(State<Dimension>& state,
   this->finalizeGhostBoundaries();
 }
 
+//------------------------------------------------------------------------------
+// Start the communication for the ghost boundary conditions applied so far.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+Integrator<Dimension>::beginGhostBoundaries() {
+  const vector<Boundary<Dimension>*> boundaries = uniqueBoundaryConditions();
+  for (ConstBoundaryIterator boundaryItr = boundaries.begin(); 
+       boundaryItr != boundaries.end();
+       ++boundaryItr) {
+    (*boundaryItr)->beginGhostBoundary();
+  }
+}
+
 //------------------------------------------------------------------------------
 // Finalize the ghost boundary conditions.
 //------------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #define Integrator_HH
 
 #include "DataOutput/registerWithRestart.hh"
+#include "DataBase/StateBase.hh"
 
 #ifdef USE_MPI
 #include "mpi.h"
@@ -25,6 +26,7 @@ template<typename Dimension> class DataBase;
 template<typename Dimension> class Physics;
 template<typename Dimension, typename DataType> class FieldList;
 template<typename Dimension> class Boundary;
+template<typename Dimension> class ConnectivityMap;
 class FileIO;
 
 template<typename Dimension>
@@ -128,7 +130,9 @@ public:
   void applyGhostBoundaries(State<Dimension>& state,
                             StateDerivatives<Dimension>& derivs);
 
-  // Finalize the ghost node boundary conditions.
+  // Start any communication for the ghost node boundary conditions applied so
+  // far, and finalize the ghost node boundary conditions.
+  void beginGhostBoundaries();
   void finalizeGhostBoundaries();
 
   // Find the nodes in violation of the boundary conditions.
@@ -210,6 +214,25 @@ public:
   bool cullGhostNodes() const;
   void cullGhostNodes(bool x);
 
+  // Select whether the ghost communication preceding each derivative evaluation
+  // is overlapped with the evaluation of the interior node pairs, for those
+  // physics packages that support it (Physics::overlapGhostExchange).  This
+  // is quietly skipped when running threaded unless MPI provides at least
+  // MPI_THREAD_FUNNELED.
+  bool overlapGhostExchange() const;
+  void overlapGhostExchange(bool x);
+
+  // Select whether we measure the time spent on each step and attribute it to
+  // the nodes (NodeList::work), for use in load balancing.
+  bool measureWork() const;
+  void measureWork(bool x);
+
+  // Select whether the physics packages share cached per-pair geometry and
+  // kernel values (ConnectivityMap::pairGeometry) during each derivative
+  // evaluation.  This trades memory for fewer kernel evaluations.
+  bool cachePairGeometry() const;
+  void cachePairGeometry(bool x);
+
   //****************************************************************************
   // Methods required for restarting.
   virtual std::string label() const { return "Integrator"; }
@@ -222,6 +245,13 @@ protected:
   // Allow write access to the DataBase for descendent classes.
   DataBase<Dimension>& accessDataBase();
 
+  // Write access to the ConnectivityMap our physics packages require.
+  ConnectivityMap<Dimension>& accessConnectivityMap();
+
+  // The pool of Field buffers our state snapshots (copyState) reuse from step
+  // to step.
+  typename StateBase<Dimension>::SnapshotPoolPtr snapshotPool() const;
+
 private:
   //--------------------------- Private Interface ---------------------------//
   Scalar mDtMin, mDtMax, mDtGrowth, mLastDt, mDtMultiplier, mDtCheckFrac, mCurrentTime;
@@ -229,7 +259,8 @@ private:
   bool mVerbose, mAllowDtCheck, mRequireConnectivity, mRequireGhostConnectivity, mRequireOverlapConnectivity;
   DataBase<Dimension>* mDataBasePtr;
   std::vector<Physics<Dimension>*> mPhysicsPackages;
-  bool mRigorousBoundaries, mCullGhostNodes;
+  bool mRigorousBoundaries, mCullGhostNodes, mOverlapGhostExchange, mMeasureWork, mCachePairGeometry;
+  typename StateBase<Dimension>::SnapshotPoolPtr mSnapshotPool;
 
   // The restart registration.
   RestartRegistrationType mRestart;
@@ -278,6 +278,63 @@ cullGhostNodes(bool x) {
   mCullGhostNodes = x;
 }
 
+//------------------------------------------------------------------------------
+// Select whether we overlap ghost communication with the interior node pairs.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+Integrator<Dimension>::
+overlapGhostExchange() const {
+  return mOverlapGhostExchange;
+}
+
+template<typename Dimension>
+inline
+void
+Integrator<Dimension>::
+overlapGhostExchange(bool x) {
+  mOverlapGhostExchange = x;
+}
+
+//------------------------------------------------------------------------------
+// Select whether we measure the work per node.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+Integrator<Dimension>::
+measureWork() const {
+  return mMeasureWork;
+}
+
+template<typename Dimension>
+inline
+void
+Integrator<Dimension>::
+measureWork(bool x) {
+  mMeasureWork = x;
+}
+
+//------------------------------------------------------------------------------
+// Select whether the physics packages share cached pair geometry.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+Integrator<Dimension>::
+cachePairGeometry() const {
+  return mCachePairGeometry;
+}
+
+template<typename Dimension>
+inline
+void
+Integrator<Dimension>::
+cachePairGeometry(bool x) {
+  mCachePairGeometry = x;
+}
+
 //------------------------------------------------------------------------------
 // Descendent classes can get write access to the DataBase.
 //------------------------------------------------------------------------------
@@ -109,8 +109,8 @@ step(typename Dimension::Scalar maxTime,
   // Copy the beginning of step state and derivatives.
   State<Dimension> state0(state);
   StateDerivatives<Dimension> derivs0(derivs);
-  state0.copyState();
-  derivs0.copyState();
+  state0.copyState(this->snapshotPool());
+  derivs0.copyState(this->snapshotPool());
 
   // Predictor step -- trial advance to the end of step.
   state.update(derivs, dt, t, dt);
@@ -132,7 +132,7 @@ step(typename Dimension::Scalar maxTime,
 
     if (dtnew < this->dtCheckFrac()*dt) {
       this->currentTime(t);
-      state.assign(state0);
+      state.swapState(state0);
       return false;
     }
   }
@@ -151,7 +151,7 @@ step(typename Dimension::Scalar maxTime,
   // Apply the corrector stage.
   const Scalar hdt = 0.5*dt;
   this->copyGhostState(state, state0);
-  state.assign(state0);
+  state.swapState(state0);
   state.update(derivs0, hdt, t, hdt);
   this->applyGhostBoundaries(state, derivs);
   state.update(derivs, hdt, t + hdt, hdt);
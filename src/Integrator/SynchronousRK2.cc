@@ -109,7 +109,7 @@ step(typename Dimension::Scalar maxTime,
 
   // Copy the beginning of step state.
   State<Dimension> state0(state);
-  state0.copyState();
+  state0.copyState(this->snapshotPool());
 
   // Trial advance the state to the mid timestep point.
   state.update(derivs, hdt, t, hdt);
@@ -133,7 +133,7 @@ step(typename Dimension::Scalar maxTime,
                                       derivs);
     if (dtnew < this->dtCheckFrac()*dt) {
       this->currentTime(t);
-      state.assign(state0);
+      state.swapState(state0);
       return false;
     }
   }
@@ -141,7 +141,7 @@ step(typename Dimension::Scalar maxTime,
   // Advance the state from the beginning of the cycle using the midpoint 
   // derivatives.
   // this->copyGhostState(state, state0);
-  state.assign(state0);
+  state.swapState(state0);
   state.update(derivs, dt, t, dt);
   this->currentTime(t + dt);
   this->applyGhostBoundaries(state, derivs);
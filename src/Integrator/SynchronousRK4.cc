@@ -100,13 +100,13 @@ step(typename Dimension::Scalar maxTime,
 
   // Zero out the derivatives, and make some independent copies
   StateDerivatives<Dimension> derivs2(derivs1), derivs3(derivs1), derivs4(derivs1);
-  derivs2.copyState();
-  derivs3.copyState();
-  derivs4.copyState();
+  derivs2.copyState(this->snapshotPool());
+  derivs3.copyState(this->snapshotPool());
+  derivs4.copyState(this->snapshotPool());
 
   // Make a copy of the state we'll use for our intermediate estimates.
   State<Dimension> tmpstate(state);
-  tmpstate.copyState();
+  tmpstate.copyState(this->snapshotPool());
 
   // Stage 1:
   // Get derivs1(t_n, state(t_n))
@@ -141,7 +141,7 @@ step(typename Dimension::Scalar maxTime,
   // Stage 3: 
   // Get derivs3(t_n + 0.5*dt, state(t_n + 0.5*dt*derivs2))
   tmpstate = state;
-  tmpstate.copyState();
+  tmpstate.copyState(this->snapshotPool());
   tmpstate.update(derivs2, 0.5*dt, t, 0.5*dt);
   this->applyGhostBoundaries(tmpstate, derivs2);
   this->postStateUpdate(t + 0.5*dt, 0.5*dt, db, tmpstate, derivs2);
@@ -166,7 +166,7 @@ step(typename Dimension::Scalar maxTime,
   // Stage 4: 
   // Get derivs3(t_n + dt, state(t_n + dt*derivs3))
   tmpstate = state;
-  tmpstate.copyState();
+  tmpstate.copyState(this->snapshotPool());
   tmpstate.update(derivs3, dt, t, dt);
   this->applyGhostBoundaries(tmpstate, derivs3);
   this->postStateUpdate(t + dt, dt, db, tmpstate, derivs3);
@@ -113,7 +113,7 @@ step(typename Dimension::Scalar maxTime,
   State<Dimension> state0;
   if (dtcheck) {
     state0 = state;
-    state0.copyState();
+    state0.copyState(this->snapshotPool());
   }
 
   // Evaluate the beginning of step derivatives.
@@ -138,14 +138,14 @@ step(typename Dimension::Scalar maxTime,
                                       derivs);
     if (dtnew < dtcheckFrac*dt0) {
       this->currentTime(t);
-      state.assign(state0);
+      state.swapState(state0);
       return false;
     }
   }
 
   // Copy the mid-point state.
   State<Dimension> state12(state);
-  state12.copyState();
+  state12.copyState(this->snapshotPool());
 
   // Advance the position to the end of step using the half-step velocity.
   auto vel12 = state.fields(HydroFieldNames::velocity, Vector::zero);
@@ -177,13 +177,13 @@ step(typename Dimension::Scalar maxTime,
                                       derivs);
     if (dtnew < dtcheckFrac*dt0) {
       this->currentTime(t);
-      state.assign(state0);
+      state.swapState(state0);
       return false;
     }
   }
 
   // Correct the final state by the end-point derivatives.
-  state.assign(state12);
+  state.swapState(state12);
   // state.timeAdvanceOnly(false);
   state.update(derivs, hdt0, t + hdt0, dt0);
   {
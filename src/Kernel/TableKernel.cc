@@ -225,6 +225,7 @@ TableKernel<Dimension>::TableKernel(const KernelType& kernel,
   mAgrad2(),
   mBgrad2(),
   mCgrad2(),
+  mInterleavedCoeffs(),
   mNumPoints(0),
   mStepSize(0.0),
   mNperhValues(),
@@ -270,6 +271,7 @@ TableKernel<Dimension>::TableKernel(const KernelType& kernel,
   setParabolicCoeffs(kernelValues, mAkernel, mBkernel, mCkernel);
   setParabolicCoeffs(gradValues, mAgrad, mBgrad, mCgrad);
   setParabolicCoeffs(grad2Values, mAgrad2, mBgrad2, mCgrad2);
+  setInterleavedCoeffs();
 
   // If we're a 2D kernel we set the RZ correction information.
   if (Dimension::nDim == 2) {
@@ -332,6 +334,7 @@ operator=(const TableKernel<Dimension>& rhs) {
     mAgrad2 = rhs.mAgrad2;
     mBgrad2 = rhs.mBgrad2;
     mCgrad2 = rhs.mCgrad2;
+    mInterleavedCoeffs = rhs.mInterleavedCoeffs;
     mNumPoints = rhs.mNumPoints;
     mStepSize = rhs.mStepSize;
     mNperhValues = rhs.mNperhValues;
@@ -507,6 +510,32 @@ setParabolicCoeffs(const std::vector<double>& table,
   }
 }
 
+//------------------------------------------------------------------------------
+// Interleave the kernel, gradient, and second derivative coefficients so a
+// single table point is contiguous in memory:
+//   [aW, bW, cW, aGrad, bGrad, cGrad, aGrad2, bGrad2, cGrad2]
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+TableKernel<Dimension>::
+setInterleavedCoeffs() {
+  REQUIRE(mNumPoints > 0);
+  REQUIRE((int)mAkernel.size() == mNumPoints and (int)mAgrad.size() == mNumPoints and (int)mAgrad2.size() == mNumPoints);
+  mInterleavedCoeffs = std::vector<double>(9*mNumPoints);
+  for (int i = 0; i < mNumPoints; ++i) {
+    auto* coeffs = &mInterleavedCoeffs[9*i];
+    coeffs[0] = mAkernel[i];
+    coeffs[1] = mBkernel[i];
+    coeffs[2] = mCkernel[i];
+    coeffs[3] = mAgrad[i];
+    coeffs[4] = mBgrad[i];
+    coeffs[5] = mCgrad[i];
+    coeffs[6] = mAgrad2[i];
+    coeffs[7] = mBgrad2[i];
+    coeffs[8] = mCgrad2[i];
+  }
+}
+
 //------------------------------------------------------------------------------
 // Initialize the Nperh values.
 //------------------------------------------------------------------------------
@@ -567,6 +596,7 @@ valid() const {
           (int)mAgrad2.size() == mNumPoints and
           (int)mBgrad2.size() == mNumPoints and
           (int)mCgrad2.size() == mNumPoints and
+          (int)mInterleavedCoeffs.size() == 9*mNumPoints and
           mStepSize > 0.0);
 }
 
@@ -58,6 +58,18 @@ public:
                            std::vector<double>& kernelValues,
                            std::vector<double>& gradValues) const;
 
+  // Block evaluation of the kernel, first, and (optionally) second derivatives
+  // for n contiguous normalized distances, writing into caller provided
+  // buffers of length n.  grad2Values may be null if not required.
+  // This loop is branch free and reads the interleaved coefficient table, so
+  // it vectorizes; prefer it to the scalar lookups in pair loops.
+  void kernelAndGradValues(const double* etaMagnitudes,
+                           const double* Hdets,
+                           const size_t n,
+                           double* kernelValues,
+                           double* gradValues,
+                           double* grad2Values = nullptr) const;
+
   // Return the equivalent number of nodes per smoothing scale implied by the given
   // sum of kernel values.
   double equivalentNodesPerSmoothingScale(const double Wsum) const;
@@ -100,6 +112,7 @@ private:
   std::vector<double> mAkernel, mBkernel, mCkernel;
   std::vector<double> mAgrad, mBgrad, mCgrad;
   std::vector<double> mAgrad2, mBgrad2, mCgrad2;
+  std::vector<double> mInterleavedCoeffs;   // (a,b,c) for (W, gradW, grad2W) at each point
   int mNumPoints;
   double mStepSize;
 
@@ -127,6 +140,9 @@ private:
                           std::vector<double>& b,
                           std::vector<double>& c) const;
 
+  // Build the interleaved coefficient table from the per quantity tables.
+  void setInterleavedCoeffs();
+
   // Generic parabolic interpolation.
   double parabolicInterp(const double etaMagnitude,
                          const std::vector<double>& a,
@@ -98,14 +98,66 @@ TableKernel<Dimension>::kernelAndGradValues(const std::vector<double>& etaMagnit
   }
   END_CONTRACT_SCOPE
 
-  // Prepare the results.
-  kernelValues = std::vector<double>(n);
-  gradValues = std::vector<double>(n);
+  // Prepare the results, reusing any existing storage.
+  kernelValues.resize(n);
+  gradValues.resize(n);
 
   // Fill those suckers in.
-  for (size_t i = 0; i != n; ++i) {
-    kernelValues[i] = Hdets[i]*parabolicInterp(etaMagnitudes[i], mAkernel, mBkernel, mCkernel);
-    gradValues[i] = Hdets[i]*parabolicInterp(etaMagnitudes[i], mAgrad, mBgrad, mCgrad);
+  if (n > 0) this->kernelAndGradValues(&etaMagnitudes[0], &Hdets[0], n, &kernelValues[0], &gradValues[0]);
+}
+
+//------------------------------------------------------------------------------
+// Block evaluation of the kernel and derivatives into caller provided buffers.
+// Points beyond the kernel extent are clamped into the table and masked to
+// zero, so the loop has no data dependent branches.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+void
+TableKernel<Dimension>::kernelAndGradValues(const double* etaMagnitudes,
+                                            const double* Hdets,
+                                            const size_t n,
+                                            double* kernelValues,
+                                            double* gradValues,
+                                            double* grad2Values) const {
+  REQUIRE(n == 0 or (etaMagnitudes != nullptr and Hdets != nullptr and kernelValues != nullptr and gradValues != nullptr));
+  REQUIRE((int)mInterleavedCoeffs.size() == 9*mNumPoints);
+  BEGIN_CONTRACT_SCOPE
+  {
+    for (size_t k = 0; k != n; ++k) {
+      REQUIRE(etaMagnitudes[k] >= 0.0);
+      REQUIRE(Hdets[k] >= 0.0);
+    }
+  }
+  END_CONTRACT_SCOPE
+
+  const auto* coeffs = &mInterleavedCoeffs[0];
+  const auto  extent = this->mKernelExtent;
+  const auto  stepInv = 1.0/mStepSize;
+  const auto  imax = mNumPoints - 3;
+  if (grad2Values == nullptr) {
+#pragma omp simd
+    for (size_t k = 0; k < n; ++k) {
+      const auto etaMag = etaMagnitudes[k];
+      const auto scale = (etaMag < extent ? Hdets[k] : 0.0);
+      const auto i0 = std::min(imax, int(std::min(etaMag, extent)*stepInv));
+      const auto x = etaMag*stepInv - i0;
+      const auto* c = coeffs + 9*(i0 + 1);
+      kernelValues[k] = scale*(c[0] + (c[1] + c[2]*x)*x);
+      gradValues[k] = scale*(c[3] + (c[4] + c[5]*x)*x);
+    }
+  } else {
+#pragma omp simd
+    for (size_t k = 0; k < n; ++k) {
+      const auto etaMag = etaMagnitudes[k];
+      const auto scale = (etaMag < extent ? Hdets[k] : 0.0);
+      const auto i0 = std::min(imax, int(std::min(etaMag, extent)*stepInv));
+      const auto x = etaMag*stepInv - i0;
+      const auto* c = coeffs + 9*(i0 + 1);
+      kernelValues[k] = scale*(c[0] + (c[1] + c[2]*x)*x);
+      gradValues[k] = scale*(c[3] + (c[4] + c[5]*x)*x);
+      grad2Values[k] = scale*(c[6] + (c[7] + c[8]*x)*x);
+    }
   }
 }
 
@@ -59,6 +59,27 @@ template<typename Dimension>
 EquationOfState<Dimension>::~EquationOfState() {
 }
 
+//------------------------------------------------------------------------------
+// Compute the thermodynamic state, by default with the individual Field
+// methods.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+EquationOfState<Dimension>::
+setState(Field<Dimension, Scalar>* pressure,
+         Field<Dimension, Scalar>* soundSpeed,
+         Field<Dimension, Scalar>* temperature,
+         Field<Dimension, Scalar>* gamma,
+         Field<Dimension, Scalar>* bulkModulus,
+         const Field<Dimension, Scalar>& massDensity,
+         const Field<Dimension, Scalar>& specificThermalEnergy) const {
+  if (pressure != nullptr)    this->setPressure(*pressure, massDensity, specificThermalEnergy);
+  if (soundSpeed != nullptr)  this->setSoundSpeed(*soundSpeed, massDensity, specificThermalEnergy);
+  if (temperature != nullptr) this->setTemperature(*temperature, massDensity, specificThermalEnergy);
+  if (gamma != nullptr)       this->setGammaField(*gamma, massDensity, specificThermalEnergy);
+  if (bulkModulus != nullptr) this->setBulkModulus(*bulkModulus, massDensity, specificThermalEnergy);
+}
+
 //------------------------------------------------------------------------------
 // Look up an energy that gives the requested pressure at the specified density.
 //------------------------------------------------------------------------------
@@ -72,6 +72,18 @@ public:
                           const Field<Dimension, Scalar>& massDensity,
                           const Field<Dimension, Scalar>& specificThermalEnergy) const = 0;
 
+  // Compute any of the pressure, sound speed, temperature, gamma, and bulk
+  // modulus in a single pass over the density and specific thermal energy.
+  // Null outputs are skipped.  The default just calls the individual Field
+  // methods above.
+  virtual void setState(Field<Dimension, Scalar>* pressure,
+                        Field<Dimension, Scalar>* soundSpeed,
+                        Field<Dimension, Scalar>* temperature,
+                        Field<Dimension, Scalar>* gamma,
+                        Field<Dimension, Scalar>* bulkModulus,
+                        const Field<Dimension, Scalar>& massDensity,
+                        const Field<Dimension, Scalar>& specificThermalEnergy) const;
+
   // Look up an energy that gives the requested pressure at the specified density.
   virtual Scalar specificThermalEnergyForPressure(const Scalar Ptarget,
                                                   const Scalar rho,
@@ -106,6 +118,22 @@ public:
 protected:
   PhysicalConstants mConstants;
 
+  // An implementation of setState for equations of state providing thread
+  // safe point-wise pressure(rho, eps), soundSpeed(rho, eps), etc.:  a single
+  // OpenMP loop over the Fields evaluating each requested quantity.  The
+  // Pressure and SoundSpeed policies calling this are fired serially by
+  // State::update (they don't opt in to concurrentUpdate), so the loop gets
+  // the full thread team.
+  template<typename EOSType>
+  static void setStateByPoint(const EOSType& eos,
+                              Field<Dimension, Scalar>* pressure,
+                              Field<Dimension, Scalar>* soundSpeed,
+                              Field<Dimension, Scalar>* temperature,
+                              Field<Dimension, Scalar>* gamma,
+                              Field<Dimension, Scalar>* bulkModulus,
+                              const Field<Dimension, Scalar>& massDensity,
+                              const Field<Dimension, Scalar>& specificThermalEnergy);
+
 private:
   double mMinimumPressure, mMaximumPressure;
   MaterialPressureMinType mMinPressureType;
@@ -0,0 +1,58 @@
+//---------------------------------Spheral++----------------------------------//
+// EquationOfStateByPoint -- A CRTP helper providing setState for equations of
+// state whose point-wise pressure(rho, eps), soundSpeed(rho, eps), etc. are
+// thread safe pure functions, by way of EquationOfState::setStateByPoint.
+//
+// Usage:
+//   class MyEOS: public EquationOfStateByPoint<Dimension, MyEOS<Dimension>> {...};
+// or for solid equations of state
+//   class MyEOS: public EquationOfStateByPoint<Dimension, MyEOS<Dimension>,
+//                                              SolidEquationOfState<Dimension>> {...};
+//
+// Equations of state with a genuinely fused evaluation of several quantities
+// (such as ANEOS's table lookups) should override setState themselves.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_EquationOfStateByPoint_hh__
+#define __Spheral_EquationOfStateByPoint_hh__
+
+#include "EquationOfState.hh"
+
+namespace Spheral {
+
+template<typename Dimension,
+         typename Derived,
+         typename BaseType = EquationOfState<Dimension>>
+class EquationOfStateByPoint: public BaseType {
+
+public:
+  //--------------------------- Public Interface ---------------------------//
+  typedef typename Dimension::Scalar Scalar;
+
+  // Forward the constructors of the base equation of state.
+  using BaseType::BaseType;
+  virtual ~EquationOfStateByPoint() {}
+
+  // Compute the requested quantities in a single threaded pass.
+  virtual void setState(Field<Dimension, Scalar>* pressure,
+                        Field<Dimension, Scalar>* soundSpeed,
+                        Field<Dimension, Scalar>* temperature,
+                        Field<Dimension, Scalar>* gamma,
+                        Field<Dimension, Scalar>* bulkModulus,
+                        const Field<Dimension, Scalar>& massDensity,
+                        const Field<Dimension, Scalar>& specificThermalEnergy) const override {
+    EquationOfState<Dimension>::setStateByPoint(static_cast<const Derived&>(*this),
+                                                pressure, soundSpeed, temperature, gamma, bulkModulus,
+                                                massDensity, specificThermalEnergy);
+  }
+};
+
+}
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  template<typename Dimension, typename Derived, typename BaseType> class EquationOfStateByPoint;
+}
+
+#endif
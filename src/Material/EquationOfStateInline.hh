@@ -87,4 +87,39 @@ EquationOfState<Dimension>::applyPressureLimits(const Scalar P) const {
           P);
 }
 
+//------------------------------------------------------------------------------
+// Fill in the thermodynamic state from the point-wise methods of an EOS.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+template<typename EOSType>
+inline
+void
+EquationOfState<Dimension>::
+setStateByPoint(const EOSType& eos,
+                Field<Dimension, Scalar>* pressure,
+                Field<Dimension, Scalar>* soundSpeed,
+                Field<Dimension, Scalar>* temperature,
+                Field<Dimension, Scalar>* gamma,
+                Field<Dimension, Scalar>* bulkModulus,
+                const Field<Dimension, Scalar>& massDensity,
+                const Field<Dimension, Scalar>& specificThermalEnergy) {
+  const int n = massDensity.size();
+  REQUIRE(specificThermalEnergy.size() == massDensity.size());
+  REQUIRE(pressure == nullptr or pressure->size() == massDensity.size());
+  REQUIRE(soundSpeed == nullptr or soundSpeed->size() == massDensity.size());
+  REQUIRE(temperature == nullptr or temperature->size() == massDensity.size());
+  REQUIRE(gamma == nullptr or gamma->size() == massDensity.size());
+  REQUIRE(bulkModulus == nullptr or bulkModulus->size() == massDensity.size());
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    const Scalar rhoi = massDensity(i);
+    const Scalar epsi = specificThermalEnergy(i);
+    if (pressure != nullptr)    (*pressure)(i) = eos.pressure(rhoi, epsi);
+    if (soundSpeed != nullptr)  (*soundSpeed)(i) = eos.soundSpeed(rhoi, epsi);
+    if (temperature != nullptr) (*temperature)(i) = eos.temperature(rhoi, epsi);
+    if (gamma != nullptr)       (*gamma)(i) = eos.gamma(rhoi, epsi);
+    if (bulkModulus != nullptr) (*bulkModulus)(i) = eos.bulkModulus(rhoi, epsi);
+  }
+}
+
 }
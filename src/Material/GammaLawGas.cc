@@ -29,7 +29,7 @@ GammaLawGas(const double gamma,
             const double minimumPressure,
             const double maximumPressure,
             const MaterialPressureMinType minPressureType):
-  EquationOfState<Dimension>(constants, minimumPressure, maximumPressure, minPressureType),
+  EquationOfStateByPoint<Dimension, GammaLawGas<Dimension>>(constants, minimumPressure, maximumPressure, minPressureType),
   mGamma(gamma),
   mMolecularWeight(mu) {
   mGamma1 = mGamma - 1.0;
@@ -7,12 +7,12 @@
 #ifndef GammaLawGas_HH
 #define GammaLawGas_HH
 
-#include "EquationOfState.hh"
+#include "EquationOfStateByPoint.hh"
 
 namespace Spheral {
 
 template<typename Dimension>
-class GammaLawGas: public EquationOfState<Dimension> {
+class GammaLawGas: public EquationOfStateByPoint<Dimension, GammaLawGas<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
@@ -20,7 +20,7 @@ IsothermalEquationOfState(const double K,
                           const double minimumPressure,
                           const double maximumPressure,
                           const MaterialPressureMinType minPressureType):
-  EquationOfState<Dimension>(constants, minimumPressure, maximumPressure, minPressureType),
+  EquationOfStateByPoint<Dimension, IsothermalEquationOfState<Dimension>>(constants, minimumPressure, maximumPressure, minPressureType),
   mK(K),
   mCs(sqrt(K)),
   mMolecularWeight(mu),
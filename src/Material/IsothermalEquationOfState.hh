@@ -6,12 +6,12 @@
 #ifndef __Spheral_IsothermalEquationOfState_hh__
 #define __Spheral_IsothermalEquationOfState_hh__
 
-#include "EquationOfState.hh"
+#include "EquationOfStateByPoint.hh"
 
 namespace Spheral {
 
 template<typename Dimension>
-class IsothermalEquationOfState: public EquationOfState<Dimension> {
+class IsothermalEquationOfState: public EquationOfStateByPoint<Dimension, IsothermalEquationOfState<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
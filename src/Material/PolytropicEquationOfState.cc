@@ -25,7 +25,7 @@ PolytropicEquationOfState(const double K,
                           const double minimumPressure,
                           const double maximumPressure,
                           const MaterialPressureMinType minPressureType):
-  EquationOfState<Dimension>(constants, minimumPressure, maximumPressure, minPressureType),
+  EquationOfStateByPoint<Dimension, PolytropicEquationOfState<Dimension>>(constants, minimumPressure, maximumPressure, minPressureType),
   mPolytropicConstant(K),
   mPolytropicIndex(index),
   mGamma(0.0),
@@ -6,12 +6,12 @@
 #ifndef __Spheral_PolytropicEquationOfState_hh__
 #define __Spheral_PolytropicEquationOfState_hh__
 
-#include "EquationOfState.hh"
+#include "EquationOfStateByPoint.hh"
 
 namespace Spheral {
 
 template<typename Dimension>
-class PolytropicEquationOfState: public EquationOfState<Dimension> {
+class PolytropicEquationOfState: public EquationOfStateByPoint<Dimension, PolytropicEquationOfState<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
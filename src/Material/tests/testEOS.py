@@ -66,6 +66,38 @@ class EOSTest(unittest.TestCase):
                         "Pressure error out of tolerance: %s > %s" % (Perr.max(), Perrcheck))
         return
 
+    def testSetState(self):
+        n = 1000
+        rhoMin, rhoMax = 1e-5, 1000.0
+        epsMin, epsMax = 0.0, 1e5
+        nodes = makeFluidNodeList("setState nodes", eos, numInternal=n)
+        rho = ScalarField("rho", nodes)
+        eps = ScalarField("eps", nodes)
+        for i in xrange(n):
+            rho[i] = rangen.uniform(rhoMin, rhoMax)
+            eps[i] = rangen.uniform(epsMin, epsMax)
+        names = ("pressure", "sound speed", "temperature", "gamma", "bulk modulus")
+        setters = (eos.setPressure, eos.setSoundSpeed, eos.setTemperature,
+                   eos.setGammaField, eos.setBulkModulus)
+        answers = [ScalarField(name, nodes) for name in names]
+        for setter, ans in zip(setters, answers):
+            setter(ans, rho, eps)
+        values = [ScalarField(name + " (setState)", nodes) for name in names]
+        eos.setState(values[0], values[1], values[2], values[3], values[4], rho, eps)
+        for name, x, ans in zip(names, values, answers):
+            for i in xrange(n):
+                self.failUnless(x[i] == ans[i],
+                                "setState %s does not match:  %g != %g" % (name, x[i], ans[i]))
+
+        # The outputs passed as None are skipped.
+        T = ScalarField("temperature (partial)", nodes)
+        K = ScalarField("bulk modulus (partial)", nodes)
+        eos.setState(None, None, T, None, K, rho, eps)
+        for i in xrange(n):
+            self.failUnless(T[i] == answers[2][i] and K[i] == answers[4][i],
+                            "Partial setState does not match:  (%g, %g) != (%g, %g)" % (T[i], K[i], answers[2][i], answers[4][i]))
+        return
+
 #-------------------------------------------------------------------------------
 # Run those tests.
 #-------------------------------------------------------------------------------
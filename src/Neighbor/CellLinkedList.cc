@@ -0,0 +1,193 @@
+//---------------------------------Spheral++----------------------------------//
+// CellLinkedList
+//
+// A flat, uniform cell grid over a set of points for bulk neighbor queries.
+//----------------------------------------------------------------------------//
+#include "CellLinkedList.hh"
+#include "Utilities/testBoxIntersection.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+using std::vector;
+using std::min;
+using std::max;
+
+namespace Spheral {
+
+namespace {
+// The tolerance of the box tests, as used in Neighbor::precullList.
+const double boxTolerance = 1.0e-10;
+}
+
+//------------------------------------------------------------------------------
+// Constructors.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+CellLinkedList<Dimension>::
+CellLinkedList():
+  mXmin(),
+  mMaxExtent(),
+  mCellSize(1.0),
+  mCellOffsets(1, 0u),
+  mIndices(),
+  mPositions(),
+  mExtents() {
+  mNumCells[0] = mNumCells[1] = mNumCells[2] = 1;
+}
+
+template<typename Dimension>
+CellLinkedList<Dimension>::
+CellLinkedList(const vector<Vector>& positions,
+               const vector<Vector>& extents,
+               const Scalar cellSize):
+  CellLinkedList() {
+  this->build(positions, extents, cellSize);
+}
+
+//------------------------------------------------------------------------------
+// Bin the points.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+CellLinkedList<Dimension>::
+build(const vector<Vector>& positions,
+      const vector<Vector>& extents,
+      const Scalar cellSize) {
+  REQUIRE(extents.size() == positions.size());
+  const auto n = positions.size();
+
+  // The bounding box and maximum extent of the points.
+  Vector xmax;
+  mXmin = std::numeric_limits<Scalar>::max();
+  xmax = -std::numeric_limits<Scalar>::max();
+  mMaxExtent = Vector::zero;
+  for (auto i = 0u; i < n; ++i) {
+    for (auto d = 0u; d < Dimension::nDim; ++d) {
+      mXmin(d) = min(mXmin(d), positions[i](d));
+      xmax(d) = max(xmax(d), positions[i](d));
+      mMaxExtent(d) = max(mMaxExtent(d), extents[i](d));
+    }
+  }
+  if (n == 0u) {
+    mXmin = Vector::zero;
+    xmax = Vector::zero;
+  }
+  const auto boxSize = xmax - mXmin;
+
+  // Pick the cell size, coarsening until we have no more than a few cells per
+  // point.
+  mCellSize = (cellSize > 0.0 ? cellSize : mMaxExtent.maxElement());
+  if (mCellSize <= 0.0) mCellSize = max(boxSize.maxElement(), 1.0e-30);
+  const double maxCells = max(8.0*n, 1.0);
+  double totalCells;
+  do {
+    totalCells = 1.0;
+    for (auto d = 0u; d < Dimension::nDim; ++d) totalCells *= std::floor(boxSize(d)/mCellSize) + 1.0;
+    if (totalCells > maxCells) mCellSize *= 2.0;
+  } while (totalCells > maxCells);
+  mNumCells[0] = mNumCells[1] = mNumCells[2] = 1;
+  for (auto d = 0u; d < Dimension::nDim; ++d) mNumCells[d] = int(boxSize(d)/mCellSize) + 1;
+  const size_t numCells = size_t(mNumCells[0])*mNumCells[1]*mNumCells[2];
+
+  // Key the points by cell.
+  vector<size_t> keys(n);
+#pragma omp parallel for
+  for (auto i = 0u; i < n; ++i) {
+    int ic[3] = {0, 0, 0};
+    for (auto d = 0u; d < Dimension::nDim; ++d) ic[d] = this->cellCoordinate(positions[i](d), d);
+    keys[i] = ic[0] + size_t(mNumCells[0])*(ic[1] + size_t(mNumCells[1])*ic[2]);
+  }
+
+  // Counting sort by key.  The scatter is stable, so the points in each cell
+  // remain in ascending index order.
+  mCellOffsets.assign(numCells + 1u, 0u);
+  for (auto i = 0u; i < n; ++i) ++mCellOffsets[keys[i] + 1u];
+  for (auto k = 0u; k < numCells; ++k) mCellOffsets[k + 1u] += mCellOffsets[k];
+  CHECK(mCellOffsets.back() == n);
+  mIndices.resize(n);
+  mPositions.resize(n);
+  mExtents.resize(n);
+  vector<size_t> cursor(mCellOffsets.begin(), mCellOffsets.end() - 1);
+  for (auto i = 0u; i < n; ++i) {
+    const auto k = cursor[keys[i]]++;
+    mIndices[k] = i;
+    mPositions[k] = positions[i];
+    mExtents[k] = extents[i];
+  }
+
+  ENSURE(this->numPoints() == n);
+  ENSURE(this->numCells() == numCells);
+}
+
+//------------------------------------------------------------------------------
+// Find the neighbors of a batch of query points.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+CellLinkedList<Dimension>::
+query(const vector<Vector>& queryPositions,
+      const vector<Vector>& queryExtents,
+      const NeighborSearchType searchType,
+      vector<size_t>& offsets,
+      vector<int>& neighbors) const {
+  REQUIRE(queryExtents.size() == queryPositions.size());
+  const auto nq = queryPositions.size();
+  const auto gather = (searchType != NeighborSearchType::Scatter);
+  const auto scatter = (searchType != NeighborSearchType::Gather);
+
+  // Each thread takes one contiguous block of the query points (in thread
+  // order), so the per thread results can simply be concatenated.
+  offsets.assign(nq + 1u, 0u);
+  vector<vector<int>> threadNeighbors(omp_get_max_threads());
+#pragma omp parallel
+  {
+    auto& localNeighbors = threadNeighbors[omp_get_thread_num()];
+    vector<int> candidates;
+#pragma omp for schedule(static)
+    for (auto k = 0u; k < nq; ++k) {
+      const auto& xq = queryPositions[k];
+      const auto& eq = queryExtents[k];
+      const auto  minQueryExtent = xq - eq;
+      const auto  maxQueryExtent = xq + eq;
+
+      // The range of cells that can hold neighbors.
+      int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+      for (auto d = 0u; d < Dimension::nDim; ++d) {
+        const auto w = max(gather ? eq(d) : 0.0, scatter ? mMaxExtent(d) : 0.0) + boxTolerance;
+        lo[d] = this->cellCoordinate(xq(d) - w, d);
+        hi[d] = this->cellCoordinate(xq(d) + w, d);
+      }
+
+      // Walk those cells and apply the same tests as Neighbor::precullList.
+      for (auto iz = lo[2]; iz <= hi[2]; ++iz) {
+        for (auto iy = lo[1]; iy <= hi[1]; ++iy) {
+          const auto key0 = size_t(mNumCells[0])*(iy + size_t(mNumCells[1])*iz);
+          for (auto p = mCellOffsets[key0 + lo[0]]; p < mCellOffsets[key0 + hi[0] + 1u]; ++p) {
+            const auto& xj = mPositions[p];
+            if ((gather and testPointInBox(xj, minQueryExtent, maxQueryExtent, boxTolerance)) or
+                (scatter and testPointInBox(xq, xj - mExtents[p], xj + mExtents[p], boxTolerance))) {
+              candidates.push_back(mIndices[p]);
+            }
+          }
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      offsets[k + 1u] = candidates.size();
+      localNeighbors.insert(localNeighbors.end(), candidates.begin(), candidates.end());
+      candidates.clear();
+    }
+  }
+
+  // Assemble the result.
+  for (auto k = 0u; k < nq; ++k) offsets[k + 1u] += offsets[k];
+  neighbors.resize(offsets.back());
+  auto itr = neighbors.begin();
+  for (const auto& localNeighbors: threadNeighbors) itr = std::copy(localNeighbors.begin(), localNeighbors.end(), itr);
+  CHECK(itr == neighbors.end());
+}
+
+}
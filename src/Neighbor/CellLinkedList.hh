@@ -0,0 +1,85 @@
+//---------------------------------Spheral++----------------------------------//
+// CellLinkedList
+//
+// A flat, uniform cell grid over a set of points for bulk neighbor queries.
+// The points are binned by cell key with a counting sort, so each cell's points
+// are one contiguous run of the sorted arrays (addressed by a single offsets
+// array), and the positions and extents are stored in that sorted order for
+// locality.
+//
+// Each point carries an extent (the half widths of its box of influence, as in
+// Neighbor::nodeExtentField).  A query point likewise has its own extent, and
+// the candidates are selected with the same box tests as Neighbor::precullList
+// for the requested NeighborSearchType.  Batches of query points are answered
+// in parallel, with the result returned in compressed sparse row form: the
+// neighbors of query point k are neighbors[offsets[k]] ...
+// neighbors[offsets[k+1]-1], sorted by point index.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_CellLinkedList_hh__
+#define __Spheral_CellLinkedList_hh__
+
+#include "Neighbor/Neighbor.hh"
+
+#include <vector>
+
+namespace Spheral {
+
+template<typename Dimension>
+class CellLinkedList {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  typedef typename Dimension::Scalar Scalar;
+  typedef typename Dimension::Vector Vector;
+
+  // Constructors.
+  CellLinkedList();
+  CellLinkedList(const std::vector<Vector>& positions,
+                 const std::vector<Vector>& extents,
+                 const Scalar cellSize = 0.0);
+
+  // Bin the given points.  If cellSize <= 0 the cell size is chosen as the
+  // maximum point extent.  The cell size is increased as needed to keep the
+  // number of cells comparable to the number of points.
+  void build(const std::vector<Vector>& positions,
+             const std::vector<Vector>& extents,
+             const Scalar cellSize = 0.0);
+
+  // Find the points neighboring each of the query points.
+  void query(const std::vector<Vector>& queryPositions,
+             const std::vector<Vector>& queryExtents,
+             const NeighborSearchType searchType,
+             std::vector<size_t>& offsets,
+             std::vector<int>& neighbors) const;
+
+  // Access the grid.
+  size_t numPoints() const;
+  size_t numCells() const;
+  Scalar cellSize() const;
+  const Vector& xmin() const;
+  const Vector& maxExtent() const;
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  Vector mXmin, mMaxExtent;
+  Scalar mCellSize;
+  int mNumCells[3];
+  std::vector<size_t> mCellOffsets;
+  std::vector<int> mIndices;
+  std::vector<Vector> mPositions, mExtents;
+
+  // The cell containing a position along each axis (clamped to the grid).
+  int cellCoordinate(const Scalar x, const int axis) const;
+};
+
+}
+
+#include "CellLinkedListInline.hh"
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  template<typename Dimension> class CellLinkedList;
+}
+
+#endif
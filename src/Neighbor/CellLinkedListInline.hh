@@ -0,0 +1,65 @@
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Access the grid.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+size_t
+CellLinkedList<Dimension>::
+numPoints() const {
+  return mIndices.size();
+}
+
+template<typename Dimension>
+inline
+size_t
+CellLinkedList<Dimension>::
+numCells() const {
+  return (mCellOffsets.empty() ? 0u : mCellOffsets.size() - 1u);
+}
+
+template<typename Dimension>
+inline
+typename Dimension::Scalar
+CellLinkedList<Dimension>::
+cellSize() const {
+  return mCellSize;
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+CellLinkedList<Dimension>::
+xmin() const {
+  return mXmin;
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+CellLinkedList<Dimension>::
+maxExtent() const {
+  return mMaxExtent;
+}
+
+//------------------------------------------------------------------------------
+// The cell containing a position along an axis.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+int
+CellLinkedList<Dimension>::
+cellCoordinate(const Scalar x, const int axis) const {
+  REQUIRE(axis >= 0 and axis < (int)Dimension::nDim);
+  const Scalar s = (x - mXmin(axis))/mCellSize;
+  return (s <= 0.0 ? 0 :
+          s >= mNumCells[axis] - 1 ? mNumCells[axis] - 1 :
+          int(s));
+}
+
+}
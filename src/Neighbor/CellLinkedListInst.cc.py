@@ -0,0 +1,10 @@
+text = """
+#include "Neighbor/CellLinkedList.cc"
+
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+namespace Spheral {
+  template class CellLinkedList< Dim< %(ndim)s > >;
+}
+"""
@@ -0,0 +1,140 @@
+//---------------------------------Spheral++----------------------------------//
+// ConnectivityCSR
+//
+// Compressed sparse row storage for the ConnectivityMap neighbor lists.
+//----------------------------------------------------------------------------//
+#include "ConnectivityCSR.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+
+using std::vector;
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Constructor.
+//------------------------------------------------------------------------------
+ConnectivityCSR::
+ConnectivityCSR():
+  mNumNodeLists(0u),
+  mOffsets(),
+  mNeighbors(),
+  mThreadBuffers(),
+  mRunThread(),
+  mRunStart(),
+  mRunSize() {
+}
+
+//------------------------------------------------------------------------------
+// Clear (and release) the storage.
+//------------------------------------------------------------------------------
+void
+ConnectivityCSR::
+clear() {
+  mNumNodeLists = 0u;
+  vector<size_t>().swap(mOffsets);
+  vector<int>().swap(mNeighbors);
+}
+
+//------------------------------------------------------------------------------
+// Fill from the nested [row][NodeList][neighbor] layout.
+//------------------------------------------------------------------------------
+void
+ConnectivityCSR::
+assign(const NestedType& nested) {
+  const auto numRows = nested.size();
+  mNumNodeLists = (numRows == 0u ? 0u : nested[0].size());
+  const auto n = numRows*mNumNodeLists;
+  mOffsets.assign(n + 1u, 0u);
+#pragma omp parallel for
+  for (size_t row = 0u; row < numRows; ++row) {
+    CHECK(nested[row].size() == mNumNodeLists);
+    for (auto nodeListj = 0u; nodeListj < mNumNodeLists; ++nodeListj) {
+      mOffsets[row*mNumNodeLists + nodeListj + 1u] = nested[row][nodeListj].size();
+    }
+  }
+  for (size_t k = 0u; k < n; ++k) mOffsets[k + 1u] += mOffsets[k];
+  vector<int>(mOffsets.back()).swap(mNeighbors);
+#pragma omp parallel for
+  for (size_t row = 0u; row < numRows; ++row) {
+    for (auto nodeListj = 0u; nodeListj < mNumNodeLists; ++nodeListj) {
+      const auto& neighbors = nested[row][nodeListj];
+      std::copy(neighbors.begin(), neighbors.end(), mNeighbors.begin() + mOffsets[row*mNumNodeLists + nodeListj]);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Expand to the nested [row][NodeList][neighbor] layout.
+//------------------------------------------------------------------------------
+ConnectivityCSR::NestedType
+ConnectivityCSR::
+nested() const {
+  const auto numRows = this->numRows();
+  NestedType result(numRows, vector<vector<int>>(mNumNodeLists));
+#pragma omp parallel for
+  for (size_t row = 0u; row < numRows; ++row) {
+    for (auto nodeListj = 0u; nodeListj < mNumNodeLists; ++nodeListj) {
+      const auto neighbors = (*this)(row, nodeListj);
+      result[row][nodeListj].assign(neighbors.begin(), neighbors.end());
+    }
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Prepare for a parallel build.
+//------------------------------------------------------------------------------
+void
+ConnectivityCSR::
+beginBuild(const size_t numRows, const unsigned numNodeLists) {
+  REQUIRE(omp_in_parallel() == 0);
+  mNumNodeLists = numNodeLists;
+  const auto n = numRows*numNodeLists;
+  mThreadBuffers.resize(omp_get_max_threads());
+  for (auto& buf: mThreadBuffers) buf.clear();
+  mRunThread.assign(n, 0);
+  mRunStart.assign(n, 0u);
+  mRunSize.assign(n, 0u);
+}
+
+//------------------------------------------------------------------------------
+// Assemble the runs set since beginBuild into the storage.
+//------------------------------------------------------------------------------
+void
+ConnectivityCSR::
+finishBuild() {
+  REQUIRE(omp_in_parallel() == 0);
+  const auto n = mRunSize.size();
+  mOffsets.resize(n + 1u);
+  mOffsets[0] = 0u;
+  for (size_t k = 0u; k < n; ++k) mOffsets[k + 1u] = mOffsets[k] + mRunSize[k];
+  vector<size_t>(mOffsets).swap(mOffsets);
+  vector<int>(mOffsets.back()).swap(mNeighbors);
+#pragma omp parallel for schedule(static)
+  for (size_t k = 0u; k < n; ++k) {
+    if (mRunSize[k] > 0u) {
+      const auto& buf = mThreadBuffers[mRunThread[k]];
+      std::copy(buf.begin() + mRunStart[k], buf.begin() + mRunStart[k] + mRunSize[k], mNeighbors.begin() + mOffsets[k]);
+    }
+  }
+
+  // Release the scratch.
+  vector<vector<int>>().swap(mThreadBuffers);
+  vector<int>().swap(mRunThread);
+  vector<size_t>().swap(mRunStart);
+  vector<size_t>().swap(mRunSize);
+}
+
+//------------------------------------------------------------------------------
+// Memory footprint.
+//------------------------------------------------------------------------------
+size_t
+ConnectivityCSR::
+memoryUsage() const {
+  return mOffsets.capacity()*sizeof(size_t) + mNeighbors.capacity()*sizeof(int);
+}
+
+}
@@ -0,0 +1,149 @@
+//---------------------------------Spheral++----------------------------------//
+// ConnectivityCSR
+//
+// Compressed sparse row storage for the ConnectivityMap neighbor lists.  Each
+// row is a node (indexed as offset[NodeList] + nodeID, as in the
+// ConnectivityMap), and holds one contiguous run of neighbor indices per
+// NodeList.  All the runs live in a single flat array, addressed by one offsets
+// array of size numRows*numNodeLists + 1.
+//
+// The neighbors of a node are returned as lightweight views (NodeConnectivity
+// and NeighborSpan) into that storage, which behave like the
+// std::vector<std::vector<int>> and std::vector<int> they replace for reading.
+//
+// The storage can be filled in parallel: between beginBuild and finishBuild
+// each thread appends the runs it finds to its own buffer, and finishBuild
+// assembles the rows in order using a prefix sum of the run lengths.
+//----------------------------------------------------------------------------//
+#ifndef _Spheral_NeighborSpace_ConnectivityCSR_hh_
+#define _Spheral_NeighborSpace_ConnectivityCSR_hh_
+
+#include <vector>
+#include <cstddef>
+
+namespace Spheral {
+
+class ConnectivityCSR;
+
+//------------------------------------------------------------------------------
+// The neighbors of a node in one NodeList.
+//------------------------------------------------------------------------------
+class NeighborSpan {
+public:
+  typedef int value_type;
+  typedef size_t size_type;
+  typedef const int& const_reference;
+  typedef const int* const_iterator;
+  typedef const int* iterator;
+
+  NeighborSpan(): mBegin(nullptr), mEnd(nullptr) {}
+  NeighborSpan(const int* begin, const int* end): mBegin(begin), mEnd(end) {}
+
+  const_iterator begin()                    const { return mBegin; }
+  const_iterator end()                      const { return mEnd; }
+  const int* data()                         const { return mBegin; }
+  size_type size()                          const { return mEnd - mBegin; }
+  bool empty()                              const { return mEnd == mBegin; }
+  const_reference operator[](size_type i)   const { return mBegin[i]; }
+  const_reference front()                   const { return *mBegin; }
+  const_reference back()                    const { return *(mEnd - 1); }
+
+  // Copy out as a std::vector.
+  operator std::vector<int>()               const { return std::vector<int>(mBegin, mEnd); }
+
+private:
+  const int* mBegin;
+  const int* mEnd;
+};
+
+//------------------------------------------------------------------------------
+// The neighbors of a node in all NodeLists.
+//------------------------------------------------------------------------------
+class NodeConnectivity {
+public:
+  typedef NeighborSpan value_type;
+  typedef size_t size_type;
+
+  // Iterate over the NeighborSpans for each NodeList.
+  class const_iterator {
+  public:
+    const_iterator(const NodeConnectivity& owner, size_type index): mOwner(&owner), mIndex(index) {}
+    NeighborSpan operator*()                          const { return (*mOwner)[mIndex]; }
+    const_iterator& operator++()                            { ++mIndex; return *this; }
+    bool operator==(const const_iterator& rhs)        const { return mIndex == rhs.mIndex; }
+    bool operator!=(const const_iterator& rhs)        const { return mIndex != rhs.mIndex; }
+  private:
+    const NodeConnectivity* mOwner;
+    size_type mIndex;
+  };
+
+  NodeConnectivity(const ConnectivityCSR& storage, const size_t row): mStorage(&storage), mRow(row) {}
+
+  size_type size() const;
+  bool empty() const                                    { return this->size() == 0u; }
+  NeighborSpan operator[](const size_type nodeListj) const;
+  const_iterator begin()                          const { return const_iterator(*this, 0u); }
+  const_iterator end()                            const { return const_iterator(*this, this->size()); }
+
+  // Copy out as nested std::vectors.
+  operator std::vector<std::vector<int>>() const;
+
+private:
+  const ConnectivityCSR* mStorage;
+  size_t mRow;
+};
+
+//------------------------------------------------------------------------------
+// The storage.
+//------------------------------------------------------------------------------
+class ConnectivityCSR {
+public:
+  typedef std::vector<std::vector<std::vector<int>>> NestedType;
+
+  ConnectivityCSR();
+
+  // Sizes.
+  size_t numRows() const;
+  unsigned numNodeLists() const;
+  size_t numNeighbors() const;
+  bool empty() const;
+  void clear();
+
+  // Access the neighbors of a row, optionally restricted to a NodeList.
+  NodeConnectivity operator[](const size_t row) const;
+  NeighborSpan operator()(const size_t row, const unsigned nodeListj) const;
+
+  // Mutable access to a run, e.g., for reordering the neighbors in place.
+  int* begin(const size_t row, const unsigned nodeListj);
+  int* end(const size_t row, const unsigned nodeListj);
+
+  // Convert to/from the nested [row][NodeList][neighbor] layout.
+  void assign(const NestedType& nested);
+  NestedType nested() const;
+
+  // Parallel build.  beginBuild must be called outside any parallel region,
+  // after which any thread may set each (row, NodeList) run at most once (unset
+  // runs are empty).  finishBuild then assembles the storage.
+  void beginBuild(const size_t numRows, const unsigned numNodeLists);
+  void setRun(const size_t row, const unsigned nodeListj, const int* begin, const int* end);
+  void finishBuild();
+
+  // Bytes of heap memory used.
+  size_t memoryUsage() const;
+
+private:
+  unsigned mNumNodeLists;
+  std::vector<size_t> mOffsets;
+  std::vector<int> mNeighbors;
+
+  // Build scratch: per thread buffers, and where each run was stored.
+  std::vector<std::vector<int>> mThreadBuffers;
+  std::vector<int> mRunThread;
+  std::vector<size_t> mRunStart, mRunSize;
+};
+
+}
+
+#include "ConnectivityCSRInline.hh"
+
+#endif
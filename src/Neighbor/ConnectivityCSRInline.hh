@@ -0,0 +1,122 @@
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/DBC.hh"
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// NodeConnectivity
+//------------------------------------------------------------------------------
+inline
+NodeConnectivity::size_type
+NodeConnectivity::
+size() const {
+  return mStorage->numNodeLists();
+}
+
+inline
+NeighborSpan
+NodeConnectivity::
+operator[](const size_type nodeListj) const {
+  return (*mStorage)(mRow, nodeListj);
+}
+
+inline
+NodeConnectivity::
+operator std::vector<std::vector<int>>() const {
+  std::vector<std::vector<int>> result;
+  result.reserve(this->size());
+  for (auto nodeListj = 0u; nodeListj < this->size(); ++nodeListj) result.push_back((*this)[nodeListj]);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// ConnectivityCSR sizes.
+//------------------------------------------------------------------------------
+inline
+size_t
+ConnectivityCSR::
+numRows() const {
+  return (mNumNodeLists == 0u ? 0u : (mOffsets.size() - 1u)/mNumNodeLists);
+}
+
+inline
+unsigned
+ConnectivityCSR::
+numNodeLists() const {
+  return mNumNodeLists;
+}
+
+inline
+size_t
+ConnectivityCSR::
+numNeighbors() const {
+  return mNeighbors.size();
+}
+
+inline
+bool
+ConnectivityCSR::
+empty() const {
+  return this->numRows() == 0u;
+}
+
+//------------------------------------------------------------------------------
+// Access.
+//------------------------------------------------------------------------------
+inline
+NodeConnectivity
+ConnectivityCSR::
+operator[](const size_t row) const {
+  REQUIRE(row < this->numRows());
+  return NodeConnectivity(*this, row);
+}
+
+inline
+NeighborSpan
+ConnectivityCSR::
+operator()(const size_t row, const unsigned nodeListj) const {
+  REQUIRE(row < this->numRows() and nodeListj < mNumNodeLists);
+  const auto k = row*mNumNodeLists + nodeListj;
+  const auto* base = mNeighbors.data();
+  return NeighborSpan(base + mOffsets[k], base + mOffsets[k + 1u]);
+}
+
+inline
+int*
+ConnectivityCSR::
+begin(const size_t row, const unsigned nodeListj) {
+  REQUIRE(row < this->numRows() and nodeListj < mNumNodeLists);
+  return mNeighbors.data() + mOffsets[row*mNumNodeLists + nodeListj];
+}
+
+inline
+int*
+ConnectivityCSR::
+end(const size_t row, const unsigned nodeListj) {
+  REQUIRE(row < this->numRows() and nodeListj < mNumNodeLists);
+  return mNeighbors.data() + mOffsets[row*mNumNodeLists + nodeListj + 1u];
+}
+
+//------------------------------------------------------------------------------
+// Set the neighbors of a (row, NodeList) run during a build.
+//------------------------------------------------------------------------------
+inline
+void
+ConnectivityCSR::
+setRun(const size_t row, const unsigned nodeListj, const int* begin, const int* end) {
+  REQUIRE(nodeListj < mNumNodeLists);
+  const auto k = row*mNumNodeLists + nodeListj;
+  REQUIRE(k < mRunSize.size());
+  const auto n = end - begin;
+  if (n > 0) {
+    const auto ithread = omp_get_thread_num();
+    CHECK(ithread < (int)mThreadBuffers.size());
+    auto& buf = mThreadBuffers[ithread];
+    mRunThread[k] = ithread;
+    mRunStart[k] = buf.size();
+    mRunSize[k] = n;
+    buf.insert(buf.end(), begin, end);
+  }
+}
+
+}
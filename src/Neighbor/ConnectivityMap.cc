@@ -16,8 +16,11 @@
 #include "Utilities/mortonOrderIndices.hh"
 #include "Utilities/PairComparisons.hh"
 #include "Utilities/Timer.hh"
+#include "Utilities/OpenMP_wrapper.hh"
 
 #include <algorithm>
+#include <memory>
+#include <cmath>
 #include <ctime>
 using std::vector;
 using std::map;
@@ -53,6 +56,41 @@ appendSTLvectors(std::vector<T>& v1, std::vector<T>& v2) {
   }
 }
 
+//------------------------------------------------------------------------------
+// Sort in parallel: each thread sorts a contiguous chunk, and the chunks are
+// then merged pairwise.  The comparator should be a strict total order if the
+// result must not depend on the number of threads.
+//------------------------------------------------------------------------------
+template<typename RandomAccessIterator, typename Comparator>
+inline
+void
+parallelSort(RandomAccessIterator first, RandomAccessIterator last, Comparator comp) {
+  typedef typename std::iterator_traits<RandomAccessIterator>::difference_type DifferenceType;
+  const DifferenceType n = std::distance(first, last);
+  const int nchunks = std::min(DifferenceType(omp_get_max_threads()), n/4096 + 1);
+  if (nchunks < 2) {
+    std::sort(first, last, comp);
+    return;
+  }
+  vector<DifferenceType> bounds(nchunks + 1);
+  for (auto k = 0; k <= nchunks; ++k) bounds[k] = (n*k)/nchunks;
+#pragma omp parallel for
+  for (auto k = 0; k < nchunks; ++k) std::sort(first + bounds[k], first + bounds[k + 1], comp);
+  for (auto width = 1; width < nchunks; width *= 2) {
+#pragma omp parallel for
+    for (auto k = 0; k < nchunks - width; k += 2*width) {
+      std::inplace_merge(first + bounds[k], first + bounds[k + width], first + bounds[std::min(k + 2*width, nchunks)], comp);
+    }
+  }
+}
+
+template<typename RandomAccessIterator>
+inline
+void
+parallelSort(RandomAccessIterator first, RandomAccessIterator last) {
+  parallelSort(first, last, std::less<typename std::iterator_traits<RandomAccessIterator>::value_type>());
+}
+
 //------------------------------------------------------------------------------
 // How should we compare pairs for sorting?
 //------------------------------------------------------------------------------
@@ -107,19 +145,24 @@ void
 sortPairs(NodePairList& pairs,
           const KeyContainer& keys) {
   // Start by making sure the pairs themselves are deterministically arranged.
-  for (auto& p: pairs) {
+  const auto npairs = pairs.size();
+#pragma omp parallel for
+  for (auto k = 0u; k < npairs; ++k) {
+    auto& p = pairs[k];
     if (keys(p.i_list, p.i_node) > keys(p.j_list, p.j_node)) {
       std::swap(p.i_list, p.j_list);
       std::swap(p.i_node, p.j_node);
     }
   }
 
-  // Now sort the list as a whole.
-  std::sort(pairs.begin(), pairs.end(),
-            [&](const NodePairIdxType& a, const NodePairIdxType& b) {
-              return hashKeys(keys(a.i_list, a.i_node), keys(a.j_list, a.j_node)) <
-                hashKeys(keys(b.i_list, b.i_node), keys(b.j_list, b.j_node));
-            });
+  // Now sort the list as a whole.  Pairs with the same hash are ordered by
+  // index so the result does not depend on the number of threads.
+  parallelSort(pairs.begin(), pairs.end(),
+               [&](const NodePairIdxType& a, const NodePairIdxType& b) {
+                 const auto hasha = hashKeys(keys(a.i_list, a.i_node), keys(a.j_list, a.j_node));
+                 const auto hashb = hashKeys(keys(b.i_list, b.i_node), keys(b.j_list, b.j_node));
+                 return (hasha < hashb or (hasha == hashb and a < b));
+               });
 }
 
 }
@@ -135,8 +178,25 @@ ConnectivityMap():
   mBuildGhostConnectivity(false),
   mBuildOverlapConnectivity(false),
   mConnectivity(),
+  mNodePairList(),
+  mActiveNodePairList(),
+  mNodePairsRestricted(false),
+  mNumInteriorNodePairs(0u),
+  mNumActiveInteriorNodePairs(0u),
+  mNodePairGeneration(0u),
+  mCompleteGhostExchange(),
   mNodeTraversalIndices(),
-  mKeys(FieldStorageType::CopyFields) {
+  mKeys(FieldStorageType::CopyFields),
+  mVerletSkin(0.0),
+  mVerletReused(false),
+  mVerletGhostConnectivity(false),
+  mVerletCandidates(),
+  mVerletNodeLists(),
+  mVerletPositions(),
+  mVerletH(),
+  mVerletNumNodes(),
+  mVerletNumInternalNodes(),
+  mRedistribution(registerWithRedistribution(*this, &ConnectivityMap<Dimension>::notifyAfterRedistribution)) {
 }
 
 //------------------------------------------------------------------------------
@@ -157,6 +217,11 @@ patchConnectivity(const FieldList<Dimension, int>& flags,
                   const FieldList<Dimension, int>& old2new) {
   TIME_ConnectivityMap_patch.start();
 
+  // We leave any Verlet candidates alone:  they are indexed by the ghost nodes
+  // as the boundaries create them in setGhostNodes (before culling), which is
+  // the numbering we see at the next full connectivity update.  If the counts
+  // don't match at that point verletCandidatesValid forces a full search.
+
   const auto domainDecompIndependent = NodeListRegistrar<Dimension>::instance().domainDecompositionIndependent();
 
   // We have to recompute the keys to sort nodes by excluding the 
@@ -171,6 +236,10 @@ patchConnectivity(const FieldList<Dimension, int>& flags,
     }
   }
 
+  // Patching changes the number of neighbors per node, so we work on the
+  // nested layout and recompress when we're done.
+  auto connectivity = mConnectivity.nested();
+
   // Iterate over the Connectivity (NodeList).
   for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
     const auto ioff = mOffsets[iNodeList];
@@ -195,7 +264,7 @@ patchConnectivity(const FieldList<Dimension, int>& flags,
         } else {
           if (domainDecompIndependent) keys_thread.push_back(std::make_pair(old2new(iNodeList, i), mKeys(iNodeList, i)));
           mNodeTraversalIndices[iNodeList][i] = old2new(iNodeList, i);
-          auto& neighbors = mConnectivity[ioff + i];
+          auto& neighbors = connectivity[ioff + i];
           CHECK(neighbors.size() == numNodeLists);
           for (auto jNodeList = 0u; jNodeList < numNodeLists; ++jNodeList) {
             vector<pair<int, Key>> nkeys;
@@ -258,6 +327,7 @@ patchConnectivity(const FieldList<Dimension, int>& flags,
       }
     }
   }
+  mConnectivity.assign(connectivity);
   
   // We also need to patch the node pair structure
   NodePairList culledPairs;
@@ -288,7 +358,25 @@ patchConnectivity(const FieldList<Dimension, int>& flags,
     // sort(mNodePairList.begin(), mNodePairList.end(), [this](const NodePairIdxType& a, const NodePairIdxType& b) { return (mKeys(a.i_list, a.i_node) + mKeys(a.j_list, a.j_node)) < (mKeys(b.i_list, b.i_node) + mKeys(b.j_list, b.j_node)); });
     // sort(mNodePairList.begin(), mNodePairList.end(), [this](const NodePairIdxType& a, const NodePairIdxType& b) { return hashKeys(mKeys(a.i_list, a.i_node), mKeys(a.j_list, a.j_node)) < hashKeys(mKeys(b.i_list, b.i_node), mKeys(b.j_list, b.j_node)); });
     sortPairs(mNodePairList, mKeys);
+  } else {
+    parallelSort(mNodePairList.begin(), mNodePairList.end());
+  }
+
+  // The NodeLists have not been resized yet, but the internal nodes we keep
+  // are numbered first, so the new first ghost node is just the number of
+  // internal nodes surviving the cull.
+  {
+    vector<int> firstGhostNode(numNodeLists, 0);
+    for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+      const auto n = mNodeLists[iNodeList]->firstGhostNode();
+      for (auto i = 0u; i < n; ++i) {
+        if (flags(iNodeList, i) != 0) ++firstGhostNode[iNodeList];
+      }
+    }
+    this->partitionNodePairs(firstGhostNode);
   }
+  this->unrestrictNodePairs();
+  this->nodePairsChanged();
 
   // You can't check valid yet 'cause the NodeLists have not been resized
   // when we call patch!  The valid method should be checked by whoever called
@@ -343,6 +431,96 @@ connectivityIntersectionForNodes(const int nodeListi, const int i,
   return result;
 }
 
+//------------------------------------------------------------------------------
+// Restrict the NodePairList to pairs involving active internal nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+restrictNodePairs(const FieldList<Dimension, int>& active) {
+  REQUIRE(active.numFields() == mNodeLists.size());
+  const auto numNodeLists = mNodeLists.size();
+  vector<unsigned> numInternal(numNodeLists);
+  for (auto k = 0u; k < numNodeLists; ++k) numInternal[k] = mNodeLists[k]->numInternalNodes();
+
+  // Keep the pairs in their original order, so the restricted list is sorted
+  // the same way as the full list.
+  const auto npairs = mNodePairList.size();
+  vector<char> keep(npairs);
+#pragma omp parallel for
+  for (auto k = 0u; k < npairs; ++k) {
+    const auto& pair = mNodePairList[k];
+    keep[k] = ((pair.i_node < int(numInternal[pair.i_list]) and active(pair.i_list, pair.i_node) != 0) or
+               (pair.j_node < int(numInternal[pair.j_list]) and active(pair.j_list, pair.j_node) != 0));
+  }
+  mActiveNodePairList.clear();
+  mNumActiveInteriorNodePairs = 0u;
+  for (auto k = 0u; k < npairs; ++k) {
+    if (keep[k]) {
+      mActiveNodePairList.push_back(mNodePairList[k]);
+      if (k < mNumInteriorNodePairs) ++mNumActiveInteriorNodePairs;
+    }
+  }
+  mNodePairsRestricted = true;
+  this->nodePairsChanged();
+}
+
+//------------------------------------------------------------------------------
+// Lift any restriction on the NodePairList.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+unrestrictNodePairs() {
+  if (mNodePairsRestricted) this->nodePairsChanged();
+  mNodePairsRestricted = false;
+  mActiveNodePairList.clear();
+  mNumActiveInteriorNodePairs = 0u;
+}
+
+//------------------------------------------------------------------------------
+// Partition the NodePairList into the pairs between internal nodes followed
+// by those touching ghost nodes, preserving the sorted order within each set.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+partitionNodePairs() {
+  const auto numNodeLists = mNodeLists.size();
+  vector<int> firstGhostNode(numNodeLists);
+  for (auto k = 0u; k < numNodeLists; ++k) firstGhostNode[k] = mNodeLists[k]->firstGhostNode();
+  this->partitionNodePairs(firstGhostNode);
+}
+
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+partitionNodePairs(const vector<int>& firstGhostNode) {
+  REQUIRE(firstGhostNode.size() == mNodeLists.size());
+  if (NodeListRegistrar<Dimension>::instance().domainDecompositionIndependent()) {
+    mNumInteriorNodePairs = 0u;
+  } else {
+    const auto itr = std::stable_partition(mNodePairList.begin(), mNodePairList.end(),
+                                           [&](const NodePairIdxType& pair) {
+                                             return (pair.i_node < firstGhostNode[pair.i_list] and
+                                                     pair.j_node < firstGhostNode[pair.j_list]);
+                                           });
+    mNumInteriorNodePairs = std::distance(mNodePairList.begin(), itr);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Note the NodePairList has changed:  any cached pair geometry is stale, and
+// consumers keyed on the pair generation must recompute.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+nodePairsChanged() {
+  mPairGeometry.clear();
+  ++mNodePairGeneration;
+}
+
 //------------------------------------------------------------------------------
 // Remove connectivity between neighbors.
 // NOTE: this method assumes you are passing the indices of the neighbors to
@@ -357,17 +535,19 @@ removeConnectivity(const FieldList<Dimension, vector<vector<int>>>& neighborsToC
   const auto numNodeLists = mNodeLists.size();
   REQUIRE(neighborsToCut.numFields() == numNodeLists);
 
+  auto connectivity = mConnectivity.nested();
   for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
     const auto n = mNodeLists[nodeListi]->numNodes();
     for (auto i = 0u; i < n; ++i) {
       const auto& allneighbors = neighborsToCut(nodeListi, i);
       CHECK(allneighbors.size() == 0 or allneighbors.size() == numNodeLists);
       for (auto nodeListj = 0u; nodeListj < allneighbors.size(); ++nodeListj) {
-        auto& neighborsi = mConnectivity[mOffsets[nodeListi] + i][nodeListj];
+        auto& neighborsi = connectivity[mOffsets[nodeListi] + i][nodeListj];
         removeElements(neighborsi, allneighbors[nodeListj]);
       }
     }
   }
+  mConnectivity.assign(connectivity);
 
   TIME_ConnectivityMap_cutConnectivity.stop();
 }
@@ -440,12 +620,12 @@ globalConnectivity(vector<Boundary<Dimension>*>& boundaries) const {
       const int gid = globalIDs(nodeListi, i);
       result[gid] = vector<int>();
 
-      const vector< vector<int> >& fullConnectivity = connectivityForNode(nodeListPtr, i);
+      const auto fullConnectivity = connectivityForNode(nodeListPtr, i);
       CHECK(fullConnectivity.size() == numNodeLists);
       for (size_t nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
+        const auto connectivity = fullConnectivity[nodeListj];
 
-        for (typename vector<int>::const_iterator jItr = connectivity.begin();
+        for (auto jItr = connectivity.begin();
              jItr != connectivity.end();
              ++jItr) result[gid].push_back(globalIDs(nodeListj, *jItr));
 
@@ -493,8 +673,8 @@ valid() const {
     const int numNodes = (ghostConnectivity ? 
                           mNodeLists.back()->numNodes() : 
                           mNodeLists.back()->numInternalNodes());
-    if ((int)mConnectivity.size() != mOffsets.back() + numNodes) {
-      cerr << "ConnectivityMap::valid: Failed offset bounding: " << mConnectivity.size() << " != " << mOffsets.back() << " + " << numNodes << endl;
+    if ((int)mConnectivity.numRows() != mOffsets.back() + numNodes) {
+      cerr << "ConnectivityMap::valid: Failed offset bounding: " << mConnectivity.numRows() << " != " << mOffsets.back() << " + " << numNodes << endl;
     }
   }
 
@@ -527,7 +707,7 @@ valid() const {
                           nodeListPtri->numInternalNodes());
     //const int firstGhostNodei = nodeListPtri->firstGhostNode();
     if ((((int)nodeListIDi < numNodeLists - 1) and ((int)(mOffsets[nodeListIDi + 1] - mOffsets[nodeListIDi]) != numNodes)) or
-        (((int)nodeListIDi == numNodeLists - 1) and ((int)(mConnectivity.size() - mOffsets[nodeListIDi]) != numNodes))) {
+        (((int)nodeListIDi == numNodeLists - 1) and ((int)(mConnectivity.numRows() - mOffsets[nodeListIDi]) != numNodes))) {
       cerr << "ConnectivityMap::valid: Failed test that all nodes set for NodeList "
            << mNodeLists[nodeListIDi]->name()
            << endl;
@@ -540,7 +720,7 @@ valid() const {
 
       // The set of neighbors for this node.  This has to be sized as the number of
       // NodeLists.
-      const vector< vector<int> >& allNeighborsForNode = mConnectivity[ioff + i];
+      const auto allNeighborsForNode = mConnectivity[ioff + i];
       if ((int)allNeighborsForNode.size() != numNodeLists) {
         cerr << "ConnectivityMap::valid: Failed allNeighborsForNode.size() == numNodeLists" << endl;
         return false;
@@ -550,12 +730,12 @@ valid() const {
       for (int nodeListIDj = 0; nodeListIDj != numNodeLists; ++nodeListIDj) {
         const NodeList<Dimension>* nodeListPtrj = mNodeLists[nodeListIDj];
         //const int firstGhostNodej = nodeListPtrj->firstGhostNode();
-        const vector<int>& neighbors = allNeighborsForNode[nodeListIDj];
+        const auto neighbors = allNeighborsForNode[nodeListIDj];
 
         // We require that the node IDs be sorted, unique, and of course in a valid range.
         if (neighbors.size() > 0) {
-          const int minNeighbor = *min_element(neighbors.begin(), neighbors.end());
-          const int maxNeighbor = *max_element(neighbors.begin(), neighbors.end());
+          const int minNeighbor = *std::min_element(neighbors.begin(), neighbors.end());
+          const int maxNeighbor = *std::max_element(neighbors.begin(), neighbors.end());
 
           if (minNeighbor < 0 or maxNeighbor >= (int)nodeListPtrj->numNodes()) {
             cerr << "ConnectivityMap::valid: Failed test that neighbors must be valid IDs: " << minNeighbor << " " << maxNeighbor << " " << nodeListPtrj->numNodes() << endl;
@@ -576,7 +756,7 @@ valid() const {
               if (mKeys(nodeListIDj, neighbors[k]) < mKeys(nodeListIDj, neighbors[k - 1])) {
                 cerr << "ConnectivityMap::valid: Failed test that neighbors must be sorted for node "
                      << i << endl;
-                for (vector<int>::const_iterator itr = neighbors.begin();
+                for (auto itr = neighbors.begin();
                      itr != neighbors.end();
                      ++itr) cerr << "(" << *itr << " " << mKeys(nodeListIDj, *itr) << ") ";
                 cerr << endl;
@@ -587,7 +767,7 @@ valid() const {
               // Otherwise they should be sorted by local ID.
               if (neighbors[k] <= neighbors[k - 1]) {
                 cerr << "ConnectivityMap::valid: Failed test that neighbors must be sorted" << endl;
-                for (vector<int>::const_iterator itr = neighbors.begin();
+                for (auto itr = neighbors.begin();
                      itr != neighbors.end();
                      ++itr) cerr << " " << *itr;
                 cerr << endl;
@@ -598,14 +778,14 @@ valid() const {
         }
 
         // Check that the connectivity is symmetric.
-        for (vector<int>::const_iterator jItr = neighbors.begin();
+        for (auto jItr = neighbors.begin();
              jItr != neighbors.end();
              ++jItr) {
           if (ghostConnectivity or (int)(*jItr < (int)nodeListPtrj->numInternalNodes())) {
-            const vector< vector<int> >& otherNeighbors = connectivityForNode(nodeListPtrj, *jItr);
-            if (find(otherNeighbors[nodeListIDi].begin(),
-                     otherNeighbors[nodeListIDi].end(),
-                     i) == otherNeighbors[nodeListIDi].end()) {
+            const auto otherNeighbors = connectivityForNode(nodeListPtrj, *jItr);
+            if (std::find(otherNeighbors[nodeListIDi].begin(),
+                          otherNeighbors[nodeListIDi].end(),
+                          i) == otherNeighbors[nodeListIDi].end()) {
               cerr << "ConnectivityMap::valid: Failed test that neighbors must be symmetric: " 
                    << i << " <> " << *jItr 
                    << "  numneigbors(i)=" << neighbors.size() 
@@ -737,21 +917,8 @@ computeConnectivity() {
              connectivitySize = mOffsets.back() + (ghostConnectivity ?
                                                    mNodeLists.back()->numNodes() :
                                                    mNodeLists.back()->numInternalNodes());
-  const bool ok = (connectivitySize > 0 and mConnectivity.size() == connectivitySize);
-  if (ok) {
-    CHECK(mNodeTraversalIndices.size() == numNodeLists);
-    for (typename ConnectivityStorageType::iterator itr = mConnectivity.begin();
-         itr != mConnectivity.end();
-         ++itr) {
-      CHECK(itr->size() == numNodeLists);
-      for (unsigned k = 0; k != numNodeLists; ++k) {
-        (*itr)[k].clear();
-      }
-    }
-  } else {
-    mConnectivity = ConnectivityStorageType(connectivitySize, vector<vector<int> >(numNodeLists));
-    mNodeTraversalIndices = vector<vector<int> >(numNodeLists);
-  }
+  mConnectivity.beginBuild(connectivitySize, numNodeLists);
+  mNodeTraversalIndices.resize(numNodeLists);
   mNodePairList.clear();
 
   // If we're trying to be domain decomposition independent, we need a key to sort
@@ -765,12 +932,16 @@ computeConnectivity() {
   if (domainDecompIndependent) {
     for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
       const NodeList<Dimension>& nodeList = *mNodeLists[iNodeList];
-      mNodeTraversalIndices[iNodeList].resize(nodeList.numNodes());
-      vector<pair<int, Key> > keys;
-      keys.reserve(nodeList.numNodes());
-      for (auto i = 0u; i != nodeList.numNodes(); ++i) keys.push_back(pair<int, Key>(i, mKeys(iNodeList, i)));
-      sort(keys.begin(), keys.end(), ComparePairsBySecondElement<pair<int, Key> >());
-      for (auto i = 0u; i != nodeList.numNodes(); ++i) mNodeTraversalIndices[iNodeList][i] = keys[i].first;
+      const auto n = nodeList.numNodes();
+      mNodeTraversalIndices[iNodeList].resize(n);
+      vector<pair<int, Key> > keys(n);
+#pragma omp parallel for
+      for (auto i = 0u; i < n; ++i) keys[i] = pair<int, Key>(i, mKeys(iNodeList, i));
+      parallelSort(keys.begin(), keys.end(), [](const pair<int, Key>& a, const pair<int, Key>& b) {
+          return (a.second < b.second or (a.second == b.second and a.first < b.first));
+        });
+#pragma omp parallel for
+      for (auto i = 0u; i < n; ++i) mNodeTraversalIndices[iNodeList][i] = keys[i].first;
       CHECK(mNodeTraversalIndices[iNodeList].size() == nodeList.numNodes());
       // std::cerr << "Traversal: ";
       // std::copy(mNodeTraversalIndices[iNodeList].begin(), mNodeTraversalIndices[iNodeList].end(), std::ostream_iterator<int>(std::cerr, " "));
@@ -792,121 +963,110 @@ computeConnectivity() {
   const FieldList<Dimension, Vector> position = dataBase.globalPosition();
   const FieldList<Dimension, SymTensor> H = dataBase.globalHfield();
 
-  // Iterate over the NodeLists.
-  // std::clock_t t0, 
-  //   tmaster = std::clock_t(0), 
-  //   trefine = std::clock_t(0), 
-  //   twalk = std::clock_t(0);
-  CHECK(mConnectivity.size() == connectivitySize);
-  for (auto iiNodeList = 0u; iiNodeList != numNodeLists; ++iiNodeList) {
-    const auto etaMax = mNodeLists[iiNodeList]->neighbor().kernelExtent();
-
-    // Iterate over the nodes in this NodeList, and look for any that are not done yet.
-    const auto nii = (ghostConnectivity ?
-                      mNodeLists[iiNodeList]->numNodes() :
-                      mNodeLists[iiNodeList]->numInternalNodes());
-    for (auto ii = 0u; ii < nii; ++ii) {
-      if (flagNodeDone(iiNodeList, ii) == 0) {
-
-        // Set the master nodes.
-        // t0 = std::clock();
-        vector<vector<int>> masterLists, coarseNeighbors;
-        Neighbor<Dimension>::setMasterNeighborGroup(position(iiNodeList, ii),
-                                                    H(iiNodeList, ii),
-                                                    mNodeLists.begin(),
-                                                    mNodeLists.end(),
-                                                    etaMax,
-                                                    masterLists,
-                                                    coarseNeighbors,
-                                                    ghostConnectivity);
-
-        // Iterate over the full of NodeLists again to work on the master nodes.
-        for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
-          const auto nmaster = masterLists[iNodeList].size();
-#pragma omp parallel 
-          {
-            NodePairList nodePairs_private;
-#pragma omp for schedule(dynamic)
-            for (auto k = 0u; k < nmaster; ++k) {
-              const auto i = masterLists[iNodeList][k];
-              CHECK2(flagNodeDone(iNodeList, i) == 0, "(" << iNodeList << " " << i << ")");
-
-              // Get the state for this node.
-              const auto& ri = position(iNodeList, i);
-              const auto& Hi = H(iNodeList, i);
-              auto&       worki = mNodeLists[iNodeList]->work();
-              CHECK2(mOffsets[iNodeList] + i < (int)mConnectivity.size(),
-                     iNodeList << " " << i << " " << mOffsets[iNodeList] << " " << mConnectivity.size());
-              const auto start = Timing::currentTime();
-
-              // Get the neighbor set we're building for this node.
-              auto& neighbors = mConnectivity[mOffsets[iNodeList] + i];
-              CHECK2(neighbors.size() == numNodeLists, neighbors.size() << " " << numNodeLists << " " << i);
-
-              // We keep track of the Morton indices.
-              vector<vector<pair<int, Key>>> keys(numNodeLists);
-
-              // Iterate over the neighbor NodeLists.
-              for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
-                const auto firstGhostNodej = mNodeLists[jNodeList]->firstGhostNode();
-
-                // Iterate over the coarse neighbors in this NodeList.
-                // t0 = std::clock();
-                for (const auto j:  coarseNeighbors[jNodeList]) {
-                  const auto& rj = position(jNodeList, j);
-                  const auto& Hj = H(jNodeList, j);
-
-                  // Compute the normalized distance between this pair.
-                  const auto rij = ri - rj;
-                  const auto eta2i = (Hi*rij).magnitude2();
-                  const auto eta2j = (Hj*rij).magnitude2();
-
-                  // If this pair is significant, add it to the list.
-                  if (eta2i <= kernelExtent2 or eta2j <= kernelExtent2) {
-
-                    // We don't include self-interactions.
-                    if ((iNodeList != jNodeList) or (i != j)) {
-                      neighbors[jNodeList].push_back(j);
-                      if (calculatePairInteraction(iNodeList, i, jNodeList, j, firstGhostNodej)) 
-                        nodePairs_private.push_back(NodePairIdxType(i, iNodeList, j, jNodeList));
-                      if (domainDecompIndependent) 
-                        keys[jNodeList].push_back(pair<int, Key>(j, mKeys(jNodeList, j)));
-                    }
-                  }
-                }
-                // twalk += std::clock() - t0;
-              }
-              CHECK(neighbors.size() == numNodeLists);
-              CHECK(keys.size() == numNodeLists);
-        
-              // We have a few options for how to order the neighbors for this node.
-              for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
-
-                if (domainDecompIndependent) {
-                  // Sort in a domain independent manner.
-                  CHECK(keys[jNodeList].size() == neighbors[jNodeList].size());
-                  sort(keys[jNodeList].begin(), keys[jNodeList].end(), ComparePairsBySecondElement<pair<int, Key>>());
-                  for (auto j = 0u; j != neighbors[jNodeList].size(); ++j) neighbors[jNodeList][j] = keys[jNodeList][j].first;
-                } else {
-                  // Sort in an attempt to be cache friendly.
-                  sort(neighbors[jNodeList].begin(), neighbors[jNodeList].end());
+  // Are we using (and can we reuse) Verlet candidate lists?
+  const auto useVerlet = (mVerletSkin > 0.0 and not domainDecompIndependent);
+  const auto searchExtent = kernelExtent + (useVerlet ? mVerletSkin : 0.0);
+  const auto searchExtent2 = searchExtent*searchExtent;
+  const auto verletReuse = (useVerlet and this->verletCandidatesValid(position, H, kernelExtent, ghostConnectivity));
+  mVerletReused = verletReuse;
+  if (not useVerlet) this->clearVerletCandidates();
+
+  if (verletReuse) {
+
+    // Just filter the Verlet candidates by the current kernel extent.
+    this->filterVerletCandidates(position, H, kernelExtent2, ghostConnectivity);
+    flagNodeDone = 1;
+
+  } else {
+
+    // Full neighbor search.  In Verlet mode we temporarily extend the Neighbor
+    // search extents by the skin so the coarse neighbor sets include all the
+    // candidates.
+    if (useVerlet) {
+      mVerletCandidates.beginBuild(connectivitySize, numNodeLists);
+      for (auto* nodeListPtr: mNodeLists) {
+        auto& neighbor = nodeListPtr->neighbor();
+        neighbor.kernelExtent(neighbor.kernelExtent() + mVerletSkin);
+        neighbor.updateNodes();
+      }
+    }
+
+    // One thread walks the nodes, gathering them into master groups (the nodes
+    // sharing a master cell) as it goes.  Each group is handed to a task to find
+    // the neighbors, so the groups are processed concurrently.  The groups are
+    // disjoint, so the only shared state is the NodePairList, which we collect
+    // per thread and merge afterwards.
+    const auto nthreads = omp_get_max_threads();
+    vector<NodePairList> nodePairs_thread(nthreads);
+#pragma omp parallel
+    {
+#pragma omp single
+      {
+        for (auto iiNodeList = 0u; iiNodeList != numNodeLists; ++iiNodeList) {
+          const auto etaMax = mNodeLists[iiNodeList]->neighbor().kernelExtent();   // Includes the Verlet skin if active
+
+          // Iterate over the nodes in this NodeList, and look for any that are not done yet.
+          const auto nii = (ghostConnectivity ?
+                            mNodeLists[iiNodeList]->numNodes() :
+                            mNodeLists[iiNodeList]->numInternalNodes());
+          for (auto ii = 0u; ii < nii; ++ii) {
+            if (flagNodeDone(iiNodeList, ii) == 0) {
+
+              // Set the master nodes, and flag them as done.
+              auto masterLists = std::make_shared<vector<vector<int>>>();
+              auto coarseNeighbors = std::make_shared<vector<vector<int>>>();
+              Neighbor<Dimension>::setMasterNeighborGroup(position(iiNodeList, ii),
+                                                          H(iiNodeList, ii),
+                                                          mNodeLists.begin(),
+                                                          mNodeLists.end(),
+                                                          etaMax,
+                                                          *masterLists,
+                                                          *coarseNeighbors,
+                                                          ghostConnectivity);
+              for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
+                for (const auto i: (*masterLists)[iNodeList]) {
+                  CHECK2(flagNodeDone(iNodeList, i) == 0, "(" << iNodeList << " " << i << ")");
+                  flagNodeDone(iNodeList, i) = 1;
                 }
               }
 
-              // Flag this master node as done.
-              flagNodeDone(iNodeList, i) = 1;
-              worki(i) += Timing::difference(start, Timing::currentTime());
+              // Find the neighbors for the group.
+#pragma omp task default(shared) firstprivate(masterLists, coarseNeighbors)
+              this->computeMasterGroupConnectivity(*masterLists, *coarseNeighbors,
+                                                   position, H,
+                                                   kernelExtent2, searchExtent2,
+                                                   useVerlet, domainDecompIndependent,
+                                                   nodePairs_thread[omp_get_thread_num()]);
             }
-            
-            // Merge the NodePairList
-#pragma omp critical
-            mNodePairList.insert(mNodePairList.end(), nodePairs_private.begin(), nodePairs_private.end());
-          } // end OMP parallel
+          }
         }
       }
     }
+
+    // Merge the per thread NodePairLists.
+    vector<size_t> pairOffsets(nthreads + 1, 0u);
+    for (auto k = 0; k < nthreads; ++k) pairOffsets[k + 1] = pairOffsets[k] + nodePairs_thread[k].size();
+    mNodePairList.resize(pairOffsets.back());
+#pragma omp parallel for
+    for (auto k = 0; k < nthreads; ++k) {
+      std::copy(nodePairs_thread[k].begin(), nodePairs_thread[k].end(), mNodePairList.begin() + pairOffsets[k]);
+    }
+
+    // Restore the Neighbor extents, and remember the state for the candidates.
+    if (useVerlet) {
+      for (auto* nodeListPtr: mNodeLists) {
+        auto& neighbor = nodeListPtr->neighbor();
+        neighbor.kernelExtent(neighbor.kernelExtent() - mVerletSkin);
+        neighbor.updateNodes();
+      }
+      mVerletCandidates.finishBuild();
+      this->storeVerletReference(position, H, ghostConnectivity);
+    }
   }
 
+  // Assemble the compressed connectivity.
+  mConnectivity.finishBuild();
+
   // // If necessary add ghost->internal connectivity.
   // if (ghostConnectivity) {
   //   for (auto iNodeList = 0; iNodeList < numNodeLists; ++iNodeList) {
@@ -944,31 +1104,38 @@ computeConnectivity() {
   if (domainDecompIndependent) {
     for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
       const auto* nodeListPtr = mNodeLists[iNodeList];
-      for (auto i = nodeListPtr->firstGhostNode();
-           i != nodeListPtr->numNodes();
-           ++i) {
-        auto& neighbors = mConnectivity[mOffsets[iNodeList] + i];
-        CHECK(neighbors.size() == numNodeLists);
+      const auto firstGhostNode = nodeListPtr->firstGhostNode();
+      const auto numNodes = nodeListPtr->numNodes();
+#pragma omp parallel for schedule(dynamic, 64)
+      for (auto i = firstGhostNode; i < numNodes; ++i) {
+        const auto row = mOffsets[iNodeList] + i;
         for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
+          auto* neighbors = mConnectivity.begin(row, jNodeList);
+          const auto n = mConnectivity.end(row, jNodeList) - neighbors;
           vector<pair<int, Key>> keys;
-          keys.reserve(neighbors[jNodeList].size());
-          for (auto itr = neighbors[jNodeList].begin();
-               itr != neighbors[jNodeList].end();
-               ++itr) keys.push_back(pair<int, Key>(*itr, mKeys(jNodeList, *itr)));
-          CHECK(keys.size() == neighbors[jNodeList].size());
+          keys.reserve(n);
+          for (auto k = 0; k != n; ++k) keys.push_back(pair<int, Key>(neighbors[k], mKeys(jNodeList, neighbors[k])));
           sort(keys.begin(), keys.end(), ComparePairsBySecondElement<pair<int, Key> >());
-          for (auto k = 0u; k != keys.size(); ++k) neighbors[jNodeList][k] = keys[k].first;
+          for (auto k = 0; k != n; ++k) neighbors[k] = keys[k].first;
         }
       }
     }
   }
 
   // Sort the NodePairList in order to enforce domain decomposition independence.
+  // Otherwise we still sort by (i, j) so that consecutive pairs share the same
+  // node i and walk memory in blocks, rather than the order threads happened to
+  // append them in.
   if (domainDecompIndependent) {
     // sort(mNodePairList.begin(), mNodePairList.end(), [this](const NodePairIdxType& a, const NodePairIdxType& b) { return (mKeys(a.i_list, a.i_node) + mKeys(a.j_list, a.j_node)) < (mKeys(b.i_list, b.i_node) + mKeys(b.j_list, b.j_node)); });
     // sort(mNodePairList.begin(), mNodePairList.end(), [this](const NodePairIdxType& a, const NodePairIdxType& b) { return hashKeys(mKeys(a.i_list, a.i_node), mKeys(a.j_list, a.j_node)) < hashKeys(mKeys(b.i_list, b.i_node), mKeys(b.j_list, b.j_node)); });
     sortPairs(mNodePairList, mKeys);
+  } else {
+    parallelSort(mNodePairList.begin(), mNodePairList.end());
   }
+  this->partitionNodePairs();
+  this->unrestrictNodePairs();
+  this->nodePairsChanged();
 
   // Do we need overlap connectivity?
   if (mBuildOverlapConnectivity) {
@@ -977,12 +1144,12 @@ computeConnectivity() {
 
     // To start out, *all* neighbors of a node (gather and scatter) are overlap neighbors.  Therefore we
     // first just copy the neighbor connectivity.
-    mOverlapConnectivity = mConnectivity;
+    auto overlapConnectivity = mConnectivity.nested();
 
     for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
       const auto* nodeListPtr = mNodeLists[iNodeList];
       for (auto i = 0u; i < nodeListPtr->numNodes(); ++i) {
-        const auto& neighborsi = mConnectivity[mOffsets[iNodeList] + i];
+        const auto neighborsi = mConnectivity[mOffsets[iNodeList] + i];
         CHECK(neighborsi.size() == numNodeLists);
         const auto& ri = position(iNodeList, i);
         const auto& Hi = H(iNodeList, i);
@@ -993,7 +1160,7 @@ computeConnectivity() {
         //     for (auto jN2 = 0; jN2 < numNodeLists; ++jN2) {
         //       for (const auto j2 : neighborsi[jN2]) {
         //         if (!(jN1 == jN2  && j1 == j2)) {
-        //           insertUnique(mOffsets, mOverlapConnectivity, mKeys, domainDecompIndependent,
+        //           insertUnique(mOffsets, overlapConnectivity, mKeys, domainDecompIndependent,
         //                        jN1, j1, jN2, j2);
         //         }
         //       }
@@ -1010,22 +1177,22 @@ computeConnectivity() {
 
               // Check if i and j1 have overlap directly.
               if ((Hj1*(rj1 - ri)).magnitude2() <= kernelExtent2) {
-                insertUnique(mOffsets, mOverlapConnectivity, mKeys, domainDecompIndependent,
+                insertUnique(mOffsets, overlapConnectivity, mKeys, domainDecompIndependent,
                              iNodeList, i, jN1, j1);
-                insertUnique(mOffsets, mOverlapConnectivity, mKeys, domainDecompIndependent,
+                insertUnique(mOffsets, overlapConnectivity, mKeys, domainDecompIndependent,
                              jN1, j1, iNodeList, i);
               }
 
               // Find the gather neighbors of j1, all of which share overlap with i.
-              const auto& neighborsj1 = mConnectivity[mOffsets[jN1] + j1];
+              const auto neighborsj1 = mConnectivity[mOffsets[jN1] + j1];
               for (auto jN2 = 0u; jN2 < numNodeLists; ++jN2) {
                 for (const auto j2: neighborsj1[jN2]) {
                   const auto& rj2 = position(jN2, j2);
                   const auto& Hj2 = H(jN2, j2);
                   if ((Hj2*(rj2 - rj1)).magnitude2() <= kernelExtent2) {                   // Is j2 a scatter neighbor of j1?
-                    insertUnique(mOffsets, mOverlapConnectivity, mKeys, domainDecompIndependent,
+                    insertUnique(mOffsets, overlapConnectivity, mKeys, domainDecompIndependent,
                                  iNodeList, i, jN2, j2);
-                    insertUnique(mOffsets, mOverlapConnectivity, mKeys, domainDecompIndependent,
+                    insertUnique(mOffsets, overlapConnectivity, mKeys, domainDecompIndependent,
                                  jN2, j2, iNodeList, i);
                   }
                 }
@@ -1035,7 +1202,10 @@ computeConnectivity() {
         }
       }
     }
+    mOverlapConnectivity.assign(overlapConnectivity);
     TIME_ConnectivityMap_computeOverlapConnectivity.stop();
+  } else {
+    mOverlapConnectivity.clear();
   }
 
   // {
@@ -1067,4 +1237,279 @@ computeConnectivity() {
   TIME_ConnectivityMap_computeConnectivity.stop();
 }
 
+//------------------------------------------------------------------------------
+// Find the neighbors for a group of master nodes, given the coarse neighbors
+// of the group.  The connectivity of each master node is set independently, so
+// disjoint groups can be processed concurrently.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+computeMasterGroupConnectivity(const vector<vector<int>>& masterLists,
+                               const vector<vector<int>>& coarseNeighbors,
+                               const FieldList<Dimension, typename Dimension::Vector>& position,
+                               const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                               const double kernelExtent2,
+                               const double searchExtent2,
+                               const bool useVerlet,
+                               const bool domainDecompIndependent,
+                               NodePairList& nodePairs) {
+  const auto numNodeLists = mNodeLists.size();
+  REQUIRE(masterLists.size() == numNodeLists and coarseNeighbors.size() == numNodeLists);
+  vector<vector<int>> neighbors(numNodeLists), candidates(numNodeLists);
+  vector<vector<pair<int, Key>>> keys(numNodeLists);
+  for (auto iNodeList = 0u; iNodeList != numNodeLists; ++iNodeList) {
+    for (const auto i: masterLists[iNodeList]) {
+
+      // Get the state for this node.
+      const auto& ri = position(iNodeList, i);
+      const auto& Hi = H(iNodeList, i);
+      auto&       worki = mNodeLists[iNodeList]->work();
+      const auto row = mOffsets[iNodeList] + i;
+      const auto start = Timing::currentTime();
+
+      // Clear the neighbor sets (and Morton indices) we're building for this node.
+      for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
+        neighbors[jNodeList].clear();
+        candidates[jNodeList].clear();
+        keys[jNodeList].clear();
+      }
+
+      // Iterate over the neighbor NodeLists.
+      for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
+        const auto firstGhostNodej = mNodeLists[jNodeList]->firstGhostNode();
+
+        // Iterate over the coarse neighbors in this NodeList.
+        for (const auto j:  coarseNeighbors[jNodeList]) {
+          const auto& rj = position(jNodeList, j);
+          const auto& Hj = H(jNodeList, j);
+
+          // Compute the normalized distance between this pair.
+          const auto rij = ri - rj;
+          const auto eta2i = (Hi*rij).magnitude2();
+          const auto eta2j = (Hj*rij).magnitude2();
+
+          // Remember anything within the Verlet skin as a candidate for later.
+          if (useVerlet and
+              (eta2i <= searchExtent2 or eta2j <= searchExtent2) and
+              ((iNodeList != jNodeList) or (i != j))) candidates[jNodeList].push_back(j);
+
+          // If this pair is significant, add it to the list.
+          if (eta2i <= kernelExtent2 or eta2j <= kernelExtent2) {
+
+            // We don't include self-interactions.
+            if ((iNodeList != jNodeList) or (i != j)) {
+              neighbors[jNodeList].push_back(j);
+              if (calculatePairInteraction(iNodeList, i, jNodeList, j, firstGhostNodej)) 
+                nodePairs.push_back(NodePairIdxType(i, iNodeList, j, jNodeList));
+              if (domainDecompIndependent) 
+                keys[jNodeList].push_back(pair<int, Key>(j, mKeys(jNodeList, j)));
+            }
+          }
+        }
+      }
+      CHECK(neighbors.size() == numNodeLists);
+      CHECK(keys.size() == numNodeLists);
+
+      // We have a few options for how to order the neighbors for this node.
+      for (auto jNodeList = 0u; jNodeList != numNodeLists; ++jNodeList) {
+
+        if (domainDecompIndependent) {
+          // Sort in a domain independent manner.
+          CHECK(keys[jNodeList].size() == neighbors[jNodeList].size());
+          sort(keys[jNodeList].begin(), keys[jNodeList].end(), ComparePairsBySecondElement<pair<int, Key>>());
+          for (auto j = 0u; j != neighbors[jNodeList].size(); ++j) neighbors[jNodeList][j] = keys[jNodeList][j].first;
+        } else {
+          // Sort in an attempt to be cache friendly.
+          sort(neighbors[jNodeList].begin(), neighbors[jNodeList].end());
+          if (useVerlet) sort(candidates[jNodeList].begin(), candidates[jNodeList].end());
+        }
+
+        // Store the neighbors (and candidates).
+        mConnectivity.setRun(row, jNodeList, neighbors[jNodeList].data(), neighbors[jNodeList].data() + neighbors[jNodeList].size());
+        if (useVerlet) mVerletCandidates.setRun(row, jNodeList, candidates[jNodeList].data(), candidates[jNodeList].data() + candidates[jNodeList].size());
+      }
+
+      worki(i) += Timing::difference(start, Timing::currentTime());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Memory used by the connectivity.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+size_t
+ConnectivityMap<Dimension>::
+connectivityMemoryUsage() const {
+  return (mConnectivity.memoryUsage() +
+          mOverlapConnectivity.memoryUsage() +
+          mVerletCandidates.memoryUsage() +
+          mNodePairList.size()*sizeof(NodePairIdxType));
+}
+
+//------------------------------------------------------------------------------
+// Check if the Verlet candidates are still good for the current state.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+ConnectivityMap<Dimension>::
+verletCandidatesValid(const FieldList<Dimension, typename Dimension::Vector>& position,
+                      const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                      const double kernelExtent,
+                      const bool ghostConnectivity) const {
+
+  // Have the NodeLists changed shape since we found the candidates?
+  const auto numNodeLists = mNodeLists.size();
+  if (mVerletCandidates.empty() or
+      ghostConnectivity != mVerletGhostConnectivity or
+      mVerletNodeLists != mNodeLists) return false;
+  for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+    if (mNodeLists[iNodeList]->numNodes() != mVerletNumNodes[iNodeList] or
+        mNodeLists[iNodeList]->numInternalNodes() != mVerletNumInternalNodes[iNodeList]) return false;
+  }
+
+  // A pair (i,j) is in the current connectivity if |H_i r_ij| <= kernelExtent
+  // (or the same in j's metric).  With d_k the displacement of node k since the
+  // full search (H0, r0 at that time),
+  //   |H0_i r0_ij| <= ||H0_i H_i^-1|| |H_i r_ij| + |H0_i d_i| + ||H0_i|| max_k |d_k|,
+  // so the pair is still among the candidates (|H0_i r0_ij| <= kernelExtent + skin)
+  // as long as
+  //   kernelExtent (||H0_i H_i^-1|| - 1) + |H0_i d_i| + ||H0_i|| max_k |d_k| <= skin
+  // for every node i.  The first term is the growth of the smoothing scale of
+  // node i, the remaining two bound the relative displacement of the pair.  We
+  // check every node (including ghosts, which may be reassigned by the
+  // boundaries) since either end of a pair can bring it into range.
+  auto maxDisplacement = 0.0;
+  for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+    const auto& r0 = mVerletPositions[iNodeList];
+    const auto  n = mVerletNumNodes[iNodeList];
+    CHECK(r0.size() == n);
+#pragma omp parallel for reduction(max:maxDisplacement)
+    for (auto i = 0u; i < n; ++i) {
+      maxDisplacement = std::max(maxDisplacement, (position(iNodeList, i) - r0[i]).magnitude());
+    }
+  }
+
+  auto rebuild = false;
+  for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+    const auto& r0 = mVerletPositions[iNodeList];
+    const auto& H0 = mVerletH[iNodeList];
+    const auto  n = mVerletNumNodes[iNodeList];
+    CHECK(H0.size() == n);
+#pragma omp parallel for reduction(||:rebuild)
+    for (auto i = 0u; i < n; ++i) {
+      const auto A = H0[i]*H(iNodeList, i).Inverse();
+      const auto Hgrowth = std::sqrt((A.Transpose()*A).Symmetric().eigenValues().maxElement());
+      const auto H0max = H0[i].eigenValues().maxElement();
+      rebuild = (rebuild or
+                 kernelExtent*(Hgrowth - 1.0) +
+                 (H0[i]*(position(iNodeList, i) - r0[i])).magnitude() +
+                 H0max*maxDisplacement > mVerletSkin);
+    }
+    if (rebuild) return false;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Fill in the connectivity and NodePairList from the Verlet candidates.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+filterVerletCandidates(const FieldList<Dimension, typename Dimension::Vector>& position,
+                       const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                       const double kernelExtent2,
+                       const bool ghostConnectivity) {
+  const auto numNodeLists = mNodeLists.size();
+  REQUIRE(mVerletCandidates.numNodeLists() == numNodeLists);
+  for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+    const auto n = (ghostConnectivity ?
+                    mNodeLists[iNodeList]->numNodes() :
+                    mNodeLists[iNodeList]->numInternalNodes());
+#pragma omp parallel
+    {
+      NodePairList nodePairs_private;
+      vector<int> neighbors;
+#pragma omp for schedule(static)
+      for (auto i = 0u; i < n; ++i) {
+        const auto& ri = position(iNodeList, i);
+        const auto& Hi = H(iNodeList, i);
+        const auto row = mOffsets[iNodeList] + i;
+        const auto candidates = mVerletCandidates[row];
+        for (auto jNodeList = 0u; jNodeList < numNodeLists; ++jNodeList) {
+          const auto firstGhostNodej = mNodeLists[jNodeList]->firstGhostNode();
+          neighbors.clear();
+          for (const auto j: candidates[jNodeList]) {
+            const auto rij = ri - position(jNodeList, j);
+            if ((Hi*rij).magnitude2() <= kernelExtent2 or
+                (H(jNodeList, j)*rij).magnitude2() <= kernelExtent2) {
+              neighbors.push_back(j);    // Candidates are sorted, so neighbors are too
+              if (calculatePairInteraction(iNodeList, i, jNodeList, j, firstGhostNodej))
+                nodePairs_private.push_back(NodePairIdxType(i, iNodeList, j, jNodeList));
+            }
+          }
+          mConnectivity.setRun(row, jNodeList, neighbors.data(), neighbors.data() + neighbors.size());
+        }
+      }
+
+#pragma omp critical
+      mNodePairList.insert(mNodePairList.end(), nodePairs_private.begin(), nodePairs_private.end());
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Remember the state the Verlet candidates were computed for.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+storeVerletReference(const FieldList<Dimension, typename Dimension::Vector>& position,
+                     const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                     const bool ghostConnectivity) {
+  const auto numNodeLists = mNodeLists.size();
+  mVerletGhostConnectivity = ghostConnectivity;
+  mVerletNodeLists = mNodeLists;
+  mVerletNumNodes.resize(numNodeLists);
+  mVerletNumInternalNodes.resize(numNodeLists);
+  mVerletPositions.resize(numNodeLists);
+  mVerletH.resize(numNodeLists);
+  for (auto iNodeList = 0u; iNodeList < numNodeLists; ++iNodeList) {
+    mVerletNumNodes[iNodeList] = mNodeLists[iNodeList]->numNodes();
+    mVerletNumInternalNodes[iNodeList] = mNodeLists[iNodeList]->numInternalNodes();
+    mVerletPositions[iNodeList].assign(position[iNodeList]->begin(), position[iNodeList]->end());
+    mVerletH[iNodeList].assign(H[iNodeList]->begin(), H[iNodeList]->end());
+  }
+}
+
+//------------------------------------------------------------------------------
+// Forget any Verlet candidates.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+clearVerletCandidates() {
+  mVerletCandidates.clear();
+  mVerletNodeLists.clear();
+  mVerletPositions.clear();
+  mVerletH.clear();
+  mVerletNumNodes.clear();
+  mVerletNumInternalNodes.clear();
+  mVerletReused = false;
+}
+
+//------------------------------------------------------------------------------
+// The nodes have been redistributed or reordered, so the stored Verlet
+// candidate indices no longer mean anything.  The connectivity itself is
+// rebuilt by whoever rebuilds the ghost nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ConnectivityMap<Dimension>::
+notifyAfterRedistribution() {
+  this->clearVerletCandidates();
+}
+
 }
@@ -11,9 +11,13 @@
 #include "Utilities/KeyTraits.hh"
 #include "Field/FieldList.hh"
 #include "NodePairList.hh"
+#include "NodePairGeometry.hh"
+#include "ConnectivityCSR.hh"
+#include "Utilities/registerWithRedistribution.hh"
 
 #include <vector>
 #include <map>
+#include <functional>
 
 namespace Spheral {
 
@@ -66,14 +70,73 @@ public:
   const std::vector<const NodeList<Dimension>*>& nodeLists() const;
   const NodePairList& nodePairList() const;
 
+  // Per-pair geometry and kernel values for the NodePairList, which physics
+  // packages may share during a derivative evaluation.
+  NodePairGeometry<Dimension>& pairGeometry() const;
+
+  // A counter incremented every time nodePairList() changes (rebuilding,
+  // patching, or restricting the pairs).
+  size_t nodePairGeneration() const;
+
+  // Optionally restrict nodePairList() to the pairs involving at least one
+  // active internal node (active(nodeList, i) != 0), as used by individual
+  // timestep integrators to only evaluate derivatives for active nodes.
+  // Rebuilding or patching the connectivity lifts any restriction.
+  void restrictNodePairs(const FieldList<Dimension, int>& active);
+  void unrestrictNodePairs();
+  bool nodePairsRestricted() const;
+
+  // The NodePairList is ordered with the pairs between internal nodes first,
+  // followed by the pairs touching ghost nodes, so physics packages can
+  // evaluate the interior pairs while ghost values are still in flight.
+  // numInteriorNodePairs is the number of leading interior pairs (zero when
+  // enforcing domain decomposition independence, since the classification
+  // depends on the decomposition), and nodePairRange returns the [begin, end)
+  // pair indices of either set.
+  size_t numInteriorNodePairs() const;
+  std::pair<size_t, size_t> nodePairRange(const bool ghostPairs) const;
+
+  // Integrators may leave the ghost boundary communication preceding a
+  // derivative evaluation in flight, registering how to complete it here.
+  // completeGhostExchange runs any pending completion on the master thread and
+  // synchronizes the thread team, so it must be called by every thread when
+  // used inside a parallel region.  It is a no-op if nothing is pending.
+  // Registering a completion that communicates requires MPI_THREAD_FUNNELED
+  // (see Communicator::funneledThreadSupport).
+  void ghostExchangePending(const std::function<void()>& complete) const;
+  bool ghostExchangePending() const;
+  void completeGhostExchange() const;
+
+  //............................................................................
+  // Verlet list mode.  If verletSkin > 0 a full neighbor search collects
+  // candidate pairs out to (kernelExtent + verletSkin) (in units of h), and
+  // subsequent rebuilds simply filter those candidates by the actual kernel
+  // extent.  A full search is repeated when the NodeLists change size, or when
+  // the displacement of a pair plus the growth of its smoothing scale since
+  // the last full search could exceed the skin, so the filtered lists always
+  // match a full search.  Not used when enforcing domain decomposition
+  // independence.
+  double verletSkin() const;
+  void verletSkin(const double x);
+
+  // Did the last rebuild reuse the Verlet candidates (rather than a full search)?
+  bool verletListReused() const;
+
+  // Called when the nodes have been redistributed or reordered, which
+  // invalidates any stored Verlet candidates.
+  void notifyAfterRedistribution();
+
   //............................................................................
   // Get the set of neighbors for the given (internal!) node in the given NodeList.
-  const std::vector< std::vector<int> >&
+  // The result is a lightweight view into the connectivity storage, indexed by
+  // NodeList like a std::vector<std::vector<int>>; it is invalidated by
+  // rebuilding or patching the connectivity.
+  NodeConnectivity
   connectivityForNode(const NodeList<Dimension>* nodeListPtr,
                       const int nodeID) const;
 
   // Same as above, just referencing the NodeList by an integer index.
-  const std::vector< std::vector<int> >&
+  NodeConnectivity
   connectivityForNode(const int nodeListID,
                       const int nodeID) const;
 
@@ -82,12 +145,12 @@ public:
   // not the common neighbors.  You need to query ConnectivityMap::connectivityIntersectionForNodes
   // to get the overlapping set of points.
   // Get the set of neighbors we have overlap with (common neighbors).
-  const std::vector< std::vector<int> >&
+  NodeConnectivity
   overlapConnectivityForNode(const NodeList<Dimension>* nodeListPtr,
                              const int nodeID) const;
 
   // Same as above, just referencing the NodeList by an integer index.
-  const std::vector< std::vector<int> >&
+  NodeConnectivity
   overlapConnectivityForNode(const int nodeListID,
                              const int nodeID) const;
 
@@ -149,6 +212,9 @@ public:
   // Check that the internal data structure is valid.
   bool valid() const;
 
+  // Bytes of memory used to store the neighbor connectivity.
+  size_t connectivityMemoryUsage() const;
+
 private:
   //--------------------------- Private Interface ---------------------------//
   // The set of NodeLists.
@@ -158,13 +224,24 @@ private:
   bool mBuildGhostConnectivity, mBuildOverlapConnectivity;
 
   // The full connectivity map.  This might be quite large!
-  // [offset[NodeList] + nodeID] [NodeListID] [neighborIndex]
-  typedef std::vector<std::vector<std::vector<int>>> ConnectivityStorageType;
+  // [offset[NodeList] + nodeID] [NodeListID] [neighborIndex], stored as
+  // compressed sparse rows.  NestedConnectivityType is the same layout as
+  // nested vectors, which we use for the rarely called editing operations.
+  typedef ConnectivityCSR ConnectivityStorageType;
+  typedef ConnectivityCSR::NestedType NestedConnectivityType;
   std::vector<int> mOffsets;
   ConnectivityStorageType mConnectivity;
 
-  // List of Node conncetion pairs.
-  NodePairList mNodePairList;
+  // List of Node conncetion pairs, and the optional restricted subset.
+  NodePairList mNodePairList, mActiveNodePairList;
+  bool mNodePairsRestricted;
+  size_t mNumInteriorNodePairs, mNumActiveInteriorNodePairs, mNodePairGeneration;
+
+  // Completion of any ghost exchange left in flight by the integrator.
+  mutable std::function<void()> mCompleteGhostExchange;
+
+  // Cached geometry for the node pairs.
+  mutable NodePairGeometry<Dimension> mPairGeometry;
 
   // Same for overlap connectivity.
   ConnectivityStorageType mOverlapConnectivity;
@@ -176,10 +253,58 @@ private:
   typedef typename KeyTraits::Key Key;
   FieldList<Dimension, Key> mKeys;
 
+  // Verlet list state: candidate neighbors (same layout as mConnectivity), and
+  // the positions, H tensors, and sizes of the NodeLists when they were found.
+  double mVerletSkin;
+  bool mVerletReused, mVerletGhostConnectivity;
+  ConnectivityStorageType mVerletCandidates;
+  std::vector<const NodeList<Dimension>*> mVerletNodeLists;
+  std::vector<std::vector<typename Dimension::Vector>> mVerletPositions;
+  std::vector<std::vector<typename Dimension::SymTensor>> mVerletH;
+  std::vector<unsigned> mVerletNumNodes, mVerletNumInternalNodes;
+
+  // Our handle for redistribution notifications.
+  RedistributionRegistrationType mRedistribution;
+
   // Internal method to fill in the connectivity, once the set of NodeLists 
   // is determined.
   void computeConnectivity();
 
+  // Find the neighbors of one group of master nodes from their coarse
+  // neighbors.  May be called concurrently for disjoint groups.
+  void computeMasterGroupConnectivity(const std::vector<std::vector<int>>& masterLists,
+                                      const std::vector<std::vector<int>>& coarseNeighbors,
+                                      const FieldList<Dimension, typename Dimension::Vector>& position,
+                                      const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                                      const double kernelExtent2,
+                                      const double searchExtent2,
+                                      const bool useVerlet,
+                                      const bool domainDecompIndependent,
+                                      NodePairList& nodePairs);
+
+  // Move the interior pairs to the front of the NodePairList, optionally
+  // given the first ghost node of each NodeList (defaults to the NodeLists'
+  // current values).
+  void partitionNodePairs();
+  void partitionNodePairs(const std::vector<int>& firstGhostNode);
+
+  // Note that nodePairList() has changed.
+  void nodePairsChanged();
+
+  // Verlet list helpers.
+  bool verletCandidatesValid(const FieldList<Dimension, typename Dimension::Vector>& position,
+                             const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                             const double kernelExtent,
+                             const bool ghostConnectivity) const;
+  void filterVerletCandidates(const FieldList<Dimension, typename Dimension::Vector>& position,
+                              const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                              const double kernelExtent2,
+                              const bool ghostConnectivity);
+  void storeVerletReference(const FieldList<Dimension, typename Dimension::Vector>& position,
+                            const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                            const bool ghostConnectivity);
+  void clearVerletCandidates();
+
   // No default constructor, copying, or assignment.
   ConnectivityMap(const ConnectivityMap&);
   ConnectivityMap& operator=(const ConnectivityMap&);
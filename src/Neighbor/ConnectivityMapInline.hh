@@ -23,8 +23,25 @@ ConnectivityMap(const NodeListIterator& begin,
   mBuildOverlapConnectivity(buildOverlapConnectivity),
   mOffsets(),
   mConnectivity(),
+  mNodePairList(),
+  mActiveNodePairList(),
+  mNodePairsRestricted(false),
+  mNumInteriorNodePairs(0u),
+  mNumActiveInteriorNodePairs(0u),
+  mNodePairGeneration(0u),
+  mCompleteGhostExchange(),
   mNodeTraversalIndices(),
-  mKeys(FieldStorageType::CopyFields) {
+  mKeys(FieldStorageType::CopyFields),
+  mVerletSkin(0.0),
+  mVerletReused(false),
+  mVerletGhostConnectivity(false),
+  mVerletCandidates(),
+  mVerletNodeLists(),
+  mVerletPositions(),
+  mVerletH(),
+  mVerletNumNodes(),
+  mVerletNumInternalNodes(),
+  mRedistribution(registerWithRedistribution(*this, &ConnectivityMap<Dimension>::notifyAfterRedistribution)) {
 
   // The private method does the grunt work of filling in the connectivity once we have
   // established the set of NodeLists.
@@ -114,7 +131,100 @@ inline
 const NodePairList&
 ConnectivityMap<Dimension>::
 nodePairList() const {
-  return mNodePairList;
+  return (mNodePairsRestricted ? mActiveNodePairList : mNodePairList);
+}
+
+//------------------------------------------------------------------------------
+// Are we currently restricting the NodePairList to active nodes?
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+ConnectivityMap<Dimension>::
+nodePairsRestricted() const {
+  return mNodePairsRestricted;
+}
+
+//------------------------------------------------------------------------------
+// The number of pairs between internal nodes at the front of the NodePairList.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+size_t
+ConnectivityMap<Dimension>::
+numInteriorNodePairs() const {
+  return (mNodePairsRestricted ? mNumActiveInteriorNodePairs : mNumInteriorNodePairs);
+}
+
+//------------------------------------------------------------------------------
+// The range of interior or ghost pair indices in the NodePairList.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+std::pair<size_t, size_t>
+ConnectivityMap<Dimension>::
+nodePairRange(const bool ghostPairs) const {
+  const auto ninterior = this->numInteriorNodePairs();
+  return (ghostPairs ?
+          std::make_pair(ninterior, this->nodePairList().size()) :
+          std::make_pair(size_t(0u), ninterior));
+}
+
+//------------------------------------------------------------------------------
+// Register/query/complete a pending ghost exchange.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+void
+ConnectivityMap<Dimension>::
+ghostExchangePending(const std::function<void()>& complete) const {
+  mCompleteGhostExchange = complete;
+}
+
+template<typename Dimension>
+inline
+bool
+ConnectivityMap<Dimension>::
+ghostExchangePending() const {
+  return bool(mCompleteGhostExchange);
+}
+
+template<typename Dimension>
+inline
+void
+ConnectivityMap<Dimension>::
+completeGhostExchange() const {
+#pragma omp master
+  {
+    if (mCompleteGhostExchange) {
+      std::function<void()> complete;
+      std::swap(complete, mCompleteGhostExchange);
+      complete();
+    }
+  }
+#pragma omp barrier
+}
+
+//------------------------------------------------------------------------------
+// The cached pair geometry.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+NodePairGeometry<Dimension>&
+ConnectivityMap<Dimension>::
+pairGeometry() const {
+  return mPairGeometry;
+}
+
+//------------------------------------------------------------------------------
+// The generation of the NodePairList.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+size_t
+ConnectivityMap<Dimension>::
+nodePairGeneration() const {
+  return mNodePairGeneration;
 }
 
 //------------------------------------------------------------------------------
@@ -122,7 +232,7 @@ nodePairList() const {
 //------------------------------------------------------------------------------
 template<typename Dimension>
 inline
-const std::vector< std::vector<int> >&
+NodeConnectivity
 ConnectivityMap<Dimension>::
 connectivityForNode(const NodeList<Dimension>* nodeListPtr,
                     const int nodeID) const {
@@ -134,8 +244,8 @@ connectivityForNode(const NodeList<Dimension>* nodeListPtr,
           (ghostValid and nodeID < (int)nodeListPtr->numNodes())));
   const int nodeListID = std::distance(mNodeLists.begin(),
                                        std::find(mNodeLists.begin(), mNodeLists.end(), nodeListPtr));
-  REQUIRE(nodeListID < (int)mConnectivity.size() and nodeListID < (int)mOffsets.size());
-  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.size());
+  REQUIRE(nodeListID < (int)mOffsets.size());
+  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.numRows());
   return mConnectivity[mOffsets[nodeListID] + nodeID];
 }
 
@@ -144,18 +254,18 @@ connectivityForNode(const NodeList<Dimension>* nodeListPtr,
 //------------------------------------------------------------------------------
 template<typename Dimension>
 inline
-const std::vector< std::vector<int> >&
+NodeConnectivity
 ConnectivityMap<Dimension>::
 connectivityForNode(const int nodeListID,
                     const int nodeID) const {
   const bool ghostValid = (mBuildGhostConnectivity or
                            NodeListRegistrar<Dimension>::instance().domainDecompositionIndependent());
   CONTRACT_VAR(ghostValid);
-  REQUIRE(nodeListID >= 0 and nodeListID < (int)mConnectivity.size());
+  REQUIRE(nodeListID >= 0 and nodeListID < (int)mOffsets.size());
   REQUIRE(nodeID >= 0 and 
           ((nodeID < (int)mNodeLists[nodeListID]->numInternalNodes()) or
           (ghostValid and nodeID < (int)mNodeLists[nodeListID]->numNodes())));
-  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.size());
+  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.numRows());
   return mConnectivity[mOffsets[nodeListID] + nodeID];
 }
 
@@ -165,7 +275,7 @@ connectivityForNode(const int nodeListID,
 //------------------------------------------------------------------------------
 template<typename Dimension>
 inline
-const std::vector< std::vector<int> >&
+NodeConnectivity
 ConnectivityMap<Dimension>::
 overlapConnectivityForNode(const NodeList<Dimension>* nodeListPtr,
                            const int nodeID) const {
@@ -177,8 +287,8 @@ overlapConnectivityForNode(const NodeList<Dimension>* nodeListPtr,
           (ghostValid and nodeID < (int)nodeListPtr->numNodes())));
   const int nodeListID = std::distance(mNodeLists.begin(),
                                        std::find(mNodeLists.begin(), mNodeLists.end(), nodeListPtr));
-  REQUIRE(nodeListID < (int)mConnectivity.size() and nodeListID < (int)mOffsets.size());
-  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.size());
+  REQUIRE(nodeListID < (int)mOffsets.size());
+  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.numRows());
   return mOverlapConnectivity[mOffsets[nodeListID] + nodeID];
 }
 
@@ -187,18 +297,18 @@ overlapConnectivityForNode(const NodeList<Dimension>* nodeListPtr,
 //------------------------------------------------------------------------------
 template<typename Dimension>
 inline
-const std::vector< std::vector<int> >&
+NodeConnectivity
 ConnectivityMap<Dimension>::
 overlapConnectivityForNode(const int nodeListID,
                            const int nodeID) const {
   const bool ghostValid = (mBuildGhostConnectivity or
                            NodeListRegistrar<Dimension>::instance().domainDecompositionIndependent());
   CONTRACT_VAR(ghostValid);
-  REQUIRE(nodeListID >= 0 and nodeListID < (int)mConnectivity.size());
+  REQUIRE(nodeListID >= 0 and nodeListID < (int)mOffsets.size());
   REQUIRE(nodeID >= 0 and 
           ((nodeID < (int)mNodeLists[nodeListID]->numInternalNodes()) or
           (ghostValid and nodeID < (int)mNodeLists[nodeListID]->numNodes())));
-  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.size());
+  REQUIRE(mOffsets[nodeListID] + nodeID < (int)mConnectivity.numRows());
   return mOverlapConnectivity[mOffsets[nodeListID] + nodeID];
 }
 
@@ -211,11 +321,9 @@ int
 ConnectivityMap<Dimension>::
 numNeighborsForNode(const NodeList<Dimension>* nodeListPtr,
                     const int nodeID) const {
-  const std::vector< std::vector<int> >& neighbors = connectivityForNode(nodeListPtr, nodeID);
+  const auto neighbors = connectivityForNode(nodeListPtr, nodeID);
   int result = 0;
-  for (std::vector< std::vector<int> >::const_iterator itr = neighbors.begin();
-       itr != neighbors.end();
-       ++itr) result += itr->size();
+  for (const auto& neighborsj: neighbors) result += neighborsj.size();
   return result;
 }
 
@@ -238,11 +346,9 @@ int
 ConnectivityMap<Dimension>::
 numOverlapNeighborsForNode(const NodeList<Dimension>* nodeListPtr,
                            const int nodeID) const {
-  const std::vector< std::vector<int> >& neighbors = overlapConnectivityForNode(nodeListPtr, nodeID);
+  const auto neighbors = overlapConnectivityForNode(nodeListPtr, nodeID);
   int result = 0;
-  for (std::vector< std::vector<int> >::const_iterator itr = neighbors.begin();
-       itr != neighbors.end();
-       ++itr) result += itr->size();
+  for (const auto& neighborsj: neighbors) result += neighborsj.size();
   return result;
 }
 
@@ -279,6 +385,35 @@ calculatePairInteraction(const int nodeListi, const int i,
   // }
 }
 
+//------------------------------------------------------------------------------
+// Verlet list parameters.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+double
+ConnectivityMap<Dimension>::
+verletSkin() const {
+  return mVerletSkin;
+}
+
+template<typename Dimension>
+inline
+void
+ConnectivityMap<Dimension>::
+verletSkin(const double x) {
+  VERIFY2(x >= 0.0, "ConnectivityMap ERROR: verletSkin must be non-negative: " << x);
+  mVerletSkin = x;
+  this->clearVerletCandidates();
+}
+
+template<typename Dimension>
+inline
+bool
+ConnectivityMap<Dimension>::
+verletListReused() const {
+  return mVerletReused;
+}
+
 //------------------------------------------------------------------------------
 // Iterators for walking nodes in a prescribed order (domain decomposition 
 // independent when needed).
@@ -4,6 +4,7 @@
 // Created by J. Michael Owen, Sun Nov 12 10:33:55 2000
 //----------------------------------------------------------------------------//
 #include "Neighbor.hh"
+#include "CellLinkedList.hh"
 
 #include "Geometry/Dimension.hh"
 #include "Geometry/GeomPlane.hh"
@@ -306,6 +307,38 @@ precullList(const Vector& minMasterPosition, const Vector& maxMasterPosition,
   return cullList;
 }
 
+//------------------------------------------------------------------------------
+// Batched neighbor search for a set of query points.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+Neighbor<Dimension>::
+setBatchNeighborLists(const vector<Vector>& positions,
+                      const vector<SymTensor>& H,
+                      vector<size_t>& offsets,
+                      vector<int>& neighbors) const {
+  REQUIRE(valid());
+  REQUIRE(H.size() == positions.size());
+
+  // Bin our nodes.
+  const auto  n = nodeList().numNodes();
+  const auto& nodePositions = nodeList().positions();
+  const auto& nodeExtents = nodeExtentField();
+  const vector<Vector> nodePos(nodePositions.begin(), nodePositions.begin() + n);
+  const vector<Vector> nodeExt(nodeExtents.begin(), nodeExtents.begin() + n);
+  const CellLinkedList<Dimension> cells(nodePos, nodeExt);
+
+  // The extents of the query points.
+  const auto nq = positions.size();
+  vector<Vector> extents(nq);
+#pragma omp parallel for
+  for (auto k = 0u; k < nq; ++k) extents[k] = HExtent(H[k], kernelExtent());
+
+  cells.query(positions, extents, neighborSearchType(), offsets, neighbors);
+  ENSURE(offsets.size() == nq + 1u);
+  ENSURE(neighbors.size() == offsets.back());
+}
+
 // //------------------------------------------------------------------------------
 // // Cull the local (to this NodeList) neighbor info based on the current master
 // // state.
@@ -125,6 +125,17 @@ public:
                              std::vector<int>& masterList,
                              std::vector<int>& coarseNeighbors) const = 0;
 
+  // Batched neighbor search.  For each of a set of query points (position, H)
+  // find the nodes (internal and ghost) of our NodeList selected by
+  // setMasterList/setRefineNeighborList, in one parallel pass over a flat cell
+  // grid (CellLinkedList).  The result is in compressed sparse row form: the
+  // neighbors of query point k are neighbors[offsets[k]] ...
+  // neighbors[offsets[k+1]-1], in ascending order.
+  void setBatchNeighborLists(const std::vector<Vector>& positions,
+                             const std::vector<SymTensor>& H,
+                             std::vector<size_t>& offsets,
+                             std::vector<int>& neighbors) const;
+
   // Force the update of internal data for the NodeList.
   virtual void updateNodes() = 0;
   virtual void updateNodes(const std::vector<int>& nodeIDs) = 0;
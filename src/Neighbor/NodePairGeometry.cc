@@ -0,0 +1,153 @@
+//---------------------------------Spheral++----------------------------------//
+// NodePairGeometry
+//
+// Structure-of-arrays cache of the per-pair geometry for a NodePairList.
+//----------------------------------------------------------------------------//
+#include "NodePairGeometry.hh"
+#include "Kernel/TableKernel.hh"
+#include "Field/Field.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/DBC.hh"
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Constructor.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+NodePairGeometry<Dimension>::
+NodePairGeometry():
+  mCaching(false),
+  mValid(false),
+  mPairsPtr(nullptr),
+  mPairsGeneration(0u),
+  mStateFields(),
+  mrij(),
+  metai(),
+  metaj(),
+  mHetai(),
+  mHetaj(),
+  metaMagi(),
+  metaMagj(),
+  mHdeti(),
+  mHdetj(),
+  mKernelValues() {
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+NodePairGeometry<Dimension>::
+~NodePairGeometry() {
+}
+
+//------------------------------------------------------------------------------
+// Clear any cached values.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+NodePairGeometry<Dimension>::
+clear() {
+  mValid = false;
+  mPairsPtr = nullptr;
+  mStateFields.clear();
+  mKernelValues.clear();
+}
+
+//------------------------------------------------------------------------------
+// Compute the geometry for each pair.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+NodePairGeometry<Dimension>::
+update(const NodePairList& pairs,
+       const size_t pairsGeneration,
+       const FieldList<Dimension, Vector>& position,
+       const FieldList<Dimension, SymTensor>& H) {
+
+  // The state Fields these values are computed from.
+  std::vector<const FieldBase<Dimension>*> stateFields;
+  for (auto itr = position.begin(); itr != position.end(); ++itr) stateFields.push_back(*itr);
+  for (auto itr = H.begin(); itr != H.end(); ++itr) stateFields.push_back(*itr);
+
+  // If we're caching and already up to date there's nothing to do.
+  const auto npairs = pairs.size();
+  if (mCaching and
+      mValid and
+      mPairsPtr == &pairs and
+      mPairsGeneration == pairsGeneration and
+      mStateFields == stateFields and
+      mrij.size() == npairs) return;
+
+  mKernelValues.clear();
+  mPairsPtr = &pairs;
+  mPairsGeneration = pairsGeneration;
+  mStateFields = stateFields;
+  mrij.resize(npairs);
+  metai.resize(npairs);
+  metaj.resize(npairs);
+  mHetai.resize(npairs);
+  mHetaj.resize(npairs);
+  metaMagi.resize(npairs);
+  metaMagj.resize(npairs);
+  mHdeti.resize(npairs);
+  mHdetj.resize(npairs);
+
+#pragma omp parallel for
+  for (auto kk = 0u; kk < npairs; ++kk) {
+    const auto i = pairs[kk].i_node;
+    const auto j = pairs[kk].j_node;
+    const auto nodeListi = pairs[kk].i_list;
+    const auto nodeListj = pairs[kk].j_list;
+    const auto& Hi = H(nodeListi, i);
+    const auto& Hj = H(nodeListj, j);
+    mrij[kk] = position(nodeListi, i) - position(nodeListj, j);
+    metai[kk] = Hi*mrij[kk];
+    metaj[kk] = Hj*mrij[kk];
+    metaMagi[kk] = metai[kk].magnitude();
+    metaMagj[kk] = metaj[kk].magnitude();
+    mHetai[kk] = Hi*metai[kk].unitVector();
+    mHetaj[kk] = Hj*metaj[kk].unitVector();
+    mHdeti[kk] = Hi.Determinant();
+    mHdetj[kk] = Hj.Determinant();
+  }
+  mValid = true;
+}
+
+//------------------------------------------------------------------------------
+// Kernel values for each pair.  Each thread evaluates a contiguous block of
+// pairs with the TableKernel block lookup.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+const typename NodePairGeometry<Dimension>::KernelValues&
+NodePairGeometry<Dimension>::
+kernelValues(const TableKernel<Dimension>& W) {
+  REQUIRE2(mValid, "NodePairGeometry::kernelValues requires a prior call to update");
+  auto itr = mKernelValues.find(&W);
+  if (itr != mKernelValues.end()) return itr->second;
+
+  const auto npairs = mPairsPtr->size();
+  CHECK(mrij.size() == npairs);
+  auto& result = mKernelValues[&W];
+  result.Wi.resize(npairs);
+  result.gWi.resize(npairs);
+  result.Wj.resize(npairs);
+  result.gWj.resize(npairs);
+
+#pragma omp parallel
+  {
+    const size_t nthreads = omp_get_num_threads();
+    const size_t tid = omp_get_thread_num();
+    const auto kbegin = (npairs*tid)/nthreads;
+    const auto kend = (npairs*(tid + 1))/nthreads;
+    if (kend > kbegin) {
+      const auto n = kend - kbegin;
+      W.kernelAndGradValues(&metaMagi[kbegin], &mHdeti[kbegin], n, &result.Wi[kbegin], &result.gWi[kbegin]);
+      W.kernelAndGradValues(&metaMagj[kbegin], &mHdetj[kbegin], n, &result.Wj[kbegin], &result.gWj[kbegin]);
+    }
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,112 @@
+//---------------------------------Spheral++----------------------------------//
+// NodePairGeometry
+//
+// Structure-of-arrays cache of the per-pair geometry for a NodePairList:
+// the pair separation rij, the normalized separations eta for both nodes, and
+// (lazily, per kernel) the kernel values and gradients for both nodes.
+//
+// Physics packages walking the same NodePairList in a single derivative
+// evaluation (hydro, artificial viscosity, corrections) can share these values
+// rather than each regathering positions and H and re-evaluating the kernel.
+// The cache is opt-in: it is only populated while caching() is enabled, which
+// Integrator::evaluateDerivatives does for the duration of a derivative
+// evaluation if Integrator::cachePairGeometry is set.  Physics packages should
+// check caching() and evaluate the pair geometry directly otherwise, so runs
+// that don't use the cache don't pay for its storage.  Cached values are keyed
+// on the NodePairList generation (ConnectivityMap::nodePairGeneration) and the
+// position and H Fields they were computed from, so changing any of those
+// forces a recompute.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_NodePairGeometry__
+#define __Spheral_NodePairGeometry__
+
+#include "NodePairList.hh"
+#include "Field/FieldList.hh"
+
+#include <vector>
+#include <map>
+
+namespace Spheral {
+
+template<typename Dimension> class TableKernel;
+
+template<typename Dimension>
+class NodePairGeometry {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  typedef typename Dimension::Scalar Scalar;
+  typedef typename Dimension::Vector Vector;
+  typedef typename Dimension::SymTensor SymTensor;
+
+  // Kernel values for both nodes of each pair.
+  struct KernelValues {
+    std::vector<Scalar> Wi, gWi, Wj, gWj;
+  };
+
+  // Constructors, destructor.
+  NodePairGeometry();
+  ~NodePairGeometry();
+
+  // Should values persist between calls to update?  Changing this state
+  // always clears any cached values.
+  bool caching() const;
+  void caching(const bool x);
+
+  // Discard any cached values.
+  void clear();
+
+  // Compute the pair geometry for the given pairs and state.  If caching is
+  // enabled and we already hold values for the same pairs (and generation),
+  // positions, and H this is a no-op.
+  void update(const NodePairList& pairs,
+              const size_t pairsGeneration,
+              const FieldList<Dimension, Vector>& position,
+              const FieldList<Dimension, SymTensor>& H);
+
+  // The kernel values for each pair with the given kernel, computed on demand
+  // in blocks with TableKernel::kernelAndGradValues.  Must be preceded by update.
+  const KernelValues& kernelValues(const TableKernel<Dimension>& W);
+
+  // Number of pairs.
+  size_t size() const;
+
+  // Per pair data:
+  //   rij   = ri - rj
+  //   etai  = Hi*rij,  etaj = Hj*rij
+  //   Hetai = Hi*etai.unitVector(), Hetaj = Hj*etaj.unitVector()
+  //   (so gradWi = gWi*Hetai, etc.)
+  const Vector& rij(const size_t k) const;
+  const Vector& etai(const size_t k) const;
+  const Vector& etaj(const size_t k) const;
+  Scalar etaMagi(const size_t k) const;
+  Scalar etaMagj(const size_t k) const;
+  const Vector& Hetai(const size_t k) const;
+  const Vector& Hetaj(const size_t k) const;
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  bool mCaching, mValid;
+  const NodePairList* mPairsPtr;
+  size_t mPairsGeneration;
+  std::vector<const FieldBase<Dimension>*> mStateFields;
+  std::vector<Vector> mrij, metai, metaj, mHetai, mHetaj;
+  std::vector<Scalar> metaMagi, metaMagj, mHdeti, mHdetj;
+  std::map<const TableKernel<Dimension>*, KernelValues> mKernelValues;
+
+  // No copying or assignment.
+  NodePairGeometry(const NodePairGeometry&);
+  NodePairGeometry& operator=(const NodePairGeometry&);
+};
+
+}
+
+#include "NodePairGeometryInline.hh"
+
+#else
+
+// Forward declaration.
+namespace Spheral {
+  template<typename Dimension> class NodePairGeometry;
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "Utilities/DBC.hh"
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Caching state.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+NodePairGeometry<Dimension>::
+caching() const {
+  return mCaching;
+}
+
+template<typename Dimension>
+inline
+void
+NodePairGeometry<Dimension>::
+caching(const bool x) {
+  mCaching = x;
+  this->clear();
+}
+
+//------------------------------------------------------------------------------
+// Number of pairs.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+size_t
+NodePairGeometry<Dimension>::
+size() const {
+  return mrij.size();
+}
+
+//------------------------------------------------------------------------------
+// Per pair data.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+NodePairGeometry<Dimension>::
+rij(const size_t k) const {
+  REQUIRE(k < mrij.size());
+  return mrij[k];
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+NodePairGeometry<Dimension>::
+etai(const size_t k) const {
+  REQUIRE(k < metai.size());
+  return metai[k];
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+NodePairGeometry<Dimension>::
+etaj(const size_t k) const {
+  REQUIRE(k < metaj.size());
+  return metaj[k];
+}
+
+template<typename Dimension>
+inline
+typename Dimension::Scalar
+NodePairGeometry<Dimension>::
+etaMagi(const size_t k) const {
+  REQUIRE(k < metaMagi.size());
+  return metaMagi[k];
+}
+
+template<typename Dimension>
+inline
+typename Dimension::Scalar
+NodePairGeometry<Dimension>::
+etaMagj(const size_t k) const {
+  REQUIRE(k < metaMagj.size());
+  return metaMagj[k];
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+NodePairGeometry<Dimension>::
+Hetai(const size_t k) const {
+  REQUIRE(k < mHetai.size());
+  return mHetai[k];
+}
+
+template<typename Dimension>
+inline
+const typename Dimension::Vector&
+NodePairGeometry<Dimension>::
+Hetaj(const size_t k) const {
+  REQUIRE(k < mHetaj.size());
+  return mHetaj[k];
+}
+
+}
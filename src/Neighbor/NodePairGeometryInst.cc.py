@@ -0,0 +1,9 @@
+text = """
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "Neighbor/NodePairGeometry.cc"
+#include "Geometry/Dimension.hh"
+
+template class Spheral::NodePairGeometry<Spheral::Dim< %(ndim)s > >;
+"""
@@ -15,4 +15,12 @@ namespace Spheral {
     mNodePairList.clear();
   }
 
+  void NodePairList::reserve(const size_t n) {
+    mNodePairList.reserve(n);
+  }
+
+  void NodePairList::resize(const size_t n) {
+    mNodePairList.resize(n, NodePairIdxType(-1, -1, -1, -1));
+  }
+
 }
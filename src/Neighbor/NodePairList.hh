@@ -43,6 +43,8 @@ public:
   NodePairList();
   void push_back(NodePairIdxType nodePair);
   void clear(); 
+  void reserve(const size_t n);
+  void resize(const size_t n);
   size_t size() const { return mNodePairList.size(); }
 
   // Iterators
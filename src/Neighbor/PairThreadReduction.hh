@@ -0,0 +1,194 @@
+//---------------------------------Spheral++----------------------------------//
+// PairThreadReduction
+//
+// A low-memory alternative to FieldList::threadCopy for OpenMP pair loops.
+//
+// PairThreadReduction partitions a NodePairList into one contiguous block of
+// pairs per thread, and records (per NodeList) the range of node indices each
+// thread actually touches in its block.  Derivative FieldLists are then
+// accumulated in FieldListThreadWindows, which only allocate storage for that
+// touched range rather than a full copy of every Field.  When the node
+// ordering is spatially coherent the windows of different threads barely
+// overlap, so the thread-local memory is ~ the size of the problem rather than
+// nthreads times the problem.
+//
+// The final reduction is owner-computes: each thread sums the contributions
+// of every window into its own slice of the internal nodes, so there is no
+// critical section and the merge scales with the number of threads.
+//
+// Usage (inside the pair loop of an evaluateDerivatives):
+//
+//   PairThreadReduction<Dimension> threadReduction(pairs, nodeLists, method);
+// #pragma omp parallel
+//   {
+//     FieldListThreadWindow<Dimension, Scalar> DepsDt_thread(DepsDt, threadReduction);
+//     ...
+//     const auto kpairs = threadReduction.pairRange();
+//     for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {...}
+//     threadReduction.reduce();
+//   }
+//
+// Constructed from a ConnectivityMap, each thread is given a block of the
+// interior pairs (between internal nodes) and a block of the pairs touching
+// ghost nodes, so the interior pairs can be evaluated while the integrator
+// still has ghost communication in flight:
+//
+//     for (const auto ghostPairs: {false, true}) {
+//       if (ghostPairs) connectivityMap.completeGhostExchange();
+//       const auto kpairs = threadReduction.pairRange(ghostPairs);
+//       for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {...}
+//     }
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_PairThreadReduction__
+#define __Spheral_PairThreadReduction__
+
+#include "NodePairList.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+
+#include <vector>
+#include <utility>
+
+namespace Spheral {
+
+template<typename Dimension> class NodeList;
+template<typename Dimension> class ConnectivityMap;
+template<typename Dimension, typename DataType> class FieldList;
+
+//------------------------------------------------------------------------------
+// Type erased interface for the thread windows, so PairThreadReduction can
+// reduce windows of any DataType.
+//------------------------------------------------------------------------------
+class FieldListThreadWindowBase {
+public:
+  virtual ~FieldListThreadWindowBase() {}
+
+  // Reduce this window's values for nodes [ibegin, iend) of NodeList nodeListi
+  // into the master FieldList.
+  virtual void reduce(const unsigned nodeListi,
+                      const unsigned ibegin,
+                      const unsigned iend) const = 0;
+};
+
+//------------------------------------------------------------------------------
+// PairThreadReduction
+//------------------------------------------------------------------------------
+template<typename Dimension>
+class PairThreadReduction {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  typedef std::pair<unsigned, unsigned> RangeType;
+
+  // Construct outside the parallel region, so the object is shared by all
+  // threads.
+  PairThreadReduction(const NodePairList& pairs,
+                      const std::vector<const NodeList<Dimension>*>& nodeLists,
+                      const ThreadReductionMethod method);
+  PairThreadReduction(const ConnectivityMap<Dimension>& connectivityMap,
+                      const ThreadReductionMethod method);
+  ~PairThreadReduction();
+
+  // The reduction method.
+  ThreadReductionMethod method() const;
+
+  // The number of NodeLists.
+  unsigned numNodeLists() const;
+
+  // The following methods must be called from inside the parallel region, and
+  // refer to the calling thread.
+
+  // The block of pairs [first, second) this thread should evaluate.  The
+  // argument free form requires we were not split into interior/ghost pairs.
+  std::pair<size_t, size_t> pairRange();
+  std::pair<size_t, size_t> pairRange(const bool ghostPairs);
+
+  // The range of node indices [first, second) this thread touches in the given
+  // NodeList (empty if first >= second).
+  RangeType nodeRange(const unsigned nodeListi);
+
+  // Register a thread window to be included in the final reduction.
+  void registerWindow(FieldListThreadWindowBase* window);
+
+  // Collective reduction of all registered windows into the master FieldLists.
+  // Every thread in the team must call this at the end of the parallel region,
+  // and thread windows must not be destroyed before it returns.
+  void reduce();
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  struct ThreadData {
+    bool initialized;
+    size_t kbegin, kend, gbegin, gend;
+    std::vector<RangeType> nodeRanges;
+    std::vector<FieldListThreadWindowBase*> windows;
+    ThreadData(): initialized(false), kbegin(0), kend(0), gbegin(0), gend(0), nodeRanges(), windows() {}
+  };
+
+  const NodePairList& mPairs;
+  size_t mNumInteriorPairs;
+  std::vector<unsigned> mNumInternalNodes;
+  ThreadReductionMethod mMethod;
+  std::vector<ThreadData> mThreadData;
+
+  // Find this thread's block of pairs and touched node ranges.
+  ThreadData& threadData();
+
+  // No default constructor, copying, or assignment.
+  PairThreadReduction();
+  PairThreadReduction(const PairThreadReduction&);
+  PairThreadReduction& operator=(const PairThreadReduction&);
+};
+
+//------------------------------------------------------------------------------
+// FieldListThreadWindow
+// Thread-local accumulation buffer for a FieldList, covering only the nodes
+// the owning thread touches.  In serial it aliases the master storage directly.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+class FieldListThreadWindow: public FieldListThreadWindowBase {
+public:
+  //--------------------------- Public Interface ---------------------------//
+  FieldListThreadWindow(FieldList<Dimension, DataType>& master,
+                        PairThreadReduction<Dimension>& reduction,
+                        const ThreadReduction reductionType = ThreadReduction::SUM);
+  virtual ~FieldListThreadWindow();
+
+  // Element access, using the same (nodeList, node) indexing as FieldList.
+  DataType& operator()(const unsigned nodeListi, const unsigned i);
+  const DataType& operator()(const unsigned nodeListi, const unsigned i) const;
+
+  // Is this window aliasing the master data (serial case)?
+  bool aliased() const;
+
+  // Reduce our values into the master.
+  virtual void reduce(const unsigned nodeListi,
+                      const unsigned ibegin,
+                      const unsigned iend) const override;
+
+private:
+  //--------------------------- Private Interface ---------------------------//
+  FieldList<Dimension, DataType>& mMaster;
+  ThreadReduction mReductionType;
+  bool mAliased;
+  std::vector<unsigned> mOffsets, mSizes;
+  std::vector<DataType*> mBasePtrs;
+  std::vector<std::vector<DataType>> mStorage;
+
+  // No default constructor, copying, or assignment.
+  FieldListThreadWindow();
+  FieldListThreadWindow(const FieldListThreadWindow&);
+  FieldListThreadWindow& operator=(const FieldListThreadWindow&);
+};
+
+}
+
+#include "PairThreadReductionInline.hh"
+
+#else
+
+// Forward declarations.
+namespace Spheral {
+  template<typename Dimension> class PairThreadReduction;
+  template<typename Dimension, typename DataType> class FieldListThreadWindow;
+}
+
+#endif
@@ -0,0 +1,341 @@
+#include "NodeList/NodeList.hh"
+#include "Neighbor/ConnectivityMap.hh"
+#include "Field/FieldList.hh"
+#include "Field/Field.hh"
+#include "Utilities/DataTypeTraits.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+#include <limits>
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Constructor.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+PairThreadReduction<Dimension>::
+PairThreadReduction(const NodePairList& pairs,
+                    const std::vector<const NodeList<Dimension>*>& nodeLists,
+                    const ThreadReductionMethod method):
+  mPairs(pairs),
+  mNumInteriorPairs(pairs.size()),
+  mNumInternalNodes(),
+  mMethod(method),
+  mThreadData(std::max(1, omp_get_max_threads())) {
+  for (const auto* nodeListPtr: nodeLists) mNumInternalNodes.push_back(nodeListPtr->numInternalNodes());
+}
+
+template<typename Dimension>
+inline
+PairThreadReduction<Dimension>::
+PairThreadReduction(const ConnectivityMap<Dimension>& connectivityMap,
+                    const ThreadReductionMethod method):
+  mPairs(connectivityMap.nodePairList()),
+  mNumInteriorPairs(connectivityMap.numInteriorNodePairs()),
+  mNumInternalNodes(),
+  mMethod(method),
+  mThreadData(std::max(1, omp_get_max_threads())) {
+  REQUIRE(mNumInteriorPairs <= mPairs.size());
+  for (const auto* nodeListPtr: connectivityMap.nodeLists()) mNumInternalNodes.push_back(nodeListPtr->numInternalNodes());
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+PairThreadReduction<Dimension>::
+~PairThreadReduction() {
+}
+
+//------------------------------------------------------------------------------
+// The reduction method.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+ThreadReductionMethod
+PairThreadReduction<Dimension>::
+method() const {
+  return mMethod;
+}
+
+//------------------------------------------------------------------------------
+// The number of NodeLists.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+unsigned
+PairThreadReduction<Dimension>::
+numNodeLists() const {
+  return mNumInternalNodes.size();
+}
+
+//------------------------------------------------------------------------------
+// The block of pairs for this thread.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+std::pair<size_t, size_t>
+PairThreadReduction<Dimension>::
+pairRange() {
+  REQUIRE(mNumInteriorPairs == mPairs.size());
+  const auto& data = this->threadData();
+  return std::make_pair(data.kbegin, data.kend);
+}
+
+template<typename Dimension>
+inline
+std::pair<size_t, size_t>
+PairThreadReduction<Dimension>::
+pairRange(const bool ghostPairs) {
+  const auto& data = this->threadData();
+  return (ghostPairs ?
+          std::make_pair(data.gbegin, data.gend) :
+          std::make_pair(data.kbegin, data.kend));
+}
+
+//------------------------------------------------------------------------------
+// The range of nodes touched by this thread in the given NodeList.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+typename PairThreadReduction<Dimension>::RangeType
+PairThreadReduction<Dimension>::
+nodeRange(const unsigned nodeListi) {
+  const auto& data = this->threadData();
+  REQUIRE(nodeListi < data.nodeRanges.size());
+  return data.nodeRanges[nodeListi];
+}
+
+//------------------------------------------------------------------------------
+// Register a thread window.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+void
+PairThreadReduction<Dimension>::
+registerWindow(FieldListThreadWindowBase* window) {
+  this->threadData().windows.push_back(window);
+}
+
+//------------------------------------------------------------------------------
+// Reduce all thread windows.  Each thread owns a contiguous slice of the
+// internal nodes of each NodeList, and gathers the contributions of every
+// thread's window for that slice.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+void
+PairThreadReduction<Dimension>::
+reduce() {
+  const auto nthreads = omp_get_num_threads();
+  if (nthreads > 1) {
+    const auto tid = omp_get_thread_num();
+    CHECK(nthreads <= int(mThreadData.size()));
+
+    // Wait until every thread has finished accumulating into its windows.
+#pragma omp barrier
+
+    const auto numNL = mNumInternalNodes.size();
+    for (auto nodeListi = 0u; nodeListi < numNL; ++nodeListi) {
+      const size_t n = mNumInternalNodes[nodeListi];
+      const unsigned ibegin = (n*tid)/nthreads;
+      const unsigned iend = (n*(tid + 1))/nthreads;
+      if (iend > ibegin) {
+        for (auto t = 0; t < nthreads; ++t) {
+          for (const auto* window: mThreadData[t].windows) window->reduce(nodeListi, ibegin, iend);
+        }
+      }
+    }
+
+    // Don't let anyone release their windows while others may still be reading them.
+#pragma omp barrier
+  }
+}
+
+//------------------------------------------------------------------------------
+// Initialize (if necessary) and return the calling thread's data.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+typename PairThreadReduction<Dimension>::ThreadData&
+PairThreadReduction<Dimension>::
+threadData() {
+  const auto tid = omp_get_thread_num();
+  REQUIRE(tid < int(mThreadData.size()));
+  auto& data = mThreadData[tid];
+  if (not data.initialized) {
+    const auto nthreads = omp_get_num_threads();
+    const auto ninterior = mNumInteriorPairs;
+    const auto nghost = mPairs.size() - ninterior;
+    const auto numNL = mNumInternalNodes.size();
+    data.kbegin = (ninterior*tid)/nthreads;
+    data.kend = (ninterior*(tid + 1))/nthreads;
+    data.gbegin = ninterior + (nghost*tid)/nthreads;
+    data.gend = ninterior + (nghost*(tid + 1))/nthreads;
+    data.nodeRanges = std::vector<RangeType>(numNL, std::make_pair(std::numeric_limits<unsigned>::max(), 0u));
+    if (mMethod == ThreadReductionMethod::TouchedRange and nthreads > 1) {
+      auto touch = [&](const size_t kbegin, const size_t kend) {
+        for (auto kk = kbegin; kk < kend; ++kk) {
+          const auto& pair = mPairs[kk];
+          auto& rangei = data.nodeRanges[pair.i_list];
+          auto& rangej = data.nodeRanges[pair.j_list];
+          rangei.first = std::min(rangei.first, unsigned(pair.i_node));
+          rangei.second = std::max(rangei.second, unsigned(pair.i_node + 1));
+          rangej.first = std::min(rangej.first, unsigned(pair.j_node));
+          rangej.second = std::max(rangej.second, unsigned(pair.j_node + 1));
+        }
+      };
+      touch(data.kbegin, data.kend);
+      touch(data.gbegin, data.gend);
+    }
+    data.initialized = true;
+  }
+  return data;
+}
+
+//------------------------------------------------------------------------------
+// FieldListThreadWindow constructor.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+FieldListThreadWindow<Dimension, DataType>::
+FieldListThreadWindow(FieldList<Dimension, DataType>& master,
+                      PairThreadReduction<Dimension>& reduction,
+                      const ThreadReduction reductionType):
+  FieldListThreadWindowBase(),
+  mMaster(master),
+  mReductionType(reductionType),
+  mAliased(omp_get_num_threads() == 1),
+  mOffsets(master.numFields(), 0u),
+  mSizes(master.numFields(), 0u),
+  mBasePtrs(master.numFields(), nullptr),
+  mStorage() {
+  REQUIRE(master.numFields() == reduction.numNodeLists());
+  const auto numNL = master.numFields();
+
+  if (mAliased) {
+
+    // In serial we just write straight into the master Fields.
+    for (auto k = 0u; k < numNL; ++k) {
+      mSizes[k] = master[k]->numElements();
+      if (mSizes[k] > 0u) mBasePtrs[k] = &(*master[k])(0);
+    }
+
+  } else {
+
+    // Allocate the range of nodes this thread touches.
+    mStorage.resize(numNL);
+    for (auto k = 0u; k < numNL; ++k) {
+      if (reduction.method() == ThreadReductionMethod::FullCopy) {
+        mOffsets[k] = 0u;
+        mSizes[k] = master[k]->numElements();
+      } else {
+        const auto range = reduction.nodeRange(k);
+        if (range.second > range.first) {
+          CHECK(range.second <= master[k]->numElements());
+          mOffsets[k] = range.first;
+          mSizes[k] = range.second - range.first;
+        }
+      }
+      if (mSizes[k] > 0u) {
+        if (reductionType == ThreadReduction::SUM) {
+          mStorage[k].resize(mSizes[k], DataTypeTraits<DataType>::zero());
+        } else {
+          // Min/max reductions have to start from the current values.
+          const auto& f = *master[k];
+          mStorage[k].reserve(mSizes[k]);
+          for (auto i = 0u; i < mSizes[k]; ++i) mStorage[k].push_back(f(mOffsets[k] + i));
+        }
+        mBasePtrs[k] = &(mStorage[k].front());
+      }
+    }
+    reduction.registerWindow(this);
+
+  }
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+FieldListThreadWindow<Dimension, DataType>::
+~FieldListThreadWindow() {
+}
+
+//------------------------------------------------------------------------------
+// Element access.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+DataType&
+FieldListThreadWindow<Dimension, DataType>::
+operator()(const unsigned nodeListi, const unsigned i) {
+  REQUIRE(nodeListi < mBasePtrs.size());
+  REQUIRE2(i >= mOffsets[nodeListi] and i < mOffsets[nodeListi] + mSizes[nodeListi],
+           "FieldListThreadWindow index out of range: " << nodeListi << " " << i << " not in ["
+           << mOffsets[nodeListi] << ", " << mOffsets[nodeListi] + mSizes[nodeListi] << ")");
+  return mBasePtrs[nodeListi][i - mOffsets[nodeListi]];
+}
+
+template<typename Dimension, typename DataType>
+inline
+const DataType&
+FieldListThreadWindow<Dimension, DataType>::
+operator()(const unsigned nodeListi, const unsigned i) const {
+  REQUIRE(nodeListi < mBasePtrs.size());
+  REQUIRE(i >= mOffsets[nodeListi] and i < mOffsets[nodeListi] + mSizes[nodeListi]);
+  return mBasePtrs[nodeListi][i - mOffsets[nodeListi]];
+}
+
+//------------------------------------------------------------------------------
+// Are we aliasing the master?
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+bool
+FieldListThreadWindow<Dimension, DataType>::
+aliased() const {
+  return mAliased;
+}
+
+//------------------------------------------------------------------------------
+// Reduce the overlap of our window with [ibegin, iend) into the master.
+//------------------------------------------------------------------------------
+template<typename Dimension, typename DataType>
+inline
+void
+FieldListThreadWindow<Dimension, DataType>::
+reduce(const unsigned nodeListi,
+       const unsigned ibegin,
+       const unsigned iend) const {
+  REQUIRE(nodeListi < mBasePtrs.size());
+  if (mAliased) return;
+  const auto i0 = std::max(ibegin, mOffsets[nodeListi]);
+  const auto i1 = std::min(iend, mOffsets[nodeListi] + mSizes[nodeListi]);
+  if (i1 > i0) {
+    auto& f = *mMaster[nodeListi];
+    const auto* vals = mBasePtrs[nodeListi];
+    const auto offset = mOffsets[nodeListi];
+    switch (mReductionType) {
+
+    case ThreadReduction::SUM:
+      for (auto i = i0; i < i1; ++i) f(i) += vals[i - offset];
+      break;
+
+    case ThreadReduction::MIN:
+      for (auto i = i0; i < i1; ++i) f(i) = std::min(f(i), vals[i - offset]);
+      break;
+
+    case ThreadReduction::MAX:
+      for (auto i = i0; i < i1; ++i) f(i) = std::max(f(i), vals[i - offset]);
+      break;
+
+    }
+  }
+}
+
+}
@@ -30,6 +30,97 @@ def applyRandomRotation(t, nDimensions):
         t.rotationalTransform(R)
     return
 
+#===============================================================================
+# Fixture for the serial ConnectivityMap tests driven through an Integrator:
+# two fluid NodeLists filling [x0, x1]^dimension as lattices either side of
+# the midplane (so the neighbors span more than one NodeList), with randomly
+# perturbed positions and reflecting boundaries on the outer faces (so setting
+# the ghost nodes creates and culls ghosts).
+#===============================================================================
+class TwoNodeListLattice:
+
+    def __init__(self, testName, dimension, nx, x0, x1, nPerh, ranfrac, rangen):
+        import mpi
+        assert dimension in (1, 2, 3)
+        if mpi.procs > 1:
+            raise RuntimeError, "%s is intended to be run serially" % testName
+        sph = __import__("Spheral%id" % dimension)
+        self.sph = sph
+        self.dimension = dimension
+
+        self.WT = sph.TableKernel(sph.WendlandC4Kernel(), 1000)
+        self.eos = sph.GammaLawGasMKS(5.0/3.0, 1.0)
+        self.nodes1 = sph.makeFluidNodeList("nodes1", self.eos, nPerh = nPerh, kernelExtent = self.WT.kernelExtent)
+        self.nodes2 = sph.makeFluidNodeList("nodes2", self.eos, nPerh = nPerh, kernelExtent = self.WT.kernelExtent)
+        self.nodeSet = [self.nodes1, self.nodes2]
+        xmid = 0.5*(x0 + x1)
+
+        if dimension == 1:
+            from DistributeNodes import distributeNodesInRange1d
+            distributeNodesInRange1d([(self.nodes1, nx/2, 1.0, (x0, xmid)),
+                                      (self.nodes2, nx/2, 1.0, (xmid, x1))], nPerh = nPerh)
+        elif dimension == 2:
+            from GenerateNodeDistribution2d import GenerateNodeDistribution2d
+            from DistributeNodes import distributeNodes2d
+            gen1 = GenerateNodeDistribution2d(nx/2, nx, 1.0, "lattice",
+                                              xmin = (x0, x0),
+                                              xmax = (xmid, x1),
+                                              nNodePerh = nPerh)
+            gen2 = GenerateNodeDistribution2d(nx/2, nx, 1.0, "lattice",
+                                              xmin = (xmid, x0),
+                                              xmax = (x1, x1),
+                                              nNodePerh = nPerh)
+            distributeNodes2d((self.nodes1, gen1), (self.nodes2, gen2))
+        else:
+            from GenerateNodeDistribution3d import GenerateNodeDistribution3d
+            from DistributeNodes import distributeNodes3d
+            gen1 = GenerateNodeDistribution3d(nx/2, nx, nx, 1.0, "lattice",
+                                              xmin = (x0, x0, x0),
+                                              xmax = (xmid, x1, x1),
+                                              nNodePerh = nPerh)
+            gen2 = GenerateNodeDistribution3d(nx/2, nx, nx, 1.0, "lattice",
+                                              xmin = (xmid, x0, x0),
+                                              xmax = (x1, x1, x1),
+                                              nNodePerh = nPerh)
+            distributeNodes3d((self.nodes1, gen1), (self.nodes2, gen2))
+
+        self.dx = (x1 - x0)/nx
+        for nodes in self.nodeSet:
+            pos = nodes.positions()
+            for i in xrange(nodes.numInternalNodes):
+                for j in xrange(dimension):
+                    pos[i][j] += ranfrac*self.dx*rangen.uniform(-1.0, 1.0)
+
+        self.bcs = []
+        for j in xrange(dimension):
+            n0, p0, n1, p1 = sph.Vector(), sph.Vector(), sph.Vector(), sph.Vector()
+            n0[j], p0[j] = 1.0, x0
+            n1[j], p1[j] = -1.0, x1
+            self.bcs += [sph.ReflectingBoundary(sph.Plane(p0, n0)),
+                         sph.ReflectingBoundary(sph.Plane(p1, n1))]
+
+    # A DataBase holding the NodeLists.
+    def dataBase(self):
+        db = self.sph.DataBase()
+        for nodes in self.nodeSet:
+            db.appendNodeList(nodes)
+        return db
+
+    # An SPH package with the boundaries and an integrator driving it, so
+    # integrator.setGhostNodes() builds the connectivity and culls the ghosts
+    # (patching the connectivity) just as it does in a run.
+    def integrator(self, db, IntegratorConstructor = None):
+        sph = self.sph
+        if IntegratorConstructor is None:
+            IntegratorConstructor = sph.CheapSynchronousRK2Integrator
+        hydro = sph.SPH(dataBase = db, W = self.WT, Q = sph.MonaghanGingoldViscosity(1.0, 1.0))
+        for bc in self.bcs:
+            hydro.appendBoundary(bc)
+        integrator = IntegratorConstructor(db)
+        integrator.appendPhysicsPackage(hydro)
+        assert integrator.cullGhostNodes
+        return hydro, integrator
+
 #===============================================================================
 # Base class for the tests, providing the generic set up methods.
 #===============================================================================
@@ -0,0 +1,106 @@
+#ATS:for dimension in (1, 2, 3):
+#ATS:    test(SELF, "--dimension %i" % dimension, label="test batched neighbor lists -- %id (serial)" % dimension)
+#-------------------------------------------------------------------------------
+# Neighbor::setBatchNeighborLists answers a set of (position, H) queries in one
+# pass over a flat cell grid.  Check it selects exactly the nodes the per point
+# setMasterList/setRefineNeighborList calls do, for both NestedGridNeighbor and
+# TreeNeighbor, each of the neighbor search types, and queries both at the
+# nodes of another NodeList and at random points with random anisotropic H.
+#-------------------------------------------------------------------------------
+from math import sqrt
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Batched neighbor lists")
+
+commandLine(
+    dimension = 2,
+    nx1d = 100,
+    nx2d = 20,
+    nx3d = 8,
+    x0 = 0.0,
+    x1 = 1.0,
+    nPerh = 2.01,
+    ranfrac = 0.2,
+    nrandom = 200,
+    seed = 2908431,
+)
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+from NeighborTestBase import TwoNodeListLattice, applyRandomRotation
+nx = {1 : nx1d, 2 : nx2d, 3 : nx3d}[dimension]
+lattice = TwoNodeListLattice("testBatchNeighborLists", dimension, nx, x0, x1, nPerh, ranfrac, rangen)
+sph = lattice.sph
+nodes1, nodes2 = lattice.nodeSet
+db = lattice.dataBase()
+
+#-------------------------------------------------------------------------------
+# The query points:  the nodes of the second NodeList, and random points (some
+# outside the nodes' bounding box) with random, rotated H.
+#-------------------------------------------------------------------------------
+positions = sph.vector_of_Vector()
+H = sph.vector_of_SymTensor()
+for i in xrange(nodes2.numInternalNodes):
+    positions.append(nodes2.positions()[i])
+    H.append(nodes2.Hfield()[i])
+hmin, hmax = 0.2*lattice.dx, 5.0*lattice.dx
+for k in xrange(nrandom):
+    ri = sph.Vector()
+    Hi = sph.SymTensor()
+    for j in xrange(dimension):
+        ri[j] = rangen.uniform(x0 - 0.1*(x1 - x0), x1 + 0.1*(x1 - x0))
+        Hi[j*dimension + j] = 1.0/rangen.uniform(hmin, hmax)
+    applyRandomRotation(Hi, dimension)
+    positions.append(ri)
+    H.append(Hi)
+nq = len(positions)
+
+#-------------------------------------------------------------------------------
+# Compare the batched and per point answers for each Neighbor and search type.
+#-------------------------------------------------------------------------------
+# Keep every Neighbor we register alive, since the NodeList only holds a
+# pointer to it.
+neighborObjects = []
+for NeighborType in (sph.TreeNeighbor, sph.NestedGridNeighbor):
+    for searchType in (sph.Gather, sph.Scatter, sph.GatherScatter):
+        if NeighborType is sph.TreeNeighbor:
+            neighbor = NeighborType(nodes1,
+                                    searchType = searchType,
+                                    kernelExtent = lattice.WT.kernelExtent,
+                                    xmin = sph.Vector.one*(x0 - 1.0),
+                                    xmax = sph.Vector.one*(x1 + 1.0))
+        else:
+            neighbor = NeighborType(nodes1,
+                                    searchType = searchType,
+                                    kernelExtent = lattice.WT.kernelExtent)
+        neighborObjects.append(neighbor)
+        nodes1.registerNeighbor(neighbor)
+        neighbor.updateNodes()
+
+        offsets, neighbors = neighbor.setBatchNeighborLists(positions, H)
+        if len(offsets) != nq + 1 or offsets[0] != 0 or offsets[-1] != len(neighbors):
+            raise ValueError, "%s %s: batched offsets malformed" % (NeighborType.__name__, searchType)
+
+        nchecked = 0
+        for k in xrange(nq):
+            masterList = vector_of_int()
+            coarseNeighbors = vector_of_int()
+            refineNeighbors = vector_of_int()
+            neighbor.setMasterList(positions[k], H[k], masterList, coarseNeighbors)
+            neighbor.setRefineNeighborList(positions[k], H[k], coarseNeighbors, refineNeighbors)
+            answer = sorted(list(refineNeighbors))
+            batch = list(neighbors[offsets[k]:offsets[k + 1]])
+            if batch != sorted(batch):
+                raise ValueError, "%s %s: batched neighbors of query %i not in ascending order" % (NeighborType.__name__, searchType, k)
+            if batch != answer:
+                raise ValueError, "%s %s: batched neighbors of query %i at %s differ from setRefineNeighborList:\n  batch  : %s\n  answer : %s" % \
+                    (NeighborType.__name__, searchType, k, positions[k], batch, answer)
+            nchecked += len(answer)
+        print "%20s %15s : %i queries, %i neighbors match" % (NeighborType.__name__, searchType, nq, nchecked)
+        if nchecked == 0:
+            raise ValueError, "%s %s: no neighbors were found" % (NeighborType.__name__, searchType)
+
+print "PASS"
@@ -0,0 +1,126 @@
+#ATS:for dimension in (1, 2, 3):
+#ATS:    test(SELF, "--dimension %i" % dimension, label="test compressed connectivity -- %id (serial)" % dimension)
+#-------------------------------------------------------------------------------
+# The ConnectivityMap stores the neighbor lists in compressed sparse rows, and
+# hands them out as views that copy to the nested [NodeList][neighbor] lists.
+# Check those lists (contents and ordering) against a brute force search, both
+# after the ghost nodes are culled (which patches the compressed storage) and
+# after a full rebuild with ghost and overlap connectivity, using a range of
+# thread counts for the parallel build.
+#-------------------------------------------------------------------------------
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Compressed connectivity")
+
+commandLine(
+    dimension = 2,
+    nx1d = 60,
+    nx2d = 16,
+    nx3d = 6,
+    x0 = 0.0,
+    x1 = 1.0,
+    nPerh = 2.01,
+    ranfrac = 0.2,
+    seed = 2398714,
+
+    # The thread counts to build the connectivity with.
+    threads = "1,2,4",
+
+    printErrors = True,
+)
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+#-------------------------------------------------------------------------------
+# Two NodeLists, with randomized positions and a range of smoothing scales.
+#-------------------------------------------------------------------------------
+from NeighborTestBase import TwoNodeListLattice
+nx = {1 : nx1d, 2 : nx2d, 3 : nx3d}[dimension]
+lattice = TwoNodeListLattice("testConnectivityCSR", dimension, nx, x0, x1, nPerh, ranfrac, rangen)
+WT = lattice.WT
+nodeSet = lattice.nodeSet
+for nodes in nodeSet:
+    H = nodes.Hfield()
+    for i in xrange(nodes.numInternalNodes):
+        H[i] = H[i]*rangen.uniform(0.8, 1.25)
+
+db = lattice.dataBase()
+cm = db.connectivityMap()
+hydro, integrator = lattice.integrator(db)
+
+#-------------------------------------------------------------------------------
+# The brute force neighbor lists, sorted by node index as the ConnectivityMap
+# orders them:  j is a neighbor of i if either is within the kernel extent of
+# the other.
+#-------------------------------------------------------------------------------
+kernelExtent2 = WT.kernelExtent**2
+
+def bruteForceNeighbors(iNodeList, i):
+    ri = nodeSet[iNodeList].positions()[i]
+    Hi = nodeSet[iNodeList].Hfield()[i]
+    result = []
+    for jNodeList, nodesj in enumerate(nodeSet):
+        pos = nodesj.positions()
+        H = nodesj.Hfield()
+        neighbors = []
+        for j in xrange(nodesj.numNodes):
+            if not (jNodeList == iNodeList and j == i):
+                rij = ri - pos[j]
+                if (Hi*rij).magnitude2() <= kernelExtent2 or (H[j]*rij).magnitude2() <= kernelExtent2:
+                    neighbors.append(j)
+        result.append(neighbors)
+    return result
+
+def isSortedUnique(x):
+    return all([x[k] < x[k + 1] for k in xrange(len(x) - 1)])
+
+def checkConnectivity(label, overlap):
+    errors = []
+    numPairs = 0
+    for iNodeList, nodes in enumerate(nodeSet):
+        n = nodes.numNodes if cm.buildGhostConnectivity else nodes.numInternalNodes
+        for i in xrange(n):
+            neighbors = [list(x) for x in cm.connectivityForNode(nodes, i)]
+            reference = bruteForceNeighbors(iNodeList, i)
+            if neighbors != reference:
+                errors.append((label, nodes.name, i, neighbors, reference))
+            if cm.numNeighborsForNode(nodes, i) != sum([len(x) for x in reference]):
+                errors.append((label, nodes.name, i, "numNeighborsForNode", cm.numNeighborsForNode(nodes, i)))
+            for jNodeList, nodesj in enumerate(nodeSet):
+                for j in reference[jNodeList]:
+                    if cm.calculatePairInteraction(iNodeList, i, jNodeList, j, nodesj.firstGhostNode):
+                        numPairs += 1
+
+            # The overlap lists are sorted and contain the neighbors.
+            if overlap:
+                overlapNeighbors = [list(x) for x in cm.overlapConnectivityForNode(nodes, i)]
+                for jNodeList in xrange(len(nodeSet)):
+                    if not (isSortedUnique(overlapNeighbors[jNodeList]) and
+                            set(reference[jNodeList]).issubset(set(overlapNeighbors[jNodeList]))):
+                        errors.append((label, nodes.name, i, "overlap", overlapNeighbors, reference))
+    if len(cm.nodePairList) != numPairs:
+        errors.append((label, "nodePairList", len(cm.nodePairList), numPairs))
+    if not cm.valid():
+        errors.append((label, "ConnectivityMap::valid failed"))
+    return errors
+
+#-------------------------------------------------------------------------------
+# Build the connectivity with each thread count and compare.
+#-------------------------------------------------------------------------------
+errors = []
+for nt in [int(x) for x in threads.split(",")]:
+    omp_set_num_threads(nt)
+    integrator.setGhostNodes()
+    errors += checkConnectivity("culled, %i threads" % nt, False)
+    db.updateConnectivityMap(True, True)
+    errors += checkConnectivity("ghost + overlap, %i threads" % nt, True)
+
+if errors:
+    if printErrors:
+        for x in errors[:10]:
+            print "  ", x
+    raise ValueError, "Compressed connectivity differs from a brute force search (%i errors)" % len(errors)
+print "PASS"
@@ -0,0 +1,121 @@
+#ATS:for dimension in (1, 2, 3):
+#ATS:    test(SELF, "--dimension %i" % dimension, label="test interior node pairs -- %id (serial)" % dimension)
+#-------------------------------------------------------------------------------
+# The ConnectivityMap orders the NodePairList with the pairs between internal
+# nodes first, so the hydro pair loops can work on them while the ghost values
+# are still in flight.  Check that ordering survives the ghost node culling the
+# Integrator does by default when it sets the ghost nodes, and that the SPH
+# derivatives match with the ghost exchange overlapped and not.
+#-------------------------------------------------------------------------------
+from math import sqrt
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Interior node pairs")
+
+commandLine(
+    dimension = 2,
+    nx1d = 100,
+    nx2d = 20,
+    nx3d = 8,
+    x0 = 0.0,
+    x1 = 1.0,
+    nPerh = 2.01,
+    ranfrac = 0.2,
+    vfrac = 0.1,
+    seed = 5981237,
+
+    tolerance = 1.0e-10,
+)
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+from NeighborTestBase import TwoNodeListLattice
+nx = {1 : nx1d, 2 : nx2d, 3 : nx3d}[dimension]
+lattice = TwoNodeListLattice("testInteriorNodePairs", dimension, nx, x0, x1, nPerh, ranfrac, rangen)
+nodeSet = lattice.nodeSet
+for nodes, eps0 in zip(nodeSet, (1.0, 2.0)):
+    eps = nodes.specificThermalEnergy()
+    vel = nodes.velocity()
+    for i in xrange(nodes.numInternalNodes):
+        eps[i] = eps0
+        for j in xrange(dimension):
+            vel[i][j] = vfrac*rangen.uniform(-1.0, 1.0)
+
+db = lattice.dataBase()
+hydro, integrator = lattice.integrator(db)
+integrator.initializeProblemStartup(db)
+state = lattice.sph.State(db, integrator.physicsPackages())
+derivs = lattice.sph.StateDerivatives(db, integrator.physicsPackages())
+
+#-------------------------------------------------------------------------------
+# Set the ghost nodes (culling them), and check the leading interior pairs.
+#-------------------------------------------------------------------------------
+def checkInteriorPairs():
+    integrator.setGhostNodes()
+    cm = db.connectivityMap()
+    assert sum([nodes.numGhostNodes for nodes in nodeSet]) > 0
+    firstGhostNode = [nodes.firstGhostNode for nodes in nodeSet]
+    pairs = cm.nodePairList
+    ninterior = cm.numInteriorNodePairs
+    expected = len([p for p in pairs if p.i_node < firstGhostNode[p.i_list] and p.j_node < firstGhostNode[p.j_list]])
+    print "Interior pairs: %i of %i" % (ninterior, len(pairs))
+    if ninterior == 0:
+        raise ValueError, "No interior node pairs after culling the ghost nodes"
+    if ninterior != expected:
+        raise ValueError, "Interior node pair count %i, expected %i" % (ninterior, expected)
+    for k in xrange(len(pairs)):
+        p = pairs[k]
+        interior = (p.i_node < firstGhostNode[p.i_list] and p.j_node < firstGhostNode[p.j_list])
+        if interior != (k < ninterior):
+            raise ValueError, "Node pair %i (%s) out of order: interior = %s, numInteriorNodePairs = %i" % (k, p, interior, ninterior)
+
+#-------------------------------------------------------------------------------
+# Evaluate the derivatives with and without overlapping the ghost exchange.
+#-------------------------------------------------------------------------------
+def derivativeFields():
+    return [("DvDt",   derivs.vectorFields(HydroFieldNames.hydroAcceleration)),
+            ("DepsDt", derivs.scalarFields("delta " + HydroFieldNames.specificThermalEnergy)),
+            ("DvDx",   derivs.tensorFields(HydroFieldNames.velocityGradient)),
+            ("Hideal", derivs.symTensorFields("new " + HydroFieldNames.H))]
+
+def evaluate(overlap):
+    integrator.overlapGhostExchange = overlap
+    checkInteriorPairs()
+    derivs.Zero()
+    integrator.preStepInitialize(state, derivs)
+    integrator.initializeDerivatives(0.0, 1.0, state, derivs)
+    integrator.evaluateDerivatives(0.0, 1.0, db, state, derivs)
+    integrator.finalizeDerivatives(0.0, 1.0, db, state, derivs)
+    result = {}
+    for name, fl in derivativeFields():
+        result[name] = [list(fl[k].internalValues()) for k in xrange(len(nodeSet))]
+    return result
+
+def magnitude(x):
+    if isinstance(x, float):
+        return abs(x)
+    elif hasattr(x, "selfDoubledot"):
+        return sqrt(x.selfDoubledot())
+    else:
+        return x.magnitude()
+
+overlapped = evaluate(True)
+serialized = evaluate(False)
+failures = []
+for name in overlapped:
+    scale = max([max([magnitude(x) for x in vals] + [0.0]) for vals in serialized[name]] + [1.0e-50])
+    diff = 0.0
+    for valsa, valsb in zip(overlapped[name], serialized[name]):
+        assert len(valsa) == len(valsb)
+        for xa, xb in zip(valsa, valsb):
+            diff = max(diff, magnitude(xa - xb))
+    print "%8s : max relative difference %g" % (name, diff/scale)
+    if diff > tolerance*scale:
+        failures.append((name, diff/scale))
+
+if failures:
+    raise ValueError, "Derivatives differ with the ghost exchange overlapped: %s" % failures
+print "PASS"
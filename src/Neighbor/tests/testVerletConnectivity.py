@@ -0,0 +1,107 @@
+#ATS:for dimension in (1, 2, 3):
+#ATS:    test(SELF, "--dimension %i" % dimension, label="test Verlet connectivity -- %id (serial)" % dimension)
+#-------------------------------------------------------------------------------
+# Move the nodes and grow their smoothing scales over a series of steps,
+# rebuilding the connectivity each step through the Integrator (setting and
+# culling the ghost nodes) with Verlet candidates enabled.  Whether or not the
+# candidates are reused, the connectivity must match a full neighbor search.
+#-------------------------------------------------------------------------------
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Verlet connectivity")
+
+commandLine(
+    dimension = 2,
+    nx1d = 100,
+    nx2d = 20,
+    nx3d = 8,
+    x0 = 0.0,
+    x1 = 1.0,
+    nPerh = 2.01,
+
+    # Randomize the initial positions, and the node velocities.
+    ranfrac = 0.2,
+    vfrac = 0.02,             # Displacement per step in units of the node spacing
+    Hfrac = 0.998,            # Factor applied to H every step (h grows)
+    seed = 4587231,
+
+    # The Verlet skin (in units of h), and the number of steps to take.
+    verletSkin = 0.5,
+    steps = 40,
+
+    printErrors = True,
+)
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+from NeighborTestBase import TwoNodeListLattice
+nx = {1 : nx1d, 2 : nx2d, 3 : nx3d}[dimension]
+lattice = TwoNodeListLattice("testVerletConnectivity", dimension, nx, x0, x1, nPerh, ranfrac, rangen)
+nodeSet = lattice.nodeSet
+velocities = [[[vfrac*lattice.dx*rangen.uniform(-1.0, 1.0) for j in xrange(dimension)]
+               for i in xrange(nodes.numInternalNodes)]
+              for nodes in nodeSet]
+
+#-------------------------------------------------------------------------------
+# The DataBase we evolve (with Verlet candidates), and one sharing the same
+# NodeLists we use for the reference full neighbor search.
+#-------------------------------------------------------------------------------
+db = lattice.dataBase()
+dbref = lattice.dataBase()
+
+cm = db.connectivityMap()
+cm.verletSkin = verletSkin
+assert dbref.connectivityMap().verletSkin == 0.0
+hydro, integrator = lattice.integrator(db)
+
+#-------------------------------------------------------------------------------
+# Compare the connectivity and pairs against a full search.
+#-------------------------------------------------------------------------------
+def compareConnectivity(cm, cmref):
+    errors = []
+    for iNodeList, nodes in enumerate(nodeSet):
+        for i in xrange(nodes.numInternalNodes):
+            neighbors = cm.connectivityForNode(nodes, i)
+            neighborsRef = cmref.connectivityForNode(nodes, i)
+            if [list(x) for x in neighbors] != [list(x) for x in neighborsRef]:
+                errors.append((nodes.name, i, [list(x) for x in neighbors], [list(x) for x in neighborsRef]))
+    pairs = sorted([(p.i_list, p.i_node, p.j_list, p.j_node) for p in cm.nodePairList])
+    pairsRef = sorted([(p.i_list, p.i_node, p.j_list, p.j_node) for p in cmref.nodePairList])
+    if pairs != pairsRef:
+        errors.append(("nodePairList", len(pairs), len(pairsRef)))
+    return errors
+
+numReused = 0
+numRebuilt = 0
+for step in xrange(steps):
+    if step > 0:
+        for nodes, vel in zip(nodeSet, velocities):
+            pos = nodes.positions()
+            H = nodes.Hfield()
+            for i in xrange(nodes.numInternalNodes):
+                for j in xrange(dimension):
+                    pos[i][j] += vel[i][j]
+                H[i] = H[i]*Hfrac
+    integrator.setGhostNodes()
+    if cm.verletListReused:
+        numReused += 1
+    else:
+        numRebuilt += 1
+
+    dbref.updateConnectivityMap(False, False)
+    errors = compareConnectivity(cm, dbref.connectivityMap())
+    if errors:
+        if printErrors:
+            for x in errors[:10]:
+                print "  ", x
+        raise ValueError, "Verlet connectivity differs from a full neighbor search on step %i (reused = %s)" % (step, cm.verletListReused)
+
+print "Steps reusing the Verlet candidates: %i, full searches: %i" % (numReused, numRebuilt)
+if numReused == 0:
+    raise ValueError, "Verlet candidates were never reused"
+if numRebuilt < 2:
+    raise ValueError, "Verlet candidates were never invalidated by the motion"
+print "PASS"
@@ -76,8 +76,10 @@ unsigned compactFacetedVolumes(std::vector<typename Dimension::FacetedVolume>& s
   Field<Dimension, SymTensor>& H = nodes.Hfield();
   Field<Dimension, double> radius("radius", nodes);
 
-  // Scratch fields for Neighbor operations.
-  vector<int> masterList, coarseNeighbors, refineNeighbors;
+  // Scratch fields for Neighbor operations:  the neighbors of shape i are
+  // neighbors[offsets[i - imin]] ... neighbors[offsets[i - imin + 1] - 1].
+  vector<size_t> offsets;
+  vector<int> neighbors;
 
   // Figure out the effective size per shape.
   for (size_t i = 0; i < nshapes; ++i) {
@@ -126,13 +128,14 @@ unsigned compactFacetedVolumes(std::vector<typename Dimension::FacetedVolume>& s
 
       // Look for any overlapping shapes and drive them apart.
       t0 = std::clock();
+      neighbor.setBatchNeighborLists(vector<Vector>(pos.begin() + imin, pos.begin() + imax),
+                                     vector<SymTensor>(H.begin() + imin, H.begin() + imax),
+                                     offsets, neighbors);
       for (auto i = imin; i < imax; ++i) {
         if (flags[i] == 3) {
           const FacetedVolume bi = shapes[i] + centers[i];
-          neighbor.setMasterList(i, masterList, coarseNeighbors);
-          neighbor.setRefineNeighborList(i, coarseNeighbors, refineNeighbors);
-          for (auto jitr = refineNeighbors.begin(); jitr != refineNeighbors.end(); ++jitr) {
-            const auto j = *jitr;
+          for (auto k = offsets[i - imin]; k < offsets[i - imin + 1]; ++k) {
+            const auto j = neighbors[k];
             if (j != (int)i) {
               if ((flags[j] == 1 and bi.intersect(shapes[j])) or
                   (j > (int)i and flags[j] >= 2 and bi.intersect(shapes[j] + centers[j]))) {
@@ -190,6 +193,9 @@ unsigned compactFacetedVolumes(std::vector<typename Dimension::FacetedVolume>& s
       //  Check the current level of overlap.
       t0 = std::clock();
       neighbor.updateNodes();
+      neighbor.setBatchNeighborLists(vector<Vector>(pos.begin() + imin, pos.begin() + imax),
+                                     vector<SymTensor>(H.begin() + imin, H.begin() + imax),
+                                     offsets, neighbors);
       maxoverlap = 0.0;
       for (auto i = imin; i < imax; ++i) {
         if (flags[i] >= 2) {
@@ -200,10 +206,8 @@ unsigned compactFacetedVolumes(std::vector<typename Dimension::FacetedVolume>& s
           // CHECK(neighbors.size() == 1);
           // for (auto j: neighbors[0]) {
           // for (auto j = 0; j != nshapes; ++j) {
-          neighbor.setMasterList(i, masterList, coarseNeighbors);
-          neighbor.setRefineNeighborList(i, coarseNeighbors, refineNeighbors);
-          for (auto jitr = refineNeighbors.begin(); jitr != refineNeighbors.end(); ++jitr) {
-            const auto j = *jitr;
+          for (auto k = offsets[i - imin]; k < offsets[i - imin + 1]; ++k) {
+            const auto j = neighbors[k];
             if (j != (int)i) {
               if (flags[j] >= 1) {
                 FacetedVolume shapej;
@@ -84,6 +84,7 @@ GenericHydro(ArtificialViscosity<Dimension>& Q,
   mArtificialViscosity(Q),
   mCfl(cfl),
   mUseVelocityMagnitudeForDt(useVelocityMagnitudeForDt),
+  mThreadReductionMethod(ThreadReductionMethod::FullCopy),
   mMinMasterNeighbor(INT_MAX),
   mMaxMasterNeighbor(0),
   mSumMasterNeighbor(0),
@@ -379,4 +380,97 @@ dt(const DataBase<Dimension>& dataBase,
   return minDt;
 }
 
+//------------------------------------------------------------------------------
+// Per node timestep votes, for individual timestep integrators.  These are
+// the same criteria as dt above, without the bookkeeping of the reasons.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+GenericHydro<Dimension>::
+nodeTimesteps(const DataBase<Dimension>& dataBase,
+              const State<Dimension>& state,
+              const StateDerivatives<Dimension>& derivs,
+              typename Dimension::Scalar /*currentTime*/,
+              FieldList<Dimension, typename Dimension::Scalar>& dt) const {
+
+  const double tiny = std::numeric_limits<double>::epsilon();
+
+  // Get some useful fluid variables from the DataBase.
+  const auto  mask = state.fields(HydroFieldNames::timeStepMask, 1);
+  const auto  velocity = state.fields(HydroFieldNames::velocity, Vector::zero);
+  const auto  rho = state.fields(HydroFieldNames::massDensity, 0.0);
+  const auto  H = state.fields(HydroFieldNames::H, SymTensor::zero);
+  const auto  cs = state.fields(HydroFieldNames::soundSpeed, 0.0);
+  const auto  maxViscousPressure = derivs.fields(HydroFieldNames::maxViscousPressure, 0.0);
+  const auto  DvDx = derivs.fields(HydroFieldNames::velocityGradient, Tensor::zero);
+  const auto  DvDt = derivs.fields(HydroFieldNames::hydroAcceleration, Vector::zero);
+  const auto& connectivityMap = dataBase.connectivityMap(this->requireGhostConnectivity(),
+                                                         this->requireOverlapConnectivity());
+  const auto  numNodeLists = connectivityMap.nodeLists().size();
+  REQUIRE(dt.numFields() == numNodeLists);
+
+  // Optional solid state.
+  const auto haveDS = state.fieldNameRegistered(SolidFieldNames::deviatoricStress);
+  FieldList<Dimension, SymTensor> S;
+  if (haveDS) S = state.fields(SolidFieldNames::deviatoricStress, SymTensor::zero);
+  const auto haveLongCs = state.fieldNameRegistered(SolidFieldNames::longitudinalSoundSpeed);
+  FieldList<Dimension, Scalar> csl;
+  if (haveLongCs) csl = state.fields(SolidFieldNames::longitudinalSoundSpeed, 0.0);
+
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto& fluidNodeList = **(dataBase.fluidNodeListBegin() + nodeListi);
+    const auto nPerh = fluidNodeList.nodesPerSmoothingScale();
+    CHECK(nPerh > 0.0);
+    const bool useCsl = haveLongCs and csl.haveNodeList(fluidNodeList);
+    const Field<Dimension, Scalar>* cslptr = nullptr;
+    if (useCsl) cslptr = *csl.fieldForNodeList(fluidNodeList);
+    const bool useS = haveDS and S.haveNodeList(fluidNodeList);
+    const Field<Dimension, SymTensor>* Sptr = nullptr;
+    if (useS) Sptr = *S.fieldForNodeList(fluidNodeList);
+
+    const auto ni = connectivityMap.numNodes(nodeListi);
+#pragma omp parallel for
+    for (auto k = 0; k < ni; ++k) {
+      const auto i = connectivityMap.ithNode(nodeListi, k);
+      if (mask(nodeListi, i) == 1 and dt(nodeListi, i) > 0.0) {
+        const auto& Hi = H(nodeListi, i);
+        const auto  nodeScalei = 1.0/Hi.eigenValues().maxElement()/nPerh;
+        const auto  rhoi = rho(nodeListi, i);
+        CHECK(rhoi > 0.0);
+
+        // Effective signal speeds: sound speed, longitudinal sound speed,
+        // deviatoric stress, and artificial viscosity.
+        auto csmax = cs(nodeListi, i);
+        if (useCsl) csmax = std::max(csmax, (*cslptr)(i));
+        if (useS) csmax = std::max(csmax, sqrt((*Sptr)(i).eigenValues().maxAbsElement()/rhoi));
+        csmax = std::max(csmax, sqrt(maxViscousPressure(nodeListi, i)/rhoi));
+        auto dti = nodeScalei/(csmax + tiny);
+
+        // Velocity divergence limit.
+        dti = std::min(dti, 1.0/(std::abs(DvDx(nodeListi, i).Trace()) + tiny));
+
+        // Maximum velocity difference limit.
+        const auto& vi = velocity(nodeListi, i);
+        const auto& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+        for (auto nodeListj = 0u; nodeListj != numNodeLists; ++nodeListj) {
+          for (const auto j: fullConnectivity[nodeListj]) {
+            const auto nodeScalej = 1.0/H(nodeListj, j).eigenValues().maxElement()/nPerh;
+            const auto vij = vi - velocity(nodeListj, j);
+            dti = std::min(dti, std::min(nodeScalei, nodeScalej)*safeInvVar(vij.magnitude(), 1e-30));
+          }
+        }
+
+        // Total acceleration limit.
+        const auto vmagi = vi.magnitude();
+        dti = std::min(dti, 0.1*std::max(nodeScalei/(vmagi + tiny), vmagi/(DvDt(nodeListi, i).magnitude() + tiny)));
+
+        // If requested, limit against the absolute velocity.
+        if (useVelocityMagnitudeForDt()) dti = std::min(dti, nodeScalei/(vmagi + 1.0e-10));
+
+        dt(nodeListi, i) = std::min(dt(nodeListi, i), cfl()*dti);
+      }
+    }
+  }
+}
+
 }
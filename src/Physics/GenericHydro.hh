@@ -8,6 +8,7 @@
 
 #include "Physics.hh"
 #include "Geometry/Dimension.hh"
+#include "Utilities/OpenMP_wrapper.hh"
 
 namespace Spheral {
 
@@ -56,6 +57,13 @@ public:
                           const StateDerivatives<Dimension>& derivs,
                           const Scalar currentTime) const;
 
+  // The same timestep criteria evaluated per node.
+  virtual void nodeTimesteps(const DataBase<Dimension>& dataBase,
+                             const State<Dimension>& state,
+                             const StateDerivatives<Dimension>& derivs,
+                             const Scalar currentTime,
+                             FieldList<Dimension, Scalar>& dt) const override;
+
   // Allow access to the artificial viscosity.
   ArtificialViscosity<Dimension>& artificialViscosity() const;
 
@@ -68,6 +76,10 @@ public:
   bool useVelocityMagnitudeForDt() const;
   void useVelocityMagnitudeForDt(bool x);
 
+  // How thread-local contributions are merged in the threaded pair loops.
+  ThreadReductionMethod threadReductionMethod() const;
+  void threadReductionMethod(ThreadReductionMethod x);
+
   // Return the cumulative neighboring statistics.
   int minMasterNeighbor() const;
   int maxMasterNeighbor() const;
@@ -97,6 +109,7 @@ private:
   ArtificialViscosity<Dimension>& mArtificialViscosity;
   Scalar mCfl;
   bool mUseVelocityMagnitudeForDt;
+  ThreadReductionMethod mThreadReductionMethod;
 
   mutable int mMinMasterNeighbor, mMaxMasterNeighbor, mSumMasterNeighbor;
   mutable int mMinCoarseNeighbor, mMaxCoarseNeighbor, mSumCoarseNeighbor;
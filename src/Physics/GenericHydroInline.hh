@@ -52,6 +52,24 @@ useVelocityMagnitudeForDt(bool x) {
   mUseVelocityMagnitudeForDt = x;
 }
 
+//------------------------------------------------------------------------------
+// The method used to reduce thread-local values in pair loops.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+ThreadReductionMethod
+GenericHydro<Dimension>::threadReductionMethod() const {
+  return mThreadReductionMethod;
+}
+
+template<typename Dimension>
+inline
+void
+GenericHydro<Dimension>::
+threadReductionMethod(ThreadReductionMethod x) {
+  mThreadReductionMethod = x;
+}
+
 //------------------------------------------------------------------------------
 // Return the master neighboring statistics.
 //------------------------------------------------------------------------------
@@ -6,6 +6,9 @@
 //----------------------------------------------------------------------------//
 #include "Physics.hh"
 #include "Boundary/Boundary.hh"
+#include "Field/FieldList.hh"
+
+#include <algorithm>
 
 using std::vector;
 using std::cout;
@@ -34,6 +37,27 @@ Physics<Dimension>::
 ~Physics() {
 }
 
+//------------------------------------------------------------------------------
+// By default apply our global timestep vote to every node.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+Physics<Dimension>::
+nodeTimesteps(const DataBase<Dimension>& dataBase,
+              const State<Dimension>& state,
+              const StateDerivatives<Dimension>& derivs,
+              const Scalar currentTime,
+              FieldList<Dimension, Scalar>& dt) const {
+  const auto dtVote = this->dt(dataBase, state, derivs, currentTime).first;
+  if (dtVote > 0.0) {
+    const auto numNodeLists = dt.numFields();
+    for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+      const auto n = dt[nodeListi]->numInternalElements();
+      for (auto i = 0u; i < n; ++i) dt(nodeListi, i) = std::min(dt(nodeListi, i), dtVote);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Add a Boundary condition to the end of the current boundary list.
 //------------------------------------------------------------------------------
@@ -206,6 +230,17 @@ requireOverlapConnectivity() const {
   return false;
 }
 
+//------------------------------------------------------------------------------
+// By default packages need the ghost values complete before evaluating their
+// derivatives.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+Physics<Dimension>::
+overlapGhostExchange() const {
+  return false;
+}
+
 //------------------------------------------------------------------------------
 // By default assume reproducing kernels are not needed.
 //------------------------------------------------------------------------------
@@ -21,6 +21,7 @@ template<typename Dimension> class State;
 template<typename Dimension> class StateDerivatives;
 template<typename Dimension> class DataBase;
 template<typename Dimension> class Boundary;
+template<typename Dimension, typename DataType> class FieldList;
 
 template<typename Dimension>
 class Physics {
@@ -57,6 +58,17 @@ public:
                           const StateDerivatives<Dimension>& derivs,
                           const Scalar currentTime) const = 0;
 
+  // Optionally vote on a time step per node, for individual timestep
+  // integrators.  dt is a FieldList over the fluid NodeLists of the DataBase,
+  // which packages reduce their votes into (dt = min(dt, vote)); nodes with
+  // dt <= 0 on input are not of interest and may be skipped.  The default
+  // applies this package's global dt vote to every node.
+  virtual void nodeTimesteps(const DataBase<Dimension>& dataBase,
+                             const State<Dimension>& state,
+                             const StateDerivatives<Dimension>& derivs,
+                             const Scalar currentTime,
+                             FieldList<Dimension, Scalar>& dt) const;
+
   // Register the state you want carried around (and potentially evolved), as
   // well as the policies for such evolution.
   virtual void registerState(DataBase<Dimension>& dataBase,
@@ -151,6 +163,12 @@ public:
   // Some physics algorithms require overlap connectivity.
   virtual bool requireOverlapConnectivity() const;
 
+  // Can evaluateDerivatives start while the ghost communication preceding it is
+  // still in flight?  Such packages must only read ghost values after calling
+  // ConnectivityMap::completeGhostExchange, e.g., by evaluating the interior
+  // pairs first (see PairThreadReduction).
+  virtual bool overlapGhostExchange() const;
+
   // Does this package require reproducing kernel functions?
   virtual std::set<RKOrder> requireReproducingKernels() const;
 
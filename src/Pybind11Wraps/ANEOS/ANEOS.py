@@ -101,6 +101,8 @@ an appropriate range for (rhoMin, rhoMax), (Tmin, Tmax), *and* have enough value
                                               doc="Get the specific thermal energy lookup table values")
     atomicWeight = PYB11property("double", "atomicWeight", "atomicWeight")
     externalPressure = PYB11property("double", "externalPressure", "externalPressure")
+    useInterpolation = PYB11property("bool", "useInterpolation", "useInterpolation",
+                                     doc="Evaluate all quantities by interpolating in the (rho, T) tables rather than calling ANEOS per point")
     
 #-------------------------------------------------------------------------------
 # Add the virtual interface
@@ -308,6 +308,12 @@ class Boundary:
         "Some boundaries need to know when a problem is starting up and all the physics packages have been initialized."
         return "void"
 
+    @PYB11virtual
+    @PYB11const
+    def beginGhostBoundary(self):
+        "Optional hook to start any communication needed for the ghost boundaries applied so far, which finalizeGhostBoundary will then complete."
+        return "void"
+
     @PYB11virtual
     @PYB11const
     def finalizeGhostBoundary(self):
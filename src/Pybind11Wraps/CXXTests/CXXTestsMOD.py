@@ -9,9 +9,20 @@ from spheralDimensions import *
 dims = spheralDimensions()
 
 PYB11includes = ['"CXXTests/testNodeIterators.hh"',
-                 '"CXXTests/test_r3d_utils.hh"',
+                 '"CXXTests/benchmarkHotPaths.hh"',
+                 '"CXXTests/testStateSnapshots.hh"',
+                 '"CXXTests/testRKCoefficients.hh"',
+                 '"CXXTests/testTableKernelBlockLookup.hh"',
+                 '"CXXTests/testSPHSumDensityAndOmegaGradh.hh"',
                  '"Geometry/Dimension.hh"',
-                 '"DataBase/DataBase.hh"']
+                 '"DataBase/DataBase.hh"',
+                 '"DataBase/State.hh"',
+                 '"DataBase/StateDerivatives.hh"',
+                 '"Physics/Physics.hh"',
+                 '"Kernel/TableKernel.hh"',
+                 '"Material/EquationOfState.hh"',
+                 '"Field/Field.hh"',
+                 '"NodeList/NodeList.hh"']
 
 PYB11namespaces = ["Spheral"]
 
@@ -59,33 +70,109 @@ PYB11namespaces = ["Spheral"]
 # ''' % {"ndim" : ndim})
 
 #-------------------------------------------------------------------------------
-# R3D tests
+# Hot path benchmarks
 #-------------------------------------------------------------------------------
-def test_polygon_to_r2d_poly():
-    "Test converting r2d_poly <- polygon."
-    return "std::string"
+@PYB11template("Dimension")
+def benchmarkConnectivityMap(dataBase = "const DataBase<%(Dimension)s>&",
+                             computeGhostConnectivity = "const bool",
+                             nrepeat = "const unsigned"):
+    "Time (seconds) rebuilding the ConnectivityMap nrepeat times."
+    return "std::vector<double>"
+
+@PYB11template("Dimension")
+def benchmarkPhysicsInitialize(physics = "Physics<%(Dimension)s>&",
+                               dataBase = "const DataBase<%(Dimension)s>&",
+                               state = "State<%(Dimension)s>&",
+                               derivs = "StateDerivatives<%(Dimension)s>&",
+                               nrepeat = "const unsigned"):
+    "Time (seconds) calling Physics::initialize nrepeat times."
+    return "std::vector<double>"
+
+@PYB11template("Dimension")
+def benchmarkEvaluateDerivatives(physics = "const Physics<%(Dimension)s>&",
+                                 dataBase = "const DataBase<%(Dimension)s>&",
+                                 state = "const State<%(Dimension)s>&",
+                                 derivs = "StateDerivatives<%(Dimension)s>&",
+                                 nrepeat = "const unsigned"):
+    "Time (seconds) calling Physics::evaluateDerivatives nrepeat times."
+    return "std::vector<double>"
+
+@PYB11template("Dimension")
+def benchmarkTableKernel(W = "const TableKernel<%(Dimension)s>&",
+                         n = "const unsigned",
+                         nrepeat = "const unsigned"):
+    "Time (seconds) n TableKernel value & gradient lookups, nrepeat times."
+    return "std::vector<double>"
+
+@PYB11template("Dimension")
+def benchmarkEquationOfState(eos = "const EquationOfState<%(Dimension)s>&",
+                             massDensity = "const Field<%(Dimension)s, %(Dimension)s::Scalar>&",
+                             specificThermalEnergy = "const Field<%(Dimension)s, %(Dimension)s::Scalar>&",
+                             nrepeat = "const unsigned"):
+    "Time (seconds) setting the pressure, sound speed, and temperature nrepeat times."
+    return "std::vector<double>"
+
+for ndim in dims:
+    exec('''
+benchmarkConnectivityMap%(ndim)id     = PYB11TemplateFunction(benchmarkConnectivityMap,     template_parameters="Dim<%(ndim)i>", pyname="benchmarkConnectivityMap")
+benchmarkPhysicsInitialize%(ndim)id   = PYB11TemplateFunction(benchmarkPhysicsInitialize,   template_parameters="Dim<%(ndim)i>", pyname="benchmarkPhysicsInitialize")
+benchmarkEvaluateDerivatives%(ndim)id = PYB11TemplateFunction(benchmarkEvaluateDerivatives, template_parameters="Dim<%(ndim)i>", pyname="benchmarkEvaluateDerivatives")
+benchmarkTableKernel%(ndim)id         = PYB11TemplateFunction(benchmarkTableKernel,         template_parameters="Dim<%(ndim)i>", pyname="benchmarkTableKernel")
+benchmarkEquationOfState%(ndim)id     = PYB11TemplateFunction(benchmarkEquationOfState,     template_parameters="Dim<%(ndim)i>", pyname="benchmarkEquationOfState")
+''' % {"ndim" : ndim})
 
-def test_r2d_poly_to_polygon():
-    "Test converting r2d_poly -> polygon."
+#-------------------------------------------------------------------------------
+# State snapshots
+#-------------------------------------------------------------------------------
+@PYB11template("Dimension")
+def testStateSnapshots(nodes = "NodeList<%(Dimension)s>&"):
+    "Test State::copyState with a snapshot pool, State::swapState, and Field::swapValues."
     return "std::string"
 
-def test_polyhedron_to_r3d_poly():
-    "Test converting r3d_poly <- polyhedron."
-    return "std::string"
+for ndim in dims:
+    exec('''
+testStateSnapshots%(ndim)id = PYB11TemplateFunction(testStateSnapshots, template_parameters="Dim<%(ndim)i>", pyname="testStateSnapshots")
+''' % {"ndim" : ndim})
 
-def test_r3d_poly_to_polyhedron():
-    "Test converting r3d_poly -> polyhedron."
+#-------------------------------------------------------------------------------
+# RKCoefficients
+#-------------------------------------------------------------------------------
+@PYB11template("Dimension")
+def testRKCoefficients(seed = "const unsigned"):
+    "Test the RKCoefficients storage, packing, and RKUtilities::applyTransformation."
     return "std::string"
 
-def test_clip_polygon():
-    "Test clipping."
-    return "std::string"
+for ndim in dims:
+    exec('''
+testRKCoefficients%(ndim)id = PYB11TemplateFunction(testRKCoefficients, template_parameters="Dim<%(ndim)i>")
+''' % {"ndim" : ndim})
 
-def test_orphan_polygon():
-    "Test clipping."
+#-------------------------------------------------------------------------------
+# TableKernel block lookups
+#-------------------------------------------------------------------------------
+@PYB11template("Dimension")
+def testTableKernelBlockLookup(W = "const TableKernel<%(Dimension)s>&",
+                               n = "const unsigned",
+                               seed = "const unsigned"):
+    "Test the block TableKernel::kernelAndGradValues against the scalar lookups."
     return "std::string"
 
-def test_clip_polyhedron():
-    "Test clipping."
+for ndim in dims:
+    exec('''
+testTableKernelBlockLookup%(ndim)id = PYB11TemplateFunction(testTableKernelBlockLookup, template_parameters="Dim<%(ndim)i>", pyname="testTableKernelBlockLookup")
+''' % {"ndim" : ndim})
+
+#-------------------------------------------------------------------------------
+# SPH fused sum density and grad h correction
+#-------------------------------------------------------------------------------
+@PYB11template("Dimension")
+def testSPHSumDensityAndOmegaGradh(dataBase = "const DataBase<%(Dimension)s>&",
+                                   W = "const TableKernel<%(Dimension)s>&",
+                                   tolerance = "const double"):
+    "Test the fused SPH sum density and grad h correction against the separate passes."
     return "std::string"
 
+for ndim in dims:
+    exec('''
+testSPHSumDensityAndOmegaGradh%(ndim)id = PYB11TemplateFunction(testSPHSumDensityAndOmegaGradh, template_parameters="Dim<%(ndim)i>", pyname="testSPHSumDensityAndOmegaGradh")
+''' % {"ndim" : ndim})
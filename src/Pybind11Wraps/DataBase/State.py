@@ -114,7 +114,13 @@ class State(StateBase):
 
     policy10 = PYB11TemplateMethod(policy, "int", pyname="policy")
 
+    def policyLevels(self):
+        "The policy keys grouped into the levels of the dependency graph, in the order they are fired by update"
+        return "std::vector<std::vector<KeyType>>"
+
     #...........................................................................
     # Proerties
     policyKeys = PYB11property("std::vector<KeyType>", "policyKeys", doc="The full set of keys for all policies")
     timeAdvanceOnly = PYB11property("bool", "timeAdvanceOnly", "timeAdvanceOnly", doc="Optionally trip a flag indicating policies should time advance only -- no replacing state!")
+    concurrentPolicyUpdates = PYB11property("bool", "concurrentPolicyUpdates", "concurrentPolicyUpdates", doc="Optionally fire independent policies concurrently as OpenMP tasks")
+    measureWork = PYB11property("bool", "measureWork", "measureWork", doc="Optionally time the policies, charging NodeList specific policies to the work of those nodes")
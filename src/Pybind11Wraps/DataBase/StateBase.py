@@ -130,6 +130,10 @@ class StateBase:
         "Set this StateBase's state equal to the other"
         return "void"
 
+    def swapState(self, rhs="StateBase<%(Dimension)s>&"):
+        "Set this StateBase's state equal to the other by exchanging values with it"
+        return "void"
+
     @PYB11static
     def key(self, field="const FieldBase<%(Dimension)s>&"):
         "Construct a key for the given Field"
@@ -12,6 +12,7 @@ from RestartableObject import *
 # Includes
 #-------------------------------------------------------------------------------
 PYB11includes += ['"DataOutput/RestartRegistrar.hh"',
+                  '"DataOutput/AsyncRestartWriter.hh"',
                   '"RestartableObject.hh"',
                   '"FileIO/FileIO.hh"']
             
@@ -57,3 +58,29 @@ class RestartRegistrar:
     @PYB11returnpolicy("take_ownership")
     def instance(self):
         return "RestartRegistrar*"
+
+#-------------------------------------------------------------------------------
+# AsyncRestartWriter
+#-------------------------------------------------------------------------------
+class AsyncRestartWriter:
+    """Write restart files in the background.
+dumpState snapshots the registered state into memory and returns, while a
+background thread writes the snapshot to disk (in the MemoryFileIO format)."""
+
+    def pyinit(self,
+               maxPending = "const unsigned"):
+        "Construct allowing at most maxPending snapshots in flight"
+
+    def dumpState(self,
+                  fileName = "const std::string"):
+        "Snapshot the state of all restartable handles and queue it to be written to fileName"
+        return "void"
+
+    def wait(self):
+        "Block until all queued snapshots have been written"
+        return "void"
+
+    # Attributes
+    maxPending = PYB11property("unsigned", "maxPending", "maxPending", doc="The maximum number of snapshots in flight")
+    numPending = PYB11property("unsigned", "numPending", doc="The number of snapshots waiting to be written")
+    numWritten = PYB11property("unsigned", "numWritten", doc="The total number of snapshots written")
@@ -88,6 +88,12 @@ conditions, connecting NodeLists across parallel domains."""
         "Override the Boundary method for culling ghost nodes."
         return "void"
 
+    @PYB11virtual
+    @PYB11const
+    def beginGhostBoundary(self):
+        "Override the base method to post the deferred exchanges."
+        return "void"
+
     @PYB11virtual
     @PYB11const
     def finalizeGhostBoundary(self):
@@ -114,6 +120,11 @@ conditions, connecting NodeLists across parallel domains."""
         "Start a non-blocking Field exchange"
         return "void"
 
+    @PYB11const
+    def beginExchanges(self):
+        "Pack and post the deferred fixed size Field exchanges, as one message per neighbor domain."
+        return "void"
+
     def finalizeExchanges(self):
         "Force the exchanges which have been registered to execute."
         return "void"
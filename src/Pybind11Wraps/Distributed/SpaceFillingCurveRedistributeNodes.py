@@ -169,3 +169,4 @@ This returns the set sorted by the index."""
     maxNodesPerDomainFraction = PYB11property("double")
     workBalance = PYB11property("bool")
     localReorderOnly = PYB11property("bool")
+    migrationFraction = PYB11property("double")
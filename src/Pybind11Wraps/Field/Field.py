@@ -139,6 +139,11 @@ class Field(FieldBase):
         "Copy a range of values from/to elements of the Field"
         return "void"
 
+    @PYB11virtual
+    def swapValues(self, rhs="FieldBase<%(Dimension)s>&"):
+        "Exchange values with another Field of the same type on the same NodeList"
+        return "void"
+
     #...........................................................................
     # Methods
     @PYB11const
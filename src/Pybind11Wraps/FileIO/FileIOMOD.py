@@ -20,6 +20,8 @@ PYB11includes += ['"NodeList/NodeList.hh"',
                   '"FileIO/FileIO.hh"',
                   '"FileIO/FlatFileIO.hh"',
                   '"FileIO/SiloFileIO.hh"',
+                  '"FileIO/ParallelHDF5FileIO.hh"',
+                  '"FileIO/MemoryFileIO.hh"',
                   '"FileIO/PyFileIO.hh"',
                   '"FileIO/vectorstringUtilities.hh"']
 
@@ -151,6 +153,8 @@ FlatFileFormat = PYB11enum(("ascii", "binary"), export_values=True,
 from FileIO import *
 from FlatFileIO import *
 from SiloFileIO import *
+from ParallelHDF5FileIO import *
+from MemoryFileIO import *
 from PyFileIO import *
 
 #-------------------------------------------------------------------------------
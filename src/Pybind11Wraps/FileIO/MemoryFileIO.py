@@ -0,0 +1,45 @@
+#-------------------------------------------------------------------------------
+# MemoryFileIO
+#-------------------------------------------------------------------------------
+from PYB11Generator import *
+from FileIO import *
+from FileIOAbstractMethods import *
+from FileIOTemplateMethods import *
+from spheralDimensions import *
+dims = spheralDimensions()
+
+class MemoryFileIO(FileIO):
+    "FileIO held in memory, and written to (or read from) a single binary file on close (open)"
+
+    #...........................................................................
+    # Constructors
+    def pyinit0(self):
+        "Default constructor"
+
+    def pyinit1(self,
+                filename = "const std::string",
+                access = "AccessType"):
+        "Open a file with a given file name and access"
+
+    #...........................................................................
+    # Override abstract methods
+    @PYB11virtual
+    def open(self,
+             fileName = "const std::string",
+             access = "AccessType"):
+        "Open a file for IO"
+        return "void"
+
+    @PYB11virtual
+    def close(self):
+        "Close the current file we're pointing at"
+        return "void"
+
+    #...........................................................................
+    # Properties
+    numBytes = PYB11property("size_t", "numBytes", doc="The number of bytes currently held")
+
+#-------------------------------------------------------------------------------
+# Override the required virtual interface
+#-------------------------------------------------------------------------------
+PYB11inject(FileIOAbstractMethods, MemoryFileIO, virtual=True, pure_virtual=False)
@@ -0,0 +1,52 @@
+#-------------------------------------------------------------------------------
+# ParallelHDF5FileIO
+#-------------------------------------------------------------------------------
+from PYB11Generator import *
+from FileIO import *
+from FileIOAbstractMethods import *
+from FileIOTemplateMethods import *
+from spheralDimensions import *
+dims = spheralDimensions()
+
+class ParallelHDF5FileIO(FileIO):
+    "Handle FileIO for a single HDF5 file shared by all processes"
+
+    #...........................................................................
+    # Constructors
+    def pyinit0(self):
+        "Default constructor"
+
+    def pyinit1(self,
+                filename = "const std::string",
+                access = "AccessType"):
+        "Open an HDF5 file with a given file name and access"
+
+    def pyinit2(self,
+                filename = "const std::string",
+                access = "AccessType",
+                compressionLevel = "const int"):
+        "Open an HDF5 file with a given file name, access, and compression level (0-9)"
+
+    #...........................................................................
+    # Override abstract methods
+    @PYB11virtual
+    def open(self,
+             fileName = "const std::string",
+             access = "AccessType"):
+        "Open a file for IO"
+        return "void"
+
+    @PYB11virtual
+    def close(self):
+        "Close the current file we're pointing at"
+        return "void"
+
+    #...........................................................................
+    # Properties
+    compressionLevel = PYB11property("int", "compressionLevel", "compressionLevel",
+                                     doc="The deflate compression level (0-9) for datasets we write")
+
+#-------------------------------------------------------------------------------
+# Override the required virtual interface
+#-------------------------------------------------------------------------------
+PYB11inject(FileIOAbstractMethods, ParallelHDF5FileIO, virtual=True, pure_virtual=False)
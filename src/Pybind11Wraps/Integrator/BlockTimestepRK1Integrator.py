@@ -0,0 +1,57 @@
+#-------------------------------------------------------------------------------
+# BlockTimestepRK1Integrator
+#-------------------------------------------------------------------------------
+from PYB11Generator import *
+from IntegratorAbstractMethods import *
+from Integrator import *
+
+@PYB11template("Dimension")
+@PYB11cppname("BlockTimestepRK1")
+class BlockTimestepRK1Integrator(Integrator):
+    "First-order in time explicit integration scheme using hierarchical individual (block) timesteps"
+
+    PYB11typedefs = """
+    typedef typename %(Dimension)s::Scalar Scalar;
+    typedef typename %(Dimension)s::Vector Vector;
+    typedef typename %(Dimension)s::Tensor Tensor;
+    typedef typename %(Dimension)s::SymTensor SymTensor;
+    typedef typename %(Dimension)s::ThirdRankTensor ThirdRankTensor;
+"""
+
+    #...........................................................................
+    # Constructors
+    def pyinit(self):
+        "Construct an itegrator"
+
+    def pyinit1(self, dataBase = "DataBase<%(Dimension)s>&"):
+        "Construct an integrator with a DataBase"
+
+    def pyinit2(self,
+                dataBase = "DataBase<%(Dimension)s>&",
+                physicsPackages = "const std::vector<Physics<%(Dimension)s>*>&"):
+        "Construct an integrator with a DataBase and physics packages"
+
+    #...........................................................................
+    # Virtual methods
+    @PYB11virtual
+    @PYB11pycppname("step")
+    def step1(self, maxTime="Scalar"):
+        "Take a step"
+        return "bool"
+
+    @PYB11virtual
+    @PYB11const
+    def label(self):
+        return "std::string"
+
+    #...........................................................................
+    # Properties
+    maxRung = PYB11property("unsigned", "maxRung", "maxRung", doc="The maximum rung: the smallest node timestep is dt/2^maxRung")
+    maxDrift = PYB11property("double", "maxDrift", "maxDrift", doc="The drift (in units of h) allowed before the ghost nodes and connectivity are rebuilt on a substep")
+    lastNumRungs = PYB11property("unsigned", "lastNumRungs", doc="The number of rungs used in the last step")
+    lastWorkFraction = PYB11property("double", "lastWorkFraction", doc="Node advances in the last step relative to advancing every node on every substep")
+
+#-------------------------------------------------------------------------------
+# Inject other interfaces
+#-------------------------------------------------------------------------------
+PYB11inject(IntegratorAbstractMethods, BlockTimestepRK1Integrator, pure_virtual=False, virtual=True)
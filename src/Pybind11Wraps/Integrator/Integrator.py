@@ -143,6 +143,10 @@ several times during a time step."""
         "Set the ghost node values on the Fields of the nodes lists in the data base."
         return "void"
 
+    def beginGhostBoundaries(self):
+        "Start any communication for the ghost node boundary conditions applied so far."
+        return "void"
+
     def finalizeGhostBoundaries(self):
         "Finalize the ghost node boundary conditions."
         return "void"
@@ -182,6 +186,9 @@ into compliance."""
     allowDtCheck = PYB11property("bool", "allowDtCheck", "allowDtCheck", doc="Should the integrator check interim timestep votes and abort steps?")
     domainDecompositionIndependent = PYB11property("bool", "domainDecompositionIndependent", "domainDecompositionIndependent", doc="Order operations to be bit perfect reproducible regardless of domain decomposition")
     cullGhostNodes = PYB11property("bool", "cullGhostNodes", "cullGhostNodes", doc="Cull ghost nodes to just active set")
+    overlapGhostExchange = PYB11property("bool", "overlapGhostExchange", "overlapGhostExchange", doc="Overlap the ghost communication before each derivative evaluation with the interior node pairs")
+    measureWork = PYB11property("bool", "measureWork", "measureWork", doc="Measure the time spent each step and attribute it to the nodes (NodeList::work) for load balancing")
+    cachePairGeometry = PYB11property("bool", "cachePairGeometry", "cachePairGeometry", doc="Share cached per-pair geometry and kernel values between the physics packages during each derivative evaluation")
 
 #-------------------------------------------------------------------------------
 # Inject other interfaces
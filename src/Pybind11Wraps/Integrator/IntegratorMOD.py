@@ -24,7 +24,8 @@ PYB11includes += ['"DataBase/DataBase.hh"',
                   '"Integrator/SynchronousRK2.hh"',
                   '"Integrator/SynchronousRK4.hh"',
                   '"Integrator/CheapSynchronousRK2.hh"',
-                  '"Integrator/Verlet.hh"']
+                  '"Integrator/Verlet.hh"',
+                  '"Integrator/BlockTimestepRK1.hh"']
 
 #-------------------------------------------------------------------------------
 # Namespaces
@@ -41,6 +42,7 @@ from SynchronousRK2Integrator import *
 from SynchronousRK4Integrator import *
 from CheapSynchronousRK2Integrator import *
 from VerletIntegrator import *
+from BlockTimestepRK1Integrator import *
 
 for ndim in dims:
     exec('''
@@ -51,5 +53,6 @@ SynchronousRK2Integrator%(ndim)id = PYB11TemplateClass(SynchronousRK2Integrator,
 SynchronousRK4Integrator%(ndim)id = PYB11TemplateClass(SynchronousRK4Integrator, template_parameters="%(Dimension)s")
 CheapSynchronousRK2Integrator%(ndim)id = PYB11TemplateClass(CheapSynchronousRK2Integrator, template_parameters="%(Dimension)s")
 VerletIntegrator%(ndim)id = PYB11TemplateClass(VerletIntegrator, template_parameters="%(Dimension)s")
+BlockTimestepRK1Integrator%(ndim)id = PYB11TemplateClass(BlockTimestepRK1Integrator, template_parameters="%(Dimension)s")
 ''' % {"ndim"      : ndim,
        "Dimension" : "Dim<" + str(ndim) + ">"})
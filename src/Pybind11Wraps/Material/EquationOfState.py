@@ -36,6 +36,19 @@ class EquationOfState:
                                          maxIterations = ("const unsigned", "100")):
         return "Scalar"
 
+    @PYB11virtual
+    @PYB11const
+    def setState(self,
+                 pressure = "ScalarField*",
+                 soundSpeed = "ScalarField*",
+                 temperature = "ScalarField*",
+                 gamma = "ScalarField*",
+                 bulkModulus = "ScalarField*",
+                 massDensity = "const ScalarField&",
+                 specificThermalEnergy = "const ScalarField&"):
+        "Compute any of the pressure, sound speed, temperature, gamma, and bulk modulus in a single pass (None outputs are skipped)"
+        return "void"
+
     @PYB11virtual
     @PYB11const
     def molecularWeight(self):
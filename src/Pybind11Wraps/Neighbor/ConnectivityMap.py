@@ -34,39 +34,48 @@ Note this method assumes neighbor info is symmetric, and removes the pair connec
 member of a pair (maintaining symmetry)."""
         return "void"
 
-    @PYB11returnpolicy("reference_internal")
+    def restrictNodePairs(self,
+                          active = "const FieldList<%(Dimension)s, int>&"):
+        "Restrict the nodePairList to pairs involving at least one active internal node"
+        return "void"
+
+    def unrestrictNodePairs(self):
+        "Lift any restriction on the nodePairList"
+        return "void"
+
     @PYB11const
+    @PYB11implementation("[](const ConnectivityMap<%(Dimension)s>& self, const NodeListType* nodeList, const int nodeID) { return std::vector<std::vector<int>>(self.connectivityForNode(nodeList, nodeID)); }")
     def connectivityForNode(self,
                             nodeList = "const NodeListType*",
                             nodeID = "const int"):
         "Get the set of neighbors for the given (internal!) node in the given NodeList."
-        return "const std::vector<std::vector<int>>&"
+        return "std::vector<std::vector<int>>"
 
-    @PYB11returnpolicy("reference_internal")
     @PYB11const
     @PYB11pycppname("connectivityForNode")
+    @PYB11implementation("[](const ConnectivityMap<%(Dimension)s>& self, const int nodeListID, const int nodeID) { return std::vector<std::vector<int>>(self.connectivityForNode(nodeListID, nodeID)); }")
     def connectivityForNode1(self,
                              nodeListID = "const int",
                              nodeID = "const int"):
         "Get the set of neighbors for the given (internal!) node in the given NodeList."
-        return "const std::vector<std::vector<int>>&"
+        return "std::vector<std::vector<int>>"
 
-    @PYB11returnpolicy("reference_internal")
     @PYB11const
+    @PYB11implementation("[](const ConnectivityMap<%(Dimension)s>& self, const NodeListType* nodeList, const int nodeID) { return std::vector<std::vector<int>>(self.overlapConnectivityForNode(nodeList, nodeID)); }")
     def overlapConnectivityForNode(self,
                                    nodeList = "const NodeListType*",
                                    nodeID = "const int"):
         "The set of points that have non-zero overlap with the given point."
-        return "const std::vector<std::vector<int>>&"
+        return "std::vector<std::vector<int>>"
 
-    @PYB11returnpolicy("reference_internal")
     @PYB11const
     @PYB11pycppname("overlapConnectivityForNode")
+    @PYB11implementation("[](const ConnectivityMap<%(Dimension)s>& self, const int nodeListID, const int nodeID) { return std::vector<std::vector<int>>(self.overlapConnectivityForNode(nodeListID, nodeID)); }")
     def overlapConnectivityForNode1(self,
                                     nodeListID = "const int",
                                     nodeID = "const int"):
         "The set of points that have non-zero overlap with the given point."
-        return "const std::vector<std::vector<int>>&"
+        return "std::vector<std::vector<int>>"
 
     @PYB11const
     def connectivityIntersectionForNodes(self,
@@ -140,6 +149,11 @@ member of a pair (maintaining symmetry)."""
         "Return which NodeList index in order the given one would be in our connectivity."
         return "unsigned"
 
+    @PYB11const
+    def connectivityMemoryUsage(self):
+        "Bytes of memory used to store the connectivity."
+        return "size_t"
+
     @PYB11const
     def valid(self):
         "Check that the internal data structure is valid."
@@ -154,3 +168,8 @@ member of a pair (maintaining symmetry)."""
                               doc="The set of NodeLists we have connectivity for")
     nodePairList = PYB11property(returnpolicy="reference",
                                  doc="The connectivity as a set of (nodeListi, i, nodeListj, j)")
+    verletSkin = PYB11property("double", "verletSkin", "verletSkin",
+                               doc="Verlet list skin (in units of h); 0 disables Verlet candidate reuse")
+    verletListReused = PYB11property(doc="Did the last rebuild reuse the Verlet candidates?")
+    nodePairsRestricted = PYB11property(doc="Is the nodePairList currently restricted to active nodes?")
+    numInteriorNodePairs = PYB11property(doc="The number of leading pairs in nodePairList between internal nodes")
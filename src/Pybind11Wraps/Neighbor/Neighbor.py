@@ -99,6 +99,22 @@ class Neighbor:
         "Return a culled list of potential neighbors based on the (min,max) info given"
         return "std::vector<int>"
 
+    @PYB11const
+    @PYB11implementation("""[](const Neighbor<%(Dimension)s>& self,
+                               const std::vector<Vector>& positions,
+                               const std::vector<SymTensor>& H) {
+                                   std::vector<size_t> offsets;
+                                   std::vector<int> neighbors;
+                                   self.setBatchNeighborLists(positions, H, offsets, neighbors);
+                                   return py::make_tuple(offsets, neighbors);
+                               }""")
+    def setBatchNeighborLists(self,
+                              positions = "const std::vector<Vector>&",
+                              H = "const std::vector<SymTensor>&"):
+        """Find the neighbors in our NodeList for each of a set of query points (position, H) in one pass.
+Returns (offsets, neighbors): the neighbors of query point k are neighbors[offsets[k]:offsets[k+1]]."""
+        return "py::tuple"
+
     #...........................................................................
     # Virtual methods
     @PYB11virtual
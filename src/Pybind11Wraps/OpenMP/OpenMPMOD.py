@@ -30,6 +30,6 @@ def omp_get_num_threads():
     "Get the number of OpenMP threads."
     return
 
-def omp_set_num_threads():
-    "Set the number of OpenMP threads."
+def omp_set_num_threads(num_threads = "int"):
+    "Set the number of OpenMP threads (a no-op without OpenMP)."
     return
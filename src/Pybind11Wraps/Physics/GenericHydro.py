@@ -36,6 +36,16 @@ class GenericHydro(Physics):
         "Vote on a time step."
         return "TimeStepType"
 
+    @PYB11virtual
+    @PYB11const
+    def nodeTimesteps(dataBase = "const DataBase<%(Dimension)s>&",
+                      state = "const State<%(Dimension)s>&",
+                      derivs = "const StateDerivatives<%(Dimension)s>&",
+                      currentTime = "const Scalar",
+                      dt = "FieldList<%(Dimension)s, Scalar>&"):
+        "Vote on a time step per node."
+        return "void"
+
     #...........................................................................
     # Protected methods
     @PYB11protected
@@ -63,6 +73,7 @@ class GenericHydro(Physics):
     artificialViscosity = PYB11property("ArtificialViscosity<%(Dimension)s>&", "artificialViscosity", doc="The artificial viscosity object")
     cfl = PYB11property("Scalar", "cfl", "cfl", doc="The Courant-Friedrichs-Lewy timestep limit multiplier")
     useVelocityMagnitudeForDt = PYB11property("bool", "useVelocityMagnitudeForDt", "useVelocityMagnitudeForDt", doc="Should the pointwise velocity magnitude be used to limit the timestep?")
+    threadReductionMethod = PYB11property("ThreadReductionMethod", "threadReductionMethod", "threadReductionMethod", doc="How thread-local values are merged in threaded pair loops")
     minMasterNeighbor = PYB11property("int", "minMasterNeighbor", doc="minimum number of master neighbors found")
     maxMasterNeighbor = PYB11property("int", "maxMasterNeighbor", doc="maximum number of master neighbors found")
     averageMasterNeighbor = PYB11property("double", "averageMasterNeighbor", doc="average number of master neighbors found")
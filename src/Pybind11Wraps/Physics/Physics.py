@@ -93,6 +93,17 @@ class Physics:
         "Provide a hook to be called after the state has been updated and boundary conditions have been enforced."
         return "void"
 
+    @PYB11virtual
+    @PYB11const
+    def nodeTimesteps(self,
+                      dataBase = "const DataBase<%(Dimension)s>&",
+                      state = "const State<%(Dimension)s>&",
+                      derivs = "const StateDerivatives<%(Dimension)s>&",
+                      currentTime = "const Scalar",
+                      dt = "FieldList<%(Dimension)s, Scalar>&"):
+        "Optionally vote on a time step per node (dt = min(dt, vote)), for individual timestep integrators."
+        return "void"
+
     @PYB11virtual
     @PYB11const
     def requireConnectivity(self):
@@ -111,6 +122,12 @@ class Physics:
         "Some physics algorithms require overlap connectivity to be constructed."
         return "bool"
 
+    @PYB11virtual
+    @PYB11const
+    def overlapGhostExchange(self):
+        "Can evaluateDerivatives start while the ghost communication preceding it is still in flight?"
+        return "bool"
+
     @PYB11virtual
     @PYB11const
     def requireReproducingKernels(self):
@@ -17,7 +17,8 @@ PYB11includes += ['"Physics/Physics.hh"',
                   '"Physics/GenericBodyForce.hh"',
                   '"Boundary/Boundary.hh"',
                   '"ArtificialViscosity/ArtificialViscosity.hh"',
-                  '"Kernel/TableKernel.hh"']
+                  '"Kernel/TableKernel.hh"',
+                  '"Field/FieldList.hh"']
 
 #-------------------------------------------------------------------------------
 # Namespaces
@@ -36,6 +37,8 @@ MassDensityType = PYB11enum(("SumDensity",
                              "CorrectedSumDensity"), export_values=True)
 HEvolutionType = PYB11enum(("IdealH", 
                             "IntegrateH"), export_values = True)
+ThreadReductionMethod = PYB11enum(("FullCopy",
+                                   "TouchedRange"), export_values = True)
 
 #-------------------------------------------------------------------------------
 # Do our dimension dependent instantiations.
@@ -239,3 +239,145 @@ The result is returned as a vector<vector<int>>, where each inner vector is a se
 ints representing vertex indices in the input Polyhedron."""
     return "std::vector<std::vector<int>>"
 
+
+#-------------------------------------------------------------------------------
+# ArenaVertex3d
+#-------------------------------------------------------------------------------
+class ArenaVertex3d:
+    """Vertex class for the PolyClipper::ArenaPolyhedron.
+The neighbors and clips of the vertex are slices of the pools owned by the polyhedron."""
+
+    # Constructors
+    def pyinit0(self):
+        "Default constructor"
+
+    def pyinit1(self,
+                position = "const ArenaVertex3d::Vector&",
+                c = "int"):
+        "Construct with a position and initial compare flag."
+
+    # Attributes
+    position = PYB11readwrite(doc="The position of the vertex.")
+    neighborOffset = PYB11readwrite(doc="The offset of the vertex neighbors in the polyhedron neighbors pool.")
+    numNeighbors = PYB11readwrite(doc="The number of vertex neighbors.")
+    neighborCapacity = PYB11readwrite(doc="The space reserved for the vertex neighbors in the polyhedron neighbors pool.")
+    clipOffset = PYB11readwrite(doc="The offset of the vertex clips in the polyhedron clips pool.")
+    numClips = PYB11readwrite(doc="The number of vertex clips.")
+    clipCapacity = PYB11readwrite(doc="The space reserved for the vertex clips in the polyhedron clips pool.")
+    comp = PYB11readwrite(doc="The current comparison flag.")
+    ID = PYB11readwrite(doc="The ID or index of the vertex.")
+
+vector_of_ArenaVertex3d = PYB11_bind_vector("PolyClipper::ArenaVertex3d", opaque=True, local=False)
+
+#-------------------------------------------------------------------------------
+# ArenaPolyhedron
+#-------------------------------------------------------------------------------
+class ArenaPolyhedron:
+    """A PolyClipper::Polyhedron with the vertex neighbors and clips stored in flat pools.
+Used for clipping many polyhedra (i.e., Voronoi cells) without allocating."""
+
+    # Constructors
+    def pyinit(self):
+        "Default constructor"
+
+    # Methods
+    @PYB11const
+    def size(self):
+        "The number of vertices."
+        return "size_t"
+
+    @PYB11const
+    def empty(self):
+        "Is the polyhedron empty?"
+        return "bool"
+
+    def clear(self):
+        "Remove all vertices."
+        return "void"
+
+    @PYB11implementation("[](const ArenaPolyhedron& self, const size_t i) { if (i >= self.size()) throw py::index_error(); const auto& v = self[i]; return std::vector<int>(self.neighbors.begin() + v.neighborOffset, self.neighbors.begin() + v.neighborOffset + v.numNeighbors); }")
+    def vertexNeighbors(self,
+                        i = "const size_t"):
+        "The (CCW ordered) neighbors of the i'th vertex."
+        return "std::vector<int>"
+
+    @PYB11implementation("[](const ArenaPolyhedron& self, const size_t i) { if (i >= self.size()) throw py::index_error(); const auto& v = self[i]; return std::set<int>(self.clips.begin() + v.clipOffset, self.clips.begin() + v.clipOffset + v.numClips); }")
+    def vertexClips(self,
+                    i = "const size_t"):
+        "The set of plane IDs (if any) responsible for the i'th vertex."
+        return "std::set<int>"
+
+    # Sequence methods
+    @PYB11implementation("[](const ArenaPolyhedron& self) { return self.size(); }")
+    def __len__(self):
+        "The number of vertices."
+
+    @PYB11returnpolicy("reference_internal")
+    @PYB11implementation("[](ArenaPolyhedron& self, const size_t i) -> ArenaVertex3d& { if (i >= self.size()) throw py::index_error(); return self[i]; }")
+    def __getitem__(self):
+        "The i'th vertex."
+
+    # Attributes
+    vertices = PYB11readwrite(doc="The vertices.")
+    neighbors = PYB11readwrite(doc="The pool of vertex neighbors.")
+    clips = PYB11readwrite(doc="The pool of vertex clips.")
+
+#-------------------------------------------------------------------------------
+# ArenaPolyhedron methods.
+#-------------------------------------------------------------------------------
+@PYB11namespace("PolyClipper")
+def convertToArenaPolyhedron(result = "ArenaPolyhedron&",
+                             polyhedron = "const Polyhedron&"):
+    "Construct a PolyClipper::ArenaPolyhedron from a PolyClipper::Polyhedron."
+    return "void"
+
+@PYB11namespace("PolyClipper")
+def convertFromArenaPolyhedron(result = "Polyhedron&",
+                               polyhedron = "const ArenaPolyhedron&"):
+    "Construct a PolyClipper::Polyhedron from a PolyClipper::ArenaPolyhedron."
+    return "void"
+
+@PYB11namespace("PolyClipper")
+@PYB11pycppname("polyhedron2string")
+def arenaPolyhedron2string(poly = "const ArenaPolyhedron&"):
+    "Return a formatted string representation for a PolyClipper::ArenaPolyhedron."
+    return "std::string"
+
+@PYB11namespace("PolyClipper")
+@PYB11pycppname("convertFromPolyhedron")
+def convertFromArenaPolyhedronToSpheral(Spheral_polyhedron = "Spheral::Dim<3>::FacetedVolume&",
+                                        polyhedron = "const ArenaPolyhedron&"):
+    "Construct a Spheral::Polyhedron from a PolyClipper::ArenaPolyhedron.  Returns the set of clip planes responsible for each vertex."
+    return "std::vector<std::set<int>>"
+
+@PYB11namespace("PolyClipper")
+@PYB11pycppname("extractFaces")
+def extractFacesArenaPolyhedron(poly = "const ArenaPolyhedron&"):
+    "Return the vertex indices of a PolyClipper::ArenaPolyhedron ordered in faces."
+    return "std::vector<std::vector<int>>"
+
+@PYB11namespace("PolyClipper")
+@PYB11implementation("""[](const ArenaPolyhedron& self) {
+                                                          double zerothMoment;
+                                                          Spheral::Dim<3>::Vector firstMoment;
+                                                          moments(zerothMoment, firstMoment, self);
+                                                          return py::make_tuple(zerothMoment, firstMoment);
+                                                        }""")
+@PYB11pycppname("moments")
+def momentsArenaPolyhedron(poly = "const ArenaPolyhedron&"):
+    "Compute the zeroth and first moment of a PolyClipper::ArenaPolyhedron."
+    return "py::tuple"
+
+@PYB11namespace("PolyClipper")
+@PYB11pycppname("clipPolyhedron")
+def clipArenaPolyhedron(poly = "ArenaPolyhedron&",
+                        planes = "const std::vector<Plane3d>&"):
+    "Clip a PolyClipper::ArenaPolyhedron with a collection of planes."
+    return "void"
+
+@PYB11namespace("PolyClipper")
+@PYB11pycppname("collapseDegenerates")
+def collapseDegeneratesArenaPolyhedron(poly = "ArenaPolyhedron&",
+                                       tol = "const double"):
+    "Collapse edges in a PolyClipper::ArenaPolyhedron below the given tolerance."
+    return "void"
@@ -69,4 +69,6 @@ class RKCoefficients:
 
     #...........................................................................
     correctionOrder = PYB11readwrite(doc="The correction order of the coefficients")
-    coeffs = PYB11readwrite(doc="The coefficients vector")
+    coeffs = PYB11property(getterraw="[](const SelfType& self) { return self.coeffs(); }",
+                           setterraw="[](SelfType& self, const std::vector<double>& x) { self.coeffs(x); }",
+                           doc="The coefficients vector")
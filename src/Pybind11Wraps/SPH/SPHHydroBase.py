@@ -137,6 +137,8 @@ boundary conditions."""
                                             doc="Flag to determine if we're applying the linear correction for the velocity gradient.")
     sumMassDensityOverAllNodeLists = PYB11property("bool", "sumMassDensityOverAllNodeLists", "sumMassDensityOverAllNodeLists",
                                                    doc="Flag to determine if the sum density definition extends over neighbor NodeLists.")
+    fuseSumDensityGradh = PYB11property("bool", "fuseSumDensityGradh", "fuseSumDensityGradh",
+                                        doc="Flag to compute the grad h correction in the same pass over the node pairs as the sum density.")
     filter = PYB11property("double", "filter", "filter", doc="Fraction of position filtering to apply.")
     epsilonTensile = PYB11property("double", "epsilonTensile", "epsilonTensile",
                                    doc="Parameters for the tensile correction force at small scales.")
@@ -19,6 +19,7 @@ from SolidSPHHydroBase import *
 PYB11includes += ['"SPH/SPHHydroBase.hh"',
                   '"SPH/PSPHHydroBase.hh"',
                   '"SPH/computeSPHSumMassDensity.hh"',
+                  '"SPH/computeSPHSumMassDensityAndOmegaGradh.hh"',
                   '"SPH/computeSPHOmegaGradhCorrection.hh"',
                   '"SPH/SPHHydroBaseRZ.hh"',
                   '"SPH/SPHHydroBaseGSRZ.hh"',
@@ -58,6 +59,19 @@ def computeSPHOmegaGradhCorrection(connectivityMap = "const ConnectivityMap<%(Di
     "Compute the SPH grad h correction due to Springel et al."
     return "void"
 
+@PYB11template("Dimension")
+def computeSPHSumMassDensityAndOmegaGradh(connectivityMap = "const ConnectivityMap<%(Dimension)s>&",
+                                          W = "const TableKernel<%(Dimension)s>&",
+                                          sumOverAllNodeLists = "const bool",
+                                          position = "const FieldList<%(Dimension)s, typename %(Dimension)s::Vector>&",
+                                          mass = "const FieldList<%(Dimension)s, typename %(Dimension)s::Scalar>&",
+                                          H = "const FieldList<%(Dimension)s, typename %(Dimension)s::SymTensor>&",
+                                          massDensity = "FieldList<%(Dimension)s, typename %(Dimension)s::Scalar>&",
+                                          omegaGradh = "FieldList<%(Dimension)s, typename %(Dimension)s::Scalar>&",
+                                          method = ("const ThreadReductionMethod", "ThreadReductionMethod::FullCopy")):
+    "Compute the SPH mass density summation and grad h correction together in one pass over the node pairs."
+    return "void"
+
 #-------------------------------------------------------------------------------
 # Instantiate our types
 #-------------------------------------------------------------------------------
@@ -69,6 +83,7 @@ SolidSPHHydroBase%(ndim)id = PYB11TemplateClass(SolidSPHHydroBase, template_para
 
 computeSPHSumMassDensity%(ndim)id = PYB11TemplateFunction(computeSPHSumMassDensity, template_parameters="%(Dimension)s")
 computeSPHOmegaGradhCorrection%(ndim)id = PYB11TemplateFunction(computeSPHOmegaGradhCorrection, template_parameters="%(Dimension)s")
+computeSPHSumMassDensityAndOmegaGradh%(ndim)id = PYB11TemplateFunction(computeSPHSumMassDensityAndOmegaGradh, template_parameters="%(Dimension)s")
 ''' % {"ndim"      : ndim,
        "Dimension" : "Dim<" + str(ndim) + ">"})
 
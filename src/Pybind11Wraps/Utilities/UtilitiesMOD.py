@@ -27,6 +27,8 @@ PYB11includes += ['"Utilities/packElement.hh"',
                   '"Utilities/nodeOrdering.hh"',
                   '"Utilities/mortonOrderIndices.hh"',
                   '"Utilities/peanoHilbertOrderIndices.hh"',
+                  '"Utilities/reorderNodesBySpaceFillingCurve.hh"',
+                  '"Neighbor/ConnectivityMap.hh"',
                   '"Utilities/boundingBox.hh"',
                   '"Utilities/globalBoundingVolumes.hh"',
                   '"Utilities/testBoxIntersection.hh"',
@@ -198,6 +200,23 @@ def peanoHilbertOrderIndices_db(dataBase = "const DataBase<%(Dimension)s>&"):
     "Return the Peano-Hilbert ordering for the positions in the DataBase"
     return "FieldList<%(Dimension)s, typename KeyTraits::Key>"
 
+@PYB11template("Dimension")
+def reorderNodesBySpaceFillingCurve(dataBase = "DataBase<%(Dimension)s>&",
+                                    usePeanoHilbert = ("const bool", "true")):
+    """Reorder the internal nodes of every NodeList in the DataBase in place along
+a space filling curve (Peano-Hilbert or Morton) for memory locality.
+Removes the ghost nodes, so the ghost nodes and connectivity must be rebuilt
+afterward."""
+    return "void"
+
+@PYB11template("Dimension")
+def nonlocalNodePairFraction(connectivityMap = "const ConnectivityMap<%(Dimension)s>&",
+                             window = ("const unsigned", "256u")):
+    """The fraction of the node pairs (within a NodeList) in the ConnectivityMap
+whose node indices are more than window apart -- a proxy for how poorly
+the node ordering matches the spatial ordering."""
+    return "double"
+
 @PYB11template("Dimension")
 def numberDensity(dataBase = "const DataBase<%(Dimension)s>&",
                   W = "const TableKernel<%(Dimension)s>&"):
@@ -306,6 +325,8 @@ mortonOrderIndices_db%(ndim)id = PYB11TemplateFunction(mortonOrderIndices_db, te
 mortonOrderIndices_mask%(ndim)id = PYB11TemplateFunction(mortonOrderIndices_mask, template_parameters="%(Dimension)s", pyname="mortonOrderIndices%(ndim)id")
 peanoHilbertOrderIndices_pos%(ndim)id = PYB11TemplateFunction(peanoHilbertOrderIndices_pos, template_parameters="%(Dimension)s", pyname="peanoHilbertOrderIndices%(ndim)id")
 peanoHilbertOrderIndices_db%(ndim)id = PYB11TemplateFunction(peanoHilbertOrderIndices_db, template_parameters="%(Dimension)s", pyname="peanoHilbertOrderIndices%(ndim)id")
+reorderNodesBySpaceFillingCurve%(ndim)id = PYB11TemplateFunction(reorderNodesBySpaceFillingCurve, template_parameters="%(Dimension)s")
+nonlocalNodePairFraction%(ndim)id = PYB11TemplateFunction(nonlocalNodePairFraction, template_parameters="%(Dimension)s")
 
 numberDensity%(ndim)id = PYB11TemplateFunction(numberDensity, template_parameters="%(Dimension)s")
 integrateThroughMeshAlongSegment%(ndim)id = PYB11TemplateFunction(integrateThroughMeshAlongSegment, template_parameters=("%(Dimension)s", "double"))
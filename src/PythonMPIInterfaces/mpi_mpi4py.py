@@ -12,6 +12,10 @@ from SpheralTestUtilities import globalFrame
 import mpi4py
 mpi4py.rc.recv_mprobe = False
 
+# The integrators may complete the ghost node exchange from the master thread
+# of an OpenMP parallel region, which needs at least MPI_THREAD_FUNNELED.
+mpi4py.rc.thread_level = "funneled"
+
 # Now go on as usual...
 from mpi4py import MPI
 
@@ -1,81 +1,127 @@
 //---------------------------------Spheral++----------------------------------//
 // RKCoefficients
 //
-// Wraps the reproducing kernel correction coefficients
+// Wraps the reproducing kernel correction coefficients.  The coefficients
+// for the common (up to linear with hessian) orders live inline in the
+// struct, so a Field of RKCoefficients is one contiguous fixed stride block
+// rather than a vector of individually allocated vectors.
 //----------------------------------------------------------------------------//
 #ifndef __LLNLSpheral_RKCoefficients__
 #define __LLNLSpheral_RKCoefficients__
 
 #include "RK/RKCorrectionParams.hh"
 #include <vector>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
 #include <iostream>
 
 namespace Spheral {
 
+//------------------------------------------------------------------------------
+// The number of coefficients we store inline (without a heap allocation) per
+// node: enough for linear corrections with gradients and hessians, which
+// covers the default RK configurations.  Higher orders spill to the heap.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+struct RKCoefficientsInlineSize {
+  static constexpr unsigned value = (Dimension::nDim + 1u)*(1u + Dimension::nDim + Dimension::nDim*(Dimension::nDim + 1u)/2u) + 1u;
+};
+
 template<typename Dimension>
 struct RKCoefficients {
+  // Some convient methods to make us behave like a std::vector<double>
+  typedef double value_type;
+  typedef std::allocator<double> allocator_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef double& reference;
+  typedef const double& const_reference;
+  typedef double* pointer;
+  typedef const double* const_pointer;
+  typedef double* iterator;
+  typedef const double* const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  static constexpr size_type inlineCapacity = RKCoefficientsInlineSize<Dimension>::value;
+
   RKOrder correctionOrder;        // The correction order
-  std::vector<double> coeffs;     // The coefficients for use with ReproducingKernel/RKUtilities
 
   // Constructors and such
-  RKCoefficients(): correctionOrder(RKOrder::ZerothOrder), coeffs() {}
-  RKCoefficients(const RKCoefficients& rhs): correctionOrder(rhs.correctionOrder), coeffs(rhs.coeffs) {}
-  RKCoefficients& operator=(const RKCoefficients& rhs) { correctionOrder = rhs.correctionOrder; coeffs = rhs.coeffs; return *this; }
+  RKCoefficients(): correctionOrder(RKOrder::ZerothOrder), mSize(0u), mOverflow() {}
+  RKCoefficients(const RKCoefficients& rhs): correctionOrder(rhs.correctionOrder), mSize(rhs.mSize), mOverflow(rhs.mOverflow) { if (mSize <= inlineCapacity) std::copy(rhs.mInline, rhs.mInline + mSize, mInline); }
+  RKCoefficients& operator=(const RKCoefficients& rhs) {
+    if (this != &rhs) {
+      correctionOrder = rhs.correctionOrder;
+      mSize = rhs.mSize;
+      if (mSize <= inlineCapacity) {
+        std::copy(rhs.mInline, rhs.mInline + mSize, mInline);
+        mOverflow.clear();
+      } else {
+        mOverflow = rhs.mOverflow;
+      }
+    }
+    return *this;
+  }
 
-  // Some convient methods to make us behave like a std::vector<double>
-  typedef std::vector<double>::value_type value_type;
-  typedef std::vector<double>::allocator_type allocator_type;
-  typedef std::vector<double>::size_type size_type;
-  typedef std::vector<double>::difference_type difference_type;
-  typedef std::vector<double>::reference reference;
-  typedef std::vector<double>::const_reference const_reference;
-  typedef std::vector<double>::pointer pointer;
-  typedef std::vector<double>::const_pointer const_pointer;
-  typedef std::vector<double>::iterator iterator;
-  typedef std::vector<double>::const_iterator const_iterator;
-  typedef std::vector<double>::reverse_iterator reverse_iterator;
-  typedef std::vector<double>::const_reverse_iterator const_reverse_iterator;
-  
-  reference at(size_type i)                                   { return coeffs.at(i); }    
-  reference operator[](size_type i)                           { return coeffs[i]; }       
-  reference front()                                           { return coeffs.front(); } 
-  reference back()                                            { return coeffs.back(); }  
-  pointer data()                                              { return coeffs.data(); }   
-  iterator begin()                                            { return coeffs.begin(); }  
-  iterator end()                                              { return coeffs.end(); }    
-  reverse_iterator rbegin()                                   { return coeffs.rbegin(); } 
-  reverse_iterator rend()                                     { return coeffs.rend(); }   
-
-  const_reference at(size_type i)                       const { return coeffs.at(i); }
-  const_reference operator[](size_type i)               const { return coeffs[i]; }
-  const_reference front()                               const { return coeffs.front(); }
-  const_reference back()                                const { return coeffs.back(); }
-  const_pointer data()                                  const { return coeffs.data(); }
-  const_iterator begin()                                const { return coeffs.begin(); }
-  const_iterator end()                                  const { return coeffs.end(); }
-  const_reverse_iterator rbegin()                       const { return coeffs.rbegin(); }
-  const_reverse_iterator rend()                         const { return coeffs.rend(); }
+  reference at(size_type i)                                   { if (i >= mSize) throw std::out_of_range("RKCoefficients::at"); return data()[i]; }
+  reference operator[](size_type i)                           { return data()[i]; }
+  reference front()                                           { return data()[0]; }
+  reference back()                                            { return data()[mSize - 1u]; }
+  pointer data()                                              { return mSize <= inlineCapacity ? mInline : mOverflow.data(); }
+  iterator begin()                                            { return data(); }
+  iterator end()                                              { return data() + mSize; }
+  reverse_iterator rbegin()                                   { return reverse_iterator(end()); }
+  reverse_iterator rend()                                     { return reverse_iterator(begin()); }
+
+  const_reference at(size_type i)                       const { if (i >= mSize) throw std::out_of_range("RKCoefficients::at"); return data()[i]; }
+  const_reference operator[](size_type i)               const { return data()[i]; }
+  const_reference front()                               const { return data()[0]; }
+  const_reference back()                                const { return data()[mSize - 1u]; }
+  const_pointer data()                                  const { return mSize <= inlineCapacity ? mInline : mOverflow.data(); }
+  const_iterator begin()                                const { return data(); }
+  const_iterator end()                                  const { return data() + mSize; }
+  const_reverse_iterator rbegin()                       const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend()                         const { return const_reverse_iterator(begin()); }
   
-  const_iterator cbegin()                               const { return coeffs.cbegin(); }
-  const_iterator cend()                                 const { return coeffs.cend(); }
-  const_reverse_iterator crbegin()                      const { return coeffs.crbegin(); }
-  const_reverse_iterator crend()                        const { return coeffs.crend(); }
-
-  void clear()                                                { coeffs.clear(); }
-  bool empty()                                          const { return coeffs.empty(); }
-  size_type size()                                      const { return coeffs.size(); }
-  void resize(size_type count, double value=0.0)              { coeffs.resize(count, value); }
+  const_iterator cbegin()                               const { return begin(); }
+  const_iterator cend()                                 const { return end(); }
+  const_reverse_iterator crbegin()                      const { return rbegin(); }
+  const_reverse_iterator crend()                        const { return rend(); }
+
+  void clear()                                                { mSize = 0u; mOverflow.clear(); }
+  bool empty()                                          const { return mSize == 0u; }
+  size_type size()                                      const { return mSize; }
+  void resize(size_type count, double value=0.0) {
+    if (count <= inlineCapacity) {
+      if (mSize > inlineCapacity) std::copy(mOverflow.begin(), mOverflow.begin() + count, mInline);
+      if (count > mSize) std::fill(mInline + mSize, mInline + count, value);
+      mOverflow.clear();
+    } else {
+      if (mSize <= inlineCapacity) mOverflow.assign(mInline, mInline + mSize);
+      mOverflow.resize(count, value);
+    }
+    mSize = count;
+  }
+
+  // Copy to/from a std::vector<double>
+  std::vector<double> coeffs()                          const { return std::vector<double>(begin(), end()); }
+  void coeffs(const std::vector<double>& x)                   { resize(x.size()); std::copy(x.begin(), x.end(), begin()); }
   
-  bool operator==(const RKCoefficients<Dimension>& rhs) const { return correctionOrder == rhs.correctionOrder and coeffs == rhs.coeffs; }
-  bool operator!=(const RKCoefficients<Dimension>& rhs) const { return correctionOrder != rhs.correctionOrder or  coeffs != rhs.coeffs; }
+  bool operator==(const RKCoefficients<Dimension>& rhs) const { return correctionOrder == rhs.correctionOrder and mSize == rhs.mSize and std::equal(begin(), end(), rhs.begin()); }
+  bool operator!=(const RKCoefficients<Dimension>& rhs) const { return not (*this == rhs); }
   bool operator< (const RKCoefficients<Dimension>& rhs) const { return (correctionOrder < rhs.correctionOrder ? true :
                                                                         correctionOrder > rhs.correctionOrder ? false :
-                                                                        coeffs < rhs.coeffs); }
-  bool operator> (const RKCoefficients<Dimension>& rhs) const { return (correctionOrder > rhs.correctionOrder ? true :
-                                                                        correctionOrder < rhs.correctionOrder ? false :
-                                                                        coeffs > rhs.coeffs); }
+                                                                        std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end())); }
+  bool operator> (const RKCoefficients<Dimension>& rhs) const { return rhs < *this; }
   bool operator<=(const RKCoefficients<Dimension>& rhs) const { return (*this) == rhs or (*this) < rhs; }
   bool operator>=(const RKCoefficients<Dimension>& rhs) const { return (*this) == rhs or (*this) > rhs; }
+
+private:
+  size_type mSize;                                // Number of coefficients
+  alignas(16) double mInline[inlineCapacity];     // Inline storage while mSize <= inlineCapacity
+  std::vector<double> mOverflow;                  // Heap storage for higher order corrections
 };
 
 //------------------------------------------------------------------------------
@@ -224,6 +224,19 @@ evaluateKernelAndGradients(const TableKernel<Dimension>& kernel,
   const auto k = kernel.kernelValue(etaMag, Hdet);
   const auto dk = kernel.gradValue(etaMag, Hdet);
   const auto HetaUnit = H * etaUnit;
+  return evaluateKernelAndGradientsFromBase(x, k, dk, HetaUnit, corrections);
+}
+
+template<typename Dimension, RKOrder correctionOrder>
+std::tuple<typename Dimension::Scalar, typename Dimension::Vector, typename Dimension::Scalar>
+RKUtilities<Dimension, correctionOrder>::
+evaluateKernelAndGradientsFromBase(const Vector& x,
+                                   const Scalar k,
+                                   const Scalar dk,
+                                   const Vector& HetaUnit,
+                                   const RKCoefficients<Dimension>& corrections) {
+  CHECK2((int)corrections.size() == correctionsSize(false) || (int)corrections.size() == correctionsSize(true),
+         corrections.size() << " ! in (" <<  correctionsSize(false) << " " << correctionsSize(true) << ")");
   const auto dw = HetaUnit*dk;
 
   // Get kernel and polynomials
@@ -710,7 +723,7 @@ applyTransformation(const TransformationMatrix& T,
                     RKCoefficients<Dimension>& corrections) {
   auto size = T.cols();
   CHECK(size == (int)corrections.size());
-  Eigen::Map<Eigen::VectorXd, Eigen::AlignmentType::Aligned> V(&corrections[0], size);
+  Eigen::Map<Eigen::VectorXd, Eigen::AlignmentType::Unaligned> V(corrections.data(), size);
   V = T * V;
 }
 
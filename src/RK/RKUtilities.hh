@@ -128,6 +128,15 @@ public:
                                                                        const Vector& x,
                                                                        const SymTensor& H,
                                                                        const RKCoefficients<Dimension>& corrections);
+
+  // Same as evaluateKernelAndGradients, but taking the base kernel value (k),
+  // gradient magnitude (dk), and HetaUnit = H*eta.unitVector() as already
+  // evaluated (e.g., from a block kernel lookup over a NodePairList).
+  static std::tuple<Scalar, Vector, Scalar> evaluateKernelAndGradientsFromBase(const Vector& x,
+                                                                               const Scalar k,
+                                                                               const Scalar dk,
+                                                                               const Vector& HetaUnit,
+                                                                               const RKCoefficients<Dimension>& corrections);
   
   // Compute the corrections
   static void computeCorrections(const ConnectivityMap<Dimension>& connectivityMap,
@@ -53,6 +53,14 @@ public:
                                                                 const SymTensor& H,
                                                                 const RKCoefficients<Dimension>& corrections) const;
 
+  // As evaluateKernelAndGradients, but with the base kernel already evaluated:
+  // W and gW the base kernel value and gradient magnitude, and HetaUnit = H*eta.unitVector().
+  std::tuple<Scalar, Vector, Scalar> evaluateKernelAndGradientsFromBase(const Vector& x,
+                                                                        const Scalar W,
+                                                                        const Scalar gW,
+                                                                        const Vector& HetaUnit,
+                                                                        const RKCoefficients<Dimension>& corrections) const;
+
   // Compute corrections and normals
   void computeCorrections(const ConnectivityMap<Dimension>& connectivityMap,
                           const FieldList<Dimension, Scalar>& volume,
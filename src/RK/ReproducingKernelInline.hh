@@ -113,6 +113,18 @@ evaluateKernelAndGradients(const typename Dimension::Vector& x,
   return (*ReproducingKernelMethods<Dimension>::mEvaluateKernelAndGradients)(*mWptr, x, H, corrections);
 }
 
+template<typename Dimension>
+inline
+std::tuple<typename Dimension::Scalar, typename Dimension::Vector, typename Dimension::Scalar>
+ReproducingKernel<Dimension>::
+evaluateKernelAndGradientsFromBase(const typename Dimension::Vector& x,
+                                   const typename Dimension::Scalar W,
+                                   const typename Dimension::Scalar gW,
+                                   const typename Dimension::Vector& HetaUnit,
+                                   const RKCoefficients<Dimension>& corrections) const {
+  return (*ReproducingKernelMethods<Dimension>::mEvaluateKernelAndGradientsFromBase)(x, W, gW, HetaUnit, corrections);
+}
+
 //------------------------------------------------------------------------------
 // computeCorrections
 //------------------------------------------------------------------------------
@@ -20,6 +20,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::ZerothOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::ZerothOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::ZerothOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::ZerothOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::ZerothOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::ZerothOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::ZerothOrder>::getTransformationMatrix;
@@ -37,6 +38,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::LinearOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::LinearOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::LinearOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::LinearOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::LinearOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::LinearOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::LinearOrder>::getTransformationMatrix;
@@ -54,6 +56,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::QuadraticOrder>::getTransformationMatrix;
@@ -71,6 +74,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::CubicOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::CubicOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::CubicOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::CubicOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::CubicOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::CubicOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::CubicOrder>::getTransformationMatrix;
@@ -88,6 +92,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::QuarticOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::QuarticOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::QuarticOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::QuarticOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::QuarticOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::QuarticOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::QuarticOrder>::getTransformationMatrix;
@@ -105,6 +110,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::QuinticOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::QuinticOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::QuinticOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::QuinticOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::QuinticOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::QuinticOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::QuinticOrder>::getTransformationMatrix;
@@ -122,6 +128,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::SexticOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::SexticOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::SexticOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::SexticOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::SexticOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::SexticOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::SexticOrder>::getTransformationMatrix;
@@ -139,6 +146,7 @@ ReproducingKernelMethods(const RKOrder order):
     mEvaluateHessian = &RKUtilities<Dimension, RKOrder::SepticOrder>::evaluateHessian;
     mEvaluateKernelAndGradient = &RKUtilities<Dimension, RKOrder::SepticOrder>::evaluateKernelAndGradient;
     mEvaluateKernelAndGradients = &RKUtilities<Dimension, RKOrder::SepticOrder>::evaluateKernelAndGradients;
+    mEvaluateKernelAndGradientsFromBase = &RKUtilities<Dimension, RKOrder::SepticOrder>::evaluateKernelAndGradientsFromBase;
     mComputeCorrections = &RKUtilities<Dimension, RKOrder::SepticOrder>::computeCorrections;
     mComputeNormal = &RKUtilities<Dimension, RKOrder::SepticOrder>::computeNormal;
     mGetTransformationMatrix = &RKUtilities<Dimension, RKOrder::SepticOrder>::getTransformationMatrix;
@@ -169,6 +177,7 @@ ReproducingKernelMethods():
   mEvaluateHessian(nullptr),
   mEvaluateKernelAndGradient(nullptr),
   mEvaluateKernelAndGradients(nullptr),
+  mEvaluateKernelAndGradientsFromBase(nullptr),
   mComputeCorrections(nullptr),
   mComputeNormal(nullptr),
   mGetTransformationMatrix(nullptr),
@@ -193,6 +202,7 @@ ReproducingKernelMethods(const ReproducingKernelMethods<Dimension>& rhs):
   mEvaluateHessian(rhs.mEvaluateHessian),
   mEvaluateKernelAndGradient(rhs.mEvaluateKernelAndGradient),
   mEvaluateKernelAndGradients(rhs.mEvaluateKernelAndGradients),
+  mEvaluateKernelAndGradientsFromBase(rhs.mEvaluateKernelAndGradientsFromBase),
   mComputeCorrections(rhs.mComputeCorrections),
   mComputeNormal(rhs.mComputeNormal),
   mGetTransformationMatrix(rhs.mGetTransformationMatrix),
@@ -218,6 +228,7 @@ operator=(const ReproducingKernelMethods<Dimension>& rhs) {
   mEvaluateHessian = rhs.mEvaluateHessian;
   mEvaluateKernelAndGradient = rhs.mEvaluateKernelAndGradient;
   mEvaluateKernelAndGradients = rhs.mEvaluateKernelAndGradients;
+  mEvaluateKernelAndGradientsFromBase = rhs.mEvaluateKernelAndGradientsFromBase;
   mComputeCorrections = rhs.mComputeCorrections;
   mComputeNormal = rhs.mComputeNormal;
   mGetTransformationMatrix = rhs.mGetTransformationMatrix;
@@ -57,6 +57,7 @@ protected:
   SymTensor                          (*mEvaluateHessian)(const TableKernel<Dimension>&, const Vector&, const SymTensor&, const RKCoefficients<Dimension>&);
   std::pair<Scalar, Vector>          (*mEvaluateKernelAndGradient)(const TableKernel<Dimension>&, const Vector&, const SymTensor&, const RKCoefficients<Dimension>&);
   std::tuple<Scalar, Vector, Scalar> (*mEvaluateKernelAndGradients)(const TableKernel<Dimension>&, const Vector&, const SymTensor&, const RKCoefficients<Dimension>&);
+  std::tuple<Scalar, Vector, Scalar> (*mEvaluateKernelAndGradientsFromBase)(const Vector&, const Scalar, const Scalar, const Vector&, const RKCoefficients<Dimension>&);
 
   void (*mComputeCorrections)(const ConnectivityMap<Dimension>&,
                               const TableKernel<Dimension>&,
@@ -130,6 +130,14 @@ ClippingType<Dim<2>> {
     return PolyClipper::polygon2string(celli);
   }
 
+  // Check if any vertex was clipped by a faceted boundary or void plane (negative plane IDs)
+  static bool surfaceClipped(const PolyVolume& celli) {
+    for (const auto& v: celli) {
+      if ((not v.clips.empty()) and *v.clips.begin() < 0) return true;
+    }
+    return false;
+  }
+
 };
 
 //..............................................................................
@@ -142,7 +150,7 @@ ClippingType<Dim<3>> {
   typedef Dim<3>::SymTensor SymTensor;
   typedef Dim<3>::FacetedVolume FacetedVolume;
   typedef PolyClipper::Plane3d Plane;
-  typedef PolyClipper::Polyhedron PolyVolume;
+  typedef PolyClipper::ArenaPolyhedron PolyVolume;
   
   // Build an approximation of the starting kernel shape (in eta space) as an icosahedron with vertices
   static PolyVolume unitPolyVolume() {
@@ -190,7 +198,9 @@ ClippingType<Dim<3>> {
     PolyClipper::Polyhedron cell0;
     PolyClipper::convertToPolyhedron(cell0, FacetedVolume(vertsIco, facesIco));
     ENSURE(cell0.size() == 12);
-    return cell0;
+    PolyVolume result;
+    PolyClipper::convertToArenaPolyhedron(result, cell0);
+    return result;
   }
 
   // clipping operation
@@ -208,7 +218,7 @@ ClippingType<Dim<3>> {
     PolyClipper::collapseDegenerates(cell, tol);
   }
 
-  // Convert PolyClipper::Polyhedron -> Spheral::Polyhedron
+  // Convert PolyClipper::ArenaPolyhedron -> Spheral::Polyhedron
   static std::vector<std::set<int>> convertFromPolyVolume(FacetedVolume& spheralcell, const PolyVolume& polycell) {
     return PolyClipper::convertFromPolyhedron(spheralcell, polycell);
   }
@@ -236,6 +246,14 @@ ClippingType<Dim<3>> {
     return PolyClipper::polyhedron2string(celli);
   }
 
+  // Check if any vertex was clipped by a faceted boundary or void plane (negative plane IDs)
+  static bool surfaceClipped(const PolyVolume& celli) {
+    for (const auto& v: celli) {
+      if (v.numClips > 0 and celli.clips[v.clipOffset] < 0) return true;
+    }
+    return false;
+  }
+
 };
 
 //------------------------------------------------------------------------------
@@ -400,12 +418,14 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
     auto cell0 = ClippingType<Dimension>::unitPolyVolume();
 
     // We'll need to hang onto the PolyClipper cells and any per cell void points.
-    FieldList<Dimension, PolyVolume> polycells(FieldStorageType::CopyFields);
+    // The cells are only needed on the internal nodes, so we keep them in
+    // plain per NodeList arrays.
+    vector<vector<PolyVolume>> polycells(numNodeLists);
     FieldList<Dimension, vector<Plane>> pairPlanes(FieldStorageType::CopyFields);
     FieldList<Dimension, vector<Plane>> voidPlanes(FieldStorageType::CopyFields);
     FieldList<Dimension, int> cumNumVoidPoints(FieldStorageType::CopyFields);
     for (auto nodeListi = 0u; nodeListi != numNodeLists; ++nodeListi) {
-      polycells.appendNewField("polycells", vol[nodeListi]->nodeList(), cell0);
+      polycells[nodeListi].assign(vol[nodeListi]->numInternalElements(), cell0);
       pairPlanes.appendNewField("pair planes", vol[nodeListi]->nodeList(), vector<Plane>());
       voidPlanes.appendNewField("void planes", vol[nodeListi]->nodeList(), vector<Plane>());
       cumNumVoidPoints.appendNewField("cumulative num void points", vol[nodeListi]->nodeList(), 0);
@@ -432,7 +452,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
           const auto  Hinv = Hi.Inverse();
 #pragma omp critical (computeVoronoiVolume_polycells)
           {
-            for (auto& v: polycells(nodeListi, i)) v.position = 1.1*rin*Hinv*v.position;
+            for (auto& v: polycells[nodeListi][i]) v.position = 1.1*rin*Hinv*v.position;
           }
 
           // Clip by any faceted boundaries first.
@@ -488,7 +508,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
             // Clip by the planes thus far.
 #pragma omp critical (computeVoronoiVolume_polycells)
             {
-              ClippingType<Dimension>::clip(polycells(nodeListi, i), boundPlanes);
+              ClippingType<Dimension>::clip(polycells[nodeListi][i], boundPlanes);
             }
           }
         }
@@ -563,7 +583,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
           auto        pairPlanesi = pairPlanes(nodeListi, i);  // Deliberately make a copy
 // #pragma omp critical (computeVornoiVolume_polycells)
           {
-            celli = polycells(nodeListi, i);         // Also make a copy the starting global cell for this point
+            celli = polycells[nodeListi][i];         // Also make a copy the starting global cell for this point
           }
           CHECK(not celli.empty());
 
@@ -610,7 +630,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
           // Store the clipped cell thus far
 // #pragma omp critical (computeVornoiVolume_polycells)
           {
-            polycells(nodeListi, i) = celli;
+            polycells[nodeListi][i] = celli;
           }
 
         }   // end over i OMP parallel for
@@ -721,7 +741,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
           PolyVolume celli;
 #pragma omp critical (computeVoronoiVolume_polycells)
           {
-            celli = polycells(nodeListi, i);         // Deliberate copy for thread safety
+            celli = polycells[nodeListi][i];         // Deliberate copy for thread safety
           }
           CHECK(not celli.empty());
 
@@ -763,13 +783,7 @@ computeVoronoiVolume(const FieldList<Dimension, typename Dimension::Vector>& pos
           }
 
           // Check if this is a surface point (clipped by faceted boundary or void point).
-          bool interior = true;
-          for (const auto& v: celli) {
-            if ((not v.clips.empty()) and *v.clips.begin() < 0) {
-              interior = false;
-              break;
-            }
-          }
+          const bool interior = not ClippingType<Dimension>::surfaceClipped(celli);
 
           // We only use the volume result if interior.
           if (interior) {
@@ -370,206 +370,211 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
     auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& ri = position(nodeListi, i);
-      const auto& mi = mass(nodeListi, i);
-      const auto& vi = velocity(nodeListi, i);
-      const auto& rhoi = massDensity(nodeListi, i);
-      const auto& epsi = specificThermalEnergy(nodeListi, i);
-      const auto& Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto& ci = soundSpeed(nodeListi, i);
-      const auto& gammai = gamma(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      CHECK(mi > 0.0);
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-
-      auto& rhoSumi = rhoSum_thread(nodeListi, i);
-      auto& normi = normalization_thread(nodeListi, i);
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& Mi = M_thread(nodeListi, i);
-      auto& localMi = localM_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto& rj = position(nodeListj, j);
-      const auto& mj = mass(nodeListj, j);
-      const auto& vj = velocity(nodeListj, j);
-      const auto& rhoj = massDensity(nodeListj, j);
-      const auto& epsj = specificThermalEnergy(nodeListj, j);
-      const auto& Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto& cj = soundSpeed(nodeListj, j);
-      const auto& gammaj = gamma(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-
-      auto& rhoSumj = rhoSum_thread(nodeListj, j);
-      auto& normj = normalization_thread(nodeListj, j);
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& Mj = M_thread(nodeListj, j);
-      auto& localMj = localM_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Flag if this is a contiguous material pair or not.
-      const bool sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
-
-      // Node displacement.
-      const auto rij = ri - rj;
-      const auto etai = Hi*rij;
-      const auto etaj = Hj*rij;
-      const auto etaMagi = etai.magnitude();
-      const auto etaMagj = etaj.magnitude();
-      CHECK(etaMagi >= 0.0);
-      CHECK(etaMagj >= 0.0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
-      std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
-      const auto Hetai = Hi*etai.unitVector();
-      const auto gradWi = gWi*Hetai;
-      const auto gradWQi = gWQi*Hetai;
-
-      std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
-      std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
-      const auto Hetaj = Hj*etaj.unitVector();
-      const auto gradWj = gWj*Hetaj;
-      const auto gradWQj = gWQj*Hetaj;
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = sameMatij ? 1.0 : mj*rhoi/(mi*rhoj);
-      const auto rij2 = rij.magnitude2();
-      const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
-
-
-      // Contribution to the sum density.
-      if (nodeListi == nodeListj) {
-        rhoSumi += mj*Wj;
-        rhoSumj += mi*Wi;
-        normi += mi/rhoi*Wj;
-        normj += mj/rhoj*Wi;
-      }
-
-      // Compute the pair-wise artificial viscosity.
-      const auto vij = vi - vj;
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      ri, etai, vi, rhoi, ci, Hi,
-                                      rj, etaj, vj, rhoj, cj, Hj);
-      const auto Qacci = 0.5*(QPiij*gradWQi);
-      const auto Qaccj = 0.5*(QPiji*gradWQj);
-      // const auto workQi = 0.5*(QPiij*vij).dot(gradWQi);
-      // const auto workQj = 0.5*(QPiji*vij).dot(gradWQj);
-      const auto workQi = vij.dot(Qacci);
-      const auto workQj = vij.dot(Qaccj);
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, Qi);
-      maxViscousPressurej = max(maxViscousPressurej, Qj);
-      effViscousPressurei += mj*Qi*WQi/rhoj;
-      effViscousPressurej += mi*Qj*WQj/rhoi;
-      viscousWorki += mj*workQi;
-      viscousWorkj += mi*workQj;
-
-      // Acceleration.
-      CHECK(rhoi > 0.0);
-      CHECK(rhoj > 0.0);
-      const auto& Fcorri=PSPHcorrection(nodeListi, i);
-      const auto& Fcorrj=PSPHcorrection(nodeListj, j);
-      const auto  Fij=1.0-Fcorri*safeInv(mj*epsj, tiny);
-      const auto  Fji=1.0-Fcorrj*safeInv(mi*epsi, tiny);
-      const auto  engCoef=(gammai-1)*(gammaj-1)*epsi*epsj;
-      const auto  deltaDvDt = engCoef*(gradWi*Fij*safeInv(Pi, tiny) + gradWj*Fji*safeInv(Pj, tiny)) + Qacci + Qaccj;
-      DvDti -= mj*deltaDvDt;
-      DvDtj += mi*deltaDvDt;
-      if (compatibleEnergy) pairAccelerations[kk] = -mj*deltaDvDt;  // Acceleration for i (j anti-symmetric)
-
-      // Specific thermal energy evolution.
-      DepsDti += mj*(engCoef*Fij*safeInv(Pi, tiny)*vij.dot(gradWi) + workQi);
-      DepsDtj += mi*(engCoef*Fji*safeInv(Pj, tiny)*vij.dot(gradWj) + workQj);
-
-      //ADD ARITIFICIAL CONDUCTIVITY IN HOPKINS 2014A
-      if (mHopkinsConductivity) {
-        const auto  alph_c = 0.25;//Parameter = 0.25 in Hopkins 2014
-        const auto  Vs = ci+cj-3.0*vij.dot(rij.unitVector());
-        const auto& Qalpha_i = reducingViscosityMultiplierL(nodeListi, i); //Both L and Q corrections are the same for Cullen Viscosity
-        const auto& Qalpha_j = reducingViscosityMultiplierL(nodeListj, j); //Both L and Q corrections are the same for Cullen Viscosity
-        //DepsDti += (Vs > 0.0)*alph_c*mi*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj+1e-30)*(rhoi+rhoj+1e-30));
-        //DepsDtj += (Vs > 0.0)*alph_c*mi*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj+1e-30)*(rhoi+rhoj+1e-30));
-        //DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi).dot(rij.unitVector()))/max((Pi+Pj)*0.5*(rhoi+rhoj),tiny) : 0.0;
-        //DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWj).dot(rij.unitVector()))/max((Pi+Pj)*0.5*(rhoi+rhoj),tiny) : 0.0;
-        DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
-        DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
-        //const Scalar tmpi = (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
-        //const Scalar tmpj = (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
-        //DepsDti += tmpi;
-        //DepsDtj += tmpj;
-        //DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
-        //DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
-        //DepsDti += (Vs > 0.0 && Pi > 1e-4 && Pj > 1e-4) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
-        //DepsDtj += (Vs > 0.0 && Pi > 1e-4 && Pj > 1e-4) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
-      }
-
-      // Velocity gradient.
-      const auto deltaDvDxi = mj*vij.dyad(gradWi);
-      const auto deltaDvDxj = mi*vij.dyad(gradWj);
-      DvDxi -= deltaDvDxi; 
-      DvDxj -= deltaDvDxj;
-      if (sameMatij) {
-        localDvDxi -= deltaDvDxi; 
-        localDvDxj -= deltaDvDxj;
-      }
-
-      // Estimate of delta v (for XSPH).
-      if (XSPH and (sameMatij)) {
-        const auto wXSPHij = 0.5*(mi/rhoi*Wi + mj/rhoj*Wj);
-        XSPHWeightSumi += wXSPHij;
-        XSPHWeightSumj += wXSPHij;
-        XSPHDeltaVi -= wXSPHij*vij;
-        XSPHDeltaVj += wXSPHij*vij;
-      }
-
-      // Linear gradient correction term.
-      Mi -= mj*rij.dyad(gradWi);
-      Mj -= mi*rij.dyad(gradWj);
-      if (sameMatij) {
-        localMi -= mj*rij.dyad(gradWi);
-        localMj -= mi*rij.dyad(gradWj);
-      }
-
-    } // loop over pairs
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& ri = position(nodeListi, i);
+        const auto& mi = mass(nodeListi, i);
+        const auto& vi = velocity(nodeListi, i);
+        const auto& rhoi = massDensity(nodeListi, i);
+        const auto& epsi = specificThermalEnergy(nodeListi, i);
+        const auto& Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto& ci = soundSpeed(nodeListi, i);
+        const auto& gammai = gamma(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        CHECK(mi > 0.0);
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+
+        auto& rhoSumi = rhoSum_thread(nodeListi, i);
+        auto& normi = normalization_thread(nodeListi, i);
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& Mi = M_thread(nodeListi, i);
+        auto& localMi = localM_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto& rj = position(nodeListj, j);
+        const auto& mj = mass(nodeListj, j);
+        const auto& vj = velocity(nodeListj, j);
+        const auto& rhoj = massDensity(nodeListj, j);
+        const auto& epsj = specificThermalEnergy(nodeListj, j);
+        const auto& Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto& cj = soundSpeed(nodeListj, j);
+        const auto& gammaj = gamma(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+
+        auto& rhoSumj = rhoSum_thread(nodeListj, j);
+        auto& normj = normalization_thread(nodeListj, j);
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& Mj = M_thread(nodeListj, j);
+        auto& localMj = localM_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Flag if this is a contiguous material pair or not.
+        const bool sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
+
+        // Node displacement.
+        const auto rij = ri - rj;
+        const auto etai = Hi*rij;
+        const auto etaj = Hj*rij;
+        const auto etaMagi = etai.magnitude();
+        const auto etaMagj = etaj.magnitude();
+        CHECK(etaMagi >= 0.0);
+        CHECK(etaMagj >= 0.0);
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
+        std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
+        const auto Hetai = Hi*etai.unitVector();
+        const auto gradWi = gWi*Hetai;
+        const auto gradWQi = gWQi*Hetai;
+
+        std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
+        std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
+        const auto Hetaj = Hj*etaj.unitVector();
+        const auto gradWj = gWj*Hetaj;
+        const auto gradWQj = gWQj*Hetaj;
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = sameMatij ? 1.0 : mj*rhoi/(mi*rhoj);
+        const auto rij2 = rij.magnitude2();
+        const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
+
+
+        // Contribution to the sum density.
+        if (nodeListi == nodeListj) {
+          rhoSumi += mj*Wj;
+          rhoSumj += mi*Wi;
+          normi += mi/rhoi*Wj;
+          normj += mj/rhoj*Wi;
+        }
+
+        // Compute the pair-wise artificial viscosity.
+        const auto vij = vi - vj;
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        ri, etai, vi, rhoi, ci, Hi,
+                                        rj, etaj, vj, rhoj, cj, Hj);
+        const auto Qacci = 0.5*(QPiij*gradWQi);
+        const auto Qaccj = 0.5*(QPiji*gradWQj);
+        // const auto workQi = 0.5*(QPiij*vij).dot(gradWQi);
+        // const auto workQj = 0.5*(QPiji*vij).dot(gradWQj);
+        const auto workQi = vij.dot(Qacci);
+        const auto workQj = vij.dot(Qaccj);
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, Qi);
+        maxViscousPressurej = max(maxViscousPressurej, Qj);
+        effViscousPressurei += mj*Qi*WQi/rhoj;
+        effViscousPressurej += mi*Qj*WQj/rhoi;
+        viscousWorki += mj*workQi;
+        viscousWorkj += mi*workQj;
+
+        // Acceleration.
+        CHECK(rhoi > 0.0);
+        CHECK(rhoj > 0.0);
+        const auto& Fcorri=PSPHcorrection(nodeListi, i);
+        const auto& Fcorrj=PSPHcorrection(nodeListj, j);
+        const auto  Fij=1.0-Fcorri*safeInv(mj*epsj, tiny);
+        const auto  Fji=1.0-Fcorrj*safeInv(mi*epsi, tiny);
+        const auto  engCoef=(gammai-1)*(gammaj-1)*epsi*epsj;
+        const auto  deltaDvDt = engCoef*(gradWi*Fij*safeInv(Pi, tiny) + gradWj*Fji*safeInv(Pj, tiny)) + Qacci + Qaccj;
+        DvDti -= mj*deltaDvDt;
+        DvDtj += mi*deltaDvDt;
+        if (compatibleEnergy) pairAccelerations[kk] = -mj*deltaDvDt;  // Acceleration for i (j anti-symmetric)
+
+        // Specific thermal energy evolution.
+        DepsDti += mj*(engCoef*Fij*safeInv(Pi, tiny)*vij.dot(gradWi) + workQi);
+        DepsDtj += mi*(engCoef*Fji*safeInv(Pj, tiny)*vij.dot(gradWj) + workQj);
+
+        //ADD ARITIFICIAL CONDUCTIVITY IN HOPKINS 2014A
+        if (mHopkinsConductivity) {
+          const auto  alph_c = 0.25;//Parameter = 0.25 in Hopkins 2014
+          const auto  Vs = ci+cj-3.0*vij.dot(rij.unitVector());
+          const auto& Qalpha_i = reducingViscosityMultiplierL(nodeListi, i); //Both L and Q corrections are the same for Cullen Viscosity
+          const auto& Qalpha_j = reducingViscosityMultiplierL(nodeListj, j); //Both L and Q corrections are the same for Cullen Viscosity
+          //DepsDti += (Vs > 0.0)*alph_c*mi*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj+1e-30)*(rhoi+rhoj+1e-30));
+          //DepsDtj += (Vs > 0.0)*alph_c*mi*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj+1e-30)*(rhoi+rhoj+1e-30));
+          //DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi).dot(rij.unitVector()))/max((Pi+Pj)*0.5*(rhoi+rhoj),tiny) : 0.0;
+          //DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWj).dot(rij.unitVector()))/max((Pi+Pj)*0.5*(rhoi+rhoj),tiny) : 0.0;
+          DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
+          DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
+          //const Scalar tmpi = (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
+          //const Scalar tmpj = (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
+          //DepsDti += tmpi;
+          //DepsDtj += tmpj;
+          //DepsDti += (Vs > 0.0) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
+          //DepsDtj += (Vs > 0.0) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj)) : 0.0;
+          //DepsDti += (Vs > 0.0 && Pi > 1e-4 && Pj > 1e-4) ? alph_c*mj*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsi-epsj)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
+          //DepsDtj += (Vs > 0.0 && Pi > 1e-4 && Pj > 1e-4) ? alph_c*mi*(Qalpha_i+Qalpha_j)*0.5*Vs*(epsj-epsi)*abs(Pi-Pj)*((gradWi+gradWj).dot(rij.unitVector()))*safeInv((Pi+Pj)*(rhoi+rhoj),tiny) : 0.0;
+        }
+
+        // Velocity gradient.
+        const auto deltaDvDxi = mj*vij.dyad(gradWi);
+        const auto deltaDvDxj = mi*vij.dyad(gradWj);
+        DvDxi -= deltaDvDxi; 
+        DvDxj -= deltaDvDxj;
+        if (sameMatij) {
+          localDvDxi -= deltaDvDxi; 
+          localDvDxj -= deltaDvDxj;
+        }
+
+        // Estimate of delta v (for XSPH).
+        if (XSPH and (sameMatij)) {
+          const auto wXSPHij = 0.5*(mi/rhoi*Wi + mj/rhoj*Wj);
+          XSPHWeightSumi += wXSPHij;
+          XSPHWeightSumj += wXSPHij;
+          XSPHDeltaVi -= wXSPHij*vij;
+          XSPHDeltaVj += wXSPHij*vij;
+        }
+
+        // Linear gradient correction term.
+        Mi -= mj*rij.dyad(gradWi);
+        Mj -= mi*rij.dyad(gradWj);
+        if (sameMatij) {
+          localMi -= mj*rij.dyad(gradWi);
+          localMj -= mi*rij.dyad(gradWj);
+        }
+
+      } // loop over pairs
+    }
 
     // Reduce the thread values to the master.
     threadReduceFieldLists<Dimension>(threadStack);
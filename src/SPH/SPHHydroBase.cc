@@ -8,6 +8,7 @@
 #include "correctSPHSumMassDensity.hh"
 #include "computeSumVoronoiCellMassDensity.hh"
 #include "computeSPHOmegaGradhCorrection.hh"
+#include "computeSPHSumMassDensityAndOmegaGradh.hh"
 #include "NodeList/SmoothingScaleBase.hh"
 #include "Hydro/HydroFieldNames.hh"
 #include "Physics/GenericHydro.hh"
@@ -37,10 +38,13 @@
 #include "Field/NodeIterators.hh"
 #include "Boundary/Boundary.hh"
 #include "Neighbor/ConnectivityMap.hh"
+#include "Neighbor/PairThreadReduction.hh"
 #include "Utilities/timingUtilities.hh"
 #include "Utilities/safeInv.hh"
 #include "Utilities/globalBoundingVolumes.hh"
 #include "Utilities/Timer.hh"
+#include "Utilities/allReduce.hh"
+#include "Distributed/Communicator.hh"
 #include "Mesh/Mesh.hh"
 #include "CRKSPH/volumeSpacing.hh"
 
@@ -56,6 +60,8 @@
 #include <fstream>
 #include <map>
 #include <vector>
+#include <cstring>
+#include <cstdint>
 using std::vector;
 using std::string;
 using std::pair;
@@ -85,6 +91,50 @@ extern Timer TIME_SPHevalDerivs_final;
 
 namespace Spheral {
 
+namespace {
+
+//------------------------------------------------------------------------------
+// A cheap checksum of the internal positions and H tensors, used to tell if
+// the state has changed since the fused sum density/grad h pass.
+//------------------------------------------------------------------------------
+template<typename T>
+inline
+size_t
+mixElementBits(const T& x, const size_t salt) {
+  size_t result = salt*0x9e3779b97f4a7c15ULL;
+  for (auto k = 0u; k < T::numElements; ++k) {
+    const double xk = x[k];
+    uint64_t bits;
+    std::memcpy(&bits, &xk, sizeof(bits));
+    result ^= bits + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+  }
+  result ^= result >> 31;
+  result *= 0xbf58476d1ce4e5b9ULL;
+  result ^= result >> 27;
+  return result;
+}
+
+template<typename Dimension>
+size_t
+positionAndHChecksum(const FieldList<Dimension, typename Dimension::Vector>& position,
+                     const FieldList<Dimension, typename Dimension::SymTensor>& H) {
+  size_t result = 0u, salt = 0u;
+  const auto numNodeLists = position.size();
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto n = position[nodeListi]->numInternalElements();
+    size_t sum = 0u;
+#pragma omp parallel for reduction(^:sum)
+    for (auto i = 0u; i < n; ++i) {
+      sum ^= mixElementBits(position(nodeListi, i), 2u*(salt + i) + 1u) ^ mixElementBits(H(nodeListi, i), 2u*(salt + i) + 2u);
+    }
+    result ^= sum;
+    salt += n;
+  }
+  return result;
+}
+
+}
+
 //------------------------------------------------------------------------------
 // Construct with the given artificial viscosity and kernels.
 //------------------------------------------------------------------------------
@@ -122,6 +172,9 @@ SPHHydroBase(const SmoothingScaleBase<Dimension>& smoothingScaleMethod,
   mXSPH(XSPH),
   mCorrectVelocityGradient(correctVelocityGradient),
   mSumMassDensityOverAllNodeLists(sumMassDensityOverAllNodeLists),
+  mFuseSumDensityGradh(false),
+  mFusedGradhValid(false),
+  mFusedGradhChecksum(0u),
   mfilter(filter),
   mEpsTensile(epsTensile),
   mnTensile(nTensile),
@@ -464,7 +517,15 @@ preStepInitialize(const DataBase<Dimension>& dataBase,
       const auto  mass = state.fields(HydroFieldNames::mass, 0.0);
       const auto  H = state.fields(HydroFieldNames::H, SymTensor::zero);
       auto        massDensity = state.fields(HydroFieldNames::massDensity, 0.0);
-      computeSPHSumMassDensity(connectivityMap, this->kernel(), mSumMassDensityOverAllNodeLists, position, mass, H, massDensity);
+      if (mFuseSumDensityGradh and mGradhCorrection) {
+        auto omega = state.fields(HydroFieldNames::omegaGradh, 0.0);
+        computeSPHSumMassDensityAndOmegaGradh(connectivityMap, this->kernel(), mSumMassDensityOverAllNodeLists, position, mass, H, massDensity, omega, this->threadReductionMethod());
+        for (auto boundaryItr = this->boundaryBegin(); boundaryItr < this->boundaryEnd(); ++boundaryItr) (*boundaryItr)->applyFieldListGhostBoundary(omega);
+        mFusedGradhChecksum = positionAndHChecksum<Dimension>(position, H);
+        mFusedGradhValid = true;
+      } else {
+        computeSPHSumMassDensity(connectivityMap, this->kernel(), mSumMassDensityOverAllNodeLists, position, mass, H, massDensity);
+      }
       for (auto boundaryItr = this->boundaryBegin(); boundaryItr < this->boundaryEnd(); ++boundaryItr) (*boundaryItr)->applyFieldListGhostBoundary(massDensity);
       for (auto boundaryItr = this->boundaryBegin(); boundaryItr < this->boundaryEnd(); ++boundaryItr) (*boundaryItr)->finalizeGhostBoundary();
       if (densityUpdate() == MassDensityType::CorrectedSumDensity) {
@@ -632,16 +693,29 @@ initialize(const typename Dimension::Scalar time,
   //const TableKernel<Dimension>& W = this->kernel();
   const TableKernel<Dimension>& WPi = this->PiKernel();
 
+  // If we're fusing the sum density and grad h passes, the correction may
+  // already have been computed alongside the sum density in preStepInitialize.
+  // We can reuse it provided the integrator has not moved the points or
+  // changed H since.  The choice must agree across processors since the ghost
+  // boundaries communicate.  Without fusing none of this bookkeeping is done.
   if (mGradhCorrection) {
     const ConnectivityMap<Dimension>& connectivityMap = dataBase.connectivityMap();
     const FieldList<Dimension, Vector> position = state.fields(HydroFieldNames::position, Vector::zero);
     const FieldList<Dimension, SymTensor> H = state.fields(HydroFieldNames::H, SymTensor::zero);
-    FieldList<Dimension, Scalar> omega = state.fields(HydroFieldNames::omegaGradh, 0.0);
-    computeSPHOmegaGradhCorrection(connectivityMap, this->kernel(), position, H, omega);
-    for (ConstBoundaryIterator boundItr = this->boundaryBegin();
-         boundItr != this->boundaryEnd();
-         ++boundItr) (*boundItr)->applyFieldListGhostBoundary(omega);
+    auto reuseFused = 0;
+    if (mFuseSumDensityGradh) {
+      reuseFused = allReduce((mFusedGradhValid and positionAndHChecksum<Dimension>(position, H) == mFusedGradhChecksum) ? 1 : 0,
+                             MPI_MIN, Communicator::communicator());
+    }
+    if (reuseFused == 0) {
+      FieldList<Dimension, Scalar> omega = state.fields(HydroFieldNames::omegaGradh, 0.0);
+      computeSPHOmegaGradhCorrection(connectivityMap, this->kernel(), position, H, omega);
+      for (ConstBoundaryIterator boundItr = this->boundaryBegin();
+           boundItr != this->boundaryEnd();
+           ++boundItr) (*boundItr)->applyFieldListGhostBoundary(omega);
+    }
   }
+  mFusedGradhValid = false;
 
   // Get the artificial viscosity and initialize it.
   ArtificialViscosity<Dimension>& Q = this->artificialViscosity();
@@ -95,6 +95,9 @@ public:
                            const State<Dimension>& state,
                            StateDerivatives<Dimension>& derivatives) const override;
 
+  // Our pair loops evaluate the interior pairs before those touching ghosts.
+  virtual bool overlapGhostExchange() const override { return true; }
+
   // Finalize the derivatives.
   virtual
   void finalizeDerivatives(const Scalar time,
@@ -153,6 +156,11 @@ public:
   bool sumMassDensityOverAllNodeLists() const;
   void sumMassDensityOverAllNodeLists(bool val);
 
+  // Flag to compute the grad h correction in the same pass over the node pairs
+  // as the sum density (only applies to RigorousSumDensity/CorrectedSumDensity).
+  bool fuseSumDensityGradh() const;
+  void fuseSumDensityGradh(bool val);
+
   // Fraction of position filtering to apply.
   double filter() const;
   void filter(double val);
@@ -229,6 +237,12 @@ protected:
   HEvolutionType mHEvolution;
   bool mCompatibleEnergyEvolution, mEvolveTotalEnergy, mGradhCorrection, mXSPH, mCorrectVelocityGradient, mSumMassDensityOverAllNodeLists;
 
+  // State for the fused sum density/grad h pass: whether the grad h correction
+  // computed in preStepInitialize is still available, and a checksum of the
+  // positions and H it was computed from.
+  bool mFuseSumDensityGradh, mFusedGradhValid;
+  size_t mFusedGradhChecksum;
+
   // Magnitude of the hourglass/parasitic mode filter.
   double mfilter;
 
@@ -73,6 +73,10 @@ public:
                            const State<Dimension>& state,
                            StateDerivatives<Dimension>& derivatives) const override;
 
+  // We walk the neighbors of each node rather than the NodePairList, so need
+  // the ghost values complete before evaluating the derivatives.
+  virtual bool overlapGhostExchange() const override { return false; }
+
   // This method is called once at the beginning of a timestep, after all state registration.
   virtual void preStepInitialize(const DataBase<Dimension>& dataBase, 
                                  State<Dimension>& state,
@@ -141,6 +141,24 @@ SPHHydroBase<Dimension>::sumMassDensityOverAllNodeLists(bool val) {
   mSumMassDensityOverAllNodeLists = val;
 }
 
+//------------------------------------------------------------------------------
+// Access the flag to fuse the sum density and grad h correction passes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+inline
+bool
+SPHHydroBase<Dimension>::fuseSumDensityGradh() const {
+  return mFuseSumDensityGradh;
+}
+
+template<typename Dimension>
+inline
+void
+SPHHydroBase<Dimension>::fuseSumDensityGradh(bool val) {
+  mFuseSumDensityGradh = val;
+  mFusedGradhValid = false;
+}
+
 //------------------------------------------------------------------------------
 // Fraction of the centroidal filtering to apply.
 //------------------------------------------------------------------------------
@@ -327,189 +327,194 @@ evaluateDerivatives(const Dim<2>::Scalar /*time*/,
     auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& posi = position(nodeListi, i);
-      const auto  ri = abs(posi.y());
-      const auto  circi = 2.0*M_PI*ri;
-      const auto  mi = mass(nodeListi, i);
-      const auto  mRZi = mi/circi;
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto& omegai = omega(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  safeOmegai = safeInv(omegai, tiny);
-      const auto  zetai = abs((Hi*posi).y());
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-
-      auto& rhoSumi = rhoSum_thread(nodeListi, i);
-      auto& normi = normalization_thread(nodeListi, i);
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& Mi = M_thread(nodeListi, i);
-      auto& localMi = localM_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto& posj = position(nodeListj, j);
-      const auto  rj = abs(posj.y());
-      const auto  circj = 2.0*M_PI*rj;
-      const auto  mj = mass(nodeListj, j);
-      const auto  mRZj = mj/circj;
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto& omegaj = omega(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  safeOmegaj = safeInv(omegaj, tiny);
-      const auto  zetaj = abs((Hj*posj).y());
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-
-      auto& rhoSumj = rhoSum_thread(nodeListj, j);
-      auto& normj = normalization_thread(nodeListj, j);
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& Mj = M_thread(nodeListj, j);
-      auto& localMj = localM_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Flag if this is a contiguous material pair or not.
-      const bool sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
-
-      // Node displacement.
-      const auto xij = posi - posj;
-      const auto etai = Hi*xij;
-      const auto etaj = Hj*xij;
-      const auto etaMagi = etai.magnitude();
-      const auto etaMagj = etaj.magnitude();
-      CHECK(etaMagi >= 0.0);
-      CHECK(etaMagj >= 0.0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
-      std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
-      const auto Hetai = Hi*etai.unitVector();
-      const auto gradWi = gWi*Hetai;
-      const auto gradWQi = gWQi*Hetai;
-
-      std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
-      std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
-      const auto Hetaj = Hj*etaj.unitVector();
-      const auto gradWj = gWj*Hetaj;
-      const auto gradWQj = gWQj*Hetaj;
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = sameMatij ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
-      const auto xij2 = xij.magnitude2();
-      const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
-      weightedNeighborSumi +=     fweightij*std::abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
-      massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
-
-      // Contribution to the sum density.
-      if (nodeListi == nodeListj) {
-        rhoSumi += mRZj*Wi;
-        rhoSumj += mRZi*Wj;
-        normi += mRZi/rhoi*Wi;
-        normj += mRZj/rhoj*Wj;
-      }
-
-      // Compute the pair-wise artificial viscosity.
-      const auto vij = vi - vj;
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      posi, etai, vi, rhoi, ci, Hi,
-                                      posj, etaj, vj, rhoj, cj, Hj);
-      const auto Qacci = 0.5*(QPiij*gradWQi);
-      const auto Qaccj = 0.5*(QPiji*gradWQj);
-      // const auto workQi = 0.5*(QPiij*vij).dot(gradWQi);
-      // const auto workQj = 0.5*(QPiji*vij).dot(gradWQj);
-      const auto workQi = vij.dot(Qacci);
-      const auto workQj = vij.dot(Qaccj);
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, Qi);
-      maxViscousPressurej = max(maxViscousPressurej, Qj);
-      effViscousPressurei += mRZj*Qi*WQi/rhoj;
-      effViscousPressurej += mRZi*Qj*WQj/rhoi;
-      viscousWorki += mRZj*workQi;
-      viscousWorkj += mRZi*workQj;
-
-      // Acceleration.
-      CHECK(rhoi > 0.0);
-      CHECK(rhoj > 0.0);
-      const auto Prhoi = safeOmegai*Pi/(rhoi*rhoi);
-      const auto Prhoj = safeOmegaj*Pj/(rhoj*rhoj);
-      const auto deltaDvDt = Prhoi*gradWi + Prhoj*gradWj + Qacci + Qaccj;
-      DvDti -= mRZj*deltaDvDt;
-      DvDtj += mRZi*deltaDvDt;
-      if (mCompatibleEnergyEvolution) {
-        pairAccelerations[2*kk]   = -mRZj*deltaDvDt;
-        pairAccelerations[2*kk+1] =  mRZi*deltaDvDt;
-      }
-
-      // Specific thermal energy evolution.
-      DepsDti += mRZj*(Prhoi*vij.dot(gradWi) + workQi);
-      DepsDtj += mRZi*(Prhoj*vij.dot(gradWj) + workQj);
-
-      // Velocity gradient.
-      const auto deltaDvDxi = mRZj*vij.dyad(gradWi);
-      const auto deltaDvDxj = mRZi*vij.dyad(gradWj);
-      DvDxi -= deltaDvDxi;
-      DvDxj -= deltaDvDxj;
-      if (sameMatij) {
-        localDvDxi -= deltaDvDxi;
-        localDvDxj -= deltaDvDxj;
-      }
-
-      // Estimate of delta v (for XSPH).
-      if (sameMatij or min(zetai, zetaj) < 1.0) {
-        const auto wXSPHij = 0.5*(mRZi/rhoi*Wi + mRZj/rhoj*Wj);
-        XSPHWeightSumi += wXSPHij;
-        XSPHWeightSumj += wXSPHij;
-        XSPHDeltaVi -= wXSPHij*vij;
-        XSPHDeltaVj += wXSPHij*vij;
-      }
-
-      // Linear gradient correction term.
-      Mi -= mRZj*xij.dyad(gradWi);
-      Mj -= mRZi*xij.dyad(gradWj);
-      if (sameMatij) {
-        localMi -= mRZj*xij.dyad(gradWi);
-        localMj -= mRZi*xij.dyad(gradWj);
-      }
-
-    } // loop over pairs
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& posi = position(nodeListi, i);
+        const auto  ri = abs(posi.y());
+        const auto  circi = 2.0*M_PI*ri;
+        const auto  mi = mass(nodeListi, i);
+        const auto  mRZi = mi/circi;
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto& omegai = omega(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  safeOmegai = safeInv(omegai, tiny);
+        const auto  zetai = abs((Hi*posi).y());
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+
+        auto& rhoSumi = rhoSum_thread(nodeListi, i);
+        auto& normi = normalization_thread(nodeListi, i);
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& Mi = M_thread(nodeListi, i);
+        auto& localMi = localM_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto& posj = position(nodeListj, j);
+        const auto  rj = abs(posj.y());
+        const auto  circj = 2.0*M_PI*rj;
+        const auto  mj = mass(nodeListj, j);
+        const auto  mRZj = mj/circj;
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto& omegaj = omega(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  safeOmegaj = safeInv(omegaj, tiny);
+        const auto  zetaj = abs((Hj*posj).y());
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+
+        auto& rhoSumj = rhoSum_thread(nodeListj, j);
+        auto& normj = normalization_thread(nodeListj, j);
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& Mj = M_thread(nodeListj, j);
+        auto& localMj = localM_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Flag if this is a contiguous material pair or not.
+        const bool sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
+
+        // Node displacement.
+        const auto xij = posi - posj;
+        const auto etai = Hi*xij;
+        const auto etaj = Hj*xij;
+        const auto etaMagi = etai.magnitude();
+        const auto etaMagj = etaj.magnitude();
+        CHECK(etaMagi >= 0.0);
+        CHECK(etaMagj >= 0.0);
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
+        std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
+        const auto Hetai = Hi*etai.unitVector();
+        const auto gradWi = gWi*Hetai;
+        const auto gradWQi = gWQi*Hetai;
+
+        std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
+        std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
+        const auto Hetaj = Hj*etaj.unitVector();
+        const auto gradWj = gWj*Hetaj;
+        const auto gradWQj = gWQj*Hetaj;
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = sameMatij ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
+        const auto xij2 = xij.magnitude2();
+        const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
+        weightedNeighborSumi +=     fweightij*std::abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*std::abs(gWj);
+        massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
+
+        // Contribution to the sum density.
+        if (nodeListi == nodeListj) {
+          rhoSumi += mRZj*Wi;
+          rhoSumj += mRZi*Wj;
+          normi += mRZi/rhoi*Wi;
+          normj += mRZj/rhoj*Wj;
+        }
+
+        // Compute the pair-wise artificial viscosity.
+        const auto vij = vi - vj;
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        posi, etai, vi, rhoi, ci, Hi,
+                                        posj, etaj, vj, rhoj, cj, Hj);
+        const auto Qacci = 0.5*(QPiij*gradWQi);
+        const auto Qaccj = 0.5*(QPiji*gradWQj);
+        // const auto workQi = 0.5*(QPiij*vij).dot(gradWQi);
+        // const auto workQj = 0.5*(QPiji*vij).dot(gradWQj);
+        const auto workQi = vij.dot(Qacci);
+        const auto workQj = vij.dot(Qaccj);
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, Qi);
+        maxViscousPressurej = max(maxViscousPressurej, Qj);
+        effViscousPressurei += mRZj*Qi*WQi/rhoj;
+        effViscousPressurej += mRZi*Qj*WQj/rhoi;
+        viscousWorki += mRZj*workQi;
+        viscousWorkj += mRZi*workQj;
+
+        // Acceleration.
+        CHECK(rhoi > 0.0);
+        CHECK(rhoj > 0.0);
+        const auto Prhoi = safeOmegai*Pi/(rhoi*rhoi);
+        const auto Prhoj = safeOmegaj*Pj/(rhoj*rhoj);
+        const auto deltaDvDt = Prhoi*gradWi + Prhoj*gradWj + Qacci + Qaccj;
+        DvDti -= mRZj*deltaDvDt;
+        DvDtj += mRZi*deltaDvDt;
+        if (mCompatibleEnergyEvolution) {
+          pairAccelerations[2*kk]   = -mRZj*deltaDvDt;
+          pairAccelerations[2*kk+1] =  mRZi*deltaDvDt;
+        }
+
+        // Specific thermal energy evolution.
+        DepsDti += mRZj*(Prhoi*vij.dot(gradWi) + workQi);
+        DepsDtj += mRZi*(Prhoj*vij.dot(gradWj) + workQj);
+
+        // Velocity gradient.
+        const auto deltaDvDxi = mRZj*vij.dyad(gradWi);
+        const auto deltaDvDxj = mRZi*vij.dyad(gradWj);
+        DvDxi -= deltaDvDxi;
+        DvDxj -= deltaDvDxj;
+        if (sameMatij) {
+          localDvDxi -= deltaDvDxi;
+          localDvDxj -= deltaDvDxj;
+        }
+
+        // Estimate of delta v (for XSPH).
+        if (sameMatij or min(zetai, zetaj) < 1.0) {
+          const auto wXSPHij = 0.5*(mRZi/rhoi*Wi + mRZj/rhoj*Wj);
+          XSPHWeightSumi += wXSPHij;
+          XSPHWeightSumj += wXSPHij;
+          XSPHDeltaVi -= wXSPHij*vij;
+          XSPHDeltaVj += wXSPHij*vij;
+        }
+
+        // Linear gradient correction term.
+        Mi -= mRZj*xij.dyad(gradWi);
+        Mj -= mRZi*xij.dyad(gradWj);
+        if (sameMatij) {
+          localMi -= mRZj*xij.dyad(gradWi);
+          localMj -= mRZi*xij.dyad(gradWj);
+        }
+
+      } // loop over pairs
+    }
 
     // Reduce the thread values to the master.
     threadReduceFieldLists<Dimension>(threadStack);
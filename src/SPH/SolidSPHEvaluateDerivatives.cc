@@ -114,6 +114,18 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   const auto& pairs = connectivityMap.nodePairList();
   const auto  npairs = pairs.size();
 
+  // The per-pair geometry and kernel values, if they're being cached for
+  // sharing between the packages.
+  auto& pairGeometry = connectivityMap.pairGeometry();
+  const auto cachedGeometry = pairGeometry.caching();
+  const typename NodePairGeometry<Dimension>::KernelValues *Wvalues = nullptr, *WQvalues = nullptr, *WGvalues = nullptr;
+  if (cachedGeometry) {
+    pairGeometry.update(pairs, connectivityMap.nodePairGeneration(), position, H);
+    Wvalues = &pairGeometry.kernelValues(W);
+    WQvalues = &pairGeometry.kernelValues(WQ);
+    WGvalues = &pairGeometry.kernelValues(WG);
+  }
+
   // Size up the pair-wise accelerations before we start.
   if (compatibleEnergy) pairAccelerations.resize(npairs);
 
@@ -126,256 +138,279 @@ evaluateDerivatives(const typename Dimension::Scalar /*time*/,
   DamagedNodeCouplingWithFrags<Dimension> coupling(damage, gradDamage, H, fragIDs);
 
   // Walk all the interacting pairs.
+  PairThreadReduction<Dimension> threadReduction(connectivityMap, this->threadReductionMethod());
 #pragma omp parallel
   {
     // Thread private  scratch variables.
     int i, j, nodeListi, nodeListj;
-    Scalar Wi, gWi, WQi, gWQi, Wj, gWj, WQj, gWQj;
+    Scalar Wi, gWi, WQi, gWQi, gWGi, Wj, gWj, WQj, gWQj, gWGj;
+    Vector rij, etai, etaj, Hetai, Hetaj;
     Tensor QPiij, QPiji;
     SymTensor sigmai, sigmaj;
 
-    typename SpheralThreads<Dimension>::FieldListStack threadStack;
-    auto rhoSum_thread = rhoSum.threadCopy(threadStack);
-    auto DvDt_thread = DvDt.threadCopy(threadStack);
-    auto DepsDt_thread = DepsDt.threadCopy(threadStack);
-    auto DvDx_thread = DvDx.threadCopy(threadStack);
-    auto localDvDx_thread = localDvDx.threadCopy(threadStack);
-    auto M_thread = M.threadCopy(threadStack);
-    auto localM_thread = localM.threadCopy(threadStack);
-    auto maxViscousPressure_thread = maxViscousPressure.threadCopy(threadStack, ThreadReduction::MAX);
-    auto effViscousPressure_thread = effViscousPressure.threadCopy(threadStack);
-    auto rhoSumCorrection_thread = rhoSumCorrection.threadCopy(threadStack);
-    auto viscousWork_thread = viscousWork.threadCopy(threadStack);
-    auto XSPHWeightSum_thread = XSPHWeightSum.threadCopy(threadStack);
-    auto XSPHDeltaV_thread = XSPHDeltaV.threadCopy(threadStack);
-    auto weightedNeighborSum_thread = weightedNeighborSum.threadCopy(threadStack);
-    auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
-    auto DSDt_thread = DSDt.threadCopy(threadStack);
-
-#pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& ri = position(nodeListi, i);
-      const auto  mi = mass(nodeListi, i);
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto  omegai = omega(nodeListi, i);
-      const auto& Si = S(nodeListi, i);
-      //const auto  mui = mu(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  safeOmegai = safeInv(omegai, tiny);
-      //const auto  fragIDi = fragIDs(nodeListi, i);
-      const auto  pTypei = pTypes(nodeListi, i);
-      CHECK(mi > 0.0);
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-
-      auto& rhoSumi = rhoSum_thread(nodeListi, i);
-      auto& DvDti = DvDt_thread(nodeListi, i);
-      auto& DepsDti = DepsDt_thread(nodeListi, i);
-      auto& DvDxi = DvDx_thread(nodeListi, i);
-      auto& localDvDxi = localDvDx_thread(nodeListi, i);
-      auto& Mi = M_thread(nodeListi, i);
-      auto& localMi = localM_thread(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
-      auto& rhoSumCorrectioni = rhoSumCorrection_thread(nodeListi, i);
-      auto& viscousWorki = viscousWork_thread(nodeListi, i);
-      auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
-
-      // Get the state for node j
-      const auto rj = position(nodeListj, j);
-      const auto mj = mass(nodeListj, j);
-      const auto vj = velocity(nodeListj, j);
-      const auto rhoj = massDensity(nodeListj, j);
-      //const auto epsj = specificThermalEnergy(nodeListj, j);
-      const auto Pj = pressure(nodeListj, j);
-      const auto Hj = H(nodeListj, j);
-      const auto cj = soundSpeed(nodeListj, j);
-      const auto omegaj = omega(nodeListj, j);
-      const auto Sj = S(nodeListj, j);
-      const auto Hdetj = Hj.Determinant();
-      const auto safeOmegaj = safeInv(omegaj, tiny);
-      //const auto fragIDj = fragIDs(nodeListj, j);
-      const auto pTypej = pTypes(nodeListj, j);
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-
-      auto& rhoSumj = rhoSum_thread(nodeListj, j);
-      auto& DvDtj = DvDt_thread(nodeListj, j);
-      auto& DepsDtj = DepsDt_thread(nodeListj, j);
-      auto& DvDxj = DvDx_thread(nodeListj, j);
-      auto& localDvDxj = localDvDx_thread(nodeListj, j);
-      auto& Mj = M_thread(nodeListj, j);
-      auto& localMj = localM_thread(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
-      auto& rhoSumCorrectionj = rhoSumCorrection_thread(nodeListj, j);
-      auto& viscousWorkj = viscousWork_thread(nodeListj, j);
-      auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
-
-      // Flag if this is a contiguous material pair or not.
-      const auto sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
-
-      // Flag if at least one particle is free (0).
-      const auto freeParticle = (pTypei == 0 or pTypej == 0);
-
-      // Node displacement.
-      const auto rij = ri - rj;
-      const auto etai = Hi*rij;
-      const auto etaj = Hj*rij;
-      const auto etaMagi = etai.magnitude();
-      const auto etaMagj = etaj.magnitude();
-      CHECK(etaMagi >= 0.0);
-      CHECK(etaMagj >= 0.0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
-      std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
-      const auto Hetai = Hi*etai.unitVector();
-      const auto gradWi = gWi*Hetai;
-      const auto gradWQi = gWQi*Hetai;
-      const auto gradWGi = WG.gradValue(etaMagi, Hdeti) * Hetai;
-
-      std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
-      std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
-      const auto Hetaj = Hj*etaj.unitVector();
-      const auto gradWj = gWj*Hetaj;
-      const auto gradWQj = gWQj*Hetaj;
-      const auto gradWGj = WG.gradValue(etaMagj, Hdetj) * Hetaj;
-
-      // Determine how we're applying damage.
-      const auto fDeffij = coupling(nodeListi, i, nodeListj, j);
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = sameMatij ? 1.0 : mj*rhoi/(mi*rhoj);
-      const auto rij2 = rij.magnitude2();
-      const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
-      weightedNeighborSumi +=     fweightij*abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*abs(gWj);
-      massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
-
-      // Contribution to the sum density (only if the same material).
-      if (nodeListi == nodeListj) {
-        rhoSumi += mj*Wi;
-        rhoSumj += mi*Wj;
-      }
-
-      // Contribution to the sum density correction
-      rhoSumCorrectioni += mj * WQi / rhoj ;
-      rhoSumCorrectionj += mi * WQj / rhoi ;
-
-      // Compute the pair-wise artificial viscosity.
-      const auto vij = vi - vj;
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      ri, etai, vi, rhoi, ci, Hi,
-                                      rj, etaj, vj, rhoj, cj, Hj);
-      const auto Qacci = 0.5*(QPiij*gradWQi);
-      const auto Qaccj = 0.5*(QPiji*gradWQj);
-      const auto workQi = vij.dot(Qacci);
-      const auto workQj = vij.dot(Qaccj);
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, Qi);
-      maxViscousPressurej = max(maxViscousPressurej, Qj);
-      effViscousPressurei += mj*Qi*WQi/rhoj;
-      effViscousPressurej += mi*Qj*WQj/rhoi;
-      viscousWorki += mj*workQi;
-      viscousWorkj += mi*workQj;
-
-      // Damage scaling of negative pressures.
-      const auto Peffi = (mNegativePressureInDamage or Pi > 0.0 ? Pi : fDeffij*Pi);
-      const auto Peffj = (mNegativePressureInDamage or Pj > 0.0 ? Pj : fDeffij*Pj);
-
-      // Compute the stress tensors.
-      sigmai = -Peffi*SymTensor::one;
-      sigmaj = -Peffj*SymTensor::one;
-      if (sameMatij) {
-        if (mStrengthInDamage) {
-          sigmai += Si;
-          sigmaj += Sj;
+    // Thread-local accumulation windows.
+    FieldListThreadWindow<Dimension, Scalar> rhoSum_thread(rhoSum, threadReduction);
+    FieldListThreadWindow<Dimension, Vector> DvDt_thread(DvDt, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> DepsDt_thread(DepsDt, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> DvDx_thread(DvDx, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> localDvDx_thread(localDvDx, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> M_thread(M, threadReduction);
+    FieldListThreadWindow<Dimension, Tensor> localM_thread(localM, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> maxViscousPressure_thread(maxViscousPressure, threadReduction, ThreadReduction::MAX);
+    FieldListThreadWindow<Dimension, Scalar> effViscousPressure_thread(effViscousPressure, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> rhoSumCorrection_thread(rhoSumCorrection, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> viscousWork_thread(viscousWork, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> XSPHWeightSum_thread(XSPHWeightSum, threadReduction);
+    FieldListThreadWindow<Dimension, Vector> XSPHDeltaV_thread(XSPHDeltaV, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> weightedNeighborSum_thread(weightedNeighborSum, threadReduction);
+    FieldListThreadWindow<Dimension, SymTensor> massSecondMoment_thread(massSecondMoment, threadReduction);
+    FieldListThreadWindow<Dimension, SymTensor> DSDt_thread(DSDt, threadReduction);
+
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = threadReduction.pairRange(ghostPairs);
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& ri = position(nodeListi, i);
+        const auto  mi = mass(nodeListi, i);
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto  omegai = omega(nodeListi, i);
+        const auto& Si = S(nodeListi, i);
+        //const auto  mui = mu(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  safeOmegai = safeInv(omegai, tiny);
+        //const auto  fragIDi = fragIDs(nodeListi, i);
+        const auto  pTypei = pTypes(nodeListi, i);
+        CHECK(mi > 0.0);
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+
+        auto& rhoSumi = rhoSum_thread(nodeListi, i);
+        auto& DvDti = DvDt_thread(nodeListi, i);
+        auto& DepsDti = DepsDt_thread(nodeListi, i);
+        auto& DvDxi = DvDx_thread(nodeListi, i);
+        auto& localDvDxi = localDvDx_thread(nodeListi, i);
+        auto& Mi = M_thread(nodeListi, i);
+        auto& localMi = localM_thread(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure_thread(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure_thread(nodeListi, i);
+        auto& rhoSumCorrectioni = rhoSumCorrection_thread(nodeListi, i);
+        auto& viscousWorki = viscousWork_thread(nodeListi, i);
+        auto& XSPHWeightSumi = XSPHWeightSum_thread(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV_thread(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum_thread(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment_thread(nodeListi, i);
+
+        // Get the state for node j
+        const auto rj = position(nodeListj, j);
+        const auto mj = mass(nodeListj, j);
+        const auto vj = velocity(nodeListj, j);
+        const auto rhoj = massDensity(nodeListj, j);
+        //const auto epsj = specificThermalEnergy(nodeListj, j);
+        const auto Pj = pressure(nodeListj, j);
+        const auto Hj = H(nodeListj, j);
+        const auto cj = soundSpeed(nodeListj, j);
+        const auto omegaj = omega(nodeListj, j);
+        const auto Sj = S(nodeListj, j);
+        const auto Hdetj = Hj.Determinant();
+        const auto safeOmegaj = safeInv(omegaj, tiny);
+        //const auto fragIDj = fragIDs(nodeListj, j);
+        const auto pTypej = pTypes(nodeListj, j);
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+
+        auto& rhoSumj = rhoSum_thread(nodeListj, j);
+        auto& DvDtj = DvDt_thread(nodeListj, j);
+        auto& DepsDtj = DepsDt_thread(nodeListj, j);
+        auto& DvDxj = DvDx_thread(nodeListj, j);
+        auto& localDvDxj = localDvDx_thread(nodeListj, j);
+        auto& Mj = M_thread(nodeListj, j);
+        auto& localMj = localM_thread(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure_thread(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure_thread(nodeListj, j);
+        auto& rhoSumCorrectionj = rhoSumCorrection_thread(nodeListj, j);
+        auto& viscousWorkj = viscousWork_thread(nodeListj, j);
+        auto& XSPHWeightSumj = XSPHWeightSum_thread(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV_thread(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum_thread(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment_thread(nodeListj, j);
+
+        // Flag if this is a contiguous material pair or not.
+        const auto sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
+
+        // Flag if at least one particle is free (0).
+        const auto freeParticle = (pTypei == 0 or pTypej == 0);
+
+        // Node displacement and symmetrized kernel weight and gradient.
+        if (cachedGeometry) {
+          rij = pairGeometry.rij(kk);
+          etai = pairGeometry.etai(kk);
+          etaj = pairGeometry.etaj(kk);
+          Hetai = pairGeometry.Hetai(kk);
+          Hetaj = pairGeometry.Hetaj(kk);
+          Wi = Wvalues->Wi[kk];
+          gWi = Wvalues->gWi[kk];
+          WQi = WQvalues->Wi[kk];
+          gWQi = WQvalues->gWi[kk];
+          gWGi = WGvalues->gWi[kk];
+          Wj = Wvalues->Wj[kk];
+          gWj = Wvalues->gWj[kk];
+          WQj = WQvalues->Wj[kk];
+          gWQj = WQvalues->gWj[kk];
+          gWGj = WGvalues->gWj[kk];
         } else {
-          sigmai += fDeffij*Si;
-          sigmaj += fDeffij*Sj;
+          rij = ri - rj;
+          etai = Hi*rij;
+          etaj = Hj*rij;
+          const auto etaMagi = etai.magnitude();
+          const auto etaMagj = etaj.magnitude();
+          CHECK(etaMagi >= 0.0);
+          CHECK(etaMagj >= 0.0);
+          std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
+          std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
+          gWGi = WG.gradValue(etaMagi, Hdeti);
+          Hetai = Hi*etai.unitVector();
+          std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
+          std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
+          gWGj = WG.gradValue(etaMagj, Hdetj);
+          Hetaj = Hj*etaj.unitVector();
+        }
+        const auto gradWi = gWi*Hetai;
+        const auto gradWQi = gWQi*Hetai;
+        const auto gradWGi = gWGi*Hetai;
+        const auto gradWj = gWj*Hetaj;
+        const auto gradWQj = gWQj*Hetaj;
+        const auto gradWGj = gWGj*Hetaj;
+
+        // Determine how we're applying damage.
+        const auto fDeffij = coupling(nodeListi, i, nodeListj, j);
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = sameMatij ? 1.0 : mj*rhoi/(mi*rhoj);
+        const auto rij2 = rij.magnitude2();
+        const auto thpt = rij.selfdyad()*safeInvVar(rij2*rij2*rij2);
+        weightedNeighborSumi +=     fweightij*abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*abs(gWj);
+        massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
+
+        // Contribution to the sum density (only if the same material).
+        if (nodeListi == nodeListj) {
+          rhoSumi += mj*Wi;
+          rhoSumj += mi*Wj;
         }
-      }
 
-      // Compute the tensile correction to add to the stress as described in 
-      // Gray, Monaghan, & Swift (Comput. Methods Appl. Mech. Eng., 190, 2001)
-      const auto fi = epsTensile*FastMath::pow4(Wi/(Hdeti*WnPerh));
-      const auto fj = epsTensile*FastMath::pow4(Wj/(Hdetj*WnPerh));
-      const auto Ri = fi*tensileStressCorrection(sigmai);
-      const auto Rj = fj*tensileStressCorrection(sigmaj);
-      sigmai += Ri;
-      sigmaj += Rj;
+        // Contribution to the sum density correction
+        rhoSumCorrectioni += mj * WQi / rhoj ;
+        rhoSumCorrectionj += mi * WQj / rhoi ;
+
+        // Compute the pair-wise artificial viscosity.
+        const auto vij = vi - vj;
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        ri, etai, vi, rhoi, ci, Hi,
+                                        rj, etaj, vj, rhoj, cj, Hj);
+        const auto Qacci = 0.5*(QPiij*gradWQi);
+        const auto Qaccj = 0.5*(QPiji*gradWQj);
+        const auto workQi = vij.dot(Qacci);
+        const auto workQj = vij.dot(Qaccj);
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, Qi);
+        maxViscousPressurej = max(maxViscousPressurej, Qj);
+        effViscousPressurei += mj*Qi*WQi/rhoj;
+        effViscousPressurej += mi*Qj*WQj/rhoi;
+        viscousWorki += mj*workQi;
+        viscousWorkj += mi*workQj;
+
+        // Damage scaling of negative pressures.
+        const auto Peffi = (mNegativePressureInDamage or Pi > 0.0 ? Pi : fDeffij*Pi);
+        const auto Peffj = (mNegativePressureInDamage or Pj > 0.0 ? Pj : fDeffij*Pj);
+
+        // Compute the stress tensors.
+        sigmai = -Peffi*SymTensor::one;
+        sigmaj = -Peffj*SymTensor::one;
+        if (sameMatij) {
+          if (mStrengthInDamage) {
+            sigmai += Si;
+            sigmaj += Sj;
+          } else {
+            sigmai += fDeffij*Si;
+            sigmaj += fDeffij*Sj;
+          }
+        }
 
-      // Acceleration.
-      CHECK(rhoi > 0.0);
-      CHECK(rhoj > 0.0);
-      const auto sigmarhoi = safeOmegai*sigmai/(rhoi*rhoi);
-      const auto sigmarhoj = safeOmegaj*sigmaj/(rhoj*rhoj);
-      const auto deltaDvDt = sigmarhoi*gradWi + sigmarhoj*gradWj - Qacci - Qaccj;
-      if (freeParticle) {
-        DvDti += mj*deltaDvDt;
-        DvDtj -= mi*deltaDvDt;
-      }
-      if (compatibleEnergy) pairAccelerations[kk] = mj*deltaDvDt;  // Acceleration for i (j anti-symmetric)
-
-      // Pair-wise portion of grad velocity.
-      const auto deltaDvDxi = vij.dyad(gradWGi);
-      const auto deltaDvDxj = vij.dyad(gradWGj);
-
-      // Specific thermal energy evolution.
-      DepsDti -= mj*(sigmarhoi.doubledot(deltaDvDxi.Symmetric()) - workQi);
-      DepsDtj -= mi*(sigmarhoj.doubledot(deltaDvDxj.Symmetric()) - workQj);
-
-      // Velocity gradient.
-      DvDxi -= mj*deltaDvDxi;
-      DvDxj -= mi*deltaDvDxj;
-      if (sameMatij) {
-        localDvDxi -= mj*deltaDvDxi;
-        localDvDxj -= mi*deltaDvDxj;
-      }
+        // Compute the tensile correction to add to the stress as described in 
+        // Gray, Monaghan, & Swift (Comput. Methods Appl. Mech. Eng., 190, 2001)
+        const auto fi = epsTensile*FastMath::pow4(Wi/(Hdeti*WnPerh));
+        const auto fj = epsTensile*FastMath::pow4(Wj/(Hdetj*WnPerh));
+        const auto Ri = fi*tensileStressCorrection(sigmai);
+        const auto Rj = fj*tensileStressCorrection(sigmaj);
+        sigmai += Ri;
+        sigmaj += Rj;
+
+        // Acceleration.
+        CHECK(rhoi > 0.0);
+        CHECK(rhoj > 0.0);
+        const auto sigmarhoi = safeOmegai*sigmai/(rhoi*rhoi);
+        const auto sigmarhoj = safeOmegaj*sigmaj/(rhoj*rhoj);
+        const auto deltaDvDt = sigmarhoi*gradWi + sigmarhoj*gradWj - Qacci - Qaccj;
+        if (freeParticle) {
+          DvDti += mj*deltaDvDt;
+          DvDtj -= mi*deltaDvDt;
+        }
+        if (compatibleEnergy) pairAccelerations[kk] = mj*deltaDvDt;  // Acceleration for i (j anti-symmetric)
+
+        // Pair-wise portion of grad velocity.
+        const auto deltaDvDxi = vij.dyad(gradWGi);
+        const auto deltaDvDxj = vij.dyad(gradWGj);
+
+        // Specific thermal energy evolution.
+        DepsDti -= mj*(sigmarhoi.doubledot(deltaDvDxi.Symmetric()) - workQi);
+        DepsDtj -= mi*(sigmarhoj.doubledot(deltaDvDxj.Symmetric()) - workQj);
+
+        // Velocity gradient.
+        DvDxi -= mj*deltaDvDxi;
+        DvDxj -= mi*deltaDvDxj;
+        if (sameMatij) {
+          localDvDxi -= mj*deltaDvDxi;
+          localDvDxj -= mi*deltaDvDxj;
+        }
 
-      // Estimate of delta v (for XSPH).
-      if (XSPH and sameMatij) {
-        const auto wXSPHij = 0.5*(mi/rhoi*Wi + mj/rhoj*Wj);
-        XSPHWeightSumi += wXSPHij;
-        XSPHWeightSumj += wXSPHij;
-        XSPHDeltaVi -= wXSPHij*vij;
-        XSPHDeltaVj += wXSPHij*vij;
-      }
+        // Estimate of delta v (for XSPH).
+        if (XSPH and sameMatij) {
+          const auto wXSPHij = 0.5*(mi/rhoi*Wi + mj/rhoj*Wj);
+          XSPHWeightSumi += wXSPHij;
+          XSPHWeightSumj += wXSPHij;
+          XSPHDeltaVi -= wXSPHij*vij;
+          XSPHDeltaVj += wXSPHij*vij;
+        }
 
-      // Linear gradient correction term.
-      Mi -= mj*rij.dyad(gradWGi);
-      Mj -= mi*rij.dyad(gradWGj);
-      if (sameMatij) {
-        localMi -= mj*rij.dyad(gradWGi);
-        localMj -= mi*rij.dyad(gradWGj);
-      }
+        // Linear gradient correction term.
+        Mi -= mj*rij.dyad(gradWGi);
+        Mj -= mi*rij.dyad(gradWGj);
+        if (sameMatij) {
+          localMi -= mj*rij.dyad(gradWGi);
+          localMj -= mi*rij.dyad(gradWGj);
+        }
 
-    } // loop over pairs
+      } // loop over pairs
+    }
 
     // Reduce the thread values to the master.
-    threadReduceFieldLists<Dimension>(threadStack);
+    threadReduction.reduce();
 
   }   // OpenMP parallel region
 
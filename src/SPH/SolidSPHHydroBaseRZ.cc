@@ -386,239 +386,244 @@ evaluateDerivatives(const Dim<2>::Scalar /*time*/,
     auto massSecondMoment_thread = massSecondMoment.threadCopy(threadStack);
     auto DSDt_thread = DSDt.threadCopy(threadStack);
 
+    // Evaluate the interior pairs first, while any ghost exchange is in flight.
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = connectivityMap.nodePairRange(ghostPairs);
 #pragma omp for
-    for (auto kk = 0u; kk < npairs; ++kk) {
-      i = pairs[kk].i_node;
-      j = pairs[kk].j_node;
-      nodeListi = pairs[kk].i_list;
-      nodeListj = pairs[kk].j_list;
-
-      // Get the state for node i.
-      const auto& posi = position(nodeListi, i);
-      const auto  ri = abs(posi.y());
-      const auto  circi = 2.0*M_PI*ri;
-      const auto  mi = mass(nodeListi, i);
-      const auto  mRZi = mi/circi;
-      const auto& vi = velocity(nodeListi, i);
-      const auto  rhoi = massDensity(nodeListi, i);
-      //const auto  epsi = specificThermalEnergy(nodeListi, i);
-      const auto  Pi = pressure(nodeListi, i);
-      const auto& Hi = H(nodeListi, i);
-      const auto  ci = soundSpeed(nodeListi, i);
-      const auto  omegai = omega(nodeListi, i);
-      const auto& Si = S(nodeListi, i);
-      //const auto  mui = mu(nodeListi, i);
-      const auto  Hdeti = Hi.Determinant();
-      const auto  safeOmegai = safeInv(omegai, tiny);
-      //const auto  fragIDi = fragIDs(nodeListi, i);
-      const auto  pTypei = pTypes(nodeListi, i);
-      const auto  zetai = abs((Hi*posi).y());
-      CHECK(mi > 0.0);
-      CHECK(rhoi > 0.0);
-      CHECK(Hdeti > 0.0);
-
-      auto& rhoSumi = rhoSum(nodeListi, i);
-      auto& DvDti = DvDt(nodeListi, i);
-      auto& DepsDti = DepsDt(nodeListi, i);
-      auto& DvDxi = DvDx(nodeListi, i);
-      auto& localDvDxi = localDvDx(nodeListi, i);
-      auto& Mi = M(nodeListi, i);
-      auto& localMi = localM(nodeListi, i);
-      auto& maxViscousPressurei = maxViscousPressure(nodeListi, i);
-      auto& effViscousPressurei = effViscousPressure(nodeListi, i);
-      auto& rhoSumCorrectioni = rhoSumCorrection(nodeListi, i);
-      auto& viscousWorki = viscousWork(nodeListi, i);
-      auto& XSPHWeightSumi = XSPHWeightSum(nodeListi, i);
-      auto& XSPHDeltaVi = XSPHDeltaV(nodeListi, i);
-      auto& weightedNeighborSumi = weightedNeighborSum(nodeListi, i);
-      auto& massSecondMomenti = massSecondMoment(nodeListi, i);
-
-      // Get the state for node j.
-      const auto& posj = position(nodeListj, j);
-      const auto  rj = abs(posj.y());
-      const auto  circj = 2.0*M_PI*rj;
-      const auto  mj = mass(nodeListj, j);
-      const auto  mRZj = mj/circj;
-      const auto& vj = velocity(nodeListj, j);
-      const auto  rhoj = massDensity(nodeListj, j);
-      //const auto  epsj = specificThermalEnergy(nodeListj, j);
-      const auto  Pj = pressure(nodeListj, j);
-      const auto& Hj = H(nodeListj, j);
-      const auto  cj = soundSpeed(nodeListj, j);
-      const auto  omegaj = omega(nodeListj, j);
-      const auto& Sj = S(nodeListj, j);
-      //const auto  muj = mu(nodeListj, j);
-      const auto  Hdetj = Hj.Determinant();
-      const auto  safeOmegaj = safeInv(omegaj, tiny);
-      //const auto  fragIDj = fragIDs(nodeListj, j);
-      const auto  pTypej = pTypes(nodeListj, j);
-      const auto  zetaj = abs((Hj*posj).y());
-      CHECK(mj > 0.0);
-      CHECK(rhoj > 0.0);
-      CHECK(Hdetj > 0.0);
-
-      auto& rhoSumj = rhoSum(nodeListj, j);
-      auto& DvDtj = DvDt(nodeListj, j);
-      auto& DepsDtj = DepsDt(nodeListj, j);
-      auto& DvDxj = DvDx(nodeListj, j);
-      auto& localDvDxj = localDvDx(nodeListj, j);
-      auto& Mj = M(nodeListj, j);
-      auto& localMj = localM(nodeListj, j);
-      auto& maxViscousPressurej = maxViscousPressure(nodeListj, j);
-      auto& effViscousPressurej = effViscousPressure(nodeListj, j);
-      auto& rhoSumCorrectionj = rhoSumCorrection(nodeListj, j);
-      auto& viscousWorkj = viscousWork(nodeListj, j);
-      auto& XSPHWeightSumj = XSPHWeightSum(nodeListj, j);
-      auto& XSPHDeltaVj = XSPHDeltaV(nodeListj, j);
-      auto& weightedNeighborSumj = weightedNeighborSum(nodeListj, j);
-      auto& massSecondMomentj = massSecondMoment(nodeListj, j);
-
-      // Flag if this is a contiguous material pair or not.
-      const auto sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
-
-      // Flag if at least one particle is free (0).
-      const auto freeParticle = (pTypei == 0 or pTypej == 0);
-
-      // Node displacement.
-      const auto xij = posi - posj;
-      const auto etai = Hi*xij;
-      const auto etaj = Hj*xij;
-      const auto etaMagi = etai.magnitude();
-      const auto etaMagj = etaj.magnitude();
-      CHECK(etaMagi >= 0.0);
-      CHECK(etaMagj >= 0.0);
-
-      // Symmetrized kernel weight and gradient.
-      std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
-      std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
-      const auto Hetai = Hi*etai.unitVector();
-      const auto gradWi = gWi*Hetai;
-      const auto gradWQi = gWQi*Hetai;
-      const auto gradWGi = WG.gradValue(etaMagi, Hdeti) * Hetai;
-
-      std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
-      std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
-      const auto Hetaj = Hj*etaj.unitVector();
-      const auto gradWj = gWj*Hetaj;
-      const auto gradWQj = gWQj*Hetaj;
-      const auto gradWGj = WG.gradValue(etaMagj, Hdetj) * Hetaj;
-
-      // Determine how we're applying damage.
-      const auto fDeffij = coupling(nodeListi, i, nodeListj, j);
-
-      // Zero'th and second moment of the node distribution -- used for the
-      // ideal H calculation.
-      const auto fweightij = sameMatij ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
-      const auto xij2 = xij.magnitude2();
-      const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
-      weightedNeighborSumi +=     fweightij*abs(gWi);
-      weightedNeighborSumj += 1.0/fweightij*abs(gWj);
-      massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
-      massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
-
-      // Contribution to the sum density (only if the same material).
-      if (nodeListi == nodeListj) {
-        rhoSumi += mRZj*Wi;
-        rhoSumj += mRZi*Wj;
-      }
-
-      // Contribution to the sum density correction
-      rhoSumCorrectioni += mRZj * WQi / rhoj ;
-      rhoSumCorrectionj += mRZi * WQj / rhoi ;
-
-      // Compute the pair-wise artificial viscosity.
-      const auto vij = vi - vj;
-      std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
-                                      posi, etai, vi, rhoi, ci, Hi,
-                                      posj, etaj, vj, rhoj, cj, Hj);
-      const auto Qacci = 0.5*(QPiij*gradWQi);
-      const auto Qaccj = 0.5*(QPiji*gradWQj);
-      const auto workQi = vij.dot(Qacci);
-      const auto workQj = vij.dot(Qaccj);
-      const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
-      const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
-      maxViscousPressurei = max(maxViscousPressurei, Qi);
-      maxViscousPressurej = max(maxViscousPressurej, Qj);
-      effViscousPressurei += mRZj*Qi*WQi/rhoj;
-      effViscousPressurej += mRZi*Qj*WQj/rhoi;
-      viscousWorki += mRZj*workQi;
-      viscousWorkj += mRZi*workQj;
-
-      // Damage scaling of negative pressures.
-      const auto Peffi = (mNegativePressureInDamage or Pi > 0.0 ? Pi : fDeffij*Pi);
-      const auto Peffj = (mNegativePressureInDamage or Pj > 0.0 ? Pj : fDeffij*Pj);
-
-      // Compute the stress tensors.
-      sigmai = -Peffi*SymTensor::one;
-      sigmaj = -Peffj*SymTensor::one;
-      if (sameMatij) {
-        if (mStrengthInDamage) {
-          sigmai += Si;
-          sigmaj += Sj;
-        } else {
-          sigmai += fDeffij*Si;
-          sigmaj += fDeffij*Sj;
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Get the state for node i.
+        const auto& posi = position(nodeListi, i);
+        const auto  ri = abs(posi.y());
+        const auto  circi = 2.0*M_PI*ri;
+        const auto  mi = mass(nodeListi, i);
+        const auto  mRZi = mi/circi;
+        const auto& vi = velocity(nodeListi, i);
+        const auto  rhoi = massDensity(nodeListi, i);
+        //const auto  epsi = specificThermalEnergy(nodeListi, i);
+        const auto  Pi = pressure(nodeListi, i);
+        const auto& Hi = H(nodeListi, i);
+        const auto  ci = soundSpeed(nodeListi, i);
+        const auto  omegai = omega(nodeListi, i);
+        const auto& Si = S(nodeListi, i);
+        //const auto  mui = mu(nodeListi, i);
+        const auto  Hdeti = Hi.Determinant();
+        const auto  safeOmegai = safeInv(omegai, tiny);
+        //const auto  fragIDi = fragIDs(nodeListi, i);
+        const auto  pTypei = pTypes(nodeListi, i);
+        const auto  zetai = abs((Hi*posi).y());
+        CHECK(mi > 0.0);
+        CHECK(rhoi > 0.0);
+        CHECK(Hdeti > 0.0);
+
+        auto& rhoSumi = rhoSum(nodeListi, i);
+        auto& DvDti = DvDt(nodeListi, i);
+        auto& DepsDti = DepsDt(nodeListi, i);
+        auto& DvDxi = DvDx(nodeListi, i);
+        auto& localDvDxi = localDvDx(nodeListi, i);
+        auto& Mi = M(nodeListi, i);
+        auto& localMi = localM(nodeListi, i);
+        auto& maxViscousPressurei = maxViscousPressure(nodeListi, i);
+        auto& effViscousPressurei = effViscousPressure(nodeListi, i);
+        auto& rhoSumCorrectioni = rhoSumCorrection(nodeListi, i);
+        auto& viscousWorki = viscousWork(nodeListi, i);
+        auto& XSPHWeightSumi = XSPHWeightSum(nodeListi, i);
+        auto& XSPHDeltaVi = XSPHDeltaV(nodeListi, i);
+        auto& weightedNeighborSumi = weightedNeighborSum(nodeListi, i);
+        auto& massSecondMomenti = massSecondMoment(nodeListi, i);
+
+        // Get the state for node j.
+        const auto& posj = position(nodeListj, j);
+        const auto  rj = abs(posj.y());
+        const auto  circj = 2.0*M_PI*rj;
+        const auto  mj = mass(nodeListj, j);
+        const auto  mRZj = mj/circj;
+        const auto& vj = velocity(nodeListj, j);
+        const auto  rhoj = massDensity(nodeListj, j);
+        //const auto  epsj = specificThermalEnergy(nodeListj, j);
+        const auto  Pj = pressure(nodeListj, j);
+        const auto& Hj = H(nodeListj, j);
+        const auto  cj = soundSpeed(nodeListj, j);
+        const auto  omegaj = omega(nodeListj, j);
+        const auto& Sj = S(nodeListj, j);
+        //const auto  muj = mu(nodeListj, j);
+        const auto  Hdetj = Hj.Determinant();
+        const auto  safeOmegaj = safeInv(omegaj, tiny);
+        //const auto  fragIDj = fragIDs(nodeListj, j);
+        const auto  pTypej = pTypes(nodeListj, j);
+        const auto  zetaj = abs((Hj*posj).y());
+        CHECK(mj > 0.0);
+        CHECK(rhoj > 0.0);
+        CHECK(Hdetj > 0.0);
+
+        auto& rhoSumj = rhoSum(nodeListj, j);
+        auto& DvDtj = DvDt(nodeListj, j);
+        auto& DepsDtj = DepsDt(nodeListj, j);
+        auto& DvDxj = DvDx(nodeListj, j);
+        auto& localDvDxj = localDvDx(nodeListj, j);
+        auto& Mj = M(nodeListj, j);
+        auto& localMj = localM(nodeListj, j);
+        auto& maxViscousPressurej = maxViscousPressure(nodeListj, j);
+        auto& effViscousPressurej = effViscousPressure(nodeListj, j);
+        auto& rhoSumCorrectionj = rhoSumCorrection(nodeListj, j);
+        auto& viscousWorkj = viscousWork(nodeListj, j);
+        auto& XSPHWeightSumj = XSPHWeightSum(nodeListj, j);
+        auto& XSPHDeltaVj = XSPHDeltaV(nodeListj, j);
+        auto& weightedNeighborSumj = weightedNeighborSum(nodeListj, j);
+        auto& massSecondMomentj = massSecondMoment(nodeListj, j);
+
+        // Flag if this is a contiguous material pair or not.
+        const auto sameMatij = true; // (nodeListi == nodeListj and fragIDi == fragIDj);
+
+        // Flag if at least one particle is free (0).
+        const auto freeParticle = (pTypei == 0 or pTypej == 0);
+
+        // Node displacement.
+        const auto xij = posi - posj;
+        const auto etai = Hi*xij;
+        const auto etaj = Hj*xij;
+        const auto etaMagi = etai.magnitude();
+        const auto etaMagj = etaj.magnitude();
+        CHECK(etaMagi >= 0.0);
+        CHECK(etaMagj >= 0.0);
+
+        // Symmetrized kernel weight and gradient.
+        std::tie(Wi, gWi) = W.kernelAndGradValue(etaMagi, Hdeti);
+        std::tie(WQi, gWQi) = WQ.kernelAndGradValue(etaMagi, Hdeti);
+        const auto Hetai = Hi*etai.unitVector();
+        const auto gradWi = gWi*Hetai;
+        const auto gradWQi = gWQi*Hetai;
+        const auto gradWGi = WG.gradValue(etaMagi, Hdeti) * Hetai;
+
+        std::tie(Wj, gWj) = W.kernelAndGradValue(etaMagj, Hdetj);
+        std::tie(WQj, gWQj) = WQ.kernelAndGradValue(etaMagj, Hdetj);
+        const auto Hetaj = Hj*etaj.unitVector();
+        const auto gradWj = gWj*Hetaj;
+        const auto gradWQj = gWQj*Hetaj;
+        const auto gradWGj = WG.gradValue(etaMagj, Hdetj) * Hetaj;
+
+        // Determine how we're applying damage.
+        const auto fDeffij = coupling(nodeListi, i, nodeListj, j);
+
+        // Zero'th and second moment of the node distribution -- used for the
+        // ideal H calculation.
+        const auto fweightij = sameMatij ? 1.0 : mRZj*rhoi/(mRZi*rhoj);
+        const auto xij2 = xij.magnitude2();
+        const auto thpt = xij.selfdyad()*safeInvVar(xij2*xij2*xij2);
+        weightedNeighborSumi +=     fweightij*abs(gWi);
+        weightedNeighborSumj += 1.0/fweightij*abs(gWj);
+        massSecondMomenti +=     fweightij*gradWi.magnitude2()*thpt;
+        massSecondMomentj += 1.0/fweightij*gradWj.magnitude2()*thpt;
+
+        // Contribution to the sum density (only if the same material).
+        if (nodeListi == nodeListj) {
+          rhoSumi += mRZj*Wi;
+          rhoSumj += mRZi*Wj;
         }
-      }
 
-      // Compute the tensile correction to add to the stress as described in 
-      // Gray, Monaghan, & Swift (Comput. Methods Appl. Mech. Eng., 190, 2001)
-      const auto fi = epsTensile*FastMath::pow4(Wi/(Hdeti*WnPerh));
-      const auto fj = epsTensile*FastMath::pow4(Wj/(Hdetj*WnPerh));
-      const auto Ri = fi*tensileStressCorrection(sigmai);
-      const auto Rj = fj*tensileStressCorrection(sigmaj);
-      sigmai += Ri;
-      sigmaj += Rj;
+        // Contribution to the sum density correction
+        rhoSumCorrectioni += mRZj * WQi / rhoj ;
+        rhoSumCorrectionj += mRZi * WQj / rhoi ;
+
+        // Compute the pair-wise artificial viscosity.
+        const auto vij = vi - vj;
+        std::tie(QPiij, QPiji) = Q.Piij(nodeListi, i, nodeListj, j,
+                                        posi, etai, vi, rhoi, ci, Hi,
+                                        posj, etaj, vj, rhoj, cj, Hj);
+        const auto Qacci = 0.5*(QPiij*gradWQi);
+        const auto Qaccj = 0.5*(QPiji*gradWQj);
+        const auto workQi = vij.dot(Qacci);
+        const auto workQj = vij.dot(Qaccj);
+        const auto Qi = rhoi*rhoi*(QPiij.diagonalElements().maxAbsElement());
+        const auto Qj = rhoj*rhoj*(QPiji.diagonalElements().maxAbsElement());
+        maxViscousPressurei = max(maxViscousPressurei, Qi);
+        maxViscousPressurej = max(maxViscousPressurej, Qj);
+        effViscousPressurei += mRZj*Qi*WQi/rhoj;
+        effViscousPressurej += mRZi*Qj*WQj/rhoi;
+        viscousWorki += mRZj*workQi;
+        viscousWorkj += mRZi*workQj;
+
+        // Damage scaling of negative pressures.
+        const auto Peffi = (mNegativePressureInDamage or Pi > 0.0 ? Pi : fDeffij*Pi);
+        const auto Peffj = (mNegativePressureInDamage or Pj > 0.0 ? Pj : fDeffij*Pj);
+
+        // Compute the stress tensors.
+        sigmai = -Peffi*SymTensor::one;
+        sigmaj = -Peffj*SymTensor::one;
+        if (sameMatij) {
+          if (mStrengthInDamage) {
+            sigmai += Si;
+            sigmaj += Sj;
+          } else {
+            sigmai += fDeffij*Si;
+            sigmaj += fDeffij*Sj;
+          }
+        }
 
-      // Acceleration.
-      CHECK(rhoi > 0.0);
-      CHECK(rhoj > 0.0);
-      const auto sigmarhoi = safeOmegai*sigmai/(rhoi*rhoi);
-      const auto sigmarhoj = safeOmegaj*sigmaj/(rhoj*rhoj);
-      const auto deltaDvDt = sigmarhoi*gradWi + sigmarhoj*gradWj - Qacci - Qaccj;
-      if (freeParticle) {
-        DvDti += mRZj*deltaDvDt;
-        DvDtj -= mRZi*deltaDvDt;
-      }
-      if (compatibleEnergy) {
-        pairAccelerations[2*kk]   =  mRZj*deltaDvDt;
-        pairAccelerations[2*kk+1] = -mRZi*deltaDvDt;
-      }
+        // Compute the tensile correction to add to the stress as described in 
+        // Gray, Monaghan, & Swift (Comput. Methods Appl. Mech. Eng., 190, 2001)
+        const auto fi = epsTensile*FastMath::pow4(Wi/(Hdeti*WnPerh));
+        const auto fj = epsTensile*FastMath::pow4(Wj/(Hdetj*WnPerh));
+        const auto Ri = fi*tensileStressCorrection(sigmai);
+        const auto Rj = fj*tensileStressCorrection(sigmaj);
+        sigmai += Ri;
+        sigmaj += Rj;
+
+        // Acceleration.
+        CHECK(rhoi > 0.0);
+        CHECK(rhoj > 0.0);
+        const auto sigmarhoi = safeOmegai*sigmai/(rhoi*rhoi);
+        const auto sigmarhoj = safeOmegaj*sigmaj/(rhoj*rhoj);
+        const auto deltaDvDt = sigmarhoi*gradWi + sigmarhoj*gradWj - Qacci - Qaccj;
+        if (freeParticle) {
+          DvDti += mRZj*deltaDvDt;
+          DvDtj -= mRZi*deltaDvDt;
+        }
+        if (compatibleEnergy) {
+          pairAccelerations[2*kk]   =  mRZj*deltaDvDt;
+          pairAccelerations[2*kk+1] = -mRZi*deltaDvDt;
+        }
 
-      // Pair-wise portion of grad velocity.
-      const auto deltaDvDxi = fDeffij*vij.dyad(gradWGi);
-      const auto deltaDvDxj = fDeffij*vij.dyad(gradWGj);
+        // Pair-wise portion of grad velocity.
+        const auto deltaDvDxi = fDeffij*vij.dyad(gradWGi);
+        const auto deltaDvDxj = fDeffij*vij.dyad(gradWGj);
 
-      // Specific thermal energy evolution.
-      DepsDti -= mRZj*(sigmarhoi.doubledot(deltaDvDxi.Symmetric()) - workQi);
-      DepsDtj -= mRZi*(sigmarhoj.doubledot(deltaDvDxj.Symmetric()) - workQj);
+        // Specific thermal energy evolution.
+        DepsDti -= mRZj*(sigmarhoi.doubledot(deltaDvDxi.Symmetric()) - workQi);
+        DepsDtj -= mRZi*(sigmarhoj.doubledot(deltaDvDxj.Symmetric()) - workQj);
 
-      // Velocity gradient.
-      DvDxi -= mRZj*deltaDvDxi;
-      DvDxj -= mRZi*deltaDvDxj;
-      if (sameMatij) {
-        localDvDxi -= mRZj*deltaDvDxi;
-        localDvDxj -= mRZi*deltaDvDxj;
-      }
+        // Velocity gradient.
+        DvDxi -= mRZj*deltaDvDxi;
+        DvDxj -= mRZi*deltaDvDxj;
+        if (sameMatij) {
+          localDvDxi -= mRZj*deltaDvDxi;
+          localDvDxj -= mRZi*deltaDvDxj;
+        }
 
-      // Estimate of delta v (for XSPH).
-      if (sameMatij or min(zetai, zetaj) < 1.0) {
-        const auto wXSPHij = 0.5*(mRZi/rhoi*Wi + mRZj/rhoj*Wj);
-        XSPHWeightSumi += wXSPHij;
-        XSPHWeightSumj += wXSPHij;
-        XSPHDeltaVi -= wXSPHij*vij;
-        XSPHDeltaVj += wXSPHij*vij;
-      }
+        // Estimate of delta v (for XSPH).
+        if (sameMatij or min(zetai, zetaj) < 1.0) {
+          const auto wXSPHij = 0.5*(mRZi/rhoi*Wi + mRZj/rhoj*Wj);
+          XSPHWeightSumi += wXSPHij;
+          XSPHWeightSumj += wXSPHij;
+          XSPHDeltaVi -= wXSPHij*vij;
+          XSPHDeltaVj += wXSPHij*vij;
+        }
 
-      // Linear gradient correction term.
-      Mi -= mRZj*xij.dyad(gradWGi);
-      Mj -= mRZi*xij.dyad(gradWGj);
-      if (sameMatij) {
-        localMi -= mRZj*xij.dyad(gradWGi);
-        localMj -= mRZi*xij.dyad(gradWGj);
-      }
+        // Linear gradient correction term.
+        Mi -= mRZj*xij.dyad(gradWGi);
+        Mj -= mRZi*xij.dyad(gradWGj);
+        if (sameMatij) {
+          localMi -= mRZj*xij.dyad(gradWGi);
+          localMj -= mRZi*xij.dyad(gradWGj);
+        }
 
-    } // loop over pairs
+      } // loop over pairs
+    }
 
     // Reduce the thread values to the master.
     threadReduceFieldLists<Dimension>(threadStack);
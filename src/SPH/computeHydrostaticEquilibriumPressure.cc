@@ -89,10 +89,10 @@ computeSPHHydrostaticEquilibriumPressure(const DataBase<Dim<3> >& db,
       s[2][iglobal] = rhoi*gi.z();
 
       // Get the neighbors for this node (in this NodeList).
-      const vector<vector<int> >& connectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto connectivity = connectivityMap.connectivityForNode(nodeListi, i);
       CHECK(connectivity.size() == numNodeLists);
       for (unsigned nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
-        for (vector<int>::const_iterator jItr = connectivity[nodeListj].begin();
+        for (auto jItr = connectivity[nodeListj].begin();
              jItr != connectivity[nodeListj].end();
              ++jItr) {
           const unsigned j = *jItr;
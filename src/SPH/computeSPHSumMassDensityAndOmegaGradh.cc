@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+// Compute the SPH mass density summation and grad h correction in one pass.
+//------------------------------------------------------------------------------
+#include "computeSPHSumMassDensityAndOmegaGradh.hh"
+#include "Field/Field.hh"
+#include "Field/FieldList.hh"
+#include "Neighbor/ConnectivityMap.hh"
+#include "Neighbor/NodePairGeometry.hh"
+#include "Neighbor/PairThreadReduction.hh"
+#include "Kernel/TableKernel.hh"
+#include "NodeList/NodeList.hh"
+#include "Hydro/HydroFieldNames.hh"
+
+namespace Spheral {
+
+using std::min;
+using std::max;
+using std::abs;
+
+template<typename Dimension>
+void
+computeSPHSumMassDensityAndOmegaGradh(const ConnectivityMap<Dimension>& connectivityMap,
+                                      const TableKernel<Dimension>& W,
+                                      const bool /*sumOverAllNodeLists*/,
+                                      const FieldList<Dimension, typename Dimension::Vector>& position,
+                                      const FieldList<Dimension, typename Dimension::Scalar>& mass,
+                                      const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                                      FieldList<Dimension, typename Dimension::Scalar>& massDensity,
+                                      FieldList<Dimension, typename Dimension::Scalar>& omegaGradh,
+                                      const ThreadReductionMethod method) {
+
+  // Pre-conditions.
+  const size_t numNodeLists = massDensity.size();
+  REQUIRE(position.size() == numNodeLists);
+  REQUIRE(mass.size() == numNodeLists);
+  REQUIRE(H.size() == numNodeLists);
+  REQUIRE(omegaGradh.size() == numNodeLists);
+
+  typedef typename Dimension::Scalar Scalar;
+
+  // Some useful variables.
+  const auto W0 = W.kernelValue(0.0, 1.0);
+
+  // Start the density with the self contribution, and zero the grad h sums.
+  omegaGradh = 0.0;
+  FieldList<Dimension, Scalar> gradsum(FieldStorageType::CopyFields);
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    gradsum.appendNewField("sum of the gradient", omegaGradh[nodeListi]->nodeList(), 0.0);
+    const auto n = massDensity[nodeListi]->numInternalElements();
+#pragma omp parallel for
+    for (auto i = 0u; i < n; ++i) {
+      massDensity(nodeListi, i) = mass(nodeListi, i)*H(nodeListi, i).Determinant()*W0;
+    }
+  }
+
+  // The set of interacting node pairs.
+  const auto& pairs = connectivityMap.nodePairList();
+
+  // The per-pair geometry and kernel values, if they're being cached.
+  auto& pairGeometry = connectivityMap.pairGeometry();
+  const auto cachedGeometry = pairGeometry.caching();
+  const typename NodePairGeometry<Dimension>::KernelValues* Wvalues = nullptr;
+  if (cachedGeometry) {
+    pairGeometry.update(pairs, connectivityMap.nodePairGeneration(), position, H);
+    Wvalues = &pairGeometry.kernelValues(W);
+  }
+
+  // Walk all the interacting pairs.
+  PairThreadReduction<Dimension> threadReduction(connectivityMap, method);
+#pragma omp parallel
+  {
+    // Thread private scratch variables
+    int i, j, nodeListi, nodeListj;
+    Scalar etai, etaj, Wi, gWi, Wj, gWj;
+
+    // Thread-local accumulation windows.
+    FieldListThreadWindow<Dimension, Scalar> massDensity_thread(massDensity, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> omegaGradh_thread(omegaGradh, threadReduction);
+    FieldListThreadWindow<Dimension, Scalar> gradsum_thread(gradsum, threadReduction);
+
+    for (const auto ghostPairs: {false, true}) {
+      if (ghostPairs) connectivityMap.completeGhostExchange();
+      const auto kpairs = threadReduction.pairRange(ghostPairs);
+      for (auto kk = kpairs.first; kk < kpairs.second; ++kk) {
+        i = pairs[kk].i_node;
+        j = pairs[kk].j_node;
+        nodeListi = pairs[kk].i_list;
+        nodeListj = pairs[kk].j_list;
+
+        // Kernel weighting and gradient.
+        if (cachedGeometry) {
+          etai = pairGeometry.etai(kk).magnitude();
+          etaj = pairGeometry.etaj(kk).magnitude();
+          Wi = Wvalues->Wi[kk];
+          gWi = Wvalues->gWi[kk];
+          Wj = Wvalues->Wj[kk];
+          gWj = Wvalues->gWj[kk];
+        } else {
+          const auto& Hi = H(nodeListi, i);
+          const auto& Hj = H(nodeListj, j);
+          const auto rij = position(nodeListi, i) - position(nodeListj, j);
+          etai = (Hi*rij).magnitude();
+          etaj = (Hj*rij).magnitude();
+          std::tie(Wi, gWi) = W.kernelAndGradValue(etai, Hi.Determinant());
+          std::tie(Wj, gWj) = W.kernelAndGradValue(etaj, Hj.Determinant());
+        }
+
+        // Sum the pair-wise contributions.
+        const auto mi = mass(nodeListi, i);
+        const auto mj = mass(nodeListj, j);
+        const auto sameMaterial = (nodeListi == nodeListj);
+        massDensity_thread(nodeListi, i) += (sameMaterial ? mj : mi)*Wj;
+        massDensity_thread(nodeListj, j) += (sameMaterial ? mi : mj)*Wi;
+
+        omegaGradh_thread(nodeListi, i) += Wi;
+        omegaGradh_thread(nodeListj, j) += Wj;
+
+        gradsum_thread(nodeListi, i) += etai*gWi;
+        gradsum_thread(nodeListj, j) += etaj*gWj;
+      }
+    }
+
+    // Reduce the thread values to the master.
+    threadReduction.reduce();
+
+  }    // OMP parallel
+
+  // Finish the grad h correction for each point.
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto ni = omegaGradh[nodeListi]->numInternalElements();
+#pragma omp parallel for
+    for (auto i = 0u; i < ni; ++i) {
+
+      // If this point is isolated, we punt to unity.
+      if (connectivityMap.numNeighborsForNode(nodeListi, i) == 0) {
+        omegaGradh(nodeListi, i) = 1.0;
+
+      } else {
+        const Scalar Hdeti = H(nodeListi, i).Determinant();
+        omegaGradh(nodeListi, i) += Hdeti*W0;
+        CHECK(omegaGradh(nodeListi, i) > 0.0);
+        omegaGradh(nodeListi, i) = std::max(1.0e-30, -gradsum(nodeListi, i)/(Dimension::nDim * omegaGradh(nodeListi, i)));
+
+      }
+
+      // Post-conditions.
+      ENSURE2(omegaGradh(nodeListi, i) >= 0.0, 
+              nodeListi << " " << i << " " << omegaGradh(nodeListi, i));
+    }
+  }
+}
+
+}
@@ -0,0 +1,37 @@
+//---------------------------------Spheral++------------------------------------
+// Compute the SPH mass density summation and the grad h correction of
+// Springel et al. together, in a single walk of the node pairs.
+//
+// This gives the same result as computeSPHSumMassDensity followed by
+// computeSPHOmegaGradhCorrection, but touches the neighbor data and looks up
+// the kernel once per pair rather than twice.  The pair walk uses the same
+// thread reduction and (if it is being cached) pair geometry as the SPH
+// evaluateDerivatives.
+//------------------------------------------------------------------------------
+#ifndef __Spheral__computeSPHSumMassDensityAndOmegaGradh__
+#define __Spheral__computeSPHSumMassDensityAndOmegaGradh__
+
+#include "Utilities/OpenMP_wrapper.hh"
+
+namespace Spheral {
+
+  // Forward declarations.
+  template<typename Dimension> class ConnectivityMap;
+  template<typename Dimension> class TableKernel;
+  template<typename Dimension, typename DataType> class FieldList;
+
+  template<typename Dimension>
+  void
+  computeSPHSumMassDensityAndOmegaGradh(const ConnectivityMap<Dimension>& connectivityMap,
+                                        const TableKernel<Dimension>& W,
+                                        const bool sumOverAllNodeLists,
+                                        const FieldList<Dimension, typename Dimension::Vector>& position,
+                                        const FieldList<Dimension, typename Dimension::Scalar>& mass,
+                                        const FieldList<Dimension, typename Dimension::SymTensor>& H,
+                                        FieldList<Dimension, typename Dimension::Scalar>& massDensity,
+                                        FieldList<Dimension, typename Dimension::Scalar>& omegaGradh,
+                                        const ThreadReductionMethod method);
+
+}
+
+#endif
@@ -0,0 +1,20 @@
+text = """
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "SPH/computeSPHSumMassDensityAndOmegaGradh.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+  template void computeSPHSumMassDensityAndOmegaGradh(const ConnectivityMap<Dim< %(ndim)s > >&, 
+                                                      const TableKernel<Dim< %(ndim)s > >&, 
+                                                      const bool,
+                                                      const FieldList<Dim< %(ndim)s >, Dim< %(ndim)s >::Vector>&,
+                                                      const FieldList<Dim< %(ndim)s >, Dim< %(ndim)s >::Scalar>&,
+                                                      const FieldList<Dim< %(ndim)s >, Dim< %(ndim)s >::SymTensor>&,
+                                                      FieldList<Dim< %(ndim)s >, Dim< %(ndim)s >::Scalar>&,
+                                                      FieldList<Dim< %(ndim)s >, Dim< %(ndim)s >::Scalar>&,
+                                                      const ThreadReductionMethod);
+}
+
+"""
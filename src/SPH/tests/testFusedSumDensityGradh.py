@@ -0,0 +1,210 @@
+#ATS:for testDim in ("1d", "2d"):
+#ATS:    test(SELF, "--testDim %s" % testDim, label="SPH fused sum density and grad h reuse test -- %s (serial)" % testDim)
+#-------------------------------------------------------------------------------
+# With fuseSumDensityGradh SPHHydroBase::preStepInitialize computes the grad h
+# correction alongside the sum density, and SPHHydroBase::initialize reuses it
+# only if the positions and H are unchanged.  Check:
+#   1.  initialize reuses the fused correction when nothing has changed;
+#   2.  moving a point, changing an H, or calling initialize a second time
+#       forces initialize to recompute the correction;
+#   3.  advancing a few steps with CheapSynchronousRK2 (which changes the state
+#       between the two calls) matches the unfused answer.
+#-------------------------------------------------------------------------------
+from math import sqrt
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("SPH fused sum density and grad h test")
+
+commandLine(
+    nx1d = 100,
+    nx2d = 20,
+    rho1 = 1.0,
+    rho2 = 0.5,
+    eps1 = 1.0,
+    eps2 = 2.0,
+    nPerh = 2.01,
+    gamma = 5.0/3.0,
+    mu = 1.0,
+    testDim = "2d",
+
+    ranfrac = 0.2,
+    vfrac = 0.1,
+    seed = 2390471,
+
+    nsteps = 10,
+    dt = 1.0e-3,
+    tolerance = 1.0e-10,
+)
+
+assert testDim in ("1d", "2d")
+
+if mpi.procs > 1:
+    raise RuntimeError, "testFusedSumDensityGradh is intended to be run serially"
+
+exec("from Spheral%s import *" % testDim)
+ndim = int(testDim[0])
+
+import random
+
+#-------------------------------------------------------------------------------
+# Build a two NodeList problem with SPH, optionally fusing the sum density and
+# grad h passes.
+#-------------------------------------------------------------------------------
+WT = TableKernel(BSplineKernel(), 1000)
+eos = GammaLawGasMKS(gamma, mu)
+
+def buildProblem(label, fuse):
+    rangen = random.Random()
+    rangen.seed(seed)
+    nodes1 = makeFluidNodeList("nodes1 " + label, eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+    nodes2 = makeFluidNodeList("nodes2 " + label, eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+    nodeSet = [nodes1, nodes2]
+    if testDim == "1d":
+        from DistributeNodes import distributeNodesInRange1d
+        distributeNodesInRange1d([(nodes1, nx1d, rho1, (0.0, 0.5)),
+                                  (nodes2, nx1d, rho2, (0.5, 1.0))], nPerh = nPerh)
+        dx = 1.0/nx1d
+    else:
+        from GenerateNodeDistribution2d import GenerateNodeDistribution2d
+        from DistributeNodes import distributeNodes2d
+        gen1 = GenerateNodeDistribution2d(nx2d, 2*nx2d, rho1, "lattice",
+                                          xmin = (0.0, 0.0),
+                                          xmax = (0.5, 1.0),
+                                          nNodePerh = nPerh)
+        gen2 = GenerateNodeDistribution2d(nx2d, 2*nx2d, rho2, "lattice",
+                                          xmin = (0.5, 0.0),
+                                          xmax = (1.0, 1.0),
+                                          nNodePerh = nPerh)
+        distributeNodes2d((nodes1, gen1), (nodes2, gen2))
+        dx = 1.0/nx2d
+    for nodes, eps0 in ((nodes1, eps1), (nodes2, eps2)):
+        nodes.specificThermalEnergy(ScalarField("tmp", nodes, eps0))
+        pos = nodes.positions()
+        vel = nodes.velocity()
+        for i in xrange(nodes.numInternalNodes):
+            for j in xrange(ndim):
+                pos[i][j] += ranfrac*dx*rangen.uniform(-1.0, 1.0)
+                vel[i][j] = vfrac*rangen.uniform(-1.0, 1.0)
+
+    db = DataBase()
+    for nodes in nodeSet:
+        db.appendNodeList(nodes)
+    hydro = SPH(dataBase = db,
+                W = WT,
+                gradhCorrection = True,
+                densityUpdate = RigorousSumDensity)
+    hydro.fuseSumDensityGradh = fuse
+    integrator = CheapSynchronousRK2Integrator(db)
+    integrator.appendPhysicsPackage(hydro)
+    integrator.lastDt = dt
+    integrator.dtMin = dt
+    integrator.dtMax = dt
+    db.updateConnectivityMap(False)
+    integrator.initializeProblemStartup(db)
+    return nodeSet, db, hydro, integrator
+
+# The internal values of a FieldList, and the largest difference between two
+# sets of them relative to the largest magnitude in the first.
+def values(fl):
+    return [list(fl[k].internalValues()) for k in xrange(len(fl))]
+
+def magnitude(x):
+    if isinstance(x, float):
+        return abs(x)
+    else:
+        return x.magnitude()
+
+def maxRelativeDifference(a, b):
+    assert len(a) == len(b)
+    scale, diff = 1.0e-50, 0.0
+    for valsa, valsb in zip(a, b):
+        assert len(valsa) == len(valsb)
+        for xa, xb in zip(valsa, valsb):
+            scale = max(scale, magnitude(xa))
+            diff = max(diff, magnitude(xa - xb))
+    return diff/scale
+
+#-------------------------------------------------------------------------------
+# 1 & 2.  Reuse and invalidation of the fused correction by initialize.
+#-------------------------------------------------------------------------------
+nodeSet, db, hydro, integrator = buildProblem("reuse", True)
+state = State(db, integrator.physicsPackages())
+derivs = StateDerivatives(db, integrator.physicsPackages())
+omega = state.scalarFields(HydroFieldNames.omegaGradh)
+position = state.vectorFields(HydroFieldNames.position)
+H = state.symTensorFields(HydroFieldNames.H)
+sentinel = -1.0
+
+# Mark the correction so we can tell whether initialize recomputed it.
+def markOmega():
+    for k in xrange(len(nodeSet)):
+        for i in xrange(nodeSet[k].numInternalNodes):
+            omega[k][i] = sentinel
+
+def omegaReused():
+    return min([x == sentinel for vals in values(omega) for x in vals])
+
+def checkRecomputed(label):
+    if omegaReused():
+        raise ValueError, "%s:  initialize reused the fused grad h correction" % label
+    answer = db.newFluidScalarFieldList(0.0, "omega")
+    computeSPHOmegaGradhCorrection(db.connectivityMap(), WT, position, H, answer)
+    err = maxRelativeDifference(values(answer), values(omega))
+    print "%40s : grad h correction max relative difference %g" % (label, err)
+    if err > tolerance:
+        raise ValueError, "%s:  recomputed grad h correction differs by %g" % (label, err)
+
+def perturbPosition():
+    position[0][0] = position[0][0] + Vector.one*0.01/(nx1d if ndim == 1 else nx2d)
+
+def perturbH():
+    H[1][0] = H[1][0]*1.01
+
+# Nothing changed:  the fused correction is reused.
+hydro.preStepInitialize(db, state, derivs)
+markOmega()
+hydro.initialize(0.0, dt, db, state, derivs)
+if not omegaReused():
+    raise ValueError, "initialize recomputed the grad h correction although the positions and H did not change"
+print "%40s : reused" % "Unchanged state"
+
+# A second initialize without preStepInitialize must recompute.
+markOmega()
+hydro.initialize(0.0, dt, db, state, derivs)
+checkRecomputed("Second initialize")
+
+# Moving a point or changing an H must recompute.
+for label, perturb in (("Moved position", perturbPosition),
+                       ("Changed H", perturbH)):
+    hydro.preStepInitialize(db, state, derivs)
+    perturb()
+    markOmega()
+    hydro.initialize(0.0, dt, db, state, derivs)
+    checkRecomputed(label)
+
+#-------------------------------------------------------------------------------
+# 3.  Advance with and without fusing, and compare the answers.
+#-------------------------------------------------------------------------------
+answers = []
+for label, fuse in (("unfused", False), ("fused", True)):
+    nodeSet, db, hydro, integrator = buildProblem(label, fuse)
+    control = SpheralController(integrator, WT,
+                                statsStep = 1000,
+                                restartBaseName = "testFusedSumDensityGradh-%s-%s-restart" % (testDim, label))
+    control.step(nsteps)
+    answers.append({"Mass density"  : values(db.fluidMassDensity),
+                    "Thermal energy": values(db.fluidSpecificThermalEnergy),
+                    "Velocity"      : values(db.fluidVelocity),
+                    "Position"      : values(db.fluidPosition),
+                    "Omega"         : values(hydro.omegaGradh)})
+
+failures = []
+for name in answers[0]:
+    err = maxRelativeDifference(answers[0][name], answers[1][name])
+    print "%40s : fused vs. unfused max relative difference %g" % (name, err)
+    if err > tolerance:
+        failures.append((name, err))
+if failures:
+    raise ValueError, "Fused sum density and grad h answer differs from the unfused answer: %s" % failures
+print "PASS"
@@ -0,0 +1,189 @@
+#ATS:for testDim in ("1d", "2d", "3d"):
+#ATS:    for HydroChoice in ("SPH", "SolidSPH"):
+#ATS:        test(SELF, "--testDim %s --HydroChoice %s" % (testDim, HydroChoice),
+#ATS:             label="%s thread reduction test -- %s (serial)" % (HydroChoice, testDim))
+#-------------------------------------------------------------------------------
+# Check the touched range thread reduction of the hydro pair loops against the
+# full copy reduction, and the threaded results against a single thread.
+#-------------------------------------------------------------------------------
+from math import sqrt
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Hydro thread reduction test")
+
+#-------------------------------------------------------------------------------
+# Generic problem parameters
+#-------------------------------------------------------------------------------
+commandLine(
+    nx1d = 200,
+    nx2d = 30,
+    nx3d = 10,
+    rho1 = 1.0,
+    rho2 = 0.5,
+    eps1 = 1.0,
+    eps2 = 2.0,
+    nPerh = 2.01,
+    gamma = 5.0/3.0,
+    mu = 1.0,
+
+    # What hydro operator should we test?
+    HydroChoice = "SPH",
+    testDim = "2d",
+
+    # Randomly perturb the positions and velocities.
+    ranfrac = 0.2,
+    vfrac = 0.1,
+    seed = 49823741,
+
+    # The thread counts to compare against one thread.
+    threads = "2,4",
+
+    # Parameters for passing the test
+    tolerance = 1.0e-10,
+)
+
+assert testDim in ("1d", "2d", "3d")
+assert HydroChoice in ("SPH", "SolidSPH")
+
+if mpi.procs > 1:
+    raise RuntimeError, "testThreadReduction is intended to be run serially"
+
+exec("from SolidSpheral%s import *" % testDim)
+ndim = int(testDim[0])
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+#-------------------------------------------------------------------------------
+# Build two NodeLists, so the reductions have to handle more than one Field.
+#-------------------------------------------------------------------------------
+eos = GammaLawGasMKS(gamma, mu)
+WT = TableKernel(BSplineKernel(), 1000)
+if HydroChoice == "SolidSPH":
+    makeNodeList = makeSolidNodeList
+else:
+    makeNodeList = makeFluidNodeList
+nodes1 = makeNodeList("nodes1", eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+nodes2 = makeNodeList("nodes2", eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+nodeSet = [nodes1, nodes2]
+
+if testDim == "1d":
+    from DistributeNodes import distributeNodesInRange1d
+    distributeNodesInRange1d([(nodes1, nx1d, rho1, (0.0, 0.5)),
+                              (nodes2, nx1d, rho2, (0.5, 1.0))], nPerh = nPerh)
+elif testDim == "2d":
+    from GenerateNodeDistribution2d import GenerateNodeDistribution2d
+    from DistributeNodes import distributeNodes2d
+    gen1 = GenerateNodeDistribution2d(nx2d, 2*nx2d, rho1, "lattice",
+                                      xmin = (0.0, 0.0),
+                                      xmax = (0.5, 1.0),
+                                      nNodePerh = nPerh)
+    gen2 = GenerateNodeDistribution2d(nx2d, 2*nx2d, rho2, "lattice",
+                                      xmin = (0.5, 0.0),
+                                      xmax = (1.0, 1.0),
+                                      nNodePerh = nPerh)
+    distributeNodes2d((nodes1, gen1), (nodes2, gen2))
+else:
+    from GenerateNodeDistribution3d import GenerateNodeDistribution3d
+    from DistributeNodes import distributeNodes3d
+    gen1 = GenerateNodeDistribution3d(nx3d, 2*nx3d, 2*nx3d, rho1, "lattice",
+                                      xmin = (0.0, 0.0, 0.0),
+                                      xmax = (0.5, 1.0, 1.0),
+                                      nNodePerh = nPerh)
+    gen2 = GenerateNodeDistribution3d(nx3d, 2*nx3d, 2*nx3d, rho2, "lattice",
+                                      xmin = (0.5, 0.0, 0.0),
+                                      xmax = (1.0, 1.0, 1.0),
+                                      nNodePerh = nPerh)
+    distributeNodes3d((nodes1, gen1), (nodes2, gen2))
+
+# Jitter the positions and give the points a random velocity, so every term in
+# the pair loops contributes.
+for nodes, eps0 in ((nodes1, eps1), (nodes2, eps2)):
+    nodes.specificThermalEnergy(ScalarField("tmp", nodes, eps0))
+    dx = 1.0/(nx1d if ndim == 1 else nx2d if ndim == 2 else nx3d)
+    pos = nodes.positions()
+    vel = nodes.velocity()
+    for i in xrange(nodes.numInternalNodes):
+        for j in xrange(ndim):
+            pos[i][j] += ranfrac*dx*rangen.uniform(-1.0, 1.0)
+            vel[i][j] = vfrac*rangen.uniform(-1.0, 1.0)
+
+db = DataBase()
+for nodes in nodeSet:
+    db.appendNodeList(nodes)
+
+#-------------------------------------------------------------------------------
+# Build the hydro (SPH picks the solid variant for the SolidNodeLists).
+#-------------------------------------------------------------------------------
+q = MonaghanGingoldViscosity(1.0, 1.0)
+hydro = SPH(dataBase = db, Q = q, W = WT)
+integrator = CheapSynchronousRK2Integrator(db)
+integrator.appendPhysicsPackage(hydro)
+db.updateConnectivityMap(True)
+integrator.initializeProblemStartup(db)
+state = State(db, integrator.physicsPackages())
+derivs = StateDerivatives(db, integrator.physicsPackages())
+
+# The derivatives accumulated in the pair loops.
+def derivativeFields():
+    return [("DvDt",   derivs.vectorFields(HydroFieldNames.hydroAcceleration)),
+            ("DepsDt", derivs.scalarFields("delta " + HydroFieldNames.specificThermalEnergy)),
+            ("DrhoDt", derivs.scalarFields("delta " + HydroFieldNames.massDensity)),
+            ("DvDx",   derivs.tensorFields(HydroFieldNames.velocityGradient)),
+            ("DHDt",   derivs.symTensorFields("delta " + HydroFieldNames.H)),
+            ("Hideal", derivs.symTensorFields("new " + HydroFieldNames.H))]
+
+# Evaluate the derivatives and return a copy of the values.
+def evaluate(method, nthreads):
+    omp_set_num_threads(nthreads)
+    hydro.threadReductionMethod = method
+    derivs.Zero()
+    integrator.preStepInitialize(state, derivs)
+    integrator.initializeDerivatives(0.0, 1.0, state, derivs)
+    integrator.evaluateDerivatives(0.0, 1.0, db, state, derivs)
+    integrator.finalizeDerivatives(0.0, 1.0, db, state, derivs)
+    result = {}
+    for name, fl in derivativeFields():
+        result[name] = [list(fl[k].internalValues()) for k in xrange(len(nodeSet))]
+    return result
+
+# The largest difference between two evaluations, relative to the largest
+# magnitude of each quantity.
+def magnitude(x):
+    if isinstance(x, float):
+        return abs(x)
+    elif hasattr(x, "selfDoubledot"):
+        return sqrt(x.selfDoubledot())
+    else:
+        return x.magnitude()
+
+def maxRelativeDifference(a, b):
+    result = {}
+    for name in a:
+        scale = max([max([magnitude(x) for x in vals] + [0.0]) for vals in a[name]] + [1.0e-50])
+        diff = 0.0
+        for valsa, valsb in zip(a[name], b[name]):
+            assert len(valsa) == len(valsb)
+            for xa, xb in zip(valsa, valsb):
+                diff = max(diff, magnitude(xa - xb))
+        result[name] = diff/scale
+    return result
+
+#-------------------------------------------------------------------------------
+# Compare against the single threaded full copy answer.
+#-------------------------------------------------------------------------------
+reference = evaluate(FullCopy, 1)
+failures = []
+for nt in [int(x) for x in threads.split(",")]:
+    for method in (FullCopy, TouchedRange):
+        errs = maxRelativeDifference(reference, evaluate(method, nt))
+        for name, err in errs.items():
+            print "%10s %-14s %2i threads : max relative difference %g" % (name, str(method), nt, err)
+            if err > tolerance:
+                failures.append((name, str(method), nt, err))
+
+if failures:
+    raise ValueError, "thread reduction differs from the single threaded answer: %s" % failures
+print "PASS"
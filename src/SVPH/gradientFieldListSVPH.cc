@@ -145,10 +145,10 @@ gradientFieldListSVPH(const FieldList<Dimension, DataType>& fieldList,
       Scalar norm = Vi*W0*Hdeti;
 
       // Walk the neighbors for this node.
-      const vector<vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
       for (auto nodeListj = 0u; nodeListj != numNodeLists; ++nodeListj) {
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
-        for (vector<int>::const_iterator jItr = connectivity.begin();
+        const auto connectivity = fullConnectivity[nodeListj];
+        for (auto jItr = connectivity.begin();
              jItr != connectivity.end();
              ++jItr) {
           const int j = *jItr;
@@ -158,10 +158,10 @@ sampleFieldListSVPH(const FieldList<Dimension, DataType>& fieldList,
       result(nodeListi, i) = Vi*W0*Hdeti * fieldList(nodeListi, i);
 
       // Walk the neighbors for this node.
-      const vector<vector<int> >& fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
+      const auto fullConnectivity = connectivityMap.connectivityForNode(nodeListi, i);
       for (auto nodeListj = 0u; nodeListj != numNodeLists; ++nodeListj) {
-        const vector<int>& connectivity = fullConnectivity[nodeListj];
-        for (vector<int>::const_iterator jItr = connectivity.begin();
+        const auto connectivity = fullConnectivity[nodeListj];
+        for (auto jItr = connectivity.begin();
              jItr != connectivity.end();
              ++jItr) {
           const int j = *jItr;
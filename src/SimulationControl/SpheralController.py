@@ -24,10 +24,17 @@ class SpheralController:
                  printStep = 1,
                  garbageCollectionStep = 100,
                  redistributeStep = None,
+                 redistributeImbalanceThreshold = None,
+                 redistributeMigrationFraction = 1.0,
+                 reorderStep = None,
+                 reorderCurve = "PeanoHilbert",
+                 reorderLocalityThreshold = None,
                  restartStep = None,
                  restartBaseName = "restart",
                  restartObjects = [],
-                 restartFileConstructor = SiloFileIO,
+                 restartFileConstructor = None,
+                 asyncRestart = False,
+                 maxPendingRestarts = 2,
                  restoreCycle = None,
                  initializeDerivatives = False,
                  vizBaseName = None,
@@ -53,7 +60,23 @@ class SpheralController:
         self.integrator = integrator
         self.kernel = kernel
         self.restartObjects = restartObjects
-        self.restartFileConstructor = restartFileConstructor
+        self.restartFileConstructor = restartFileConstructor if restartFileConstructor else SiloFileIO
+        self.restartWriter = None
+        self.redistributeImbalanceThreshold = redistributeImbalanceThreshold
+        self.redistributeMigrationFraction = redistributeMigrationFraction
+        assert reorderCurve in ("PeanoHilbert", "Morton")
+        self.reorderCurve = reorderCurve
+        self.reorderLocalityThreshold = reorderLocalityThreshold
+
+        # Asynchronous restarts snapshot the state into memory and write it
+        # from a background thread.  The writer owns the file format, so the
+        # restart files are always MemoryFileIO (".restart") files, and any
+        # other restartFileConstructor is an error.
+        if asyncRestart:
+            if restartFileConstructor not in (None, MemoryFileIO):
+                raise RuntimeError, "SpheralController ERROR: asyncRestart writes MemoryFileIO restart files, and cannot be combined with restartFileConstructor = %s" % restartFileConstructor.__name__
+            self.restartFileConstructor = MemoryFileIO
+            self.restartWriter = AsyncRestartWriter(maxPendingRestarts)
         self.SPH = SPH
         self.numHIterationsBetweenCycles = numHIterationsBetweenCycles
         self._break = False
@@ -86,7 +109,12 @@ class SpheralController:
 
         # Should we look for the last restart set?
         if restoreCycle == -1:
-            restoreCycle = findLastRestart(restartBaseName)
+            if self.restartFileConstructor is ParallelHDF5FileIO:
+                restoreCycle = findLastRestart(restartBaseName, procs=1, suffix=".h5")
+            elif self.restartFileConstructor is MemoryFileIO:
+                restoreCycle = findLastRestart(restartBaseName, suffix=".restart")
+            else:
+                restoreCycle = findLastRestart(restartBaseName)
 
         # Generic initialization work.
         self.reinitializeProblem(restartBaseName,
@@ -96,6 +124,7 @@ class SpheralController:
                                  printStep = printStep,
                                  garbageCollectionStep = garbageCollectionStep,
                                  redistributeStep = redistributeStep,
+                                 reorderStep = reorderStep,
                                  restartStep = restartStep,
                                  restoreCycle = restoreCycle,
                                  initializeDerivatives = initializeDerivatives,
@@ -129,6 +158,7 @@ class SpheralController:
                             printStep = 1,
                             garbageCollectionStep = 100,
                             redistributeStep = None,
+                            reorderStep = None,
                             restartStep = None,
                             restoreCycle = None,
                             initializeDerivatives = False,
@@ -242,6 +272,7 @@ class SpheralController:
 
         # We add this one after forcing periodic work so it's not always fired right at the beginning of a calculation.
         self.appendPeriodicWork(self.updateDomainDistribution, redistributeStep)
+        self.appendPeriodicWork(self.reorderNodes, reorderStep)
 
         return
 
@@ -255,8 +286,8 @@ class SpheralController:
         self.restartBaseName = name
 
         # If we're running parallel then add the domain info to the restart
-        # base name.
-        if procs > 1:
+        # base name.  ParallelHDF5FileIO shares a single file between domains.
+        if procs > 1 and self.restartFileConstructor is not ParallelHDF5FileIO:
             self.restartBaseName += '_rank%i_of_%idomains' % (rank, procs)
 
         return
@@ -351,6 +382,10 @@ class SpheralController:
             self.doPeriodicWork(force=True)
             self.redistribute = thpt
 
+        # Make sure any restart files in flight are on disk.
+        if self.restartWriter:
+            self.restartWriter.wait()
+
         db = self.integrator.dataBase
         bcs = self.integrator.uniqueBoundaryConditions()
         numActualGhostNodes = 0
@@ -500,10 +535,22 @@ class SpheralController:
 
     #--------------------------------------------------------------------------
     # Periodically redistribute the nodes between domains.
+    # If we have an imbalance threshold, we only repartition when the measured
+    # time of the slowest domain exceeds the mean by more than that factor.
     #--------------------------------------------------------------------------
     def updateDomainDistribution(self, cycle, Time, dt):
         if self.redistribute:
 
+            if not self.redistributeImbalanceThreshold is None:
+                localWork = self.integrator.dataBase.globalWork.localSumElements()
+                maxWork = mpi.allreduce(localWork, mpi.MAX)
+                meanWork = mpi.allreduce(localWork, mpi.SUM)/mpi.procs
+                if maxWork <= self.redistributeImbalanceThreshold*meanWork:
+                    return
+                if mpi.rank == 0:
+                    print "Domain work imbalance (max/mean) %g exceeds %g: redistributing nodes." % (maxWork/meanWork,
+                                                                                                   self.redistributeImbalanceThreshold)
+
             # It is *critical* that each NodeList have the same number of fields
             # registered against it on each processor, therefore we pause to
             # garbage collect here and make sure any temporaries are gone.
@@ -518,6 +565,37 @@ class SpheralController:
             self.redistributeTimer.printStatus()
         return
 
+    #--------------------------------------------------------------------------
+    # Periodically reorder the nodes in memory along a space filling curve, to
+    # keep the node storage order close to the spatial order as the nodes move.
+    # If we have a locality threshold, we only reorder when the fraction of
+    # node pairs that are far apart in memory exceeds it.
+    #--------------------------------------------------------------------------
+    def reorderNodes(self, cycle, Time, dt):
+        db = self.integrator.dataBase
+
+        if not self.reorderLocalityThreshold is None:
+            nonlocalFraction = eval("nonlocalNodePairFraction%s" % self.dim)(db.connectivityMap())
+            if nonlocalFraction <= self.reorderLocalityThreshold:
+                return
+            if mpi.rank == 0:
+                print "Nonlocal node pair fraction %g exceeds %g: reordering nodes." % (nonlocalFraction,
+                                                                                      self.reorderLocalityThreshold)
+
+        # As with redistribution every NodeList must have the same fields
+        # registered on each processor, so clear out any temporaries.
+        import gc
+        while gc.collect():
+            pass
+
+        # The reordering removes the ghost nodes, so rebuild them (and the
+        # connectivity) for the new order.
+        reorder = eval("reorderNodesBySpaceFillingCurve%s" % self.dim)
+        reorder(db, self.reorderCurve == "PeanoHilbert")
+        db.reinitializeNeighbors()
+        self.integrator.setGhostNodes()
+        return
+
     #--------------------------------------------------------------------------
     # Find the name associated with the given object.
     #--------------------------------------------------------------------------
@@ -543,6 +621,10 @@ class SpheralController:
         import time
         start = time.clock()
         fileName = self.restartBaseName + "_cycle%i" % self.totalSteps
+        if self.restartWriter:
+            self.restartWriter.dumpState(fileName)
+            print "Queued restart file in %0.2f seconds" % (time.clock() - start)
+            return
         file = self.restartFileConstructor(fileName, Create)
         RestartRegistrar.instance().dumpState(file)
         print "Wrote restart file in %0.2f seconds" % (time.clock() - start)
@@ -564,6 +646,12 @@ class SpheralController:
             fileName += ".gz"
         if self.restartFileConstructor is SiloFileIO:
             fileName += ".silo"
+        if self.restartFileConstructor is ParallelHDF5FileIO:
+            fileName += ".h5"
+        if self.restartFileConstructor is MemoryFileIO:
+            fileName += ".restart"
+        if self.restartWriter:
+            self.restartWriter.wait()
         if not os.path.exists(fileName):
             raise RuntimeError("File %s does not exist or is inaccessible." %
                                fileName)
@@ -757,6 +845,13 @@ precedeDistributed += [PeriodicBoundary%(dim)sd,
                 print "Warning: this appears to be a parallel run, but Controller cannot construct"
                 print "         dynamic redistributer."
                 pass
+
+            # Balancing against the measured imbalance requires the integrator
+            # to measure the work per node as it goes.
+            if self.redistribute and not self.redistributeImbalanceThreshold is None:
+                assert self.redistributeImbalanceThreshold >= 1.0
+                self.integrator.measureWork = True
+                self.redistribute.migrationFraction = self.redistributeMigrationFraction
         return
 
     #---------------------------------------------------------------------------
@@ -83,6 +83,12 @@ ANEOS(const int materialNumber,
   mTmax(Tmax),
   mExternalPressure(externalPressure),
   mSTEvals(boost::extents[numRhoVals][numTvals]),
+  mUseInterpolation(false),
+  mPvals(boost::extents[numRhoVals][numTvals]),
+  mCSvals(boost::extents[numRhoVals][numTvals]),
+  mSvals(boost::extents[numRhoVals][numTvals]),
+  mCVvals(boost::extents[numRhoVals][numTvals]),
+  mKvals(boost::extents[numRhoVals][numTvals]),
   mANEOSunits(0.01,   // cm expressed as meters.
               0.001,  // g expressed in kg.
               1.0),   // sec in secs.
@@ -130,7 +136,8 @@ ANEOS(const int materialNumber,
   // Fix the reference density.
   this->referenceDensity(this->referenceDensity() * mRhoConv);
 
-  // Build our lookup table to find eps(rho, T).
+  // Build our lookup table to find eps(rho, T), and since we're calling ANEOS
+  // anyway the tables for the other quantities as well.
   const double drho = (mRhoMax - mRhoMin)/(mNumRhoVals - 1);
   const double dT = (mTmax - mTmin)/(mNumTvals - 1);
   double Ti, rhoi, Pi, Si, CVi, DPDTi, DPDRi, csi;
@@ -143,6 +150,11 @@ ANEOS(const int materialNumber,
       call_aneos_(&mMaterialNumber, &Ti, &rhoi,
                   &Pi, &mSTEvals[i][j], &Si, &CVi, &DPDTi, &DPDRi, &csi);
       mSTEvals[i][j] = mSTEvals[i][j] * mEconv;
+      mPvals[i][j] = Pi * mPconv;
+      mCSvals[i][j] = csi * mVelConv;
+      mSvals[i][j] = Si * mSconv;
+      mCVvals[i][j] = CVi * mCVconv;
+      mKvals[i][j] = std::abs(rhoi * DPDRi * mPconv);
     }
   }
 }
@@ -164,7 +176,8 @@ ANEOS<Dimension>::
 setPressure(Field<Dimension, Scalar>& Pressure,
             const Field<Dimension, Scalar>& massDensity,
             const Field<Dimension, Scalar>& specificThermalEnergy) const {
-  for (int i = 0; i != (int)Pressure.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)Pressure.size(); ++i) {
     Pressure(i) = this->pressure(massDensity(i), specificThermalEnergy(i));
   }
 }
@@ -178,7 +191,8 @@ ANEOS<Dimension>::
 setTemperature(Field<Dimension, Scalar>& temperature,
                const Field<Dimension, Scalar>& massDensity,
                const Field<Dimension, Scalar>& specificThermalEnergy) const {
-  for (int i = 0; i != (int)temperature.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)temperature.size(); ++i) {
     temperature(i) = this->temperature(massDensity(i), specificThermalEnergy(i));
   }
 }
@@ -192,7 +206,8 @@ ANEOS<Dimension>::
 setSpecificThermalEnergy(Field<Dimension, Scalar>& specificThermalEnergy,
                          const Field<Dimension, Scalar>& massDensity,
                          const Field<Dimension, Scalar>& temperature) const {
-  for (int i = 0; i != (int)specificThermalEnergy.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)specificThermalEnergy.size(); ++i) {
     specificThermalEnergy(i) = this->specificThermalEnergy(massDensity(i), temperature(i));
   }
 }
@@ -206,7 +221,8 @@ ANEOS<Dimension>::
 setSpecificHeat(Field<Dimension, Scalar>& specificHeat,
                 const Field<Dimension, Scalar>& massDensity,
                 const Field<Dimension, Scalar>& temperature) const {
-  for (int i = 0; i != (int)specificHeat.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)specificHeat.size(); ++i) {
     specificHeat(i) = this->specificHeat(massDensity(i), temperature(i));
   }
 }
@@ -220,7 +236,8 @@ ANEOS<Dimension>::
 setSoundSpeed(Field<Dimension, Scalar>& soundSpeed,
               const Field<Dimension, Scalar>& massDensity,
               const Field<Dimension, Scalar>& specificThermalEnergy) const {
-  for (int i = 0; i != (int)soundSpeed.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)soundSpeed.size(); ++i) {
     soundSpeed(i) = this->soundSpeed(massDensity(i), specificThermalEnergy(i));
   }
 }
@@ -257,7 +274,8 @@ ANEOS<Dimension>::
 setBulkModulus(Field<Dimension, Scalar>& bulkModulus,
                const Field<Dimension, Scalar>& massDensity,
                const Field<Dimension, Scalar>& specificThermalEnergy) const {
-  for (int i = 0; i != (int)bulkModulus.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)bulkModulus.size(); ++i) {
     bulkModulus(i)=this->bulkModulus(massDensity(i), specificThermalEnergy(i));
   }
 }
@@ -271,11 +289,52 @@ ANEOS<Dimension>::
 setEntropy(Field<Dimension, Scalar>& entropy,
            const Field<Dimension, Scalar>& massDensity,
            const Field<Dimension, Scalar>& specificThermalEnergy) const {
-  for (int i = 0; i != (int)entropy.size(); ++i) {
+#pragma omp parallel for if (mUseInterpolation)
+  for (int i = 0; i < (int)entropy.size(); ++i) {
     entropy(i)=this->entropy(massDensity(i), specificThermalEnergy(i));
   }
 }
 
+//------------------------------------------------------------------------------
+// Set the thermodynamic state in a single pass.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ANEOS<Dimension>::
+setState(Field<Dimension, Scalar>* pressure,
+         Field<Dimension, Scalar>* soundSpeed,
+         Field<Dimension, Scalar>* temperature,
+         Field<Dimension, Scalar>* gamma,
+         Field<Dimension, Scalar>* bulkModulus,
+         const Field<Dimension, Scalar>& massDensity,
+         const Field<Dimension, Scalar>& specificThermalEnergy) const {
+
+  // Without the tables there's nothing to share between the quantities.
+  if (not mUseInterpolation) {
+    EquationOfState<Dimension>::setState(pressure, soundSpeed, temperature, gamma, bulkModulus, massDensity, specificThermalEnergy);
+    return;
+  }
+
+  // Otherwise we can do the table lookup once for all quantities.
+  const double dT = (mTmax - mTmin)/(mNumTvals - 1);
+  const int n = massDensity.size();
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoEpsLookup(massDensity(i), specificThermalEnergy(i), irho0, iT0, u, t);
+    if (pressure != nullptr)    (*pressure)(i) = this->applyPressureLimits(this->interpolate(mPvals, irho0, iT0, u, t) - mExternalPressure);
+    if (soundSpeed != nullptr)  (*soundSpeed)(i) = this->interpolate(mCSvals, irho0, iT0, u, t);
+    if (temperature != nullptr) (*temperature)(i) = mTmin + (iT0 + t)*dT;
+    if (bulkModulus != nullptr) (*bulkModulus)(i) = this->interpolate(mKvals, irho0, iT0, u, t);
+    if (gamma != nullptr) {
+      const double nDen = massDensity(i)/mAtomicWeight;
+      const double cvi = max(1.0e-1*mConstants.molarGasConstant()*nDen, this->interpolate(mCVvals, irho0, iT0, u, t));
+      (*gamma)(i) = 1.0 + mConstants.molarGasConstant()*nDen*safeInvVar(cvi);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Calculate an individual pressure.
 //------------------------------------------------------------------------------
@@ -285,13 +344,20 @@ ANEOS<Dimension>::
 pressure(const Scalar massDensity,
          const Scalar specificThermalEnergy) const {
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
-  rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
-  Ti = this->temperature(massDensity, specificThermalEnergy) / mTconv;
-  call_aneos_(const_cast<int*>(&mMaterialNumber), &Ti, &rhoi,
-              &Pi, &Ei, &Si, &CVi, &DPDTi, &DPDRi, &csi);
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoEpsLookup(massDensity, specificThermalEnergy, irho0, iT0, u, t);
+    Pi = this->interpolate(mPvals, irho0, iT0, u, t);
+  } else {
+    rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
+    Ti = this->temperature(massDensity, specificThermalEnergy) / mTconv;
+    call_aneos_(const_cast<int*>(&mMaterialNumber), &Ti, &rhoi,
+                &Pi, &Ei, &Si, &CVi, &DPDTi, &DPDRi, &csi);
+    Pi *= mPconv;
+  }
 
   // That's it.
-  Pi *= mPconv;
   return this->applyPressureLimits(Pi - mExternalPressure);
 }
 
@@ -306,28 +372,10 @@ typename Dimension::Scalar
 ANEOS<Dimension>::
 temperature(const Scalar massDensity,
             const Scalar specificThermalEnergy) const {
-  // const double logeps = log(specificThermalEnergy);
-  const double drho = (mRhoMax - mRhoMin)/(mNumRhoVals - 1);
   const double dT = (mTmax - mTmin)/(mNumTvals - 1);
-  const unsigned irho0 = min(mNumRhoVals - 2, unsigned(max(0.0, (massDensity - mRhoMin)/drho))),
-                 irho1 = irho0 + 1;
-  const_slice_type rho0_slice = mSTEvals[boost::indices[irho0][range(0, mNumTvals)]];
-  const unsigned iT0 = max(0, min(int(mNumTvals - 2), 
-                                  bisectSearch(rho0_slice.begin(), rho0_slice.end(), specificThermalEnergy))),
-                 iT1 = iT0 + 1;
-  const double u = max(0.0, min(1.0, (massDensity - mRhoMin - irho0*drho)/drho));
-  double num = specificThermalEnergy - (1.0 - u)*mSTEvals[irho0][iT0] - u*mSTEvals[irho0][iT1];
-  double den = (1.0 - u)*(mSTEvals[irho1][iT0] - mSTEvals[irho0][iT0]) + u*(mSTEvals[irho1][iT1] - mSTEvals[irho0][iT1]);
-  if (irho0 == 0 or irho1 == mNumRhoVals - 1 or iT0 == 0 or iT1 == mNumTvals - 1) num = 0.0;   // Avoid extrapolating off the T table.
-  CHECK(den != 0.0);
-  const double t = max(0.0, min(1.0, num*safeInv(den, 1.0e-100)));
-  // cerr << "Looking up temperature : " << massDensity << " " << specificThermalEnergy << endl
-  //      << "                         " << mRhoMin << " " << mRhoMax << " : " << mTmin << " " << mTmax << endl
-  //      << "                         " << irho0 << " " << iT0 << endl
-  //      << "                         " << mSTEvals[irho0][iT0] << " " << mSTEvals[irho0][iT1] << " " << mSTEvals[irho1][iT0] << " " << mSTEvals[irho1][iT1] << endl
-  //      << "                         " << u << " " << t << endl
-  //      << "                         " << num << " " << den << endl
-  //      << "                         " << mTmin + (iT0 + t)*dT << endl;
+  unsigned irho0, iT0;
+  double u, t;
+  this->rhoEpsLookup(massDensity, specificThermalEnergy, irho0, iT0, u, t);
   return mTmin + (iT0 + t)*dT;
 }
 
@@ -339,6 +387,12 @@ typename Dimension::Scalar
 ANEOS<Dimension>::
 specificThermalEnergy(const Scalar massDensity,
                       const Scalar temperature) const {
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoTlookup(massDensity, temperature, irho0, iT0, u, t);
+    return this->interpolate(mSTEvals, irho0, iT0, u, t);
+  }
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
   rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
   Ti = temperature / mTconv;
@@ -356,12 +410,20 @@ ANEOS<Dimension>::
 specificHeat(const Scalar massDensity,
              const Scalar temperature) const {
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
-  rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
-  Ti = max(mTmin, min(mTmax, temperature)) / mTconv;
-  call_aneos_(const_cast<int*>(&mMaterialNumber), &Ti, &rhoi,
-              &Pi, &Ei, &Si, &CVi, &DPDTi, &DPDRi, &csi);
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoTlookup(massDensity, temperature, irho0, iT0, u, t);
+    CVi = this->interpolate(mCVvals, irho0, iT0, u, t);
+  } else {
+    rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
+    Ti = max(mTmin, min(mTmax, temperature)) / mTconv;
+    call_aneos_(const_cast<int*>(&mMaterialNumber), &Ti, &rhoi,
+                &Pi, &Ei, &Si, &CVi, &DPDTi, &DPDRi, &csi);
+    CVi *= mCVconv;
+  }
   const auto nDen = massDensity/mAtomicWeight;
-  return max(1.0e-1*mConstants.molarGasConstant()*nDen, CVi * mCVconv);
+  return max(1.0e-1*mConstants.molarGasConstant()*nDen, CVi);
 }
 
 //------------------------------------------------------------------------------
@@ -372,6 +434,12 @@ typename Dimension::Scalar
 ANEOS<Dimension>::
 soundSpeed(const Scalar massDensity,
            const Scalar specificThermalEnergy) const {
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoEpsLookup(massDensity, specificThermalEnergy, irho0, iT0, u, t);
+    return this->interpolate(mCSvals, irho0, iT0, u, t);
+  }
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
   rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
   Ti = this->temperature(massDensity, specificThermalEnergy) / mTconv;
@@ -403,6 +471,12 @@ typename Dimension::Scalar
 ANEOS<Dimension>::
 bulkModulus(const Scalar massDensity,
             const Scalar specificThermalEnergy) const {
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoEpsLookup(massDensity, specificThermalEnergy, irho0, iT0, u, t);
+    return this->interpolate(mKvals, irho0, iT0, u, t);
+  }
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
   rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
   Ti = this->temperature(massDensity, specificThermalEnergy) / mTconv;
@@ -419,6 +493,12 @@ typename Dimension::Scalar
 ANEOS<Dimension>::
 entropy(const Scalar massDensity,
         const Scalar specificThermalEnergy) const {
+  if (mUseInterpolation) {
+    unsigned irho0, iT0;
+    double u, t;
+    this->rhoEpsLookup(massDensity, specificThermalEnergy, irho0, iT0, u, t);
+    return this->interpolate(mSvals, irho0, iT0, u, t);
+  }
   double Ti, rhoi, Pi, Ei, Si, CVi, DPDTi, DPDRi, csi;
   rhoi = max(mRhoMin, min(mRhoMax, massDensity)) / mRhoConv;
   Ti = this->temperature(massDensity, specificThermalEnergy) / mTconv;
@@ -516,6 +596,23 @@ externalPressure(const double x) {
   mExternalPressure = x;
 }
 
+//------------------------------------------------------------------------------
+// Use the interpolation tables?
+//------------------------------------------------------------------------------
+template<typename Dimension>
+bool
+ANEOS<Dimension>::
+useInterpolation() const {
+  return mUseInterpolation;
+}
+
+template<typename Dimension>
+void
+ANEOS<Dimension>::
+useInterpolation(const bool x) {
+  mUseInterpolation = x;
+}
+
 //------------------------------------------------------------------------------
 // Atomic weight.
 //------------------------------------------------------------------------------
@@ -526,5 +623,61 @@ atomicWeight() const {
   return mAtomicWeight;
 }
 
+//------------------------------------------------------------------------------
+// Find the table cell and weights for a (rho, T) point.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ANEOS<Dimension>::
+rhoTlookup(const Scalar massDensity,
+           const Scalar temperature,
+           unsigned& irho0, unsigned& iT0, double& u, double& t) const {
+  const double drho = (mRhoMax - mRhoMin)/(mNumRhoVals - 1);
+  const double dT = (mTmax - mTmin)/(mNumTvals - 1);
+  irho0 = min(mNumRhoVals - 2, unsigned(max(0.0, (massDensity - mRhoMin)/drho)));
+  iT0 = min(mNumTvals - 2, unsigned(max(0.0, (temperature - mTmin)/dT)));
+  u = max(0.0, min(1.0, (massDensity - mRhoMin - irho0*drho)/drho));
+  t = max(0.0, min(1.0, (temperature - mTmin - iT0*dT)/dT));
+}
+
+//------------------------------------------------------------------------------
+// Find the table cell and weights for a (rho, eps) point.
+// This is the inverse lookup of T in the table of eps(rho, T) described for
+// temperature.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+ANEOS<Dimension>::
+rhoEpsLookup(const Scalar massDensity,
+             const Scalar specificThermalEnergy,
+             unsigned& irho0, unsigned& iT0, double& u, double& t) const {
+  // const double logeps = log(specificThermalEnergy);
+  const double drho = (mRhoMax - mRhoMin)/(mNumRhoVals - 1);
+  irho0 = min(mNumRhoVals - 2, unsigned(max(0.0, (massDensity - mRhoMin)/drho)));
+  const unsigned irho1 = irho0 + 1;
+  const_slice_type rho0_slice = mSTEvals[boost::indices[irho0][range(0, mNumTvals)]];
+  iT0 = max(0, min(int(mNumTvals - 2), 
+                   bisectSearch(rho0_slice.begin(), rho0_slice.end(), specificThermalEnergy)));
+  const unsigned iT1 = iT0 + 1;
+  u = max(0.0, min(1.0, (massDensity - mRhoMin - irho0*drho)/drho));
+  double num = specificThermalEnergy - (1.0 - u)*mSTEvals[irho0][iT0] - u*mSTEvals[irho0][iT1];
+  double den = (1.0 - u)*(mSTEvals[irho1][iT0] - mSTEvals[irho0][iT0]) + u*(mSTEvals[irho1][iT1] - mSTEvals[irho0][iT1]);
+  if (irho0 == 0 or irho1 == mNumRhoVals - 1 or iT0 == 0 or iT1 == mNumTvals - 1) num = 0.0;   // Avoid extrapolating off the T table.
+  CHECK(den != 0.0);
+  t = max(0.0, min(1.0, num*safeInv(den, 1.0e-100)));
+}
+
+//------------------------------------------------------------------------------
+// Bilinear interpolation in a (rho, T) table.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+double
+ANEOS<Dimension>::
+interpolate(const array_type& table,
+            const unsigned irho0, const unsigned iT0, const double u, const double t) const {
+  REQUIRE(irho0 + 1 < mNumRhoVals and iT0 + 1 < mNumTvals);
+  return ((1.0 - u)*((1.0 - t)*table[irho0][iT0]     + t*table[irho0][iT0 + 1]) +
+                 u *((1.0 - t)*table[irho0 + 1][iT0] + t*table[irho0 + 1][iT0 + 1]));
 }
 
+}
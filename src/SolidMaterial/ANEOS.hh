@@ -82,6 +82,15 @@ public:
                           const Field<Dimension, Scalar>& massDensity,
                           const Field<Dimension, Scalar>& specificThermalEnergy) const;
 
+  // Compute the pressure, sound speed, etc. in a single pass.
+  virtual void setState(Field<Dimension, Scalar>* pressure,
+                        Field<Dimension, Scalar>* soundSpeed,
+                        Field<Dimension, Scalar>* temperature,
+                        Field<Dimension, Scalar>* gamma,
+                        Field<Dimension, Scalar>* bulkModulus,
+                        const Field<Dimension, Scalar>& massDensity,
+                        const Field<Dimension, Scalar>& specificThermalEnergy) const;
+
   // We also want the equivalent functions for individual calculations.
   Scalar pressure(const Scalar massDensity,
                   const Scalar specificThermalEnergy) const;
@@ -127,6 +136,12 @@ public:
   double externalPressure() const;
   void externalPressure(const double x);
 
+  // Optionally evaluate all quantities by bilinear interpolation in the
+  // (rho, T) tables built at construction, rather than calling ANEOS for
+  // each point.  This also allows the Field methods to be threaded.
+  bool useInterpolation() const;
+  void useInterpolation(const bool x);
+
   double atomicWeight() const;
 
 private:
@@ -137,6 +152,11 @@ private:
   double mRhoMin, mRhoMax, mTmin, mTmax, mExternalPressure;
   array_type mSTEvals;
 
+  // Tables of the remaining quantities on the same (rho, T) grid, used if
+  // mUseInterpolation is set.
+  bool mUseInterpolation;
+  array_type mPvals, mCSvals, mSvals, mCVvals, mKvals;
+
   // ANEOS internal units.
   PhysicalConstants mANEOSunits;
 
@@ -146,6 +166,19 @@ private:
   // Atomic weight.
   double mAtomicWeight;
 
+  // Find the (rho, T) table cell and interpolation weights for a point given
+  // either (rho, T) or (rho, eps).
+  void rhoTlookup(const Scalar massDensity,
+                  const Scalar temperature,
+                  unsigned& irho0, unsigned& iT0, double& u, double& t) const;
+  void rhoEpsLookup(const Scalar massDensity,
+                    const Scalar specificThermalEnergy,
+                    unsigned& irho0, unsigned& iT0, double& u, double& t) const;
+
+  // Bilinear interpolation in one of our tables.
+  double interpolate(const array_type& table,
+                     const unsigned irho0, const unsigned iT0, const double u, const double t) const;
+
   // Disallow default constructor
   ANEOS();
 
@@ -35,13 +35,13 @@ GruneisenEquationOfState(const double referenceDensity,
                          const double minimumPressure,
                          const double maximumPressure,
                          const MaterialPressureMinType minPressureType):
-  SolidEquationOfState<Dimension>(referenceDensity,
-                                  etamin,
-                                  min(etamax, max(0.99*S1/(S1 - 1.0), 2.0)),
-                                  constants,
-                                  minimumPressure,
-                                  maximumPressure,
-                                  minPressureType),
+  EquationOfStateByPoint<Dimension, GruneisenEquationOfState<Dimension>, SolidEquationOfState<Dimension>>(referenceDensity,
+                                                                                                          etamin,
+                                                                                                          min(etamax, max(0.99*S1/(S1 - 1.0), 2.0)),
+                                                                                                          constants,
+                                                                                                          minimumPressure,
+                                                                                                          maximumPressure,
+                                                                                                          minPressureType),
   mC0(C0),
   mS1(S1),
   mS2(S2),
@@ -9,6 +9,7 @@
 #define GruneisenEquationOfState_HH
 
 #include "SolidEquationOfState.hh"
+#include "Material/EquationOfStateByPoint.hh"
 
 #include <limits>
 
@@ -18,7 +19,7 @@ namespace Spheral {
 template<typename Dimension, typename DataType> class Field;
 
 template<typename Dimension>
-class GruneisenEquationOfState: public SolidEquationOfState<Dimension> { 
+class GruneisenEquationOfState: public EquationOfStateByPoint<Dimension, GruneisenEquationOfState<Dimension>, SolidEquationOfState<Dimension>> { 
 
 public:
   //--------------------------- Public Interface ---------------------------//
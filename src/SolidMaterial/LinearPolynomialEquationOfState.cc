@@ -41,13 +41,13 @@ LinearPolynomialEquationOfState(const double referenceDensity,
                                 const double minimumPressure,
                                 const double maximumPressure,
                                 const MaterialPressureMinType minPressureType):
-  SolidEquationOfState<Dimension>(referenceDensity,
-                                  etamin,
-                                  etamax,
-                                  constants,
-                                  minimumPressure,
-                                  maximumPressure,
-                                  minPressureType),
+  EquationOfStateByPoint<Dimension, LinearPolynomialEquationOfState<Dimension>, SolidEquationOfState<Dimension>>(referenceDensity,
+                                                                                                                 etamin,
+                                                                                                                 etamax,
+                                                                                                                 constants,
+                                                                                                                 minimumPressure,
+                                                                                                                 maximumPressure,
+                                                                                                                 minPressureType),
   mA0(a0),
   mA1(a1),
   mA2(a2),
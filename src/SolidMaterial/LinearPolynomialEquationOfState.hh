@@ -11,6 +11,7 @@
 #define LinearPolynomialEquationOfState_HH
 
 #include "SolidEquationOfState.hh"
+#include "Material/EquationOfStateByPoint.hh"
 
 #include <float.h>
 
@@ -20,7 +21,7 @@ namespace Spheral {
 template<typename Dimension, typename DataType> class Field;
 
 template<typename Dimension>
-class LinearPolynomialEquationOfState: public SolidEquationOfState<Dimension> {
+class LinearPolynomialEquationOfState: public EquationOfStateByPoint<Dimension, LinearPolynomialEquationOfState<Dimension>, SolidEquationOfState<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
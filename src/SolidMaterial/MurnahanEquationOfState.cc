@@ -32,13 +32,13 @@ MurnahanEquationOfState(const double referenceDensity,
                         const double minimumPressure,
                         const double maximumPressure,
                         const MaterialPressureMinType minPressureType):
-  SolidEquationOfState<Dimension>(referenceDensity,
-                                  etamin,
-                                  etamax,
-                                  constants,
-                                  minimumPressure,
-                                  maximumPressure,
-                                  minPressureType),
+  EquationOfStateByPoint<Dimension, MurnahanEquationOfState<Dimension>, SolidEquationOfState<Dimension>>(referenceDensity,
+                                                                                                         etamin,
+                                                                                                         etamax,
+                                                                                                         constants,
+                                                                                                         minimumPressure,
+                                                                                                         maximumPressure,
+                                                                                                         minPressureType),
   mn(n),
   mK(K),
   mAtomicWeight(atomicWeight),
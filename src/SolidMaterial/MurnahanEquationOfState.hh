@@ -11,11 +11,12 @@
 
 #include <float.h>
 #include "SolidEquationOfState.hh"
+#include "Material/EquationOfStateByPoint.hh"
 
 namespace Spheral {
 
 template<typename Dimension>
-class MurnahanEquationOfState: public SolidEquationOfState<Dimension> {
+class MurnahanEquationOfState: public EquationOfStateByPoint<Dimension, MurnahanEquationOfState<Dimension>, SolidEquationOfState<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
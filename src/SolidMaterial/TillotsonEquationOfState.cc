@@ -46,13 +46,13 @@ TillotsonEquationOfState(const double referenceDensity,
                          const double minimumPressure,
                          const double maximumPressure,
                          const MaterialPressureMinType minPressureType):
-  SolidEquationOfState<Dimension>(referenceDensity,
-                                  etamin,
-                                  etamax,
-                                  constants,
-                                  minimumPressure,
-                                  maximumPressure,
-                                  minPressureType),
+  EquationOfStateByPoint<Dimension, TillotsonEquationOfState<Dimension>, SolidEquationOfState<Dimension>>(referenceDensity,
+                                                                                                          etamin,
+                                                                                                          etamax,
+                                                                                                          constants,
+                                                                                                          minimumPressure,
+                                                                                                          maximumPressure,
+                                                                                                          minPressureType),
   mEtaMinSolid(etamin_solid),
   mEtaMaxSolid(etamax_solid),
   ma(a),
@@ -11,13 +11,14 @@
 #define TillotsonEquationOfState_HH
 
 #include "SolidEquationOfState.hh"
+#include "Material/EquationOfStateByPoint.hh"
 
 namespace Spheral {
 
 template<typename Dimension, typename DataType> class Field;
 
 template<typename Dimension>
-class TillotsonEquationOfState: public SolidEquationOfState<Dimension> {
+class TillotsonEquationOfState: public EquationOfStateByPoint<Dimension, TillotsonEquationOfState<Dimension>, SolidEquationOfState<Dimension>> {
 
 public:
   //--------------------------- Public Interface ---------------------------//
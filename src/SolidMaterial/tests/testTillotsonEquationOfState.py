@@ -251,6 +251,40 @@ class TestTillotsonEquationOfState(unittest.TestCase):
                                  eta, mu, phi))
         return
 
+    #===========================================================================
+    # setState against the individual set methods
+    #===========================================================================
+    def testSetState(self):
+        n = self.nsample*self.nsample
+        nodes = makeFluidNodeList("setState nodes", self.eos, numInternal=n)
+        rhof = ScalarField("rho", nodes)
+        epsf = ScalarField("eps", nodes)
+        for irho in xrange(self.nsample):
+            for ieps in xrange(self.nsample):
+                rhof[irho*self.nsample + ieps] = self.rho(irho)
+                epsf[irho*self.nsample + ieps] = self.eps(ieps)
+        names = ("pressure", "sound speed", "temperature", "gamma", "bulk modulus")
+        setters = (self.eos.setPressure, self.eos.setSoundSpeed, self.eos.setTemperature,
+                   self.eos.setGammaField, self.eos.setBulkModulus)
+        answers = [ScalarField(name, nodes) for name in names]
+        for setter, ans in zip(setters, answers):
+            setter(ans, rhof, epsf)
+        values = [ScalarField(name + " (setState)", nodes) for name in names]
+        self.eos.setState(values[0], values[1], values[2], values[3], values[4], rhof, epsf)
+        for name, x, ans in zip(names, values, answers):
+            for i in xrange(n):
+                self.failUnless(x[i] == ans[i],
+                                "setState %s does not match:  %g != %g" % (name, x[i], ans[i]))
+
+        # The outputs passed as None are skipped.
+        Pf = ScalarField("pressure (partial)", nodes)
+        csf = ScalarField("sound speed (partial)", nodes)
+        self.eos.setState(Pf, csf, None, None, None, rhof, epsf)
+        for i in xrange(n):
+            self.failUnless(Pf[i] == answers[0][i] and csf[i] == answers[1][i],
+                            "Partial setState does not match:  (%g, %g) != (%g, %g)" % (Pf[i], csf[i], answers[0][i], answers[1][i]))
+        return
+
     #===========================================================================
     # dPdrho
     #===========================================================================
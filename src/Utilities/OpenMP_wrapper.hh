@@ -9,7 +9,9 @@
 #else
 inline int  omp_get_num_threads() { return 1; }
 inline int  omp_get_thread_num()  { return 0; }
-inline void omp_set_num_threads() {}
+inline int  omp_get_max_threads() { return 1; }
+inline int  omp_in_parallel()     { return 0; }
+inline void omp_set_num_threads(int) {}
 #endif
 
 #include "boost/variant.hpp"
@@ -42,6 +44,17 @@ enum class ThreadReduction {
   SUM = 2
 };
 
+//------------------------------------------------------------------------------
+// How thread-local contributions are accumulated and merged in pair loops.
+//   FullCopy     : each thread accumulates into a full copy of the Fields.
+//   TouchedRange : each thread only allocates the range of nodes touched by its
+//                  block of pairs (see Neighbor/PairThreadReduction.hh).
+//------------------------------------------------------------------------------
+enum class ThreadReductionMethod {
+  FullCopy = 0,
+  TouchedRange = 1
+};
+
 // Put the helpers for threadReduceFields in an enclosing struct
 template<typename Dimension>
 struct SpheralThreads {
@@ -10,6 +10,8 @@
 
 #include "Utilities/DataTypeTraits.hh"
 
+#include <vector>
+
 #ifdef USE_MPI
 //------------------------------------------------------------------------------
 // MPI version
@@ -28,6 +30,16 @@ allReduce(const Value& value, const MPI_Op op, const MPI_Comm comm) {
   return result;
 }
 
+// Element by element reduction of a vector (the same length on all processes).
+template<typename Value>
+std::vector<Value>
+allReduce(const std::vector<Value>& value, const MPI_Op op, const MPI_Comm comm) {
+  std::vector<Value> tmp = value;
+  std::vector<Value> result(value.size());
+  if (not value.empty()) MPI_Allreduce(&tmp.front(), &result.front(), value.size(), DataTypeTraits<Value>::MpiDataType(), op, comm);
+  return result;
+}
+
 }
 
 #else
@@ -70,7 +70,7 @@ computeShepardsInterpolation(const FieldList<Dimension, DataType>& fieldList,
       for (nodeListj = 0; nodeListj != numNodeLists; ++nodeListj) {
         const auto& connectivity = fullConnectivity[nodeListj];
         const int firstGhostNodej = fieldList[nodeListi]->nodeList().firstGhostNode();
-        for (vector<int>::const_iterator jItr = connectivity.begin();
+        for (auto jItr = connectivity.begin();
              jItr != connectivity.end();
              ++jItr) {
           const int j = *jItr;
@@ -13,6 +13,7 @@
 #include "DataBase/DataBase.hh"
 #include "Field/FieldList.hh"
 #include "Utilities/DBC.hh"
+#include "Utilities/OpenMP_wrapper.hh"
 
 using std::vector;
 using std::string;
@@ -129,15 +130,18 @@ mortonOrderIndices(const FieldList<Dimension, typename Dimension::Vector>& posit
   const Vector stepSize = (xmax - xmin)/KeyTraits::maxKey1d;
 
   // Go over all nodes.
-  for (AllNodeIterator<Dimension> nodeItr = positions.nodeBegin();
-       nodeItr != positions.nodeEnd();
-       ++nodeItr) {
+  const auto numNodeLists = positions.numFields();
+  for (auto nodeListi = 0u; nodeListi < numNodeLists; ++nodeListi) {
+    const auto n = positions[nodeListi]->numElements();
+#pragma omp parallel for
+    for (auto i = 0u; i < n; ++i) {
 
-    // Find the offset from the minimum coordinates.
-    const Vector xoff = positions(nodeItr) - xmin;
+      // Find the offset from the minimum coordinates.
+      const Vector xoff = positions(nodeListi, i) - xmin;
 
-    // Hash that sucker.
-    result(nodeItr) = hashPosition(xoff, stepSize);
+      // Hash that sucker.
+      result(nodeListi, i) = hashPosition(xoff, stepSize);
+    }
   }
 
   return result;
@@ -206,12 +206,14 @@ overlayRemapFields(const vector<Boundary<Dimension>*>& boundaries,
     for (auto i = 0u; i != donorN; ++i) unpackElement(donorH[i], bufItr, buffer.end());
     CHECK(bufItr == buffer.end());
 
+    // Find the potential acceptor neighbors for all the donors at once.
+    vector<size_t> Aoffsets;
+    vector<int> Arefine;
+    neighborA.setBatchNeighborLists(donorPos, donorH, Aoffsets, Arefine);
+
     for (unsigned i = 0; i != donorN; ++i) {
-      vector<int> Amasters, Acoarse, Arefine;
-      neighborA.setMasterList(donorPos[i], donorH[i], Amasters, Acoarse);
-      neighborA.setRefineNeighborList(donorPos[i], donorH[i], Acoarse, Arefine);
-      for (auto jitr = Arefine.begin(); jitr < Arefine.end(); ++jitr) {
-        const int j = *jitr;
+      for (auto k = Aoffsets[i]; k < Aoffsets[i + 1]; ++k) {
+        const int j = Arefine[k];
         if (donorCells[i].intersect(localAcceptorCells(j))) {
           const vector<Facet>& facets = localAcceptorCells(j).facets();
           vector<Plane> planes;
@@ -353,12 +355,14 @@ overlayRemapFields(const vector<Boundary<Dimension>*>& boundaries,
   // Look for intersecting node volumes.
   Field<Dimension, vector<unsigned>> intersectIndices("intersection indices", *donorNodeListPtr);
   Field<Dimension, vector<Scalar>> intersectVols("intesection volumes", *donorNodeListPtr);
+  vector<size_t> Aoffsets;
+  vector<int> Arefine;
+  neighborA.setBatchNeighborLists(vector<Vector>(posD.begin(), posD.begin() + nD),
+                                  vector<SymTensor>(HD.begin(), HD.begin() + nD),
+                                  Aoffsets, Arefine);
   for (unsigned i = 0; i != nD; ++i) {
-    vector<int> Amasters, Acoarse, Arefine;
-    neighborA.setMasterList(posD(i), HD(i), Amasters, Acoarse);
-    neighborA.setRefineNeighborList(posD(i), HD(i), Acoarse, Arefine);
-    for (auto jitr = Arefine.begin(); jitr < Arefine.end(); ++jitr) {
-      const int j = *jitr;
+    for (auto k = Aoffsets[i]; k < Aoffsets[i + 1]; ++k) {
+      const int j = Arefine[k];
       if (localDonorCells(i).intersect(localAcceptorCells(j))) {
         const vector<Facet>& facets = localAcceptorCells(j).facets();
         vector<Plane> planes;
@@ -274,7 +274,9 @@ void
 packElement(const RKCoefficients<Dimension>& value,
             std::vector<char>& buffer) {
   packElement(value.correctionOrder, buffer);
-  packElement(value.coeffs, buffer);
+  const unsigned size = value.size();
+  packElement(size, buffer);
+  for (const auto x: value) packElement(x, buffer);
 }
 
 //------------------------------------------------------------------------------
@@ -569,7 +571,12 @@ unpackElement(RKCoefficients<Dimension>& value,
               std::vector<char>::const_iterator& itr,
               const std::vector<char>::const_iterator& endPackedVector) {
   unpackElement(value.correctionOrder, itr, endPackedVector);
-  unpackElement(value.coeffs, itr, endPackedVector);
+  unsigned int size;
+  unpackElement(size, itr, endPackedVector);
+  CHECK2(size <= std::distance(itr, endPackedVector),
+         "Crazy buffer size:  " << size << " " << std::distance(itr, endPackedVector));
+  value.resize(size);
+  for (auto& x: value) unpackElement(x, itr, endPackedVector);
   ENSURE(itr <= endPackedVector);
 }
 
@@ -0,0 +1,102 @@
+//---------------------------------Spheral++----------------------------------//
+// reorderNodesBySpaceFillingCurve
+//
+// Reorder the internal nodes of every NodeList in a DataBase in place along a
+// space filling curve.
+//----------------------------------------------------------------------------//
+#include "reorderNodesBySpaceFillingCurve.hh"
+#include "peanoHilbertOrderIndices.hh"
+#include "mortonOrderIndices.hh"
+#include "RedistributionRegistrar.hh"
+#include "DataBase/DataBase.hh"
+#include "Field/FieldList.hh"
+#include "NodeList/NodeList.hh"
+#include "Neighbor/Neighbor.hh"
+#include "Neighbor/ConnectivityMap.hh"
+#include "Utilities/allReduce.hh"
+#include "Distributed/Communicator.hh"
+#include "Utilities/OpenMP_wrapper.hh"
+#include "Utilities/DBC.hh"
+
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+
+using std::vector;
+using std::pair;
+using std::make_pair;
+
+namespace Spheral {
+
+//------------------------------------------------------------------------------
+// Reorder the nodes.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+void
+reorderNodesBySpaceFillingCurve(DataBase<Dimension>& dataBase,
+                                const bool usePeanoHilbert) {
+
+  typedef typename KeyTraits::Key Key;
+
+  // Let everyone know the nodes are about to be shuffled.
+  RedistributionRegistrar::instance().preRedistributionNotifications();
+
+  // Get rid of the ghost nodes, so the keys only cover internal nodes.
+  for (auto nodeListPtr: dataBase.nodeListPtrs()) {
+    nodeListPtr->numGhostNodes(0);
+    nodeListPtr->neighbor().updateNodes();
+  }
+
+  // Compute the curve keys.
+  const auto keys = (usePeanoHilbert ?
+                     peanoHilbertOrderIndices(dataBase) :
+                     mortonOrderIndices(dataBase));
+
+  // Sort the nodes in each NodeList by their keys, breaking ties by the current
+  // index so the ordering is reproducible, and apply the new order.
+  auto nodeListi = 0u;
+  for (auto nodeListPtr: dataBase.nodeListPtrs()) {
+    const auto n = nodeListPtr->numInternalNodes();
+    const auto& keyField = *keys[nodeListi++];
+    vector<pair<Key, int>> orderedKeys(n);
+#pragma omp parallel for
+    for (auto i = 0u; i < n; ++i) orderedKeys[i] = make_pair(keyField(i), i);
+    std::sort(orderedKeys.begin(), orderedKeys.end());
+    vector<int> ordering(n);
+#pragma omp parallel for
+    for (auto i = 0u; i < n; ++i) ordering[orderedKeys[i].second] = i;
+    nodeListPtr->reorderNodes(ordering);
+    nodeListPtr->neighbor().updateNodes();
+  }
+
+  // Notify everyone that the nodes have just been shuffled around.
+  RedistributionRegistrar::instance().broadcastRedistributionNotifications();
+}
+
+//------------------------------------------------------------------------------
+// The fraction of the intra-NodeList node pairs that are further apart in
+// memory than the given window.
+//------------------------------------------------------------------------------
+template<typename Dimension>
+double
+nonlocalNodePairFraction(const ConnectivityMap<Dimension>& connectivityMap,
+                         const unsigned window) {
+  const auto& pairs = connectivityMap.nodePairList();
+  const auto npairs = pairs.size();
+  const int iwindow = window;
+  size_t nsame = 0u, nfar = 0u;
+#pragma omp parallel for reduction(+:nsame, nfar)
+  for (size_t k = 0u; k < npairs; ++k) {
+    const auto& nodePair = pairs[k];
+    if (nodePair.i_list == nodePair.j_list) {
+      ++nsame;
+      if (std::abs(nodePair.i_node - nodePair.j_node) > iwindow) ++nfar;
+    }
+  }
+  const double ntot = allReduce(double(nsame), MPI_SUM, Communicator::communicator());
+  const double nnonlocal = allReduce(double(nfar), MPI_SUM, Communicator::communicator());
+  return (ntot > 0.0 ? nnonlocal/ntot : 0.0);
+}
+
+}
@@ -0,0 +1,43 @@
+//---------------------------------Spheral++----------------------------------//
+// reorderNodesBySpaceFillingCurve
+//
+// Reorder the internal nodes of every NodeList in a DataBase in place along a
+// space filling curve (Peano-Hilbert or Morton), so that nodes near each other
+// in space are also near each other in memory.  As nodes move over the course
+// of a run their storage order drifts away from the spatial order, and the
+// node pair loops degrade into random access over the Field arrays; calling
+// this periodically restores the locality.
+//
+// This is a local operation (no nodes change domains), but the keys are
+// computed over the global bounding box so all processes must call it
+// together.  Like the redistribution methods it removes the ghost nodes and
+// notifies everything registered with the RedistributionRegistrar, so the
+// caller must rebuild the ghost nodes and connectivity afterward.
+//
+// nonlocalNodePairFraction provides a cheap proxy for the cache behavior of
+// the current ordering: the fraction of the node pairs in a ConnectivityMap
+// (between nodes in the same NodeList) whose indices are more than window
+// apart.
+//----------------------------------------------------------------------------//
+#ifndef __Spheral_reorderNodesBySpaceFillingCurve__
+#define __Spheral_reorderNodesBySpaceFillingCurve__
+
+namespace Spheral {
+
+// Forward declarations.
+template<typename Dimension> class DataBase;
+template<typename Dimension> class ConnectivityMap;
+
+template<typename Dimension>
+void
+reorderNodesBySpaceFillingCurve(DataBase<Dimension>& dataBase,
+                                const bool usePeanoHilbert = true);
+
+template<typename Dimension>
+double
+nonlocalNodePairFraction(const ConnectivityMap<Dimension>& connectivityMap,
+                         const unsigned window = 256u);
+
+}
+
+#endif
@@ -0,0 +1,12 @@
+text = """
+//------------------------------------------------------------------------------
+// Explicit instantiation.
+//------------------------------------------------------------------------------
+#include "Utilities/reorderNodesBySpaceFillingCurve.cc"
+#include "Geometry/Dimension.hh"
+
+namespace Spheral {
+  template void reorderNodesBySpaceFillingCurve<Dim< %(ndim)s > >(DataBase<Dim< %(ndim)s > >&, const bool);
+  template double nonlocalNodePairFraction<Dim< %(ndim)s > >(const ConnectivityMap<Dim< %(ndim)s > >&, const unsigned);
+}
+"""
@@ -0,0 +1,146 @@
+#ATS:for dimension in (2, 3):
+#ATS:    test(SELF, "--dimension %i" % dimension, label="reorder nodes by space filling curve -- %id (serial)" % dimension)
+#-------------------------------------------------------------------------------
+# reorderNodesBySpaceFillingCurve shuffles the internal nodes of each NodeList
+# in place.  Check every Field registered in the hydro State is permuted
+# consistently, and that the SPH derivatives evaluated after the reordering
+# match those from before it once mapped back to the original order.
+#-------------------------------------------------------------------------------
+import sys
+from math import sqrt
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("Reorder nodes by space filling curve")
+
+commandLine(
+    dimension = 2,
+    nx2d = 20,
+    nx3d = 8,
+    x0 = 0.0,
+    x1 = 1.0,
+    nPerh = 2.01,
+    ranfrac = 0.2,
+    vfrac = 0.1,
+    seed = 4598721,
+    usePeanoHilbert = True,
+
+    tolerance = 1.0e-10,
+)
+
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+sys.path.append("../../Neighbor/tests")
+from NeighborTestBase import TwoNodeListLattice
+nx = {2 : nx2d, 3 : nx3d}[dimension]
+lattice = TwoNodeListLattice("testReorderNodesBySpaceFillingCurve", dimension, nx, x0, x1, nPerh, ranfrac, rangen)
+sph = lattice.sph
+nodeSet = lattice.nodeSet
+for nodes, eps0 in zip(nodeSet, (1.0, 2.0)):
+    eps = nodes.specificThermalEnergy()
+    vel = nodes.velocity()
+    for i in xrange(nodes.numInternalNodes):
+        eps[i] = eps0*(1.0 + 0.1*rangen.uniform(-1.0, 1.0))
+        for j in xrange(dimension):
+            vel[i][j] = vfrac*rangen.uniform(-1.0, 1.0)
+
+# Label each node with its original index.
+ids = []
+for nodes in nodeSet:
+    ids.append(sph.IntField("original index", nodes))
+    for i in xrange(nodes.numInternalNodes):
+        ids[-1][i] = i
+
+db = lattice.dataBase()
+hydro, integrator = lattice.integrator(db)
+integrator.initializeProblemStartup(db)
+
+#-------------------------------------------------------------------------------
+# Helpers.
+#-------------------------------------------------------------------------------
+# The internal values of every registered Field we can get at by type, by name.
+def stateValues(state):
+    result = {}
+    for name in state.fieldKeys():
+        for accessor in (state.intFields, state.scalarFields, state.vectorFields, state.tensorFields, state.symTensorFields):
+            try:
+                fl = accessor(name)
+            except:
+                continue
+            if len(fl) == len(nodeSet):
+                result[name] = [list(fl[k].internalValues()) for k in xrange(len(nodeSet))]
+                break
+    return result
+
+def derivativeValues(state, derivs):
+    integrator.setGhostNodes()
+    derivs.Zero()
+    integrator.preStepInitialize(state, derivs)
+    integrator.initializeDerivatives(0.0, 1.0, state, derivs)
+    integrator.evaluateDerivatives(0.0, 1.0, db, state, derivs)
+    integrator.finalizeDerivatives(0.0, 1.0, db, state, derivs)
+    result = {}
+    for name, fl in (("DvDt",   derivs.vectorFields(HydroFieldNames.hydroAcceleration)),
+                     ("DepsDt", derivs.scalarFields("delta " + HydroFieldNames.specificThermalEnergy)),
+                     ("DvDx",   derivs.tensorFields(HydroFieldNames.velocityGradient)),
+                     ("Hideal", derivs.symTensorFields("new " + HydroFieldNames.H))):
+        result[name] = [list(fl[k].internalValues()) for k in xrange(len(nodeSet))]
+    return result
+
+def magnitude(x):
+    if isinstance(x, (int, float)):
+        return abs(x)
+    elif hasattr(x, "selfDoubledot"):
+        return sqrt(x.selfDoubledot())
+    else:
+        return x.magnitude()
+
+#-------------------------------------------------------------------------------
+# Evaluate the derivatives, reorder, and evaluate them again.
+#-------------------------------------------------------------------------------
+state = sph.State(db, integrator.physicsPackages())
+derivs = sph.StateDerivatives(db, integrator.physicsPackages())
+derivs0 = derivativeValues(state, derivs)
+values0 = stateValues(state)
+print "Checking the registered Fields: %s" % sorted(values0.keys())
+
+sph.reorderNodesBySpaceFillingCurve(db, usePeanoHilbert)
+db.reinitializeNeighbors()
+
+# Each node's original index.
+ordering = [list(ids[k].internalValues()) for k in xrange(len(nodeSet))]
+for k, nodes in enumerate(nodeSet):
+    if sorted(ordering[k]) != range(nodes.numInternalNodes):
+        raise ValueError, "The original indices of %s are not a permutation" % nodes.name
+    if ordering[k] == range(nodes.numInternalNodes):
+        raise ValueError, "Reordering did not change the order of %s" % nodes.name
+
+# Every Field should have been permuted the same way.
+values1 = stateValues(state)
+assert sorted(values1.keys()) == sorted(values0.keys())
+for name in values0:
+    for k in xrange(len(nodeSet)):
+        for i, i0 in enumerate(ordering[k]):
+            if values1[name][k][i] != values0[name][k][i0]:
+                raise ValueError, "Field %s value for node %i of %s not permuted with the nodes: %s != %s" % (name, i, nodeSet[k].name, values1[name][k][i], values0[name][k][i0])
+
+# The derivatives should be unchanged up to the permutation (and round off).
+state = sph.State(db, integrator.physicsPackages())
+derivs = sph.StateDerivatives(db, integrator.physicsPackages())
+derivs1 = derivativeValues(state, derivs)
+failures = []
+for name in derivs0:
+    scale = max([max([magnitude(x) for x in vals] + [0.0]) for vals in derivs0[name]] + [1.0e-50])
+    diff = 0.0
+    for k in xrange(len(nodeSet)):
+        for i, i0 in enumerate(ordering[k]):
+            diff = max(diff, magnitude(derivs1[name][k][i] - derivs0[name][k][i0]))
+    print "%8s : max relative difference %g" % (name, diff/scale)
+    if diff > tolerance*scale:
+        failures.append((name, diff/scale))
+
+if failures:
+    raise ValueError, "Derivatives changed by reordering the nodes: %s" % failures
+print "PASS"
@@ -0,0 +1,13 @@
+#-------------------------------------------------------------------------------
+# Exercise the C++ unit test of RKCoefficients (the inline/heap coefficient
+# storage, packing, and RKUtilities::applyTransformation).
+#-------------------------------------------------------------------------------
+#ATS:test(SELF, "", label="RKCoefficients unit tests.")
+import CXXTests
+
+for ndim in (1, 2, 3):
+    for seed in xrange(1, 6):
+        result = eval("CXXTests.testRKCoefficients%id(%i)" % (ndim, seed))
+        print "Testing testRKCoefficients%id(%i) : %s" % (ndim, seed, result)
+        assert result == "OK"
+print "PASS"
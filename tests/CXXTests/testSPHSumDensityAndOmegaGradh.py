@@ -0,0 +1,71 @@
+#-------------------------------------------------------------------------------
+# Exercise the C++ unit test comparing the fused SPH sum density and grad h
+# correction pass against the separate passes, with and without the pair
+# geometry cache.
+#-------------------------------------------------------------------------------
+#ATS:test(SELF, "", label="Fused SPH sum density and grad h unit tests.")
+import random
+import CXXTests
+
+rangen = random.Random()
+rangen.seed(48912734)
+
+nx = {1 : 100, 2 : 20, 3 : 8}
+nPerh = 2.01
+ranfrac = 0.2
+
+for ndim in (1, 2, 3):
+    exec("from Spheral%id import *" % ndim)
+    WT = TableKernel(BSplineKernel(), 1000)
+    eos = GammaLawGasMKS(5.0/3.0, 1.0)
+    nodes1 = makeFluidNodeList("nodes1 %id" % ndim, eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+    nodes2 = makeFluidNodeList("nodes2 %id" % ndim, eos, nPerh = nPerh, kernelExtent = WT.kernelExtent)
+
+    # Two NodeLists of different densities side by side, so the pairs cross
+    # NodeLists and the smoothing scales differ.
+    if ndim == 1:
+        from DistributeNodes import distributeNodesInRange1d
+        distributeNodesInRange1d([(nodes1, nx[1], 1.0, (0.0, 0.5)),
+                                  (nodes2, nx[1]/2, 0.5, (0.5, 1.0))], nPerh = nPerh)
+    elif ndim == 2:
+        from GenerateNodeDistribution2d import GenerateNodeDistribution2d
+        from DistributeNodes import distributeNodes2d
+        gen1 = GenerateNodeDistribution2d(nx[2], 2*nx[2], 1.0, "lattice",
+                                          xmin = (0.0, 0.0),
+                                          xmax = (0.5, 1.0),
+                                          nNodePerh = nPerh)
+        gen2 = GenerateNodeDistribution2d(nx[2]/2, nx[2], 0.5, "lattice",
+                                          xmin = (0.5, 0.0),
+                                          xmax = (1.0, 1.0),
+                                          nNodePerh = nPerh)
+        distributeNodes2d((nodes1, gen1), (nodes2, gen2))
+    else:
+        from GenerateNodeDistribution3d import GenerateNodeDistribution3d
+        from DistributeNodes import distributeNodes3d
+        gen1 = GenerateNodeDistribution3d(nx[3], 2*nx[3], 2*nx[3], 1.0, "lattice",
+                                          xmin = (0.0, 0.0, 0.0),
+                                          xmax = (0.5, 1.0, 1.0),
+                                          nNodePerh = nPerh)
+        gen2 = GenerateNodeDistribution3d(nx[3]/2, nx[3], nx[3], 0.5, "lattice",
+                                          xmin = (0.5, 0.0, 0.0),
+                                          xmax = (1.0, 1.0, 1.0),
+                                          nNodePerh = nPerh)
+        distributeNodes3d((nodes1, gen1), (nodes2, gen2))
+
+    # Jitter the positions so the pairs aren't all equivalent.
+    for nodes in (nodes1, nodes2):
+        dx = 1.0/nx[ndim]
+        pos = nodes.positions()
+        for i in xrange(nodes.numInternalNodes):
+            for j in xrange(ndim):
+                pos[i][j] += ranfrac*dx*rangen.uniform(-1.0, 1.0)
+
+    db = DataBase()
+    db.appendNodeList(nodes1)
+    db.appendNodeList(nodes2)
+    db.updateConnectivityMap(False)
+
+    result = CXXTests.testSPHSumDensityAndOmegaGradh(db, WT, 1.0e-10)
+    print "Testing testSPHSumDensityAndOmegaGradh (%id) : %s" % (ndim, result)
+    assert result == "OK"
+print "PASS"
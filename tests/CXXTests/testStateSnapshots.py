@@ -0,0 +1,16 @@
+#-------------------------------------------------------------------------------
+# Exercise the C++ unit test of the State snapshots (copyState with a snapshot
+# pool, swapState, and Field::swapValues).
+#-------------------------------------------------------------------------------
+#ATS:test(SELF, "", label="State snapshot unit tests.")
+import CXXTests
+
+for ndim in (1, 2, 3):
+    exec("from Spheral%id import *" % ndim)
+    eos = GammaLawGasMKS(5.0/3.0, 1.0)
+    nodes = makeFluidNodeList("nodes %id" % ndim, eos, numInternal=20)
+    result = CXXTests.testStateSnapshots(nodes)
+    print "Testing testStateSnapshots (%id) : %s" % (ndim, result)
+    assert result == "OK"
+    del nodes
+print "PASS"
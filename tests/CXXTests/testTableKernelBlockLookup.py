@@ -0,0 +1,17 @@
+#-------------------------------------------------------------------------------
+# Exercise the C++ unit test comparing the block TableKernel lookups against
+# the scalar lookups.
+#-------------------------------------------------------------------------------
+#ATS:test(SELF, "", label="TableKernel block lookup unit tests.")
+import CXXTests
+
+for ndim in (1, 2, 3):
+    exec("from Spheral%id import *" % ndim)
+    for W in (TableKernel(BSplineKernel(), 1000),
+              TableKernel(WendlandC4Kernel(), 200),
+              TableKernel(NBSplineKernel(5), 1000)):
+        for seed in xrange(1, 4):
+            result = CXXTests.testTableKernelBlockLookup(W, 10000, seed)
+            print "Testing testTableKernelBlockLookup (%id, seed %i) : %s" % (ndim, seed, result)
+            assert result == "OK"
+print "PASS"
@@ -0,0 +1,135 @@
+#ATS:for ndim in (2, 3):
+#ATS:    test(SELF, "--ndim %i" % ndim, np=1, label="TreeGravity accuracy against a direct sum -- %id (serial)" % ndim)
+#ATS:    test(SELF, "--ndim %i" % ndim, np=4, label="TreeGravity accuracy against a direct sum -- %id (4 proc)" % ndim)
+#-------------------------------------------------------------------------------
+# Compare the TreeGravity accelerations (the quadrupole dual tree walk, and in
+# parallel the exchange of the locally essential trees between domains) with a
+# direct sum over all the points.  The far field error of the expansions
+# scales as opening^2, so the tolerances do as well.
+#-------------------------------------------------------------------------------
+from math import *
+from SpheralTestUtilities import *
+import mpi
+
+title("TreeGravity accuracy")
+
+commandLine(
+    ndim = 3,
+    n = 800,                    # Total number of points (over all domains)
+    G = 1.0,
+    softeningLength = 1.0e-5,
+    seed = 4928731,
+
+    # The opening angles to test, and the tolerances (as multiples of
+    # opening^2) on the errors relative to the RMS acceleration.
+    openings = "0.3,0.5,0.7",
+    maxErrorFactor = 1.0,
+    rmsErrorFactor = 0.1,
+)
+
+assert ndim in (2, 3)
+exec("from Spheral%id import *" % ndim)
+if ndim == 2:
+    TreeGravityType = QuadTreeGravity
+else:
+    TreeGravityType = OctTreeGravity
+
+#-------------------------------------------------------------------------------
+# Every domain generates the same points (so each can compute the direct sum),
+# and keeps a round robin subset of them.  The points are a centrally
+# concentrated cluster plus a pair of compact clumps, so the tree is unbalanced
+# and the walk sees a range of cell sizes.
+#-------------------------------------------------------------------------------
+import random
+rangen = random.Random()
+rangen.seed(seed)
+
+def randomPoint(center, radius):
+    while True:
+        nhat = [rangen.gauss(0.0, 1.0) for j in xrange(ndim)]
+        nmag = sqrt(sum([x*x for x in nhat]))
+        if nmag > 0.0:
+            break
+    r = radius*sqrt(rangen.uniform(0.0, 1.0))
+    return [center[j] + r*nhat[j]/nmag for j in xrange(ndim)]
+
+clumps = [([0.0]*ndim, 1.0, 0.7),
+          ([0.8] + [0.3]*(ndim - 1), 0.1, 0.2),
+          ([-0.5] + [-0.9]*(ndim - 1), 0.05, 0.1)]
+allPositions, allMasses = [], []
+for center, radius, frac in clumps:
+    for k in xrange(int(frac*n + 0.5)):
+        allPositions.append(randomPoint(center, radius))
+        allMasses.append(rangen.uniform(0.5, 1.5)/n)
+ntot = len(allPositions)
+
+localIDs = range(mpi.rank, ntot, mpi.procs)
+nodes = makeVoidNodeList("nodes", numInternal = len(localIDs))
+pos = nodes.positions()
+mass = nodes.mass()
+for i, k in enumerate(localIDs):
+    pos[i] = Vector(*allPositions[k])
+    mass[i] = allMasses[k]
+assert mpi.allreduce(nodes.numInternalNodes, mpi.SUM) == ntot
+
+db = DataBase()
+db.appendNodeList(nodes)
+
+#-------------------------------------------------------------------------------
+# The direct sum, using the same softened force law as the tree's direct
+# (leaf-leaf) interactions.
+#-------------------------------------------------------------------------------
+eps2 = softeningLength**2
+def directAcceleration(k):
+    xi = allPositions[k]
+    result = [0.0]*ndim
+    for kk in xrange(ntot):
+        if kk != k:
+            d = [allPositions[kk][j] - xi[j] for j in xrange(ndim)]
+            r2 = sum([x*x for x in d])
+            r = sqrt(r2)
+            if ndim == 2:
+                f = G*allMasses[kk]/sqrt(r2 + eps2)/r
+            else:
+                f = G*allMasses[kk]/(r2 + eps2)/r
+            for j in xrange(ndim):
+                result[j] += f*d[j]
+    return Vector(*result)
+
+print "Computing the direct sum for %i points." % ntot
+adirect = [directAcceleration(k) for k in localIDs]
+armsDirect = sqrt(mpi.allreduce(sum([a.magnitude2() for a in adirect]), mpi.SUM)/ntot)
+print "RMS acceleration: ", armsDirect
+
+#-------------------------------------------------------------------------------
+# Evaluate the tree accelerations for each opening angle.
+#-------------------------------------------------------------------------------
+failures = []
+for opening in [float(x) for x in openings.split(",")]:
+    gravity = TreeGravityType(G = G,
+                              softeningLength = softeningLength,
+                              opening = opening,
+                              ftimestep = 0.1,
+                              timeStepChoice = AccelerationRatio)
+    integrator = CheapSynchronousRK2Integrator(db)
+    integrator.appendPhysicsPackage(gravity)
+    integrator.initializeProblemStartup(db)
+    state = State(db, integrator.physicsPackages())
+    derivs = StateDerivatives(db, integrator.physicsPackages())
+    derivs.Zero()
+    gravity.initialize(0.0, 1.0, db, state, derivs)
+    gravity.evaluateDerivatives(0.0, 1.0, db, state, derivs)
+    DvDt = derivs.vectorFields("delta " + HydroFieldNames.velocity)[0]
+
+    errs = [(DvDt[i] - adirect[i]).magnitude()/armsDirect for i in xrange(nodes.numInternalNodes)]
+    maxErr = mpi.allreduce(max(errs + [0.0]), mpi.MAX)
+    rmsErr = sqrt(mpi.allreduce(sum([x*x for x in errs]), mpi.SUM)/ntot)
+    maxTol = maxErrorFactor*opening**2
+    rmsTol = rmsErrorFactor*opening**2
+    print "opening = %g : max error %g (tolerance %g), RMS error %g (tolerance %g)" % (opening, maxErr, maxTol, rmsErr, rmsTol)
+    if maxErr > maxTol or rmsErr > rmsTol:
+        failures.append((opening, maxErr, rmsErr))
+
+if failures:
+    raise ValueError, "TreeGravity accelerations differ from the direct sum: %s" % failures
+print "PASS"
@@ -33,6 +33,20 @@
 #
 #ATS:t300 = test(        SELF, "--psph True --graphics None --clearDirectories True --checkError False --restartStep 20 --steps 40", label="Planar Noh problem with PSPH -- 1-D (serial)")
 #ATS:t301 = testif(t300, SELF, "--psph True --graphics None --clearDirectories False --checkError False --restartStep 20 --restoreCycle 20 --steps 20 --checkRestart True", label="Planar Noh problem with PSPH -- 1-D (serial) RESTART CHECK")
+#
+# Restarts through a single ParallelHDF5FileIO file shared by all processes
+#
+#ATS:t400 = test(        SELF, "--graphics None --clearDirectories True  --checkError False --dataDirBase 'dumps-planar-hdf5-restartcheck' --restartFileConstructor ParallelHDF5FileIO --restartStep 20 --steps 40", label="Planar Noh problem -- 1-D (serial, ParallelHDF5FileIO restarts)")
+#ATS:t401 = testif(t400, SELF, "--graphics None --clearDirectories False --checkError False --dataDirBase 'dumps-planar-hdf5-restartcheck' --restartFileConstructor ParallelHDF5FileIO --restartStep 20 --restoreCycle 20 --steps 20 --checkRestart True", label="Planar Noh problem -- 1-D (serial, ParallelHDF5FileIO restarts) RESTART CHECK")
+#ATS:t402 = test(        SELF, "--graphics None --clearDirectories True  --checkError False --dataDirBase 'dumps-planar-hdf5-restartcheck-parallel' --restartFileConstructor ParallelHDF5FileIO --restartStep 20 --steps 40", np=2, label="Planar Noh problem -- 1-D (parallel, ParallelHDF5FileIO restarts)")
+#ATS:t403 = testif(t402, SELF, "--graphics None --clearDirectories False --checkError False --dataDirBase 'dumps-planar-hdf5-restartcheck-parallel' --restartFileConstructor ParallelHDF5FileIO --restartStep 20 --restoreCycle 20 --steps 20 --checkRestart True", np=2, label="Planar Noh problem -- 1-D (parallel, ParallelHDF5FileIO restarts) RESTART CHECK")
+#
+# Restarts written in the background by the AsyncRestartWriter
+#
+#ATS:t500 = test(        SELF, "--graphics None --clearDirectories True  --checkError False --dataDirBase 'dumps-planar-async-restartcheck' --restartFileConstructor MemoryFileIO --asyncRestart True --restartStep 10 --steps 40", label="Planar Noh problem -- 1-D (serial, asynchronous restarts)")
+#ATS:t501 = testif(t500, SELF, "--graphics None --clearDirectories False --checkError False --dataDirBase 'dumps-planar-async-restartcheck' --restartFileConstructor MemoryFileIO --asyncRestart True --restartStep 10 --restoreCycle 20 --steps 20 --checkRestart True", label="Planar Noh problem -- 1-D (serial, asynchronous restarts) RESTART CHECK")
+#ATS:t502 = test(        SELF, "--graphics None --clearDirectories True  --checkError False --dataDirBase 'dumps-planar-async-restartcheck-parallel' --restartFileConstructor MemoryFileIO --asyncRestart True --restartStep 10 --steps 40", np=2, label="Planar Noh problem -- 1-D (parallel, asynchronous restarts)")
+#ATS:t503 = testif(t502, SELF, "--graphics None --clearDirectories False --checkError False --dataDirBase 'dumps-planar-async-restartcheck-parallel' --restartFileConstructor MemoryFileIO --asyncRestart True --restartStep 10 --restoreCycle 20 --steps 20 --checkRestart True", np=2, label="Planar Noh problem -- 1-D (parallel, asynchronous restarts) RESTART CHECK")
 
 import os, shutil
 from SolidSpheral1d import *
@@ -143,6 +157,8 @@ commandLine(KernelConstructor = NBSplineKernel,
             restartStep = 10000,
             dataDirBase = "dumps-planar-Noh",
             restartBaseName = "Noh-planar-1d",
+            restartFileConstructor = SiloFileIO,
+            asyncRestart = False,
             outputFile = "None",
             comparisonFile = "None",
             normOutputFile = "None",
@@ -482,6 +498,8 @@ control = SpheralController(integrator,
                             statsStep = statsStep,
                             restartStep = restartStep,
                             restartBaseName = restartBaseName,
+                            restartFileConstructor = restartFileConstructor,
+                            asyncRestart = asyncRestart,
                             restoreCycle = restoreCycle,
                             timerName = timerName
                             )
@@ -0,0 +1,200 @@
+#ATS:test(SELF, "", label="Planar Sod problem with block timesteps against a single timestep -- 1-D (serial)")
+#ATS:test(SELF, "", np=2, label="Planar Sod problem with block timesteps against a single timestep -- 1-D (parallel)")
+#-------------------------------------------------------------------------------
+# Run the planar Sod problem with the block timestep integrator, and again with
+# the single timestep forward Euler integrator it reduces to (SynchronousRK1).
+# The node spacing is four times larger on the low density side, so the block
+# timestep run spreads the nodes over several rungs.  The block timestep answer
+# should be about as close to the analytic solution, and close to the single
+# timestep answer.
+#-------------------------------------------------------------------------------
+from math import *
+from Spheral1d import *
+from SpheralTestUtilities import *
+from SodAnalyticSolution import *
+import Pnorm
+import mpi
+
+title("1-D planar Sod problem with block timesteps")
+
+commandLine(nx1 = 200,
+            nx2 = 50,
+            rho1 = 1.0,
+            rho2 = 0.25,
+            P1 = 1.0,
+            P2 = 0.1795,
+
+            x0 = -0.5,
+            x1 = 0.0,
+            x2 = 0.5,
+
+            nPerh = 1.35,
+            gammaGas = 5.0/3.0,
+            mu = 1.0,
+            cfl = 0.25,
+
+            goalTime = 0.15,
+            dt = 1.0e-6,
+            dtMin = 1.0e-6,
+            dtMax = 0.1,
+            dtGrowth = 2.0,
+            maxRung = 4,
+
+            # The block timestep L1 errors against the analytic solution may be
+            # at most this multiple of the single timestep errors, and the two
+            # answers must agree to this fraction (L1 difference relative to
+            # the L1 norm of the single timestep answer).
+            errorRatioTolerance = 1.5,
+            differenceTolerance = 0.05,
+            )
+
+def rho_initial(xi):
+    if xi <= x1:
+        return rho1
+    else:
+        return rho2
+
+def specificEnergy(xi, rhoi):
+    if xi <= x1:
+        Pi = P1
+    else:
+        Pi = P2
+    return Pi/((gammaGas - 1.0)*rhoi)
+
+# Make a flat list from a FieldList
+def createList(x):
+    result = []
+    for i in xrange(len(x)):
+        for j in xrange(x[i].numInternalElements):
+            result.append(x(i,j))
+    return mpi.allreduce(result, mpi.SUM)
+
+#-------------------------------------------------------------------------------
+# Build and run the problem with the given integrator, returning the final
+# profiles sorted by position.
+#-------------------------------------------------------------------------------
+from GenerateNodeProfile import GenerateNodeProfile1d
+from VoronoiDistributeNodes import distributeNodes1d
+
+def run(IntegratorConstructor, label):
+    eos = GammaLawGasMKS(gammaGas, mu)
+    WT = TableKernel(NBSplineKernel(5), 1000)
+    nodes = makeFluidNodeList("nodes " + label, eos,
+                              nPerh = nPerh,
+                              kernelExtent = WT.kernelExtent)
+    gen = GenerateNodeProfile1d(nx = nx1 + nx2,
+                                rho = rho_initial,
+                                xmin = x0,
+                                xmax = x2,
+                                nNodePerh = nPerh)
+    distributeNodes1d((nodes, gen))
+    pos = nodes.positions()
+    eps = nodes.specificThermalEnergy()
+    rho = nodes.massDensity()
+    for i in xrange(nodes.numInternalNodes):
+        eps[i] = specificEnergy(pos[i].x, rho[i])
+
+    db = DataBase()
+    db.appendNodeList(nodes)
+
+    # The compatible energy update walks the node pairs, so make sure we cover
+    # it with the pairs restricted to the active nodes.
+    hydro = SPH(dataBase = db,
+                W = WT,
+                cfl = cfl,
+                compatibleEnergyEvolution = True,
+                densityUpdate = RigorousSumDensity,
+                HUpdate = IdealH)
+    for bc in (ReflectingBoundary(Plane(Vector(x0), Vector( 1.0))),
+               ReflectingBoundary(Plane(Vector(x2), Vector(-1.0)))):
+        hydro.appendBoundary(bc)
+
+    integrator = IntegratorConstructor(db)
+    integrator.appendPhysicsPackage(hydro)
+    integrator.lastDt = dt
+    integrator.dtMin = dtMin
+    integrator.dtMax = dtMax
+    integrator.dtGrowth = dtGrowth
+    if IntegratorConstructor is BlockTimestepRK1Integrator:
+        integrator.maxRung = maxRung
+
+    control = SpheralController(integrator, WT,
+                                statsStep = 1000,
+                                restartBaseName = "Sod-planar-1d-BlockTimestep-%s-restart" % label)
+
+    # Track the rungs and work of the block timestep steps.
+    rungs, work = [], []
+    def recordRungs(cycle, t, dt):
+        if IntegratorConstructor is BlockTimestepRK1Integrator:
+            rungs.append(integrator.lastNumRungs)
+            work.append(integrator.lastWorkFraction)
+    control.appendPeriodicWork(recordRungs, 1)
+    control.advance(goalTime)
+
+    xprof = [x.x for x in createList(db.fluidPosition)]
+    profiles = {"Mass density"  : createList(db.fluidMassDensity),
+                "Pressure"      : createList(hydro.pressure),
+                "Velocity"      : [v.x for v in createList(db.fluidVelocity)],
+                "Thermal energy": createList(db.fluidSpecificThermalEnergy)}
+    order = sorted(range(len(xprof)), key = lambda i: xprof[i])
+    xprof = [xprof[i] for i in order]
+    for name in profiles:
+        profiles[name] = [profiles[name][i] for i in order]
+    return control.time(), xprof, profiles, rungs, work
+
+t1, xsingle, single, rungs1, work1 = run(SynchronousRK1Integrator, "single")
+t2, xblock, block, rungs, work = run(BlockTimestepRK1Integrator, "block")
+
+print "Block timestep steps: %i, rungs used per step %s, work fractions %s" % (len(rungs), rungs, ["%.3f" % x for x in work])
+if max(rungs + [0]) < 2:
+    raise ValueError, "Block timestep run never used more than one rung"
+if min(work + [1.0]) >= 1.0:
+    raise ValueError, "Block timestep run never skipped any node advances"
+if abs(t1 - goalTime) > 1.0e-10 or abs(t2 - goalTime) > 1.0e-10:
+    raise ValueError, "Runs did not end at the goal time: %g %g" % (t1, t2)
+assert len(xsingle) == len(xblock)
+
+#-------------------------------------------------------------------------------
+# Compare against the analytic solution, and against each other.
+#-------------------------------------------------------------------------------
+dx1 = (x1 - x0)/nx1
+dx2 = (x2 - x1)/nx2
+answer = SodSolution(nPoints = nx1 + nx2,
+                     gamma = gammaGas,
+                     rho1 = rho1,
+                     P1 = P1,
+                     rho2 = rho2,
+                     P2 = P2,
+                     x0 = x0,
+                     x1 = x1,
+                     x2 = x2,
+                     h1 = nPerh*dx1,
+                     h2 = nPerh*dx2)
+
+def L1(x, values):
+    return Pnorm.Pnorm(values, x).gridpnorm(1, x0, x2)
+
+def analytic(x):
+    xans, vans, uans, rhoans, Pans, hans = answer.solution(goalTime, x)
+    return {"Mass density"  : rhoans,
+            "Pressure"      : Pans,
+            "Velocity"      : vans,
+            "Thermal energy": uans}
+
+anssingle = analytic(xsingle)
+ansblock = analytic(xblock)
+failures = []
+print "\tQuantity \t\tL1 (single) \t\tL1 (block) \t\tL1 difference"
+for name in single:
+    errsingle = L1(xsingle, [a - b for (a, b) in zip(single[name], anssingle[name])])
+    errblock = L1(xblock, [a - b for (a, b) in zip(block[name], ansblock[name])])
+    diff = L1(xsingle, [a - b for (a, b) in zip(block[name], single[name])])/max(1.0e-50, L1(xsingle, [abs(a) for a in single[name]]))
+    print "\t%-14s \t\t%g \t\t%g \t\t%g" % (name, errsingle, errblock, diff)
+    if errblock > errorRatioTolerance*errsingle:
+        failures.append((name, "L1 error", errblock, errsingle))
+    if diff > differenceTolerance:
+        failures.append((name, "difference", diff))
+
+if failures:
+    raise ValueError, "Block timestep answer does not match the single timestep answer: %s" % failures
+print "PASS"
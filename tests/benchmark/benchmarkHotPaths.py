@@ -0,0 +1,140 @@
+#-------------------------------------------------------------------------------
+# Time the C++ hot paths (ConnectivityMap construction, SPH evaluateDerivatives,
+# the RK volumes & corrections, TableKernel lookups, TreeGravity, and the
+# equation of state) on lattice NodeLists over a range of dimensions and
+# thread counts.  The results are written as JSON so successive versions can
+# be compared, e.g.
+#
+#   python benchmarkHotPaths.py --dimensions "2,3" --threads "1,4,16"
+#
+# Requires Spheral to be built with the CXXTests package (-DENABLE_CXXTESTS=On
+# for CMake builds).
+#-------------------------------------------------------------------------------
+import json, time, platform
+from Spheral import *
+from SpheralTestUtilities import *
+
+title("C++ hot path benchmarks")
+
+commandLine(dimensions = "1,2,3",
+            threads = "1",
+            nx1d = 10000,
+            nx2d = 100,
+            nx3d = 30,
+            nPerh = 2.01,
+            nrepeat = 5,
+            nkernel = 1000000,
+            rho0 = 1.0,
+            eps0 = 1.0,
+            gamma = 5.0/3.0,
+            mu = 1.0,
+            outputFile = "benchmarkHotPaths.json")
+
+if mpi.procs > 1:
+    raise RuntimeError, "benchmarkHotPaths is intended to be run serially"
+
+dims = [int(x) for x in dimensions.split(",")]
+nthreads = [int(x) for x in threads.split(",")]
+
+#-------------------------------------------------------------------------------
+# Summarize a set of timings.
+#-------------------------------------------------------------------------------
+def stats(times):
+    times = list(times)
+    return {"min"   : min(times),
+            "max"   : max(times),
+            "mean"  : sum(times)/len(times),
+            "times" : times}
+
+#-------------------------------------------------------------------------------
+# Build the problem for a given dimension.
+#-------------------------------------------------------------------------------
+def buildProblem(ndim):
+    sph = __import__("Spheral%id" % ndim)
+    units = sph.CGS()
+    eos = sph.GammaLawGas(gamma, mu, units)
+    WT = sph.TableKernel(sph.WendlandC4Kernel(), 1000)
+    nodes = sph.makeFluidNodeList("nodes", eos,
+                                  nPerh = nPerh,
+                                  kernelExtent = WT.kernelExtent)
+    if ndim == 1:
+        from DistributeNodes import distributeNodesInRange1d
+        distributeNodesInRange1d([(nodes, nx1d, rho0, (0.0, 1.0))], nPerh = nPerh)
+    elif ndim == 2:
+        from GenerateNodeDistribution2d import GenerateNodeDistribution2d
+        from DistributeNodes import distributeNodes2d
+        generator = GenerateNodeDistribution2d(nx2d, nx2d, rho0, "lattice",
+                                               xmin = (0.0, 0.0),
+                                               xmax = (1.0, 1.0),
+                                               nNodePerh = nPerh)
+        distributeNodes2d((nodes, generator))
+    else:
+        from GenerateNodeDistribution3d import GenerateNodeDistribution3d
+        from DistributeNodes import distributeNodes3d
+        generator = GenerateNodeDistribution3d(nx3d, nx3d, nx3d, rho0, "lattice",
+                                               xmin = (0.0, 0.0, 0.0),
+                                               xmax = (1.0, 1.0, 1.0),
+                                               nNodePerh = nPerh)
+        distributeNodes3d((nodes, generator))
+    nodes.specificThermalEnergy(sph.ScalarField("tmp", nodes, eps0))
+
+    db = sph.DataBase()
+    db.appendNodeList(nodes)
+
+    hydro = sph.SPH(dataBase = db, W = WT)
+    rk = sph.RKCorrections(orders = set([sph.RKOrder.LinearOrder]),
+                           dataBase = db,
+                           W = WT,
+                           volumeType = sph.RKVolumeType.RKVoronoiVolume,
+                           needHessian = False)
+    packages = [("SPH", hydro), ("RKCorrections", rk)]
+    if ndim > 1:
+        Gravity = (sph.QuadTreeGravity if ndim == 2 else sph.OctTreeGravity)
+        packages.append(("TreeGravity", Gravity(G = 1.0,
+                                                softeningLength = 1.0e-3,
+                                                opening = 0.5,
+                                                ftimestep = 0.1)))
+
+    pkgs = sph.vector_of_Physics()
+    for name, p in packages:
+        pkgs.append(p)
+    db.updateConnectivityMap(False, False)
+    for name, p in packages:
+        p.initializeProblemStartup(db)
+    state = sph.State(db, pkgs)
+    derivs = sph.StateDerivatives(db, pkgs)
+    for name, p in packages:
+        p.initialize(0.0, 1.0, db, state, derivs)
+    return sph, WT, eos, nodes, db, packages, state, derivs
+
+#-------------------------------------------------------------------------------
+# Run the benchmarks.
+#-------------------------------------------------------------------------------
+results = {"time"     : time.strftime("%Y-%m-%d %H:%M:%S"),
+           "host"     : platform.node(),
+           "nrepeat"  : nrepeat,
+           "results"  : []}
+
+for ndim in dims:
+    sph, WT, eos, nodes, db, packages, state, derivs = buildProblem(ndim)
+    for nt in nthreads:
+        omp_set_num_threads(nt)
+        print "Benchmarking %iD, %i nodes, %i threads" % (ndim, nodes.numInternalNodes, nt)
+        def record(name, times):
+            s = stats(times)
+            s.update({"name"     : name,
+                      "ndim"     : ndim,
+                      "nthreads" : nt,
+                      "numNodes" : nodes.numInternalNodes})
+            results["results"].append(s)
+            print "  %-40s min %12.6g  mean %12.6g (s)" % (name, s["min"], s["mean"])
+        record("ConnectivityMap", sph.benchmarkConnectivityMap(db, False, nrepeat))
+        record("TableKernel", sph.benchmarkTableKernel(WT, nkernel, nrepeat))
+        record("EquationOfState", sph.benchmarkEquationOfState(eos, nodes.massDensity(), nodes.specificThermalEnergy(), nrepeat))
+        for name, p in packages:
+            record(name + "::initialize", sph.benchmarkPhysicsInitialize(p, db, state, derivs, nrepeat))
+            record(name + "::evaluateDerivatives", sph.benchmarkEvaluateDerivatives(p, db, state, derivs, nrepeat))
+
+with open(outputFile, "w") as f:
+    json.dump(results, f, indent=2)
+print "Wrote ", outputFile